@@ -22,6 +22,7 @@
 #include "esp_lcd_ssd1681_commands.h"
 #include "esp_log.h"
 #include "esp_memory_utils.h"
+#include "esp_timer.h"
 
 #define SSD1681_LUT_SIZE 159
 #define SSD1681_EPD_1IN54_V2_WIDTH 200
@@ -61,6 +62,9 @@ typedef struct {
     uint8_t *_framebuffer;
     bool _invert_color;
     bool _partial_refresh; // Flag for partial refresh mode
+    // --- Timing accumulated since the last epaper_panel_take_timing() call
+    uint32_t _transfer_us;
+    uint32_t _busy_us;
 } epaper_panel_t;
 
 // --- Utility functions
@@ -195,9 +199,11 @@ static esp_err_t epaper_set_area(esp_lcd_panel_io_handle_t io, uint32_t start_x,
 
 static esp_err_t panel_epaper_wait_busy(esp_lcd_panel_t *panel) {
     epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
+    int64_t start_us = esp_timer_get_time();
     while (gpio_get_level(epaper_panel->busy_gpio_num)) {
         vTaskDelay(pdMS_TO_TICKS(15));
     }
+    epaper_panel->_busy_us += (uint32_t)(esp_timer_get_time() - start_us);
     return ESP_OK;
 }
 
@@ -280,6 +286,18 @@ esp_err_t epaper_panel_refresh_screen(esp_lcd_panel_t *panel) {
     return ESP_OK;
 }
 
+esp_err_t epaper_panel_take_timing(esp_lcd_panel_t *panel, uint32_t *transfer_us,
+                                   uint32_t *busy_us) {
+    ESP_RETURN_ON_FALSE(panel && transfer_us && busy_us, ESP_ERR_INVALID_ARG, TAG,
+                        "1 or more args is NULL");
+    epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
+    *transfer_us = epaper_panel->_transfer_us;
+    *busy_us = epaper_panel->_busy_us;
+    epaper_panel->_transfer_us = 0;
+    epaper_panel->_busy_us = 0;
+    return ESP_OK;
+}
+
 esp_err_t epaper_panel_set_refresh_mode(esp_lcd_panel_t *panel, bool partial_refresh) {
     ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "panel handler is NULL");
     epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
@@ -468,6 +486,7 @@ static esp_err_t epaper_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
     if (gpio_get_level(epaper_panel->busy_gpio_num)) {
         return ESP_ERR_NOT_FINISHED;
     }
+    int64_t start_us = esp_timer_get_time();
     x_start += epaper_panel->gap_x;
     x_end += epaper_panel->gap_x;
     y_start += epaper_panel->gap_y;
@@ -569,6 +588,7 @@ static esp_err_t epaper_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
     // tx_param will wait until DMA transaction finishes, so it is safe to call
     // panel_epaper_refresh_screen at once. The driver will not call the
     // `epaper_panel_refresh_screen` automatically, please call it manually.
+    epaper_panel->_transfer_us += (uint32_t)(esp_timer_get_time() - start_us);
     return ESP_OK;
 }
 
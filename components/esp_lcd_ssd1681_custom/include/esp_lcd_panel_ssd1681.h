@@ -156,6 +156,22 @@ esp_err_t epaper_panel_set_custom_lut(esp_lcd_panel_t *panel, uint8_t *lut, size
  */
 esp_err_t epaper_panel_set_refresh_mode(esp_lcd_panel_t *panel, bool partial_refresh);
 
+/**
+ * @brief Get and reset the time spent in bitmap transfer and BUSY wait
+ *
+ * @note Transfer time covers esp_lcd_panel_draw_bitmap() calls. The color data is queued
+ * asynchronously, so the tail of the last transfer is waited by the next command instead.
+ * @note BUSY wait time covers every internal wait for the BUSY pin to go low.
+ *
+ * @param[in] panel LCD panel handle
+ * @param[out] transfer_us Accumulated transfer time in microseconds
+ * @param[out] busy_us Accumulated BUSY wait time in microseconds
+ * @return  ESP_OK                on success
+ *          ESP_ERR_INVALID_ARG   if parameter is invalid
+ */
+esp_err_t epaper_panel_take_timing(esp_lcd_panel_t *panel, uint32_t *transfer_us,
+                                   uint32_t *busy_us);
+
 #ifdef __cplusplus
 }
 #endif
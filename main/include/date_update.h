@@ -2,4 +2,6 @@
 
 void date_update();
 
-void date_update_init();
\ No newline at end of file
+void date_update_init();
+
+void date_update_refresh();
\ No newline at end of file
@@ -1,6 +1,131 @@
 #pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
+#include "esp_err.h"
 #include "zlib.h"
 
-int network_gzip_decompress(void *in_buf, size_t in_size, void *out_buf, size_t *out_size,
-                            size_t out_buf_size);
\ No newline at end of file
+/** @brief 流式解压每次输出的块大小 */
+#define GZIP_STREAM_OUT_CHUNK 512
+
+/**
+ * @brief 解压输出回调
+ *
+ * @param ctx 用户上下文
+ * @param data 解压得到的数据
+ * @param len 数据长度
+ * @return Z_OK 继续，其他值终止解压并作为 gzip_stream_feed 的返回值
+ */
+typedef int (*gzip_stream_output_cb_t)(void *ctx, const uint8_t *data, size_t len);
+
+/**
+ * @brief 流式 GZIP 解压器
+ *
+ * 输入按 HTTP 数据块逐段喂入，解压结果以固定大小的块交给回调，不缓存整个响应体。
+ * 若数据不是 GZIP 格式（首字节不是 0x1f），则原样透传给回调。
+ * 支持多个 GZIP 成员首尾相接的数据，成员之后的填充 0 字节被忽略。
+ *
+ * zlib 的窗口与状态通过 zalloc/zfree 钩子分配在 PSRAM 中。解压器可长期持有：
+ * gzip_stream_reset() 通过 inflateReset 复用已有的窗口，避免每次请求重新分配 32 KB。
+ */
+typedef struct {
+    z_stream zs;                           ///< zlib 流
+    bool inited;                           ///< 是否已完成 inflateInit2
+    bool detected;                         ///< 是否已判断输入格式
+    bool passthrough;                      ///< 输入不是 GZIP，原样透传
+    bool finished;                         ///< 已遇到流结束标志
+    gzip_stream_output_cb_t output_cb;     ///< 输出回调
+    void *ctx;                             ///< 回调上下文
+    size_t total_in;                       ///< 累计输入字节数
+    size_t total_out;                      ///< 累计输出字节数
+    int64_t inflate_us;                    ///< 本次解压中 inflate 累计耗时（不含回调）
+    uint8_t out[GZIP_STREAM_OUT_CHUNK];    ///< 输出块缓冲
+} gzip_stream_t;
+
+/**
+ * @brief 解压统计
+ */
+typedef struct {
+    uint32_t streams;   ///< 解压次数
+    uint32_t inits;     ///< inflateInit2 次数（窗口分配次数）
+    uint32_t resets;    ///< inflateReset 复用次数
+    uint32_t errors;    ///< 解压失败次数
+    uint64_t total_in;  ///< 累计输入字节数
+    uint64_t total_out; ///< 累计输出字节数
+    int64_t inflate_us; ///< inflate 累计耗时（微秒）
+    uint32_t last_in;   ///< 最近一次输入字节数
+    uint32_t last_out;  ///< 最近一次输出字节数
+    int64_t last_us;    ///< 最近一次 inflate 耗时（微秒）
+} gzip_stats_t;
+
+/**
+ * @brief 初始化流式解压器
+ *
+ * @param gs 解压器（由调用者分配）
+ * @param output_cb 输出回调
+ * @param ctx 回调上下文
+ */
+void gzip_stream_init(gzip_stream_t *gs, gzip_stream_output_cb_t output_cb, void *ctx);
+
+/**
+ * @brief 复位解压器以开始新的数据流，保留已分配的 zlib 窗口
+ *
+ * @param gs 已初始化的解压器
+ * @param output_cb 输出回调
+ * @param ctx 回调上下文
+ */
+void gzip_stream_reset(gzip_stream_t *gs, gzip_stream_output_cb_t output_cb, void *ctx);
+
+/**
+ * @brief 喂入一段压缩数据
+ *
+ * @return Z_OK 成功，其他为 zlib 错误码或回调返回值
+ */
+int gzip_stream_feed(gzip_stream_t *gs, const void *data, size_t len);
+
+/**
+ * @brief 结束解压并检查流是否完整
+ *
+ * @return Z_OK 完整，Z_DATA_ERROR 表示数据被截断
+ */
+int gzip_stream_finish(gzip_stream_t *gs);
+
+/**
+ * @brief 释放解压器内部资源（zlib 窗口与状态）
+ */
+void gzip_stream_deinit(gzip_stream_t *gs);
+
+/**
+ * @brief 初始化共享解压器
+ *
+ * @return ESP_OK 成功，ESP_ERR_NO_MEM 内存不足
+ */
+esp_err_t decompress_init(void);
+
+/**
+ * @brief 获取共享的长期解压器并复位
+ *
+ * 解压器由 decompress_init() 创建后一直保留；同一时间只能有一个持有者，
+ * 其他调用者阻塞等待。用完后必须调用 gzip_stream_release()。
+ *
+ * @param output_cb 输出回调
+ * @param ctx 回调上下文
+ * @return 解压器，未初始化时返回 NULL
+ */
+gzip_stream_t *gzip_stream_acquire(gzip_stream_output_cb_t output_cb, void *ctx);
+
+/**
+ * @brief 归还共享解压器，记录本次的压缩比与耗时
+ *
+ * @param gs gzip_stream_acquire() 返回的解压器
+ * @param ok 本次解压是否成功
+ */
+void gzip_stream_release(gzip_stream_t *gs, bool ok);
+
+/**
+ * @brief 获取解压统计
+ *
+ * @param stats 输出统计
+ */
+void gzip_get_stats(gzip_stats_t *stats);
@@ -0,0 +1,52 @@
+/**
+ * @file epaper_theme.h
+ * @brief 电子墨水屏专用 LVGL 主题
+ *
+ * 纯黑白样式：无阴影、无渐变、无透明度、无圆角、无过渡动画，
+ * 避免软件渲染额外开销以及抖动后产生的噪点。
+ */
+
+#pragma once
+
+#include "lvgl.h"
+
+/**
+ * @brief 初始化电子墨水屏主题
+ *
+ * @param disp 目标显示对象，为 NULL 时使用默认显示
+ * @return 主题指针
+ */
+lv_theme_t *epaper_theme_init(lv_display_t *disp);
+
+/**
+ * @brief 安装电子墨水屏主题，接管 EEZ 生成代码中的默认主题
+ *
+ * EEZ 生成的 create_screens() 会调用 lv_theme_default_init() 并将其设为显示主题。
+ * 本函数需在 eez_flow_init() 之前调用：以相同参数预先初始化默认主题，并把其 apply 回调
+ * 替换为电子墨水屏主题。默认主题在参数未变化时不会重置回调，因此生成代码无需修改。
+ *
+ * 这依赖 lv_theme_default_init() 对相同参数直接返回的行为：在 EEZ Studio 中修改主题
+ * 颜色或字体后，生成代码会重新初始化默认主题，电子墨水屏主题随之失效。lvgl_init.c
+ * 在 eez_flow_init() 之后用 epaper_theme_is_active() 检查。生成代码随后把默认主题设为显示
+ * 主题，因此无法改用 lv_theme_set_parent() 叠加一个独立主题。
+ *
+ * @param disp 目标显示对象，为 NULL 时使用默认显示
+ */
+void epaper_theme_install(lv_display_t *disp);
+
+/**
+ * @brief 切换显示主题：电子墨水屏主题或 EEZ 生成代码使用的默认主题（渲染耗时对比用）
+ *
+ * 主题只作用于之后创建的对象：调用前删除所有已创建的屏幕，之后重新创建。
+ *
+ * @param disp   目标显示对象，为 NULL 时使用默认显示
+ * @param epaper true 使用电子墨水屏主题，false 使用默认主题
+ */
+void epaper_theme_select(lv_display_t *disp, bool epaper);
+
+/**
+ * @brief 电子墨水屏主题是否仍在生效（生成代码没有以不同参数重新初始化默认主题）
+ *
+ * @param disp 目标显示对象，为 NULL 时使用默认显示
+ */
+bool epaper_theme_is_active(lv_display_t *disp);
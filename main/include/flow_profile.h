@@ -0,0 +1,74 @@
+/**
+ * @file flow_profile.h
+ * @brief EEZ 流程执行剖析
+ *
+ * 按组件类型统计执行次数、累计与最大耗时，另外统计表达式求值、原生动作（actions.c 中的
+ * action_*）、每次 eez::flow::tick 的耗时、队列深度与触及 FLOW_TICK_MAX_DURATION_MS 的次数。
+ * 组件耗时包含其中的表达式求值与原生动作；表达式求值也包括 screens.c 中控件绑定的求值。
+ *
+ * 默认关闭，在 main/CMakeLists.txt 中设置 EEZ_FLOW_PROFILE=1 开启；关闭时 eez-flow.cpp 中的
+ * 钩子、本模块与 GET /api/flow_profile 都不参与编译。
+ */
+
+#pragma once
+
+#if EEZ_FLOW_PROFILE
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+/** @brief 最多统计的组件类型数，超出的类型只计入 dropped */
+#define FLOW_PROFILE_MAX_TYPES 24
+/** @brief 最多统计的原生动作数（按 ui.c 中 actions 数组的序号） */
+#define FLOW_PROFILE_MAX_ACTIONS 8
+
+/**
+ * @brief 一项耗时统计
+ */
+typedef struct {
+    uint32_t count;    ///< 次数
+    uint64_t total_us; ///< 累计耗时（微秒）
+    uint32_t max_us;   ///< 单次最大耗时（微秒）
+} flow_profile_entry_t;
+
+/**
+ * @brief 单个组件类型的统计
+ */
+typedef struct {
+    uint16_t type;              ///< 组件类型（eez-flow.h 中的 COMPONENT_TYPE_*）
+    flow_profile_entry_t entry; ///< 耗时统计
+} flow_profile_component_t;
+
+/**
+ * @brief 流程执行剖析统计
+ */
+typedef struct {
+    uint32_t window_ms;               ///< 统计时长（开机或上次清零以来，毫秒）
+    flow_profile_entry_t ticks;       ///< eez::flow::tick 的耗时
+    uint32_t budget_hits;             ///< 因超过 FLOW_TICK_MAX_DURATION_MS 提前结束的 tick 数
+    uint32_t queue_size;              ///< 最近一次 tick 开始时的队列长度
+    uint32_t queue_backlog_max;       ///< tick 开始时队列长度的最大值
+    uint32_t queue_peak;              ///< 流程启动以来队列长度的最大值（清零不影响）
+    flow_profile_entry_t expressions; ///< 表达式求值的耗时
+    uint32_t dropped;                 ///< 因类型表已满而未统计的组件执行次数
+    uint8_t num_types;                ///< components 中有效的项数
+    /** @brief 各组件类型的统计，按首次执行的顺序 */
+    flow_profile_component_t components[FLOW_PROFILE_MAX_TYPES];
+    /** @brief 各原生动作的统计 */
+    flow_profile_entry_t actions[FLOW_PROFILE_MAX_ACTIONS];
+} flow_profile_stats_t;
+
+/**
+ * @brief 获取流程执行剖析统计
+ *
+ * 在持有 LVGL 互斥锁时复制，与流程执行互斥。
+ *
+ * @param stats 输出统计
+ * @param reset 复制后清零
+ * @return ESP_OK 成功，ESP_ERR_TIMEOUT 等待 LVGL 互斥锁超时
+ */
+esp_err_t flow_profile_get_stats(flow_profile_stats_t *stats, bool reset);
+
+#endif // EEZ_FLOW_PROFILE
@@ -0,0 +1,138 @@
+/**
+ * @file http_cache.h
+ * @brief 以 URL 为键的 HTTP 响应缓存
+ *
+ * 保存上一次 200 响应的校验信息（ETag / Last-Modified / max-age / 业务更新时间）
+ * 以及解析后的结果结构体：
+ * - max-age 未过期时直接返回缓存结果，不发请求；
+ * - 否则携带 If-None-Match / If-Modified-Since 发起条件请求，304 时复用缓存结果；
+ * - 服务器返回的业务更新时间（如和风天气 updateTime）未变化时也复用缓存结果。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_http_client.h"
+
+/** @brief 缓存条目数：每个天气位置的实时天气与预报各占一条（见 weather_multi.c 中的检查） */
+#define HTTP_CACHE_SIZE 8
+/** @brief 缓存 URL 最大长度（含结束符） */
+#define HTTP_CACHE_URL_MAX 256
+/** @brief ETag 最大长度（含结束符） */
+#define HTTP_CACHE_ETAG_MAX 64
+/** @brief HTTP 日期 / 业务更新时间最大长度（含结束符） */
+#define HTTP_CACHE_DATE_MAX 40
+
+/**
+ * @brief 从响应头中提取的缓存信息
+ */
+typedef struct {
+    char etag[HTTP_CACHE_ETAG_MAX];          ///< ETag
+    char last_modified[HTTP_CACHE_DATE_MAX]; ///< Last-Modified
+    int32_t max_age_s;                       ///< Cache-Control: max-age，-1 表示未给出
+    bool revalidate;                         ///< no-store / no-cache：忽略 max-age，总是重新验证
+} http_cache_meta_t;
+
+/**
+ * @brief 缓存统计
+ */
+typedef struct {
+    uint32_t fresh_hits;        ///< max-age 内直接使用缓存、未发请求的次数
+    uint32_t not_modified;      ///< 收到 304 的次数
+    uint32_t unchanged;         ///< 收到 200 但业务更新时间未变化的次数
+    uint32_t stores;            ///< 写入新结果的次数
+    uint32_t parses_skipped;    ///< 跳过解析的次数
+    uint32_t refreshes_skipped; ///< 跳过界面更新（墨水屏刷新）的次数
+    uint64_t bytes_saved;       ///< 避免下载的响应字节数
+} http_cache_stats_t;
+
+/**
+ * @brief 初始化响应缓存
+ *
+ * @return ESP_OK 成功
+ */
+esp_err_t http_cache_init(void);
+
+/**
+ * @brief 初始化响应头信息
+ *
+ * @param meta 响应头信息
+ */
+void http_cache_meta_init(http_cache_meta_t *meta);
+
+/**
+ * @brief 处理一个响应头，在 HTTP_EVENT_ON_HEADER 中调用
+ *
+ * @param meta 响应头信息
+ * @param key 头名称
+ * @param value 头内容
+ */
+void http_cache_parse_header(http_cache_meta_t *meta, const char *key, const char *value);
+
+/**
+ * @brief 查询 max-age 内仍然新鲜的缓存结果
+ *
+ * @param url 请求 URL
+ * @param result 输出，命中时复制缓存结果
+ * @param size 结果大小，须与写入时一致
+ * @return ESP_OK 命中，ESP_ERR_NOT_FOUND 未命中或已过期
+ */
+esp_err_t http_cache_get_fresh(const char *url, void *result, size_t size);
+
+/**
+ * @brief 为请求设置条件请求头
+ *
+ * 复用的客户端句柄会保留上一次请求的头，因此没有缓存时也会删除这两个头；http_pool_release()
+ * 归还句柄时同样删除，不会带到同一主机上其他 URL 的请求中。
+ *
+ * @param url 请求 URL
+ * @param client HTTP 客户端
+ * @param update_time 输出，缓存结果的业务更新时间，无缓存时为空串；可为 NULL
+ * @param update_time_size update_time 缓冲区大小
+ */
+void http_cache_prepare_request(const char *url, esp_http_client_handle_t client,
+                                char *update_time, size_t update_time_size);
+
+/**
+ * @brief 响应未变化（304 或业务更新时间相同）：刷新有效期并取回缓存结果
+ *
+ * @param url 请求 URL
+ * @param meta 本次响应头信息
+ * @param not_modified true 表示 304，false 表示 200 但业务更新时间未变化
+ * @param result 输出，复制缓存结果
+ * @param size 结果大小
+ * @return ESP_OK 成功，ESP_ERR_NOT_FOUND 缓存已被淘汰
+ */
+esp_err_t http_cache_revalidated(const char *url, const http_cache_meta_t *meta,
+                                 bool not_modified, void *result, size_t size);
+
+/**
+ * @brief 写入新的解析结果
+ *
+ * @param url 请求 URL
+ * @param meta 本次响应头信息
+ * @param update_time 业务更新时间，可为 NULL
+ * @param result 解析结果
+ * @param size 结果大小
+ * @param wire_bytes 本次响应体在网络上传输的字节数（用于统计节省量）
+ * @return ESP_OK 成功
+ */
+esp_err_t http_cache_store(const char *url, const http_cache_meta_t *meta,
+                           const char *update_time, const void *result, size_t size,
+                           size_t wire_bytes);
+
+/**
+ * @brief 记录一次因数据未变化而跳过的界面更新
+ */
+void http_cache_note_refresh_skipped(void);
+
+/**
+ * @brief 获取缓存统计
+ *
+ * @param stats 输出统计
+ */
+void http_cache_get_stats(http_cache_stats_t *stats);
@@ -0,0 +1,90 @@
+/**
+ * @file http_pool.h
+ * @brief 按主机复用的 HTTPS 客户端连接池
+ *
+ * 每个主机保留一个 esp_http_client 句柄，连续请求复用同一 TCP/TLS 连接；
+ * 连接断开后重连时使用保存的 TLS 会话票据走简化握手。
+ * 请求期间的 HTTP 事件会转发给调用者提供的事件回调和 user_data。
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_http_client.h"
+
+/** @brief 连接池槽位数（同时保持的主机数） */
+#define HTTP_POOL_SIZE 4
+/** @brief 主机名最大长度（含结束符） */
+#define HTTP_POOL_HOST_MAX 64
+/** @brief 空闲超过该时间的连接在复用前主动关闭（服务器通常已断开） */
+#define HTTP_POOL_IDLE_CLOSE_MS 30000
+
+/**
+ * @brief 连接池统计
+ */
+typedef struct {
+    uint32_t requests;        ///< 请求总数
+    uint32_t connects;        ///< 新建连接（TCP + TLS 握手）次数
+    uint32_t reused;          ///< 复用已建立连接的请求数
+    uint32_t stale_retries;   ///< 复用连接已失效、重连后重试的次数
+    uint32_t evictions;       ///< 因槽位不足被淘汰的主机数
+    uint32_t overflow;        ///< 槽位全部占用时临时创建的客户端数
+    int64_t connect_us_total; ///< 建连累计耗时（微秒）
+    int64_t last_connect_us;  ///< 最近一次建连耗时（微秒）
+} http_pool_stats_t;
+
+/**
+ * @brief 初始化连接池
+ *
+ * @return ESP_OK 成功
+ */
+esp_err_t http_pool_init(void);
+
+/**
+ * @brief 获取指定 URL 所在主机的客户端
+ *
+ * 同一主机的空闲句柄会被复用（仅更新 URL），否则新建。使用完毕后必须调用 http_pool_release()。
+ *
+ * @param url 完整请求 URL
+ * @param event_handler 本次请求的事件回调，可为 NULL
+ * @param user_data 传给事件回调的 user_data
+ * @return 客户端句柄，失败返回 NULL
+ */
+esp_http_client_handle_t http_pool_acquire(const char *url, http_event_handle_cb event_handler,
+                                           void *user_data);
+
+/**
+ * @brief 执行请求
+ *
+ * 与 esp_http_client_perform() 相同；若复用的连接已被服务器关闭且尚未收到任何响应，
+ * 则重连后重试一次。
+ *
+ * @param client http_pool_acquire() 返回的句柄
+ * @return esp_err_t 错误码
+ */
+esp_err_t http_pool_perform(esp_http_client_handle_t client);
+
+/**
+ * @brief 归还客户端
+ *
+ * @param client http_pool_acquire() 返回的句柄
+ */
+void http_pool_release(esp_http_client_handle_t client);
+
+/**
+ * @brief 关闭所有空闲连接
+ *
+ * Wi-Fi 断开或被 wifi_suspend() 关闭时由 wifi.c 调用。句柄与其中的会话票据保留，之后的请求
+ * 重新建连时恢复会话。
+ * 正在使用的连接不受影响，请求出错后自行关闭。
+ */
+void http_pool_flush(void);
+
+/**
+ * @brief 获取连接池统计
+ *
+ * @param stats 输出统计
+ */
+void http_pool_get_stats(http_pool_stats_t *stats);
@@ -2,6 +2,11 @@
 
 #include <stdbool.h>
 
+#include "esp_err.h"
+
+/** @brief 默认 IP 定位接口地址，可通过配置 ip_location.base_url 替换（如本地模拟服务器） */
+#define IP_LOCATION_DEFAULT_BASE_URL "https://cn.apihz.cn"
+
 typedef struct {
     int code;
     char continent[64];     // 洲
@@ -27,3 +32,23 @@ typedef struct {
 } location_t;
 
 esp_err_t get_location(const char *ip, location_t *location);
+
+/**
+ * @brief 获取当前位置（带缓存）
+ *
+ * - 配置了手动位置时直接返回配置的位置，不发起请求；
+ * - 否则以当前接入点（BSSID + SSID）为键缓存 IP 定位结果（同时记录返回的公网 IP），
+ *   接入点未变化且未超过缓存有效期时直接返回缓存，缓存同时保存在 NVS 中，重启后仍然有效。
+ *
+ * @param location 输出位置信息
+ * @param from_cache 输出，结果是否来自缓存或手动配置，可为 NULL
+ * @return esp_err_t 错误码，ESP_OK 表示成功
+ */
+esp_err_t get_location_cached(location_t *location, bool *from_cache);
+
+/**
+ * @brief 使位置缓存失效，下次调用 get_location_cached() 时重新定位
+ *
+ * Web 配置修改了 WiFi、IP 定位接口或手动位置时调用。
+ */
+void location_cache_invalidate(void);
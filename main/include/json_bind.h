@@ -0,0 +1,144 @@
+/**
+ * @file json_bind.h
+ * @brief 表驱动的 JSON 字段到结构体绑定
+ *
+ * 每个结构体用一张字段描述表（JSON 键名、成员偏移、类型、成员大小）声明映射关系，
+ * 由通用绑定器在 json_stream 回调中逐个处理标量值。键名通过预先生成的完美哈希表
+ * 直接定位到字段，每个值只需一次哈希和一次 strcmp 校验。
+ *
+ * 哈希槽表由 tools/gen_json_bind_hash.py 生成，修改字段表后需重新生成。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "json_stream.h"
+
+/**
+ * @brief 字段目标类型
+ */
+typedef enum {
+    JSON_BIND_STR,    ///< 字符串，截断复制到定长字符数组
+    JSON_BIND_INT,    ///< 整数，按成员大小（1/2/4 字节）写入
+    JSON_BIND_FLOAT,  ///< 单精度浮点
+    JSON_BIND_DOUBLE, ///< 双精度浮点
+    JSON_BIND_TIME,   ///< ISO 8601 本地时间（YYYY-MM-DDTHH:MM）转换为 time_t
+} json_bind_type_t;
+
+/** @brief 仅接受 JSON 数字，忽略字符串形式的值 */
+#define JSON_BIND_F_NUMBER_ONLY 0x01
+/** @brief 字符串形式的数值为空串时忽略 */
+#define JSON_BIND_F_NONEMPTY 0x02
+
+/** @brief 无 has_xxx 标志成员 */
+#define JSON_BIND_NO_FLAG 0xFFFF
+
+/**
+ * @brief 字段描述
+ */
+typedef struct {
+    const char *key;      ///< JSON 键名
+    uint16_t offset;      ///< 成员在结构体中的偏移
+    uint16_t size;        ///< 成员大小（字符串为数组长度）
+    uint16_t flag_offset; ///< 赋值成功时置 true 的 bool 成员偏移，JSON_BIND_NO_FLAG 表示无
+    uint8_t type;         ///< json_bind_type_t
+    uint8_t flags;        ///< JSON_BIND_F_*
+} json_bind_field_t;
+
+/**
+ * @brief 结构体描述：字段表与完美哈希槽表
+ */
+typedef struct {
+    const char *name;                ///< 描述名称（用于日志）
+    const json_bind_field_t *fields; ///< 字段表
+    uint8_t field_count;             ///< 字段数
+    const int8_t *slots;             ///< 哈希槽 → 字段下标，-1 表示空槽
+    uint8_t slot_mask;               ///< 槽数 - 1（槽数为 2 的幂）
+    uint32_t seed;                   ///< 哈希种子
+} json_bind_desc_t;
+
+/**
+ * @brief 单个对象的绑定状态
+ */
+typedef struct {
+    const json_bind_desc_t *desc; ///< 结构体描述
+    void *base;                   ///< 目标结构体
+    uint16_t bound;               ///< 已赋值的字段数
+    int64_t elapsed_us;           ///< 绑定累计耗时
+} json_bind_obj_t;
+
+/**
+ * @brief 声明字段
+ *
+ * @param key_ JSON 键名
+ * @param type_ json_bind_type_t
+ * @param struct_t 目标结构体类型
+ * @param member 成员名
+ */
+#define JSON_BIND_FIELD(key_, type_, struct_t, member)                                             \
+    JSON_BIND_FIELD_EX(key_, type_, struct_t, member, 0, JSON_BIND_NO_FLAG)
+
+/**
+ * @brief 声明带选项的字段
+ *
+ * @param flags_ JSON_BIND_F_* 组合
+ * @param flag_offset_ 赋值成功时置 true 的 bool 成员偏移（offsetof），或 JSON_BIND_NO_FLAG
+ */
+#define JSON_BIND_FIELD_EX(key_, type_, struct_t, member, flags_, flag_offset_)                    \
+    {                                                                                              \
+        .key = (key_), .offset = offsetof(struct_t, member),                                       \
+        .size = sizeof(((struct_t *)0)->member), .flag_offset = (flag_offset_), .type = (type_),   \
+        .flags = (flags_),                                                                         \
+    }
+
+/**
+ * @brief 计算键名哈希（与 tools/gen_json_bind_hash.py 保持一致）
+ *
+ * @param key 键名
+ * @param seed 哈希种子
+ * @return 32 位哈希值
+ */
+uint32_t json_bind_hash(const char *key, uint32_t seed);
+
+/**
+ * @brief 校验描述表与哈希槽表是否一致
+ *
+ * 字段表修改后未重新生成槽表时，部分键名将无法命中，此函数会逐个报告。
+ *
+ * @param desc 结构体描述
+ * @return ESP_OK 一致，ESP_ERR_INVALID_STATE 表示槽表已过期
+ */
+esp_err_t json_bind_verify(const json_bind_desc_t *desc);
+
+/**
+ * @brief 开始绑定一个对象
+ *
+ * @param obj 绑定状态
+ * @param desc 结构体描述
+ * @param base 目标结构体，调用者负责预先清零
+ */
+void json_bind_begin(json_bind_obj_t *obj, const json_bind_desc_t *desc, void *base);
+
+/**
+ * @brief 绑定一个标量值
+ *
+ * @param obj 绑定状态
+ * @param key 键名
+ * @param type 值类型
+ * @param value 值文本
+ * @return true 键名命中且类型匹配，false 表示忽略
+ */
+bool json_bind_value(json_bind_obj_t *obj, const char *key, json_stream_type_t type,
+                     const char *value);
+
+/**
+ * @brief 结束绑定一个对象并输出耗时
+ *
+ * @param obj 绑定状态
+ * @return 该对象的绑定累计耗时（微秒）
+ */
+int64_t json_bind_end(json_bind_obj_t *obj);
@@ -0,0 +1,100 @@
+/**
+ * @file json_stream.h
+ * @brief 增量式（SAX 风格）JSON 解析器
+ *
+ * 按任意分块喂入 JSON 文本，解析过程中通过回调逐个报告对象/数组的开始与结束以及标量值，
+ * 不构建 DOM，内存占用与响应体大小无关。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+/** @brief 最大嵌套深度 */
+#define JSON_STREAM_MAX_DEPTH 16
+/** @brief 键名最大长度（含结束符），超出部分被截断 */
+#define JSON_STREAM_KEY_MAX 32
+/** @brief 标量值最大长度（含结束符），超出部分被截断 */
+#define JSON_STREAM_VALUE_MAX 512
+
+/**
+ * @brief 标量值类型
+ */
+typedef enum {
+    JSON_STREAM_STRING, ///< 字符串（已反转义，UTF-8）
+    JSON_STREAM_NUMBER, ///< 数字（原始文本）
+    JSON_STREAM_BOOL,   ///< true / false
+    JSON_STREAM_NULL,   ///< null
+} json_stream_type_t;
+
+/**
+ * @brief 解析回调
+ *
+ * depth 为事件所在容器的嵌套层数：根对象开始时为 0，根对象内的值为 1，依此类推。
+ * key 为该值在所属对象中的键名；数组元素或根值的 key 为 NULL。
+ * 任一回调均可为 NULL。
+ */
+typedef struct {
+    void (*on_object_start)(void *ctx, int depth, const char *key);
+    void (*on_object_end)(void *ctx, int depth);
+    void (*on_array_start)(void *ctx, int depth, const char *key);
+    void (*on_array_end)(void *ctx, int depth);
+    void (*on_value)(void *ctx, int depth, const char *key, json_stream_type_t type,
+                     const char *value, size_t len);
+} json_stream_callbacks_t;
+
+/**
+ * @brief 解析器状态（由调用者分配，无内部动态内存）
+ */
+typedef struct {
+    const json_stream_callbacks_t *cb; ///< 回调表
+    void *ctx;                         ///< 回调上下文
+
+    uint8_t state;                          ///< 当前状态
+    uint8_t depth;                          ///< 当前嵌套深度
+    char stack[JSON_STREAM_MAX_DEPTH];      ///< 容器栈（'{' 或 '['）
+    bool parsing_key;                       ///< 当前字符串是否为键名
+    bool has_key;                           ///< key 是否有效
+    char key[JSON_STREAM_KEY_MAX];          ///< 当前键名
+    size_t key_len;                         ///< 当前键名长度
+    char value[JSON_STREAM_VALUE_MAX];      ///< 当前标量值
+    size_t value_len;                       ///< 当前标量值长度
+    bool truncated;                         ///< 是否发生过截断
+    uint32_t unicode;                       ///< \\uXXXX 累积值
+    uint8_t unicode_digits;                 ///< 已读取的十六进制位数
+    uint32_t high_surrogate;                ///< 待配对的高代理项
+    size_t offset;                          ///< 已处理字节数（用于错误定位）
+} json_stream_t;
+
+/**
+ * @brief 初始化解析器
+ *
+ * @param js 解析器
+ * @param cb 回调表
+ * @param ctx 回调上下文
+ */
+void json_stream_init(json_stream_t *js, const json_stream_callbacks_t *cb, void *ctx);
+
+/**
+ * @brief 喂入一段 JSON 文本
+ *
+ * @param js 解析器
+ * @param data 数据
+ * @param len 数据长度
+ * @return ESP_OK 成功，ESP_ERR_INVALID_RESPONSE 表示 JSON 语法错误
+ */
+esp_err_t json_stream_feed(json_stream_t *js, const char *data, size_t len);
+
+/**
+ * @brief 结束解析
+ *
+ * 处理末尾尚未结束的数字字面量，并检查文档是否完整。
+ *
+ * @param js 解析器
+ * @return ESP_OK 文档完整，ESP_ERR_INVALID_RESPONSE 表示文档不完整或有语法错误
+ */
+esp_err_t json_stream_finish(json_stream_t *js);
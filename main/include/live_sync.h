@@ -0,0 +1,93 @@
+/**
+ * @file live_sync.h
+ * @brief 实时同步：通过 WebSocket 推送配置与界面状态的增量
+ *
+ * WebSocket /api/live 在同一个 HTTP 服务器上运行，取代网页对 /api/config 的轮询。
+ * 消息均为 JSON 文本帧：
+ * - 设备发出 {"type":"full"|"patch","seq":n,"vars":{...},"refresh":{...},"config":{...}}，
+ *   连接后的第一条为 full，之后只包含变化的部分：vars 中为变化的界面变量，config 中为
+ *   变化的配置分组（与 GET /api/config 的顶层字段相同，每组整体替换），refresh 为面板
+ *   刷新状态。客户端按 JSON Merge Patch 合并即可。
+ * - 客户端发送 {"config":{...}}，格式与 POST /api/config 的请求体相同，设备应用后回复
+ *   {"type":"ack","ok":true}，变化的配置随后推送给所有连接（包括发送者）。
+ *
+ * 界面变量与刷新状态在有连接时每秒比对一次（变量读取一致的快照并比较版本号，刷新状态
+ * 只保存 CRC32），配置在被修改时比对。
+ * 每个连接只记录待发送项的位图，套接字不可写时不阻塞 HTTP 服务器任务，变化合并到
+ * 下一条消息；持续不可写超过 LIVE_SYNC_STALL_MS 的连接被关闭。可写时发送超过约 2.8 KB 的
+ * 消息仍可能等待，最多 2 * WEBSERVER_SEND_WAIT_S 秒，超时的连接同样被关闭。
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_http_server.h"
+
+/** @brief 最多同时连接的客户端数 */
+#define LIVE_SYNC_MAX_CLIENTS 3
+/** @brief 界面变量与刷新状态的比对周期（毫秒） */
+#define LIVE_SYNC_POLL_MS 1000
+/** @brief 套接字持续不可写多久后关闭连接（毫秒） */
+#define LIVE_SYNC_STALL_MS 30000
+/** @brief 客户端消息的最大长度 */
+#define LIVE_SYNC_RX_MAX 1024
+
+/**
+ * @brief 单个连接的统计
+ */
+typedef struct {
+    int fd;               ///< 套接字
+    uint32_t messages;    ///< 发送的消息数
+    uint32_t bytes;       ///< 发送的字节数
+    uint32_t deferred;    ///< 因套接字不可写而推迟发送的次数
+    uint32_t cpu_us;      ///< 为该连接生成、发送消息与处理其补丁的累计耗时（微秒）
+    uint32_t connected_s; ///< 已连接时长（秒）
+} live_sync_client_stats_t;
+
+/**
+ * @brief 实时同步统计
+ */
+typedef struct {
+    uint8_t clients;         ///< 当前连接数
+    uint32_t messages;       ///< 发送的消息总数
+    uint64_t bytes;          ///< 发送的总字节数
+    uint32_t deferred;       ///< 推迟发送的总次数
+    uint32_t dropped;        ///< 因持续不可写或发送失败而关闭的连接数
+    uint32_t rejected;       ///< 超过连接上限被拒绝的握手数
+    uint32_t patches;        ///< 收到并应用的配置补丁数
+    uint32_t bad_patches;    ///< 无效或保存失败的配置补丁数
+    uint32_t polls;          ///< 比对次数
+    uint64_t poll_us;        ///< 比对累计耗时（微秒），由所有连接共同承担
+    int32_t heap_per_client; ///< 估算的每个连接占用的内部 RAM（字节），无连接时为 -1
+    /** @brief 各连接的统计，前 clients 项有效 */
+    live_sync_client_stats_t peers[LIVE_SYNC_MAX_CLIENTS];
+} live_sync_stats_t;
+
+/**
+ * @brief 在 HTTP 服务器上注册 /api/live
+ *
+ * @param server HTTP 服务器句柄
+ * @return ESP_OK 成功，ESP_ERR_NO_MEM 内存不足，否则为创建比对定时器的错误码
+ */
+esp_err_t live_sync_register(httpd_handle_t server);
+
+/**
+ * @brief HTTP 服务器停止前调用，停止比对并清除连接
+ */
+void live_sync_unregister(void);
+
+/**
+ * @brief 通知配置已修改（可在任意任务中调用）
+ *
+ * 比对在 HTTP 服务器任务中进行，只推送实际变化的配置分组。
+ */
+void live_sync_notify_config(void);
+
+/**
+ * @brief 获取实时同步统计
+ *
+ * @param stats 输出统计
+ */
+void live_sync_get_stats(live_sync_stats_t *stats);
@@ -13,6 +13,17 @@
 #include "lv_port_disp.h"
 #include "lv_port_indev.h"
 
+/**
+ * @brief 面板刷新状态
+ */
+typedef struct {
+    bool pending;     ///< 帧缓冲有尚未刷到面板的修改
+    bool refreshing;  ///< 面板正在刷新
+    bool last_full;   ///< 最近一次刷新是否为全刷
+    uint32_t count;   ///< 开机以来的刷新次数
+    int partial_left; ///< 下一次全刷之前还可以局刷的次数
+} lvgl_refresh_state_t;
+
 /**
  * @brief 初始化电子墨水屏显示
  *
@@ -24,4 +35,11 @@ void lvgl_init_epaper_display(void);
  * @brief 获取 LVGL 互斥锁
  * @return LVGL 互斥锁句柄
  */
-SemaphoreHandle_t lvgl_get_mutex(void);
\ No newline at end of file
+SemaphoreHandle_t lvgl_get_mutex(void);
+
+/**
+ * @brief 获取面板刷新状态（不加锁，各字段分别读取）
+ *
+ * @param state 输出状态
+ */
+void lvgl_get_refresh_state(lvgl_refresh_state_t *state);
\ No newline at end of file
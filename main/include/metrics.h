@@ -0,0 +1,80 @@
+/**
+ * @file metrics.h
+ * @brief 运行时指标（计数器、仪表、固定分桶直方图）
+ *
+ * 指标在编译期登记，存储为静态的 32 位原子变量，记录时只做一次原子加法，不加锁、不分配内存，
+ * 可以在渲染路径和中断之外的任意任务中常开。GET /api/metrics 以 Prometheus 文本格式导出。
+ *
+ * 直方图记录微秒，导出时换算为秒；所有直方图共用一组从 100 us 到 10 s 的分桶边界。
+ * 同一指标可以有多个实例（如按接口区分的 HTTP 耗时），以标签区分。
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+/**
+ * @brief 指标
+ */
+typedef enum {
+    METRIC_LV_TIMER = 0,  ///< 直方图：lv_timer_handler 单次耗时
+    METRIC_UI_TICK,       ///< 直方图：ui_tick（流程与控件绑定更新）单次耗时
+    METRIC_DISP_FLUSH,    ///< 直方图：disp_flush 耗时（含抖动）
+    METRIC_EPD_TRANSFER,  ///< 直方图：一次刷新中位图传输到面板的耗时
+    METRIC_EPD_BUSY,      ///< 直方图：一次刷新中等待面板 BUSY 的耗时
+    METRIC_EPD_REFRESH,   ///< 计数器：面板刷新次数，按全刷 / 局刷区分
+    METRIC_HTTP_REQUEST,  ///< 直方图：上游 HTTP 请求耗时，按接口（net_endpoint_t）区分
+    METRIC_HEAP_FREE,     ///< 仪表：空闲堆内存，按内部 RAM / PSRAM 区分
+    METRIC_HEAP_LARGEST,  ///< 仪表：最大空闲块
+    METRIC_HEAP_MIN_FREE, ///< 仪表：开机以来的最低空闲堆内存
+    METRIC_STACK_FREE,    ///< 仪表：任务栈高水位（剩余的最少字节数），按任务区分
+    METRIC_COUNT,
+} metric_id_t;
+
+/** @brief METRIC_EPD_REFRESH 的实例 */
+#define METRIC_REFRESH_FULL 0
+#define METRIC_REFRESH_PARTIAL 1
+
+/**
+ * @brief 导出时的输出回调
+ *
+ * @param ctx 调用者上下文
+ * @param data 文本
+ * @param len 长度
+ * @return ESP_OK 继续，其他值中止导出
+ */
+typedef esp_err_t (*metrics_write_fn)(void *ctx, const char *data, size_t len);
+
+/**
+ * @brief 计数器加一
+ *
+ * @param id 指标
+ * @param index 实例序号，无标签的指标为 0
+ */
+void metrics_inc(metric_id_t id, uint8_t index);
+
+/**
+ * @brief 设置仪表的值
+ */
+void metrics_set(metric_id_t id, uint8_t index, uint32_t value);
+
+/**
+ * @brief 向直方图记录一次耗时
+ *
+ * @param id 指标
+ * @param index 实例序号
+ * @param us 耗时（微秒），负值按 0 记录
+ */
+void metrics_observe(metric_id_t id, uint8_t index, int64_t us);
+
+/**
+ * @brief 采样堆与任务栈后，以 Prometheus 文本格式导出所有指标
+ *
+ * @param write 输出回调，每次传入一行或多行完整文本
+ * @param ctx 回调上下文
+ * @return ESP_OK 成功，否则为回调返回的错误码
+ */
+esp_err_t metrics_write(metrics_write_fn write, void *ctx);
@@ -0,0 +1,64 @@
+/**
+ * @file mqtt_push.h
+ * @brief MQTT 推送接入（HTTP 轮询之外的数据来源）
+ *
+ * 设备以持久会话（clean session = 0）连接配置的 broker，以 QoS 1 订阅：
+ * - <prefix>/var/<name>：设置界面变量（如 yiyan、weather_temp），建议以 retain 发布
+ * - <prefix>/cmd/<name>：执行命令，目前支持 refresh（负载为网络调度器任务名），不要 retain
+ *
+ * 离线期间 broker 为持久会话保留 QoS 1 消息，重连后补发；设备发布的消息进入 esp-mqtt 的
+ * outbox，连接恢复后重传。每条变量应用后向 <prefix>/ack/<name> 回显负载，便于测量推送延迟。
+ *
+ * 同一模块实现 EEZ Flow 的 eez_mqtt_* 钩子，流程中的 MQTT 组件基于 esp-mqtt 运行。流程连接同样
+ * 使用持久会话，客户端 ID 为 espaperplay-<MAC 后三字节>-flow<序号>，序号取最小的空闲值。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+/** @brief 默认主题前缀 */
+#define MQTT_PUSH_DEFAULT_PREFIX "espaperplay"
+/** @brief 单条消息负载上限（字节），超过时丢弃 */
+#define MQTT_PUSH_PAYLOAD_MAX 1024
+/** @brief 离线时 outbox 最多缓存的字节数 */
+#define MQTT_PUSH_OUTBOX_LIMIT 4096
+/** @brief 保活间隔（秒），省电模式下决定空闲时的唤醒频率 */
+#define MQTT_PUSH_KEEPALIVE_S 120
+
+/**
+ * @brief MQTT 推送统计
+ */
+typedef struct {
+    bool enabled;         ///< 是否配置了 broker
+    bool connected;       ///< 当前是否已连接
+    bool session_present; ///< 最近一次连接时 broker 是否保留了会话
+    uint32_t connects;    ///< 连接成功次数
+    uint32_t disconnects; ///< 断开次数
+    uint32_t messages;    ///< 收到的消息数
+    uint32_t vars;        ///< 应用的变量数
+    uint32_t commands;    ///< 执行的命令数
+    uint32_t dropped;     ///< 未知主题、超长或无效的消息数
+    int64_t last_msg_ms;  ///< 距最近一条消息的时间（毫秒），-1 表示尚未收到
+} mqtt_push_stats_t;
+
+/**
+ * @brief 按配置启动 MQTT 推送客户端
+ *
+ * 需在网络初始化之后调用；未配置 broker 地址时不启动，返回 ESP_OK。
+ * 常驻连接需要射频一直保持关联，射频策略为 WINDOWED 时不启动（见 radio.h）。
+ *
+ * @return ESP_OK 成功或未启用，ESP_ERR_NOT_SUPPORTED 射频策略为 WINDOWED，
+ *         其他错误码表示客户端创建失败
+ */
+esp_err_t mqtt_push_start(void);
+
+/**
+ * @brief 获取 MQTT 推送统计
+ *
+ * @param stats 输出统计
+ */
+void mqtt_push_get_stats(mqtt_push_stats_t *stats);
@@ -0,0 +1,151 @@
+/**
+ * @file net_health.h
+ * @brief 上游接口熔断与退避
+ *
+ * 每个上游接口（天气、定位、一言）维护一个熔断器：
+ * - CLOSED：正常请求，连续失败达到阈值后转为 OPEN；
+ * - OPEN：不发请求，退避时间到后转为 HALF_OPEN；
+ * - HALF_OPEN：只放行一次探测请求，成功则恢复 CLOSED，失败则退避时间翻倍后回到 OPEN。
+ *
+ * 退避时间按指数增长并带随机抖动，避免接口故障期间反复唤醒射频。
+ * 鉴权失败（401/403）与限流（429）一次即熔断，因为立即重试不会有不同结果。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_http_client.h"
+
+/** @brief 连续失败多少次后熔断 */
+#define NET_HEALTH_FAIL_THRESHOLD 3
+/** @brief 首次熔断的退避时间 */
+#define NET_HEALTH_BACKOFF_BASE_MS (30 * 1000)
+/** @brief 退避时间上限 */
+#define NET_HEALTH_BACKOFF_MAX_MS (30 * 60 * 1000)
+/** @brief 鉴权失败时的首次退避时间（通常需要用户修改配置） */
+#define NET_HEALTH_BACKOFF_AUTH_MS (10 * 60 * 1000)
+/** @brief 限流时的首次退避时间 */
+#define NET_HEALTH_BACKOFF_RATE_MS (5 * 60 * 1000)
+/** @brief 退避时间的随机抖动比例（百分比，正负） */
+#define NET_HEALTH_JITTER_PCT 20
+
+/**
+ * @brief 上游接口
+ */
+typedef enum {
+    NET_EP_WEATHER = 0, ///< 和风天气
+    NET_EP_LOCATION,    ///< IP 定位
+    NET_EP_YIYAN,       ///< 一言
+    NET_EP_COUNT,
+} net_endpoint_t;
+
+/**
+ * @brief 熔断器状态
+ */
+typedef enum {
+    NET_HEALTH_CLOSED = 0, ///< 正常
+    NET_HEALTH_OPEN,       ///< 熔断中，不发请求
+    NET_HEALTH_HALF_OPEN,  ///< 放行一次探测请求
+} net_health_state_t;
+
+/**
+ * @brief 请求失败分类
+ */
+typedef enum {
+    NET_FAIL_NONE = 0, ///< 成功
+    NET_FAIL_CONNECT,  ///< DNS 或 TCP 连接失败
+    NET_FAIL_TLS,      ///< TLS 握手或证书错误
+    NET_FAIL_TIMEOUT,  ///< 连接或读取超时
+    NET_FAIL_HTTP_5XX, ///< 服务端错误
+    NET_FAIL_HTTP_4XX, ///< 其他客户端错误
+    NET_FAIL_AUTH,     ///< 401/403，立即熔断
+    NET_FAIL_RATE,     ///< 429，立即熔断
+    NET_FAIL_PARSE,    ///< 响应无法解析
+    NET_FAIL_OTHER,    ///< 其他错误
+    NET_FAIL_COUNT,
+} net_fail_t;
+
+/**
+ * @brief 单个接口的健康状态
+ */
+typedef struct {
+    const char *name;              ///< 接口名
+    net_health_state_t state;      ///< 熔断器状态
+    uint32_t consecutive_failures; ///< 连续失败次数
+    net_fail_t last_fail;          ///< 最近一次失败的分类
+    int last_status;               ///< 最近一次失败的 HTTP 状态码（0 表示无响应）
+    uint32_t backoff_ms;           ///< 当前退避时间（不含抖动）
+    int64_t retry_in_ms;           ///< 距离下一次探测的时间，非 OPEN 时为 0
+    uint32_t successes;            ///< 成功次数
+    uint32_t failures;             ///< 失败次数
+    uint32_t trips;                ///< 熔断次数
+    uint32_t skipped;              ///< 熔断期间跳过的请求数
+} net_health_info_t;
+
+/**
+ * @brief 初始化熔断器
+ *
+ * @return ESP_OK 成功，ESP_ERR_NO_MEM 内存不足
+ */
+esp_err_t net_health_init(void);
+
+/**
+ * @brief 请求前检查接口是否允许访问
+ *
+ * OPEN 状态且退避时间已到时转为 HALF_OPEN 并放行本次请求；
+ * 放行后必须调用 net_health_report() 报告结果。
+ *
+ * @param ep 接口
+ * @return true 可以发起请求，false 熔断中（调用方应返回 ESP_ERR_NOT_ALLOWED）
+ */
+bool net_health_allow(net_endpoint_t ep);
+
+/**
+ * @brief 报告一次请求的结果
+ *
+ * @param ep 接口
+ * @param fail 失败分类，NET_FAIL_NONE 表示成功
+ * @param status HTTP 状态码（0 表示无响应），仅用于记录
+ */
+void net_health_report(net_endpoint_t ep, net_fail_t fail, int status);
+
+/**
+ * @brief 根据 HTTP 客户端的执行结果对失败分类
+ *
+ * 需在 http_pool_release() 之前调用，以便读取 TLS 错误。
+ * 2xx 与 304 视为成功；响应解析失败由调用方另行报告 NET_FAIL_PARSE。
+ *
+ * @param client HTTP 客户端
+ * @param err http_pool_perform() 的返回值
+ * @param status HTTP 状态码
+ * @return 失败分类
+ */
+net_fail_t net_health_classify(esp_http_client_handle_t client, esp_err_t err, int status);
+
+/**
+ * @brief 将所有接口恢复为 CLOSED
+ *
+ * 配置（如 API 密钥）修改后调用，使新配置立即生效。
+ */
+void net_health_reset_all(void);
+
+/**
+ * @brief 获取接口的健康状态
+ *
+ * @param ep 接口
+ * @param info 输出
+ */
+void net_health_get(net_endpoint_t ep, net_health_info_t *info);
+
+/**
+ * @brief 熔断器状态名（"closed"/"open"/"half_open"）
+ */
+const char *net_health_state_name(net_health_state_t state);
+
+/**
+ * @brief 失败分类名
+ */
+const char *net_health_fail_name(net_fail_t fail);
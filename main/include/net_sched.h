@@ -0,0 +1,141 @@
+/**
+ * @file net_sched.h
+ * @brief 网络任务调度器
+ *
+ * 所有联网任务（天气、一言等）由同一个工作任务按截止时间依次执行，取代各服务独立的
+ * FreeRTOS 任务：
+ * - 周期任务每次完成后按周期加随机抖动计算下一次截止时间；
+ * - 某个任务到期时，合并窗口内即将到期的其他任务会被提前、在同一轮中连续执行，
+ *   使射频集中工作一段时间后长时间空闲；
+ * - 同一轮中按优先级执行，失败的任务按指数退避重试有限次数；
+ * - 一轮中第一个需要网络的任务执行前才申请射频（radio_acquire()），整轮结束后释放；
+ * - 支持立即触发已注册的任务，以及提交一次性任务（如 Web 界面发起的刷新）。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+/** @brief 最大任务数（含一次性任务） */
+#define NET_SCHED_MAX_JOBS 8
+/** @brief 任务名最大长度（含结束符） */
+#define NET_SCHED_NAME_MAX 16
+/** @brief 合并窗口：该时间内即将到期的任务与当前任务在同一轮中执行 */
+#define NET_SCHED_COALESCE_MS 60000
+/** @brief 工作任务栈大小 */
+#define NET_SCHED_STACK_SIZE 8192
+
+/** @brief 任务 ID，小于 0 表示无效 */
+typedef int net_job_id_t;
+
+/**
+ * @brief 任务函数
+ *
+ * @param arg 注册时传入的参数
+ * @return ESP_OK 成功，其他值按重试策略重试
+ */
+typedef esp_err_t (*net_job_fn_t)(void *arg);
+
+/**
+ * @brief 任务优先级（同一轮中高优先级先执行）
+ */
+typedef enum {
+    NET_JOB_PRIO_LOW = 0,
+    NET_JOB_PRIO_NORMAL,
+    NET_JOB_PRIO_HIGH,
+} net_job_prio_t;
+
+/**
+ * @brief 任务配置
+ */
+typedef struct {
+    const char *name;        ///< 任务名
+    net_job_fn_t fn;         ///< 任务函数
+    void *arg;               ///< 任务参数
+    uint32_t period_ms;      ///< 执行周期，0 表示一次性任务
+    uint32_t jitter_ms;      ///< 每个周期附加的随机延迟上限
+    uint32_t first_delay_ms; ///< 首次执行前的延迟
+    net_job_prio_t priority; ///< 优先级
+    uint8_t max_retries;     ///< 失败后的最大重试次数
+    uint32_t retry_delay_ms; ///< 首次重试延迟，之后每次翻倍
+    bool offline;            ///< 不使用网络，执行前不申请射频（如关闭射频本身）
+} net_job_config_t;
+
+/**
+ * @brief 调度统计
+ */
+typedef struct {
+    uint32_t bursts;       ///< 执行轮数（每轮射频连续工作一次）
+    uint32_t jobs_run;     ///< 任务执行次数
+    uint32_t coalesced;    ///< 因合并窗口提前执行的次数
+    uint32_t retries;      ///< 重试次数
+    uint32_t failures;     ///< 重试耗尽后的失败次数
+    uint32_t rejected;     ///< 因任务槽已满被拒绝的任务数
+    int64_t busy_us_total; ///< 各轮执行累计耗时（微秒）
+    int64_t last_burst_us; ///< 最近一轮执行耗时（微秒）
+} net_sched_stats_t;
+
+/**
+ * @brief 初始化调度器并创建工作任务
+ *
+ * 工作任务在网络与时间初始化完成（time_wait_ready()）之后才开始执行任务。
+ *
+ * @return ESP_OK 成功
+ */
+esp_err_t net_sched_init(void);
+
+/**
+ * @brief 注册任务
+ *
+ * @param config 任务配置
+ * @return 任务 ID，失败返回 -1
+ */
+net_job_id_t net_sched_add(const net_job_config_t *config);
+
+/**
+ * @brief 按名称查找任务
+ *
+ * @param name 任务名
+ * @return 任务 ID，未找到返回 -1
+ */
+net_job_id_t net_sched_find(const char *name);
+
+/**
+ * @brief 立即执行已注册的任务
+ *
+ * 任务正在执行时，在本次完成后再执行一次。
+ *
+ * @param id 任务 ID
+ * @return ESP_OK 成功，ESP_ERR_NOT_FOUND 任务不存在
+ */
+esp_err_t net_sched_trigger(net_job_id_t id);
+
+/**
+ * @brief 按名称立即执行已注册的任务
+ *
+ * @param name 任务名
+ * @return ESP_OK 成功，ESP_ERR_NOT_FOUND 任务不存在
+ */
+esp_err_t net_sched_trigger_by_name(const char *name);
+
+/**
+ * @brief 提交一次性任务，尽快执行
+ *
+ * @param name 任务名
+ * @param fn 任务函数
+ * @param arg 任务参数
+ * @param priority 优先级
+ * @return ESP_OK 成功，ESP_ERR_NO_MEM 任务槽已满
+ */
+esp_err_t net_sched_submit(const char *name, net_job_fn_t fn, void *arg,
+                           net_job_prio_t priority);
+
+/**
+ * @brief 获取调度统计
+ *
+ * @param stats 输出统计
+ */
+void net_sched_get_stats(net_sched_stats_t *stats);
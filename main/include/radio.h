@@ -0,0 +1,123 @@
+/**
+ * @file radio.h
+ * @brief 射频（WiFi）使用策略
+ *
+ * 联网的使用者只有周期任务与偶尔的网页配置，射频不必一直保持关联：
+ * - ALWAYS_ON：始终保持关联（默认省电模式），Web 服务器常驻；
+ * - MODEM_SLEEP：保持关联，按配置的 DTIM 监听间隔休眠，Web 服务器仅在触摸请求后开启；
+ * - WINDOWED：两次联网窗口之间完全关闭 WiFi，使用时由 radio_acquire() 打开。
+ *
+ * 所有联网使用者通过 radio_acquire()/radio_release() 引用计数，最后一个使用者释放后
+ * 短暂停留再关闭射频，使同一轮中的连续请求共用一次连接。关闭射频由网络调度器执行。
+ * 非 ALWAYS_ON 模式下，长按屏幕开启一段时间的 Web 配置会话。
+ *
+ * 常驻连接不持有引用：
+ * - MQTT 推送与 EEZ 流程中的 MQTT 连接需要一直保持关联，只在 ALWAYS_ON 与 MODEM_SLEEP
+ *   模式下运行（这两种模式从不关闭射频）；WINDOWED 模式下 mqtt_push_start() 不启动客户端，
+ *   流程中的连接请求返回错误。
+ * - SNTP 在后台按固定间隔轮询。WINDOWED 模式下只有落在联网窗口内的轮询能成功
+ *   （首次同步在开机保持时间 RADIO_BOOT_HOLD_MS 内完成），其余时间由漂移补偿维持走时。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+/** @brief 默认 DTIM 监听间隔（MODEM_SLEEP 模式） */
+#define RADIO_DEFAULT_LISTEN_INTERVAL 3
+/** @brief 打开射频后等待获取 IP 的超时时间 */
+#define RADIO_CONNECT_TIMEOUT_MS 15000
+/** @brief 最后一个使用者释放后保持射频开启的时间 */
+#define RADIO_LINGER_MS 3000
+/** @brief 开机后保持射频开启的时间（首次时间同步与首轮任务） */
+#define RADIO_BOOT_HOLD_MS 60000
+/** @brief 触摸开启的 Web 配置会话时长 */
+#define RADIO_WEB_SESSION_MS (5 * 60 * 1000)
+/** @brief 按小时统计射频开启时长的小时数 */
+#define RADIO_STATS_HOURS 24
+
+/**
+ * @brief 射频策略
+ */
+typedef enum {
+    RADIO_MODE_ALWAYS_ON = 0, ///< 始终关联，Web 服务器常驻
+    RADIO_MODE_MODEM_SLEEP,   ///< 始终关联，按 DTIM 监听间隔休眠
+    RADIO_MODE_WINDOWED,      ///< 仅在联网窗口内开启
+    RADIO_MODE_COUNT,
+} radio_mode_t;
+
+/**
+ * @brief 射频统计
+ */
+typedef struct {
+    radio_mode_t mode;                      ///< 当前策略
+    bool on;                                ///< WiFi 是否开启
+    uint8_t refs;                           ///< 当前使用者数量
+    bool web_session;                       ///< 触摸开启的 Web 会话是否进行中
+    uint32_t wakeups;                       ///< WINDOWED 模式下打开射频的次数
+    uint32_t timeouts;                      ///< 打开射频后未能在超时内获取 IP 的次数
+    int64_t last_connect_ms;                ///< 最近一次打开射频到获取 IP 的耗时
+    int64_t on_ms_total;                    ///< 开机以来射频开启总时长
+    uint32_t on_ms_hour[RADIO_STATS_HOURS]; ///< 每小时射频开启时长，[0] 为当前小时
+} radio_stats_t;
+
+/**
+ * @brief 按配置设置射频策略
+ *
+ * 在 wifi_init() 之前调用，设置省电模式与 DTIM 监听间隔。
+ *
+ * @return ESP_OK 成功，ESP_ERR_NO_MEM 内存不足
+ */
+esp_err_t radio_init(void);
+
+/**
+ * @brief 网络初始化完成后启用射频策略
+ *
+ * ALWAYS_ON 模式启动 Web 服务器；WINDOWED 模式在开机保持时间后关闭射频。
+ */
+void radio_start(void);
+
+/**
+ * @brief 申请使用射频，必要时打开 WiFi 并等待获取 IP
+ *
+ * 可能阻塞到 RADIO_CONNECT_TIMEOUT_MS，不能在定时器或 LVGL 回调中调用。
+ * 返回 ESP_OK 时必须调用 radio_release()。
+ *
+ * @param who 使用者名称（日志用）
+ * @return ESP_OK 已联网，ESP_ERR_TIMEOUT 超时未获取 IP（已自动释放）
+ */
+esp_err_t radio_acquire(const char *who);
+
+/**
+ * @brief 释放射频
+ *
+ * @param who 使用者名称（日志用）
+ */
+void radio_release(const char *who);
+
+/**
+ * @brief 请求开启（或延长）Web 配置会话
+ *
+ * 非阻塞，可在触摸回调中调用；ALWAYS_ON 模式下 Web 服务器常驻，无操作。
+ */
+void radio_request_web_session(void);
+
+/**
+ * @brief 获取当前射频策略
+ */
+radio_mode_t radio_get_mode(void);
+
+/**
+ * @brief 获取射频统计
+ *
+ * @param stats 输出统计
+ */
+void radio_get_stats(radio_stats_t *stats);
+
+/**
+ * @brief 射频策略名（"always_on"/"modem_sleep"/"windowed"）
+ */
+const char *radio_mode_name(radio_mode_t mode);
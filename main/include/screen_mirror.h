@@ -0,0 +1,78 @@
+/**
+ * @file screen_mirror.h
+ * @brief 屏幕镜像：帧缓冲快照与脏区增量推送
+ *
+ * GET /api/screen 返回当前的 1bpp 虚拟帧缓冲，默认 PNG，?format=pbm 时为 PBM (P4)。
+ * 按行带加锁读取并逐块编码发送，不分配整帧大小的临时缓冲。
+ *
+ * WebSocket /api/screen/ws 推送每次屏幕刷新的脏区：disp_flush 只记录脏矩形，屏幕刷新任务
+ * 在帧送往面板后统计变化像素并编码增量，由 HTTP 服务器任务异步发送给所有客户端。
+ *
+ * 消息为二进制帧，多字节字段小端：
+ * - 头部：u8 类型（0 关键帧，1 增量）、u8 矩形数、u16 序号、u32 本次刷新变化的像素数
+ * - 每个矩形：u16 x、u16 y、u16 w、u16 h、u16 数据长度，随后是 PackBits 编码的像素数据
+ *
+ * x 与 w 按 8 像素对齐；像素数据为矩形内逐行的 1bpp 字节（高位在左，1 为黑）。
+ * 客户端连接时以及增量因发送未完成而被跳过后，下一帧为覆盖全屏的关键帧。
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_http_server.h"
+
+/** @brief 最多同时连接的镜像客户端数 */
+#define SCREEN_MIRROR_MAX_CLIENTS 2
+/** @brief 一次刷新最多记录的脏矩形数，超过时合并为包围盒 */
+#define SCREEN_MIRROR_MAX_RECTS 8
+
+/**
+ * @brief 屏幕镜像统计
+ */
+typedef struct {
+    uint8_t clients;        ///< 当前连接的客户端数
+    uint32_t refreshes;     ///< 有脏区的屏幕刷新次数
+    uint32_t frames;        ///< 发送的消息数（含关键帧）
+    uint32_t keyframes;     ///< 发送的关键帧数
+    uint32_t skipped;       ///< 上一帧仍在发送而改为关键帧的次数
+    uint32_t changed_last;  ///< 最近一次刷新变化的像素数
+    uint64_t changed_total; ///< 累计变化的像素数
+    uint64_t raw_bytes;     ///< 编码前的像素字节数
+    uint64_t sent_bytes;    ///< 编码后发送的字节数（每个客户端分别计入）
+} screen_mirror_stats_t;
+
+/**
+ * @brief 记录一个脏矩形（在 LVGL 刷新回调中调用，持有 LVGL 互斥锁）
+ *
+ * 只保存坐标，不复制像素。
+ */
+void screen_mirror_mark(int x1, int y1, int x2, int y2);
+
+/**
+ * @brief 提交本次刷新的脏区（屏幕刷新任务在帧送往面板后调用）
+ *
+ * 统计变化像素；有客户端时编码增量并交给 HTTP 服务器任务发送。
+ */
+void screen_mirror_commit(void);
+
+/**
+ * @brief 在 HTTP 服务器上注册 /api/screen 与 /api/screen/ws
+ *
+ * @param server HTTP 服务器句柄
+ * @return ESP_OK 成功，ESP_ERR_NO_MEM 内存不足
+ */
+esp_err_t screen_mirror_register(httpd_handle_t server);
+
+/**
+ * @brief HTTP 服务器停止前调用，清除客户端
+ */
+void screen_mirror_unregister(void);
+
+/**
+ * @brief 获取屏幕镜像统计
+ *
+ * @param stats 输出统计
+ */
+void screen_mirror_get_stats(screen_mirror_stats_t *stats);
@@ -1,5 +1,99 @@
+/**
+ * @file sntp.h
+ * @brief 系统时间：开机恢复、后台 SNTP 同步与漂移补偿
+ *
+ * 开机时立即从 RTC（软件复位后系统时间仍在运行）或 NVS（上次同步时保存的时间）恢复时间，
+ * 不等待网络；联网后 SNTP 在后台同步，首次同步成功后时间才视为可信，并通知界面。
+ * 每次同步时根据偏差学习时钟漂移，两次同步之间按学习到的漂移率平滑修正系统时间。
+ */
+
 #pragma once
 
-void obtain_time(void);
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief 早于该时间（2024-01-01）的系统时间视为无效 */
+#define TIME_MIN_VALID 1704067200
+/** @brief 默认 NTP 服务器列表（逗号分隔） */
+#define TIME_DEFAULT_NTP_SERVERS "ntp.aliyun.com,cn.pool.ntp.org"
+/** @brief 默认时区（POSIX TZ 格式） */
+#define TIME_DEFAULT_TIMEZONE "CST-8"
+
+/**
+ * @brief 当前系统时间的来源
+ */
+typedef enum {
+    TIME_SOURCE_NONE = 0, ///< 无有效时间
+    TIME_SOURCE_RTC,      ///< 复位前的系统时间（RTC 定时器保持）
+    TIME_SOURCE_NVS,      ///< 上次同步时保存到 NVS 的时间（掉电期间的时长丢失）
+    TIME_SOURCE_NTP,      ///< 本次启动后已通过 SNTP 同步，可信
+} time_source_t;
+
+/**
+ * @brief 时间同步回调
+ *
+ * 在 SNTP 任务中调用，不应执行耗时操作。
+ *
+ * @param first 是否为本次启动后的首次同步（时间从此变为可信）
+ */
+typedef void (*time_sync_cb_t)(bool first);
+
+/**
+ * @brief 开机恢复时间并应用时区
+ *
+ * 在 NVS 初始化之后、界面启动之前调用，不访问网络。
+ */
+void time_restore(void);
+
+/**
+ * @brief 启动后台 SNTP 同步
+ *
+ * 在 WiFi 连接之后调用，立即返回，不等待同步完成。
+ */
+void time_init(void);
+
+/**
+ * @brief 按当前配置重新设置 NTP 服务器与时区
+ *
+ * 配置保存后调用；SNTP 已启动时以新的服务器列表重新开始同步。
+ */
+void time_apply_config(void);
+
+/**
+ * @brief 等待网络就绪
+ *
+ * time_init() 在 WiFi 连接之后执行，返回时网络已可用，时间不一定已同步。
+ */
+void time_wait_ready(void);
+
+/**
+ * @brief 等待时间变为可信
+ *
+ * @param timeout_ms 超时时间（毫秒）
+ * @return true 已同步，false 超时
+ */
+bool time_wait_synced(uint32_t timeout_ms);
+
+/**
+ * @brief 时间是否可信（本次启动后已通过 SNTP 同步）
+ */
+bool time_is_authoritative(void);
+
+/**
+ * @brief 获取当前系统时间的来源
+ */
+time_source_t time_get_source(void);
+
+/**
+ * @brief 获取学习到的时钟漂移
+ *
+ * @return 漂移率（ppm），正值表示本地时钟偏慢
+ */
+float time_get_drift_ppm(void);
 
-void time_init(void);
\ No newline at end of file
+/**
+ * @brief 注册时间同步回调（只保留一个）
+ *
+ * @param cb 回调函数，NULL 表示取消
+ */
+void time_set_sync_callback(time_sync_cb_t cb);
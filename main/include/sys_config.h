@@ -1,6 +1,7 @@
 #pragma once
 
 #include "dither.h"
+#include <stdbool.h>
 #include <stdint.h>
 
 typedef struct {
@@ -9,6 +10,10 @@ typedef struct {
     struct {
         char ssid[33];
         char password[65];
+        char static_ip[16]; // 静态 IP，为空时使用 DHCP
+        char netmask[16];   // 子网掩码，为空时使用 255.255.255.0
+        char gateway[16];   // 网关
+        char dns[16];       // DNS 服务器，为空时使用网关
     } wifi;
 
     struct {
@@ -19,12 +24,44 @@ typedef struct {
     struct {
         char id[64];
         char key[64];
+        char base_url[128]; // 接口地址（含协议），为空时使用 IP_LOCATION_DEFAULT_BASE_URL
     } ip_location;
 
+    struct {
+        bool manual;         // 使用手动配置的位置，跳过 IP 定位
+        char name[64];       // 手动位置名称
+        double latitude;     // 手动位置纬度
+        double longitude;    // 手动位置经度
+        int cache_ttl_hours; // IP 定位结果缓存有效期（小时）
+    } location;
+
     struct {
         char city[64];
-        char api_host[128];
+        char api_host[128]; // 域名，或带协议的地址（如 http://192.168.1.10:8080）
         char api_key[64];
+        int stale_minutes;   // 开机恢复的天气快照超过该时长（分钟）后标记为过期
+        char locations[192]; // 额外位置，"名称,纬度,经度" 以分号分隔
     } weather;
 
+    struct {
+        char base_url[128]; // 接口地址（含协议），为空时使用 YIYAN_DEFAULT_BASE_URL
+    } yiyan;
+
+    struct {
+        char ntp_servers[128]; // NTP 服务器列表，逗号分隔，按顺序使用
+        char timezone[64];     // POSIX TZ 格式时区，如 CST-8
+    } time;
+
+    struct {
+        int radio_mode;      // 射频策略（radio_mode_t），重启后生效
+        int listen_interval; // MODEM_SLEEP 模式的 DTIM 监听间隔
+    } power;
+
+    struct {
+        char uri[128];         // broker 地址，如 mqtt://192.168.1.10:1883，为空时不启用推送
+        char username[64];     // 用户名，可为空
+        char password[64];     // 密码，可为空
+        char topic_prefix[64]; // 主题前缀，为空时使用 MQTT_PUSH_DEFAULT_PREFIX
+    } mqtt;
+
 } sys_config_t;
\ No newline at end of file
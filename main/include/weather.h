@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esp_err.h"
+#include <stdbool.h>
 #include <stdint.h>
 #include <time.h>
 
@@ -9,7 +10,7 @@ typedef struct {
     float feelslike;    // 体感温度，单位摄氏度
     uint16_t icon;      // 天气图标代码（支持100-9999）
     char text[32];      // 天气描述文本
-    char wind_dir[8];   // 风向
+    char wind_dir[16];  // 风向（如 "西北风"、"无持续风向"）
     uint8_t wind_scale; // 风力等级
     uint8_t humidity;   // 相对湿度，百分比
     float precip;       // 降水量，单位毫米
@@ -41,11 +42,11 @@ typedef struct {
     uint16_t icon_night;      // 夜间天气图标代码
     char text_night[16];      // 夜间天气描述
     uint16_t wind_360_day;    // 白天风向360度角
-    char wind_dir_day[8];     // 白天风向名称
+    char wind_dir_day[16];    // 白天风向名称
     char wind_scale_day[8];   // 白天风力等级，如 "1-2"
     uint8_t wind_speed_day;   // 白天风速，单位 km/h
     uint16_t wind_360_night;  // 夜间风向360度角
-    char wind_dir_night[8];   // 夜间风向名称
+    char wind_dir_night[16];  // 夜间风向名称
     char wind_scale_night[8]; // 夜间风力等级，如 "1-2"
     uint8_t wind_speed_night; // 夜间风速，单位 km/h
     uint8_t humidity;         // 相对湿度，百分比
@@ -66,6 +67,6 @@ typedef struct {
     weather_daily_t daily[10]; // 预报数据数组，最多支持10天
 } weather_forecast_t;
 
-esp_err_t get_weather_now(location_t *location, weather_now_t *weather_now);
+esp_err_t get_weather_now(location_t *location, weather_now_t *weather_now, bool *updated);
 esp_err_t get_weather_forecast(location_t *location, uint8_t days,
-                               weather_forecast_t *weather_forecast);
\ No newline at end of file
+                               weather_forecast_t *weather_forecast, bool *updated);
\ No newline at end of file
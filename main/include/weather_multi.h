@@ -0,0 +1,101 @@
+/**
+ * @file weather_multi.h
+ * @brief 多位置天气缓存
+ *
+ * 位置 0 为当前位置（手动配置或 IP 定位），其后为配置项 weather.locations 中的额外位置。
+ * 所有位置的实时天气与预报槽位在初始化时一次性分配在 PSRAM 中，运行期间内存占用固定。
+ * 一次刷新在同一个联网窗口内依次获取所有位置（同一主机，复用连接池中的同一条连接），
+ * 界面切换位置时直接读取槽位，不发起网络请求。
+ *
+ * 预报按需获取：某个位置的预报被 weather_multi_get_forecast() 读取过之后，刷新时才请求该位置的
+ * 预报；超过 WEATHER_FORECAST_IDLE_S 未被读取则停止请求，没有界面显示预报时不产生预报流量。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "ip_location.h"
+#include "weather.h"
+
+/** @brief 最多位置数（含当前位置） */
+#define WEATHER_MAX_LOCATIONS 4
+/** @brief 额外位置名称最大长度（含结束符） */
+#define WEATHER_LOCATION_NAME_MAX 32
+/** @brief 预报天数 */
+#define WEATHER_FORECAST_DAYS 3
+/** @brief 预报刷新间隔（秒），期间只刷新实时天气 */
+#define WEATHER_FORECAST_REFRESH_S (3 * 3600)
+/** @brief 预报超过该时间（秒）未被读取时停止刷新 */
+#define WEATHER_FORECAST_IDLE_S (2 * WEATHER_FORECAST_REFRESH_S)
+
+/**
+ * @brief 多位置天气统计
+ *
+ * 耗时为一次完整刷新（所有位置）的时间（毫秒），-1 表示尚未测得。
+ */
+typedef struct {
+    uint8_t count;           ///< 当前位置数（含当前位置）
+    uint8_t valid;           ///< 已有实时天气的位置数
+    uint32_t refreshes;      ///< 完整刷新次数
+    uint32_t requests;       ///< 发起的天气请求数（实时 + 预报）
+    uint32_t failures;       ///< 单个位置获取失败次数
+    int64_t last_refresh_ms; ///< 最近一次完整刷新耗时
+    int64_t max_refresh_ms;  ///< 最长一次完整刷新耗时
+    int64_t avg_refresh_ms;  ///< 平均完整刷新耗时
+} weather_multi_stats_t;
+
+/**
+ * @brief 分配位置槽位
+ *
+ * @return ESP_OK 成功，ESP_ERR_NO_MEM 内存不足
+ */
+esp_err_t weather_multi_init(void);
+
+/**
+ * @brief 依次刷新所有位置的天气（阻塞，在网络调度器中调用）
+ *
+ * 额外位置每次从配置中重新解析，位置变化的槽位被清空。接口熔断时中止本轮剩余的请求。
+ * 当前位置的数据更新后写入天气快照，供开机时恢复。
+ *
+ * @param current 当前位置，为 NULL 时（定位失败）保留该槽位原有数据，只刷新额外位置
+ * @param changed 输出参数，数据有更新的位置位图（bit i 对应位置 i），可为 NULL
+ * @return 当前位置的获取结果；current 为 NULL 时为首个额外位置的错误码，
+ *         ESP_ERR_NOT_ALLOWED 表示接口熔断中
+ */
+esp_err_t weather_multi_refresh(const location_t *current, uint32_t *changed);
+
+/**
+ * @brief 获取当前位置数（含当前位置）
+ */
+uint8_t weather_multi_count(void);
+
+/**
+ * @brief 读取位置的实时天气（不发起网络请求）
+ *
+ * @param index 位置序号
+ * @param weather_now 输出实时天气
+ * @param location 输出位置信息，可为 NULL
+ * @return ESP_OK 成功，ESP_ERR_NOT_FOUND 该位置尚无数据，ESP_ERR_INVALID_ARG 序号无效
+ */
+esp_err_t weather_multi_get(uint8_t index, weather_now_t *weather_now, location_t *location);
+
+/**
+ * @brief 读取位置的天气预报（不发起网络请求）
+ *
+ * 同时登记该位置的预报需求：首次读取返回 ESP_ERR_NOT_FOUND，下一轮刷新起获取该位置的预报。
+ *
+ * @param index 位置序号
+ * @param forecast 输出天气预报
+ * @return ESP_OK 成功，ESP_ERR_NOT_FOUND 该位置尚无预报，ESP_ERR_INVALID_ARG 序号无效
+ */
+esp_err_t weather_multi_get_forecast(uint8_t index, weather_forecast_t *forecast);
+
+/**
+ * @brief 获取多位置天气统计
+ *
+ * @param stats 输出统计
+ */
+void weather_multi_get_stats(weather_multi_stats_t *stats);
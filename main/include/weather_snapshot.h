@@ -0,0 +1,72 @@
+/**
+ * @file weather_snapshot.h
+ * @brief 天气 / 预报 / 位置快照的持久化
+ *
+ * 每次获取到新数据时写入 NVS，开机后在联网之前读出并恢复到界面变量，
+ * 使屏幕在 LVGL 初始化完成后立即显示上一次的有效数据，而不是等待网络请求完成。
+ * 每条记录带有结构版本号和保存时间，结构体布局变化后旧记录自动作废。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <time.h>
+
+#include "esp_err.h"
+#include "ip_location.h"
+#include "weather.h"
+
+/** @brief 快照结构版本，weather_now_t / weather_forecast_t / location_t 布局变化时递增 */
+#define WEATHER_SNAPSHOT_SCHEMA_VERSION 2
+/** @brief 默认过期时间（分钟），超过后界面将快照标记为过期 */
+#define WEATHER_SNAPSHOT_DEFAULT_STALE_MIN 180
+
+/**
+ * @brief 保存实时天气及其对应的位置
+ *
+ * 内容与已保存的记录相同时不写入 flash。
+ *
+ * @param weather_now 实时天气
+ * @param location 位置信息
+ * @return ESP_OK 成功
+ */
+esp_err_t weather_snapshot_save_now(const weather_now_t *weather_now, const location_t *location);
+
+/**
+ * @brief 保存天气预报
+ *
+ * @param forecast 天气预报
+ * @return ESP_OK 成功
+ */
+esp_err_t weather_snapshot_save_forecast(const weather_forecast_t *forecast);
+
+/**
+ * @brief 读取实时天气及其对应的位置
+ *
+ * @param weather_now 输出实时天气
+ * @param location 输出位置信息
+ * @param saved_at 输出保存时间，保存时系统时间未同步则为 0；可为 NULL
+ * @return ESP_OK 成功，ESP_ERR_NOT_FOUND 无快照或结构版本不匹配
+ */
+esp_err_t weather_snapshot_load_now(weather_now_t *weather_now, location_t *location,
+                                    time_t *saved_at);
+
+/**
+ * @brief 读取天气预报
+ *
+ * @param forecast 输出天气预报
+ * @param saved_at 输出保存时间，可为 NULL
+ * @return ESP_OK 成功，ESP_ERR_NOT_FOUND 无快照或结构版本不匹配
+ */
+esp_err_t weather_snapshot_load_forecast(weather_forecast_t *forecast, time_t *saved_at);
+
+/**
+ * @brief 判断快照是否过期
+ *
+ * 系统时间尚未同步（开机后 SNTP 完成前）时无法计算时长，按过期处理。
+ *
+ * @param timestamp 数据时间（保存时间或观测时间）
+ * @param stale_minutes 过期时间（分钟），不大于 0 时使用默认值
+ * @return true 已过期或无法判断
+ */
+bool weather_snapshot_is_stale(time_t timestamp, int stale_minutes);
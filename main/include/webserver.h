@@ -1,13 +1,59 @@
 #pragma once
 
+#include <stdint.h>
+
+#include "cJSON.h"
 #include "esp_err.h"
 
+/**
+ * @brief 套接字单次发送的等待上限（秒），即 httpd 的 send_wait_timeout
+ *
+ * 发送缓冲区满时 send() 最多阻塞这么久，超时即视为连接失效。WebSocket 帧的头部与负载
+ * 分两次发送，因此单帧最多阻塞 HTTP 服务器任务 2 * WEBSERVER_SEND_WAIT_S 秒。
+ */
+#define WEBSERVER_SEND_WAIT_S 1
+
+/**
+ * @brief 静态文件服务统计
+ *
+ * 配置页（index.html）单独记录最近一次响应，-1 表示尚未请求过。首字节时间为收到请求到
+ * 首个数据块交给协议栈的时间（不含网络传输），与客户端测得的 TTFB 之差即为网络耗时。
+ */
+typedef struct {
+    uint32_t requests;     ///< 静态文件请求数
+    uint32_t gzip;         ///< 选用预压缩版本的次数（含 304）
+    uint32_t not_modified; ///< 返回 304 的次数
+    uint64_t bytes;        ///< 发送的响应体总字节数
+    int64_t page_bytes;    ///< 配置页最近一次的响应体字节数
+    int64_t page_ttfb_us;  ///< 配置页最近一次的首字节时间（微秒）
+    int64_t page_total_us; ///< 配置页最近一次的完整响应时间（微秒）
+} webserver_stats_t;
+
 /**
  * @brief 启动 HTTP Web 服务器，提供配置接口与静态文件服务。
  * @param base_path FATFS 挂载路径，例如 "/flash"。
  */
 esp_err_t webserver_start(const char *base_path);
 
+/**
+ * @brief 以 JSON 形式导出当前配置（GET /api/config 的响应体）。
+ * @return 新建的 JSON 对象，由调用者释放；内存不足时返回 NULL。
+ */
+cJSON *webserver_config_to_json(void);
+
+/**
+ * @brief 按 JSON 更新配置并保存，只更新提供的字段，随后应用时区、解除熔断并刷新天气。
+ * @param root 与 POST /api/config 请求体相同格式的 JSON 对象。
+ * @return ESP_OK 成功，否则为保存失败的错误码。
+ */
+esp_err_t webserver_config_apply(const cJSON *root);
+
+/**
+ * @brief 获取静态文件服务统计。
+ * @param stats 输出统计。
+ */
+void webserver_get_stats(webserver_stats_t *stats);
+
 /**
  * @brief 停止 Web 服务器。
  */
@@ -1,3 +1,92 @@
 #pragma once
 
-void wifi_init();
\ No newline at end of file
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+/** @brief 开机后超过该时间仍未连上 WiFi 时自动进入 SmartConfig */
+#define WIFI_SMARTCONFIG_AFTER_MS (10 * 60 * 1000)
+/** @brief wifi_init() 等待首次连接尝试（缓存接入点 + 全信道扫描）的上限 */
+#define WIFI_FIRST_ATTEMPT_MAX_MS (15 * 1000)
+/** @brief 重连退避时间上限 */
+#define WIFI_RECONNECT_MAX_DELAY_MS (60 * 1000)
+
+/**
+ * @brief WiFi 连接统计
+ *
+ * 时间均为最近一次连接的耗时（毫秒），-1 表示尚未测得。
+ */
+typedef struct {
+    bool connected;          ///< 当前是否已获取 IP
+    bool fast_path;          ///< 最近一次连接是否使用了缓存的 BSSID/信道
+    bool static_ip;          ///< 是否使用静态 IP
+    uint32_t connects;       ///< 成功连接次数
+    uint32_t fast_hits;      ///< 使用缓存直接连上的次数
+    uint32_t scan_fallbacks; ///< 缓存失效后退回全信道扫描的次数
+    uint32_t disconnects;    ///< 断开次数
+    int64_t assoc_ms;        ///< 发起连接到关联成功
+    int64_t ip_ms;           ///< 关联成功到获取 IP
+    int64_t first_byte_ms;   ///< 获取 IP 到收到第一个 HTTP 响应
+} wifi_stats_t;
+
+/**
+ * @brief 初始化 WiFi 并等待获取 IP
+ *
+ * 首次尝试使用上次连接时缓存的 BSSID 与信道，失败后退回全信道扫描并按退避时间无限重试；
+ * 没有已保存的凭证，或开机后 WIFI_SMARTCONFIG_AFTER_MS 内仍未连上时进入 SmartConfig。
+ *
+ * 只等待首次尝试：连上、缓存的接入点与全信道扫描都失败，或超过 WIFI_FIRST_ATTEMPT_MAX_MS
+ * 时返回；没有凭证时启动 SmartConfig 后立即返回。退避重连与 SmartConfig 在后台继续，
+ * 联网的使用者通过 wifi_wait_connected() 或 radio_acquire() 等待连接。
+ */
+void wifi_init(void);
+
+/**
+ * @brief 主动进入 SmartConfig 配网
+ *
+ * 停止重连并等待手机下发新的凭证；超时未配网时恢复用已保存的凭证重连。
+ */
+void wifi_start_smartconfig(void);
+
+/**
+ * @brief 设置关联期间的省电模式
+ *
+ * 在 wifi_init() 之前调用；DTIM 监听间隔在下一次关联时生效。
+ *
+ * @param max_modem true 使用 WIFI_PS_MAX_MODEM，false 使用默认的 WIFI_PS_MIN_MODEM
+ * @param listen_interval DTIM 监听间隔（信标周期数），0 表示默认值
+ */
+void wifi_set_power_save(bool max_modem, uint8_t listen_interval);
+
+/**
+ * @brief 关闭 WiFi（esp_wifi_stop），期间不自动重连
+ *
+ * @return ESP_OK 成功，ESP_ERR_INVALID_STATE SmartConfig 进行中
+ */
+esp_err_t wifi_suspend(void);
+
+/**
+ * @brief 重新打开 WiFi 并使用缓存的接入点连接
+ */
+void wifi_resume(void);
+
+/**
+ * @brief 等待获取 IP
+ *
+ * @param timeout_ms 超时时间（毫秒）
+ * @return true 已连接，false 超时
+ */
+bool wifi_wait_connected(uint32_t timeout_ms);
+
+/**
+ * @brief 记录连接后收到第一个 HTTP 响应的时间（由连接池调用）
+ */
+void wifi_note_first_byte(void);
+
+/**
+ * @brief 获取 WiFi 连接统计
+ *
+ * @param stats 输出统计
+ */
+void wifi_get_stats(wifi_stats_t *stats);
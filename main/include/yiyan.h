@@ -1,5 +1,88 @@
+/**
+ * @file yiyan.h
+ * @brief 一言（hitokoto）句子获取与本地句子环
+ *
+ * 句子在联网窗口内批量获取，去重后存入保存在 FAT 分区中的环形缓冲区。
+ * 界面定时从本地轮换显示，不需要联网；未显示过的句子少于水位线时再批量补充。
+ * 离线时继续循环显示已保存的句子。
+ */
+
 #pragma once
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #include "esp_err.h"
 
-esp_err_t get_yiyan(char **return_str);
\ No newline at end of file
+/** @brief 默认一言接口地址，可通过配置 yiyan.base_url 替换（如本地模拟服务器） */
+#define YIYAN_DEFAULT_BASE_URL "https://v1.hitokoto.cn"
+
+/** @brief 句子环容量 */
+#define YIYAN_RING_SIZE 32
+/** @brief 单条句子最大长度（含结束符，与界面变量 yiyan 一致） */
+#define YIYAN_TEXT_MAX 100
+/** @brief 请求的句子最大字数（hitokoto max_length 参数，保证 UTF-8 编码后放得下） */
+#define YIYAN_MAX_CHARS 30
+/** @brief 未显示过的句子少于该数量时补充 */
+#define YIYAN_REFILL_WATERMARK 8
+/** @brief 一次补充最多发起的请求数 */
+#define YIYAN_BATCH_MAX 12
+/** @brief 句子环文件 */
+#define YIYAN_RING_PATH "/flash/yiyan.bin"
+
+/**
+ * @brief 一言统计
+ */
+typedef struct {
+    uint8_t count;       ///< 已保存的句子数
+    uint8_t unread;      ///< 未显示过的句子数
+    uint32_t fetched;    ///< 获取到的新句子数
+    uint32_t duplicates; ///< 因重复丢弃的句子数
+    uint32_t requests;   ///< 请求次数
+    uint32_t shown;      ///< 轮换显示次数
+    uint32_t replays;    ///< 没有新句子时重复显示已保存句子的次数
+    uint32_t saves;      ///< 写入 flash 的次数
+} yiyan_stats_t;
+
+/**
+ * @brief 从 flash 读取句子环
+ *
+ * 需在 FAT 分区挂载之后调用；文件不存在或格式不匹配时从空环开始。
+ *
+ * @return ESP_OK 成功，ESP_ERR_NO_MEM 内存不足
+ */
+esp_err_t yiyan_init(void);
+
+/**
+ * @brief 取下一条要显示的句子
+ *
+ * 优先返回未显示过的句子；全部显示过后按顺序循环已保存的句子。不发起网络请求。
+ *
+ * @param out 输出缓冲区
+ * @param size 缓冲区大小
+ * @return ESP_OK 成功，ESP_ERR_NOT_FOUND 没有已保存的句子
+ */
+esp_err_t yiyan_next(char *out, size_t size);
+
+/**
+ * @brief 未显示过的句子是否已低于水位线
+ */
+bool yiyan_needs_refill(void);
+
+/**
+ * @brief 批量获取句子补充句子环（阻塞，在网络调度器中调用）
+ *
+ * 连续请求直到句子环装满、达到 YIYAN_BATCH_MAX 或请求失败，结束后写入一次 flash。
+ *
+ * @return ESP_OK 请求成功（或失败前已获取到新句子），ESP_ERR_NOT_ALLOWED 接口熔断中，
+ *         其他错误码表示首个请求失败
+ */
+esp_err_t yiyan_refill(void);
+
+/**
+ * @brief 获取一言统计
+ *
+ * @param stats 输出统计
+ */
+void yiyan_get_stats(yiyan_stats_t *stats);
@@ -5,18 +5,29 @@
 #include "touch.h"
 #include <stdio.h>
 
+#include "actions.h"
 #include "config_manager.h"
 #include "date_update.h"
+#include "decompress.h"
 #include "epaper.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
 #include "freertos/task.h"
+#include "http_cache.h"
+#include "http_pool.h"
 #include "ip_location.h"
 #include "lvgl_init.h"
+#include "mqtt_push.h"
+#include "net_health.h"
+#include "net_sched.h"
+#include "radio.h"
 #include "sntp.h"
+#include "vars.h"
 #include "weather.h"
+#include "weather_multi.h"
 #include "webserver.h"
 #include "wifi.h"
+#include "yiyan.h"
 
 #define TAG "main"
 #define INIT_DONE_BIT BIT0
@@ -25,21 +36,28 @@ static wl_handle_t s_wl_handle = WL_INVALID_HANDLE;
 static EventGroupHandle_t s_init_event_group = NULL;
 
 void wifi_and_time_init_task(void *pvParameter) {
-    // 初始化 WiFi
+    // 初始化 WiFi（只等待首次连接尝试，重连与配网在后台继续）
     wifi_init();
 
-    // 初始化 SNTP 时间同步
+    // 启动后台 SNTP 时间同步（不等待同步完成）
     time_init();
 
-    // 初始化日期更新时间服务
-    date_update_init();
-
     // 通知主任务网络与时间初始化已完成
     xEventGroupSetBits(s_init_event_group, INIT_DONE_BIT);
 
     vTaskDelete(NULL);
 }
 
+/**
+ * @brief SNTP 同步完成回调：立即按新的时间刷新界面上的日期时间
+ */
+static void on_time_synced(bool first) {
+    if (first) {
+        ESP_LOGI(TAG, "System time is now authoritative");
+    }
+    date_update_refresh();
+}
+
 void lvgl_init_task(void *param) {
     lvgl_init_epaper_display();
     vTaskDelete(NULL);
@@ -66,12 +84,88 @@ void app_main(void) {
         return;
     }
 
+    // 立即恢复上一次的时间（RTC / NVS），不等待网络
+    time_restore();
+    time_set_sync_callback(on_time_synced);
+
+    // 初始化界面变量存储（写入界面变量的服务启动之前）
+    ret = vars_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "vars_init failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    // 初始化日期更新时间服务
+    date_update_init();
+
+    // 初始化 HTTPS 连接池（天气、定位、一言共用）
+    ret = http_pool_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "http_pool_init failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    // 初始化 HTTP 响应缓存（条件请求与 max-age）
+    ret = http_cache_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "http_cache_init failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    // 初始化共享 GZIP 解压器（zlib 窗口分配在 PSRAM 中并长期复用）
+    ret = decompress_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "decompress_init failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    // 初始化上游接口熔断器（接口连续失败时暂停请求并指数退避）
+    ret = net_health_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "net_health_init failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    // 初始化网络任务调度器（天气、一言等周期任务共用一个工作任务）
+    ret = net_sched_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "net_sched_init failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    // 读取一言句子环（离线时界面也有句子可显示）
+    ret = yiyan_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "yiyan_init failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    // 分配多位置天气槽位（当前位置 + 配置的额外位置）
+    ret = weather_multi_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "weather_multi_init failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    // 按配置设置射频策略（需在 wifi_init() 之前）
+    ret = radio_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "radio_init failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
     s_init_event_group = xEventGroupCreate();
     if (s_init_event_group == NULL) {
         ESP_LOGE(TAG, "Failed to create init event group");
         return;
     }
 
+    // 在联网之前恢复上一次的天气快照，LVGL 启动后即可显示
+    restore_weather_snapshot();
+
+    // 初始化 LVGL（与网络初始化并行，联网相关任务会等待网络就绪）
+    xTaskCreate(lvgl_init_task, "lvgl_init_task", 8192, NULL, 5, NULL);
+
     // 初始化 WiFi/时间（异步任务，完成后通过事件组通知）
     BaseType_t task_created =
         xTaskCreate(wifi_and_time_init_task, "wifi_init_task", 4096, NULL, 5, NULL);
@@ -80,18 +174,18 @@ void app_main(void) {
         return;
     }
 
-    // 等待网络与时间初始化完成后再初始化 LVGL
+    // 等待网络与时间初始化完成
     xEventGroupWaitBits(s_init_event_group, INIT_DONE_BIT, pdTRUE, pdTRUE, portMAX_DELAY);
-    ESP_LOGI(TAG, "Network/time init done, starting LVGL");
+    ESP_LOGI(TAG, "Network/time init done");
 
-    // 启动 Web 服务器，提供配置页面与 API
-    err = webserver_start("/flash");
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "webserver_start failed: %s", esp_err_to_name(err));
-    }
+    // 启用射频策略（常开模式下启动 Web 服务器，其他模式长按屏幕时开启）
+    radio_start();
 
-    // 初始化 LVGL
-    xTaskCreate(lvgl_init_task, "lvgl_init_task", 8192, NULL, 5, NULL);
+    // 按配置启动 MQTT 推送（持久会话，离线期间的消息由 broker 保留）
+    ret = mqtt_push_start();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "mqtt_push_start failed: %s", esp_err_to_name(ret));
+    }
 
     return;
 }
@@ -1,8 +1,11 @@
 #include "esp_log.h"
 #include "nvs_flash.h"
+#include <math.h>
 #include <string.h>
 
 #include "config_manager.h"
+#include "radio.h"
+#include "sntp.h"
 
 #define TAG "config_manager"
 #define CONFIG_NVS_NAMESPACE "sys_config"
@@ -70,6 +73,54 @@ esp_err_t sys_config_load(sys_config_t *config) {
         return err;
     }
 
+    required_size = sizeof(config->wifi.static_ip);
+    err = nvs_get_str(nvs_handle, "wifi_ip", config->wifi.static_ip, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded wifi_ip: %s", config->wifi.static_ip);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->wifi.static_ip[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for wifi_ip failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->wifi.netmask);
+    err = nvs_get_str(nvs_handle, "wifi_mask", config->wifi.netmask, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded wifi_mask: %s", config->wifi.netmask);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->wifi.netmask[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for wifi_mask failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->wifi.gateway);
+    err = nvs_get_str(nvs_handle, "wifi_gw", config->wifi.gateway, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded wifi_gw: %s", config->wifi.gateway);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->wifi.gateway[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for wifi_gw failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->wifi.dns);
+    err = nvs_get_str(nvs_handle, "wifi_dns", config->wifi.dns, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded wifi_dns: %s", config->wifi.dns);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->wifi.dns[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for wifi_dns failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
     int32_t stored_int = 0;
 
     // Use shorter NVS keys (<=15 chars); keep backward compatibility with legacy key.
@@ -133,6 +184,83 @@ esp_err_t sys_config_load(sys_config_t *config) {
         return err;
     }
 
+    required_size = sizeof(config->ip_location.base_url);
+    err = nvs_get_str(nvs_handle, "ip_loc_base", config->ip_location.base_url, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded ip_loc_base: %s", config->ip_location.base_url);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGI(TAG, "ip_loc_base not found, using default");
+        config->ip_location.base_url[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for ip_loc_base failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_get_i32(nvs_handle, "loc_manual", &stored_int);
+    if (err == ESP_OK) {
+        config->location.manual = (stored_int != 0);
+        ESP_LOGI(TAG, "Loaded loc_manual: %d", config->location.manual);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGI(TAG, "loc_manual not found, using default");
+        config->location.manual = false;
+    } else {
+        ESP_LOGI(TAG, "nvs_get_i32 for loc_manual failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->location.name);
+    err = nvs_get_str(nvs_handle, "loc_name", config->location.name, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded loc_name: %s", config->location.name);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGI(TAG, "loc_name not found, using default");
+        config->location.name[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for loc_name failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    // 经纬度以百万分之一度为单位保存为整数
+    err = nvs_get_i32(nvs_handle, "loc_lat_e6", &stored_int);
+    if (err == ESP_OK) {
+        config->location.latitude = stored_int / 1e6;
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->location.latitude = 0;
+    } else {
+        ESP_LOGI(TAG, "nvs_get_i32 for loc_lat_e6 failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_get_i32(nvs_handle, "loc_lon_e6", &stored_int);
+    if (err == ESP_OK) {
+        config->location.longitude = stored_int / 1e6;
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->location.longitude = 0;
+    } else {
+        ESP_LOGI(TAG, "nvs_get_i32 for loc_lon_e6 failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+    ESP_LOGI(TAG, "Loaded location: %.6f, %.6f", config->location.latitude,
+             config->location.longitude);
+
+    err = nvs_get_i32(nvs_handle, "loc_ttl_h", &stored_int);
+    if (err == ESP_OK) {
+        config->location.cache_ttl_hours = stored_int;
+        ESP_LOGI(TAG, "Loaded loc_ttl_h: %d", config->location.cache_ttl_hours);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGI(TAG, "loc_ttl_h not found, using default");
+        config->location.cache_ttl_hours = 24;
+    } else {
+        ESP_LOGI(TAG, "nvs_get_i32 for loc_ttl_h failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
     required_size = sizeof(config->weather.city);
     err = nvs_get_str(nvs_handle, "weather_city", config->weather.city, &required_size);
     if (err == ESP_OK) {
@@ -172,6 +300,145 @@ esp_err_t sys_config_load(sys_config_t *config) {
         return err;
     }
 
+    err = nvs_get_i32(nvs_handle, "wx_stale_min", &stored_int);
+    if (err == ESP_OK) {
+        config->weather.stale_minutes = stored_int;
+        ESP_LOGI(TAG, "Loaded weather stale_minutes: %d", config->weather.stale_minutes);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGI(TAG, "weather stale_minutes not found, using default");
+        config->weather.stale_minutes = 180;
+    } else {
+        ESP_LOGI(TAG, "nvs_get_i32 for wx_stale_min failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->weather.locations);
+    err = nvs_get_str(nvs_handle, "wx_locations", config->weather.locations, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded wx_locations: %s", config->weather.locations);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGI(TAG, "wx_locations not found, using default");
+        config->weather.locations[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for wx_locations failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->yiyan.base_url);
+    err = nvs_get_str(nvs_handle, "yiyan_base", config->yiyan.base_url, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded yiyan_base: %s", config->yiyan.base_url);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGI(TAG, "yiyan_base not found, using default");
+        config->yiyan.base_url[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for yiyan_base failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->time.ntp_servers);
+    err = nvs_get_str(nvs_handle, "ntp_servers", config->time.ntp_servers, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded ntp_servers: %s", config->time.ntp_servers);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGI(TAG, "ntp_servers not found, using default");
+        snprintf(config->time.ntp_servers, sizeof(config->time.ntp_servers), "%s",
+                 TIME_DEFAULT_NTP_SERVERS);
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for ntp_servers failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->time.timezone);
+    err = nvs_get_str(nvs_handle, "timezone", config->time.timezone, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded timezone: %s", config->time.timezone);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGI(TAG, "timezone not found, using default");
+        snprintf(config->time.timezone, sizeof(config->time.timezone), "%s",
+                 TIME_DEFAULT_TIMEZONE);
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for timezone failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_get_i32(nvs_handle, "radio_mode", &stored_int);
+    if (err == ESP_OK) {
+        config->power.radio_mode = stored_int;
+        ESP_LOGI(TAG, "Loaded radio_mode: %d", config->power.radio_mode);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->power.radio_mode = RADIO_MODE_ALWAYS_ON;
+    } else {
+        ESP_LOGI(TAG, "nvs_get_i32 for radio_mode failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_get_i32(nvs_handle, "listen_int", &stored_int);
+    if (err == ESP_OK) {
+        config->power.listen_interval = stored_int;
+        ESP_LOGI(TAG, "Loaded listen_interval: %d", config->power.listen_interval);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->power.listen_interval = RADIO_DEFAULT_LISTEN_INTERVAL;
+    } else {
+        ESP_LOGI(TAG, "nvs_get_i32 for listen_int failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->mqtt.uri);
+    err = nvs_get_str(nvs_handle, "mqtt_uri", config->mqtt.uri, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded mqtt_uri: %s", config->mqtt.uri);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->mqtt.uri[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for mqtt_uri failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->mqtt.username);
+    err = nvs_get_str(nvs_handle, "mqtt_user", config->mqtt.username, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded mqtt_user: %s", config->mqtt.username);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->mqtt.username[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for mqtt_user failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->mqtt.password);
+    err = nvs_get_str(nvs_handle, "mqtt_pass", config->mqtt.password, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded mqtt_pass: %s", "********");
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->mqtt.password[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for mqtt_pass failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    required_size = sizeof(config->mqtt.topic_prefix);
+    err = nvs_get_str(nvs_handle, "mqtt_prefix", config->mqtt.topic_prefix, &required_size);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded mqtt_prefix: %s", config->mqtt.topic_prefix);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        config->mqtt.topic_prefix[0] = '\0';
+    } else {
+        ESP_LOGI(TAG, "nvs_get_str for mqtt_prefix failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
     return ESP_OK;
 }
 
@@ -209,6 +476,34 @@ esp_err_t config_manager_save_config(sys_config_t *config) {
         return err;
     }
 
+    err = nvs_set_str(nvs_handle, "wifi_ip", config->wifi.static_ip);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for wifi_ip failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "wifi_mask", config->wifi.netmask);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for wifi_mask failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "wifi_gw", config->wifi.gateway);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for wifi_gw failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "wifi_dns", config->wifi.dns);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for wifi_dns failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
     err = nvs_set_i32(nvs_handle, "frc", config->display.fast_refresh_count);
     if (err != ESP_OK) {
         ESP_LOGI(TAG, "nvs_set_i32 for fast_refresh_count failed: %s", esp_err_to_name(err));
@@ -237,6 +532,48 @@ esp_err_t config_manager_save_config(sys_config_t *config) {
         return err;
     }
 
+    err = nvs_set_str(nvs_handle, "ip_loc_base", config->ip_location.base_url);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for ip_loc_base failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_i32(nvs_handle, "loc_manual", config->location.manual ? 1 : 0);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_i32 for loc_manual failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "loc_name", config->location.name);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for loc_name failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_i32(nvs_handle, "loc_lat_e6", (int32_t)lround(config->location.latitude * 1e6));
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_i32 for loc_lat_e6 failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_i32(nvs_handle, "loc_lon_e6", (int32_t)lround(config->location.longitude * 1e6));
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_i32 for loc_lon_e6 failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_i32(nvs_handle, "loc_ttl_h", config->location.cache_ttl_hours);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_i32 for loc_ttl_h failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
     err = nvs_set_str(nvs_handle, "weather_city", config->weather.city);
     if (err != ESP_OK) {
         ESP_LOGI(TAG, "nvs_set_str for weather_city failed: %s", esp_err_to_name(err));
@@ -258,6 +595,83 @@ esp_err_t config_manager_save_config(sys_config_t *config) {
         return err;
     }
 
+    err = nvs_set_i32(nvs_handle, "wx_stale_min", config->weather.stale_minutes);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_i32 for wx_stale_min failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "wx_locations", config->weather.locations);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for wx_locations failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "yiyan_base", config->yiyan.base_url);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for yiyan_base failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "ntp_servers", config->time.ntp_servers);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for ntp_servers failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "timezone", config->time.timezone);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for timezone failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_i32(nvs_handle, "radio_mode", config->power.radio_mode);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_i32 for radio_mode failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_i32(nvs_handle, "listen_int", config->power.listen_interval);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_i32 for listen_int failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "mqtt_uri", config->mqtt.uri);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for mqtt_uri failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "mqtt_user", config->mqtt.username);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for mqtt_user failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "mqtt_pass", config->mqtt.password);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for mqtt_pass failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_str(nvs_handle, "mqtt_prefix", config->mqtt.topic_prefix);
+    if (err != ESP_OK) {
+        ESP_LOGI(TAG, "nvs_set_str for mqtt_prefix failed: %s", esp_err_to_name(err));
+        nvs_close(nvs_handle);
+        return err;
+    }
+
     err = nvs_commit(nvs_handle);
     if (err != ESP_OK) {
         ESP_LOGI(TAG, "nvs_commit failed: %s", esp_err_to_name(err));
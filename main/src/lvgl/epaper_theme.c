@@ -0,0 +1,152 @@
+/**
+ * @file epaper_theme.c
+ * @brief 电子墨水屏专用 LVGL 主题实现
+ *
+ * 默认主题带有阴影、抗锯齿圆角、透明度图层和状态过渡动画，这些效果在软件渲染时
+ * 开销较大，经过 1bpp 抖动后又会变成噪点。本主题只使用纯黑/纯白、整数宽度边框，
+ * 不设置任何过渡。
+ */
+
+#include "esp_log.h"
+
+#include "epaper_theme.h"
+#include "lvgl.h"
+#include "lvgl_private.h"
+
+#define TAG "epaper_theme"
+
+// ============================================================================
+// 私有变量
+// ============================================================================
+
+// 屏幕背景：纯白、不透明
+static lv_style_t style_scr;
+// 普通容器：白底、1px 黑色边框、直角
+static lv_style_t style_obj;
+// 按下状态：黑白反色，代替默认主题的阴影与变暗效果
+static lv_style_t style_pressed;
+// 滚动条：细黑条，无淡入淡出
+static lv_style_t style_scrollbar;
+
+static bool styles_inited = false;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+/**
+ * @brief 初始化主题样式
+ */
+static void style_init(void) {
+    if (styles_inited) {
+        return;
+    }
+
+    lv_style_init(&style_scr);
+    lv_style_set_bg_color(&style_scr, lv_color_white());
+    lv_style_set_bg_opa(&style_scr, LV_OPA_COVER);
+    lv_style_set_bg_grad_dir(&style_scr, LV_GRAD_DIR_NONE);
+    lv_style_set_text_color(&style_scr, lv_color_black());
+    lv_style_set_text_font(&style_scr, LV_FONT_DEFAULT);
+
+    lv_style_init(&style_obj);
+    lv_style_set_bg_color(&style_obj, lv_color_white());
+    lv_style_set_bg_opa(&style_obj, LV_OPA_COVER);
+    lv_style_set_bg_grad_dir(&style_obj, LV_GRAD_DIR_NONE);
+    lv_style_set_border_color(&style_obj, lv_color_black());
+    lv_style_set_border_width(&style_obj, 1);
+    lv_style_set_border_opa(&style_obj, LV_OPA_COVER);
+    lv_style_set_radius(&style_obj, 0);
+    lv_style_set_shadow_width(&style_obj, 0);
+    lv_style_set_outline_width(&style_obj, 0);
+    lv_style_set_pad_all(&style_obj, 4);
+    lv_style_set_text_color(&style_obj, lv_color_black());
+
+    lv_style_init(&style_pressed);
+    lv_style_set_bg_color(&style_pressed, lv_color_black());
+    lv_style_set_text_color(&style_pressed, lv_color_white());
+
+    lv_style_init(&style_scrollbar);
+    lv_style_set_bg_color(&style_scrollbar, lv_color_black());
+    lv_style_set_bg_opa(&style_scrollbar, LV_OPA_COVER);
+    lv_style_set_radius(&style_scrollbar, 0);
+    lv_style_set_width(&style_scrollbar, 2);
+    lv_style_set_pad_right(&style_scrollbar, 1);
+    lv_style_set_pad_top(&style_scrollbar, 1);
+
+    styles_inited = true;
+}
+
+/**
+ * @brief 主题应用回调，在每个对象创建时由 LVGL 调用
+ */
+static void epaper_theme_apply(lv_theme_t *th, lv_obj_t *obj) {
+    LV_UNUSED(th);
+
+    if (lv_obj_get_parent(obj) == NULL) {
+        lv_obj_add_style(obj, &style_scr, 0);
+        lv_obj_add_style(obj, &style_scrollbar, LV_PART_SCROLLBAR);
+        return;
+    }
+
+    if (lv_obj_check_type(obj, &lv_obj_class)) {
+        lv_obj_add_style(obj, &style_obj, 0);
+        lv_obj_add_style(obj, &style_pressed, LV_STATE_PRESSED);
+        lv_obj_add_style(obj, &style_scrollbar, LV_PART_SCROLLBAR);
+    }
+    // 标签与图片不附加任何主题样式，文字颜色从父对象继承
+}
+
+/**
+ * @brief 以 EEZ 生成代码中的参数初始化默认主题
+ *
+ * 参数必须与 screens.c 中 create_screens() 调用 lv_theme_default_init() 的参数保持一致：
+ * 默认主题只在参数相同时直接返回、保留被替换的 apply 回调，参数不同则整体重新初始化，
+ * 回调恢复为默认主题自身的实现（epaper_theme_is_active() 会检测到）。
+ */
+static lv_theme_t *default_theme_init(lv_display_t *disp) {
+    return lv_theme_default_init(disp, lv_palette_main(LV_PALETTE_BLUE),
+                                 lv_palette_main(LV_PALETTE_RED), false, LV_FONT_DEFAULT);
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+lv_theme_t *epaper_theme_init(lv_display_t *disp) {
+    style_init();
+
+    lv_theme_t *theme = default_theme_init(disp);
+    lv_theme_set_apply_cb(theme, epaper_theme_apply);
+
+    return theme;
+}
+
+void epaper_theme_install(lv_display_t *disp) {
+    lv_display_t *target = (disp != NULL) ? disp : lv_display_get_default();
+    lv_theme_t *theme = epaper_theme_init(target);
+    lv_display_set_theme(target, theme);
+    ESP_LOGI(TAG, "E-paper theme installed");
+}
+
+void epaper_theme_select(lv_display_t *disp, bool epaper) {
+    lv_display_t *target = (disp != NULL) ? disp : lv_display_get_default();
+
+    lv_theme_t *theme;
+    if (epaper) {
+        theme = epaper_theme_init(target);
+    } else {
+        // 默认主题只在参数变化时恢复自己的 apply 回调，先以不同参数初始化一次。
+        // 不能 lv_theme_default_deinit()：显示的各图层仍引用默认主题的样式
+        lv_theme_default_init(target, lv_palette_main(LV_PALETTE_BLUE),
+                              lv_palette_main(LV_PALETTE_RED), true, LV_FONT_DEFAULT);
+        theme = default_theme_init(target);
+    }
+    lv_display_set_theme(target, theme);
+}
+
+bool epaper_theme_is_active(lv_display_t *disp) {
+    lv_display_t *target = (disp != NULL) ? disp : lv_display_get_default();
+    lv_theme_t *theme = lv_display_get_theme(target);
+    return theme != NULL && theme->apply_cb == epaper_theme_apply;
+}
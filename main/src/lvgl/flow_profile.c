@@ -0,0 +1,138 @@
+/**
+ * @file flow_profile.c
+ * @brief EEZ 流程执行剖析
+ *
+ * 实现 eez-flow.h 中的 eez_flow_profile_* 钩子。钩子都在持有 LVGL 互斥锁时调用
+ * （流程 tick 与控件绑定在 lvgl_tick 定时器中，原生动作在 lv_timer_handler 中），
+ * 统计数据由该互斥锁保护，记录路径上不再加锁。
+ */
+
+#if EEZ_FLOW_PROFILE
+
+#include "flow_profile.h"
+
+#include <string.h>
+
+#include "esp_timer.h"
+
+#include "lvgl_init.h"
+#include "ui.h"
+
+/** @brief 读取统计时等待 LVGL 互斥锁的最长时间（毫秒） */
+#define FLOW_PROFILE_LOCK_MS 200
+
+// ============================================================================
+// 私有变量
+// ============================================================================
+
+// 统计数据，受 LVGL 互斥锁保护
+static flow_profile_stats_t s_stats;
+
+// 统计开始时间（微秒）
+static int64_t s_window_start_us;
+
+// 最近一次命中的组件类型在 s_stats.components 中的序号
+static uint8_t s_last_type;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+/**
+ * @brief 记录一次耗时
+ */
+static void entry_add(flow_profile_entry_t *entry, uint32_t start) {
+    uint32_t us = (uint32_t)esp_timer_get_time() - start;
+    entry->count++;
+    entry->total_us += us;
+    if (us > entry->max_us) {
+        entry->max_us = us;
+    }
+}
+
+/**
+ * @brief 查找组件类型的统计项，不存在时追加
+ *
+ * 同一页面上连续执行的多为同一类型，先比较上次命中的项。
+ *
+ * @return 统计项，类型表已满时返回 NULL
+ */
+static flow_profile_entry_t *component_entry(uint16_t type) {
+    if (s_last_type < s_stats.num_types && s_stats.components[s_last_type].type == type) {
+        return &s_stats.components[s_last_type].entry;
+    }
+    for (uint8_t i = 0; i < s_stats.num_types; i++) {
+        if (s_stats.components[i].type == type) {
+            s_last_type = i;
+            return &s_stats.components[i].entry;
+        }
+    }
+    if (s_stats.num_types == FLOW_PROFILE_MAX_TYPES) {
+        return NULL;
+    }
+    s_last_type = s_stats.num_types++;
+    s_stats.components[s_last_type].type = type;
+    return &s_stats.components[s_last_type].entry;
+}
+
+// ============================================================================
+// EEZ 流程钩子
+// ============================================================================
+
+uint32_t eez_flow_profile_now(void) { return (uint32_t)esp_timer_get_time(); }
+
+void eez_flow_profile_component(uint16_t type, uint32_t start) {
+    flow_profile_entry_t *entry = component_entry(type);
+    if (entry == NULL) {
+        s_stats.dropped++;
+        return;
+    }
+    entry_add(entry, start);
+}
+
+void eez_flow_profile_expression(uint32_t start) { entry_add(&s_stats.expressions, start); }
+
+void eez_flow_profile_action(int actionIndex, uint32_t start) {
+    if (actionIndex >= 0 && actionIndex < FLOW_PROFILE_MAX_ACTIONS) {
+        entry_add(&s_stats.actions[actionIndex], start);
+    }
+}
+
+void eez_flow_profile_tick(uint32_t start, size_t queueSize, size_t queuePeak,
+                           bool budgetExceeded) {
+    entry_add(&s_stats.ticks, start);
+    if (budgetExceeded) {
+        s_stats.budget_hits++;
+    }
+    s_stats.queue_size = queueSize;
+    if (queueSize > s_stats.queue_backlog_max) {
+        s_stats.queue_backlog_max = queueSize;
+    }
+    s_stats.queue_peak = queuePeak;
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t flow_profile_get_stats(flow_profile_stats_t *stats, bool reset) {
+    SemaphoreHandle_t mutex = lvgl_get_mutex();
+    if (mutex == NULL || xSemaphoreTake(mutex, pdMS_TO_TICKS(FLOW_PROFILE_LOCK_MS)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    int64_t now_us = esp_timer_get_time();
+    *stats = s_stats;
+    stats->window_ms = (uint32_t)((now_us - s_window_start_us) / 1000);
+    if (reset) {
+        uint32_t queue_peak = s_stats.queue_peak;
+        memset(&s_stats, 0, sizeof(s_stats));
+        s_stats.queue_peak = queue_peak;
+        s_window_start_us = now_us;
+    }
+
+    xSemaphoreGive(mutex);
+    return ESP_OK;
+}
+
+#endif // EEZ_FLOW_PROFILE
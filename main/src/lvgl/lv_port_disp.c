@@ -7,10 +7,13 @@
 
 #include "esp_heap_caps.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "dither.h"
 #include "lv_port_disp.h"
 #include "lvgl.h"
+#include "metrics.h"
+#include "screen_mirror.h"
 
 #define TAG "lv_port_disp"
 
@@ -53,6 +56,7 @@ static volatile bool screen_needs_refresh = false;
  * 此函数由 LVGL 调用，用于将渲染的图像数据刷新到电子墨水屏
  */
 static void disp_flush(lv_display_t *disp_drv, const lv_area_t *area, uint8_t *px_map) {
+    int64_t start_us = esp_timer_get_time();
     int height = area->y2 - area->y1 + 1;
     int width = area->x2 - area->x1 + 1;
 
@@ -66,8 +70,12 @@ static void disp_flush(lv_display_t *disp_drv, const lv_area_t *area, uint8_t *p
     dither_convert_area(px_map, virtual_fb, area->x1, area->y1, width, height, MY_DISP_HOR_RES,
                         BYTE_PER_PIXEL);
 
+    // 记录脏区，屏幕镜像在刷新后推送增量
+    screen_mirror_mark(area->x1, area->y1, area->x2, area->y2);
+
     // 标记屏幕需要刷新
     screen_needs_refresh = true;
+    metrics_observe(METRIC_DISP_FLUSH, 0, esp_timer_get_time() - start_us);
 
     // 通知 LVGL 此次区域 flush 已处理完成
     lv_display_flush_ready(disp_drv);
@@ -8,6 +8,7 @@
 
 #include "lv_port_indev.h"
 #include "lvgl.h"
+#include "radio.h"
 #include "touch.h"
 
 #define TAG "lv_port_indev"
@@ -21,6 +22,9 @@
 #define MY_DISP_VER_RES 200
 #endif
 
+// 长按该时间后请求开启 Web 配置会话
+#define LONG_PRESS_MS 3000
+
 // ============================================================================
 // 私有变量
 // ============================================================================
@@ -42,6 +46,10 @@ static touch_data_t g_touch_data = {
     .is_pressed = false,
 };
 
+// 本次按下的开始时间与是否已触发长按
+static uint32_t s_press_start = 0;
+static bool s_long_press_fired = false;
+
 // ============================================================================
 // 私有函数
 // ============================================================================
@@ -73,6 +81,20 @@ static void touchpad_read(lv_indev_t *indev_drv, lv_indev_data_t *data) {
         g_touch_data.is_pressed = false;
     }
 
+    // 长按：每次按下只触发一次
+    if (g_touch_data.is_pressed) {
+        if (s_press_start == 0) {
+            s_press_start = lv_tick_get() | 1;
+            s_long_press_fired = false;
+        } else if (!s_long_press_fired && lv_tick_elaps(s_press_start) >= LONG_PRESS_MS) {
+            s_long_press_fired = true;
+            ESP_LOGI(TAG, "Long press, requesting web session");
+            radio_request_web_session();
+        }
+    } else {
+        s_press_start = 0;
+    }
+
     // 设置触摸状态（按下或释放）
     data->state = g_touch_data.is_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
     // 设置触摸点坐标
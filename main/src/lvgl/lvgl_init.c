@@ -8,6 +8,7 @@
 #include "freertos/task.h"
 
 #include "esp_log.h"
+#include "esp_rom_crc.h"
 #include "esp_timer.h"
 
 #include "epaper.h"
@@ -15,13 +16,21 @@
 #include "lv_demos.h"
 #include "lvgl.h"
 
+#include "assets_flat.h"
 #include "config_manager.h"
 #include "dither.h"
+#include "epaper_theme.h"
+#include "images.h"
 #include "lv_port_disp.h"
 #include "lv_port_indev.h"
 #include "lvgl_init.h"
+#include "metrics.h"
+#include "screen_deps.h"
+#include "screen_mirror.h"
 #include "touch.h"
+#include "screens.h"
 #include "ui.h"
+#include "vars.h"
 
 #define TAG "lvgl_init"
 
@@ -37,6 +46,18 @@
 #define MY_DISP_VER_RES 200
 #endif
 
+// 是否使用电子墨水屏专用主题（0 则使用 EEZ 生成代码中的默认主题，便于对比渲染耗时）
+#define LVGL_USE_EPAPER_THEME 1
+
+// 是否记录每个屏幕的渲染耗时；开启后启动时先在两种主题下依次渲染每个屏幕并输出对比
+#define LVGL_RENDER_BENCHMARK 0
+
+// 启动对比中每个屏幕的全屏渲染次数
+#define LVGL_RENDER_BENCHMARK_ROUNDS 9
+
+// EEZ 生成的 ui.c 中的动作表（生成的头文件中没有声明）
+extern ActionExecFunc actions[];
+
 // 局刷计数器和阈值
 static int fast_refresh_count = 0;
 static int max_fast_refresh_count = 30;
@@ -48,10 +69,151 @@ static int max_fast_refresh_count = 30;
 // LVGL 线程互斥锁
 static SemaphoreHandle_t lvgl_mutex = NULL;
 
+// 面板刷新状态，由屏幕刷新线程写入
+static volatile bool refreshing = false;
+static volatile bool last_refresh_full = false;
+static volatile uint32_t refresh_count = 0;
+
+// 每个屏幕的变量观察点，以及上次比对时的屏幕对象（屏幕重新创建后对象会变化）
+static vars_watch_t screen_watch[SCREEN_DEPS_COUNT];
+static lv_obj_t *screen_watch_obj[SCREEN_DEPS_COUNT];
+
+#if LVGL_RENDER_BENCHMARK
+// 本次渲染开始时间（微秒）
+static int64_t render_start_us = 0;
+#endif
+
 // ============================================================================
 // 私有函数
 // ============================================================================
 
+#if LVGL_RENDER_BENCHMARK
+/**
+ * @brief 获取当前活动屏幕名称，用于渲染耗时日志
+ */
+static const char *active_screen_name(void) {
+    lv_obj_t *scr = lv_screen_active();
+    if (scr == objects.main) {
+        return "Main";
+    } else if (scr == objects.menu) {
+        return "Menu";
+    } else if (scr == objects.weather) {
+        return "Weather";
+    }
+    return "Unknown";
+}
+
+/**
+ * @brief 渲染耗时统计回调
+ *
+ * RENDER_START 仅在存在脏区域时发送，REFR_READY 在本轮刷新结束时发送
+ */
+static void render_benchmark_cb(lv_event_t *e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_RENDER_START) {
+        render_start_us = esp_timer_get_time();
+    } else if (code == LV_EVENT_REFR_READY && render_start_us != 0) {
+        int64_t elapsed_us = esp_timer_get_time() - render_start_us;
+        render_start_us = 0;
+        ESP_LOGI(TAG, "Render %s: %lld us (theme=%s)", active_screen_name(), elapsed_us,
+                 LVGL_USE_EPAPER_THEME ? "epaper" : "default");
+    }
+}
+
+/**
+ * @brief 删除所有已创建的屏幕
+ */
+static void render_benchmark_delete_screens(void) {
+    lv_obj_t **screens = (lv_obj_t **)&objects;
+    for (int id = SCREEN_ID_MAIN; id <= SCREEN_DEPS_COUNT; id++) {
+        if (screens[id - 1] != NULL) {
+            delete_screen_by_id((enum ScreensEnum)id);
+        }
+    }
+}
+
+/**
+ * @brief 全屏渲染当前屏幕若干次，输出最小、中位与最大耗时
+ *
+ * lv_refr_now() 包含 LVGL 软件渲染与 disp_flush 中的抖动转换，不包含面板刷新
+ * （屏幕刷新线程此时尚未创建）。
+ */
+static void render_benchmark_screen(const char *theme_name) {
+    int64_t samples[LVGL_RENDER_BENCHMARK_ROUNDS];
+    lv_display_t *disp = lv_port_disp_get();
+    lv_obj_t *scr = lv_screen_active();
+
+    for (int i = 0; i < LVGL_RENDER_BENCHMARK_ROUNDS; i++) {
+        lv_obj_invalidate(scr);
+        int64_t start_us = esp_timer_get_time();
+        lv_refr_now(disp);
+        int64_t elapsed_us = esp_timer_get_time() - start_us;
+
+        // 插入排序，样本数很少
+        int j = i;
+        while (j > 0 && samples[j - 1] > elapsed_us) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = elapsed_us;
+    }
+
+    ESP_LOGI(TAG, "Render benchmark %-7s theme=%-7s min %lld us, median %lld us, max %lld us",
+             active_screen_name(), theme_name, samples[0],
+             samples[LVGL_RENDER_BENCHMARK_ROUNDS / 2], samples[LVGL_RENDER_BENCHMARK_ROUNDS - 1]);
+}
+
+/**
+ * @brief 在默认主题与电子墨水屏主题下分别创建并渲染每个屏幕
+ *
+ * 在 ui_init_assets() 之后、tick 定时器与 LVGL 任务启动之前调用。结束后按
+ * LVGL_USE_EPAPER_THEME 恢复主题，只保留主屏幕，与 create_screens() 之后的状态一致。
+ * 控件显示设计时的初始文本，不执行 tick_screen_*。
+ */
+static void render_benchmark_sweep(void) {
+    lv_display_t *disp = lv_port_disp_get();
+    static const bool themes[] = {false, true};
+
+    for (size_t t = 0; t < sizeof(themes) / sizeof(themes[0]); t++) {
+        const char *theme_name = themes[t] ? "epaper" : "default";
+        render_benchmark_delete_screens();
+        epaper_theme_select(disp, themes[t]);
+
+        for (int id = SCREEN_ID_MAIN; id <= SCREEN_DEPS_COUNT; id++) {
+            create_screen_by_id((enum ScreensEnum)id);
+            lv_screen_load(((lv_obj_t **)&objects)[id - 1]);
+            render_benchmark_screen(theme_name);
+        }
+    }
+
+    render_benchmark_delete_screens();
+    epaper_theme_select(disp, LVGL_USE_EPAPER_THEME);
+    create_screen_by_id(SCREEN_ID_MAIN);
+    lv_screen_load(objects.main);
+}
+#endif
+
+/**
+ * @brief 初始化 EEZ 界面，代替生成的 ui_init() 选择资源来源
+ *
+ * UI_ASSETS_IN_PLACE 时直接使用 assets_flat.c 中未压缩的资源，启动时不分配内存也不解压。
+ * 构建时 tools/eez_assets.py --check 保证 assets_flat 与 ui.c 一致；这里再比对一次 ui.c
+ * 中压缩资源的 CRC32，不一致时退回解压 ui.c 中的资源，界面不会使用过期的数据。
+ */
+static void ui_init_assets(void) {
+#if UI_ASSETS_IN_PLACE
+    if (sizeof(assets) == UI_ASSETS_FLAT_SOURCE_SIZE &&
+        esp_rom_crc32_le(0, assets, sizeof(assets)) == UI_ASSETS_FLAT_SOURCE_CRC32) {
+        eez_flow_init(assets_flat, sizeof(assets_flat), (lv_obj_t **)&objects, sizeof(objects),
+                      images, sizeof(images), actions);
+        return;
+    }
+    ESP_LOGW(TAG, "assets_flat.c is stale, run tools/eez_assets.py; decompressing ui.c assets");
+#endif
+    eez_flow_init(assets, sizeof(assets), (lv_obj_t **)&objects, sizeof(objects), images,
+                  sizeof(images), actions);
+}
+
 /**
  * @brief 屏幕刷新线程
  *
@@ -68,6 +230,8 @@ static void lvgl_screen_refresh_task(void *param) {
 
         ESP_LOGI(TAG, "Screen refresh task: sending full virtual framebuffer");
 
+        refreshing = true;
+
         // 打开屏幕
         esp_lcd_panel_disp_on_off(s_panel_handle, true);
 
@@ -77,11 +241,15 @@ static void lvgl_screen_refresh_task(void *param) {
             // 使用内置 LUT 局刷模式
             ESP_LOGI(TAG, "Partial refresh (%d/%d)", fast_refresh_count, max_fast_refresh_count);
             epaper_panel_set_refresh_mode(s_panel_handle, true); // 局刷
+            metrics_inc(METRIC_EPD_REFRESH, METRIC_REFRESH_PARTIAL);
+            last_refresh_full = false;
         } else {
             fast_refresh_count = 0;
             // 使用全刷模式重置屏幕
             ESP_LOGI(TAG, "Full refresh (reset screen)");
             epaper_panel_set_refresh_mode(s_panel_handle, false); // 全刷
+            metrics_inc(METRIC_EPD_REFRESH, METRIC_REFRESH_FULL);
+            last_refresh_full = true;
         }
 
         uint8_t *virtual_fb = lv_port_disp_get_fb();
@@ -101,7 +269,52 @@ static void lvgl_screen_refresh_task(void *param) {
         epaper_panel_refresh_screen(s_panel_handle);
         esp_lcd_panel_disp_on_off(s_panel_handle, false);
 
+        // 本次刷新的位图传输与 BUSY 等待耗时
+        uint32_t transfer_us, busy_us;
+        if (epaper_panel_take_timing(s_panel_handle, &transfer_us, &busy_us) == ESP_OK) {
+            metrics_observe(METRIC_EPD_TRANSFER, 0, transfer_us);
+            metrics_observe(METRIC_EPD_BUSY, 0, busy_us);
+        }
+
         lv_port_disp_clear_refresh_flag();
+        refresh_count++;
+        refreshing = false;
+
+        // 向屏幕镜像客户端推送本次刷新的脏区
+        screen_mirror_commit();
+    }
+}
+
+/**
+ * @brief 代替 ui_tick()：只在当前屏幕依赖的变量变化时执行 tick_screen_*
+ *
+ * 依赖表 screen_deps 由 tools/eez_bindings.py 生成，生成的 ui.c / screens.c 不做修改。
+ * 屏幕首次出现或重新创建后总是执行一次，保证控件拿到初始值。
+ */
+static void ui_tick_changed(void) {
+    eez_flow_tick();
+
+    int screen = g_currentScreen;
+    if (screen < 0) {
+        return;
+    }
+    if (screen >= SCREEN_DEPS_COUNT) {
+        tick_screen(screen);
+        return;
+    }
+
+    lv_obj_t *obj = ((lv_obj_t **)&objects)[screen];
+    if (obj == NULL) {
+        return;
+    }
+    if (obj != screen_watch_obj[screen]) {
+        screen_watch_obj[screen] = obj;
+        vars_watch_reset(&screen_watch[screen]);
+    }
+
+    uint32_t changed = vars_watch_poll(&screen_watch[screen]);
+    if ((changed & screen_deps[screen]) != 0 || screen_deps[screen] == SCREEN_DEPS_ALWAYS) {
+        tick_screen(screen);
     }
 }
 
@@ -113,7 +326,11 @@ static void lvgl_screen_refresh_task(void *param) {
 static void increase_lvgl_tick(void *arg) {
     xSemaphoreTake(lvgl_mutex, portMAX_DELAY);
     lv_tick_inc(LVGL_TICK_PERIOD_MS);
-    ui_tick();
+    int64_t start_us = esp_timer_get_time();
+    // 取最近一次提交的界面变量，本次 tick 中所有控件看到同一份数据
+    vars_sync();
+    ui_tick_changed();
+    metrics_observe(METRIC_UI_TICK, 0, esp_timer_get_time() - start_us);
     xSemaphoreGive(lvgl_mutex);
 }
 
@@ -125,7 +342,9 @@ static void increase_lvgl_tick(void *arg) {
 static void lvgl_timer_task(void *param) {
     while (1) {
         xSemaphoreTake(lvgl_mutex, portMAX_DELAY);
+        int64_t start_us = esp_timer_get_time();
         lv_timer_handler();
+        metrics_observe(METRIC_LV_TIMER, 0, esp_timer_get_time() - start_us);
         xSemaphoreGive(lvgl_mutex);
 
         vTaskDelay(pdMS_TO_TICKS(LVGL_TICK_PERIOD_MS));
@@ -138,6 +357,14 @@ static void lvgl_timer_task(void *param) {
 
 SemaphoreHandle_t lvgl_get_mutex(void) { return lvgl_mutex; }
 
+void lvgl_get_refresh_state(lvgl_refresh_state_t *state) {
+    state->pending = lv_port_disp_needs_refresh();
+    state->refreshing = refreshing;
+    state->last_full = last_refresh_full;
+    state->count = refresh_count;
+    state->partial_left = max_fast_refresh_count - fast_refresh_count;
+}
+
 void lvgl_init_epaper_display(void) {
     ESP_LOGI(TAG, "Initializing LVGL for e-paper display");
 
@@ -169,10 +396,28 @@ void lvgl_init_epaper_display(void) {
     // 初始化输入设备
     lv_port_indev_init();
 
-    // 初始化 UI（必须在启动 tick 定时器之前，否则 ui_tick() 会访问未初始化的屏幕）
-    ui_init();
+#if LVGL_USE_EPAPER_THEME
+    // 安装电子墨水屏主题（必须在 ui_init_assets 之前，生成代码中的默认主题会被接管）
+    epaper_theme_install(lv_port_disp_get());
+#endif
+
+    // 初始化 UI（必须在启动 tick 定时器之前，否则 tick 会访问未初始化的屏幕）
+    ui_init_assets();
+
+#if LVGL_USE_EPAPER_THEME
+    // 生成代码以不同参数重新初始化默认主题时，电子墨水屏主题被覆盖（见 epaper_theme.h）
+    if (!epaper_theme_is_active(lv_port_disp_get())) {
+        ESP_LOGW(TAG, "E-paper theme overridden by create_screens(), check theme arguments");
+    }
+#endif
+
+#if LVGL_RENDER_BENCHMARK
+    render_benchmark_sweep();
+    lv_display_add_event_cb(lv_port_disp_get(), render_benchmark_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(lv_port_disp_get(), render_benchmark_cb, LV_EVENT_REFR_READY, NULL);
+#endif
 
-    // 配置 LVGL 系统时钟定时器（在 ui_init 之后启动，确保 currentScreen 已有效）
+    // 配置 LVGL 系统时钟定时器（在 ui_init_assets 之后启动，确保 currentScreen 已有效）
     ESP_LOGI(TAG, "Setting up LVGL tick timer");
     const esp_timer_create_args_t lvgl_tick_timer_args = {.callback = &increase_lvgl_tick,
                                                           .name = "lvgl_tick"};
@@ -0,0 +1,335 @@
+/**
+ * @file http_cache.c
+ * @brief 以 URL 为键的 HTTP 响应缓存实现
+ *
+ * 条目保存在 PSRAM 中，包含完整 URL（URL 中带有 API Key，仅用于比对，不会输出到日志）、
+ * 校验信息以及解析结果的副本。条目满时淘汰最久未使用的一项。
+ */
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "http_cache.h"
+
+#define TAG "http_cache"
+
+/**
+ * @brief 缓存条目
+ */
+typedef struct {
+    bool valid;                            ///< 是否有效
+    uint32_t url_hash;                     ///< URL 哈希，用于快速比对
+    char url[HTTP_CACHE_URL_MAX];          ///< 完整 URL
+    http_cache_meta_t meta;                ///< 校验信息
+    char update_time[HTTP_CACHE_DATE_MAX]; ///< 业务更新时间
+    int64_t expires_us;                    ///< 新鲜期截止时间（esp_timer 时间），0 表示需要重新验证
+    int64_t last_used_us;                  ///< 最近一次使用时间
+    size_t wire_bytes;                     ///< 上一次 200 响应体的传输字节数
+    void *result;                          ///< 解析结果副本
+    size_t result_size;                    ///< 解析结果大小
+} http_cache_entry_t;
+
+static http_cache_entry_t *s_entries = NULL;
+static SemaphoreHandle_t s_mutex = NULL;
+static http_cache_stats_t s_stats;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+static uint32_t url_hash(const char *url) {
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    while (*url != '\0') {
+        h ^= (uint8_t)*url++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief 查找条目（需持有互斥锁）
+ */
+static http_cache_entry_t *find_locked(const char *url) {
+    uint32_t h = url_hash(url);
+    for (int i = 0; i < HTTP_CACHE_SIZE; i++) {
+        http_cache_entry_t *e = &s_entries[i];
+        if (e->valid && e->url_hash == h && strcmp(e->url, url) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 获取可写入的条目：已有条目、空条目或最久未使用的条目（需持有互斥锁）
+ */
+static http_cache_entry_t *slot_for_locked(const char *url) {
+    http_cache_entry_t *e = find_locked(url);
+    if (e != NULL) {
+        return e;
+    }
+
+    http_cache_entry_t *victim = &s_entries[0];
+    for (int i = 0; i < HTTP_CACHE_SIZE; i++) {
+        if (!s_entries[i].valid) {
+            return &s_entries[i];
+        }
+        if (s_entries[i].last_used_us < victim->last_used_us) {
+            victim = &s_entries[i];
+        }
+    }
+    victim->valid = false;
+    return victim;
+}
+
+/**
+ * @brief 按响应头更新新鲜期
+ */
+static void update_expiry(http_cache_entry_t *e, const http_cache_meta_t *meta, int64_t now) {
+    if (!meta->revalidate && meta->max_age_s > 0) {
+        e->expires_us = now + (int64_t)meta->max_age_s * 1000000;
+    } else {
+        e->expires_us = 0;
+    }
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t http_cache_init(void) {
+    if (s_mutex != NULL) {
+        return ESP_OK;
+    }
+
+    s_entries = heap_caps_calloc(HTTP_CACHE_SIZE, sizeof(http_cache_entry_t), MALLOC_CAP_SPIRAM);
+    if (s_entries == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate cache entries");
+        return ESP_ERR_NO_MEM;
+    }
+
+    s_mutex = xSemaphoreCreateMutex();
+    if (s_mutex == NULL) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        heap_caps_free(s_entries);
+        s_entries = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    ESP_LOGI(TAG, "HTTP cache initialized (%d entries)", HTTP_CACHE_SIZE);
+    return ESP_OK;
+}
+
+void http_cache_meta_init(http_cache_meta_t *meta) {
+    memset(meta, 0, sizeof(http_cache_meta_t));
+    meta->max_age_s = -1;
+}
+
+void http_cache_parse_header(http_cache_meta_t *meta, const char *key, const char *value) {
+    if (meta == NULL || key == NULL || value == NULL) {
+        return;
+    }
+
+    if (strcasecmp(key, "ETag") == 0) {
+        snprintf(meta->etag, sizeof(meta->etag), "%s", value);
+    } else if (strcasecmp(key, "Last-Modified") == 0) {
+        snprintf(meta->last_modified, sizeof(meta->last_modified), "%s", value);
+    } else if (strcasecmp(key, "Cache-Control") == 0) {
+        // 指令不区分大小写，转为小写后再匹配
+        char directives[128];
+        size_t i = 0;
+        for (; value[i] != '\0' && i < sizeof(directives) - 1; i++) {
+            directives[i] = (char)tolower((unsigned char)value[i]);
+        }
+        directives[i] = '\0';
+
+        if (strstr(directives, "no-store") != NULL || strstr(directives, "no-cache") != NULL) {
+            meta->revalidate = true;
+        }
+        const char *p = strstr(directives, "max-age=");
+        if (p != NULL) {
+            meta->max_age_s = (int32_t)strtol(p + strlen("max-age="), NULL, 10);
+        }
+    }
+}
+
+esp_err_t http_cache_get_fresh(const char *url, void *result, size_t size) {
+    if (s_mutex == NULL || url == NULL || result == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    int64_t now = esp_timer_get_time();
+    int64_t left_s = 0;
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    http_cache_entry_t *e = find_locked(url);
+    if (e != NULL && e->result_size == size && e->expires_us > now) {
+        left_s = (e->expires_us - now) / 1000000;
+        memcpy(result, e->result, size);
+        e->last_used_us = now;
+        s_stats.fresh_hits++;
+        s_stats.parses_skipped++;
+        s_stats.bytes_saved += e->wire_bytes;
+        ret = ESP_OK;
+    }
+    xSemaphoreGive(s_mutex);
+
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "Fresh hit, request skipped (%lld s left)", left_s);
+    }
+    return ret;
+}
+
+void http_cache_prepare_request(const char *url, esp_http_client_handle_t client,
+                                char *update_time, size_t update_time_size) {
+    char etag[HTTP_CACHE_ETAG_MAX] = {0};
+    char last_modified[HTTP_CACHE_DATE_MAX] = {0};
+
+    if (update_time != NULL && update_time_size > 0) {
+        update_time[0] = '\0';
+    }
+
+    if (s_mutex != NULL && url != NULL) {
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        http_cache_entry_t *e = find_locked(url);
+        if (e != NULL) {
+            memcpy(etag, e->meta.etag, sizeof(etag));
+            memcpy(last_modified, e->meta.last_modified, sizeof(last_modified));
+            if (update_time != NULL && update_time_size > 0) {
+                snprintf(update_time, update_time_size, "%s", e->update_time);
+            }
+        }
+        xSemaphoreGive(s_mutex);
+    }
+
+    if (etag[0] != '\0') {
+        esp_http_client_set_header(client, "If-None-Match", etag);
+    } else {
+        esp_http_client_delete_header(client, "If-None-Match");
+    }
+
+    if (last_modified[0] != '\0') {
+        esp_http_client_set_header(client, "If-Modified-Since", last_modified);
+    } else {
+        esp_http_client_delete_header(client, "If-Modified-Since");
+    }
+}
+
+esp_err_t http_cache_revalidated(const char *url, const http_cache_meta_t *meta,
+                                 bool not_modified, void *result, size_t size) {
+    if (s_mutex == NULL || url == NULL || result == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    int64_t now = esp_timer_get_time();
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    http_cache_entry_t *e = find_locked(url);
+    if (e != NULL && e->result_size == size) {
+        memcpy(result, e->result, size);
+        e->last_used_us = now;
+
+        // 304 可以携带新的校验信息，未携带时沿用旧值
+        if (meta != NULL) {
+            if (meta->etag[0] != '\0') {
+                memcpy(e->meta.etag, meta->etag, sizeof(e->meta.etag));
+            }
+            if (meta->last_modified[0] != '\0') {
+                memcpy(e->meta.last_modified, meta->last_modified, sizeof(e->meta.last_modified));
+            }
+            if (meta->max_age_s >= 0 || meta->revalidate) {
+                e->meta.max_age_s = meta->max_age_s;
+                e->meta.revalidate = meta->revalidate;
+            }
+        }
+        update_expiry(e, &e->meta, now);
+
+        if (not_modified) {
+            s_stats.not_modified++;
+            s_stats.bytes_saved += e->wire_bytes;
+        } else {
+            s_stats.unchanged++;
+        }
+        s_stats.parses_skipped++;
+        ret = ESP_OK;
+    }
+    xSemaphoreGive(s_mutex);
+
+    return ret;
+}
+
+esp_err_t http_cache_store(const char *url, const http_cache_meta_t *meta,
+                           const char *update_time, const void *result, size_t size,
+                           size_t wire_bytes) {
+    if (s_mutex == NULL || url == NULL || meta == NULL || result == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (strlen(url) >= HTTP_CACHE_URL_MAX) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    int64_t now = esp_timer_get_time();
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    http_cache_entry_t *e = slot_for_locked(url);
+
+    if (e->result == NULL || e->result_size != size) {
+        void *buf = heap_caps_realloc(e->result, size, MALLOC_CAP_SPIRAM);
+        if (buf == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate %u bytes for cached result", (unsigned)size);
+            e->valid = false;
+            xSemaphoreGive(s_mutex);
+            return ESP_ERR_NO_MEM;
+        }
+        e->result = buf;
+        e->result_size = size;
+    }
+
+    memcpy(e->result, result, size);
+    snprintf(e->url, sizeof(e->url), "%s", url);
+    e->url_hash = url_hash(url);
+    e->meta = *meta;
+    snprintf(e->update_time, sizeof(e->update_time), "%s", update_time ? update_time : "");
+    e->wire_bytes = wire_bytes;
+    e->last_used_us = now;
+    update_expiry(e, meta, now);
+    e->valid = true;
+    s_stats.stores++;
+    xSemaphoreGive(s_mutex);
+
+    return ESP_OK;
+}
+
+void http_cache_note_refresh_skipped(void) {
+    if (s_mutex == NULL) {
+        return;
+    }
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    s_stats.refreshes_skipped++;
+    xSemaphoreGive(s_mutex);
+}
+
+void http_cache_get_stats(http_cache_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    if (s_mutex == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    *stats = s_stats;
+    xSemaphoreGive(s_mutex);
+}
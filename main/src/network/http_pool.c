@@ -0,0 +1,375 @@
+/**
+ * @file http_pool.c
+ * @brief 按主机复用的 HTTPS 客户端连接池实现
+ *
+ * - 句柄复用：保留 esp_http_client 及其收发缓冲区，服务器未关闭时直接复用 TCP/TLS 连接
+ * - 会话恢复：开启 save_client_session，重连时携带 TLS 会话票据，避免完整证书链校验
+ * - 域名解析：lwIP 的 DNS 表按记录 TTL 缓存解析结果，复用连接时不再发起解析
+ */
+
+#include "esp_crt_bundle.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "http_pool.h"
+#include "wifi.h"
+
+#define TAG "http_pool"
+
+/**
+ * @brief 连接池槽位
+ */
+typedef struct {
+    char host[HTTP_POOL_HOST_MAX];   ///< 主机名（含端口）
+    esp_http_client_handle_t client; ///< 客户端句柄，NULL 表示空槽
+    bool pooled;                     ///< 是否属于连接池（否则为临时客户端）
+    bool in_use;                     ///< 是否正被某个请求占用
+    bool connected;                  ///< 底层连接是否处于打开状态
+    bool connected_now;              ///< 本次请求是否新建了连接
+    bool got_response;               ///< 本次请求是否已收到响应头或数据
+    int64_t last_used_us;            ///< 最近一次归还时间
+    int64_t perform_start_us;        ///< 本次请求开始时间
+    int64_t connect_us;              ///< 本次请求建连耗时（微秒），请求结束后计入统计
+    http_event_handle_cb handler;    ///< 调用者的事件回调
+    void *user_data;                 ///< 调用者的 user_data
+} http_pool_slot_t;
+
+static http_pool_slot_t s_slots[HTTP_POOL_SIZE];
+static SemaphoreHandle_t s_mutex = NULL;
+// 统计，受 s_mutex 保护
+static http_pool_stats_t s_stats;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+/**
+ * @brief 从 URL 中提取主机名（含端口）
+ */
+static bool parse_host(const char *url, char *host, size_t host_size) {
+    const char *p = strstr(url, "://");
+    p = (p != NULL) ? p + 3 : url;
+
+    size_t len = strcspn(p, "/?#");
+    if (len == 0 || len >= host_size) {
+        return false;
+    }
+    memcpy(host, p, len);
+    host[len] = '\0';
+    return true;
+}
+
+/**
+ * @brief 事件分发：记录连接状态后转发给调用者的回调
+ */
+static esp_err_t pool_event_handler(esp_http_client_event_t *evt) {
+    http_pool_slot_t *slot = (http_pool_slot_t *)evt->user_data;
+
+    switch (evt->event_id) {
+    case HTTP_EVENT_ON_CONNECTED: {
+        int64_t elapsed = esp_timer_get_time() - slot->perform_start_us;
+        slot->connected = true;
+        slot->connected_now = true;
+        slot->connect_us = elapsed;
+        ESP_LOGD(TAG, "Connected to %s in %lld us", slot->host, elapsed);
+        break;
+    }
+    case HTTP_EVENT_ON_HEADER:
+    case HTTP_EVENT_ON_DATA:
+        slot->got_response = true;
+        break;
+    case HTTP_EVENT_DISCONNECTED:
+        slot->connected = false;
+        break;
+    default:
+        break;
+    }
+
+    if (slot->handler == NULL) {
+        return ESP_OK;
+    }
+
+    evt->user_data = slot->user_data;
+    esp_err_t ret = slot->handler(evt);
+    evt->user_data = slot;
+    return ret;
+}
+
+/**
+ * @brief 为槽位创建客户端
+ */
+static esp_err_t slot_create_client(http_pool_slot_t *slot, const char *url) {
+    esp_http_client_config_t config = {
+        .url = url,
+        .event_handler = pool_event_handler,
+        .crt_bundle_attach = esp_crt_bundle_attach,
+        .user_data = slot,
+        .keep_alive_enable = true,
+#if CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
+        .save_client_session = true,
+#endif
+    };
+
+    slot->client = esp_http_client_init(&config);
+    slot->connected = false;
+    return (slot->client != NULL) ? ESP_OK : ESP_FAIL;
+}
+
+/**
+ * @brief 释放槽位中的客户端
+ */
+static void slot_destroy_client(http_pool_slot_t *slot) {
+    if (slot->client != NULL) {
+        esp_http_client_cleanup(slot->client);
+        slot->client = NULL;
+    }
+    slot->connected = false;
+    slot->host[0] = '\0';
+}
+
+/**
+ * @brief 为主机挑选槽位（需持有互斥锁）
+ *
+ * 优先同主机的空闲槽位，其次空槽位，最后淘汰最久未使用的空闲槽位。
+ */
+static http_pool_slot_t *pick_slot_locked(const char *host) {
+    http_pool_slot_t *empty = NULL;
+    http_pool_slot_t *lru = NULL;
+
+    for (int i = 0; i < HTTP_POOL_SIZE; i++) {
+        http_pool_slot_t *slot = &s_slots[i];
+        if (slot->in_use) {
+            continue;
+        }
+        if (slot->client != NULL && strcmp(slot->host, host) == 0) {
+            return slot;
+        }
+        if (slot->client == NULL) {
+            if (empty == NULL) {
+                empty = slot;
+            }
+        } else if (lru == NULL || slot->last_used_us < lru->last_used_us) {
+            lru = slot;
+        }
+    }
+
+    if (empty != NULL) {
+        return empty;
+    }
+    if (lru != NULL) {
+        ESP_LOGI(TAG, "Evicting %s", lru->host);
+        slot_destroy_client(lru);
+        s_stats.evictions++;
+    }
+    return lru;
+}
+
+static http_pool_slot_t *slot_from_client(esp_http_client_handle_t client) {
+    void *data = NULL;
+    if (client == NULL || esp_http_client_get_user_data(client, &data) != ESP_OK) {
+        return NULL;
+    }
+    return (http_pool_slot_t *)data;
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t http_pool_init(void) {
+    if (s_mutex != NULL) {
+        return ESP_OK;
+    }
+
+    s_mutex = xSemaphoreCreateMutex();
+    if (s_mutex == NULL) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        return ESP_ERR_NO_MEM;
+    }
+
+    memset(s_slots, 0, sizeof(s_slots));
+    memset(&s_stats, 0, sizeof(s_stats));
+    ESP_LOGI(TAG, "HTTP pool initialized (%d slots)", HTTP_POOL_SIZE);
+    return ESP_OK;
+}
+
+esp_http_client_handle_t http_pool_acquire(const char *url, http_event_handle_cb event_handler,
+                                           void *user_data) {
+    char host[HTTP_POOL_HOST_MAX];
+    if (url == NULL || s_mutex == NULL || !parse_host(url, host, sizeof(host))) {
+        ESP_LOGE(TAG, "Invalid URL or pool not initialized");
+        return NULL;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    http_pool_slot_t *slot = pick_slot_locked(host);
+    if (slot != NULL) {
+        slot->in_use = true;
+        slot->pooled = true;
+    }
+    xSemaphoreGive(s_mutex);
+
+    if (slot == NULL) {
+        // 所有槽位都在使用中，创建一次性客户端
+        slot = heap_caps_calloc(1, sizeof(http_pool_slot_t), MALLOC_CAP_SPIRAM);
+        if (slot == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate overflow slot");
+            return NULL;
+        }
+        slot->in_use = true;
+        slot->pooled = false;
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        s_stats.overflow++;
+        xSemaphoreGive(s_mutex);
+    }
+
+    slot->handler = event_handler;
+    slot->user_data = user_data;
+
+    if (slot->client == NULL) {
+        snprintf(slot->host, sizeof(slot->host), "%s", host);
+        if (slot_create_client(slot, url) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to initialize HTTP client for %s", host);
+            if (!slot->pooled) {
+                heap_caps_free(slot);
+                return NULL;
+            }
+            xSemaphoreTake(s_mutex, portMAX_DELAY);
+            slot->host[0] = '\0';
+            slot->in_use = false;
+            xSemaphoreGive(s_mutex);
+            return NULL;
+        }
+        return slot->client;
+    }
+
+    // 服务器一般在空闲数十秒后关闭连接，提前关闭以免在半开连接上发送请求
+    int64_t idle_ms = (esp_timer_get_time() - slot->last_used_us) / 1000;
+    if (slot->connected && idle_ms > HTTP_POOL_IDLE_CLOSE_MS) {
+        esp_http_client_close(slot->client);
+        slot->connected = false;
+    }
+
+    esp_http_client_set_url(slot->client, url);
+    return slot->client;
+}
+
+esp_err_t http_pool_perform(esp_http_client_handle_t client) {
+    http_pool_slot_t *slot = slot_from_client(client);
+    if (slot == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    bool was_connected = slot->connected;
+    bool stale_retry = false;
+    slot->connected_now = false;
+    slot->got_response = false;
+    slot->perform_start_us = esp_timer_get_time();
+
+    esp_err_t err = esp_http_client_perform(client);
+
+    if (err != ESP_OK && was_connected && !slot->connected_now && !slot->got_response) {
+        // 复用的连接已被对端关闭：重连后重试一次（尚未向调用者转发任何数据，重试是安全的）
+        ESP_LOGW(TAG, "Keep-alive connection to %s was stale, reconnecting", slot->host);
+        esp_http_client_close(client);
+        slot->connected = false;
+        stale_retry = true;
+        slot->perform_start_us = esp_timer_get_time();
+        err = esp_http_client_perform(client);
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    s_stats.requests++;
+    if (stale_retry) {
+        s_stats.stale_retries++;
+    }
+    if (slot->connected_now) {
+        s_stats.connects++;
+        s_stats.connect_us_total += slot->connect_us;
+        s_stats.last_connect_us = slot->connect_us;
+    } else if (err == ESP_OK) {
+        s_stats.reused++;
+    }
+    xSemaphoreGive(s_mutex);
+
+    if (slot->got_response) {
+        wifi_note_first_byte();
+    }
+
+    if (err != ESP_OK) {
+        // 出错后连接状态不确定，下次请求重新建连（仍可使用会话票据）
+        esp_http_client_close(client);
+        slot->connected = false;
+    }
+
+    ESP_LOGD(TAG, "%s: %s connection, %lld us", slot->host,
+             slot->connected_now ? "new" : "reused", esp_timer_get_time() - slot->perform_start_us);
+    return err;
+}
+
+void http_pool_release(esp_http_client_handle_t client) {
+    http_pool_slot_t *slot = slot_from_client(client);
+    if (slot == NULL) {
+        return;
+    }
+
+    slot->handler = NULL;
+    slot->user_data = NULL;
+
+    if (!slot->pooled) {
+        esp_http_client_cleanup(client);
+        heap_caps_free(slot);
+        return;
+    }
+
+    // 句柄按主机共享：本次请求的条件请求头不能带到下一个调用者的其他 URL 上
+    esp_http_client_delete_header(client, "If-None-Match");
+    esp_http_client_delete_header(client, "If-Modified-Since");
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    slot->last_used_us = esp_timer_get_time();
+    slot->in_use = false;
+    xSemaphoreGive(s_mutex);
+}
+
+void http_pool_flush(void) {
+    if (s_mutex == NULL) {
+        return;
+    }
+
+    // 只关闭连接、保留句柄：会话票据保存在句柄中，销毁句柄会让重连退回完整握手
+    int flushed = 0;
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    for (int i = 0; i < HTTP_POOL_SIZE; i++) {
+        http_pool_slot_t *slot = &s_slots[i];
+        if (!slot->in_use && slot->client != NULL && slot->connected) {
+            esp_http_client_close(slot->client);
+            slot->connected = false;
+            flushed++;
+        }
+    }
+    xSemaphoreGive(s_mutex);
+
+    if (flushed > 0) {
+        ESP_LOGI(TAG, "Closed %d idle connections", flushed);
+    }
+}
+
+void http_pool_get_stats(http_pool_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    if (s_mutex == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    *stats = s_stats;
+    xSemaphoreGive(s_mutex);
+}
@@ -0,0 +1,654 @@
+/**
+ * @file live_sync.c
+ * @brief 实时同步：通过 WebSocket 推送配置与界面状态的增量
+ *
+ * 比对、发送与连接列表的修改都在 HTTP 服务器任务中进行（定时器回调与配置通知只排队
+ * 工作函数），不需要额外的锁。界面变量以 vars_read 读取一致的快照，按版本号比对；
+ * 遇到进行中的提交时沿用上一份快照，下一次比对再读取。
+ */
+
+#include "live_sync.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/select.h>
+
+#include "cJSON.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+
+#include "lvgl_init.h"
+#include "vars.h"
+#include "webserver.h"
+
+#define TAG "live_sync"
+
+#define COUNT_OF(a) ((int)(sizeof(a) / sizeof((a)[0])))
+
+/**
+ * @brief 推送的界面变量
+ */
+typedef struct {
+    const char *name;    ///< JSON 字段名
+    enum NativeVarId id; ///< 变量
+} live_var_t;
+
+/**
+ * @brief 待发送项
+ */
+typedef struct {
+    uint32_t vars;   ///< 界面变量位图，按 s_vars 的下标
+    uint16_t config; ///< 配置分组位图，按 s_config_groups 的下标
+    bool refresh;    ///< 面板刷新状态
+} dirty_t;
+
+/**
+ * @brief 连接
+ */
+typedef struct {
+    int fd;                   ///< 套接字
+    bool full;                ///< 下一条消息为完整快照
+    dirty_t dirty;            ///< 尚未发送的变化
+    int64_t connected_us;     ///< 连接时间
+    int64_t stalled_since_us; ///< 开始不可写的时间，0 表示可写
+    uint32_t messages;        ///< 发送的消息数
+    uint32_t bytes;           ///< 发送的字节数
+    uint32_t deferred;        ///< 推迟发送的次数
+    uint32_t cpu_us;          ///< 累计耗时（微秒）
+} client_t;
+
+// ============================================================================
+// 私有变量
+// ============================================================================
+
+static const live_var_t s_vars[] = {
+    {"current_time", NATIVE_VAR_ID_CURRENT_TIME},
+    {"current_date", NATIVE_VAR_ID_CURRENT_DATE},
+    {"current_weekday", NATIVE_VAR_ID_CURRENT_WEEKDAY},
+    {"yiyan", NATIVE_VAR_ID_YIYAN},
+    {"solar_term", NATIVE_VAR_ID_SOLAR_TERM},
+    {"weather_text", NATIVE_VAR_ID_WEATHER_TEXT},
+    {"weather_icon", NATIVE_VAR_ID_WEATHER_ICON},
+    {"weather_temp", NATIVE_VAR_ID_WEATHER_TEMP},
+    {"weather_uptime", NATIVE_VAR_ID_WEATHER_UPTIME},
+    {"weather_location", NATIVE_VAR_ID_WEATHER_LOCATION},
+    {"weather_feelslike", NATIVE_VAR_ID_WEATHER_FEELSLIKE},
+    {"weather_wind_dir", NATIVE_VAR_ID_WEATHER_WIND_DIR},
+    {"weather_wind_scale", NATIVE_VAR_ID_WEATHER_WIND_SCALE},
+    {"weather_humidity", NATIVE_VAR_ID_WEATHER_HUMIDITY},
+    {"weather_precip", NATIVE_VAR_ID_WEATHER_PRECIP},
+    {"weather_pressure", NATIVE_VAR_ID_WEATHER_PRESSURE},
+    {"weather_visibility", NATIVE_VAR_ID_WEATHER_VISIBILITY},
+    {"weather_cloud", NATIVE_VAR_ID_WEATHER_CLOUD},
+    {"weather_dew", NATIVE_VAR_ID_WEATHER_DEW},
+};
+
+/** @brief 配置分组，即 webserver_config_to_json() 的顶层字段 */
+static const char *const s_config_groups[] = {
+    "device_name", "wifi", "display", "ip_location", "location",
+    "weather",     "yiyan", "time",   "power",       "mqtt",
+};
+
+_Static_assert(COUNT_OF(s_vars) <= 32, "dirty_t.vars is a 32-bit mask");
+_Static_assert(COUNT_OF(s_config_groups) <= 16, "dirty_t.config is a 16-bit mask");
+
+static httpd_handle_t s_server = NULL;
+static esp_timer_handle_t s_timer = NULL;
+static bool s_timer_running = false;
+
+static client_t s_clients[LIVE_SYNC_MAX_CLIENTS];
+static uint8_t s_client_count = 0;
+
+/** @brief 比对工作函数已排队，未执行前不重复排队 */
+static volatile bool s_poll_queued = false;
+/** @brief 配置已修改，下一次比对包括配置 */
+static volatile bool s_config_changed = false;
+
+/** @brief 最近一次读到的界面变量快照（PSRAM），以及推送时各变量的版本号 */
+static vars_snapshot_t *s_snapshot = NULL;
+static uint32_t s_var_version[COUNT_OF(s_vars)];
+
+/** @brief 配置分组与面板刷新状态最近一次推送时的 CRC32 */
+static uint32_t s_config_crc[COUNT_OF(s_config_groups)];
+static uint32_t s_refresh_crc = 0;
+
+static uint32_t s_seq = 0;
+
+/** @brief 没有连接时的内部 RAM 空闲量，用于估算每个连接的占用 */
+static size_t s_heap_idle = 0;
+
+static live_sync_stats_t s_stats = {.heap_per_client = -1};
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+static uint32_t crc_str(const char *text) {
+    return esp_rom_crc32_le(0, (const uint8_t *)text, strlen(text));
+}
+
+/**
+ * @brief 读取界面变量快照并按版本号比对
+ *
+ * @return 变化的变量位图；遇到进行中的提交时为 0，快照保持不变
+ */
+static uint32_t diff_vars(void) {
+    if (!vars_read(s_snapshot)) {
+        return 0;
+    }
+    uint32_t changed = 0;
+    for (int i = 0; i < COUNT_OF(s_vars); i++) {
+        uint32_t version = s_snapshot->versions[s_vars[i].id];
+        if (version != s_var_version[i]) {
+            s_var_version[i] = version;
+            changed |= 1u << i;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief 比对面板刷新状态
+ *
+ * @return true 状态变化
+ */
+static bool diff_refresh(void) {
+    lvgl_refresh_state_t state;
+    memset(&state, 0, sizeof(state));
+    lvgl_get_refresh_state(&state);
+
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)&state, sizeof(state));
+    if (crc == s_refresh_crc) {
+        return false;
+    }
+    s_refresh_crc = crc;
+    return true;
+}
+
+/**
+ * @brief 比对配置分组
+ *
+ * @param config webserver_config_to_json() 的结果
+ * @return 变化的分组位图
+ */
+static uint16_t diff_config(const cJSON *config) {
+    uint16_t changed = 0;
+    for (int i = 0; i < COUNT_OF(s_config_groups); i++) {
+        char *text =
+            cJSON_PrintUnformatted(cJSON_GetObjectItemCaseSensitive(config, s_config_groups[i]));
+        if (text == NULL) {
+            continue;
+        }
+        uint32_t crc = crc_str(text);
+        cJSON_free(text);
+        if (crc != s_config_crc[i]) {
+            s_config_crc[i] = crc;
+            changed |= 1u << i;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief 生成一条消息
+ *
+ * @param dirty 要包含的项
+ * @param full true 时为完整快照
+ * @param config 当前配置，不包含配置分组时可为 NULL
+ * @return 新分配的 JSON 文本，由调用者以 cJSON_free 释放；内存不足时为 NULL
+ */
+static char *build_message(const dirty_t *dirty, bool full, const cJSON *config) {
+    cJSON *root = cJSON_CreateObject();
+    if (root == NULL) {
+        return NULL;
+    }
+    cJSON_AddStringToObject(root, "type", full ? "full" : "patch");
+    cJSON_AddNumberToObject(root, "seq", ++s_seq);
+
+    if (dirty->vars != 0) {
+        cJSON *vars = cJSON_AddObjectToObject(root, "vars");
+        for (int i = 0; i < COUNT_OF(s_vars); i++) {
+            if ((dirty->vars & (1u << i)) == 0) {
+                continue;
+            }
+            enum NativeVarId id = s_vars[i].id;
+            if (vars_type(id) == VAR_TYPE_STRING) {
+                cJSON_AddStringToObject(vars, s_vars[i].name, vars_snapshot_str(s_snapshot, id));
+            } else {
+                cJSON_AddNumberToObject(vars, s_vars[i].name, vars_snapshot_int(s_snapshot, id));
+            }
+        }
+    }
+
+    if (dirty->refresh) {
+        lvgl_refresh_state_t state;
+        lvgl_get_refresh_state(&state);
+        cJSON *refresh = cJSON_AddObjectToObject(root, "refresh");
+        cJSON_AddBoolToObject(refresh, "pending", state.pending);
+        cJSON_AddBoolToObject(refresh, "refreshing", state.refreshing);
+        cJSON_AddBoolToObject(refresh, "last_full", state.last_full);
+        cJSON_AddNumberToObject(refresh, "count", state.count);
+        cJSON_AddNumberToObject(refresh, "partial_left", state.partial_left);
+    }
+
+    if (dirty->config != 0 && config != NULL) {
+        cJSON *groups = cJSON_AddObjectToObject(root, "config");
+        for (int i = 0; i < COUNT_OF(s_config_groups); i++) {
+            const cJSON *item = cJSON_GetObjectItemCaseSensitive(config, s_config_groups[i]);
+            if ((dirty->config & (1u << i)) != 0 && item != NULL) {
+                cJSON_AddItemToObject(groups, s_config_groups[i], cJSON_Duplicate(item, true));
+            }
+        }
+    }
+
+    char *text = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    return text;
+}
+
+/**
+ * @brief 套接字发送缓冲区是否有空间（不阻塞）
+ *
+ * lwIP 只在空闲空间超过 TCP_SNDLOWAT（TCP_SND_BUF 4096、MSS 1440 时为 2881 字节）时报告
+ * 可写，不超过这个长度的帧随后发送时不会阻塞。更长的帧（如含完整配置的 full 消息）可能
+ * 等待发送缓冲区，由 WEBSERVER_SEND_WAIT_S 限定：每帧最多阻塞 2 * WEBSERVER_SEND_WAIT_S 秒，
+ * 超时后发送失败，连接被移除。
+ */
+static bool socket_writable(int fd) {
+    fd_set wfds;
+    FD_ZERO(&wfds);
+    FD_SET(fd, &wfds);
+    struct timeval timeout = {0};
+    return select(fd + 1, NULL, &wfds, NULL, &timeout) > 0;
+}
+
+static size_t internal_free(void) { return heap_caps_get_free_size(MALLOC_CAP_INTERNAL); }
+
+static void remove_client(int index) {
+    ESP_LOGI(TAG, "Live client fd=%d gone", s_clients[index].fd);
+    s_clients[index] = s_clients[--s_client_count];
+    s_stats.clients = s_client_count;
+    if (s_client_count == 0) {
+        s_heap_idle = internal_free();
+    }
+}
+
+/**
+ * @brief 移除已断开或被复用的连接
+ *
+ * @param fd 额外需要移除的套接字（新握手复用了旧连接的描述符），-1 表示没有
+ */
+static void prune_clients(int fd) {
+    for (int i = 0; i < s_client_count;) {
+        if (s_clients[i].fd == fd ||
+            httpd_ws_get_fd_info(s_server, s_clients[i].fd) != HTTPD_WS_CLIENT_WEBSOCKET) {
+            remove_client(i);
+        } else {
+            i++;
+        }
+    }
+}
+
+/**
+ * @brief 向一个连接发送它的待发送项
+ *
+ * @return false 发送失败，连接应被移除
+ */
+static bool send_pending(client_t *client, const cJSON *config) {
+    int64_t start_us = esp_timer_get_time();
+
+    dirty_t all = {.vars = UINT32_MAX, .config = UINT16_MAX, .refresh = true};
+    char *text = build_message(client->full ? &all : &client->dirty, client->full, config);
+    if (text == NULL) {
+        // 内存不足：保留待发送项，下次重试
+        return true;
+    }
+
+    size_t len = strlen(text);
+    httpd_ws_frame_t pkt = {
+        .final = true,
+        .type = HTTPD_WS_TYPE_TEXT,
+        .payload = (uint8_t *)text,
+        .len = len,
+    };
+    esp_err_t ret = httpd_ws_send_frame_async(s_server, client->fd, &pkt);
+    cJSON_free(text);
+
+    client->cpu_us += (uint32_t)(esp_timer_get_time() - start_us);
+    if (ret != ESP_OK) {
+        return false;
+    }
+
+    memset(&client->dirty, 0, sizeof(client->dirty));
+    client->full = false;
+    client->messages++;
+    client->bytes += len;
+    s_stats.messages++;
+    s_stats.bytes += len;
+    return true;
+}
+
+/**
+ * @brief 向各连接发送待发送项
+ *
+ * 不可写的连接保留待发送项，之后的变化继续合并进去；持续不可写超时的连接被关闭。
+ *
+ * @param config 当前配置，NULL 时按需生成
+ */
+static void flush_clients(cJSON *config) {
+    bool own_config = false;
+    int64_t now_us = esp_timer_get_time();
+
+    for (int i = 0; i < s_client_count;) {
+        client_t *client = &s_clients[i];
+        if (!client->full && client->dirty.vars == 0 && client->dirty.config == 0 &&
+            !client->dirty.refresh) {
+            i++;
+            continue;
+        }
+
+        if (!socket_writable(client->fd)) {
+            client->deferred++;
+            s_stats.deferred++;
+            if (client->stalled_since_us == 0) {
+                client->stalled_since_us = now_us;
+            } else if (now_us - client->stalled_since_us > LIVE_SYNC_STALL_MS * 1000LL) {
+                ESP_LOGW(TAG, "Live client fd=%d stalled, closing", client->fd);
+                httpd_sess_trigger_close(s_server, client->fd);
+                s_stats.dropped++;
+                remove_client(i);
+                continue;
+            }
+            i++;
+            continue;
+        }
+        client->stalled_since_us = 0;
+
+        if (config == NULL && (client->full || client->dirty.config != 0)) {
+            config = webserver_config_to_json();
+            own_config = true;
+        }
+        if (!send_pending(client, config)) {
+            s_stats.dropped++;
+            remove_client(i);
+            continue;
+        }
+        i++;
+    }
+
+    if (own_config) {
+        cJSON_Delete(config);
+    }
+}
+
+/**
+ * @brief 比对各项并推送变化（在 HTTP 服务器任务中执行）
+ */
+static void poll_work(void *arg) {
+    (void)arg;
+    s_poll_queued = false;
+    if (s_server == NULL) {
+        return;
+    }
+
+    prune_clients(-1);
+    if (s_client_count == 0) {
+        if (s_timer_running) {
+            esp_timer_stop(s_timer);
+            s_timer_running = false;
+        }
+        s_stats.heap_per_client = -1;
+        return;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    dirty_t changed = {.vars = diff_vars(), .refresh = diff_refresh()};
+    cJSON *config = NULL;
+    if (s_config_changed) {
+        config = webserver_config_to_json();
+        if (config != NULL) {
+            s_config_changed = false;
+            changed.config = diff_config(config);
+        }
+    }
+    s_stats.polls++;
+    s_stats.poll_us += esp_timer_get_time() - start_us;
+
+    for (int i = 0; i < s_client_count; i++) {
+        s_clients[i].dirty.vars |= changed.vars;
+        s_clients[i].dirty.config |= changed.config;
+        s_clients[i].dirty.refresh |= changed.refresh;
+    }
+    flush_clients(config);
+    cJSON_Delete(config);
+
+    // 与没有连接时相比减少的内部 RAM，平均到每个连接（含 HTTP 会话与套接字缓冲）
+    size_t free_now = internal_free();
+    if (s_client_count == 0) {
+        s_stats.heap_per_client = -1;
+    } else if (s_heap_idle > free_now) {
+        s_stats.heap_per_client = (int32_t)((s_heap_idle - free_now) / s_client_count);
+    } else {
+        s_stats.heap_per_client = 0;
+    }
+}
+
+static void queue_poll(void) {
+    if (s_server == NULL || s_poll_queued) {
+        return;
+    }
+    s_poll_queued = true;
+    if (httpd_queue_work(s_server, poll_work, NULL) != ESP_OK) {
+        s_poll_queued = false;
+    }
+}
+
+static void poll_timer_cb(void *arg) {
+    (void)arg;
+    queue_poll();
+}
+
+/**
+ * @brief 以当前状态为比对基准，之后只推送新的变化
+ */
+static void reset_baseline(void) {
+    s_config_changed = false;
+    diff_vars();
+    diff_refresh();
+    cJSON *config = webserver_config_to_json();
+    if (config != NULL) {
+        diff_config(config);
+        cJSON_Delete(config);
+    }
+}
+
+static client_t *find_client(int fd) {
+    for (int i = 0; i < s_client_count; i++) {
+        if (s_clients[i].fd == fd) {
+            return &s_clients[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 回复配置补丁的处理结果
+ */
+static esp_err_t send_ack(httpd_req_t *req, bool ok, const char *error) {
+    char text[96];
+    int len = ok ? snprintf(text, sizeof(text), "{\"type\":\"ack\",\"ok\":true}")
+                 : snprintf(text, sizeof(text), "{\"type\":\"ack\",\"ok\":false,\"error\":\"%s\"}",
+                            error);
+    httpd_ws_frame_t pkt = {
+        .final = true,
+        .type = HTTPD_WS_TYPE_TEXT,
+        .payload = (uint8_t *)text,
+        .len = len,
+    };
+    return httpd_ws_send_frame(req, &pkt);
+}
+
+/**
+ * @brief 处理客户端发来的配置补丁
+ */
+static esp_err_t handle_patch(httpd_req_t *req, const char *text) {
+    cJSON *root = cJSON_Parse(text);
+    const cJSON *config = cJSON_GetObjectItemCaseSensitive(root, "config");
+    if (!cJSON_IsObject(config)) {
+        cJSON_Delete(root);
+        s_stats.bad_patches++;
+        return send_ack(req, false, "Invalid patch");
+    }
+
+    esp_err_t err = webserver_config_apply(config);
+    cJSON_Delete(root);
+    if (err != ESP_OK) {
+        s_stats.bad_patches++;
+        return send_ack(req, false, "Save failed");
+    }
+
+    s_stats.patches++;
+    ESP_LOGI(TAG, "Config patch applied from fd=%d", httpd_req_to_sockfd(req));
+    return send_ack(req, true, NULL);
+}
+
+/**
+ * @brief /api/live - 实时同步连接
+ *
+ * 握手完成时登记连接，完整快照由随后排队的比对工作函数发送。
+ */
+static esp_err_t live_ws_handler(httpd_req_t *req) {
+    int fd = httpd_req_to_sockfd(req);
+
+    if (req->method == HTTP_GET) {
+        prune_clients(fd);
+        if (s_client_count >= LIVE_SYNC_MAX_CLIENTS) {
+            ESP_LOGW(TAG, "Too many live clients, rejecting fd=%d", fd);
+            s_stats.rejected++;
+            return ESP_FAIL;
+        }
+
+        if (s_client_count == 0) {
+            reset_baseline();
+        }
+        s_clients[s_client_count++] = (client_t){
+            .fd = fd,
+            .full = true,
+            .connected_us = esp_timer_get_time(),
+        };
+        s_stats.clients = s_client_count;
+        ESP_LOGI(TAG, "Live client fd=%d connected", fd);
+
+        if (!s_timer_running &&
+            esp_timer_start_periodic(s_timer, LIVE_SYNC_POLL_MS * 1000ULL) == ESP_OK) {
+            s_timer_running = true;
+        }
+        queue_poll();
+        return ESP_OK;
+    }
+
+    httpd_ws_frame_t pkt = {0};
+    esp_err_t ret = httpd_ws_recv_frame(req, &pkt, 0);
+    if (ret != ESP_OK || pkt.len == 0) {
+        return ret;
+    }
+    if (pkt.len > LIVE_SYNC_RX_MAX) {
+        s_stats.bad_patches++;
+        return ESP_FAIL;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    char *text = heap_caps_malloc(pkt.len + 1, MALLOC_CAP_SPIRAM);
+    if (text == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    pkt.payload = (uint8_t *)text;
+    ret = httpd_ws_recv_frame(req, &pkt, pkt.len);
+    if (ret == ESP_OK && pkt.type == HTTPD_WS_TYPE_TEXT) {
+        text[pkt.len] = '\0';
+        ret = handle_patch(req, text);
+    }
+    heap_caps_free(text);
+
+    client_t *client = find_client(fd);
+    if (client != NULL) {
+        client->cpu_us += (uint32_t)(esp_timer_get_time() - start_us);
+    }
+    return ret;
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t live_sync_register(httpd_handle_t server) {
+    if (s_timer == NULL) {
+        const esp_timer_create_args_t args = {.callback = poll_timer_cb, .name = "live_sync"};
+        esp_err_t ret = esp_timer_create(&args, &s_timer);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to create poll timer: %s", esp_err_to_name(ret));
+            return ret;
+        }
+    }
+    if (s_snapshot == NULL) {
+        s_snapshot = heap_caps_calloc(1, sizeof(vars_snapshot_t), MALLOC_CAP_SPIRAM);
+        if (s_snapshot == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate variable snapshot");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    s_server = server;
+    s_client_count = 0;
+    s_stats.clients = 0;
+    s_stats.heap_per_client = -1;
+    s_poll_queued = false;
+    s_heap_idle = internal_free();
+
+    httpd_uri_t live_ws = {.uri = "/api/live",
+                           .method = HTTP_GET,
+                           .handler = live_ws_handler,
+                           .user_ctx = NULL,
+                           .is_websocket = true};
+    return httpd_register_uri_handler(server, &live_ws);
+}
+
+void live_sync_unregister(void) {
+    if (s_timer_running) {
+        esp_timer_stop(s_timer);
+        s_timer_running = false;
+    }
+    s_server = NULL;
+    s_client_count = 0;
+    s_stats.clients = 0;
+    s_stats.heap_per_client = -1;
+    s_poll_queued = false;
+}
+
+void live_sync_notify_config(void) {
+    s_config_changed = true;
+    queue_poll();
+}
+
+void live_sync_get_stats(live_sync_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    *stats = s_stats;
+
+    int64_t now_us = esp_timer_get_time();
+    for (int i = 0; i < s_client_count; i++) {
+        const client_t *client = &s_clients[i];
+        stats->peers[i] = (live_sync_client_stats_t){
+            .fd = client->fd,
+            .messages = client->messages,
+            .bytes = client->bytes,
+            .deferred = client->deferred,
+            .cpu_us = client->cpu_us,
+            .connected_s = (uint32_t)((now_us - client->connected_us) / 1000000),
+        };
+    }
+}
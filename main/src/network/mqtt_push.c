@@ -0,0 +1,684 @@
+/**
+ * @file mqtt_push.c
+ * @brief MQTT 推送接入与 EEZ Flow MQTT 钩子实现
+ *
+ * 推送客户端：收到的变量直接写入界面变量（与网络任务中的写法相同），命令转交网络调度器。
+ *
+ * EEZ Flow 钩子：esp-mqtt 的事件在 MQTT 任务中产生，而流程状态只能在持有 LVGL 互斥锁时访问。
+ * 事件连同复制的主题与负载放入队列，由 LVGL 定时器取出后调用 eez_mqtt_on_event_callback()。
+ * 不在 MQTT 任务中等待 LVGL 互斥锁：流程中调用订阅 / 发布时持有该锁并等待 esp-mqtt 的内部锁，
+ * 反过来等待会造成死锁。
+ *
+ * @author
+ * @date YYYY-MM-DD
+ */
+
+#include "esp_crt_bundle.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_mac.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "lvgl.h"
+#include "mqtt_client.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config_manager.h"
+#include "mqtt_push.h"
+#include "net_sched.h"
+#include "radio.h"
+#include "vars.h"
+
+/** @brief 日志标签 */
+#define TAG "mqtt_push"
+
+/** @brief 主题最大长度（含结束符） */
+#define MQTT_TOPIC_MAX 128
+/** @brief 连接断开后的重连间隔 */
+#define MQTT_RECONNECT_MS (10 * 1000)
+/** @brief EEZ Flow 事件队列长度 */
+#define EEZ_MQTT_QUEUE_LEN 16
+/** @brief EEZ Flow 事件队列在 LVGL 中的处理间隔 */
+#define EEZ_MQTT_POLL_MS 50
+/** @brief 同时存在的 EEZ Flow 连接数上限（每个连接占用一个客户端 ID 序号） */
+#define EEZ_MQTT_MAX_CONNS 8
+
+/*
+ * eez-flow.h 中 mqtt.h 部分的声明只对 C++ 可见，这里按相同的签名与取值声明。
+ */
+#define MQTT_ERROR_OK 0
+#define MQTT_ERROR_OTHER 1
+
+typedef enum {
+    EEZ_MQTT_EVENT_CONNECT = 0,
+    EEZ_MQTT_EVENT_RECONNECT = 1,
+    EEZ_MQTT_EVENT_CLOSE = 2,
+    EEZ_MQTT_EVENT_DISCONNECT = 3,
+    EEZ_MQTT_EVENT_OFFLINE = 4,
+    EEZ_MQTT_EVENT_END = 5,
+    EEZ_MQTT_EVENT_ERROR = 6,
+    EEZ_MQTT_EVENT_MESSAGE = 7
+} EEZ_MQTT_Event;
+
+typedef struct {
+    const char *topic;
+    const char *payload;
+} EEZ_MQTT_MessageEvent;
+
+void eez_mqtt_on_event_callback(void *handle, EEZ_MQTT_Event event, void *eventData);
+
+/**
+ * @brief 分片消息的接收缓冲
+ */
+typedef struct {
+    char topic[MQTT_TOPIC_MAX]; ///< 消息主题
+    char *buf;                  ///< MQTT_PUSH_PAYLOAD_MAX + 1 字节
+    size_t len;                 ///< 已接收长度
+    bool overflow;              ///< 主题或负载超出缓冲区
+} mqtt_rx_t;
+
+/**
+ * @brief 可由推送设置的界面变量
+ */
+typedef struct {
+    const char *name;                   ///< 主题中的变量名
+    void (*set_str)(const char *value); ///< 字符串变量
+    void (*set_int)(int32_t value);     ///< 整数变量
+} mqtt_var_binding_t;
+
+/**
+ * @brief EEZ Flow 连接
+ */
+typedef struct {
+    esp_mqtt_client_handle_t client; ///< esp-mqtt 客户端
+    bool started;                    ///< 是否已调用 esp_mqtt_client_start
+    bool connected_once;             ///< 是否连接成功过（之后的连接报告为 RECONNECT）
+    uint8_t id;                      ///< 客户端 ID 序号（s_eez_ids 中的位）
+    mqtt_rx_t rx;                    ///< 接收缓冲
+} eez_mqtt_conn_t;
+
+/**
+ * @brief 待交给 EEZ Flow 的事件
+ */
+typedef struct {
+    void *handle;         ///< eez_mqtt_conn_t
+    EEZ_MQTT_Event event; ///< 事件类型
+    char *topic;          ///< MESSAGE 的主题，或 ERROR 的描述（PSRAM，处理后释放）
+    char *payload;        ///< MESSAGE 的负载（PSRAM，处理后释放）
+} eez_mqtt_pending_t;
+
+static const mqtt_var_binding_t s_var_bindings[] = {
+    {"yiyan", set_var_yiyan, NULL},
+    {"solar_term", set_var_solar_term, NULL},
+    {"weather_text", set_var_weather_text, NULL},
+    {"weather_icon", set_var_weather_icon, NULL},
+    {"weather_temp", set_var_weather_temp, NULL},
+    {"weather_uptime", set_var_weather_uptime, NULL},
+    {"weather_location", set_var_weather_location, NULL},
+    {"weather_feelslike", set_var_weather_feelslike, NULL},
+    {"weather_wind_dir", set_var_weather_wind_dir, NULL},
+    {"weather_wind_scale", NULL, set_var_weather_wind_scale},
+    {"weather_humidity", NULL, set_var_weather_humidity},
+    {"weather_precip", NULL, set_var_weather_precip},
+    {"weather_pressure", NULL, set_var_weather_pressure},
+    {"weather_visibility", NULL, set_var_weather_visibility},
+    {"weather_cloud", NULL, set_var_weather_cloud},
+    {"weather_dew", NULL, set_var_weather_dew},
+};
+
+static esp_mqtt_client_handle_t s_client = NULL;
+static char s_prefix[64] = {0};
+static mqtt_rx_t s_rx = {0};
+static mqtt_push_stats_t s_stats = {.last_msg_ms = -1};
+static int64_t s_last_msg_us = 0;
+
+static QueueHandle_t s_eez_queue = NULL;
+static lv_timer_t *s_eez_timer = NULL;
+// 已占用的流程连接客户端 ID 序号（只在 LVGL 任务中访问）
+static uint8_t s_eez_ids = 0;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+/**
+ * @brief 接收一个数据事件，消息完整时返回 true
+ *
+ * 长消息被 esp-mqtt 拆成多个事件，只有第一个事件带主题。
+ */
+static bool rx_append(mqtt_rx_t *rx, const esp_mqtt_event_t *event) {
+    if (event->current_data_offset == 0) {
+        rx->len = 0;
+        rx->overflow = (event->topic_len >= MQTT_TOPIC_MAX ||
+                        event->total_data_len > MQTT_PUSH_PAYLOAD_MAX);
+        if (!rx->overflow) {
+            memcpy(rx->topic, event->topic, event->topic_len);
+            rx->topic[event->topic_len] = '\0';
+        }
+    }
+
+    if (!rx->overflow && rx->buf != NULL) {
+        memcpy(rx->buf + rx->len, event->data, event->data_len);
+        rx->len += event->data_len;
+    }
+
+    if (event->current_data_offset + event->data_len < event->total_data_len) {
+        return false;
+    }
+    if (rx->overflow || rx->buf == NULL) {
+        ESP_LOGW(TAG, "Dropping oversized message (%d bytes)", event->total_data_len);
+        return false;
+    }
+    rx->buf[rx->len] = '\0';
+    return true;
+}
+
+/**
+ * @brief 应用变量消息
+ *
+ * @return true 变量名有效
+ */
+static bool apply_var(const char *name, const char *payload) {
+    for (size_t i = 0; i < sizeof(s_var_bindings) / sizeof(s_var_bindings[0]); i++) {
+        const mqtt_var_binding_t *binding = &s_var_bindings[i];
+        if (strcmp(binding->name, name) != 0) {
+            continue;
+        }
+        if (binding->set_str != NULL) {
+            binding->set_str(payload);
+        } else {
+            binding->set_int((int32_t)strtol(payload, NULL, 10));
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 执行命令消息
+ *
+ * @return true 命令有效
+ */
+static bool run_command(const char *name, const char *payload) {
+    if (strcmp(name, "refresh") == 0) {
+        return net_sched_trigger_by_name(payload) == ESP_OK;
+    }
+    return false;
+}
+
+/**
+ * @brief 处理推送客户端收到的完整消息
+ */
+static void handle_push_message(const char *topic, const char *payload) {
+    s_stats.messages++;
+    s_last_msg_us = esp_timer_get_time();
+
+    size_t prefix_len = strlen(s_prefix);
+    if (strncmp(topic, s_prefix, prefix_len) != 0 || topic[prefix_len] != '/') {
+        s_stats.dropped++;
+        return;
+    }
+    const char *rest = topic + prefix_len + 1;
+
+    if (strncmp(rest, "var/", 4) == 0) {
+        const char *name = rest + 4;
+        if (!apply_var(name, payload)) {
+            ESP_LOGW(TAG, "Unknown variable: %s", name);
+            s_stats.dropped++;
+            return;
+        }
+        s_stats.vars++;
+        ESP_LOGI(TAG, "Variable %s updated", name);
+
+        // 回显负载，供测试工具计算推送延迟
+        char ack_topic[MQTT_TOPIC_MAX];
+        snprintf(ack_topic, sizeof(ack_topic), "%s/ack/%s", s_prefix, name);
+        esp_mqtt_client_publish(s_client, ack_topic, payload, 0, 0, 0);
+    } else if (strncmp(rest, "cmd/", 4) == 0) {
+        const char *name = rest + 4;
+        if (!run_command(name, payload)) {
+            ESP_LOGW(TAG, "Invalid command: %s %s", name, payload);
+            s_stats.dropped++;
+            return;
+        }
+        s_stats.commands++;
+        ESP_LOGI(TAG, "Command %s %s executed", name, payload);
+    } else {
+        s_stats.dropped++;
+    }
+}
+
+/**
+ * @brief 推送客户端事件处理（MQTT 任务中执行）
+ */
+static void push_event_handler(void *arg, esp_event_base_t base, int32_t event_id,
+                               void *event_data) {
+    (void)arg;
+    (void)base;
+    esp_mqtt_event_handle_t event = event_data;
+    char topic[MQTT_TOPIC_MAX];
+
+    switch ((esp_mqtt_event_id_t)event_id) {
+    case MQTT_EVENT_CONNECTED:
+        s_stats.connected = true;
+        s_stats.session_present = event->session_present;
+        s_stats.connects++;
+        ESP_LOGI(TAG, "Connected (session present: %d)", event->session_present);
+
+        snprintf(topic, sizeof(topic), "%s/status", s_prefix);
+        esp_mqtt_client_publish(s_client, topic, "online", 0, 1, 1);
+
+        // broker 保留了会话时订阅仍然有效，重复订阅也无副作用（同时取回 retain 消息）
+        snprintf(topic, sizeof(topic), "%s/var/+", s_prefix);
+        esp_mqtt_client_subscribe(s_client, topic, 1);
+        snprintf(topic, sizeof(topic), "%s/cmd/+", s_prefix);
+        esp_mqtt_client_subscribe(s_client, topic, 1);
+        break;
+
+    case MQTT_EVENT_DISCONNECTED:
+        if (s_stats.connected) {
+            s_stats.disconnects++;
+        }
+        s_stats.connected = false;
+        ESP_LOGI(TAG, "Disconnected");
+        break;
+
+    case MQTT_EVENT_DATA:
+        if (rx_append(&s_rx, event)) {
+            handle_push_message(s_rx.topic, s_rx.buf);
+        } else if (s_rx.overflow &&
+                   event->current_data_offset + event->data_len >= event->total_data_len) {
+            s_stats.messages++;
+            s_stats.dropped++;
+        }
+        break;
+
+    case MQTT_EVENT_ERROR:
+        ESP_LOGW(TAG, "MQTT error (type %d)", event->error_handle->error_type);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 将事件交给 LVGL 定时器处理
+ *
+ * 队列满时丢弃（流程处理不及时的旧连接状态没有意义，消息由持久会话保证不丢失于 broker 侧）。
+ */
+static void eez_post(eez_mqtt_conn_t *conn, EEZ_MQTT_Event event, const char *topic,
+                     const char *payload) {
+    eez_mqtt_pending_t pending = {.handle = conn, .event = event};
+    if (topic != NULL) {
+        pending.topic = heap_caps_malloc(strlen(topic) + 1, MALLOC_CAP_SPIRAM);
+        if (pending.topic != NULL) {
+            strcpy(pending.topic, topic);
+        }
+    }
+    if (payload != NULL) {
+        pending.payload = heap_caps_malloc(strlen(payload) + 1, MALLOC_CAP_SPIRAM);
+        if (pending.payload != NULL) {
+            strcpy(pending.payload, payload);
+        }
+    }
+
+    if ((topic != NULL && pending.topic == NULL) || (payload != NULL && pending.payload == NULL) ||
+        xQueueSend(s_eez_queue, &pending, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "Dropping flow event %d", event);
+        heap_caps_free(pending.topic);
+        heap_caps_free(pending.payload);
+    }
+}
+
+/**
+ * @brief EEZ Flow 连接事件处理（MQTT 任务中执行）
+ */
+static void eez_event_handler(void *arg, esp_event_base_t base, int32_t event_id,
+                              void *event_data) {
+    (void)base;
+    eez_mqtt_conn_t *conn = arg;
+    esp_mqtt_event_handle_t event = event_data;
+
+    switch ((esp_mqtt_event_id_t)event_id) {
+    case MQTT_EVENT_BEFORE_CONNECT:
+        if (conn->connected_once) {
+            eez_post(conn, EEZ_MQTT_EVENT_RECONNECT, NULL, NULL);
+        }
+        break;
+
+    case MQTT_EVENT_CONNECTED:
+        conn->connected_once = true;
+        eez_post(conn, EEZ_MQTT_EVENT_CONNECT, NULL, NULL);
+        break;
+
+    case MQTT_EVENT_DISCONNECTED:
+        eez_post(conn, EEZ_MQTT_EVENT_CLOSE, NULL, NULL);
+        eez_post(conn, EEZ_MQTT_EVENT_OFFLINE, NULL, NULL);
+        break;
+
+    case MQTT_EVENT_DATA:
+        if (rx_append(&conn->rx, event)) {
+            eez_post(conn, EEZ_MQTT_EVENT_MESSAGE, conn->rx.topic, conn->rx.buf);
+        }
+        break;
+
+    case MQTT_EVENT_ERROR:
+        eez_post(conn, EEZ_MQTT_EVENT_ERROR, "MQTT error", NULL);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 丢弃队列中属于某个连接的事件（在 LVGL 任务中调用）
+ *
+ * 连接释放前调用，避免 eez_timer_cb 把已释放的句柄交给流程。其他连接的事件按原顺序放回
+ * 队首，排在丢弃期间新到达的事件之前；放回时队列已满的事件被丢弃。
+ */
+static void eez_drain(eez_mqtt_conn_t *conn) {
+    eez_mqtt_pending_t kept[EEZ_MQTT_QUEUE_LEN];
+    int num_kept = 0;
+    int dropped = 0;
+
+    eez_mqtt_pending_t pending;
+    UBaseType_t waiting = uxQueueMessagesWaiting(s_eez_queue);
+    while (waiting-- > 0 && xQueueReceive(s_eez_queue, &pending, 0) == pdTRUE) {
+        if (pending.handle == conn) {
+            heap_caps_free(pending.topic);
+            heap_caps_free(pending.payload);
+            dropped++;
+        } else {
+            kept[num_kept++] = pending;
+        }
+    }
+
+    for (int i = num_kept - 1; i >= 0; i--) {
+        if (xQueueSendToFront(s_eez_queue, &kept[i], 0) != pdTRUE) {
+            ESP_LOGW(TAG, "Dropping flow event %d", kept[i].event);
+            heap_caps_free(kept[i].topic);
+            heap_caps_free(kept[i].payload);
+        }
+    }
+    if (dropped > 0) {
+        ESP_LOGD(TAG, "Dropped %d queued event(s) of a closed flow connection", dropped);
+    }
+}
+
+/**
+ * @brief 在 LVGL 任务中把排队的事件交给流程
+ */
+static void eez_timer_cb(lv_timer_t *timer) {
+    (void)timer;
+    eez_mqtt_pending_t pending;
+    while (xQueueReceive(s_eez_queue, &pending, 0) == pdTRUE) {
+        if (pending.event == EEZ_MQTT_EVENT_MESSAGE) {
+            EEZ_MQTT_MessageEvent message = {.topic = pending.topic, .payload = pending.payload};
+            eez_mqtt_on_event_callback(pending.handle, pending.event, &message);
+        } else {
+            eez_mqtt_on_event_callback(pending.handle, pending.event, pending.topic);
+        }
+        heap_caps_free(pending.topic);
+        heap_caps_free(pending.payload);
+    }
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t mqtt_push_start(void) {
+    if (s_client != NULL) {
+        return ESP_OK;
+    }
+
+    sys_config_t sys_config;
+    config_manager_get_config(&sys_config);
+    if (sys_config.mqtt.uri[0] == '\0') {
+        ESP_LOGI(TAG, "No broker configured, MQTT push disabled");
+        return ESP_OK;
+    }
+
+    // 常驻连接不持有射频引用，WINDOWED 模式下射频在窗口之间关闭，不启动
+    if (radio_get_mode() == RADIO_MODE_WINDOWED) {
+        ESP_LOGW(TAG, "MQTT push needs the radio associated, not started in %s mode",
+                 radio_mode_name(RADIO_MODE_WINDOWED));
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    snprintf(s_prefix, sizeof(s_prefix), "%s",
+             (sys_config.mqtt.topic_prefix[0] != '\0') ? sys_config.mqtt.topic_prefix
+                                                       : MQTT_PUSH_DEFAULT_PREFIX);
+
+    s_rx.buf = heap_caps_malloc(MQTT_PUSH_PAYLOAD_MAX + 1, MALLOC_CAP_SPIRAM);
+    if (s_rx.buf == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate receive buffer");
+        return ESP_ERR_NO_MEM;
+    }
+
+    // 持久会话需要固定的客户端 ID
+    uint8_t mac[6] = {0};
+    esp_read_mac(mac, ESP_MAC_WIFI_STA);
+    static char client_id[32];
+    snprintf(client_id, sizeof(client_id), "espaperplay-%02x%02x%02x", mac[3], mac[4], mac[5]);
+
+    static char will_topic[MQTT_TOPIC_MAX];
+    snprintf(will_topic, sizeof(will_topic), "%s/status", s_prefix);
+
+    esp_mqtt_client_config_t mqtt_cfg = {
+        .broker.address.uri = sys_config.mqtt.uri,
+        .broker.verification.crt_bundle_attach = esp_crt_bundle_attach,
+        .credentials.client_id = client_id,
+        .credentials.username =
+            (sys_config.mqtt.username[0] != '\0') ? sys_config.mqtt.username : NULL,
+        .credentials.authentication.password =
+            (sys_config.mqtt.password[0] != '\0') ? sys_config.mqtt.password : NULL,
+        .session.disable_clean_session = true,
+        .session.keepalive = MQTT_PUSH_KEEPALIVE_S,
+        .session.last_will.topic = will_topic,
+        .session.last_will.msg = "offline",
+        .session.last_will.qos = 1,
+        .session.last_will.retain = 1,
+        .network.reconnect_timeout_ms = MQTT_RECONNECT_MS,
+        .outbox.limit = MQTT_PUSH_OUTBOX_LIMIT,
+    };
+
+    s_client = esp_mqtt_client_init(&mqtt_cfg);
+    if (s_client == NULL) {
+        ESP_LOGE(TAG, "esp_mqtt_client_init failed");
+        heap_caps_free(s_rx.buf);
+        s_rx.buf = NULL;
+        return ESP_FAIL;
+    }
+
+    esp_mqtt_client_register_event(s_client, ESP_EVENT_ANY_ID, push_event_handler, NULL);
+    esp_err_t err = esp_mqtt_client_start(s_client);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "esp_mqtt_client_start failed: %s", esp_err_to_name(err));
+        esp_mqtt_client_destroy(s_client);
+        s_client = NULL;
+        heap_caps_free(s_rx.buf);
+        s_rx.buf = NULL;
+        return err;
+    }
+
+    s_stats.enabled = true;
+    ESP_LOGI(TAG, "MQTT push started: %s, prefix %s", sys_config.mqtt.uri, s_prefix);
+    return ESP_OK;
+}
+
+void mqtt_push_get_stats(mqtt_push_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    *stats = s_stats;
+    if (s_last_msg_us > 0) {
+        stats->last_msg_ms = (esp_timer_get_time() - s_last_msg_us) / 1000;
+    }
+}
+
+// ============================================================================
+// EEZ Flow MQTT 钩子（在 LVGL 任务中由流程调用）
+// ============================================================================
+
+int eez_mqtt_init(const char *protocol, const char *host, int port, const char *username,
+                  const char *password, void **handle) {
+    if (s_eez_queue == NULL) {
+        s_eez_queue = xQueueCreate(EEZ_MQTT_QUEUE_LEN, sizeof(eez_mqtt_pending_t));
+        if (s_eez_queue == NULL) {
+            return MQTT_ERROR_OTHER;
+        }
+    }
+    if (s_eez_timer == NULL) {
+        s_eez_timer = lv_timer_create(eez_timer_cb, EEZ_MQTT_POLL_MS, NULL);
+    }
+
+    // 持久会话按客户端 ID 区分：每个连接取最小的空闲序号，流程按相同顺序创建连接时重启后不变
+    uint8_t id = 0;
+    while (id < EEZ_MQTT_MAX_CONNS && (s_eez_ids & (1u << id)) != 0) {
+        id++;
+    }
+    if (id == EEZ_MQTT_MAX_CONNS) {
+        ESP_LOGE(TAG, "Too many flow connections (max %d)", EEZ_MQTT_MAX_CONNS);
+        return MQTT_ERROR_OTHER;
+    }
+
+    eez_mqtt_conn_t *conn = heap_caps_calloc(1, sizeof(eez_mqtt_conn_t), MALLOC_CAP_SPIRAM);
+    if (conn == NULL) {
+        return MQTT_ERROR_OTHER;
+    }
+    conn->rx.buf = heap_caps_malloc(MQTT_PUSH_PAYLOAD_MAX + 1, MALLOC_CAP_SPIRAM);
+    if (conn->rx.buf == NULL) {
+        heap_caps_free(conn);
+        return MQTT_ERROR_OTHER;
+    }
+    conn->id = id;
+
+    uint8_t mac[6] = {0};
+    esp_read_mac(mac, ESP_MAC_WIFI_STA);
+    char client_id[40];
+    snprintf(client_id, sizeof(client_id), "espaperplay-%02x%02x%02x-flow%u", mac[3], mac[4],
+             mac[5], id);
+
+    // mqtt.js 风格的协议名映射到 esp-mqtt 的 URI 协议
+    const char *scheme = protocol;
+    if (strcmp(protocol, "tcp") == 0) {
+        scheme = "mqtt";
+    } else if (strcmp(protocol, "tls") == 0 || strcmp(protocol, "ssl") == 0) {
+        scheme = "mqtts";
+    }
+    char uri[192];
+    snprintf(uri, sizeof(uri), "%s://%s:%d", scheme, host, port);
+
+    esp_mqtt_client_config_t mqtt_cfg = {
+        .broker.address.uri = uri,
+        .broker.verification.crt_bundle_attach = esp_crt_bundle_attach,
+        .credentials.client_id = client_id,
+        .credentials.username = (username != NULL && username[0] != '\0') ? username : NULL,
+        .credentials.authentication.password =
+            (password != NULL && password[0] != '\0') ? password : NULL,
+        .session.disable_clean_session = true,
+        .session.keepalive = MQTT_PUSH_KEEPALIVE_S,
+        .network.reconnect_timeout_ms = MQTT_RECONNECT_MS,
+        .outbox.limit = MQTT_PUSH_OUTBOX_LIMIT,
+    };
+
+    conn->client = esp_mqtt_client_init(&mqtt_cfg);
+    if (conn->client == NULL) {
+        heap_caps_free(conn->rx.buf);
+        heap_caps_free(conn);
+        return MQTT_ERROR_OTHER;
+    }
+    esp_mqtt_client_register_event(conn->client, ESP_EVENT_ANY_ID, eez_event_handler, conn);
+    s_eez_ids |= 1u << id;
+
+    ESP_LOGI(TAG, "Flow connection created: %s (%s)", uri, client_id);
+    *handle = conn;
+    return MQTT_ERROR_OK;
+}
+
+int eez_mqtt_deinit(void *handle) {
+    eez_mqtt_conn_t *conn = handle;
+    if (conn == NULL) {
+        return MQTT_ERROR_OTHER;
+    }
+    // 先停止 MQTT 任务，之后不会再有该连接的事件入队，再丢弃已排队的事件
+    if (conn->started) {
+        esp_mqtt_client_stop(conn->client);
+    }
+    esp_mqtt_client_destroy(conn->client);
+    eez_drain(conn);
+
+    s_eez_ids &= ~(1u << conn->id);
+    heap_caps_free(conn->rx.buf);
+    heap_caps_free(conn);
+    return MQTT_ERROR_OK;
+}
+
+int eez_mqtt_connect(void *handle) {
+    eez_mqtt_conn_t *conn = handle;
+    if (conn == NULL) {
+        return MQTT_ERROR_OTHER;
+    }
+    if (radio_get_mode() == RADIO_MODE_WINDOWED) {
+        // 与推送客户端相同：常驻连接只在射频保持关联的模式下运行
+        ESP_LOGW(TAG, "Flow connect refused in %s mode", radio_mode_name(RADIO_MODE_WINDOWED));
+        return MQTT_ERROR_OTHER;
+    }
+    esp_err_t err = conn->started ? esp_mqtt_client_reconnect(conn->client)
+                                  : esp_mqtt_client_start(conn->client);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Flow connect failed: %s", esp_err_to_name(err));
+        return MQTT_ERROR_OTHER;
+    }
+    conn->started = true;
+    return MQTT_ERROR_OK;
+}
+
+int eez_mqtt_disconnect(void *handle) {
+    eez_mqtt_conn_t *conn = handle;
+    if (conn == NULL || !conn->started) {
+        return MQTT_ERROR_OTHER;
+    }
+    if (esp_mqtt_client_stop(conn->client) != ESP_OK) {
+        return MQTT_ERROR_OTHER;
+    }
+    conn->started = false;
+    conn->connected_once = false;
+    // 主动断开：已在 LVGL 任务中，直接通知流程
+    eez_mqtt_on_event_callback(conn, EEZ_MQTT_EVENT_END, NULL);
+    return MQTT_ERROR_OK;
+}
+
+int eez_mqtt_subscribe(void *handle, const char *topic) {
+    eez_mqtt_conn_t *conn = handle;
+    if (conn == NULL || esp_mqtt_client_subscribe(conn->client, topic, 1) < 0) {
+        return MQTT_ERROR_OTHER;
+    }
+    return MQTT_ERROR_OK;
+}
+
+int eez_mqtt_unsubscribe(void *handle, const char *topic) {
+    eez_mqtt_conn_t *conn = handle;
+    if (conn == NULL || esp_mqtt_client_unsubscribe(conn->client, topic) < 0) {
+        return MQTT_ERROR_OTHER;
+    }
+    return MQTT_ERROR_OK;
+}
+
+int eez_mqtt_publish(void *handle, const char *topic, const char *payload) {
+    eez_mqtt_conn_t *conn = handle;
+    if (conn == NULL) {
+        return MQTT_ERROR_OTHER;
+    }
+    // 放入 outbox（离线时缓存，连接恢复后发送），不阻塞 LVGL 任务等待网络
+    if (esp_mqtt_client_enqueue(conn->client, topic, payload, 0, 1, 0, true) < 0) {
+        return MQTT_ERROR_OTHER;
+    }
+    return MQTT_ERROR_OK;
+}
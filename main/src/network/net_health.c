@@ -0,0 +1,301 @@
+/**
+ * @file net_health.c
+ * @brief 上游接口熔断与退避实现
+ */
+
+#include "esp_log.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "esp_tls.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <string.h>
+
+#include "net_health.h"
+
+#define TAG "net_health"
+
+/** @brief 探测请求超过该时间仍未报告结果时，允许发起新的探测 */
+#define NET_HEALTH_PROBE_TIMEOUT_US (120LL * 1000 * 1000)
+
+/**
+ * @brief 单个接口的熔断器
+ */
+typedef struct {
+    net_health_info_t info;   ///< 对外可见的状态与统计
+    int64_t open_until_us;    ///< OPEN 状态的截止时间（esp_timer 时间）
+    int64_t probe_started_us; ///< HALF_OPEN 探测请求的开始时间，0 表示未在探测
+} net_breaker_t;
+
+static const char *const s_endpoint_names[NET_EP_COUNT] = {
+    [NET_EP_WEATHER] = "weather",
+    [NET_EP_LOCATION] = "location",
+    [NET_EP_YIYAN] = "yiyan",
+};
+
+static const char *const s_fail_names[NET_FAIL_COUNT] = {
+    [NET_FAIL_NONE] = "none",         [NET_FAIL_CONNECT] = "connect",
+    [NET_FAIL_TLS] = "tls",           [NET_FAIL_TIMEOUT] = "timeout",
+    [NET_FAIL_HTTP_5XX] = "http_5xx", [NET_FAIL_HTTP_4XX] = "http_4xx",
+    [NET_FAIL_AUTH] = "auth",         [NET_FAIL_RATE] = "rate_limit",
+    [NET_FAIL_PARSE] = "parse",       [NET_FAIL_OTHER] = "other",
+};
+
+static net_breaker_t s_breakers[NET_EP_COUNT];
+static SemaphoreHandle_t s_mutex = NULL;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+/**
+ * @brief 退避时间加上 ±NET_HEALTH_JITTER_PCT% 的随机抖动
+ */
+static uint32_t jittered_ms(uint32_t backoff_ms) {
+    uint32_t span = backoff_ms / 100 * NET_HEALTH_JITTER_PCT;
+    if (span == 0) {
+        return backoff_ms;
+    }
+    return backoff_ms - span + esp_random() % (2 * span + 1);
+}
+
+/**
+ * @brief 进入 OPEN 状态（需持有互斥锁）
+ */
+static void trip_locked(net_breaker_t *b, int64_t now) {
+    uint32_t delay_ms = jittered_ms(b->info.backoff_ms);
+    b->info.state = NET_HEALTH_OPEN;
+    b->info.trips++;
+    b->open_until_us = now + (int64_t)delay_ms * 1000;
+    b->probe_started_us = 0;
+
+    ESP_LOGW(TAG, "%s circuit open after %lu failure(s) (%s, status %d), retry in %lu s",
+             b->info.name, (unsigned long)b->info.consecutive_failures,
+             s_fail_names[b->info.last_fail], b->info.last_status,
+             (unsigned long)(delay_ms / 1000));
+}
+
+/**
+ * @brief 根据失败分类确定首次熔断的退避时间
+ */
+static uint32_t initial_backoff_ms(net_fail_t fail) {
+    switch (fail) {
+    case NET_FAIL_AUTH:
+        return NET_HEALTH_BACKOFF_AUTH_MS;
+    case NET_FAIL_RATE:
+        return NET_HEALTH_BACKOFF_RATE_MS;
+    default:
+        return NET_HEALTH_BACKOFF_BASE_MS;
+    }
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t net_health_init(void) {
+    if (s_mutex != NULL) {
+        return ESP_OK;
+    }
+
+    s_mutex = xSemaphoreCreateMutex();
+    if (s_mutex == NULL) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        return ESP_ERR_NO_MEM;
+    }
+
+    memset(s_breakers, 0, sizeof(s_breakers));
+    for (int i = 0; i < NET_EP_COUNT; i++) {
+        s_breakers[i].info.name = s_endpoint_names[i];
+    }
+    return ESP_OK;
+}
+
+bool net_health_allow(net_endpoint_t ep) {
+    if (s_mutex == NULL || ep >= NET_EP_COUNT) {
+        return true;
+    }
+
+    bool allowed = true;
+    int64_t now = esp_timer_get_time();
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    net_breaker_t *b = &s_breakers[ep];
+
+    if (b->info.state == NET_HEALTH_OPEN && now >= b->open_until_us) {
+        b->info.state = NET_HEALTH_HALF_OPEN;
+        b->probe_started_us = 0;
+        ESP_LOGI(TAG, "%s circuit half-open, probing", b->info.name);
+    }
+
+    if (b->info.state == NET_HEALTH_OPEN) {
+        allowed = false;
+    } else if (b->info.state == NET_HEALTH_HALF_OPEN) {
+        // 同一时间只放行一个探测请求
+        if (b->probe_started_us != 0 &&
+            now - b->probe_started_us < NET_HEALTH_PROBE_TIMEOUT_US) {
+            allowed = false;
+        } else {
+            b->probe_started_us = now;
+        }
+    }
+
+    if (!allowed) {
+        b->info.skipped++;
+    }
+    xSemaphoreGive(s_mutex);
+    return allowed;
+}
+
+void net_health_report(net_endpoint_t ep, net_fail_t fail, int status) {
+    if (s_mutex == NULL || ep >= NET_EP_COUNT) {
+        return;
+    }
+
+    int64_t now = esp_timer_get_time();
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    net_breaker_t *b = &s_breakers[ep];
+
+    if (fail == NET_FAIL_NONE) {
+        b->info.successes++;
+        if (b->info.state != NET_HEALTH_CLOSED) {
+            ESP_LOGI(TAG, "%s circuit closed", b->info.name);
+        }
+        b->info.state = NET_HEALTH_CLOSED;
+        b->info.consecutive_failures = 0;
+        b->info.backoff_ms = 0;
+        b->probe_started_us = 0;
+        xSemaphoreGive(s_mutex);
+        return;
+    }
+
+    b->info.failures++;
+    b->info.consecutive_failures++;
+    b->info.last_fail = fail;
+    b->info.last_status = status;
+
+    if (b->info.state == NET_HEALTH_HALF_OPEN) {
+        // 探测失败：退避时间翻倍
+        uint32_t next = b->info.backoff_ms * 2;
+        if (next < initial_backoff_ms(fail)) {
+            next = initial_backoff_ms(fail);
+        }
+        b->info.backoff_ms = (next > NET_HEALTH_BACKOFF_MAX_MS) ? NET_HEALTH_BACKOFF_MAX_MS : next;
+        trip_locked(b, now);
+    } else if (b->info.state == NET_HEALTH_CLOSED &&
+               (fail == NET_FAIL_AUTH || fail == NET_FAIL_RATE ||
+                b->info.consecutive_failures >= NET_HEALTH_FAIL_THRESHOLD)) {
+        b->info.backoff_ms = initial_backoff_ms(fail);
+        trip_locked(b, now);
+    }
+    xSemaphoreGive(s_mutex);
+}
+
+net_fail_t net_health_classify(esp_http_client_handle_t client, esp_err_t err, int status) {
+    if (err == ESP_OK) {
+        if ((status >= 200 && status < 300) || status == 304) {
+            return NET_FAIL_NONE;
+        }
+        if (status == 401 || status == 403) {
+            return NET_FAIL_AUTH;
+        }
+        if (status == 429) {
+            return NET_FAIL_RATE;
+        }
+        if (status >= 500) {
+            return NET_FAIL_HTTP_5XX;
+        }
+        if (status >= 400) {
+            return NET_FAIL_HTTP_4XX;
+        }
+        return NET_FAIL_OTHER;
+    }
+
+    // 连接阶段的错误由 esp-tls 记录更具体的原因
+    int tls_code = 0;
+    int tls_flags = 0;
+    esp_err_t tls_err = ESP_OK;
+    if (client != NULL) {
+        tls_err = esp_http_client_get_and_clear_last_tls_error(client, &tls_code, &tls_flags);
+    }
+
+    if (tls_err == ESP_ERR_ESP_TLS_CONNECTION_TIMEOUT) {
+        return NET_FAIL_TIMEOUT;
+    }
+    if (tls_err == ESP_ERR_ESP_TLS_CANNOT_RESOLVE_HOSTNAME ||
+        tls_err == ESP_ERR_ESP_TLS_CANNOT_CREATE_SOCKET ||
+        tls_err == ESP_ERR_ESP_TLS_FAILED_CONNECT_TO_HOST) {
+        return NET_FAIL_CONNECT;
+    }
+    if (tls_err != ESP_OK) {
+        return NET_FAIL_TLS;
+    }
+
+    switch (err) {
+    case ESP_ERR_HTTP_EAGAIN:
+    case ESP_ERR_TIMEOUT:
+        return NET_FAIL_TIMEOUT;
+    case ESP_ERR_HTTP_CONNECT:
+    case ESP_ERR_HTTP_CONNECTING:
+        return NET_FAIL_CONNECT;
+    default:
+        return NET_FAIL_OTHER;
+    }
+}
+
+void net_health_reset_all(void) {
+    if (s_mutex == NULL) {
+        return;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    for (int i = 0; i < NET_EP_COUNT; i++) {
+        net_breaker_t *b = &s_breakers[i];
+        b->info.state = NET_HEALTH_CLOSED;
+        b->info.consecutive_failures = 0;
+        b->info.backoff_ms = 0;
+        b->probe_started_us = 0;
+    }
+    xSemaphoreGive(s_mutex);
+}
+
+void net_health_get(net_endpoint_t ep, net_health_info_t *info) {
+    if (info == NULL || ep >= NET_EP_COUNT) {
+        return;
+    }
+    if (s_mutex == NULL) {
+        memset(info, 0, sizeof(net_health_info_t));
+        info->name = s_endpoint_names[ep];
+        return;
+    }
+
+    int64_t now = esp_timer_get_time();
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    net_breaker_t *b = &s_breakers[ep];
+    *info = b->info;
+    if (b->info.state == NET_HEALTH_OPEN && b->open_until_us > now) {
+        info->retry_in_ms = (b->open_until_us - now) / 1000;
+    } else {
+        info->retry_in_ms = 0;
+    }
+    xSemaphoreGive(s_mutex);
+}
+
+const char *net_health_state_name(net_health_state_t state) {
+    switch (state) {
+    case NET_HEALTH_CLOSED:
+        return "closed";
+    case NET_HEALTH_OPEN:
+        return "open";
+    case NET_HEALTH_HALF_OPEN:
+        return "half_open";
+    default:
+        return "unknown";
+    }
+}
+
+const char *net_health_fail_name(net_fail_t fail) {
+    return (fail < NET_FAIL_COUNT) ? s_fail_names[fail] : "unknown";
+}
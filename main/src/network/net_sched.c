@@ -0,0 +1,383 @@
+/**
+ * @file net_sched.c
+ * @brief 网络任务调度器实现
+ *
+ * 单个工作任务循环：计算最早的截止时间并休眠（可被 trigger 唤醒），到期后开始一轮执行，
+ * 每次从“已到期”或“未在重试中且将在合并窗口内到期”的任务中挑选优先级最高、截止时间最早的
+ * 一个执行，直到没有可执行的任务为止。重试中的任务严格遵守退避时间，不参与提前合并。
+ */
+
+#include "esp_log.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net_sched.h"
+#include "radio.h"
+#include "sntp.h"
+
+#define TAG "net_sched"
+
+/**
+ * @brief 任务槽
+ */
+typedef struct {
+    bool in_use;                   ///< 是否已注册
+    bool running;                  ///< 是否正在执行
+    bool triggered;                ///< 执行期间收到了立即执行请求
+    char name[NET_SCHED_NAME_MAX]; ///< 任务名
+    net_job_config_t config;       ///< 任务配置（name 指向上面的副本）
+    int64_t due_us;                ///< 下一次截止时间（esp_timer 时间）
+    uint8_t retries;               ///< 当前连续重试次数
+} net_job_t;
+
+static net_job_t s_jobs[NET_SCHED_MAX_JOBS];
+static SemaphoreHandle_t s_mutex = NULL;
+static TaskHandle_t s_worker = NULL;
+static net_sched_stats_t s_stats;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+/**
+ * @brief 周期 + 随机抖动（微秒）
+ */
+static int64_t next_period_us(const net_job_config_t *config) {
+    uint32_t jitter_ms = (config->jitter_ms > 0) ? esp_random() % (config->jitter_ms + 1) : 0;
+    return ((int64_t)config->period_ms + jitter_ms) * 1000;
+}
+
+/**
+ * @brief 挑选本轮下一个要执行的任务（需持有互斥锁）
+ *
+ * @return 任务槽，没有可执行的任务返回 NULL
+ */
+static net_job_t *pick_job_locked(int64_t now) {
+    net_job_t *best = NULL;
+    int64_t horizon = now + (int64_t)NET_SCHED_COALESCE_MS * 1000;
+
+    for (int i = 0; i < NET_SCHED_MAX_JOBS; i++) {
+        net_job_t *job = &s_jobs[i];
+        if (!job->in_use || job->running) {
+            continue;
+        }
+
+        bool eligible = job->due_us <= now || (job->retries == 0 && job->due_us <= horizon);
+        if (!eligible) {
+            continue;
+        }
+
+        if (best == NULL || job->config.priority > best->config.priority ||
+            (job->config.priority == best->config.priority && job->due_us < best->due_us)) {
+            best = job;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief 最早的截止时间（需持有互斥锁）
+ *
+ * @return 截止时间，没有任务时返回 INT64_MAX
+ */
+static int64_t earliest_due_locked(void) {
+    int64_t earliest = INT64_MAX;
+    for (int i = 0; i < NET_SCHED_MAX_JOBS; i++) {
+        if (s_jobs[i].in_use && !s_jobs[i].running && s_jobs[i].due_us < earliest) {
+            earliest = s_jobs[i].due_us;
+        }
+    }
+    return earliest;
+}
+
+/**
+ * @brief 根据执行结果安排任务的下一次执行（需持有互斥锁）
+ */
+static void reschedule_locked(net_job_t *job, esp_err_t err, int64_t now) {
+    job->running = false;
+
+    if (err != ESP_OK && job->retries < job->config.max_retries) {
+        uint32_t delay_ms = job->config.retry_delay_ms << job->retries;
+        job->retries++;
+        job->due_us = now + (int64_t)delay_ms * 1000;
+        s_stats.retries++;
+        ESP_LOGW(TAG, "%s failed (%s), retry %u/%u in %lu ms", job->name, esp_err_to_name(err),
+                 job->retries, job->config.max_retries, (unsigned long)delay_ms);
+    } else {
+        if (err != ESP_OK) {
+            s_stats.failures++;
+            ESP_LOGE(TAG, "%s failed (%s), giving up until next period", job->name,
+                     esp_err_to_name(err));
+        }
+        job->retries = 0;
+
+        if (job->config.period_ms == 0) {
+            // 一次性任务执行完毕，释放任务槽
+            job->in_use = false;
+            return;
+        }
+        job->due_us = now + next_period_us(&job->config);
+    }
+
+    if (job->triggered) {
+        job->triggered = false;
+        job->due_us = now;
+    }
+}
+
+/**
+ * @brief 工作任务
+ */
+static void net_sched_task(void *param) {
+    (void)param;
+
+    // 等待网络与时间初始化完成
+    time_wait_ready();
+    ESP_LOGI(TAG, "Network ready, scheduler running");
+
+    while (1) {
+        int64_t now = esp_timer_get_time();
+
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        int64_t earliest = earliest_due_locked();
+        xSemaphoreGive(s_mutex);
+
+        if (earliest > now) {
+            // 休眠到最早的截止时间，或被 trigger / submit 唤醒
+            TickType_t ticks = portMAX_DELAY;
+            if (earliest != INT64_MAX) {
+                ticks = pdMS_TO_TICKS((earliest - now + 999) / 1000);
+                if (ticks == 0) {
+                    ticks = 1;
+                }
+            }
+            ulTaskNotifyTake(pdTRUE, ticks);
+            continue;
+        }
+
+        // 一轮执行：连续执行所有已到期及合并窗口内的任务，整轮共用一次射频窗口；
+        // 只有离线任务的一轮不申请射频
+        int64_t burst_start = now;
+        int jobs_in_burst = 0;
+        bool radio_tried = false;
+        bool radio_held = false;
+
+        while (1) {
+            xSemaphoreTake(s_mutex, portMAX_DELAY);
+            net_job_t *job = pick_job_locked(now);
+            if (job != NULL) {
+                job->running = true;
+                if (job->due_us > now) {
+                    s_stats.coalesced++;
+                }
+            }
+            xSemaphoreGive(s_mutex);
+
+            if (job == NULL) {
+                break;
+            }
+
+            if (!job->config.offline && !radio_tried) {
+                radio_tried = true;
+                radio_held = (radio_acquire("net_sched") == ESP_OK);
+                if (!radio_held) {
+                    // 仍然执行：任务失败后按各自的退避时间重试
+                    ESP_LOGW(TAG, "Radio not connected, running burst anyway");
+                }
+            }
+
+            ESP_LOGD(TAG, "Running %s", job->name);
+            esp_err_t err = job->config.fn(job->config.arg);
+            now = esp_timer_get_time();
+            jobs_in_burst++;
+
+            xSemaphoreTake(s_mutex, portMAX_DELAY);
+            s_stats.jobs_run++;
+            reschedule_locked(job, err, now);
+            xSemaphoreGive(s_mutex);
+        }
+
+        if (radio_held) {
+            radio_release("net_sched");
+        }
+
+        int64_t burst_us = now - burst_start;
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        s_stats.bursts++;
+        s_stats.last_burst_us = burst_us;
+        s_stats.busy_us_total += burst_us;
+        xSemaphoreGive(s_mutex);
+        ESP_LOGI(TAG, "Burst done: %d job(s) in %lld ms", jobs_in_burst, burst_us / 1000);
+    }
+}
+
+/**
+ * @brief 占用一个空闲任务槽并填入配置（需持有互斥锁）
+ */
+static net_job_t *alloc_job_locked(const net_job_config_t *config) {
+    for (int i = 0; i < NET_SCHED_MAX_JOBS; i++) {
+        net_job_t *job = &s_jobs[i];
+        if (job->in_use) {
+            continue;
+        }
+
+        memset(job, 0, sizeof(net_job_t));
+        job->in_use = true;
+        snprintf(job->name, sizeof(job->name), "%s", config->name ? config->name : "job");
+        job->config = *config;
+        job->config.name = job->name;
+        job->due_us = esp_timer_get_time() + (int64_t)config->first_delay_ms * 1000;
+        return job;
+    }
+
+    s_stats.rejected++;
+    return NULL;
+}
+
+static void wake_worker(void) {
+    if (s_worker != NULL) {
+        xTaskNotifyGive(s_worker);
+    }
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t net_sched_init(void) {
+    if (s_mutex != NULL) {
+        return ESP_OK;
+    }
+
+    s_mutex = xSemaphoreCreateMutex();
+    if (s_mutex == NULL) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        return ESP_ERR_NO_MEM;
+    }
+
+    memset(s_jobs, 0, sizeof(s_jobs));
+    memset(&s_stats, 0, sizeof(s_stats));
+
+    if (xTaskCreate(net_sched_task, "net_sched", NET_SCHED_STACK_SIZE, NULL, 5, &s_worker) !=
+        pdPASS) {
+        ESP_LOGE(TAG, "Failed to create worker task");
+        vSemaphoreDelete(s_mutex);
+        s_mutex = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "Network scheduler initialized (%d slots, coalesce %d ms)", NET_SCHED_MAX_JOBS,
+             NET_SCHED_COALESCE_MS);
+    return ESP_OK;
+}
+
+net_job_id_t net_sched_add(const net_job_config_t *config) {
+    if (s_mutex == NULL || config == NULL || config->fn == NULL) {
+        return -1;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    net_job_t *job = alloc_job_locked(config);
+    xSemaphoreGive(s_mutex);
+
+    if (job == NULL) {
+        ESP_LOGE(TAG, "No free slot for %s", config->name ? config->name : "job");
+        return -1;
+    }
+
+    ESP_LOGI(TAG, "Added %s (period %lu ms, prio %d)", job->name,
+             (unsigned long)config->period_ms, config->priority);
+    wake_worker();
+    return (net_job_id_t)(job - s_jobs);
+}
+
+net_job_id_t net_sched_find(const char *name) {
+    if (s_mutex == NULL || name == NULL) {
+        return -1;
+    }
+
+    net_job_id_t id = -1;
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    for (int i = 0; i < NET_SCHED_MAX_JOBS; i++) {
+        if (s_jobs[i].in_use && s_jobs[i].config.period_ms > 0 &&
+            strcmp(s_jobs[i].name, name) == 0) {
+            id = i;
+            break;
+        }
+    }
+    xSemaphoreGive(s_mutex);
+    return id;
+}
+
+esp_err_t net_sched_trigger(net_job_id_t id) {
+    if (s_mutex == NULL || id < 0 || id >= NET_SCHED_MAX_JOBS) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_err_t ret = ESP_OK;
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    net_job_t *job = &s_jobs[id];
+    if (!job->in_use) {
+        ret = ESP_ERR_NOT_FOUND;
+    } else if (job->running) {
+        job->triggered = true;
+    } else {
+        job->due_us = esp_timer_get_time();
+        job->retries = 0;
+    }
+    xSemaphoreGive(s_mutex);
+
+    if (ret == ESP_OK) {
+        wake_worker();
+    }
+    return ret;
+}
+
+esp_err_t net_sched_trigger_by_name(const char *name) {
+    return net_sched_trigger(net_sched_find(name));
+}
+
+esp_err_t net_sched_submit(const char *name, net_job_fn_t fn, void *arg,
+                           net_job_prio_t priority) {
+    if (s_mutex == NULL || fn == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    net_job_config_t config = {
+        .name = name,
+        .fn = fn,
+        .arg = arg,
+        .priority = priority,
+    };
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    net_job_t *job = alloc_job_locked(&config);
+    xSemaphoreGive(s_mutex);
+
+    if (job == NULL) {
+        ESP_LOGW(TAG, "No free slot for ad-hoc job %s", name ? name : "job");
+        return ESP_ERR_NO_MEM;
+    }
+    wake_worker();
+    return ESP_OK;
+}
+
+void net_sched_get_stats(net_sched_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    if (s_mutex == NULL) {
+        memset(stats, 0, sizeof(net_sched_stats_t));
+        return;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    *stats = s_stats;
+    xSemaphoreGive(s_mutex);
+}
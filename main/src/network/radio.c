@@ -0,0 +1,375 @@
+/**
+ * @file radio.c
+ * @brief 射频（WiFi）使用策略实现
+ */
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <string.h>
+
+#include "config_manager.h"
+#include "net_sched.h"
+#include "radio.h"
+#include "webserver.h"
+#include "wifi.h"
+
+#define TAG "radio"
+
+/** @brief 一小时（微秒） */
+#define HOUR_US (3600LL * 1000 * 1000)
+
+static SemaphoreHandle_t s_mutex = NULL;
+static radio_mode_t s_mode = RADIO_MODE_ALWAYS_ON;
+static uint8_t s_refs = 0;
+static bool s_on = true;
+static bool s_web_session = false;
+static esp_timer_handle_t s_linger_timer = NULL;
+static esp_timer_handle_t s_boot_timer = NULL;
+static esp_timer_handle_t s_web_timer = NULL;
+
+/** @brief 开启时长统计 */
+static int64_t s_acc_us = 0;                    ///< 已统计到的时间点
+static int64_t s_cur_hour = 0;                  ///< s_acc_us 所在的小时序号
+static int64_t s_on_us_hour[RADIO_STATS_HOURS]; ///< 按小时序号取模存放
+static int64_t s_on_us_total = 0;
+static uint32_t s_wakeups = 0;
+static uint32_t s_timeouts = 0;
+static int64_t s_last_connect_ms = -1;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+/**
+ * @brief 把上次统计以来的开启时长计入各小时（需持有互斥锁）
+ */
+static void account_locked(int64_t now) {
+    while (s_acc_us < now) {
+        int64_t hour = s_acc_us / HOUR_US;
+        if (hour != s_cur_hour) {
+            // 进入新的小时，清空从上次到现在之间各小时的槽位
+            for (int64_t h = s_cur_hour + 1; h <= hour && h - s_cur_hour <= RADIO_STATS_HOURS;
+                 h++) {
+                s_on_us_hour[h % RADIO_STATS_HOURS] = 0;
+            }
+            s_cur_hour = hour;
+        }
+
+        int64_t end = (hour + 1) * HOUR_US;
+        if (end > now) {
+            end = now;
+        }
+        if (s_on) {
+            s_on_us_hour[hour % RADIO_STATS_HOURS] += end - s_acc_us;
+            s_on_us_total += end - s_acc_us;
+        }
+        s_acc_us = end;
+    }
+}
+
+/**
+ * @brief 打开或关闭射频（需持有互斥锁）
+ */
+static void set_radio_locked(bool on) {
+    if (s_on == on) {
+        return;
+    }
+
+    account_locked(esp_timer_get_time());
+    if (on) {
+        s_on = true;
+        s_wakeups++;
+        wifi_resume();
+    } else if (wifi_suspend() == ESP_OK) {
+        s_on = false;
+    }
+    ESP_LOGI(TAG, "Radio %s", s_on ? "on" : "off");
+}
+
+/**
+ * @brief 没有使用者时关闭射频（在网络调度器中执行）
+ *
+ * esp_wifi_stop() 可能阻塞较长时间，不在 esp_timer 任务中执行，以免推迟 LVGL tick 等
+ * 其他定时器回调。提交后到执行前可能出现新的使用者，执行时再检查一次。
+ */
+static esp_err_t radio_off_job(void *arg) {
+    (void)arg;
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (s_refs == 0 && s_mode == RADIO_MODE_WINDOWED) {
+        set_radio_locked(false);
+    }
+    xSemaphoreGive(s_mutex);
+    return ESP_OK;
+}
+
+/**
+ * @brief 释放开机时持有的引用（在网络调度器中执行）
+ */
+static esp_err_t boot_release_job(void *arg) {
+    (void)arg;
+    radio_release("boot");
+    return ESP_OK;
+}
+
+/**
+ * @brief 把射频状态切换交给网络调度器
+ *
+ * 任务标记为离线，执行前不申请射频；低优先级，与联网任务同一轮时排在最后。
+ */
+static void post_radio_job(const char *name, net_job_fn_t fn) {
+    const net_job_config_t config = {
+        .name = name,
+        .fn = fn,
+        .priority = NET_JOB_PRIO_LOW,
+        .offline = true,
+    };
+    if (net_sched_add(&config) < 0) {
+        ESP_LOGW(TAG, "Failed to post %s", name);
+    }
+}
+
+/**
+ * @brief 停留时间结束：交给网络调度器关闭射频
+ */
+static void linger_timer_cb(void *arg) {
+    (void)arg;
+    post_radio_job("radio_off", radio_off_job);
+}
+
+/**
+ * @brief 开机保持时间结束
+ */
+static void boot_timer_cb(void *arg) {
+    (void)arg;
+    post_radio_job("radio_boot", boot_release_job);
+}
+
+/**
+ * @brief 开启 Web 会话（在网络调度器中执行，此时射频已打开）
+ */
+static esp_err_t web_session_start_job(void *arg) {
+    (void)arg;
+    if (s_web_session) {
+        return ESP_OK;
+    }
+
+    esp_err_t err = radio_acquire("web");
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    err = webserver_start("/flash");
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "webserver_start failed: %s", esp_err_to_name(err));
+        radio_release("web");
+        return err;
+    }
+
+    s_web_session = true;
+    esp_timer_stop(s_web_timer);
+    esp_timer_start_once(s_web_timer, (uint64_t)RADIO_WEB_SESSION_MS * 1000);
+    ESP_LOGI(TAG, "Web session open for %d s", RADIO_WEB_SESSION_MS / 1000);
+    return ESP_OK;
+}
+
+/**
+ * @brief 结束 Web 会话
+ */
+static esp_err_t web_session_end_job(void *arg) {
+    (void)arg;
+    if (!s_web_session) {
+        return ESP_OK;
+    }
+
+    webserver_stop();
+    s_web_session = false;
+    radio_release("web");
+    ESP_LOGI(TAG, "Web session closed");
+    return ESP_OK;
+}
+
+static void web_timer_cb(void *arg) {
+    (void)arg;
+    net_sched_submit("web_off", web_session_end_job, NULL, NET_JOB_PRIO_HIGH);
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t radio_init(void) {
+    if (s_mutex != NULL) {
+        return ESP_OK;
+    }
+
+    s_mutex = xSemaphoreCreateMutex();
+    if (s_mutex == NULL) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        return ESP_ERR_NO_MEM;
+    }
+
+    const esp_timer_create_args_t linger_args = {.callback = linger_timer_cb, .name = "radio"};
+    const esp_timer_create_args_t boot_args = {.callback = boot_timer_cb, .name = "radio_boot"};
+    const esp_timer_create_args_t web_args = {.callback = web_timer_cb, .name = "radio_web"};
+    if (esp_timer_create(&linger_args, &s_linger_timer) != ESP_OK ||
+        esp_timer_create(&boot_args, &s_boot_timer) != ESP_OK ||
+        esp_timer_create(&web_args, &s_web_timer) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create timers");
+        return ESP_ERR_NO_MEM;
+    }
+
+    sys_config_t config;
+    config_manager_get_config(&config);
+    s_mode = (config.power.radio_mode >= 0 && config.power.radio_mode < RADIO_MODE_COUNT)
+                 ? (radio_mode_t)config.power.radio_mode
+                 : RADIO_MODE_ALWAYS_ON;
+
+    // MODEM_SLEEP 使用最大省电模式并按 DTIM 监听间隔醒来，其他模式关联期间使用默认省电模式
+    int listen_interval = (config.power.listen_interval > 0) ? config.power.listen_interval
+                                                             : RADIO_DEFAULT_LISTEN_INTERVAL;
+    if (s_mode == RADIO_MODE_MODEM_SLEEP) {
+        wifi_set_power_save(true, (uint8_t)listen_interval);
+    } else {
+        wifi_set_power_save(false, 0);
+    }
+
+    // WINDOWED 模式开机时持有一个引用，radio_start() 之后的开机保持时间结束时释放
+    s_refs = (s_mode == RADIO_MODE_WINDOWED) ? 1 : 0;
+
+    memset(s_on_us_hour, 0, sizeof(s_on_us_hour));
+    s_acc_us = esp_timer_get_time();
+    s_cur_hour = s_acc_us / HOUR_US;
+
+    ESP_LOGI(TAG, "Radio policy: %s (listen interval %d)", radio_mode_name(s_mode),
+             s_mode == RADIO_MODE_MODEM_SLEEP ? listen_interval : 0);
+    return ESP_OK;
+}
+
+void radio_start(void) {
+    if (s_mode == RADIO_MODE_ALWAYS_ON) {
+        // 启动 Web 服务器，提供配置页面与 API
+        esp_err_t err = webserver_start("/flash");
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "webserver_start failed: %s", esp_err_to_name(err));
+        }
+        return;
+    }
+
+    if (s_mode == RADIO_MODE_WINDOWED) {
+        // 开机后保持一段时间，之后由联网任务按需打开
+        esp_timer_start_once(s_boot_timer, (uint64_t)RADIO_BOOT_HOLD_MS * 1000);
+    }
+    ESP_LOGI(TAG, "Web server available on demand (long press the screen)");
+}
+
+esp_err_t radio_acquire(const char *who) {
+    if (s_mutex == NULL) {
+        return ESP_OK;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    bool woke = false;
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    s_refs++;
+    esp_timer_stop(s_linger_timer);
+    if (!s_on) {
+        set_radio_locked(true);
+        woke = true;
+    }
+    xSemaphoreGive(s_mutex);
+
+    if (!wifi_wait_connected(RADIO_CONNECT_TIMEOUT_MS)) {
+        ESP_LOGW(TAG, "%s: no connection after %d ms", who ? who : "?",
+                 RADIO_CONNECT_TIMEOUT_MS);
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        s_timeouts++;
+        xSemaphoreGive(s_mutex);
+        radio_release(who);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    if (woke) {
+        int64_t connect_ms = (esp_timer_get_time() - start_us) / 1000;
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        s_last_connect_ms = connect_ms;
+        xSemaphoreGive(s_mutex);
+        ESP_LOGI(TAG, "%s: radio up in %lld ms", who ? who : "?", connect_ms);
+    }
+    return ESP_OK;
+}
+
+void radio_release(const char *who) {
+    if (s_mutex == NULL) {
+        return;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (s_refs > 0) {
+        s_refs--;
+    } else {
+        ESP_LOGW(TAG, "%s: unbalanced release", who ? who : "?");
+    }
+    if (s_refs == 0 && s_mode == RADIO_MODE_WINDOWED && s_on) {
+        esp_timer_stop(s_linger_timer);
+        esp_timer_start_once(s_linger_timer, (uint64_t)RADIO_LINGER_MS * 1000);
+    }
+    xSemaphoreGive(s_mutex);
+}
+
+void radio_request_web_session(void) {
+    if (s_mutex == NULL || s_mode == RADIO_MODE_ALWAYS_ON) {
+        return;
+    }
+
+    if (s_web_session) {
+        // 会话进行中：延长
+        esp_timer_stop(s_web_timer);
+        esp_timer_start_once(s_web_timer, (uint64_t)RADIO_WEB_SESSION_MS * 1000);
+        return;
+    }
+    net_sched_submit("web_on", web_session_start_job, NULL, NET_JOB_PRIO_HIGH);
+}
+
+radio_mode_t radio_get_mode(void) { return s_mode; }
+
+void radio_get_stats(radio_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    memset(stats, 0, sizeof(radio_stats_t));
+    stats->mode = s_mode;
+    if (s_mutex == NULL) {
+        return;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    account_locked(esp_timer_get_time());
+    stats->on = s_on;
+    stats->refs = s_refs;
+    stats->web_session = s_web_session;
+    stats->wakeups = s_wakeups;
+    stats->timeouts = s_timeouts;
+    stats->last_connect_ms = s_last_connect_ms;
+    stats->on_ms_total = s_on_us_total / 1000;
+    for (int i = 0; i < RADIO_STATS_HOURS && i <= s_cur_hour; i++) {
+        int64_t on_us = s_on_us_hour[(s_cur_hour - i) % RADIO_STATS_HOURS];
+        stats->on_ms_hour[i] = (uint32_t)(on_us / 1000);
+    }
+    xSemaphoreGive(s_mutex);
+}
+
+const char *radio_mode_name(radio_mode_t mode) {
+    switch (mode) {
+    case RADIO_MODE_ALWAYS_ON:
+        return "always_on";
+    case RADIO_MODE_MODEM_SLEEP:
+        return "modem_sleep";
+    case RADIO_MODE_WINDOWED:
+        return "windowed";
+    default:
+        return "unknown";
+    }
+}
@@ -0,0 +1,693 @@
+/**
+ * @file screen_mirror.c
+ * @brief 屏幕镜像：帧缓冲快照与脏区增量推送
+ *
+ * 脏矩形列表、影子帧缓冲与编码缓冲都由 LVGL 互斥锁保护；客户端列表只在 HTTP 服务器任务
+ * （握手处理函数与发送工作函数）中修改，不需要额外的锁。
+ */
+
+#include "screen_mirror.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/param.h>
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "lvgl_init.h"
+
+#define TAG "screen_mirror"
+
+/** @brief 快照按行带读取时的缓冲区大小（栈上） */
+#define BAND_BUF_SIZE 640
+/** @brief 消息头部长度 */
+#define FRAME_HEADER_LEN 8
+/** @brief 每个矩形的头部长度 */
+#define RECT_HEADER_LEN 10
+/** @brief 等待 LVGL 互斥锁的超时（毫秒） */
+#define LVGL_LOCK_TIMEOUT_MS 1000
+
+/** @brief 消息类型 */
+#define FRAME_TYPE_KEY 0
+#define FRAME_TYPE_DELTA 1
+
+/**
+ * @brief 脏矩形（闭区间，像素坐标）
+ */
+typedef struct {
+    int16_t x1;
+    int16_t y1;
+    int16_t x2;
+    int16_t y2;
+} rect_t;
+
+/**
+ * @brief 镜像客户端
+ */
+typedef struct {
+    int fd;            ///< 套接字
+    bool awaiting_key; ///< 尚未收到关键帧，此前的增量帧不发给它
+} mirror_client_t;
+
+/**
+ * @brief PNG 流式写入状态
+ */
+typedef struct {
+    httpd_req_t *req; ///< HTTP 请求句柄
+    uint32_t crc;     ///< 当前块的 CRC32
+    uint32_t adler_a; ///< zlib Adler-32 低 16 位
+    uint32_t adler_b; ///< zlib Adler-32 高 16 位
+} png_writer_t;
+
+// ============================================================================
+// 私有变量
+// ============================================================================
+
+static httpd_handle_t s_server = NULL;
+
+static mirror_client_t s_clients[SCREEN_MIRROR_MAX_CLIENTS];
+static uint8_t s_client_count = 0;
+
+static rect_t s_rects[SCREEN_MIRROR_MAX_RECTS];
+static uint8_t s_rect_count = 0;
+
+/** @brief 最近一次提交的帧缓冲内容，用于统计变化像素 */
+static uint8_t *s_shadow = NULL;
+
+/** @brief 待发送的消息，发送完成前不会被覆盖 */
+static uint8_t *s_frame = NULL;
+static size_t s_frame_cap = 0;
+static size_t s_frame_len = 0;
+static volatile bool s_sending = false;
+
+/** @brief 下一帧是否需要关键帧 */
+static bool s_need_key = true;
+static uint16_t s_seq = 0;
+
+static screen_mirror_stats_t s_stats = {0};
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+static bool lock_lvgl(void) {
+    SemaphoreHandle_t mutex = lvgl_get_mutex();
+    return mutex != NULL && xSemaphoreTake(mutex, pdMS_TO_TICKS(LVGL_LOCK_TIMEOUT_MS)) == pdTRUE;
+}
+
+static void unlock_lvgl(void) { xSemaphoreGive(lvgl_get_mutex()); }
+
+/**
+ * @brief 获取显示尺寸
+ *
+ * @return false 显示尚未初始化
+ */
+static bool get_geometry(int *width, int *height) {
+    lv_display_t *disp = lv_port_disp_get();
+    if (disp == NULL || lv_port_disp_get_fb() == NULL) {
+        return false;
+    }
+    *width = lv_display_get_horizontal_resolution(disp);
+    *height = lv_display_get_vertical_resolution(disp);
+    return true;
+}
+
+static void put_le16(uint8_t *p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static void put_be32(uint8_t *p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = (v >> 16) & 0xFF;
+    p[2] = (v >> 8) & 0xFF;
+    p[3] = v & 0xFF;
+}
+
+/**
+ * @brief PackBits 编码
+ *
+ * 控制字节 n 为 0..127 时其后是 n + 1 个原样字节；为 -127..-1（补码）时下一个字节重复
+ * 1 - n 次。只有 3 个以上的重复才编码为游程，最坏情况每 128 字节多 1 字节。
+ *
+ * @return 编码后的字节数
+ */
+static size_t packbits(const uint8_t *src, size_t len, uint8_t *dst) {
+    size_t out = 0;
+    size_t i = 0;
+
+    while (i < len) {
+        size_t run = 1;
+        while (i + run < len && run < 128 && src[i + run] == src[i]) {
+            run++;
+        }
+        if (run >= 3) {
+            dst[out++] = (uint8_t)(257 - run);
+            dst[out++] = src[i];
+            i += run;
+            continue;
+        }
+
+        size_t start = i;
+        while (i < len && i - start < 128) {
+            if (i + 2 < len && src[i] == src[i + 1] && src[i] == src[i + 2]) {
+                break;
+            }
+            i++;
+        }
+        dst[out++] = (uint8_t)(i - start - 1);
+        memcpy(dst + out, src + start, i - start);
+        out += i - start;
+    }
+    return out;
+}
+
+/**
+ * @brief 矩形扩展到整字节后的字节列范围
+ */
+static void rect_columns(const rect_t *r, int *first, int *last) {
+    *first = r->x1 / 8;
+    *last = r->x2 / 8;
+}
+
+/**
+ * @brief 统计矩形内的变化像素并更新影子帧缓冲
+ */
+static uint32_t update_shadow(const uint8_t *fb, int stride, const rect_t *r) {
+    int first, last;
+    rect_columns(r, &first, &last);
+
+    uint32_t changed = 0;
+    for (int y = r->y1; y <= r->y2; y++) {
+        for (int b = first; b <= last; b++) {
+            int i = y * stride + b;
+            uint8_t diff = fb[i] ^ s_shadow[i];
+            if (diff != 0) {
+                changed += __builtin_popcount(diff);
+                s_shadow[i] = fb[i];
+            }
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief 把一个矩形编码进消息缓冲
+ *
+ * @return 写入后的消息长度，0 表示缓冲区不足
+ */
+static size_t encode_rect(const uint8_t *fb, int stride, const rect_t *r, size_t pos) {
+    int first, last;
+    rect_columns(r, &first, &last);
+    int row_bytes = last - first + 1;
+    int rows = r->y2 - r->y1 + 1;
+
+    // 每行最坏情况多 1 字节控制码（行宽不超过 128 字节时）
+    size_t worst = (size_t)rows * (row_bytes + (row_bytes + 127) / 128);
+    if (pos + RECT_HEADER_LEN + worst > s_frame_cap) {
+        return 0;
+    }
+
+    uint8_t *hdr = s_frame + pos;
+    put_le16(hdr, first * 8);
+    put_le16(hdr + 2, r->y1);
+    put_le16(hdr + 4, row_bytes * 8);
+    put_le16(hdr + 6, rows);
+
+    size_t data = pos + RECT_HEADER_LEN;
+    size_t out = data;
+    for (int y = r->y1; y <= r->y2; y++) {
+        out += packbits(fb + y * stride + first, row_bytes, s_frame + out);
+    }
+    put_le16(hdr + 8, out - data);
+
+    s_stats.raw_bytes += (uint64_t)rows * row_bytes;
+    return out;
+}
+
+/**
+ * @brief 编码一条消息，需持有 LVGL 互斥锁
+ *
+ * 脏矩形的总面积超过整屏或编码溢出时改为覆盖全屏的关键帧。
+ */
+static void encode_frame(const uint8_t *fb, int width, int height, uint32_t changed) {
+    const int stride = width / 8;
+    const rect_t full = {0, 0, width - 1, height - 1};
+
+    bool key = s_need_key;
+    if (!key) {
+        size_t area = 0;
+        for (int i = 0; i < s_rect_count; i++) {
+            area += (size_t)(s_rects[i].y2 - s_rects[i].y1 + 1) *
+                    (s_rects[i].x2 / 8 - s_rects[i].x1 / 8 + 1);
+        }
+        key = area > (size_t)stride * height;
+    }
+
+    size_t pos = FRAME_HEADER_LEN;
+    if (!key) {
+        for (int i = 0; i < s_rect_count && pos != 0; i++) {
+            pos = encode_rect(fb, stride, &s_rects[i], pos);
+        }
+        key = (pos == 0);
+    }
+    if (key) {
+        pos = encode_rect(fb, stride, &full, FRAME_HEADER_LEN);
+        s_stats.keyframes++;
+        s_need_key = false;
+    }
+
+    s_frame[0] = key ? FRAME_TYPE_KEY : FRAME_TYPE_DELTA;
+    s_frame[1] = key ? 1 : s_rect_count;
+    put_le16(s_frame + 2, s_seq++);
+    put_le16(s_frame + 4, changed & 0xFFFF);
+    put_le16(s_frame + 6, changed >> 16);
+    s_frame_len = pos;
+}
+
+/**
+ * @brief 从客户端列表中移除一项
+ */
+static void remove_client(int index) {
+    ESP_LOGI(TAG, "Mirror client fd=%d gone", s_clients[index].fd);
+    s_clients[index] = s_clients[--s_client_count];
+    s_stats.clients = s_client_count;
+}
+
+static void queue_frame(uint32_t changed);
+
+/**
+ * @brief 向所有客户端发送消息（在 HTTP 服务器任务中执行）
+ *
+ * 发送失败（客户端断开或发送超时）的连接被移除，下次连接时重新获得关键帧。
+ * 新客户端可能在一条增量帧编码之后、发送之前登记，它在收到关键帧之前跳过增量帧；
+ * 本条发完后若仍有客户端在等待，立即编码一个关键帧。
+ */
+static void send_frame_work(void *arg) {
+    (void)arg;
+    if (s_server == NULL) {
+        s_sending = false;
+        return;
+    }
+
+    httpd_ws_frame_t pkt = {
+        .final = true,
+        .type = HTTPD_WS_TYPE_BINARY,
+        .payload = s_frame,
+        .len = s_frame_len,
+    };
+
+    const bool key = (s_frame[0] == FRAME_TYPE_KEY);
+    bool awaiting = false;
+    for (int i = 0; i < s_client_count;) {
+        mirror_client_t *client = &s_clients[i];
+        if (httpd_ws_get_fd_info(s_server, client->fd) != HTTPD_WS_CLIENT_WEBSOCKET) {
+            remove_client(i);
+        } else if (client->awaiting_key && !key) {
+            awaiting = true;
+            i++;
+        } else if (httpd_ws_send_frame_async(s_server, client->fd, &pkt) == ESP_OK) {
+            client->awaiting_key = false;
+            s_stats.sent_bytes += s_frame_len;
+            i++;
+        } else {
+            remove_client(i);
+        }
+    }
+
+    s_stats.frames++;
+    s_sending = false;
+
+    if (awaiting && lock_lvgl()) {
+        s_need_key = true;
+        queue_frame(0);
+        unlock_lvgl();
+    }
+}
+
+/**
+ * @brief 编码并排队发送一条消息，需持有 LVGL 互斥锁
+ *
+ * 上一条仍在发送时跳过，并让下一条消息成为关键帧。
+ */
+static void queue_frame(uint32_t changed) {
+    int width, height;
+    if (s_server == NULL || s_frame == NULL || !get_geometry(&width, &height)) {
+        return;
+    }
+    if (s_sending) {
+        s_need_key = true;
+        s_stats.skipped++;
+        return;
+    }
+
+    encode_frame(lv_port_disp_get_fb(), width, height, changed);
+    s_sending = true;
+    if (httpd_queue_work(s_server, send_frame_work, NULL) != ESP_OK) {
+        s_sending = false;
+        s_need_key = true;
+    }
+}
+
+/**
+ * @brief 按行带读取帧缓冲（内部持有 LVGL 互斥锁，两次读取之间释放）
+ *
+ * @param dst 输出缓冲
+ * @param y 起始行
+ * @param rows 行数
+ * @param stride 每行字节数
+ * @param png true 时每行前加滤波类型字节 0 并反相（PNG 灰度 0 为黑）
+ * @return false LVGL 互斥锁获取失败
+ */
+static bool read_band(uint8_t *dst, int y, int rows, int stride, bool png) {
+    if (!lock_lvgl()) {
+        return false;
+    }
+
+    const uint8_t *fb = lv_port_disp_get_fb();
+    for (int row = 0; row < rows; row++) {
+        const uint8_t *src = fb + (y + row) * stride;
+        if (png) {
+            *dst++ = 0;
+            for (int b = 0; b < stride; b++) {
+                *dst++ = ~src[b];
+            }
+        } else {
+            memcpy(dst, src, stride);
+            dst += stride;
+        }
+    }
+
+    unlock_lvgl();
+    return true;
+}
+
+static esp_err_t png_write(png_writer_t *png, const void *data, size_t len) {
+    png->crc = esp_rom_crc32_le(png->crc, data, len);
+    return httpd_resp_send_chunk(png->req, data, len);
+}
+
+static esp_err_t png_chunk_begin(png_writer_t *png, const char *type, uint32_t len) {
+    uint8_t hdr[4];
+    put_be32(hdr, len);
+    png->crc = 0;
+    esp_err_t ret = httpd_resp_send_chunk(png->req, (const char *)hdr, sizeof(hdr));
+    return (ret == ESP_OK) ? png_write(png, type, 4) : ret;
+}
+
+static esp_err_t png_chunk_end(png_writer_t *png) {
+    uint8_t crc[4];
+    put_be32(crc, png->crc);
+    return httpd_resp_send_chunk(png->req, (const char *)crc, sizeof(crc));
+}
+
+/**
+ * @brief 以 PNG 发送帧缓冲（1 位灰度）
+ *
+ * 图像数据为 zlib 存储块（不压缩）：每个行带一个存储块，随读随发，CRC 与 Adler-32 增量计算。
+ * 200x200 的屏幕约 5.3 KB。
+ */
+static esp_err_t send_png(httpd_req_t *req, int width, int height) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    const int stride = width / 8;
+    const int band_rows = BAND_BUF_SIZE / (stride + 1);
+    const int bands = (height + band_rows - 1) / band_rows;
+    uint8_t band[BAND_BUF_SIZE];
+    png_writer_t png = {.req = req, .adler_a = 1, .adler_b = 0};
+
+    httpd_resp_set_type(req, "image/png");
+    esp_err_t ret = httpd_resp_send_chunk(req, (const char *)signature, sizeof(signature));
+
+    // IHDR：宽、高、位深 1、颜色类型 0（灰度）、压缩/滤波/隔行均为 0
+    uint8_t ihdr[13] = {0};
+    put_be32(ihdr, width);
+    put_be32(ihdr + 4, height);
+    ihdr[8] = 1;
+    if (ret == ESP_OK) {
+        ret = png_chunk_begin(&png, "IHDR", sizeof(ihdr));
+    }
+    if (ret == ESP_OK) {
+        ret = png_write(&png, ihdr, sizeof(ihdr));
+    }
+    if (ret == ESP_OK) {
+        ret = png_chunk_end(&png);
+    }
+
+    // IDAT：zlib 头 + 每个行带一个存储块 + Adler-32
+    uint32_t idat_len = 2 + bands * 5 + height * (stride + 1) + 4;
+    static const uint8_t zlib_header[2] = {0x78, 0x01};
+    if (ret == ESP_OK) {
+        ret = png_chunk_begin(&png, "IDAT", idat_len);
+    }
+    if (ret == ESP_OK) {
+        ret = png_write(&png, zlib_header, sizeof(zlib_header));
+    }
+
+    for (int y = 0; y < height && ret == ESP_OK; y += band_rows) {
+        int rows = MIN(band_rows, height - y);
+        uint16_t len = rows * (stride + 1);
+        uint8_t block[5] = {(y + rows >= height) ? 1 : 0, len & 0xFF, len >> 8,
+                            (uint8_t)~(len & 0xFF), (uint8_t)~(len >> 8)};
+        if (!read_band(band, y, rows, stride, true)) {
+            ret = ESP_ERR_TIMEOUT;
+            break;
+        }
+        for (int i = 0; i < len; i++) {
+            png.adler_a = (png.adler_a + band[i]) % 65521;
+            png.adler_b = (png.adler_b + png.adler_a) % 65521;
+        }
+        ret = png_write(&png, block, sizeof(block));
+        if (ret == ESP_OK) {
+            ret = png_write(&png, band, len);
+        }
+    }
+
+    uint8_t adler[4];
+    put_be32(adler, (png.adler_b << 16) | png.adler_a);
+    if (ret == ESP_OK) {
+        ret = png_write(&png, adler, sizeof(adler));
+    }
+    if (ret == ESP_OK) {
+        ret = png_chunk_end(&png);
+    }
+
+    if (ret == ESP_OK) {
+        ret = png_chunk_begin(&png, "IEND", 0);
+    }
+    if (ret == ESP_OK) {
+        ret = png_chunk_end(&png);
+    }
+    return ret;
+}
+
+/**
+ * @brief 以 PBM (P4) 发送帧缓冲，帧缓冲格式与 P4 相同（高位在左，1 为黑）
+ */
+static esp_err_t send_pbm(httpd_req_t *req, int width, int height) {
+    const int stride = width / 8;
+    const int band_rows = BAND_BUF_SIZE / stride;
+    uint8_t band[BAND_BUF_SIZE];
+
+    char header[32];
+    int n = snprintf(header, sizeof(header), "P4\n%d %d\n", width, height);
+    httpd_resp_set_type(req, "image/x-portable-bitmap");
+    esp_err_t ret = httpd_resp_send_chunk(req, header, n);
+
+    for (int y = 0; y < height && ret == ESP_OK; y += band_rows) {
+        int rows = MIN(band_rows, height - y);
+        if (!read_band(band, y, rows, stride, false)) {
+            return ESP_ERR_TIMEOUT;
+        }
+        ret = httpd_resp_send_chunk(req, (const char *)band, rows * stride);
+    }
+    return ret;
+}
+
+/**
+ * @brief GET /api/screen - 当前帧缓冲快照
+ */
+static esp_err_t screen_get_handler(httpd_req_t *req) {
+    int width, height;
+    if (!get_geometry(&width, &height)) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        return httpd_resp_send(req, "Display not ready", HTTPD_RESP_USE_STRLEN);
+    }
+
+    char query[32];
+    char format[8] = "png";
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        httpd_query_key_value(query, "format", format, sizeof(format));
+    }
+
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+    esp_err_t ret = (strcmp(format, "pbm") == 0) ? send_pbm(req, width, height)
+                                                 : send_png(req, width, height);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Snapshot aborted: %s", esp_err_to_name(ret));
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+/**
+ * @brief /api/screen/ws - 镜像客户端
+ *
+ * 握手完成时登记客户端并发送关键帧；客户端发来的消息读出后丢弃。
+ */
+static esp_err_t screen_ws_handler(httpd_req_t *req) {
+    if (req->method == HTTP_GET) {
+        int fd = httpd_req_to_sockfd(req);
+
+        // 清理已断开或被复用的连接
+        for (int i = 0; i < s_client_count;) {
+            if (s_clients[i].fd == fd ||
+                httpd_ws_get_fd_info(s_server, s_clients[i].fd) != HTTPD_WS_CLIENT_WEBSOCKET) {
+                remove_client(i);
+            } else {
+                i++;
+            }
+        }
+        if (s_client_count >= SCREEN_MIRROR_MAX_CLIENTS) {
+            ESP_LOGW(TAG, "Too many mirror clients, rejecting fd=%d", fd);
+            return ESP_FAIL;
+        }
+
+        s_clients[s_client_count++] = (mirror_client_t){.fd = fd, .awaiting_key = true};
+        s_stats.clients = s_client_count;
+        ESP_LOGI(TAG, "Mirror client fd=%d connected", fd);
+
+        if (lock_lvgl()) {
+            s_need_key = true;
+            queue_frame(0);
+            unlock_lvgl();
+        }
+        return ESP_OK;
+    }
+
+    uint8_t buf[32];
+    httpd_ws_frame_t pkt = {.payload = buf};
+    esp_err_t ret = httpd_ws_recv_frame(req, &pkt, 0);
+    if (ret != ESP_OK || pkt.len == 0) {
+        return ret;
+    }
+    if (pkt.len > sizeof(buf)) {
+        return ESP_FAIL;
+    }
+    return httpd_ws_recv_frame(req, &pkt, pkt.len);
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+void screen_mirror_mark(int x1, int y1, int x2, int y2) {
+    const rect_t r = {x1, y1, x2, y2};
+
+    if (s_rect_count < SCREEN_MIRROR_MAX_RECTS) {
+        s_rects[s_rect_count++] = r;
+        return;
+    }
+
+    // 列表已满：全部合并为包围盒
+    rect_t *box = &s_rects[0];
+    for (int i = 1; i < s_rect_count; i++) {
+        box->x1 = MIN(box->x1, s_rects[i].x1);
+        box->y1 = MIN(box->y1, s_rects[i].y1);
+        box->x2 = MAX(box->x2, s_rects[i].x2);
+        box->y2 = MAX(box->y2, s_rects[i].y2);
+    }
+    box->x1 = MIN(box->x1, r.x1);
+    box->y1 = MIN(box->y1, r.y1);
+    box->x2 = MAX(box->x2, r.x2);
+    box->y2 = MAX(box->y2, r.y2);
+    s_rect_count = 1;
+}
+
+void screen_mirror_commit(void) {
+    int width, height;
+    if (!get_geometry(&width, &height) || !lock_lvgl()) {
+        return;
+    }
+
+    if (s_rect_count > 0 && s_shadow != NULL) {
+        const uint8_t *fb = lv_port_disp_get_fb();
+        uint32_t changed = 0;
+        for (int i = 0; i < s_rect_count; i++) {
+            changed += update_shadow(fb, width / 8, &s_rects[i]);
+        }
+
+        s_stats.refreshes++;
+        s_stats.changed_last = changed;
+        s_stats.changed_total += changed;
+
+        if (s_client_count > 0) {
+            queue_frame(changed);
+        }
+    }
+    s_rect_count = 0;
+
+    unlock_lvgl();
+}
+
+esp_err_t screen_mirror_register(httpd_handle_t server) {
+    if (s_shadow == NULL) {
+        size_t fb_size = lv_port_disp_get_fb_size();
+        s_frame_cap =
+            FRAME_HEADER_LEN + SCREEN_MIRROR_MAX_RECTS * RECT_HEADER_LEN + fb_size * 2;
+        s_shadow = heap_caps_calloc(1, fb_size, MALLOC_CAP_SPIRAM);
+        s_frame = heap_caps_malloc(s_frame_cap, MALLOC_CAP_SPIRAM);
+        if (s_shadow == NULL || s_frame == NULL) {
+            ESP_LOGE(TAG, "No memory for mirror buffers");
+            heap_caps_free(s_shadow);
+            heap_caps_free(s_frame);
+            s_shadow = NULL;
+            s_frame = NULL;
+            return ESP_ERR_NO_MEM;
+        }
+
+        // 以当前画面为基准，之后只统计新的变化
+        if (lock_lvgl()) {
+            const uint8_t *fb = lv_port_disp_get_fb();
+            if (fb != NULL) {
+                memcpy(s_shadow, fb, fb_size);
+            }
+            unlock_lvgl();
+        }
+    }
+
+    s_server = server;
+    s_client_count = 0;
+    s_stats.clients = 0;
+    s_sending = false;
+
+    httpd_uri_t screen_get = {.uri = "/api/screen",
+                              .method = HTTP_GET,
+                              .handler = screen_get_handler,
+                              .user_ctx = NULL};
+    httpd_uri_t screen_ws = {.uri = "/api/screen/ws",
+                             .method = HTTP_GET,
+                             .handler = screen_ws_handler,
+                             .user_ctx = NULL,
+                             .is_websocket = true};
+    httpd_register_uri_handler(server, &screen_get);
+    httpd_register_uri_handler(server, &screen_ws);
+    return ESP_OK;
+}
+
+void screen_mirror_unregister(void) {
+    s_server = NULL;
+    s_client_count = 0;
+    s_stats.clients = 0;
+    s_sending = false;
+}
+
+void screen_mirror_get_stats(screen_mirror_stats_t *stats) {
+    if (stats != NULL) {
+        *stats = s_stats;
+    }
+}
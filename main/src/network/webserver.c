@@ -10,7 +10,12 @@
  * 主要功能：
  * - 通过 HTTP GET 请求获取设备配置信息
  * - 通过 HTTP POST 请求更新设备配置信息
+ * - 通过 HTTP POST 请求立即执行联网任务（如刷新天气）
+ * - 通过 HTTP GET 请求查询上游接口的熔断状态
  * - 提供 Web 文件静态服务，支持自动路由到 index.html
+ * - 静态文件优先发送构建时生成的 .gz 版本，带强 ETag 与 Cache-Control，支持 304
+ * - 通过 HTTP GET 请求以 Prometheus 文本格式导出运行时指标
+ * - 通过 WebSocket 推送配置与界面状态的增量（见 live_sync.c）
  *
  * @author
  * @date YYYY-MM-DD
@@ -20,10 +25,31 @@
 
 #include "cJSON.h"
 #include "config_manager.h"
+#include "decompress.h"
+#include "esp_heap_caps.h"
 #include "esp_http_server.h"
 #include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
 #include "esp_vfs.h"
+#include "flow_profile.h"
+#include "http_cache.h"
+#include "http_pool.h"
+#include "ip_location.h"
+#include "live_sync.h"
+#include "metrics.h"
+#include "mqtt_push.h"
+#include "net_health.h"
+#include "net_sched.h"
+#include "radio.h"
+#include "screen_mirror.h"
+#include "sntp.h"
+#include "vars.h"
+#include "weather_multi.h"
+#include "wifi.h"
+#include "yiyan.h"
 #include <fcntl.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/param.h>
@@ -32,9 +58,19 @@
 
 /** @defgroup WEBSERVER_MACRO 网络服务器宏定义 */
 /** @{ */
-#define TAG "webserver"      /**< 日志标签 */
-#define MAX_JSON_BODY 1024   /**< JSON 请求体最大字节数 */
-#define FILE_READ_CHUNK 1024 /**< 文件读取块大小 */
+#define TAG "webserver"           /**< 日志标签 */
+#define MAX_JSON_BODY 1024        /**< JSON 请求体最大字节数 */
+#define FILE_SEND_BUF (16 * 1024) /**< 文件发送缓冲区大小（PSRAM），不超过它的文件一次发送 */
+#define ETAG_CACHE_SIZE 8         /**< ETag 缓存条目数 */
+#define ETAG_PATH_MAX 64          /**< ETag 缓存可记录的最长文件路径 */
+#define ETAG_LEN 24               /**< ETag 字符串长度（含引号与结束符） */
+#define CONFIG_PAGE "/index.html" /**< 配置页，单独记录其传输字节数与首字节时间 */
+/** 文件名带内容哈希的资源，内容变化时文件名随之变化 */
+#define CACHE_IMMUTABLE "public, max-age=31536000, immutable"
+/** 其他静态资源 */
+#define CACHE_STATIC "public, max-age=86400"
+/** HTML 每次用 ETag 向服务器校验 */
+#define CACHE_REVALIDATE "no-cache"
 /** @} */
 
 /**
@@ -46,12 +82,38 @@ typedef struct {
     char base_path[ESP_VFS_PATH_MAX + 16]; /**< 文件服务器基础路径 */
 } file_server_data_t;
 
+/**
+ * @brief ETag 缓存条目
+ *
+ * 文件内容哈希在首次请求时计算，以大小与修改时间判断文件是否变化。
+ */
+typedef struct {
+    char path[ETAG_PATH_MAX]; /**< 文件完整路径，空串表示未使用 */
+    off_t size;               /**< 计算哈希时的文件大小 */
+    time_t mtime;             /**< 计算哈希时的修改时间 */
+    char etag[ETAG_LEN];      /**< 强 ETag，"<crc32>-<大小>" */
+} etag_entry_t;
+
 /** @brief 全局 HTTP 服务器句柄 */
 static httpd_handle_t s_server = NULL;
 
 /** @brief 全局文件服务器数据 */
 static file_server_data_t *s_fs_data = NULL;
 
+/**
+ * @brief 文件发送缓冲区
+ *
+ * esp_http_server 在单个任务中依次执行处理函数，缓冲区与 ETag 缓存无需加锁。
+ */
+static uint8_t *s_send_buf = NULL;
+
+/** @brief ETag 缓存，写满后轮换替换 */
+static etag_entry_t s_etags[ETAG_CACHE_SIZE];
+static uint8_t s_etag_next = 0;
+
+/** @brief 静态文件服务统计 */
+static webserver_stats_t s_stats = {.page_bytes = -1, .page_ttfb_us = -1, .page_total_us = -1};
+
 /**
  * @brief 根据文件路径设置 HTTP 响应的 Content-Type
  *
@@ -82,6 +144,134 @@ static void set_content_type_from_file(httpd_req_t *req, const char *filepath) {
     httpd_resp_set_type(req, type);
 }
 
+/**
+ * @brief 判断文件名是否带内容哈希（如 app.3f2a9c1b.js）
+ *
+ * 这类文件内容变化时文件名随之变化，可以被浏览器长期缓存。
+ *
+ * @param filepath 文件路径
+ * @return true 文件名中有一段至少 8 位的十六进制串，且其后还有扩展名
+ */
+static bool is_hashed_name(const char *filepath) {
+    const char *name = strrchr(filepath, '/');
+    name = (name != NULL) ? name + 1 : filepath;
+
+    for (const char *dot = strchr(name, '.'); dot != NULL; dot = strchr(dot + 1, '.')) {
+        size_t hex = strspn(dot + 1, "0123456789abcdef");
+        if (hex >= 8 && dot[1 + hex] == '.') {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 根据文件类型选择 Cache-Control
+ *
+ * @param filepath 文件路径（原始文件，而非 .gz 变体）
+ * @return Cache-Control 头的值
+ */
+static const char *cache_control_for(const char *filepath) {
+    if (is_hashed_name(filepath)) {
+        return CACHE_IMMUTABLE;
+    }
+    if (strstr(filepath, ".html")) {
+        return CACHE_REVALIDATE;
+    }
+    return CACHE_STATIC;
+}
+
+/**
+ * @brief 判断请求头中是否包含指定标记（如 Accept-Encoding 中的 gzip）
+ *
+ * @param req HTTP 请求句柄
+ * @param field 请求头名称
+ * @param token 要查找的标记
+ * @return true 请求头存在且包含该标记
+ */
+static bool header_has(httpd_req_t *req, const char *field, const char *token) {
+    char value[128];
+    esp_err_t ret = httpd_req_get_hdr_value_str(req, field, value, sizeof(value));
+    if (ret != ESP_OK && ret != ESP_ERR_HTTPD_RESULT_TRUNC) {
+        return false;
+    }
+    return strstr(value, token) != NULL;
+}
+
+/**
+ * @brief 在缓存中查找文件的 ETag
+ *
+ * @param filepath 文件完整路径
+ * @param st 文件当前的统计信息
+ * @param etag 输出 ETag，长度 ETAG_LEN
+ * @return true 命中且文件未变化
+ */
+static bool etag_lookup(const char *filepath, const struct stat *st, char *etag) {
+    for (int i = 0; i < ETAG_CACHE_SIZE; i++) {
+        const etag_entry_t *e = &s_etags[i];
+        if (e->size == st->st_size && e->mtime == st->st_mtime && strcmp(e->path, filepath) == 0) {
+            memcpy(etag, e->etag, ETAG_LEN);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 由内容哈希生成 ETag 并写入缓存
+ *
+ * 路径过长的文件不缓存，每次请求重新计算。
+ *
+ * @param filepath 文件完整路径
+ * @param st 文件统计信息
+ * @param crc 文件内容的 CRC32
+ * @param etag 输出 ETag，长度 ETAG_LEN
+ */
+static void etag_store(const char *filepath, const struct stat *st, uint32_t crc, char *etag) {
+    snprintf(etag, ETAG_LEN, "\"%08" PRIx32 "-%lx\"", crc, (unsigned long)st->st_size);
+
+    if (strlen(filepath) >= ETAG_PATH_MAX) {
+        return;
+    }
+
+    // 同一路径的旧条目（文件已变化）原地更新
+    etag_entry_t *slot = NULL;
+    for (int i = 0; i < ETAG_CACHE_SIZE && slot == NULL; i++) {
+        if (strcmp(s_etags[i].path, filepath) == 0) {
+            slot = &s_etags[i];
+        }
+    }
+    if (slot == NULL) {
+        slot = &s_etags[s_etag_next];
+        s_etag_next = (s_etag_next + 1) % ETAG_CACHE_SIZE;
+    }
+
+    strlcpy(slot->path, filepath, sizeof(slot->path));
+    slot->size = st->st_size;
+    slot->mtime = st->st_mtime;
+    memcpy(slot->etag, etag, ETAG_LEN);
+}
+
+/**
+ * @brief 读满指定字节数
+ *
+ * @return 实际读取的字节数，-1 表示读取失败
+ */
+static ssize_t read_full(int fd, uint8_t *buf, size_t len) {
+    size_t total = 0;
+    while (total < len) {
+        ssize_t n = read(fd, buf + total, len - total);
+        if (n < 0) {
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        total += n;
+    }
+    return (ssize_t)total;
+}
+
 /**
  * @brief 向 HTTP 响应发送 404 未找到错误
  *
@@ -94,6 +284,42 @@ static esp_err_t send_not_found(httpd_req_t *req) {
     return httpd_resp_send(req, "File not found", HTTPD_RESP_USE_STRLEN);
 }
 
+/**
+ * @brief 发送 304 Not Modified（客户端缓存仍然有效）
+ *
+ * @param req HTTP 请求句柄
+ * @param etag 当前 ETag
+ * @return esp_err_t 错误码
+ */
+static esp_err_t send_not_modified(httpd_req_t *req, const char *etag) {
+    s_stats.not_modified++;
+    httpd_resp_set_status(req, "304 Not Modified");
+    httpd_resp_set_hdr(req, "ETag", etag);
+    return httpd_resp_send(req, NULL, 0);
+}
+
+/**
+ * @brief 记录一次静态文件响应的统计
+ *
+ * @param filepath 原始文件路径
+ * @param fs 文件服务器上下文
+ * @param bytes 响应体字节数
+ * @param start_us 请求开始时间
+ * @param first_us 首个数据块交给协议栈的时间
+ */
+static void record_response(const char *filepath, const file_server_data_t *fs, size_t bytes,
+                            int64_t start_us, int64_t first_us) {
+    s_stats.bytes += bytes;
+
+    size_t base_len = strlen(fs->base_path);
+    if (strncmp(filepath, fs->base_path, base_len) == 0 &&
+        strcmp(filepath + base_len, CONFIG_PAGE) == 0) {
+        s_stats.page_bytes = (int64_t)bytes;
+        s_stats.page_ttfb_us = first_us - start_us;
+        s_stats.page_total_us = esp_timer_get_time() - start_us;
+    }
+}
+
 /**
  * @brief HTTP GET 请求处理函数 - 用于提供静态文件服务
  *
@@ -101,13 +327,19 @@ static esp_err_t send_not_found(httpd_req_t *req) {
  * - 目录请求自动路由到 index.html
  * - 路径安全检查（防止目录遍历攻击）
  * - 自动 Content-Type 设置
+ * - 客户端接受 gzip 且存在构建时生成的 <文件>.gz 时发送压缩版本
+ * - 基于内容哈希的强 ETag，If-None-Match 匹配时返回 304
+ * - 按文件类型设置 Cache-Control
+ *
+ * 不超过发送缓冲区的文件一次读入并以 Content-Length 发送，较大的文件分块发送。
  *
  * @param req HTTP 请求句柄
  * @return esp_err_t 错误码
  */
 static esp_err_t file_get_handler(httpd_req_t *req) {
+    const int64_t start_us = esp_timer_get_time();
     file_server_data_t *fs = (file_server_data_t *)req->user_ctx;
-    if (fs == NULL) {
+    if (fs == NULL || s_send_buf == NULL) {
         return ESP_FAIL;
     }
 
@@ -144,27 +376,87 @@ static esp_err_t file_get_handler(httpd_req_t *req) {
         }
     }
 
+    s_stats.requests++;
     set_content_type_from_file(req, filepath);
+    httpd_resp_set_hdr(req, "Cache-Control", cache_control_for(filepath));
+
+    // 优先发送预压缩版本，Content-Type 仍按原始文件设置
+    char gz_path[sizeof(filepath) + 3];
+    const char *send_path = filepath;
+    snprintf(gz_path, sizeof(gz_path), "%s.gz", filepath);
+    struct stat gz_stat;
+    if (header_has(req, "Accept-Encoding", "gzip") && stat(gz_path, &gz_stat) == 0) {
+        send_path = gz_path;
+        file_stat = gz_stat;
+        httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+        s_stats.gzip++;
+    }
+    httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+
+    char etag[ETAG_LEN];
+    bool etag_known = etag_lookup(send_path, &file_stat, etag);
+    if (etag_known && header_has(req, "If-None-Match", etag)) {
+        return send_not_modified(req, etag);
+    }
 
     // 打开文件并发送内容
-    int fd = open(filepath, O_RDONLY, 0);
+    int fd = open(send_path, O_RDONLY, 0);
     if (fd == -1) {
         return send_not_found(req);
     }
 
-    char chunk[FILE_READ_CHUNK];
-    ssize_t read_bytes;
+    // 小文件一次读入缓冲区；大文件在首次请求时先完整读一遍计算哈希
+    ssize_t whole = -1;
+    if (file_stat.st_size <= FILE_SEND_BUF) {
+        whole = read_full(fd, s_send_buf, file_stat.st_size);
+        if (whole < 0) {
+            close(fd);
+            return ESP_FAIL;
+        }
+        if (!etag_known) {
+            etag_store(send_path, &file_stat, esp_rom_crc32_le(0, s_send_buf, whole), etag);
+        }
+    } else if (!etag_known) {
+        uint32_t crc = 0;
+        ssize_t n;
+        while ((n = read(fd, s_send_buf, FILE_SEND_BUF)) > 0) {
+            crc = esp_rom_crc32_le(crc, s_send_buf, n);
+        }
+        etag_store(send_path, &file_stat, crc, etag);
+        lseek(fd, 0, SEEK_SET);
+    }
+
+    if (!etag_known && header_has(req, "If-None-Match", etag)) {
+        close(fd);
+        return send_not_modified(req, etag);
+    }
+    httpd_resp_set_hdr(req, "ETag", etag);
+
+    if (whole >= 0) {
+        close(fd);
+        esp_err_t ret = httpd_resp_send(req, (const char *)s_send_buf, whole);
+        record_response(filepath, fs, whole, start_us, esp_timer_get_time());
+        return ret;
+    }
 
     // 分块读取和发送文件内容
-    while ((read_bytes = read(fd, chunk, sizeof(chunk))) > 0) {
-        if (httpd_resp_send_chunk(req, chunk, read_bytes) != ESP_OK) {
+    size_t sent = 0;
+    int64_t first_us = 0;
+    ssize_t read_bytes;
+    while ((read_bytes = read(fd, s_send_buf, FILE_SEND_BUF)) > 0) {
+        if (httpd_resp_send_chunk(req, (const char *)s_send_buf, read_bytes) != ESP_OK) {
             close(fd);
             return ESP_FAIL;
         }
+        if (sent == 0) {
+            first_us = esp_timer_get_time();
+        }
+        sent += read_bytes;
     }
 
     close(fd);
     httpd_resp_send_chunk(req, NULL, 0); // 发送终止块
+    record_response(filepath, fs, sent, start_us, first_us);
     return ESP_OK;
 }
 
@@ -182,33 +474,34 @@ static void copy_string_field(char *dest, size_t dest_size, const cJSON *json_it
 }
 
 /**
- * @brief HTTP GET 请求处理函数 - 获取设备配置信息
- *
- * 返回 JSON 格式的设备配置，包括：
- * - 设备名称
- * - WiFi 配置
- * - 显示设置
- * - IP 定位配置
- * - 天气 API 配置
- *
- * @param req HTTP 请求句柄
- * @return esp_err_t 错误码
+ * @brief 影响定位结果的配置（接入点、定位接口、手动位置）的校验值
  */
-static esp_err_t config_get_handler(httpd_req_t *req) {
+static uint32_t location_config_crc(const sys_config_t *cfg) {
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)&cfg->wifi, sizeof(cfg->wifi));
+    crc = esp_rom_crc32_le(crc, (const uint8_t *)&cfg->ip_location, sizeof(cfg->ip_location));
+    return esp_rom_crc32_le(crc, (const uint8_t *)&cfg->location, sizeof(cfg->location));
+}
+
+cJSON *webserver_config_to_json(void) {
     sys_config_t cfg;
     config_manager_get_config(&cfg);
 
     // 创建 JSON 根对象
     cJSON *root = cJSON_CreateObject();
     if (root == NULL) {
-        return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "OOM");
+        return NULL;
     }
 
     // 创建各个配置子对象
     cJSON *wifi = cJSON_CreateObject();
     cJSON *display = cJSON_CreateObject();
     cJSON *ip_location = cJSON_CreateObject();
+    cJSON *location = cJSON_CreateObject();
     cJSON *weather = cJSON_CreateObject();
+    cJSON *yiyan = cJSON_CreateObject();
+    cJSON *time_cfg = cJSON_CreateObject();
+    cJSON *power = cJSON_CreateObject();
+    cJSON *mqtt = cJSON_CreateObject();
 
     // 添加设备名称
     cJSON_AddStringToObject(root, "device_name", cfg.device_name);
@@ -216,6 +509,10 @@ static esp_err_t config_get_handler(httpd_req_t *req) {
     // 添加 WiFi 配置
     cJSON_AddStringToObject(wifi, "ssid", cfg.wifi.ssid);
     cJSON_AddStringToObject(wifi, "password", cfg.wifi.password);
+    cJSON_AddStringToObject(wifi, "static_ip", cfg.wifi.static_ip);
+    cJSON_AddStringToObject(wifi, "netmask", cfg.wifi.netmask);
+    cJSON_AddStringToObject(wifi, "gateway", cfg.wifi.gateway);
+    cJSON_AddStringToObject(wifi, "dns", cfg.wifi.dns);
     cJSON_AddItemToObject(root, "wifi", wifi);
 
     // 添加显示配置
@@ -226,68 +523,90 @@ static esp_err_t config_get_handler(httpd_req_t *req) {
     // 添加 IP 定位配置
     cJSON_AddStringToObject(ip_location, "id", cfg.ip_location.id);
     cJSON_AddStringToObject(ip_location, "key", cfg.ip_location.key);
+    cJSON_AddStringToObject(ip_location, "base_url", cfg.ip_location.base_url);
     cJSON_AddItemToObject(root, "ip_location", ip_location);
 
+    // 添加位置配置
+    cJSON_AddBoolToObject(location, "manual", cfg.location.manual);
+    cJSON_AddStringToObject(location, "name", cfg.location.name);
+    cJSON_AddNumberToObject(location, "latitude", cfg.location.latitude);
+    cJSON_AddNumberToObject(location, "longitude", cfg.location.longitude);
+    cJSON_AddNumberToObject(location, "cache_ttl_hours", cfg.location.cache_ttl_hours);
+    cJSON_AddItemToObject(root, "location", location);
+
     // 添加天气 API 配置
     cJSON_AddStringToObject(weather, "city", cfg.weather.city);
     cJSON_AddStringToObject(weather, "api_host", cfg.weather.api_host);
     cJSON_AddStringToObject(weather, "api_key", cfg.weather.api_key);
+    cJSON_AddNumberToObject(weather, "stale_minutes", cfg.weather.stale_minutes);
+    cJSON_AddStringToObject(weather, "locations", cfg.weather.locations);
     cJSON_AddItemToObject(root, "weather", weather);
 
-    // 将 JSON 对象转换为字符串
-    char *json_str = cJSON_PrintUnformatted(root);
-    cJSON_Delete(root);
+    // 添加一言接口配置
+    cJSON_AddStringToObject(yiyan, "base_url", cfg.yiyan.base_url);
+    cJSON_AddItemToObject(root, "yiyan", yiyan);
 
-    if (json_str == NULL) {
-        return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to build JSON");
-    }
+    // 添加时间同步配置与状态
+    cJSON_AddStringToObject(time_cfg, "ntp_servers", cfg.time.ntp_servers);
+    cJSON_AddStringToObject(time_cfg, "timezone", cfg.time.timezone);
+    cJSON_AddBoolToObject(time_cfg, "synced", time_is_authoritative());
+    cJSON_AddNumberToObject(time_cfg, "drift_ppm", time_get_drift_ppm());
+    cJSON_AddItemToObject(root, "time", time_cfg);
 
-    // 设置响应类型并发送 JSON 数据
-    httpd_resp_set_type(req, "application/json");
-    esp_err_t ret = httpd_resp_send(req, json_str, HTTPD_RESP_USE_STRLEN);
-    free(json_str);
-    return ret;
+    // 添加射频策略（重启后生效）
+    cJSON_AddNumberToObject(power, "radio_mode", cfg.power.radio_mode);
+    cJSON_AddNumberToObject(power, "listen_interval", cfg.power.listen_interval);
+    cJSON_AddItemToObject(root, "power", power);
+
+    // 添加 MQTT 推送配置（重启后生效）
+    cJSON_AddStringToObject(mqtt, "uri", cfg.mqtt.uri);
+    cJSON_AddStringToObject(mqtt, "username", cfg.mqtt.username);
+    cJSON_AddStringToObject(mqtt, "password", cfg.mqtt.password);
+    cJSON_AddStringToObject(mqtt, "topic_prefix", cfg.mqtt.topic_prefix);
+    cJSON_AddItemToObject(root, "mqtt", mqtt);
+
+    return root;
 }
 
 /**
- * @brief HTTP POST 请求处理函数 - 更新设备配置信息
+ * @brief HTTP GET 请求处理函数 - 获取设备配置信息
  *
- * 接收 JSON 格式的配置数据，更新设备的各项配置，并保存到持久存储。
- * 支持部分更新，只有提供的字段才会被更新。
+ * 返回 JSON 格式的设备配置，包括：
+ * - 设备名称
+ * - WiFi 配置
+ * - 显示设置
+ * - IP 定位配置
+ * - 天气 API 配置
  *
  * @param req HTTP 请求句柄
  * @return esp_err_t 错误码
  */
-static esp_err_t config_post_handler(httpd_req_t *req) {
-    // 检查请求体大小
-    if (req->content_len >= MAX_JSON_BODY) {
-        return httpd_resp_send_err(req, HTTPD_413_CONTENT_TOO_LARGE, "Payload too large");
+static esp_err_t config_get_handler(httpd_req_t *req) {
+    cJSON *root = webserver_config_to_json();
+    if (root == NULL) {
+        return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "OOM");
     }
 
-    // 读取 JSON 请求体
-    char buf[MAX_JSON_BODY] = {0};
-    int received = 0;
-    while (received < req->content_len) {
-        int ret = httpd_req_recv(req, buf + received, req->content_len - received);
-        if (ret <= 0) {
-            if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
-                continue;
-            }
-            return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Read error");
-        }
-        received += ret;
-    }
-    buf[received] = '\0';
+    // 将 JSON 对象转换为字符串
+    char *json_str = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
 
-    // 解析 JSON
-    cJSON *root = cJSON_Parse(buf);
-    if (root == NULL) {
-        return httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid JSON");
+    if (json_str == NULL) {
+        return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to build JSON");
     }
 
+    // 设置响应类型并发送 JSON 数据
+    httpd_resp_set_type(req, "application/json");
+    esp_err_t ret = httpd_resp_send(req, json_str, HTTPD_RESP_USE_STRLEN);
+    free(json_str);
+    return ret;
+}
+
+esp_err_t webserver_config_apply(const cJSON *root) {
     // 获取当前配置
     sys_config_t cfg;
     config_manager_get_config(&cfg);
+    uint32_t location_crc = location_config_crc(&cfg);
 
     cJSON *item = NULL;
 
@@ -302,6 +621,14 @@ static esp_err_t config_post_handler(httpd_req_t *req) {
                           cJSON_GetObjectItemCaseSensitive(wifi, "ssid"));
         copy_string_field(cfg.wifi.password, sizeof(cfg.wifi.password),
                           cJSON_GetObjectItemCaseSensitive(wifi, "password"));
+        copy_string_field(cfg.wifi.static_ip, sizeof(cfg.wifi.static_ip),
+                          cJSON_GetObjectItemCaseSensitive(wifi, "static_ip"));
+        copy_string_field(cfg.wifi.netmask, sizeof(cfg.wifi.netmask),
+                          cJSON_GetObjectItemCaseSensitive(wifi, "netmask"));
+        copy_string_field(cfg.wifi.gateway, sizeof(cfg.wifi.gateway),
+                          cJSON_GetObjectItemCaseSensitive(wifi, "gateway"));
+        copy_string_field(cfg.wifi.dns, sizeof(cfg.wifi.dns),
+                          cJSON_GetObjectItemCaseSensitive(wifi, "dns"));
     }
 
     // 更新显示配置
@@ -324,6 +651,31 @@ static esp_err_t config_post_handler(httpd_req_t *req) {
                           cJSON_GetObjectItemCaseSensitive(ip_location, "id"));
         copy_string_field(cfg.ip_location.key, sizeof(cfg.ip_location.key),
                           cJSON_GetObjectItemCaseSensitive(ip_location, "key"));
+        copy_string_field(cfg.ip_location.base_url, sizeof(cfg.ip_location.base_url),
+                          cJSON_GetObjectItemCaseSensitive(ip_location, "base_url"));
+    }
+
+    // 更新位置配置
+    cJSON *location = cJSON_GetObjectItemCaseSensitive(root, "location");
+    if (cJSON_IsObject(location)) {
+        item = cJSON_GetObjectItemCaseSensitive(location, "manual");
+        if (cJSON_IsBool(item)) {
+            cfg.location.manual = cJSON_IsTrue(item);
+        }
+        copy_string_field(cfg.location.name, sizeof(cfg.location.name),
+                          cJSON_GetObjectItemCaseSensitive(location, "name"));
+        item = cJSON_GetObjectItemCaseSensitive(location, "latitude");
+        if (cJSON_IsNumber(item)) {
+            cfg.location.latitude = item->valuedouble;
+        }
+        item = cJSON_GetObjectItemCaseSensitive(location, "longitude");
+        if (cJSON_IsNumber(item)) {
+            cfg.location.longitude = item->valuedouble;
+        }
+        item = cJSON_GetObjectItemCaseSensitive(location, "cache_ttl_hours");
+        if (cJSON_IsNumber(item)) {
+            cfg.location.cache_ttl_hours = item->valueint;
+        }
     }
 
     // 更新天气 API 配置
@@ -335,14 +687,121 @@ static esp_err_t config_post_handler(httpd_req_t *req) {
                           cJSON_GetObjectItemCaseSensitive(weather, "api_host"));
         copy_string_field(cfg.weather.api_key, sizeof(cfg.weather.api_key),
                           cJSON_GetObjectItemCaseSensitive(weather, "api_key"));
+        item = cJSON_GetObjectItemCaseSensitive(weather, "stale_minutes");
+        if (cJSON_IsNumber(item)) {
+            cfg.weather.stale_minutes = item->valueint;
+        }
+        copy_string_field(cfg.weather.locations, sizeof(cfg.weather.locations),
+                          cJSON_GetObjectItemCaseSensitive(weather, "locations"));
     }
 
-    cJSON_Delete(root);
+    // 更新一言接口配置
+    cJSON *yiyan = cJSON_GetObjectItemCaseSensitive(root, "yiyan");
+    if (cJSON_IsObject(yiyan)) {
+        copy_string_field(cfg.yiyan.base_url, sizeof(cfg.yiyan.base_url),
+                          cJSON_GetObjectItemCaseSensitive(yiyan, "base_url"));
+    }
+
+    // 更新时间同步配置
+    cJSON *time_cfg = cJSON_GetObjectItemCaseSensitive(root, "time");
+    if (cJSON_IsObject(time_cfg)) {
+        copy_string_field(cfg.time.ntp_servers, sizeof(cfg.time.ntp_servers),
+                          cJSON_GetObjectItemCaseSensitive(time_cfg, "ntp_servers"));
+        copy_string_field(cfg.time.timezone, sizeof(cfg.time.timezone),
+                          cJSON_GetObjectItemCaseSensitive(time_cfg, "timezone"));
+    }
+
+    // 更新射频策略
+    cJSON *power = cJSON_GetObjectItemCaseSensitive(root, "power");
+    if (cJSON_IsObject(power)) {
+        item = cJSON_GetObjectItemCaseSensitive(power, "radio_mode");
+        if (cJSON_IsNumber(item) && item->valueint >= 0 && item->valueint < RADIO_MODE_COUNT) {
+            cfg.power.radio_mode = item->valueint;
+        }
+        item = cJSON_GetObjectItemCaseSensitive(power, "listen_interval");
+        if (cJSON_IsNumber(item) && item->valueint > 0 && item->valueint <= 255) {
+            cfg.power.listen_interval = item->valueint;
+        }
+    }
+
+    // 更新 MQTT 推送配置
+    cJSON *mqtt = cJSON_GetObjectItemCaseSensitive(root, "mqtt");
+    if (cJSON_IsObject(mqtt)) {
+        copy_string_field(cfg.mqtt.uri, sizeof(cfg.mqtt.uri),
+                          cJSON_GetObjectItemCaseSensitive(mqtt, "uri"));
+        copy_string_field(cfg.mqtt.username, sizeof(cfg.mqtt.username),
+                          cJSON_GetObjectItemCaseSensitive(mqtt, "username"));
+        copy_string_field(cfg.mqtt.password, sizeof(cfg.mqtt.password),
+                          cJSON_GetObjectItemCaseSensitive(mqtt, "password"));
+        copy_string_field(cfg.mqtt.topic_prefix, sizeof(cfg.mqtt.topic_prefix),
+                          cJSON_GetObjectItemCaseSensitive(mqtt, "topic_prefix"));
+    }
 
     // 保存更新的配置
     esp_err_t err = config_manager_save_config(&cfg);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to save config: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    // 应用新的时区与 NTP 服务器
+    time_apply_config();
+
+    // 接入点、定位接口或手动位置变化后，缓存的定位结果不再可信
+    if (location_config_crc(&cfg) != location_crc) {
+        location_cache_invalidate();
+    }
+
+    // API 密钥等配置可能已修正，解除所有接口的熔断
+    net_health_reset_all();
+
+    // 配置可能影响天气 API 与位置，立即刷新一次天气
+    net_sched_trigger_by_name("weather");
+
+    // 向实时连接推送变化的配置
+    live_sync_notify_config();
+    return ESP_OK;
+}
+
+/**
+ * @brief HTTP POST 请求处理函数 - 更新设备配置信息
+ *
+ * 接收 JSON 格式的配置数据，更新设备的各项配置，并保存到持久存储。
+ * 支持部分更新，只有提供的字段才会被更新。
+ *
+ * @param req HTTP 请求句柄
+ * @return esp_err_t 错误码
+ */
+static esp_err_t config_post_handler(httpd_req_t *req) {
+    // 检查请求体大小
+    if (req->content_len >= MAX_JSON_BODY) {
+        return httpd_resp_send_err(req, HTTPD_413_CONTENT_TOO_LARGE, "Payload too large");
+    }
+
+    // 读取 JSON 请求体
+    char buf[MAX_JSON_BODY] = {0};
+    int received = 0;
+    while (received < req->content_len) {
+        int ret = httpd_req_recv(req, buf + received, req->content_len - received);
+        if (ret <= 0) {
+            if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
+                continue;
+            }
+            return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Read error");
+        }
+        received += ret;
+    }
+    buf[received] = '\0';
+
+    // 解析 JSON
+    cJSON *root = cJSON_Parse(buf);
+    if (root == NULL) {
+        return httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid JSON");
+    }
+
+    esp_err_t err = webserver_config_apply(root);
+    cJSON_Delete(root);
+    if (err != ESP_OK) {
         return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Save failed");
     }
 
@@ -351,12 +810,441 @@ static esp_err_t config_post_handler(httpd_req_t *req) {
     return httpd_resp_send(req, "{\"status\":\"ok\"}", HTTPD_RESP_USE_STRLEN);
 }
 
+/**
+ * @brief HTTP POST 请求处理函数 - 立即执行联网任务
+ *
+ * 请求格式：POST /api/refresh?job=weather，job 为网络调度器中注册的任务名。
+ *
+ * @param req HTTP 请求句柄
+ * @return esp_err_t 错误码
+ */
+static esp_err_t refresh_post_handler(httpd_req_t *req) {
+    char query[64] = {0};
+    char job[NET_SCHED_NAME_MAX] = {0};
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK ||
+        httpd_query_key_value(query, "job", job, sizeof(job)) != ESP_OK) {
+        return httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing job");
+    }
+
+    if (net_sched_trigger_by_name(job) != ESP_OK) {
+        return httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Unknown job");
+    }
+
+    ESP_LOGI(TAG, "Job %s triggered from web", job);
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_send(req, "{\"status\":\"ok\"}", HTTPD_RESP_USE_STRLEN);
+}
+
+/**
+ * @brief HTTP POST 请求处理函数 - 进入 SmartConfig 配网
+ *
+ * 设备随即断开 WiFi，响应在断开前发出。
+ *
+ * @param req HTTP 请求句柄
+ * @return esp_err_t 错误码
+ */
+static esp_err_t smartconfig_post_handler(httpd_req_t *req) {
+    httpd_resp_set_type(req, "application/json");
+    esp_err_t ret = httpd_resp_send(req, "{\"status\":\"ok\"}", HTTPD_RESP_USE_STRLEN);
+
+    ESP_LOGI(TAG, "SmartConfig requested from web");
+    wifi_start_smartconfig();
+    return ret;
+}
+
+/**
+ * @brief HTTP GET 请求处理函数 - 获取上游接口健康状态
+ *
+ * 返回各接口的熔断器状态、连续失败次数、最近一次失败原因与下一次探测的剩余时间，
+ * 最近一次 WiFi 连接的关联、获取 IP 与首个 HTTP 响应耗时，HTTPS 连接池的复用与建连统计，
+ * 响应缓存避免的下载字节、解析与墨水屏刷新次数，GZIP 响应的压缩比与解压耗时，
+ * 每小时的射频开启时长，网络任务调度的执行轮数、合并执行次数与累计耗时，
+ * MQTT 推送连接与消息计数，多位置天气的完整刷新耗时，一言句子环状态，
+ * 静态文件服务的压缩、304 命中与配置页的传输字节数、首字节时间，
+ * 屏幕镜像的客户端数与每次刷新的变化像素数，以及实时同步各连接的耗时与内存占用。
+ *
+ * @param req HTTP 请求句柄
+ * @return esp_err_t 错误码
+ */
+static esp_err_t health_get_handler(httpd_req_t *req) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON *endpoints = cJSON_AddArrayToObject(root, "endpoints");
+
+    for (int i = 0; i < NET_EP_COUNT; i++) {
+        net_health_info_t info;
+        net_health_get((net_endpoint_t)i, &info);
+
+        cJSON *ep = cJSON_CreateObject();
+        cJSON_AddStringToObject(ep, "name", info.name);
+        cJSON_AddStringToObject(ep, "state", net_health_state_name(info.state));
+        cJSON_AddNumberToObject(ep, "consecutive_failures", info.consecutive_failures);
+        cJSON_AddStringToObject(ep, "last_error", net_health_fail_name(info.last_fail));
+        cJSON_AddNumberToObject(ep, "last_status", info.last_status);
+        cJSON_AddNumberToObject(ep, "retry_in_s", (double)(info.retry_in_ms / 1000));
+        cJSON_AddNumberToObject(ep, "successes", info.successes);
+        cJSON_AddNumberToObject(ep, "failures", info.failures);
+        cJSON_AddNumberToObject(ep, "trips", info.trips);
+        cJSON_AddNumberToObject(ep, "skipped", info.skipped);
+        cJSON_AddItemToArray(endpoints, ep);
+    }
+
+    // WiFi 连接各阶段耗时
+    wifi_stats_t wifi_stats;
+    wifi_get_stats(&wifi_stats);
+    cJSON *wifi = cJSON_AddObjectToObject(root, "wifi");
+    cJSON_AddBoolToObject(wifi, "fast_path", wifi_stats.fast_path);
+    cJSON_AddBoolToObject(wifi, "static_ip", wifi_stats.static_ip);
+    cJSON_AddNumberToObject(wifi, "assoc_ms", (double)wifi_stats.assoc_ms);
+    cJSON_AddNumberToObject(wifi, "ip_ms", (double)wifi_stats.ip_ms);
+    cJSON_AddNumberToObject(wifi, "first_byte_ms", (double)wifi_stats.first_byte_ms);
+    cJSON_AddNumberToObject(wifi, "connects", wifi_stats.connects);
+    cJSON_AddNumberToObject(wifi, "fast_hits", wifi_stats.fast_hits);
+    cJSON_AddNumberToObject(wifi, "scan_fallbacks", wifi_stats.scan_fallbacks);
+    cJSON_AddNumberToObject(wifi, "disconnects", wifi_stats.disconnects);
+
+    // HTTPS 连接池（复用与建连次数、建连耗时）
+    http_pool_stats_t pool_stats;
+    http_pool_get_stats(&pool_stats);
+    cJSON *pool = cJSON_AddObjectToObject(root, "pool");
+    cJSON_AddNumberToObject(pool, "requests", pool_stats.requests);
+    cJSON_AddNumberToObject(pool, "connects", pool_stats.connects);
+    cJSON_AddNumberToObject(pool, "reused", pool_stats.reused);
+    cJSON_AddNumberToObject(pool, "stale_retries", pool_stats.stale_retries);
+    cJSON_AddNumberToObject(pool, "evictions", pool_stats.evictions);
+    cJSON_AddNumberToObject(pool, "overflow", pool_stats.overflow);
+    cJSON_AddNumberToObject(pool, "connect_us_total", (double)pool_stats.connect_us_total);
+    cJSON_AddNumberToObject(pool, "last_connect_us", (double)pool_stats.last_connect_us);
+
+    // HTTP 响应缓存（避免的下载、解析与墨水屏刷新）
+    http_cache_stats_t cache_stats;
+    http_cache_get_stats(&cache_stats);
+    cJSON *cache = cJSON_AddObjectToObject(root, "cache");
+    cJSON_AddNumberToObject(cache, "fresh_hits", cache_stats.fresh_hits);
+    cJSON_AddNumberToObject(cache, "not_modified", cache_stats.not_modified);
+    cJSON_AddNumberToObject(cache, "unchanged", cache_stats.unchanged);
+    cJSON_AddNumberToObject(cache, "stores", cache_stats.stores);
+    cJSON_AddNumberToObject(cache, "parses_skipped", cache_stats.parses_skipped);
+    cJSON_AddNumberToObject(cache, "refreshes_skipped", cache_stats.refreshes_skipped);
+    cJSON_AddNumberToObject(cache, "bytes_saved", (double)cache_stats.bytes_saved);
+
+    // GZIP 响应解压（压缩比、inflate 耗时与 zlib 窗口复用）
+    gzip_stats_t gzip_stats;
+    gzip_get_stats(&gzip_stats);
+    cJSON *gzip = cJSON_AddObjectToObject(root, "gzip");
+    cJSON_AddNumberToObject(gzip, "streams", gzip_stats.streams);
+    cJSON_AddNumberToObject(gzip, "inits", gzip_stats.inits);
+    cJSON_AddNumberToObject(gzip, "resets", gzip_stats.resets);
+    cJSON_AddNumberToObject(gzip, "errors", gzip_stats.errors);
+    cJSON_AddNumberToObject(gzip, "bytes_in", (double)gzip_stats.total_in);
+    cJSON_AddNumberToObject(gzip, "bytes_out", (double)gzip_stats.total_out);
+    cJSON_AddNumberToObject(gzip, "ratio",
+                            gzip_stats.total_in > 0
+                                ? (double)gzip_stats.total_out / (double)gzip_stats.total_in
+                                : 0);
+    cJSON_AddNumberToObject(gzip, "inflate_us", (double)gzip_stats.inflate_us);
+    cJSON_AddNumberToObject(gzip, "last_in", gzip_stats.last_in);
+    cJSON_AddNumberToObject(gzip, "last_out", gzip_stats.last_out);
+    cJSON_AddNumberToObject(gzip, "last_us", (double)gzip_stats.last_us);
+
+    // 射频开启时长（每小时，[0] 为当前小时）
+    radio_stats_t radio_stats;
+    radio_get_stats(&radio_stats);
+    cJSON *radio = cJSON_AddObjectToObject(root, "radio");
+    cJSON_AddStringToObject(radio, "mode", radio_mode_name(radio_stats.mode));
+    cJSON_AddBoolToObject(radio, "on", radio_stats.on);
+    cJSON_AddNumberToObject(radio, "refs", radio_stats.refs);
+    cJSON_AddNumberToObject(radio, "wakeups", radio_stats.wakeups);
+    cJSON_AddNumberToObject(radio, "timeouts", radio_stats.timeouts);
+    cJSON_AddNumberToObject(radio, "last_connect_ms", (double)radio_stats.last_connect_ms);
+    cJSON_AddNumberToObject(radio, "on_ms_total", (double)radio_stats.on_ms_total);
+    cJSON *hours = cJSON_AddArrayToObject(radio, "on_ms_hour");
+    for (int i = 0; i < RADIO_STATS_HOURS; i++) {
+        cJSON_AddItemToArray(hours, cJSON_CreateNumber(radio_stats.on_ms_hour[i]));
+    }
+
+    // 网络任务调度（执行轮数、合并执行与射频连续工作的累计耗时）
+    net_sched_stats_t sched_stats;
+    net_sched_get_stats(&sched_stats);
+    cJSON *sched = cJSON_AddObjectToObject(root, "sched");
+    cJSON_AddNumberToObject(sched, "bursts", sched_stats.bursts);
+    cJSON_AddNumberToObject(sched, "jobs_run", sched_stats.jobs_run);
+    cJSON_AddNumberToObject(sched, "coalesced", sched_stats.coalesced);
+    cJSON_AddNumberToObject(sched, "retries", sched_stats.retries);
+    cJSON_AddNumberToObject(sched, "failures", sched_stats.failures);
+    cJSON_AddNumberToObject(sched, "rejected", sched_stats.rejected);
+    cJSON_AddNumberToObject(sched, "busy_ms_total", (double)(sched_stats.busy_us_total / 1000));
+    cJSON_AddNumberToObject(sched, "last_burst_ms", (double)(sched_stats.last_burst_us / 1000));
+
+    // MQTT 推送
+    mqtt_push_stats_t mqtt_stats;
+    mqtt_push_get_stats(&mqtt_stats);
+    cJSON *mqtt = cJSON_AddObjectToObject(root, "mqtt");
+    cJSON_AddBoolToObject(mqtt, "enabled", mqtt_stats.enabled);
+    cJSON_AddBoolToObject(mqtt, "connected", mqtt_stats.connected);
+    cJSON_AddBoolToObject(mqtt, "session_present", mqtt_stats.session_present);
+    cJSON_AddNumberToObject(mqtt, "connects", mqtt_stats.connects);
+    cJSON_AddNumberToObject(mqtt, "disconnects", mqtt_stats.disconnects);
+    cJSON_AddNumberToObject(mqtt, "messages", mqtt_stats.messages);
+    cJSON_AddNumberToObject(mqtt, "vars", mqtt_stats.vars);
+    cJSON_AddNumberToObject(mqtt, "commands", mqtt_stats.commands);
+    cJSON_AddNumberToObject(mqtt, "dropped", mqtt_stats.dropped);
+    cJSON_AddNumberToObject(mqtt, "last_msg_ms", (double)mqtt_stats.last_msg_ms);
+
+    // 多位置天气（完整刷新耗时）
+    weather_multi_stats_t weather_stats;
+    weather_multi_get_stats(&weather_stats);
+    cJSON *weather = cJSON_AddObjectToObject(root, "weather");
+    cJSON_AddNumberToObject(weather, "locations", weather_stats.count);
+    cJSON_AddNumberToObject(weather, "valid", weather_stats.valid);
+    cJSON_AddNumberToObject(weather, "refreshes", weather_stats.refreshes);
+    cJSON_AddNumberToObject(weather, "requests", weather_stats.requests);
+    cJSON_AddNumberToObject(weather, "failures", weather_stats.failures);
+    cJSON_AddNumberToObject(weather, "last_refresh_ms", (double)weather_stats.last_refresh_ms);
+    cJSON_AddNumberToObject(weather, "max_refresh_ms", (double)weather_stats.max_refresh_ms);
+    cJSON_AddNumberToObject(weather, "avg_refresh_ms", (double)weather_stats.avg_refresh_ms);
+
+    // 一言句子环
+    yiyan_stats_t yiyan_stats;
+    yiyan_get_stats(&yiyan_stats);
+    cJSON *yiyan = cJSON_AddObjectToObject(root, "yiyan");
+    cJSON_AddNumberToObject(yiyan, "stored", yiyan_stats.count);
+    cJSON_AddNumberToObject(yiyan, "unread", yiyan_stats.unread);
+    cJSON_AddNumberToObject(yiyan, "fetched", yiyan_stats.fetched);
+    cJSON_AddNumberToObject(yiyan, "duplicates", yiyan_stats.duplicates);
+    cJSON_AddNumberToObject(yiyan, "requests", yiyan_stats.requests);
+    cJSON_AddNumberToObject(yiyan, "shown", yiyan_stats.shown);
+    cJSON_AddNumberToObject(yiyan, "replays", yiyan_stats.replays);
+    cJSON_AddNumberToObject(yiyan, "saves", yiyan_stats.saves);
+
+    // 静态文件服务（配置页传输字节数与首字节时间）
+    webserver_stats_t web_stats;
+    webserver_get_stats(&web_stats);
+    cJSON *web = cJSON_AddObjectToObject(root, "web");
+    cJSON_AddNumberToObject(web, "requests", web_stats.requests);
+    cJSON_AddNumberToObject(web, "gzip", web_stats.gzip);
+    cJSON_AddNumberToObject(web, "not_modified", web_stats.not_modified);
+    cJSON_AddNumberToObject(web, "bytes", (double)web_stats.bytes);
+    cJSON_AddNumberToObject(web, "page_bytes", (double)web_stats.page_bytes);
+    cJSON_AddNumberToObject(web, "page_ttfb_us", (double)web_stats.page_ttfb_us);
+    cJSON_AddNumberToObject(web, "page_total_us", (double)web_stats.page_total_us);
+
+    // 屏幕镜像（每次刷新的变化像素与推送字节数）
+    screen_mirror_stats_t screen_stats;
+    screen_mirror_get_stats(&screen_stats);
+    cJSON *screen = cJSON_AddObjectToObject(root, "screen");
+    cJSON_AddNumberToObject(screen, "clients", screen_stats.clients);
+    cJSON_AddNumberToObject(screen, "refreshes", screen_stats.refreshes);
+    cJSON_AddNumberToObject(screen, "frames", screen_stats.frames);
+    cJSON_AddNumberToObject(screen, "keyframes", screen_stats.keyframes);
+    cJSON_AddNumberToObject(screen, "skipped", screen_stats.skipped);
+    cJSON_AddNumberToObject(screen, "changed_last", screen_stats.changed_last);
+    cJSON_AddNumberToObject(screen, "changed_total", (double)screen_stats.changed_total);
+    cJSON_AddNumberToObject(screen, "raw_bytes", (double)screen_stats.raw_bytes);
+    cJSON_AddNumberToObject(screen, "sent_bytes", (double)screen_stats.sent_bytes);
+
+    // 实时同步（连接数、推送字节数、每个连接的耗时与估算的内存占用）
+    live_sync_stats_t live_stats;
+    live_sync_get_stats(&live_stats);
+    cJSON *live = cJSON_AddObjectToObject(root, "live");
+    cJSON_AddNumberToObject(live, "clients", live_stats.clients);
+    cJSON_AddNumberToObject(live, "messages", live_stats.messages);
+    cJSON_AddNumberToObject(live, "bytes", (double)live_stats.bytes);
+    cJSON_AddNumberToObject(live, "deferred", live_stats.deferred);
+    cJSON_AddNumberToObject(live, "dropped", live_stats.dropped);
+    cJSON_AddNumberToObject(live, "rejected", live_stats.rejected);
+    cJSON_AddNumberToObject(live, "patches", live_stats.patches);
+    cJSON_AddNumberToObject(live, "bad_patches", live_stats.bad_patches);
+    cJSON_AddNumberToObject(live, "polls", live_stats.polls);
+    cJSON_AddNumberToObject(live, "poll_us", (double)live_stats.poll_us);
+    cJSON_AddNumberToObject(live, "heap_per_client", live_stats.heap_per_client);
+    cJSON *peers = cJSON_AddArrayToObject(live, "peers");
+    for (int i = 0; i < live_stats.clients; i++) {
+        const live_sync_client_stats_t *peer = &live_stats.peers[i];
+        cJSON *obj = cJSON_CreateObject();
+        cJSON_AddNumberToObject(obj, "fd", peer->fd);
+        cJSON_AddNumberToObject(obj, "messages", peer->messages);
+        cJSON_AddNumberToObject(obj, "bytes", peer->bytes);
+        cJSON_AddNumberToObject(obj, "deferred", peer->deferred);
+        cJSON_AddNumberToObject(obj, "cpu_us", peer->cpu_us);
+        cJSON_AddNumberToObject(obj, "connected_s", peer->connected_s);
+        cJSON_AddItemToArray(peers, obj);
+    }
+
+    // 界面变量存储（提交次数，以及因提交进行中而推迟或失败的读取）
+    vars_stats_t vars_stats;
+    vars_get_stats(&vars_stats);
+    cJSON *vars = cJSON_AddObjectToObject(root, "vars");
+    cJSON_AddNumberToObject(vars, "commits", vars_stats.commits);
+    cJSON_AddNumberToObject(vars, "changes", vars_stats.changes);
+    cJSON_AddNumberToObject(vars, "view_syncs", vars_stats.view_syncs);
+    cJSON_AddNumberToObject(vars, "view_deferred", vars_stats.view_deferred);
+    cJSON_AddNumberToObject(vars, "read_failed", vars_stats.read_failed);
+    cJSON_AddNumberToObject(vars, "lvgl_deferred", vars_stats.lvgl_deferred);
+
+    char *json_str = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (json_str == NULL) {
+        return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "No memory");
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    esp_err_t ret = httpd_resp_send(req, json_str, HTTPD_RESP_USE_STRLEN);
+    free(json_str);
+    return ret;
+}
+
+/**
+ * @brief 指标导出的输出上下文
+ */
+typedef struct {
+    httpd_req_t *req; ///< 当前请求
+    size_t used;      ///< s_send_buf 中已缓存的字节数
+} metrics_out_t;
+
+/**
+ * @brief 指标导出回调：文本先攒进 s_send_buf，满了再作为一个分块发出
+ */
+static esp_err_t metrics_out_write(void *ctx, const char *data, size_t len) {
+    metrics_out_t *out = ctx;
+
+    while (len > 0) {
+        if (out->used == FILE_SEND_BUF) {
+            esp_err_t ret = httpd_resp_send_chunk(out->req, (const char *)s_send_buf, out->used);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+            out->used = 0;
+        }
+        size_t n = MIN(len, FILE_SEND_BUF - out->used);
+        memcpy(s_send_buf + out->used, data, n);
+        out->used += n;
+        data += n;
+        len -= n;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief HTTP GET 请求处理函数 - 以 Prometheus 文本格式导出运行时指标
+ *
+ * 包括渲染与面板刷新的耗时直方图、上游 HTTP 请求耗时、堆内存与任务栈高水位。
+ *
+ * @param req HTTP 请求句柄
+ * @return esp_err_t 错误码
+ */
+static esp_err_t metrics_get_handler(httpd_req_t *req) {
+    if (s_send_buf == NULL) {
+        return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "No memory");
+    }
+
+    httpd_resp_set_type(req, "text/plain; version=0.0.4; charset=utf-8");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+
+    metrics_out_t out = {.req = req, .used = 0};
+    esp_err_t ret = metrics_write(metrics_out_write, &out);
+    if (ret == ESP_OK && out.used > 0) {
+        ret = httpd_resp_send_chunk(req, (const char *)s_send_buf, out.used);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Metrics export aborted: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+#if EEZ_FLOW_PROFILE
+/**
+ * @brief 把一项剖析统计写入 JSON 对象
+ */
+static void add_profile_entry(cJSON *obj, const flow_profile_entry_t *entry) {
+    cJSON_AddNumberToObject(obj, "count", entry->count);
+    cJSON_AddNumberToObject(obj, "total_us", (double)entry->total_us);
+    cJSON_AddNumberToObject(obj, "max_us", entry->max_us);
+}
+
+/**
+ * @brief HTTP GET 请求处理函数 - 导出 EEZ 流程执行剖析
+ *
+ * 查询参数 reset=1 时读取后清零，下次读取即为两次请求之间的统计。
+ * components 按组件类型号给出，可用 tools/flow_profile.py 换算为名称。
+ *
+ * @param req HTTP 请求句柄
+ * @return esp_err_t 错误码
+ */
+static esp_err_t flow_profile_get_handler(httpd_req_t *req) {
+    char query[32] = {0};
+    char reset[4] = {0};
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        httpd_query_key_value(query, "reset", reset, sizeof(reset));
+    }
+
+    // 统计结构较大，放在 PSRAM 中以免占用处理函数的栈
+    flow_profile_stats_t *stats = heap_caps_malloc(sizeof(*stats), MALLOC_CAP_SPIRAM);
+    if (stats == NULL) {
+        return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "No memory");
+    }
+    if (flow_profile_get_stats(stats, strcmp(reset, "1") == 0) != ESP_OK) {
+        free(stats);
+        return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "UI busy");
+    }
+
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "window_ms", stats->window_ms);
+    cJSON *ticks = cJSON_AddObjectToObject(root, "ticks");
+    add_profile_entry(ticks, &stats->ticks);
+    cJSON_AddNumberToObject(ticks, "budget_hits", stats->budget_hits);
+    cJSON *queue = cJSON_AddObjectToObject(root, "queue");
+    cJSON_AddNumberToObject(queue, "size", stats->queue_size);
+    cJSON_AddNumberToObject(queue, "backlog_max", stats->queue_backlog_max);
+    cJSON_AddNumberToObject(queue, "peak", stats->queue_peak);
+    add_profile_entry(cJSON_AddObjectToObject(root, "expressions"), &stats->expressions);
+
+    cJSON *components = cJSON_AddArrayToObject(root, "components");
+    for (int i = 0; i < stats->num_types; i++) {
+        cJSON *item = cJSON_CreateObject();
+        cJSON_AddNumberToObject(item, "type", stats->components[i].type);
+        add_profile_entry(item, &stats->components[i].entry);
+        cJSON_AddItemToArray(components, item);
+    }
+    cJSON_AddNumberToObject(root, "dropped", stats->dropped);
+
+    cJSON *actions = cJSON_AddArrayToObject(root, "actions");
+    for (int i = 0; i < FLOW_PROFILE_MAX_ACTIONS; i++) {
+        cJSON *item = cJSON_CreateObject();
+        add_profile_entry(item, &stats->actions[i]);
+        cJSON_AddItemToArray(actions, item);
+    }
+    free(stats);
+
+    char *json_str = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (json_str == NULL) {
+        return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "No memory");
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+    esp_err_t ret = httpd_resp_send(req, json_str, HTTPD_RESP_USE_STRLEN);
+    free(json_str);
+    return ret;
+}
+#endif
+
 /**
  * @brief 启动 HTTP 网络服务器
  *
  * 初始化并启动 HTTP 服务器，注册以下请求处理函数：
  * - GET  /api/config      - 获取设备配置
  * - POST /api/config      - 更新设备配置
+ * - POST /api/refresh     - 立即执行联网任务
+ * - GET  /api/health      - 获取上游接口健康状态
+ * - GET  /api/metrics     - 运行时指标（Prometheus 文本格式）
+ * - GET  /api/flow_profile - EEZ 流程执行剖析（EEZ_FLOW_PROFILE 开启时）
+ * - GET  /api/screen      - 屏幕快照（PNG / PBM）
+ * - WS   /api/screen/ws   - 屏幕镜像（脏区增量）
+ * - WS   /api/live        - 配置与界面状态的实时推送，接收配置补丁
+ * - POST /api/wifi/smartconfig - 进入 SmartConfig 配网
  * - GET  /{*}               - 提供静态文件服务
  *
  * @param base_path 文件服务器的基础路径，若为 NULL 则使用 "/flash"
@@ -371,6 +1259,9 @@ esp_err_t webserver_start(const char *base_path) {
     // 配置 HTTP 服务器
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
     config.uri_match_fn = httpd_uri_match_wildcard;
+    config.max_uri_handlers = 12;
+    // 默认 5 秒：慢客户端会让 WebSocket 推送长时间阻塞服务器任务
+    config.send_wait_timeout = WEBSERVER_SEND_WAIT_S;
 
     // 启动 HTTP 服务器
     ESP_LOGI(TAG, "Starting web server on port %d", config.server_port);
@@ -388,6 +1279,14 @@ esp_err_t webserver_start(const char *base_path) {
         return ESP_ERR_NO_MEM;
     }
 
+    // 文件发送缓冲区放在 PSRAM，避免占用处理函数的栈
+    s_send_buf = heap_caps_malloc(FILE_SEND_BUF, MALLOC_CAP_SPIRAM);
+    if (s_send_buf == NULL) {
+        ESP_LOGE(TAG, "No memory for file send buffer");
+        webserver_stop();
+        return ESP_ERR_NO_MEM;
+    }
+
     // 设置文件服务器基础路径
     const char *root = (base_path != NULL) ? base_path : "/flash";
     strlcpy(s_fs_data->base_path, root, sizeof(s_fs_data->base_path));
@@ -399,6 +1298,22 @@ esp_err_t webserver_start(const char *base_path) {
                             .method = HTTP_POST,
                             .handler = config_post_handler,
                             .user_ctx = NULL};
+    httpd_uri_t api_refresh = {.uri = "/api/refresh",
+                               .method = HTTP_POST,
+                               .handler = refresh_post_handler,
+                               .user_ctx = NULL};
+    httpd_uri_t api_smartconfig = {.uri = "/api/wifi/smartconfig",
+                                   .method = HTTP_POST,
+                                   .handler = smartconfig_post_handler,
+                                   .user_ctx = NULL};
+    httpd_uri_t api_health = {.uri = "/api/health",
+                              .method = HTTP_GET,
+                              .handler = health_get_handler,
+                              .user_ctx = NULL};
+    httpd_uri_t api_metrics = {.uri = "/api/metrics",
+                               .method = HTTP_GET,
+                               .handler = metrics_get_handler,
+                               .user_ctx = NULL};
 
     // 注册文件服务处理函数
     httpd_uri_t file_get = {
@@ -407,11 +1322,47 @@ esp_err_t webserver_start(const char *base_path) {
     // 添加处理函数到服务器
     httpd_register_uri_handler(s_server, &api_get);
     httpd_register_uri_handler(s_server, &api_post);
+    httpd_register_uri_handler(s_server, &api_refresh);
+    httpd_register_uri_handler(s_server, &api_health);
+    httpd_register_uri_handler(s_server, &api_metrics);
+    httpd_register_uri_handler(s_server, &api_smartconfig);
+
+#if EEZ_FLOW_PROFILE
+    httpd_uri_t api_flow_profile = {.uri = "/api/flow_profile",
+                                    .method = HTTP_GET,
+                                    .handler = flow_profile_get_handler,
+                                    .user_ctx = NULL};
+    httpd_register_uri_handler(s_server, &api_flow_profile);
+#endif
+
+    // 屏幕快照与镜像（需在通配的文件服务之前注册）
+    ret = screen_mirror_register(s_server);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Screen mirror unavailable: %s", esp_err_to_name(ret));
+    }
+
+    // 配置与界面状态的实时推送
+    ret = live_sync_register(s_server);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Live sync unavailable: %s", esp_err_to_name(ret));
+    }
+
     httpd_register_uri_handler(s_server, &file_get);
 
     return ESP_OK;
 }
 
+/**
+ * @brief 获取静态文件服务统计
+ *
+ * @param stats 输出统计
+ */
+void webserver_get_stats(webserver_stats_t *stats) {
+    if (stats != NULL) {
+        *stats = s_stats;
+    }
+}
+
 /**
  * @brief 停止 HTTP 网络服务器
  *
@@ -420,6 +1371,8 @@ esp_err_t webserver_start(const char *base_path) {
 void webserver_stop() {
     // 停止 HTTP 服务器
     if (s_server) {
+        screen_mirror_unregister();
+        live_sync_unregister();
         httpd_stop(s_server);
         s_server = NULL;
     }
@@ -429,4 +1382,9 @@ void webserver_stop() {
         free(s_fs_data);
         s_fs_data = NULL;
     }
+
+    if (s_send_buf) {
+        heap_caps_free(s_send_buf);
+        s_send_buf = NULL;
+    }
 }
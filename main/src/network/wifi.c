@@ -4,13 +4,16 @@
  *
  * 本模块处理 WiFi STA 模式的配置和连接，支持：
  * - 从配置存储中恢复已保存的 WiFi 凭证
+ * - 使用上次连接的 BSSID 与信道快速重连，可选静态 IP
  * - SmartConfig 自动配网功能
  * - WiFi 连接状态管理和重试机制
  *
  * 工作流程：
  * 1. 检查是否有已保存的 WiFi 配置
- * 2. 如果有配置，尝试连接到保存的 WiFi 网络
- * 3. 如果没有配置或连接失败，启动 SmartConfig 等待用户配网
+ * 2. 如果有配置，先用缓存的 BSSID/信道直接连接（跳过扫描），失败后退回全信道扫描
+ * 3. 之后按指数退避无限重试；没有配置、开机后长时间连不上或用户主动请求时启动 SmartConfig
+ *
+ * DHCP 租约由 lwIP 保存（CONFIG_LWIP_DHCP_RESTORE_LAST_IP），重连时直接请求上次的地址。
  *
  * @author
  * @date YYYY-MM-DD
@@ -18,13 +21,16 @@
 
 #include "esp_event.h"
 #include "esp_log.h"
+#include "esp_mac.h"
 #include "esp_netif.h"
 #include "esp_smartconfig.h"
 #include "esp_system.h"
+#include "esp_timer.h"
 #include "esp_wifi.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
 #include "freertos/task.h"
+#include "nvs.h"
 #include "nvs_flash.h"
 #include <stdio.h>
 #include <string.h>
@@ -33,6 +39,7 @@
 #include "lwip/sys.h"
 
 #include "config_manager.h"
+#include "http_pool.h"
 #include "wifi.h"
 
 /** @brief 日志标签 */
@@ -40,18 +47,260 @@
 
 /** @defgroup WIFI_EVENT_BITS WiFi 事件位定义 */
 /** @{ */
-#define WIFI_CONNECTED_BIT BIT0 /**< WiFi 已连接事件位 */
-#define WIFI_FAIL_BIT BIT1      /**< WiFi 连接失败事件位 */
-#define ESPTOUCH_DONE_BIT BIT2  /**< SmartConfig 完成事件位 */
+#define WIFI_CONNECTED_BIT BIT0     /**< WiFi 已连接事件位 */
+#define WIFI_FIRST_ATTEMPT_BIT BIT1 /**< 开机后的首次尝试已有结果（连上或进入退避） */
+#define ESPTOUCH_DONE_BIT BIT2      /**< SmartConfig 完成事件位 */
 /** @} */
 
-#define MAXIMUM_RETRY 5               /**< 最大重试次数 */
 #define SMARTCONFIG_TIMEOUT_MS 120000 /**< SmartConfig 超时时间（毫秒）120秒 */
 
+/** @brief 接入点缓存 NVS 命名空间与键 */
+#define WIFI_CACHE_NVS_NAMESPACE "wifi_fast"
+#define WIFI_CACHE_NVS_KEY "ap"
+/** @brief 缓存结构版本，wifi_ap_cache_t 布局变化时递增 */
+#define WIFI_CACHE_SCHEMA_VERSION 1
+
+/**
+ * @brief 上次成功连接的接入点
+ */
+typedef struct {
+    uint16_t schema;  /**< 结构版本 */
+    char ssid[33];    /**< SSID，与当前配置不同时缓存不可用 */
+    uint8_t bssid[6]; /**< 接入点 BSSID */
+    uint8_t channel;  /**< 接入点信道 */
+} wifi_ap_cache_t;
+
 /** @brief WiFi 事件组句柄 */
 static EventGroupHandle_t s_wifi_event_group;
+/** @brief STA 网络接口 */
+static esp_netif_t *s_sta_netif = NULL;
+/** @brief 退避重连定时器 */
+static esp_timer_handle_t s_reconnect_timer = NULL;
+/** @brief 开机后长时间未连上时启动 SmartConfig 的定时器 */
+static esp_timer_handle_t s_smartconfig_timer = NULL;
+/** @brief 接入点缓存 */
+static wifi_ap_cache_t s_cache;
+static bool s_cache_valid = false;
+/** @brief 当前连接尝试是否使用了缓存的 BSSID/信道 */
+static bool s_use_cache = false;
 /** @brief 当前重试次数 */
 static int s_retry_num = 0;
+/** @brief SmartConfig 进行中，暂停自动重连 */
+static volatile bool s_smartconfig_active = false;
+/** @brief WiFi 已被主动关闭，暂停自动重连 */
+static volatile bool s_suspended = false;
+/** @brief 关联期间的省电模式与 DTIM 监听间隔 */
+static wifi_ps_type_t s_ps_type = WIFI_PS_MIN_MODEM;
+static uint8_t s_listen_interval = 0;
+/** @brief 连接各阶段的时间点（esp_timer 时间） */
+static int64_t s_connect_start_us = 0;
+static int64_t s_assoc_us = 0;
+static int64_t s_ip_us = 0;
+/** @brief 获取 IP 后尚未收到 HTTP 响应 */
+static volatile bool s_first_byte_pending = false;
+static wifi_stats_t s_stats = {.assoc_ms = -1, .ip_ms = -1, .first_byte_ms = -1};
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+/**
+ * @brief 是否已保存有效的 WiFi 凭证
+ */
+static bool is_configured(const sys_config_t *sys_config) {
+    return strcmp(sys_config->wifi.ssid, "DefaultSSID") != 0 && strlen(sys_config->wifi.ssid) > 0;
+}
+
+/**
+ * @brief 从 NVS 加载接入点缓存
+ */
+static void wifi_cache_load(void) {
+    nvs_handle_t nvs;
+    if (nvs_open(WIFI_CACHE_NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return;
+    }
+    size_t length = sizeof(s_cache);
+    esp_err_t err = nvs_get_blob(nvs, WIFI_CACHE_NVS_KEY, &s_cache, &length);
+    nvs_close(nvs);
+
+    s_cache_valid = (err == ESP_OK && length == sizeof(s_cache) &&
+                     s_cache.schema == WIFI_CACHE_SCHEMA_VERSION && s_cache.channel > 0);
+    if (s_cache_valid) {
+        ESP_LOGI(TAG, "Cached AP %s " MACSTR " on channel %u", s_cache.ssid,
+                 MAC2STR(s_cache.bssid), s_cache.channel);
+    }
+}
+
+/**
+ * @brief 接入点变化时更新缓存并写入 NVS
+ */
+static void wifi_cache_update(const char *ssid, const uint8_t *bssid, uint8_t channel) {
+    if (s_cache_valid && s_cache.channel == channel && strcmp(s_cache.ssid, ssid) == 0 &&
+        memcmp(s_cache.bssid, bssid, sizeof(s_cache.bssid)) == 0) {
+        return;
+    }
+
+    memset(&s_cache, 0, sizeof(s_cache));
+    s_cache.schema = WIFI_CACHE_SCHEMA_VERSION;
+    snprintf(s_cache.ssid, sizeof(s_cache.ssid), "%s", ssid);
+    memcpy(s_cache.bssid, bssid, sizeof(s_cache.bssid));
+    s_cache.channel = channel;
+    s_cache_valid = true;
+
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(WIFI_CACHE_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, WIFI_CACHE_NVS_KEY, &s_cache, sizeof(s_cache));
+        if (err == ESP_OK) {
+            err = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to save AP cache: %s", esp_err_to_name(err));
+    }
+}
+
+/**
+ * @brief 根据配置与接入点缓存设置 STA 参数
+ *
+ * @param use_cache 是否尝试使用缓存的 BSSID/信道（缓存与当前 SSID 不符时忽略）
+ */
+static void apply_sta_config(bool use_cache) {
+    sys_config_t sys_config;
+    config_manager_get_config(&sys_config);
+
+    wifi_config_t wifi_config = {.sta = {
+                                     .threshold.authmode = WIFI_AUTH_OPEN,
+                                     .pmf_cfg = {.capable = true, .required = false},
+                                 }};
+    memcpy(wifi_config.sta.ssid, sys_config.wifi.ssid, strlen(sys_config.wifi.ssid));
+    memcpy(wifi_config.sta.password, sys_config.wifi.password, strlen(sys_config.wifi.password));
+    wifi_config.sta.listen_interval = s_listen_interval;
+
+    s_use_cache = use_cache && s_cache_valid && strcmp(s_cache.ssid, sys_config.wifi.ssid) == 0;
+    if (s_use_cache) {
+        // 直接连接上次的接入点，跳过全信道扫描
+        wifi_config.sta.bssid_set = true;
+        memcpy(wifi_config.sta.bssid, s_cache.bssid, sizeof(wifi_config.sta.bssid));
+        wifi_config.sta.channel = s_cache.channel;
+        wifi_config.sta.scan_method = WIFI_FAST_SCAN;
+    } else {
+        // 扫描所有信道，连接信号最强的同名接入点
+        wifi_config.sta.scan_method = WIFI_ALL_CHANNEL_SCAN;
+        wifi_config.sta.sort_method = WIFI_CONNECT_AP_BY_SIGNAL;
+    }
+
+    esp_err_t err = esp_wifi_set_config(WIFI_IF_STA, &wifi_config);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "esp_wifi_set_config failed: %s", esp_err_to_name(err));
+    }
+}
+
+/**
+ * @brief 配置了静态 IP 时停止 DHCP 并设置地址
+ */
+static void apply_ip_config(const sys_config_t *sys_config) {
+    s_stats.static_ip = false;
+    if (sys_config->wifi.static_ip[0] == '\0') {
+        return;
+    }
+
+    esp_netif_ip_info_t ip_info = {0};
+    const char *netmask =
+        (sys_config->wifi.netmask[0] != '\0') ? sys_config->wifi.netmask : "255.255.255.0";
+    if (esp_netif_str_to_ip4(sys_config->wifi.static_ip, &ip_info.ip) != ESP_OK ||
+        esp_netif_str_to_ip4(netmask, &ip_info.netmask) != ESP_OK ||
+        (sys_config->wifi.gateway[0] != '\0' &&
+         esp_netif_str_to_ip4(sys_config->wifi.gateway, &ip_info.gw) != ESP_OK)) {
+        ESP_LOGW(TAG, "Invalid static IP config, using DHCP");
+        return;
+    }
+
+    esp_err_t err = esp_netif_dhcpc_stop(s_sta_netif);
+    if (err != ESP_OK && err != ESP_ERR_ESP_NETIF_DHCP_ALREADY_STOPPED) {
+        ESP_LOGW(TAG, "Failed to stop DHCP client: %s", esp_err_to_name(err));
+        return;
+    }
+    err = esp_netif_set_ip_info(s_sta_netif, &ip_info);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to set static IP: %s, using DHCP", esp_err_to_name(err));
+        esp_netif_dhcpc_start(s_sta_netif);
+        return;
+    }
+
+    // 未配置 DNS 时使用网关
+    esp_netif_dns_info_t dns = {.ip.type = ESP_IPADDR_TYPE_V4};
+    dns.ip.u_addr.ip4 = ip_info.gw;
+    if (sys_config->wifi.dns[0] != '\0') {
+        esp_netif_str_to_ip4(sys_config->wifi.dns, &dns.ip.u_addr.ip4);
+    }
+    if (dns.ip.u_addr.ip4.addr != 0) {
+        esp_netif_set_dns_info(s_sta_netif, ESP_NETIF_DNS_MAIN, &dns);
+    }
+
+    s_stats.static_ip = true;
+    ESP_LOGI(TAG, "Using static IP " IPSTR, IP2STR(&ip_info.ip));
+}
+
+/**
+ * @brief 发起一次连接并记录开始时间
+ */
+static void connect_now(void) {
+    s_connect_start_us = esp_timer_get_time();
+    s_assoc_us = 0;
+    esp_wifi_connect();
+}
+
+/**
+ * @brief 退避重连定时器回调
+ */
+static void reconnect_timer_cb(void *arg) {
+    (void)arg;
+    if (!s_smartconfig_active) {
+        connect_now();
+    }
+}
+
+/**
+ * @brief 按指数退避安排下一次重连
+ */
+static void schedule_reconnect(void) {
+    uint32_t delay_ms = WIFI_RECONNECT_MAX_DELAY_MS;
+    if (s_retry_num < 16) {
+        delay_ms = 1000u << (s_retry_num - 1);
+        if (delay_ms > WIFI_RECONNECT_MAX_DELAY_MS) {
+            delay_ms = WIFI_RECONNECT_MAX_DELAY_MS;
+        }
+    }
+
+    ESP_LOGI(TAG, "retry %d to connect to the AP in %lu ms", s_retry_num,
+             (unsigned long)delay_ms);
+    esp_timer_stop(s_reconnect_timer);
+    esp_timer_start_once(s_reconnect_timer, (uint64_t)delay_ms * 1000);
+
+    // 缓存的接入点与全信道扫描都失败了，wifi_init() 不再等待，之后的重连在后台进行
+    xEventGroupSetBits(s_wifi_event_group, WIFI_FIRST_ATTEMPT_BIT);
+}
+
+/**
+ * @brief 开机后 WIFI_SMARTCONFIG_AFTER_MS 仍未连上过时启动 SmartConfig
+ *
+ * 射频被 wifi_suspend() 关闭时无法配网，推迟到下一个周期再检查。
+ */
+static void smartconfig_timer_cb(void *arg) {
+    (void)arg;
+    if (s_stats.connects > 0 || s_smartconfig_active) {
+        return;
+    }
+    if (s_suspended) {
+        esp_timer_start_once(s_smartconfig_timer, (uint64_t)WIFI_SMARTCONFIG_AFTER_MS * 1000);
+        return;
+    }
+    ESP_LOGW(TAG, "Not connected after %d s, starting SmartConfig",
+             WIFI_SMARTCONFIG_AFTER_MS / 1000);
+    wifi_start_smartconfig();
+}
 
 /**
  * @brief SmartConfig 事件处理函数
@@ -78,18 +327,9 @@ static void smartconfig_event_handler(void *arg, esp_event_base_t event_base, in
         ESP_LOGI(TAG, "Got SSID and password");
 
         smartconfig_event_got_ssid_pswd_t *evt = (smartconfig_event_got_ssid_pswd_t *)event_data;
-        wifi_config_t wifi_config;
         uint8_t ssid[33] = {0};
         uint8_t password[65] = {0};
 
-        // 清空并配置 WiFi 配置结构
-        bzero(&wifi_config, sizeof(wifi_config_t));
-        memcpy(wifi_config.sta.ssid, evt->ssid, sizeof(wifi_config.sta.ssid));
-        memcpy(wifi_config.sta.password, evt->password, sizeof(wifi_config.sta.password));
-        wifi_config.sta.threshold.authmode = WIFI_AUTH_OPEN;
-        wifi_config.sta.pmf_cfg.capable = true;
-        wifi_config.sta.pmf_cfg.required = false;
-
         memcpy(ssid, evt->ssid, sizeof(evt->ssid));
         memcpy(password, evt->password, sizeof(evt->password));
         ESP_LOGI(TAG, "SSID:%s", ssid);
@@ -104,11 +344,12 @@ static void smartconfig_event_handler(void *arg, esp_event_base_t event_base, in
         memcpy(sys_config.wifi.password, password, strlen((char *)password));
         config_manager_save_config(&sys_config);
 
-        // 断开现有连接并设置新的 WiFi 配置
-        ESP_ERROR_CHECK(esp_wifi_disconnect());
-        ESP_ERROR_CHECK(esp_wifi_set_config(ESP_IF_WIFI_STA, &wifi_config));
-        s_retry_num = 0; // 重置重试次数
-        esp_wifi_connect();
+        // 断开现有连接，用新的凭证扫描连接（缓存的接入点属于旧网络）
+        esp_wifi_disconnect();
+        s_smartconfig_active = false;
+        s_retry_num = 0;
+        apply_sta_config(false);
+        connect_now();
     } else if (event_base == SC_EVENT && event_id == SC_EVENT_SEND_ACK_DONE) {
         // SmartConfig 已发送确认
         xEventGroupSetBits(s_wifi_event_group, ESPTOUCH_DONE_BIT);
@@ -120,7 +361,8 @@ static void smartconfig_event_handler(void *arg, esp_event_base_t event_base, in
  *
  * 处理 WiFi STA 连接过程中的事件：
  * - STA 启动
- * - STA 断开连接（含重试机制）
+ * - 关联成功（记录接入点与关联耗时）
+ * - STA 断开连接（缓存失效时退回扫描，之后按退避时间重试）
  * - 获取到 IP 地址
  *
  * @param arg 事件处理函数参数
@@ -134,52 +376,155 @@ static void wifi_event_handler(void *arg, esp_event_base_t event_base, int32_t e
         // STA 启动，尝试连接到已保存的 WiFi 网络
         sys_config_t sys_config;
         config_manager_get_config(&sys_config);
-        if (strcmp(sys_config.wifi.ssid, "DefaultSSID") != 0 && strlen(sys_config.wifi.ssid) > 0) {
-            esp_wifi_connect();
+        if (is_configured(&sys_config)) {
+            connect_now();
         }
+    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_CONNECTED) {
+        // 关联成功，记录接入点供下次快速重连
+        wifi_event_sta_connected_t *event = (wifi_event_sta_connected_t *)event_data;
+        char ssid[33] = {0};
+        memcpy(ssid, event->ssid, event->ssid_len < 32 ? event->ssid_len : 32);
+
+        s_assoc_us = esp_timer_get_time();
+        s_stats.assoc_ms = (s_assoc_us - s_connect_start_us) / 1000;
+        s_stats.fast_path = s_use_cache;
+        wifi_cache_update(ssid, event->bssid, event->channel);
     } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
-        // WiFi 断开连接，进行重试
-        if (s_retry_num < MAXIMUM_RETRY) {
-            esp_wifi_connect();
-            s_retry_num++;
-            ESP_LOGI(TAG, "retry to connect to the AP");
+        wifi_event_sta_disconnected_t *event = (wifi_event_sta_disconnected_t *)event_data;
+        bool was_connected = s_stats.connected;
+
+        s_stats.connected = false;
+        xEventGroupClearBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
+        ESP_LOGI(TAG, "connect to the AP fail (reason %d)", event->reason);
+
+        if (was_connected) {
+            // 池中的 TLS 连接已随链路失效，关闭后重连时恢复会话
+            http_pool_flush();
+        }
+
+        if (s_smartconfig_active || s_suspended) {
+            return;
+        }
+
+        if (was_connected) {
+            // 刚刚断开：先用缓存的接入点立即重连
+            s_stats.disconnects++;
+            s_retry_num = 0;
+            apply_sta_config(true);
+            connect_now();
+        } else if (s_use_cache) {
+            // 缓存的接入点不可用，立即退回全信道扫描
+            ESP_LOGW(TAG, "Fast reconnect failed, falling back to full scan");
+            s_stats.scan_fallbacks++;
+            apply_sta_config(false);
+            connect_now();
         } else {
-            // 重试次数已达上限
-            xEventGroupSetBits(s_wifi_event_group, WIFI_FAIL_BIT);
+            s_retry_num++;
+            schedule_reconnect();
         }
-        ESP_LOGI(TAG, "connect to the AP fail");
     } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
         // 成功获取 IP 地址
         ip_event_got_ip_t *event = (ip_event_got_ip_t *)event_data;
-        ESP_LOGI(TAG, "got ip:" IPSTR, IP2STR(&event->ip_info.ip));
+        s_ip_us = esp_timer_get_time();
+        s_stats.ip_ms = (s_assoc_us > 0) ? (s_ip_us - s_assoc_us) / 1000 : -1;
+        s_stats.connected = true;
+        s_stats.connects++;
+        if (s_stats.fast_path) {
+            s_stats.fast_hits++;
+        }
+        s_first_byte_pending = true;
+
+        ESP_LOGI(TAG, "got ip:" IPSTR " in %lld ms (assoc %lld ms, %s %lld ms, %s)",
+                 IP2STR(&event->ip_info.ip), (s_ip_us - s_connect_start_us) / 1000,
+                 s_stats.assoc_ms, s_stats.static_ip ? "static" : "dhcp", s_stats.ip_ms,
+                 s_stats.fast_path ? "cached AP" : "scan");
         s_retry_num = 0; // 重置重试计数
-        xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
+        xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT | WIFI_FIRST_ATTEMPT_BIT);
     }
 }
 
 /**
- * @brief 启动 SmartConfig 配网
+ * @brief SmartConfig 任务
  *
- * 初始化 SmartConfig 并启动等待用户通过手机应用进行配网。
+ * 启动 SmartConfig 并等待配网完成。超时后：已有凭证则恢复重连，没有凭证则继续等待配网。
  */
-static void start_smartconfig(void) {
-    s_retry_num = 0;
-    // 注册 SmartConfig 事件处理函数
-    ESP_ERROR_CHECK(
-        esp_event_handler_register(SC_EVENT, ESP_EVENT_ANY_ID, &smartconfig_event_handler, NULL));
-    // 设置 SmartConfig 类型为 ESPTOUCH
-    ESP_ERROR_CHECK(esp_smartconfig_set_type(SC_TYPE_ESPTOUCH));
-    // 创建并启动 SmartConfig
-    smartconfig_start_config_t cfg = SMARTCONFIG_START_CONFIG_DEFAULT();
-    ESP_ERROR_CHECK(esp_smartconfig_start(&cfg));
+static void smartconfig_task(void *param) {
+    (void)param;
+    static bool s_handler_registered = false;
+
+    if (!s_handler_registered) {
+        ESP_ERROR_CHECK(esp_event_handler_register(SC_EVENT, ESP_EVENT_ANY_ID,
+                                                   &smartconfig_event_handler, NULL));
+        s_handler_registered = true;
+    }
+
+    while (1) {
+        // 停止重连，SmartConfig 期间射频用于监听配网数据
+        s_smartconfig_active = true;
+        esp_timer_stop(s_reconnect_timer);
+        esp_wifi_disconnect();
+
+        // 设置 SmartConfig 类型为 ESPTOUCH
+        ESP_ERROR_CHECK(esp_smartconfig_set_type(SC_TYPE_ESPTOUCH));
+        // 创建并启动 SmartConfig
+        smartconfig_start_config_t cfg = SMARTCONFIG_START_CONFIG_DEFAULT();
+        ESP_ERROR_CHECK(esp_smartconfig_start(&cfg));
+        ESP_LOGI(TAG, "SmartConfig started");
+
+        EventBits_t bits = xEventGroupWaitBits(s_wifi_event_group, ESPTOUCH_DONE_BIT, pdTRUE,
+                                               pdFALSE, pdMS_TO_TICKS(SMARTCONFIG_TIMEOUT_MS));
+        esp_smartconfig_stop();
+
+        if (bits & ESPTOUCH_DONE_BIT) {
+            ESP_LOGI(TAG, "SmartConfig done");
+            break;
+        }
+
+        if (s_stats.connected) {
+            // 已用下发的凭证连上，只是确认包未送达
+            s_smartconfig_active = false;
+            break;
+        }
+
+        sys_config_t sys_config;
+        config_manager_get_config(&sys_config);
+        if (is_configured(&sys_config)) {
+            // 超时未配网：恢复使用已保存的凭证重连
+            ESP_LOGI(TAG, "SmartConfig timed out, reconnecting with saved SSID");
+            s_smartconfig_active = false;
+            s_retry_num = 0;
+            apply_sta_config(true);
+            connect_now();
+            break;
+        }
+        ESP_LOGI(TAG, "SmartConfig timed out, no saved config, restarting");
+    }
+
+    vTaskDelete(NULL);
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+void wifi_start_smartconfig(void) {
+    if (s_smartconfig_active) {
+        return;
+    }
+    s_smartconfig_active = true;
+    if (xTaskCreate(smartconfig_task, "smartconfig", 4096, NULL, 3, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create SmartConfig task");
+        s_smartconfig_active = false;
+    }
 }
 
 /**
  * @brief 初始化 WiFi STA 模式
  *
  * 初始化 WiFi 网络栈，配置为 STA 模式，然后：
- * 1. 尝试从系统配置中恢复已保存的 WiFi 配置并连接
- * 2. 如果没有配置或连接失败，启动 SmartConfig 等待用户配网
+ * 1. 使用缓存的 BSSID/信道与可选的静态 IP 连接已保存的 WiFi 网络，等待这次尝试
+ *    （以及失败后的全信道扫描）有结果后返回
+ * 2. 如果没有配置，启动 SmartConfig 后立即返回；开机后长时间仍未连上时由定时器启动
  */
 void wifi_init(void) {
     // 设置日志级别
@@ -196,12 +541,25 @@ void wifi_init(void) {
     // 创建默认事件循环
     ESP_ERROR_CHECK(esp_event_loop_create_default());
     // 创建默认的 WiFi STA 网络接口
-    esp_netif_create_default_wifi_sta();
+    s_sta_netif = esp_netif_create_default_wifi_sta();
 
     // 初始化 WiFi 驱动
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
     ESP_ERROR_CHECK(esp_wifi_init(&cfg));
 
+    // 创建退避重连定时器
+    const esp_timer_create_args_t timer_args = {
+        .callback = reconnect_timer_cb,
+        .name = "wifi_reconnect",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_reconnect_timer));
+
+    const esp_timer_create_args_t smartconfig_timer_args = {
+        .callback = smartconfig_timer_cb,
+        .name = "wifi_smartconfig",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&smartconfig_timer_args, &s_smartconfig_timer));
+
     // 注册 WiFi 事件处理函数
     esp_event_handler_instance_t instance_any_id;
     esp_event_handler_instance_t instance_got_ip;
@@ -215,67 +573,105 @@ void wifi_init(void) {
     config_manager_get_config(&sys_config);
 
     // 检查是否有有效的 WiFi 配置
-    bool is_configured =
-        (strcmp(sys_config.wifi.ssid, "DefaultSSID") != 0 && strlen(sys_config.wifi.ssid) > 0);
+    bool configured = is_configured(&sys_config);
 
     // 设置 WiFi 模式为 STA
     ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
 
-    // 如果有配置，应用该配置
-    if (is_configured) {
-        wifi_config_t wifi_config = {.sta = {
-                                         .threshold.authmode = WIFI_AUTH_OPEN,
-                                         .pmf_cfg = {.capable = true, .required = false},
-                                     }};
-        memcpy(wifi_config.sta.ssid, sys_config.wifi.ssid, strlen(sys_config.wifi.ssid));
-        memcpy(wifi_config.sta.password, sys_config.wifi.password,
-               strlen(sys_config.wifi.password));
-        ESP_ERROR_CHECK(esp_wifi_set_config(ESP_IF_WIFI_STA, &wifi_config));
+    // 如果有配置，应用该配置（优先使用缓存的接入点）
+    if (configured) {
+        wifi_cache_load();
+        apply_sta_config(true);
+        apply_ip_config(&sys_config);
     }
 
-    // 启动 WiFi
+    // 启动 WiFi（STA_START 事件中发起连接）
     ESP_ERROR_CHECK(esp_wifi_start());
+    esp_wifi_set_ps(s_ps_type);
 
-    // 尝试连接到已保存的 WiFi 网络
-    if (is_configured) {
-        ESP_LOGI(TAG, "Connecting to saved SSID: %s", sys_config.wifi.ssid);
-        // 等待连接成功或失败
-        EventBits_t bits =
-            xEventGroupWaitBits(s_wifi_event_group, WIFI_CONNECTED_BIT | WIFI_FAIL_BIT, pdFALSE,
-                                pdFALSE, portMAX_DELAY);
-
-        if (bits & WIFI_CONNECTED_BIT) {
-            // 连接成功
-            config_manager_get_config(&sys_config);
-            ESP_LOGI(TAG, "connected to ap SSID:%s password:%s", sys_config.wifi.ssid,
-                     sys_config.wifi.password);
-            return; // 连接成功，直接返回
-        } else {
-            // 连接失败，继续执行下面的 SmartConfig 逻辑
-            ESP_LOGI(TAG, "Failed to connect to SSID:%s, starting SmartConfig...",
-                     sys_config.wifi.ssid);
-        }
-    } else {
-        // 没有有效的配置，启动 SmartConfig
+    if (!configured) {
+        // 没有有效的配置，启动 SmartConfig，配网在后台进行
         ESP_LOGI(TAG, "No valid config found, starting SmartConfig...");
+        wifi_start_smartconfig();
+        return;
     }
 
-    // 启动 SmartConfig 进行配网
-    start_smartconfig();
+    ESP_LOGI(TAG, "Connecting to saved SSID: %s%s", sys_config.wifi.ssid,
+             s_use_cache ? " (cached AP)" : "");
+    esp_timer_start_once(s_smartconfig_timer, (uint64_t)WIFI_SMARTCONFIG_AFTER_MS * 1000);
+
+    // 只等待首次尝试的结果，不阻塞开机流程；退避重连与 SmartConfig 在后台继续，
+    // 联网的使用者各自等待连接（wifi_wait_connected()、radio_acquire()）
+    EventBits_t bits = xEventGroupWaitBits(s_wifi_event_group,
+                                           WIFI_CONNECTED_BIT | WIFI_FIRST_ATTEMPT_BIT, pdFALSE,
+                                           pdFALSE, pdMS_TO_TICKS(WIFI_FIRST_ATTEMPT_MAX_MS));
+    if (!(bits & WIFI_CONNECTED_BIT)) {
+        ESP_LOGW(TAG, "Not connected yet, retrying in background");
+        return;
+    }
 
-    // 等待 SmartConfig 完成或 WiFi 连接成功
-    EventBits_t bits =
-        xEventGroupWaitBits(s_wifi_event_group, WIFI_CONNECTED_BIT | ESPTOUCH_DONE_BIT, pdFALSE,
-                            pdFALSE, portMAX_DELAY);
+    ESP_LOGI(TAG, "connected to ap SSID:%s", sys_config.wifi.ssid);
+}
 
-    if (bits & WIFI_CONNECTED_BIT) {
-        // WiFi 已连接
-        config_manager_get_config(&sys_config);
-        ESP_LOGI(TAG, "connected to ap SSID:%s password:%s", sys_config.wifi.ssid,
-                 sys_config.wifi.password);
-    } else if (bits & ESPTOUCH_DONE_BIT) {
-        // SmartConfig 已完成
-        ESP_LOGI(TAG, "SmartConfig done");
-        esp_smartconfig_stop();
+void wifi_set_power_save(bool max_modem, uint8_t listen_interval) {
+    s_ps_type = max_modem ? WIFI_PS_MAX_MODEM : WIFI_PS_MIN_MODEM;
+    s_listen_interval = listen_interval;
+}
+
+esp_err_t wifi_suspend(void) {
+    if (s_smartconfig_active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_suspended = true;
+    esp_timer_stop(s_reconnect_timer);
+    s_stats.connected = false;
+    xEventGroupClearBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
+    // 关闭射频前关闭池中的空闲连接，避免恢复后在已失效的套接字上发送请求
+    http_pool_flush();
+    esp_err_t err = esp_wifi_stop();
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "esp_wifi_stop failed: %s", esp_err_to_name(err));
     }
-}
\ No newline at end of file
+    return ESP_OK;
+}
+
+void wifi_resume(void) {
+    if (!s_suspended) {
+        return;
+    }
+
+    s_suspended = false;
+    s_retry_num = 0;
+    apply_sta_config(true);
+    // STA_START 事件中发起连接
+    esp_err_t err = esp_wifi_start();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "esp_wifi_start failed: %s", esp_err_to_name(err));
+        return;
+    }
+    esp_wifi_set_ps(s_ps_type);
+}
+
+bool wifi_wait_connected(uint32_t timeout_ms) {
+    if (s_wifi_event_group == NULL) {
+        return false;
+    }
+    EventBits_t bits = xEventGroupWaitBits(s_wifi_event_group, WIFI_CONNECTED_BIT, pdFALSE,
+                                           pdFALSE, pdMS_TO_TICKS(timeout_ms));
+    return (bits & WIFI_CONNECTED_BIT) != 0;
+}
+
+void wifi_note_first_byte(void) {
+    if (s_first_byte_pending) {
+        s_first_byte_pending = false;
+        s_stats.first_byte_ms = (esp_timer_get_time() - s_ip_us) / 1000;
+        ESP_LOGI(TAG, "First HTTP response %lld ms after IP", s_stats.first_byte_ms);
+    }
+}
+
+void wifi_get_stats(wifi_stats_t *stats) {
+    if (stats != NULL) {
+        *stats = s_stats;
+    }
+}
@@ -23,6 +23,7 @@
 
 #include "config_manager.h"
 #include "date_update.h"
+#include "sntp.h"
 #include "solar_term.h"
 
 /** @brief 上次记录的年份 */
@@ -39,12 +40,20 @@ static int last_minute = -1;
 static int last_weekday = -1;
 
 /**
- * @brief 更新日期和时间
- *
- * 检查当前系统时间，如果与上次记录的值不同，则更新相应的系统变量。
- * 定期被定时器回调函数调用。
+ * @brief 检查当前系统时间，与上次记录的值不同时写入相应的界面变量
  */
-void date_update() {
+static void update_date_vars(void) {
+    // 首次上电且尚未同步时没有有效时间，显示占位符（last_year 为 0 表示已显示）
+    if (time_get_source() == TIME_SOURCE_NONE) {
+        if (last_year != 0) {
+            last_year = 0;
+            set_var_current_date("等待时间同步");
+            set_var_current_time("--:--");
+            set_var_current_weekday("");
+        }
+        return;
+    }
+
     time_t now = time(NULL);
     struct tm timeinfo;
 
@@ -97,6 +106,20 @@ void date_update() {
     }
 }
 
+/**
+ * @brief 更新日期和时间
+ *
+ * 定期被定时器回调函数调用。同一次检查中变化的日期、节气、时间与星期作为一次提交发布，
+ * 跨日时界面在同一次刷新中显示新的日期和时间。
+ */
+void date_update() {
+    if (vars_begin() != ESP_OK) {
+        return;
+    }
+    update_date_vars();
+    vars_commit();
+}
+
 /**
  * @brief 初始化日期更新服务
  *
@@ -113,4 +136,18 @@ void date_update_init() {
     esp_timer_create(&periodic_timer_args, &periodic_timer);
     // 启动周期定时器（1000 * 1000 微秒 = 1 秒）
     esp_timer_start_periodic(periodic_timer, 1000 * 1000);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 强制刷新日期时间
+ *
+ * 清除上次记录的值，下一次定时检测时重新设置所有日期时间变量（如时间同步或时区变化后）。
+ */
+void date_update_refresh() {
+    last_year = -1;
+    last_month = -1;
+    last_day = -1;
+    last_hour = -1;
+    last_minute = -1;
+    last_weekday = -1;
+}
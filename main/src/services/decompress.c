@@ -1,79 +1,256 @@
+#include "esp_heap_caps.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <string.h>
 
 #include "decompress.h"
 
 #define TAG "decompress"
 
+/** @brief 共享解压器（decompress_init 中分配，之后一直保留） */
+static gzip_stream_t *s_shared = NULL;
+static SemaphoreHandle_t s_shared_mutex = NULL;
+static gzip_stats_t s_stats;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+/**
+ * @brief zlib 内存分配钩子：窗口与状态放在 PSRAM 中，PSRAM 不足时退回内部 RAM
+ */
+static voidpf gzip_zalloc(voidpf opaque, uInt items, uInt size) {
+    (void)opaque;
+    size_t bytes = (size_t)items * size;
+    void *p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+    if (p == NULL) {
+        p = heap_caps_malloc(bytes, MALLOC_CAP_DEFAULT);
+    }
+    return p;
+}
+
+static void gzip_zfree(voidpf opaque, voidpf address) {
+    (void)opaque;
+    heap_caps_free(address);
+}
+
 /**
- * @brief GZIP 数据解压缩函数
+ * @brief 跳过成员之间的填充 0（与 gzip 命令相同，成员结束后的 0 字节不视为新成员）
  *
- * 使用 zlib 库对 GZIP 压缩的数据进行解压缩。
+ * @return 是否还有剩余输入
+ */
+static bool skip_padding(gzip_stream_t *gs) {
+    while (gs->zs.avail_in > 0 && *gs->zs.next_in == 0) {
+        gs->zs.next_in++;
+        gs->zs.avail_in--;
+    }
+    return gs->zs.avail_in > 0;
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+void gzip_stream_init(gzip_stream_t *gs, gzip_stream_output_cb_t output_cb, void *ctx) {
+    memset(gs, 0, sizeof(gzip_stream_t));
+    gs->zs.zalloc = gzip_zalloc;
+    gs->zs.zfree = gzip_zfree;
+    gs->output_cb = output_cb;
+    gs->ctx = ctx;
+}
+
+void gzip_stream_reset(gzip_stream_t *gs, gzip_stream_output_cb_t output_cb, void *ctx) {
+    gs->detected = false;
+    gs->passthrough = false;
+    gs->finished = false;
+    gs->output_cb = output_cb;
+    gs->ctx = ctx;
+    gs->total_in = 0;
+    gs->total_out = 0;
+    gs->inflate_us = 0;
+}
+
+/**
+ * @brief 流式解压一段数据
  *
- * @param in_buf 压缩数据输入缓冲区
- * @param in_size 压缩数据大小
- * @param out_buf 解压缩数据输出缓冲区
- * @param out_size 输出指针，保存解压缩后的数据长度
- * @param out_buf_size 输出缓冲区大小
- * @return int 错误码，Z_OK 表示成功
+ * 每填满一个输出块就交给回调，处理完本段输入后返回，zlib 状态保留到下一段数据。
  */
-int network_gzip_decompress(void *in_buf, size_t in_size, void *out_buf, size_t *out_size,
-                            size_t out_buf_size) {
-    int err = 0;
-    // 初始化 zlib 解压缩流
-    z_stream d_stream = {0};
-    d_stream.zalloc = Z_NULL;
-    d_stream.zfree = Z_NULL;
-    d_stream.opaque = Z_NULL;
-    d_stream.next_in = (Bytef *)in_buf;
-    d_stream.avail_in = 0;
-    d_stream.next_out = (Bytef *)out_buf;
-    d_stream.avail_out = 0;
-
-    // 初始化解压缩器（16 + MAX_WBITS 用于处理 GZIP 格式）
-    err = inflateInit2(&d_stream, 16 + MAX_WBITS);
-    if (err != Z_OK) {
-        ESP_LOGE(TAG, "inflateInit2 failed: %d", err);
-        return err;
-    }
-
-    d_stream.avail_in = in_size;
-    d_stream.avail_out = out_buf_size - 1;
-
-    while (d_stream.total_out < out_buf_size - 1 && d_stream.total_in < in_size) {
-        // 执行解压缩操作
-        err = inflate(&d_stream, Z_NO_FLUSH);
+int gzip_stream_feed(gzip_stream_t *gs, const void *data, size_t len) {
+    if (len == 0) {
+        return Z_OK;
+    }
+    gs->total_in += len;
 
-        if (err == Z_STREAM_END) {
-            // 解压缩完成
-            break;
+    // 根据首字节判断是否为 GZIP 数据
+    if (!gs->detected) {
+        gs->detected = true;
+        gs->passthrough = (((const uint8_t *)data)[0] != 0x1f);
+        if (!gs->passthrough) {
+            if (gs->inited) {
+                // 复用已分配的窗口
+                inflateReset(&gs->zs);
+                s_stats.resets++;
+            } else {
+                int err = inflateInit2(&gs->zs, 16 + MAX_WBITS);
+                if (err != Z_OK) {
+                    ESP_LOGE(TAG, "inflateInit2 failed: %d", err);
+                    return err;
+                }
+                gs->inited = true;
+                s_stats.inits++;
+            }
         }
+    }
+
+    if (gs->passthrough) {
+        gs->total_out += len;
+        return gs->output_cb(gs->ctx, (const uint8_t *)data, len);
+    }
+
+    gs->zs.next_in = (Bytef *)data;
+    gs->zs.avail_in = len;
 
-        if (err != Z_OK) {
+    // 上一个 GZIP 成员已结束，跳过填充后继续解压下一个成员
+    if (gs->finished) {
+        if (!skip_padding(gs)) {
+            return Z_OK;
+        }
+        inflateReset(&gs->zs);
+        gs->finished = false;
+    }
+
+    do {
+        gs->zs.next_out = gs->out;
+        gs->zs.avail_out = sizeof(gs->out);
+
+        int64_t start_us = esp_timer_get_time();
+        int err = inflate(&gs->zs, Z_NO_FLUSH);
+        gs->inflate_us += esp_timer_get_time() - start_us;
+        if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR) {
             ESP_LOGE(TAG, "inflate failed: %d", err);
-            inflateEnd(&d_stream);
             return err;
         }
 
-        if (d_stream.avail_out == 0) {
-            ESP_LOGW(TAG, "Output buffer full during decompression");
-            break;
+        size_t produced = sizeof(gs->out) - gs->zs.avail_out;
+        if (produced > 0) {
+            gs->total_out += produced;
+            int ret = gs->output_cb(gs->ctx, gs->out, produced);
+            if (ret != Z_OK) {
+                return ret;
+            }
         }
 
-        if (d_stream.avail_in == 0 && d_stream.total_in < in_size) {
-            d_stream.avail_in = in_size - d_stream.total_in;
+        if (err == Z_STREAM_END) {
+            gs->finished = true;
+            if (!skip_padding(gs)) {
+                break;
+            }
+            inflateReset(&gs->zs);
+            gs->finished = false;
         }
+    } while (gs->zs.avail_in > 0 || gs->zs.avail_out == 0);
+
+    return Z_OK;
+}
+
+int gzip_stream_finish(gzip_stream_t *gs) {
+    if (!gs->detected || gs->passthrough) {
+        return Z_OK;
     }
+    if (!gs->finished) {
+        ESP_LOGE(TAG, "GZIP stream truncated (%u bytes in, %u bytes out)", (unsigned)gs->total_in,
+                 (unsigned)gs->total_out);
+        return Z_DATA_ERROR;
+    }
+    return Z_OK;
+}
 
-    // 清理解压缩流
-    err = inflateEnd(&d_stream);
-    if (err != Z_OK) {
-        ESP_LOGE(TAG, "inflateEnd failed: %d", err);
-        return err;
+void gzip_stream_deinit(gzip_stream_t *gs) {
+    if (gs->inited) {
+        inflateEnd(&gs->zs);
+        gs->inited = false;
     }
+}
 
-    // 记录解压缩结果
-    *out_size = d_stream.total_out;
-    ((char *)out_buf)[*out_size] = '\0';
+esp_err_t decompress_init(void) {
+    if (s_shared_mutex != NULL) {
+        return ESP_OK;
+    }
 
-    return Z_OK;
-}
\ No newline at end of file
+    // zlib 窗口在第一次解压 GZIP 数据时才分配，之后一直复用
+    s_shared = heap_caps_malloc(sizeof(gzip_stream_t), MALLOC_CAP_SPIRAM);
+    if (s_shared == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate decompressor");
+        return ESP_ERR_NO_MEM;
+    }
+    gzip_stream_init(s_shared, NULL, NULL);
+
+    s_shared_mutex = xSemaphoreCreateMutex();
+    if (s_shared_mutex == NULL) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        heap_caps_free(s_shared);
+        s_shared = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    return ESP_OK;
+}
+
+gzip_stream_t *gzip_stream_acquire(gzip_stream_output_cb_t output_cb, void *ctx) {
+    if (s_shared_mutex == NULL) {
+        ESP_LOGE(TAG, "Decompressor not initialized");
+        return NULL;
+    }
+
+    xSemaphoreTake(s_shared_mutex, portMAX_DELAY);
+    gzip_stream_reset(s_shared, output_cb, ctx);
+    return s_shared;
+}
+
+void gzip_stream_release(gzip_stream_t *gs, bool ok) {
+    if (gs == NULL || gs != s_shared) {
+        return;
+    }
+
+    if (gs->total_in > 0) {
+        s_stats.streams++;
+        s_stats.total_in += gs->total_in;
+        s_stats.total_out += gs->total_out;
+        s_stats.inflate_us += gs->inflate_us;
+        s_stats.last_in = (uint32_t)gs->total_in;
+        s_stats.last_out = (uint32_t)gs->total_out;
+        s_stats.last_us = gs->inflate_us;
+        if (!ok) {
+            s_stats.errors++;
+        }
+
+        if (!gs->passthrough) {
+            ESP_LOGI(TAG, "Inflated %u -> %u bytes (ratio %.2f) in %lld us",
+                     (unsigned)gs->total_in, (unsigned)gs->total_out,
+                     (double)gs->total_out / (double)gs->total_in, gs->inflate_us);
+        }
+    }
+
+    // 不在两次使用之间持有回调上下文
+    gs->output_cb = NULL;
+    gs->ctx = NULL;
+    xSemaphoreGive(s_shared_mutex);
+}
+
+void gzip_get_stats(gzip_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    if (s_shared_mutex == NULL) {
+        memset(stats, 0, sizeof(gzip_stats_t));
+        return;
+    }
+
+    // 统计只在持有共享解压器时更新
+    xSemaphoreTake(s_shared_mutex, portMAX_DELAY);
+    *stats = s_stats;
+    xSemaphoreGive(s_shared_mutex);
+}
@@ -9,228 +9,174 @@
  *
  * 该模块使用在线 API 服务进行查询，支持配置 API ID 和密钥。
  *
+ * 设备几乎不会移动，get_location_cached() 以接入点为键缓存定位结果（内存 + NVS），
+ * 只有接入点变化或缓存过期时才重新请求；配置了手动位置时完全不请求。
+ *
  * @author
  * @date YYYY-MM-DD
  */
 
-#include "cJSON.h"
-#include "esp_crt_bundle.h"
 #include "esp_err.h"
 #include "esp_heap_caps.h"
 #include "esp_http_client.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_wifi.h"
+#include "nvs.h"
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "config_manager.h"
+#include "http_pool.h"
 #include "ip_location.h"
+#include "json_bind.h"
+#include "json_stream.h"
+#include "metrics.h"
+#include "net_health.h"
 
 /** @brief 日志标签 */
 #define TAG "ip_location"
 
+/** @brief 位置缓存 NVS 命名空间与键 */
+#define LOCATION_CACHE_NVS_NAMESPACE "loc_cache"
+#define LOCATION_CACHE_NVS_KEY "entry"
+/** @brief 缓存结构版本，location_t 布局变化时递增 */
+#define LOCATION_CACHE_SCHEMA_VERSION 1
+/** @brief 默认缓存有效期（小时） */
+#define LOCATION_CACHE_DEFAULT_TTL_H 24
+/** @brief 早于该时间（2024-01-01）的系统时间视为尚未同步 */
+#define LOCATION_MIN_VALID_TIME 1704067200
+
+/** @brief location_t 字段表（根对象） */
+static const json_bind_field_t location_fields[] = {
+    JSON_BIND_FIELD_EX("code", JSON_BIND_INT, location_t, code, JSON_BIND_F_NUMBER_ONLY,
+                       JSON_BIND_NO_FLAG),
+    JSON_BIND_FIELD("zhou", JSON_BIND_STR, location_t, continent),
+    JSON_BIND_FIELD("zhoucode", JSON_BIND_STR, location_t, continent_code),
+    JSON_BIND_FIELD("guo", JSON_BIND_STR, location_t, country),
+    JSON_BIND_FIELD("guocode", JSON_BIND_STR, location_t, country_code),
+    JSON_BIND_FIELD("sheng", JSON_BIND_STR, location_t, province),
+    JSON_BIND_FIELD_EX("shengcode", JSON_BIND_INT, location_t, province_code,
+                       JSON_BIND_F_NONEMPTY, offsetof(location_t, has_province_code)),
+    JSON_BIND_FIELD("shi", JSON_BIND_STR, location_t, city),
+    JSON_BIND_FIELD_EX("shicode", JSON_BIND_INT, location_t, city_code, JSON_BIND_F_NONEMPTY,
+                       offsetof(location_t, has_city_code)),
+    JSON_BIND_FIELD_EX("qu", JSON_BIND_STR, location_t, district, 0,
+                       offsetof(location_t, has_district)),
+    JSON_BIND_FIELD_EX("qucode", JSON_BIND_INT, location_t, district_code, JSON_BIND_F_NONEMPTY,
+                       offsetof(location_t, has_district_code)),
+    JSON_BIND_FIELD("isp", JSON_BIND_STR, location_t, isp),
+    JSON_BIND_FIELD_EX("lat", JSON_BIND_DOUBLE, location_t, latitude, JSON_BIND_F_NONEMPTY,
+                       JSON_BIND_NO_FLAG),
+    JSON_BIND_FIELD_EX("lon", JSON_BIND_DOUBLE, location_t, longitude, JSON_BIND_F_NONEMPTY,
+                       JSON_BIND_NO_FLAG),
+    JSON_BIND_FIELD("msg", JSON_BIND_STR, location_t, message),
+    JSON_BIND_FIELD("ip", JSON_BIND_STR, location_t, ip),
+    JSON_BIND_FIELD("td", JSON_BIND_STR, location_t, td),
+};
+
+// 由 tools/gen_json_bind_hash.py 生成，修改 location_fields 后需重新生成
+// clang-format off
+#define LOCATION_SEED 0x00000001u
+static const int8_t location_slots[64] = {
+     3,  2, -1, -1, -1, -1, 14, -1,  7, -1, -1, -1, -1,  0, -1, -1,
+    -1, -1, -1, -1, 10, -1, -1, -1, 13, 15, -1, 11, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, 12, -1, -1,  9, -1, -1,  4, -1,  5,
+    -1, -1, -1, 16, -1,  1,  6, -1, -1, -1, -1, -1, -1, -1, -1,  8,
+};
+// clang-format on
+
+static const json_bind_desc_t location_desc = {
+    .name = "location",
+    .fields = location_fields,
+    .field_count = sizeof(location_fields) / sizeof(location_fields[0]),
+    .slots = location_slots,
+    .slot_mask = sizeof(location_slots) - 1,
+    .seed = LOCATION_SEED,
+};
+
 /**
- * @brief 解析 IP 定位 API 响应的 JSON 数据
- *
- * 将 JSON 响应解析为 location_t 结构体，提取所有地理位置信息。
- * 如果某些字段在 JSON 中不存在或类型不符合预期，则保持默认值。
- *
- * @param json JSON 响应字符串
- * @param location 输出参数，解析后的位置信息结构体
+ * @brief 单次定位请求的流式解析上下文
  */
-static void parse_location(const char *json, location_t *location) {
-    if (location == NULL) {
-        ESP_LOGE(TAG, "location pointer is NULL");
-        return;
-    }
-
-    // 解析 JSON 字符串
-    cJSON *root = cJSON_Parse(json);
-    if (root == NULL) {
-        ESP_LOGE(TAG, "Failed to parse JSON");
-        return;
-    }
-
-    // 初始化所有字段为零
-    memset(location, 0, sizeof(location_t));
-
-    // 提取各个字段信息
-    cJSON *item = NULL;
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "code");
-    if (item != NULL && cJSON_IsNumber(item)) {
-        location->code = item->valueint;
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "zhou");
-    if (item != NULL && cJSON_IsString(item) && item->valuestring) {
-        strncpy(location->continent, item->valuestring, sizeof(location->continent) - 1);
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "zhoucode");
-    if (item != NULL && cJSON_IsString(item) && item->valuestring) {
-        strncpy(location->continent_code, item->valuestring, sizeof(location->continent_code) - 1);
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "guo");
-    if (item != NULL && cJSON_IsString(item) && item->valuestring) {
-        strncpy(location->country, item->valuestring, sizeof(location->country) - 1);
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "guocode");
-    if (item != NULL && cJSON_IsString(item) && item->valuestring) {
-        strncpy(location->country_code, item->valuestring, sizeof(location->country_code) - 1);
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "sheng");
-    if (item != NULL && cJSON_IsString(item) && item->valuestring) {
-        strncpy(location->province, item->valuestring, sizeof(location->province) - 1);
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "shengcode");
-    if (item != NULL) {
-        if (cJSON_IsNumber(item)) {
-            location->province_code = item->valueint;
-            location->has_province_code = true;
-        } else if (cJSON_IsString(item) && item->valuestring && item->valuestring[0] != '\0') {
-            location->province_code = (int)strtol(item->valuestring, NULL, 10);
-            location->has_province_code = true;
-        }
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "shi");
-    if (item != NULL && cJSON_IsString(item) && item->valuestring) {
-        strncpy(location->city, item->valuestring, sizeof(location->city) - 1);
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "shicode");
-    if (item != NULL) {
-        if (cJSON_IsNumber(item)) {
-            location->city_code = item->valueint;
-            location->has_city_code = true;
-        } else if (cJSON_IsString(item) && item->valuestring && item->valuestring[0] != '\0') {
-            location->city_code = (int)strtol(item->valuestring, NULL, 10);
-            location->has_city_code = true;
-        }
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "qu");
-    if (item != NULL && cJSON_IsString(item) && item->valuestring) {
-        strncpy(location->district, item->valuestring, sizeof(location->district) - 1);
-        location->has_district = true;
-    }
+typedef struct {
+    location_t *location; /**< 输出结构体 */
+    bool received;        /**< 是否收到过响应数据 */
+    esp_err_t err;        /**< 解析过程中发生的第一个错误 */
+    json_bind_obj_t bind; /**< 根对象的绑定状态 */
+    json_stream_t json;   /**< 增量 JSON 解析器 */
+} location_request_t;
 
-    item = cJSON_GetObjectItemCaseSensitive(root, "qucode");
-    if (item != NULL) {
-        if (cJSON_IsNumber(item)) {
-            location->district_code = item->valueint;
-            location->has_district_code = true;
-        } else if (cJSON_IsString(item) && item->valuestring && item->valuestring[0] != '\0') {
-            location->district_code = (int)strtol(item->valuestring, NULL, 10);
-            location->has_district_code = true;
-        }
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "isp");
-    if (item != NULL && cJSON_IsString(item) && item->valuestring) {
-        strncpy(location->isp, item->valuestring, sizeof(location->isp) - 1);
-    }
+/**
+ * @brief JSON 对象开始回调：开始绑定根对象
+ */
+static void on_object_start(void *ctx, int depth, const char *key) {
+    location_request_t *req = (location_request_t *)ctx;
+    (void)key;
 
-    item = cJSON_GetObjectItemCaseSensitive(root, "lat");
-    if (item != NULL) {
-        if (cJSON_IsNumber(item)) {
-            location->latitude = item->valuedouble;
-        } else if (cJSON_IsString(item) && item->valuestring && item->valuestring[0] != '\0') {
-            location->latitude = strtod(item->valuestring, NULL);
-        }
+    if (depth == 0) {
+        json_bind_begin(&req->bind, &location_desc, req->location);
     }
+}
 
-    item = cJSON_GetObjectItemCaseSensitive(root, "lon");
-    if (item != NULL) {
-        if (cJSON_IsNumber(item)) {
-            location->longitude = item->valuedouble;
-        } else if (cJSON_IsString(item) && item->valuestring && item->valuestring[0] != '\0') {
-            location->longitude = strtod(item->valuestring, NULL);
-        }
-    }
+/**
+ * @brief JSON 对象结束回调：结束绑定根对象
+ */
+static void on_object_end(void *ctx, int depth) {
+    location_request_t *req = (location_request_t *)ctx;
 
-    item = cJSON_GetObjectItemCaseSensitive(root, "msg");
-    if (item != NULL && cJSON_IsString(item) && item->valuestring) {
-        strncpy(location->message, item->valuestring, sizeof(location->message) - 1);
+    if (depth == 0) {
+        json_bind_end(&req->bind);
     }
+}
 
-    item = cJSON_GetObjectItemCaseSensitive(root, "ip");
-    if (item != NULL && cJSON_IsString(item) && item->valuestring) {
-        strncpy(location->ip, item->valuestring, sizeof(location->ip) - 1);
-    }
+/**
+ * @brief JSON 标量值回调：将根对象字段写入 location_t
+ *
+ * 如果某些字段在 JSON 中不存在或类型不符合预期，则保持默认值。
+ */
+static void on_value(void *ctx, int depth, const char *key, json_stream_type_t type,
+                     const char *value, size_t len) {
+    location_request_t *req = (location_request_t *)ctx;
+    (void)len;
 
-    item = cJSON_GetObjectItemCaseSensitive(root, "td");
-    if (item != NULL && cJSON_IsString(item) && item->valuestring) {
-        strncpy(location->td, item->valuestring, sizeof(location->td) - 1);
+    if (depth == 1) {
+        json_bind_value(&req->bind, key, type, value);
     }
-
-    // 记录解析结果日志
-    ESP_LOGI(TAG, "Location: %s-%s-%s-%s-%s-%s", location->continent, location->country,
-             location->province, location->city, location->district, location->isp);
-
-    // 释放 JSON 对象
-    cJSON_Delete(root);
 }
 
+/** @brief 定位响应解析回调表 */
+static const json_stream_callbacks_t s_location_json_callbacks = {
+    .on_object_start = on_object_start,
+    .on_object_end = on_object_end,
+    .on_value = on_value,
+};
+
 /**
  * @brief HTTP 客户端事件处理回调函数
  *
- * 处理 HTTP 请求的各个阶段事件，包括数据接收、响应完成等。
- * 使用内存重新分配策略来接收完整的响应数据。
+ * 每收到一个数据块就立即交给增量 JSON 解析器，不缓存响应体。
  *
  * @param evt HTTP 客户端事件结构体
  * @return esp_err_t 错误码
  */
 static esp_err_t http_event_handler(esp_http_client_event_t *evt) {
-    // 使用静态变量缓存响应数据
-    static char *response_buf = NULL; /**< 响应数据缓冲区 */
-    static int total_len = 0;         /**< 已接收数据总长度 */
+    location_request_t *req = (location_request_t *)evt->user_data;
 
     switch (evt->event_id) {
-    case HTTP_EVENT_ON_HEADER:
-        // 在收到响应头时重置缓冲区
-        total_len = 0;
-        heap_caps_free(response_buf); // 释放之前分配的内存
-        response_buf = NULL;
-        break;
-
     case HTTP_EVENT_ON_DATA:
-        // 接收响应数据块
-        total_len += evt->data_len;
-        char *tmp = heap_caps_realloc(response_buf, total_len + 1, MALLOC_CAP_SPIRAM);
-        if (tmp == NULL) {
-            ESP_LOGE(TAG, "Failed to allocate memory for response buffer");
-            heap_caps_free(response_buf);
-            response_buf = NULL;
-            return ESP_ERR_NO_MEM;
+        // 非 200 响应（如错误页）不参与解析
+        if (esp_http_client_get_status_code(evt->client) != 200) {
+            break;
         }
-        response_buf = tmp;
-        memcpy(response_buf + total_len - evt->data_len, evt->data, evt->data_len);
-        response_buf[total_len] = '\0';
-        break;
-
-    case HTTP_EVENT_ON_FINISH:
-        // 响应接收完成
-        if (response_buf != NULL) {
-            // 复制数据到用户指定的指针
-            *(char **)evt->user_data = strdup(response_buf);
-            heap_caps_free(response_buf);
-            response_buf = NULL;
-            total_len = 0;
+        req->received = true;
+        if (req->err == ESP_OK &&
+            json_stream_feed(&req->json, evt->data, evt->data_len) != ESP_OK) {
+            req->err = ESP_ERR_INVALID_RESPONSE;
         }
         break;
 
-    case HTTP_EVENT_ERROR:
-    case HTTP_EVENT_DISCONNECTED:
-        heap_caps_free(response_buf);
-        response_buf = NULL;
-        total_len = 0;
-        break;
-
     default:
         break;
     }
@@ -249,7 +195,16 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt) {
  * @return esp_err_t 错误码，ESP_OK 表示成功
  */
 esp_err_t get_location(const char *ip, location_t *location) {
-    char *response_data = NULL;
+    if (location == NULL) {
+        ESP_LOGE(TAG, "location pointer is NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    static bool s_table_checked = false;
+    if (!s_table_checked) {
+        json_bind_verify(&location_desc);
+        s_table_checked = true;
+    }
 
     // 获取 API 配置
     sys_config_t config;
@@ -259,45 +214,259 @@ esp_err_t get_location(const char *ip, location_t *location) {
     const char *api_id = (config.ip_location.id[0] != '\0') ? config.ip_location.id : "88888888";
     const char *api_key = (config.ip_location.key[0] != '\0') ? config.ip_location.key : "88888888";
 
+    // 接口熔断中：不发请求，调用方退回缓存的位置
+    if (!net_health_allow(NET_EP_LOCATION)) {
+        ESP_LOGW(TAG, "Location endpoint circuit open, request skipped");
+        return ESP_ERR_NOT_ALLOWED;
+    }
+
+    // 接口地址可配置，去掉末尾的斜杠后拼接路径
+    const char *base = (config.ip_location.base_url[0] != '\0') ? config.ip_location.base_url
+                                                                : IP_LOCATION_DEFAULT_BASE_URL;
+    int base_len = strlen(base);
+    while (base_len > 0 && base[base_len - 1] == '/') {
+        base_len--;
+    }
+
     char url[256];
     snprintf(url, sizeof(url),
-             "https://cn.apihz.cn/api/ip/"
+             "%.*s/api/ip/"
              "chaapi.php?spm=a2c6h.12873639.article-detail.5.113a57d83nebvB&id=%s&key="
              "%s&ip=%s",
-             api_id, api_key, (ip != NULL) ? ip : "");
+             base_len, base, api_id, api_key, (ip != NULL) ? ip : "");
 
-    // 配置 HTTP 客户端
-    esp_http_client_config_t config_http = {.url = url,
-                                            .event_handler = http_event_handler,
-                                            .crt_bundle_attach = esp_crt_bundle_attach,
-                                            .user_data = &response_data};
+    location_request_t *req = heap_caps_calloc(1, sizeof(location_request_t), MALLOC_CAP_SPIRAM);
+    if (req == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate request context");
+        net_health_report(NET_EP_LOCATION, NET_FAIL_OTHER, 0);
+        return ESP_ERR_NO_MEM;
+    }
 
-    // 初始化 HTTP 客户端
-    esp_http_client_handle_t client = esp_http_client_init(&config_http);
+    // 初始化所有字段为零，解析过程中直接写入
+    memset(location, 0, sizeof(location_t));
+    req->location = location;
+    json_stream_init(&req->json, &s_location_json_callbacks, req);
+
+    // 从连接池获取 HTTP 客户端
+    esp_http_client_handle_t client = http_pool_acquire(url, http_event_handler, req);
+    if (client == NULL) {
+        heap_caps_free(req);
+        net_health_report(NET_EP_LOCATION, NET_FAIL_OTHER, 0);
+        return ESP_FAIL;
+    }
 
     // 执行 HTTP 请求
-    esp_err_t err = esp_http_client_perform(client);
+    int64_t start_us = esp_timer_get_time();
+    esp_err_t err = http_pool_perform(client);
+    metrics_observe(METRIC_HTTP_REQUEST, NET_EP_LOCATION, esp_timer_get_time() - start_us);
+    int status = esp_http_client_get_status_code(client);
+    net_fail_t fail = net_health_classify(client, err, status);
 
     if (err == ESP_OK) {
-        ESP_LOGI(TAG, "HTTPS Status = %d, content_length = %lld",
-                 esp_http_client_get_status_code(client),
+        ESP_LOGI(TAG, "HTTPS Status = %d, content_length = %lld", status,
                  esp_http_client_get_content_length(client));
     } else {
         ESP_LOGE(TAG, "HTTP request failed: %s", esp_err_to_name(err));
-        esp_http_client_cleanup(client);
+        http_pool_release(client);
+        heap_caps_free(req);
+        net_health_report(NET_EP_LOCATION, fail, 0);
         return err;
     }
 
-    esp_http_client_cleanup(client);
+    http_pool_release(client);
 
-    // 解析响应数据
-    if (response_data != NULL) {
-        parse_location(response_data, location);
-        free(response_data);
-    } else {
+    if (fail != NET_FAIL_NONE) {
+        ESP_LOGE(TAG, "Unexpected HTTP status %d", status);
+        err = ESP_ERR_INVALID_RESPONSE;
+    } else if (!req->received) {
         ESP_LOGE(TAG, "No response data received");
-        return ESP_ERR_INVALID_RESPONSE;
+        err = ESP_ERR_INVALID_RESPONSE;
+    } else if (req->err != ESP_OK || json_stream_finish(&req->json) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to parse JSON");
+        err = ESP_ERR_INVALID_RESPONSE;
+    } else {
+        // 记录解析结果日志
+        ESP_LOGI(TAG, "Location: %s-%s-%s-%s-%s-%s (bind %lld us)", location->continent,
+                 location->country, location->province, location->city, location->district,
+                 location->isp, req->bind.elapsed_us);
+    }
+
+    if (fail == NET_FAIL_NONE && err != ESP_OK) {
+        fail = NET_FAIL_PARSE;
     }
+    net_health_report(NET_EP_LOCATION, fail, status);
+
+    heap_caps_free(req);
+    return err;
+}
+
+// ============================================================================
+// 位置缓存
+// ============================================================================
+
+/**
+ * @brief 位置缓存条目
+ */
+typedef struct {
+    uint16_t schema;     /**< 结构版本 */
+    uint8_t bssid[6];    /**< 定位时连接的接入点 BSSID */
+    char ssid[33];       /**< 定位时连接的接入点 SSID */
+    int64_t resolved_at; /**< 定位时间，0 表示定位时系统时间未同步 */
+    location_t location; /**< 定位结果（含公网 IP） */
+} location_cache_entry_t;
+
+/** @brief 缓存条目（PSRAM），NULL 表示尚未从 NVS 加载 */
+static location_cache_entry_t *s_cache = NULL;
+/** @brief 缓存条目是否有效 */
+static bool s_cache_valid = false;
+/** @brief 是否已被要求失效 */
+static volatile bool s_cache_invalidated = false;
 
+/**
+ * @brief 从 NVS 加载缓存条目
+ */
+static void location_cache_load(void) {
+    s_cache = heap_caps_calloc(1, sizeof(location_cache_entry_t), MALLOC_CAP_SPIRAM);
+    if (s_cache == NULL) {
+        return;
+    }
+
+    nvs_handle_t nvs;
+    if (nvs_open(LOCATION_CACHE_NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return;
+    }
+    size_t length = sizeof(location_cache_entry_t);
+    esp_err_t err = nvs_get_blob(nvs, LOCATION_CACHE_NVS_KEY, s_cache, &length);
+    nvs_close(nvs);
+
+    s_cache_valid = (err == ESP_OK && length == sizeof(location_cache_entry_t) &&
+                     s_cache->schema == LOCATION_CACHE_SCHEMA_VERSION);
+    if (s_cache_valid) {
+        ESP_LOGI(TAG, "Loaded cached location: %s-%s (AP %s)", s_cache->location.city,
+                 s_cache->location.district, s_cache->ssid);
+    }
+}
+
+/**
+ * @brief 将缓存条目写入 NVS
+ */
+static void location_cache_save(void) {
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(LOCATION_CACHE_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, LOCATION_CACHE_NVS_KEY, s_cache, sizeof(location_cache_entry_t));
+        if (err == ESP_OK) {
+            err = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to save location cache: %s", esp_err_to_name(err));
+    }
+}
+
+/**
+ * @brief 用手动配置的位置填充 location_t
+ *
+ * @return true 已配置手动位置
+ */
+static bool manual_location(const sys_config_t *config, location_t *location) {
+    if (!config->location.manual) {
+        return false;
+    }
+    if (config->location.latitude == 0 && config->location.longitude == 0) {
+        ESP_LOGW(TAG, "Manual location enabled but coordinates are not set, using IP lookup");
+        return false;
+    }
+
+    memset(location, 0, sizeof(location_t));
+    const char *name = (config->location.name[0] != '\0') ? config->location.name : "未知";
+    snprintf(location->city, sizeof(location->city), "%s", name);
+    snprintf(location->message, sizeof(location->message), "%s", name);
+    location->latitude = config->location.latitude;
+    location->longitude = config->location.longitude;
+    return true;
+}
+
+esp_err_t get_location_cached(location_t *location, bool *from_cache) {
+    if (location == NULL) {
+        ESP_LOGE(TAG, "location pointer is NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (from_cache != NULL) {
+        *from_cache = true;
+    }
+
+    sys_config_t config;
+    config_manager_get_config(&config);
+
+    // 手动位置：不发起定位请求
+    if (manual_location(&config, location)) {
+        ESP_LOGD(TAG, "Using manual location: %s", location->city);
+        return ESP_OK;
+    }
+
+    if (s_cache == NULL) {
+        location_cache_load();
+    }
+    if (s_cache_invalidated) {
+        s_cache_invalidated = false;
+        s_cache_valid = false;
+    }
+
+    // 当前网络标识
+    wifi_ap_record_t ap_info = {0};
+    bool have_ap = (esp_wifi_sta_get_ap_info(&ap_info) == ESP_OK);
+
+    int ttl_hours = (config.location.cache_ttl_hours > 0) ? config.location.cache_ttl_hours
+                                                          : LOCATION_CACHE_DEFAULT_TTL_H;
+    time_t now = time(NULL);
+
+    if (s_cache != NULL && s_cache_valid && have_ap) {
+        bool same_ap = memcmp(s_cache->bssid, ap_info.bssid, sizeof(s_cache->bssid)) == 0 &&
+                       strcmp(s_cache->ssid, (const char *)ap_info.ssid) == 0;
+        // 系统时间未同步时无法判断缓存时长，接入点相同即沿用
+        bool expired = now >= LOCATION_MIN_VALID_TIME &&
+                       (s_cache->resolved_at < LOCATION_MIN_VALID_TIME ||
+                        now - s_cache->resolved_at > (int64_t)ttl_hours * 3600);
+
+        if (same_ap && !expired) {
+            memcpy(location, &s_cache->location, sizeof(location_t));
+            ESP_LOGI(TAG, "Location cache hit: %s-%s (IP %s)", location->city,
+                     location->district, location->ip);
+            return ESP_OK;
+        }
+        ESP_LOGI(TAG, "Location cache %s, resolving", same_ap ? "expired" : "AP changed");
+    }
+
+    if (from_cache != NULL) {
+        *from_cache = false;
+    }
+    esp_err_t err = get_location(NULL, location);
+
+    if (err != ESP_OK) {
+        // 定位失败时退回上一次的结果（位置很少变化）
+        if (s_cache != NULL && s_cache_valid) {
+            ESP_LOGW(TAG, "Location lookup failed, using cached location");
+            memcpy(location, &s_cache->location, sizeof(location_t));
+            if (from_cache != NULL) {
+                *from_cache = true;
+            }
+            return ESP_OK;
+        }
+        return err;
+    }
+
+    if (s_cache != NULL && have_ap) {
+        s_cache->schema = LOCATION_CACHE_SCHEMA_VERSION;
+        memcpy(s_cache->bssid, ap_info.bssid, sizeof(s_cache->bssid));
+        snprintf(s_cache->ssid, sizeof(s_cache->ssid), "%s", (const char *)ap_info.ssid);
+        s_cache->resolved_at = (now >= LOCATION_MIN_VALID_TIME) ? (int64_t)now : 0;
+        memcpy(&s_cache->location, location, sizeof(location_t));
+        s_cache_valid = true;
+        location_cache_save();
+    }
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+void location_cache_invalidate(void) { s_cache_invalidated = true; }
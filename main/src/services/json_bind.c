@@ -0,0 +1,225 @@
+/**
+ * @file json_bind.c
+ * @brief 表驱动的 JSON 字段到结构体绑定实现
+ *
+ * 数值字段同时接受 JSON 数字和字符串形式（接口返回的数值多为字符串），
+ * 转换规则与原先逐字段解析的代码保持一致：数字按 double 解析后截断取整并饱和到 int 范围，
+ * 字符串按 strtol / strtod 解析。
+ */
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "json_bind.h"
+
+#define TAG "json_bind"
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+/**
+ * @brief 按完美哈希查找字段
+ *
+ * @return 字段描述，未命中返回 NULL
+ */
+static const json_bind_field_t *lookup(const json_bind_desc_t *desc, const char *key) {
+    int8_t idx = desc->slots[json_bind_hash(key, desc->seed) & desc->slot_mask];
+    if (idx < 0) {
+        return NULL;
+    }
+    const json_bind_field_t *field = &desc->fields[idx];
+    return (strcmp(field->key, key) == 0) ? field : NULL;
+}
+
+/**
+ * @brief 与 cJSON 的 valueint 一致：截断取整并饱和到 int 范围
+ */
+static int number_to_int(double d) {
+    if (d >= INT_MAX) {
+        return INT_MAX;
+    }
+    if (d <= (double)INT_MIN) {
+        return INT_MIN;
+    }
+    return (int)d;
+}
+
+/**
+ * @brief 按成员大小写入整数
+ */
+static void store_int(void *dst, uint16_t size, int v) {
+    switch (size) {
+    case 1: {
+        uint8_t u8 = (uint8_t)v;
+        memcpy(dst, &u8, 1);
+        break;
+    }
+    case 2: {
+        uint16_t u16 = (uint16_t)v;
+        memcpy(dst, &u16, 2);
+        break;
+    }
+    default: {
+        int32_t i32 = (int32_t)v;
+        memcpy(dst, &i32, 4);
+        break;
+    }
+    }
+}
+
+/**
+ * @brief 解析 ISO 8601 本地时间（如 "2026-01-29T00:48+08:00"，时区部分忽略）
+ *
+ * @return 时间戳，解析失败返回 0
+ */
+static time_t parse_iso8601(const char *value) {
+    struct tm tm = {0};
+    // 解析ISO 8601时间格式: YYYY-MM-DDTHH:MM+TZ:TZ
+    if (sscanf(value, "%d-%d-%dT%d:%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &tm.tm_hour,
+               &tm.tm_min) == 5) {
+        tm.tm_year -= 1900; // tm_year是从1900年开始
+        tm.tm_mon -= 1;     // tm_mon是0-11
+        tm.tm_sec = 0;
+        tm.tm_isdst = -1; // 让系统自动判断是否夏令时
+        time_t t = mktime(&tm);
+        ESP_LOGD(TAG, "Parsed time: %s -> timestamp: %ld", value, (long)t);
+        return t;
+    }
+    ESP_LOGW(TAG, "Failed to parse time: %s", value);
+    return 0;
+}
+
+/**
+ * @brief 按字段描述转换并写入一个值
+ *
+ * @return true 已写入，false 表示值类型与字段不匹配
+ */
+static bool bind_field(const json_bind_field_t *field, void *base, json_stream_type_t type,
+                       const char *value) {
+    uint8_t *dst = (uint8_t *)base + field->offset;
+    bool is_number = (type == JSON_STREAM_NUMBER);
+    bool is_string = (type == JSON_STREAM_STRING);
+
+    // 字符串形式的数值
+    bool numeric_string = is_string && !(field->flags & JSON_BIND_F_NUMBER_ONLY) &&
+                          !((field->flags & JSON_BIND_F_NONEMPTY) && value[0] == '\0');
+
+    switch (field->type) {
+    case JSON_BIND_STR:
+        if (!is_string) {
+            return false;
+        }
+        strncpy((char *)dst, value, field->size - 1);
+        dst[field->size - 1] = '\0';
+        break;
+
+    case JSON_BIND_INT:
+        if (is_number) {
+            store_int(dst, field->size, number_to_int(strtod(value, NULL)));
+        } else if (numeric_string) {
+            store_int(dst, field->size, (int)strtol(value, NULL, 10));
+        } else {
+            return false;
+        }
+        break;
+
+    case JSON_BIND_FLOAT:
+    case JSON_BIND_DOUBLE: {
+        if (!is_number && !numeric_string) {
+            return false;
+        }
+        double d = strtod(value, NULL);
+        if (field->type == JSON_BIND_FLOAT) {
+            float f = (float)d;
+            memcpy(dst, &f, sizeof(f));
+        } else {
+            memcpy(dst, &d, sizeof(d));
+        }
+        break;
+    }
+
+    case JSON_BIND_TIME: {
+        if (!is_string) {
+            return false;
+        }
+        time_t t = parse_iso8601(value);
+        memcpy(dst, &t, sizeof(t));
+        break;
+    }
+
+    default:
+        return false;
+    }
+
+    if (field->flag_offset != JSON_BIND_NO_FLAG) {
+        *((bool *)((uint8_t *)base + field->flag_offset)) = true;
+    }
+    return true;
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+uint32_t json_bind_hash(const char *key, uint32_t seed) {
+    // FNV-1a，以种子作为初始值
+    uint32_t h = seed;
+    while (*key != '\0') {
+        h ^= (uint8_t)*key++;
+        h *= 16777619u;
+    }
+    // 乘法只向高位扩散，把高位折叠到低位后再取槽号
+    return h ^ (h >> 16);
+}
+
+esp_err_t json_bind_verify(const json_bind_desc_t *desc) {
+    esp_err_t ret = ESP_OK;
+    for (uint8_t i = 0; i < desc->field_count; i++) {
+        if (lookup(desc, desc->fields[i].key) != &desc->fields[i]) {
+            ESP_LOGE(TAG, "%s: key '%s' not reachable, regenerate hash slots", desc->name,
+                     desc->fields[i].key);
+            ret = ESP_ERR_INVALID_STATE;
+        }
+    }
+    return ret;
+}
+
+void json_bind_begin(json_bind_obj_t *obj, const json_bind_desc_t *desc, void *base) {
+    obj->desc = desc;
+    obj->base = base;
+    obj->bound = 0;
+    obj->elapsed_us = 0;
+}
+
+bool json_bind_value(json_bind_obj_t *obj, const char *key, json_stream_type_t type,
+                     const char *value) {
+    if (obj->desc == NULL || key == NULL) {
+        return false;
+    }
+
+    int64_t start = esp_timer_get_time();
+    const json_bind_field_t *field = lookup(obj->desc, key);
+    bool bound = (field != NULL) && bind_field(field, obj->base, type, value);
+    obj->elapsed_us += esp_timer_get_time() - start;
+
+    if (bound) {
+        obj->bound++;
+    }
+    return bound;
+}
+
+int64_t json_bind_end(json_bind_obj_t *obj) {
+    if (obj->desc == NULL) {
+        return 0;
+    }
+    ESP_LOGD(TAG, "%s: %u/%u fields bound in %lld us", obj->desc->name, obj->bound,
+             obj->desc->field_count, obj->elapsed_us);
+    obj->desc = NULL;
+    return obj->elapsed_us;
+}
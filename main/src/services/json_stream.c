@@ -0,0 +1,430 @@
+/**
+ * @file json_stream.c
+ * @brief 增量式（SAX 风格）JSON 解析器实现
+ *
+ * 基于字符状态机，输入可在任意字节处被切分（包括字符串转义序列和 UTF-8 多字节字符的中间）。
+ * 只保存当前键名和当前标量值，不保存已解析的内容。
+ */
+
+#include "esp_log.h"
+#include <string.h>
+
+#include "json_stream.h"
+
+#define TAG "json_stream"
+
+/**
+ * @brief 解析器状态
+ */
+enum {
+    JS_STATE_VALUE,          ///< 期望一个值
+    JS_STATE_VALUE_OR_END,   ///< 数组开始后，期望一个值或 ']'
+    JS_STATE_AFTER_VALUE,    ///< 值之后，期望 ',' 或闭合符
+    JS_STATE_KEY_OR_END,     ///< 对象开始后，期望键名或 '}'
+    JS_STATE_KEY,            ///< 逗号之后，期望键名
+    JS_STATE_COLON,          ///< 键名之后，期望 ':'
+    JS_STATE_STRING,         ///< 字符串内部
+    JS_STATE_STRING_ESC,     ///< 字符串转义符之后
+    JS_STATE_STRING_UNICODE, ///< \\uXXXX 内部
+    JS_STATE_LITERAL,        ///< 数字 / true / false / null
+    JS_STATE_DONE,           ///< 根值已结束
+    JS_STATE_ERROR,          ///< 出错
+};
+
+static inline bool is_ws(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+static inline bool in_object(const json_stream_t *js) {
+    return js->depth > 0 && js->stack[js->depth - 1] == '{';
+}
+
+static inline const char *current_key(const json_stream_t *js) {
+    return (in_object(js) && js->has_key) ? js->key : NULL;
+}
+
+/**
+ * @brief 向当前字符串（键名或值）追加一个字节，超出容量时截断
+ */
+static void append_byte(json_stream_t *js, char c) {
+    if (js->parsing_key) {
+        if (js->key_len < JSON_STREAM_KEY_MAX - 1) {
+            js->key[js->key_len++] = c;
+        } else {
+            js->truncated = true;
+        }
+    } else {
+        if (js->value_len < JSON_STREAM_VALUE_MAX - 1) {
+            js->value[js->value_len++] = c;
+        } else {
+            js->truncated = true;
+        }
+    }
+}
+
+/**
+ * @brief 以 UTF-8 编码追加一个 Unicode 码点
+ */
+static void append_codepoint(json_stream_t *js, uint32_t cp) {
+    if (cp < 0x80) {
+        append_byte(js, (char)cp);
+    } else if (cp < 0x800) {
+        append_byte(js, (char)(0xC0 | (cp >> 6)));
+        append_byte(js, (char)(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        append_byte(js, (char)(0xE0 | (cp >> 12)));
+        append_byte(js, (char)(0x80 | ((cp >> 6) & 0x3F)));
+        append_byte(js, (char)(0x80 | (cp & 0x3F)));
+    } else {
+        append_byte(js, (char)(0xF0 | (cp >> 18)));
+        append_byte(js, (char)(0x80 | ((cp >> 12) & 0x3F)));
+        append_byte(js, (char)(0x80 | ((cp >> 6) & 0x3F)));
+        append_byte(js, (char)(0x80 | (cp & 0x3F)));
+    }
+}
+
+/**
+ * @brief 一个值（标量或容器）结束后的状态转移
+ */
+static void value_done(json_stream_t *js) {
+    js->has_key = false;
+    js->state = (js->depth == 0) ? JS_STATE_DONE : JS_STATE_AFTER_VALUE;
+}
+
+/**
+ * @brief 报告一个标量值
+ */
+static void emit_value(json_stream_t *js, json_stream_type_t type) {
+    js->value[js->value_len] = '\0';
+    if (js->cb->on_value) {
+        js->cb->on_value(js->ctx, js->depth, current_key(js), type, js->value, js->value_len);
+    }
+    value_done(js);
+}
+
+/**
+ * @brief 结束字面量（数字 / true / false / null）
+ * @return true 字面量合法
+ */
+static bool finish_literal(json_stream_t *js) {
+    js->value[js->value_len] = '\0';
+    json_stream_type_t type;
+    if (strcmp(js->value, "true") == 0 || strcmp(js->value, "false") == 0) {
+        type = JSON_STREAM_BOOL;
+    } else if (strcmp(js->value, "null") == 0) {
+        type = JSON_STREAM_NULL;
+    } else if (js->value[0] == '-' || (js->value[0] >= '0' && js->value[0] <= '9')) {
+        type = JSON_STREAM_NUMBER;
+    } else {
+        return false;
+    }
+    emit_value(js, type);
+    return true;
+}
+
+/**
+ * @brief 开始一个容器（对象或数组）
+ * @return true 成功，false 表示嵌套过深
+ */
+static bool open_container(json_stream_t *js, char kind) {
+    if (js->depth >= JSON_STREAM_MAX_DEPTH) {
+        return false;
+    }
+    const char *key = current_key(js);
+    if (kind == '{') {
+        if (js->cb->on_object_start) {
+            js->cb->on_object_start(js->ctx, js->depth, key);
+        }
+    } else if (js->cb->on_array_start) {
+        js->cb->on_array_start(js->ctx, js->depth, key);
+    }
+    js->stack[js->depth++] = kind;
+    js->has_key = false;
+    js->state = (kind == '{') ? JS_STATE_KEY_OR_END : JS_STATE_VALUE_OR_END;
+    return true;
+}
+
+/**
+ * @brief 结束当前容器
+ * @return true 成功，false 表示闭合符不匹配
+ */
+static bool close_container(json_stream_t *js, char kind) {
+    if (js->depth == 0 || js->stack[js->depth - 1] != kind) {
+        return false;
+    }
+    js->depth--;
+    if (kind == '{') {
+        if (js->cb->on_object_end) {
+            js->cb->on_object_end(js->ctx, js->depth);
+        }
+    } else if (js->cb->on_array_end) {
+        js->cb->on_array_end(js->ctx, js->depth);
+    }
+    value_done(js);
+    return true;
+}
+
+/**
+ * @brief 开始一个字符串（键名或值）
+ */
+static void begin_string(json_stream_t *js, bool is_key) {
+    js->parsing_key = is_key;
+    if (is_key) {
+        js->key_len = 0;
+    } else {
+        js->value_len = 0;
+    }
+    js->high_surrogate = 0;
+    js->state = JS_STATE_STRING;
+}
+
+/**
+ * @brief 处理 \\uXXXX 解码得到的 UTF-16 码元
+ */
+static void handle_utf16_unit(json_stream_t *js, uint32_t unit) {
+    if (unit >= 0xD800 && unit <= 0xDBFF) {
+        if (js->high_surrogate) {
+            append_codepoint(js, 0xFFFD);
+        }
+        js->high_surrogate = unit;
+        return;
+    }
+    if (unit >= 0xDC00 && unit <= 0xDFFF) {
+        if (js->high_surrogate) {
+            uint32_t cp = 0x10000 + ((js->high_surrogate - 0xD800) << 10) + (unit - 0xDC00);
+            js->high_surrogate = 0;
+            append_codepoint(js, cp);
+        } else {
+            append_codepoint(js, 0xFFFD);
+        }
+        return;
+    }
+    if (js->high_surrogate) {
+        js->high_surrogate = 0;
+        append_codepoint(js, 0xFFFD);
+    }
+    append_codepoint(js, unit);
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief 处理一个输入字节
+ * @return true 字节已消费，false 表示需要在新状态下重新处理同一字节
+ */
+static bool step(json_stream_t *js, char c) {
+    switch (js->state) {
+    case JS_STATE_VALUE_OR_END:
+        if (c == ']') {
+            if (!close_container(js, '[')) {
+                js->state = JS_STATE_ERROR;
+            }
+            return true;
+        }
+        // fallthrough
+    case JS_STATE_VALUE:
+        if (is_ws(c)) {
+            return true;
+        }
+        if (c == '{' || c == '[') {
+            if (!open_container(js, c)) {
+                js->state = JS_STATE_ERROR;
+            }
+        } else if (c == '"') {
+            begin_string(js, false);
+        } else if (c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n') {
+            js->value_len = 0;
+            js->parsing_key = false;
+            append_byte(js, c);
+            js->state = JS_STATE_LITERAL;
+        } else {
+            js->state = JS_STATE_ERROR;
+        }
+        return true;
+
+    case JS_STATE_AFTER_VALUE:
+        if (is_ws(c)) {
+            return true;
+        }
+        if (c == ',') {
+            js->state = in_object(js) ? JS_STATE_KEY : JS_STATE_VALUE;
+        } else if (c == '}' || c == ']') {
+            if (!close_container(js, c == '}' ? '{' : '[')) {
+                js->state = JS_STATE_ERROR;
+            }
+        } else {
+            js->state = JS_STATE_ERROR;
+        }
+        return true;
+
+    case JS_STATE_KEY_OR_END:
+        if (c == '}') {
+            if (!close_container(js, '{')) {
+                js->state = JS_STATE_ERROR;
+            }
+            return true;
+        }
+        // fallthrough
+    case JS_STATE_KEY:
+        if (is_ws(c)) {
+            return true;
+        }
+        if (c == '"') {
+            begin_string(js, true);
+        } else {
+            js->state = JS_STATE_ERROR;
+        }
+        return true;
+
+    case JS_STATE_COLON:
+        if (is_ws(c)) {
+            return true;
+        }
+        js->state = (c == ':') ? JS_STATE_VALUE : JS_STATE_ERROR;
+        return true;
+
+    case JS_STATE_STRING:
+        if (c == '"') {
+            if (js->high_surrogate) {
+                js->high_surrogate = 0;
+                append_codepoint(js, 0xFFFD);
+            }
+            if (js->parsing_key) {
+                js->key[js->key_len] = '\0';
+                js->has_key = true;
+                js->state = JS_STATE_COLON;
+            } else {
+                emit_value(js, JSON_STREAM_STRING);
+            }
+        } else if (c == '\\') {
+            js->state = JS_STATE_STRING_ESC;
+        } else if ((unsigned char)c < 0x20) {
+            js->state = JS_STATE_ERROR;
+        } else {
+            append_byte(js, c);
+        }
+        return true;
+
+    case JS_STATE_STRING_ESC:
+        js->state = JS_STATE_STRING;
+        switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+            append_byte(js, c);
+            break;
+        case 'b':
+            append_byte(js, '\b');
+            break;
+        case 'f':
+            append_byte(js, '\f');
+            break;
+        case 'n':
+            append_byte(js, '\n');
+            break;
+        case 'r':
+            append_byte(js, '\r');
+            break;
+        case 't':
+            append_byte(js, '\t');
+            break;
+        case 'u':
+            js->unicode = 0;
+            js->unicode_digits = 0;
+            js->state = JS_STATE_STRING_UNICODE;
+            break;
+        default:
+            js->state = JS_STATE_ERROR;
+            break;
+        }
+        return true;
+
+    case JS_STATE_STRING_UNICODE: {
+        int v = hex_value(c);
+        if (v < 0) {
+            js->state = JS_STATE_ERROR;
+            return true;
+        }
+        js->unicode = (js->unicode << 4) | (uint32_t)v;
+        if (++js->unicode_digits == 4) {
+            handle_utf16_unit(js, js->unicode);
+            js->state = JS_STATE_STRING;
+        }
+        return true;
+    }
+
+    case JS_STATE_LITERAL:
+        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '.' || c == '-' ||
+            c == '+' || c == 'E') {
+            append_byte(js, c);
+            return true;
+        }
+        if (!finish_literal(js)) {
+            js->state = JS_STATE_ERROR;
+            return true;
+        }
+        // 分隔符需要在新状态下重新处理
+        return false;
+
+    case JS_STATE_DONE:
+        if (!is_ws(c)) {
+            js->state = JS_STATE_ERROR;
+        }
+        return true;
+
+    default:
+        return true;
+    }
+}
+
+void json_stream_init(json_stream_t *js, const json_stream_callbacks_t *cb, void *ctx) {
+    static const json_stream_callbacks_t no_callbacks = {0};
+    memset(js, 0, sizeof(json_stream_t));
+    js->cb = (cb != NULL) ? cb : &no_callbacks;
+    js->ctx = ctx;
+    js->state = JS_STATE_VALUE;
+}
+
+esp_err_t json_stream_feed(json_stream_t *js, const char *data, size_t len) {
+    size_t i = 0;
+    while (i < len) {
+        if (js->state == JS_STATE_ERROR) {
+            ESP_LOGE(TAG, "JSON syntax error at offset %u", (unsigned)js->offset);
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        if (step(js, data[i])) {
+            i++;
+            js->offset++;
+        }
+    }
+    if (js->state == JS_STATE_ERROR) {
+        ESP_LOGE(TAG, "JSON syntax error at offset %u", (unsigned)js->offset);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    return ESP_OK;
+}
+
+esp_err_t json_stream_finish(json_stream_t *js) {
+    // 根值为数字时，只能在输入结束时确定其结束位置
+    if (js->state == JS_STATE_LITERAL && js->depth == 0) {
+        if (!finish_literal(js)) {
+            js->state = JS_STATE_ERROR;
+        }
+    }
+    if (js->state != JS_STATE_DONE) {
+        ESP_LOGE(TAG, "Incomplete JSON document (state=%d, depth=%d, %u bytes)", js->state,
+                 js->depth, (unsigned)js->offset);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    if (js->truncated) {
+        ESP_LOGW(TAG, "Some keys or values were truncated");
+    }
+    return ESP_OK;
+}
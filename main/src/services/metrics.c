@@ -0,0 +1,299 @@
+/**
+ * @file metrics.c
+ * @brief 运行时指标（计数器、仪表、固定分桶直方图）
+ *
+ * 直方图的每个分桶是一个 32 位原子计数（非累积，导出时累加），耗时总和拆成高低两个 32 位原子量：
+ * 低位溢出的那次加法负责给高位进位。读取时前后两次读高位不一致则重读。
+ * ESP32-S3 上 32 位原子操作由 S32C1I 指令实现，不需要临界区。
+ */
+
+#include "metrics.h"
+
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <sys/param.h>
+
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "net_health.h"
+
+#define TAG "metrics"
+
+/** @brief 指标名前缀 */
+#define METRIC_PREFIX "espaper_"
+/** @brief 单行输出的最大长度 */
+#define METRIC_LINE_MAX 192
+/** @brief 读取耗时总和时的最大重试次数 */
+#define SUM_READ_RETRIES 4
+
+#define COUNT_OF(a) ((int)(sizeof(a) / sizeof((a)[0])))
+
+/** @brief 直方图分桶上边界（微秒），最后还有一个 +Inf 桶 */
+static const uint32_t s_bounds_us[] = {
+    100,    250,    500,     1000,    2500,    5000,    10000,   25000,
+    50000,  100000, 250000,  500000,  1000000, 2500000, 5000000, 10000000,
+};
+#define BUCKET_COUNT (COUNT_OF(s_bounds_us) + 1)
+
+/**
+ * @brief 指标类型
+ */
+typedef enum {
+    METRIC_TYPE_COUNTER,
+    METRIC_TYPE_GAUGE,
+    METRIC_TYPE_HISTOGRAM,
+} metric_type_t;
+
+/**
+ * @brief 直方图存储
+ */
+typedef struct {
+    atomic_uint_least32_t buckets[BUCKET_COUNT]; ///< 各桶计数（非累积）
+    atomic_uint_least32_t sum_lo;                ///< 耗时总和（微秒）低 32 位
+    atomic_uint_least32_t sum_hi;                ///< 耗时总和（微秒）高 32 位
+} histogram_t;
+
+/**
+ * @brief 指标描述
+ */
+typedef struct {
+    const char *name;                ///< 名称（不含前缀）
+    const char *help;                ///< 说明
+    metric_type_t type;              ///< 类型
+    const char *label;               ///< 标签名，无标签时为 NULL
+    const char *const *label_values; ///< 各实例的标签值
+    uint8_t instances;               ///< 实例数
+    histogram_t *hist;               ///< 直方图存储（type 为直方图时）
+    atomic_uint_least32_t *value;    ///< 计数器或仪表存储
+} metric_desc_t;
+
+// ============================================================================
+// 私有变量
+// ============================================================================
+
+/** @brief 标签值 */
+static const char *const s_refresh_modes[] = {"full", "partial"};
+static const char *const s_endpoints[] = {"weather", "location", "yiyan"};
+static const char *const s_regions[] = {"internal", "psram"};
+static const char *const s_tasks[] = {"lvgl_task", "lvgl_refresh", "net_sched",
+                                      "httpd",     "mqtt_task",    "tiT",
+                                      "esp_timer", "sys_evt"};
+
+_Static_assert(COUNT_OF(s_endpoints) == NET_EP_COUNT, "s_endpoints must match net_endpoint_t");
+
+/** @brief 指标存储 */
+static histogram_t s_lv_timer;
+static histogram_t s_ui_tick;
+static histogram_t s_disp_flush;
+static histogram_t s_epd_transfer;
+static histogram_t s_epd_busy;
+static histogram_t s_http[NET_EP_COUNT];
+static atomic_uint_least32_t s_epd_refresh[COUNT_OF(s_refresh_modes)];
+static atomic_uint_least32_t s_heap_free[COUNT_OF(s_regions)];
+static atomic_uint_least32_t s_heap_largest[COUNT_OF(s_regions)];
+static atomic_uint_least32_t s_heap_min_free[COUNT_OF(s_regions)];
+static atomic_uint_least32_t s_stack_free[COUNT_OF(s_tasks)];
+
+/** @brief 指标登记表 */
+static const metric_desc_t s_metrics[METRIC_COUNT] = {
+    [METRIC_LV_TIMER] = {"lvgl_timer_handler_seconds", "Duration of one lv_timer_handler call",
+                         METRIC_TYPE_HISTOGRAM, NULL, NULL, 1, &s_lv_timer, NULL},
+    [METRIC_UI_TICK] = {"ui_tick_seconds", "Duration of one ui_tick call", METRIC_TYPE_HISTOGRAM,
+                        NULL, NULL, 1, &s_ui_tick, NULL},
+    [METRIC_DISP_FLUSH] = {"disp_flush_seconds", "Duration of disp_flush including dithering",
+                           METRIC_TYPE_HISTOGRAM, NULL, NULL, 1, &s_disp_flush, NULL},
+    [METRIC_EPD_TRANSFER] = {"epd_transfer_seconds", "Bitmap transfer time per panel refresh",
+                             METRIC_TYPE_HISTOGRAM, NULL, NULL, 1, &s_epd_transfer, NULL},
+    [METRIC_EPD_BUSY] = {"epd_busy_wait_seconds", "Panel BUSY wait time per panel refresh",
+                         METRIC_TYPE_HISTOGRAM, NULL, NULL, 1, &s_epd_busy, NULL},
+    [METRIC_EPD_REFRESH] = {"epd_refresh_total", "Panel refreshes", METRIC_TYPE_COUNTER, "mode",
+                            s_refresh_modes, COUNT_OF(s_refresh_modes), NULL, s_epd_refresh},
+    [METRIC_HTTP_REQUEST] = {"http_request_seconds", "Upstream HTTP request duration",
+                             METRIC_TYPE_HISTOGRAM, "endpoint", s_endpoints, NET_EP_COUNT, s_http,
+                             NULL},
+    [METRIC_HEAP_FREE] = {"heap_free_bytes", "Free heap", METRIC_TYPE_GAUGE, "region", s_regions,
+                          COUNT_OF(s_regions), NULL, s_heap_free},
+    [METRIC_HEAP_LARGEST] = {"heap_largest_free_block_bytes", "Largest free heap block",
+                             METRIC_TYPE_GAUGE, "region", s_regions, COUNT_OF(s_regions), NULL,
+                             s_heap_largest},
+    [METRIC_HEAP_MIN_FREE] = {"heap_min_free_bytes", "Lowest free heap since boot",
+                              METRIC_TYPE_GAUGE, "region", s_regions, COUNT_OF(s_regions), NULL,
+                              s_heap_min_free},
+    [METRIC_STACK_FREE] = {"task_stack_high_water_bytes", "Minimum free stack of a task",
+                           METRIC_TYPE_GAUGE, "task", s_tasks, COUNT_OF(s_tasks), NULL,
+                           s_stack_free},
+};
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+static bool valid(metric_id_t id, uint8_t index, metric_type_t type) {
+    return id < METRIC_COUNT && s_metrics[id].type == type && index < s_metrics[id].instances;
+}
+
+/**
+ * @brief 读取直方图的耗时总和（微秒）
+ */
+static uint64_t read_sum(histogram_t *h) {
+    uint32_t hi, lo;
+    for (int i = 0; i < SUM_READ_RETRIES; i++) {
+        hi = atomic_load_explicit(&h->sum_hi, memory_order_relaxed);
+        lo = atomic_load_explicit(&h->sum_lo, memory_order_relaxed);
+        if (atomic_load_explicit(&h->sum_hi, memory_order_relaxed) == hi) {
+            break;
+        }
+    }
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/**
+ * @brief 采样堆内存与任务栈高水位
+ */
+static void collect_gauges(void) {
+    static const uint32_t caps[] = {MALLOC_CAP_INTERNAL, MALLOC_CAP_SPIRAM};
+    for (int i = 0; i < COUNT_OF(caps); i++) {
+        metrics_set(METRIC_HEAP_FREE, i, heap_caps_get_free_size(caps[i]));
+        metrics_set(METRIC_HEAP_LARGEST, i, heap_caps_get_largest_free_block(caps[i]));
+        metrics_set(METRIC_HEAP_MIN_FREE, i, heap_caps_get_minimum_free_size(caps[i]));
+    }
+
+    // ESP-IDF 中栈以字节为单位；任务不存在时记为 0
+    for (int i = 0; i < COUNT_OF(s_tasks); i++) {
+        TaskHandle_t task = xTaskGetHandle(s_tasks[i]);
+        metrics_set(METRIC_STACK_FREE, i, task ? uxTaskGetStackHighWaterMark(task) : 0);
+    }
+}
+
+/**
+ * @brief 生成一个实例的标签部分，如 {endpoint="weather",le="0.1"}
+ *
+ * @param le 分桶边界文本，不是直方图分桶时为 NULL
+ */
+static void format_labels(char *buf, size_t size, const metric_desc_t *m, int index,
+                          const char *le) {
+    if (m->label == NULL && le == NULL) {
+        buf[0] = '\0';
+    } else if (m->label == NULL) {
+        snprintf(buf, size, "{le=\"%s\"}", le);
+    } else if (le == NULL) {
+        snprintf(buf, size, "{%s=\"%s\"}", m->label, m->label_values[index]);
+    } else {
+        snprintf(buf, size, "{%s=\"%s\",le=\"%s\"}", m->label, m->label_values[index], le);
+    }
+}
+
+static esp_err_t write_line(metrics_write_fn write, void *ctx, char *line, int len) {
+    if (len <= 0) {
+        return ESP_OK;
+    }
+    return write(ctx, line, MIN(len, METRIC_LINE_MAX - 1));
+}
+
+/**
+ * @brief 导出一个直方图实例（分桶累积计数、总和与次数）
+ */
+static esp_err_t write_histogram(metrics_write_fn write, void *ctx, const metric_desc_t *m,
+                                 int index) {
+    histogram_t *h = &m->hist[index];
+    char line[METRIC_LINE_MAX];
+    char labels[64];
+    char le[16];
+    uint32_t cumulative = 0;
+    esp_err_t ret = ESP_OK;
+
+    for (int b = 0; b < BUCKET_COUNT && ret == ESP_OK; b++) {
+        cumulative += atomic_load_explicit(&h->buckets[b], memory_order_relaxed);
+        if (b < BUCKET_COUNT - 1) {
+            snprintf(le, sizeof(le), "%g", s_bounds_us[b] / 1e6);
+        } else {
+            snprintf(le, sizeof(le), "+Inf");
+        }
+        format_labels(labels, sizeof(labels), m, index, le);
+        int len = snprintf(line, sizeof(line), METRIC_PREFIX "%s_bucket%s %" PRIu32 "\n", m->name,
+                           labels, cumulative);
+        ret = write_line(write, ctx, line, len);
+    }
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    uint64_t sum_us = read_sum(h);
+    format_labels(labels, sizeof(labels), m, index, NULL);
+    int len = snprintf(line, sizeof(line),
+                       METRIC_PREFIX "%s_sum%s %" PRIu64 ".%06" PRIu64 "\n" METRIC_PREFIX
+                                     "%s_count%s %" PRIu32 "\n",
+                       m->name, labels, sum_us / 1000000, sum_us % 1000000, m->name, labels,
+                       cumulative);
+    return write_line(write, ctx, line, len);
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+void metrics_inc(metric_id_t id, uint8_t index) {
+    if (valid(id, index, METRIC_TYPE_COUNTER)) {
+        atomic_fetch_add_explicit(&s_metrics[id].value[index], 1, memory_order_relaxed);
+    }
+}
+
+void metrics_set(metric_id_t id, uint8_t index, uint32_t value) {
+    if (valid(id, index, METRIC_TYPE_GAUGE)) {
+        atomic_store_explicit(&s_metrics[id].value[index], value, memory_order_relaxed);
+    }
+}
+
+void metrics_observe(metric_id_t id, uint8_t index, int64_t us) {
+    if (!valid(id, index, METRIC_TYPE_HISTOGRAM)) {
+        return;
+    }
+
+    uint32_t v = (us < 0) ? 0 : (us > UINT32_MAX) ? UINT32_MAX : (uint32_t)us;
+    int b = 0;
+    while (b < BUCKET_COUNT - 1 && v > s_bounds_us[b]) {
+        b++;
+    }
+
+    histogram_t *h = &s_metrics[id].hist[index];
+    atomic_fetch_add_explicit(&h->buckets[b], 1, memory_order_relaxed);
+    uint32_t old = atomic_fetch_add_explicit(&h->sum_lo, v, memory_order_relaxed);
+    if ((uint32_t)(old + v) < old) {
+        atomic_fetch_add_explicit(&h->sum_hi, 1, memory_order_relaxed);
+    }
+}
+
+esp_err_t metrics_write(metrics_write_fn write, void *ctx) {
+    static const char *const type_names[] = {"counter", "gauge", "histogram"};
+    char line[METRIC_LINE_MAX];
+    char labels[64];
+
+    collect_gauges();
+
+    for (int id = 0; id < METRIC_COUNT; id++) {
+        const metric_desc_t *m = &s_metrics[id];
+        int len = snprintf(line, sizeof(line),
+                           "# HELP " METRIC_PREFIX "%s %s\n# TYPE " METRIC_PREFIX "%s %s\n",
+                           m->name, m->help, m->name, type_names[m->type]);
+        esp_err_t ret = write_line(write, ctx, line, len);
+
+        for (int i = 0; i < m->instances && ret == ESP_OK; i++) {
+            if (m->type == METRIC_TYPE_HISTOGRAM) {
+                ret = write_histogram(write, ctx, m, i);
+                continue;
+            }
+            format_labels(labels, sizeof(labels), m, i, NULL);
+            len = snprintf(line, sizeof(line), METRIC_PREFIX "%s%s %" PRIu32 "\n", m->name, labels,
+                           (uint32_t)atomic_load_explicit(&m->value[i], memory_order_relaxed));
+            ret = write_line(write, ctx, line, len);
+        }
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
@@ -1,3 +1,19 @@
+/**
+ * @file sntp.c
+ * @brief 系统时间：开机恢复、后台 SNTP 同步与漂移补偿
+ *
+ * - 恢复：软件复位后 RTC 定时器保持系统时间，直接沿用；掉电后系统时间从 1970 年开始，
+ *   改用 NVS 中上次同步时保存的时间（掉电期间的时长丢失，界面在同步前视为不可信）。
+ * - 同步：重定义 sntp_sync_time()，在设置系统时间之前拿到本地时间与 NTP 时间的偏差。
+ * - 漂移：两次同步之间的偏差除以间隔得到残余漂移率，按增益累加到漂移估计中；
+ *   补偿定时器每分钟按漂移率用 adjtime() 平滑修正系统时间。漂移估计保存在
+ *   RTC 内存（软件复位后保留）和 NVS（掉电后保留）中。
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
 #include <time.h>
@@ -7,95 +23,401 @@
 #include "freertos/task.h"
 
 #include "esp_attr.h"
-#include "esp_event.h"
 #include "esp_log.h"
-#include "esp_sleep.h"
 #include "esp_sntp.h"
-#include "esp_system.h"
-#include "nvs_flash.h"
+#include "esp_timer.h"
+#include "nvs.h"
+
+#include "config_manager.h"
 #include "sntp.h"
 
 static const char *TAG = "sntp";
 
+#define TIME_NVS_NAMESPACE "time"
+#define TIME_NVS_KEY "state"
+#define TIME_STATE_SCHEMA 1
+#define TIME_RTC_MAGIC 0x54494D45
+
+/** @brief 最多使用的 NTP 服务器数（受 LWIP 配置限制） */
+#define TIME_MAX_NTP_SERVERS CONFIG_LWIP_SNTP_MAX_SERVERS
+/** @brief 单个 NTP 服务器地址最大长度（含结束符） */
+#define TIME_SERVER_NAME_MAX 64
+
+/** @brief 漂移补偿间隔（秒） */
+#define DRIFT_COMP_INTERVAL_S 60
+/** @brief 两次同步间隔短于该值（秒）时不更新漂移估计 */
+#define DRIFT_MIN_SAMPLE_S 600
+/** @brief 漂移估计上限（ppm），超过视为异常 */
+#define DRIFT_MAX_PPM 500.0f
+/** @brief 残余漂移累加到估计中的增益 */
+#define DRIFT_GAIN 0.5f
+/** @brief 偏差超过该值（微秒）视为时间跳变（如首次同步），不用于漂移估计 */
+#define DRIFT_MAX_STEP_US 10000000LL
+
+#define TIME_READY_BIT BIT0  ///< time_init() 已执行（网络已就绪）
+#define TIME_SYNCED_BIT BIT1 ///< 已通过 SNTP 同步
+
+/**
+ * @brief NVS 中保存的同步状态
+ */
+typedef struct {
+    uint16_t schema;   ///< 结构版本
+    uint16_t reserved;
+    int32_t drift_ppb; ///< 漂移估计（十亿分之一）
+    int64_t last_sync; ///< 最近一次同步的时间（Unix 秒）
+} time_nvs_state_t;
+
 /**
- * @brief 获取网络时间
+ * @brief RTC 内存中保存的漂移估计（软件复位后保留）
+ */
+typedef struct {
+    uint32_t magic;
+    int32_t drift_ppb;
+    uint32_t check;
+} time_rtc_state_t;
+
+static RTC_NOINIT_ATTR time_rtc_state_t s_rtc_state;
+
+static EventGroupHandle_t s_events = NULL;
+static esp_timer_handle_t s_comp_timer = NULL;
+static volatile time_source_t s_source = TIME_SOURCE_NONE;
+static volatile float s_drift_ppm = 0;
+static int64_t s_last_sync_us = 0; ///< 本次启动后最近一次同步的 NTP 时间，0 表示未同步
+static bool s_sntp_started = false;
+static time_sync_cb_t s_sync_cb = NULL;
+
+/** @brief esp_sntp_setservername() 只保存指针，服务器地址需长期有效 */
+static char s_servers[TIME_MAX_NTP_SERVERS][TIME_SERVER_NAME_MAX];
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+static int64_t timeval_to_us(const struct timeval *tv) {
+    return (int64_t)tv->tv_sec * 1000000 + tv->tv_usec;
+}
+
+static uint32_t rtc_state_check(const time_rtc_state_t *state) {
+    return state->magic ^ (uint32_t)state->drift_ppb ^ 0xA5A5A5A5u;
+}
+
+/**
+ * @brief 保存漂移估计到 RTC 内存
+ */
+static void rtc_state_save(void) {
+    s_rtc_state.magic = TIME_RTC_MAGIC;
+    s_rtc_state.drift_ppb = (int32_t)lroundf(s_drift_ppm * 1000.0f);
+    s_rtc_state.check = rtc_state_check(&s_rtc_state);
+}
+
+/**
+ * @brief 从 RTC 内存读取漂移估计（上电后内容随机，校验失败视为无效）
+ */
+static bool rtc_state_load(float *drift_ppm) {
+    if (s_rtc_state.magic != TIME_RTC_MAGIC ||
+        s_rtc_state.check != rtc_state_check(&s_rtc_state)) {
+        return false;
+    }
+    *drift_ppm = s_rtc_state.drift_ppb / 1000.0f;
+    return fabsf(*drift_ppm) <= DRIFT_MAX_PPM;
+}
+
+static esp_err_t nvs_state_load(time_nvs_state_t *state) {
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(TIME_NVS_NAMESPACE, NVS_READONLY, &nvs);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    size_t length = sizeof(time_nvs_state_t);
+    err = nvs_get_blob(nvs, TIME_NVS_KEY, state, &length);
+    nvs_close(nvs);
+
+    if (err == ESP_OK &&
+        (length != sizeof(time_nvs_state_t) || state->schema != TIME_STATE_SCHEMA)) {
+        err = ESP_ERR_NOT_FOUND;
+    }
+    return err;
+}
+
+static void nvs_state_save(time_t last_sync) {
+    time_nvs_state_t state = {
+        .schema = TIME_STATE_SCHEMA,
+        .drift_ppb = (int32_t)lroundf(s_drift_ppm * 1000.0f),
+        .last_sync = (int64_t)last_sync,
+    };
+
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(TIME_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, TIME_NVS_KEY, &state, sizeof(state));
+        if (err == ESP_OK) {
+            err = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to save time state: %s", esp_err_to_name(err));
+    }
+}
+
+/**
+ * @brief 应用配置中的时区
+ */
+static void apply_timezone(const sys_config_t *config) {
+    const char *tz =
+        config->time.timezone[0] != '\0' ? config->time.timezone : TIME_DEFAULT_TIMEZONE;
+    setenv("TZ", tz, 1);
+    tzset();
+    ESP_LOGI(TAG, "Timezone: %s", tz);
+}
+
+/**
+ * @brief 解析逗号分隔的服务器列表到 s_servers
  *
- * 通过SNTP协议从NTP服务器获取当前时间并同步到系统
+ * @return 服务器个数
  */
-void obtain_time(void);
+static int parse_servers(const char *list) {
+    int count = 0;
+
+    memset(s_servers, 0, sizeof(s_servers));
+    const char *p = list;
+    while (*p != '\0' && count < TIME_MAX_NTP_SERVERS) {
+        while (*p == ',' || *p == ' ') {
+            p++;
+        }
+        size_t len = strcspn(p, ", ");
+        if (len >= TIME_SERVER_NAME_MAX) {
+            ESP_LOGW(TAG, "NTP server name too long, ignored");
+        } else if (len > 0) {
+            memcpy(s_servers[count], p, len);
+            count++;
+        }
+        p += len;
+    }
+    return count;
+}
 
 /**
- * @brief 初始化SNTP服务
+ * @brief 配置并启动 SNTP 客户端
+ */
+static void start_sntp(void) {
+    sys_config_t config;
+    config_manager_get_config(&config);
+    int count = parse_servers(config.time.ntp_servers);
+    if (count == 0) {
+        count = parse_servers(TIME_DEFAULT_NTP_SERVERS);
+    }
+
+    esp_sntp_setoperatingmode(SNTP_OPMODE_POLL);
+    for (int i = 0; i < TIME_MAX_NTP_SERVERS; i++) {
+        esp_sntp_setservername(i, i < count ? s_servers[i] : NULL);
+        if (i < count) {
+            ESP_LOGI(TAG, "NTP server %d: %s", i, s_servers[i]);
+        }
+    }
+    esp_sntp_init();
+    s_sntp_started = true;
+}
+
+/**
+ * @brief 漂移补偿定时器回调
  *
- * 配置并启动SNTP客户端以同步网络时间
+ * 按漂移估计修正一个补偿周期内累积的偏差（ppm × 秒 = 微秒）。
  */
-static void initialize_sntp(void);
+static void drift_comp_cb(void *arg) {
+    (void)arg;
+    float drift_ppm = s_drift_ppm;
+    if (s_source != TIME_SOURCE_NTP || fabsf(drift_ppm) < 0.1f) {
+        return;
+    }
+
+    int64_t delta_us = (int64_t)lroundf(drift_ppm * DRIFT_COMP_INTERVAL_S);
+    struct timeval delta = {
+        .tv_sec = (time_t)(delta_us / 1000000),
+        .tv_usec = (suseconds_t)(delta_us % 1000000),
+    };
+    adjtime(&delta, NULL);
+}
 
 /**
- * @brief 时间同步回调函数
+ * @brief 根据本次同步的偏差更新漂移估计
  *
- * 当系统时间通过SNTP同步后被调用
- * @param tv 同步后的时间值
+ * @param offset_us NTP 时间 - 本地时间
+ * @param ntp_us NTP 时间
  */
-void time_sync_notification_cb(struct timeval *tv) {
-    time_t now;
-    time(&now);
-    struct tm timeinfo;
-    localtime_r(&now, &timeinfo);
+static void update_drift(int64_t offset_us, int64_t ntp_us) {
+    if (s_last_sync_us == 0 || llabs(offset_us) > DRIFT_MAX_STEP_US) {
+        return;
+    }
+
+    int64_t elapsed_us = ntp_us - s_last_sync_us;
+    if (elapsed_us < (int64_t)DRIFT_MIN_SAMPLE_S * 1000000) {
+        return;
+    }
 
-    ESP_LOGI(TAG, "Time synced from NTP server, current time: %s", asctime(&timeinfo));
+    // 补偿已生效时测得的是残余漂移，累加到估计中
+    float residual_ppm = (float)((double)offset_us * 1e6 / (double)elapsed_us);
+    float drift_ppm = s_drift_ppm + DRIFT_GAIN * residual_ppm;
+    if (fabsf(drift_ppm) > DRIFT_MAX_PPM) {
+        ESP_LOGW(TAG, "Drift estimate %.1f ppm out of range, ignored", drift_ppm);
+        return;
+    }
+
+    s_drift_ppm = drift_ppm;
+    ESP_LOGI(TAG, "Offset %lld ms over %lld s, residual %.2f ppm, drift now %.2f ppm",
+             offset_us / 1000, elapsed_us / 1000000, residual_ppm, drift_ppm);
 }
 
+// ============================================================================
+// 公共 API
+// ============================================================================
+
 /**
- * @brief 初始化并同步系统时间
+ * @brief SNTP 收到服务器时间后调用（重定义 ESP-IDF 中的弱符号）
  *
- * 等待WiFi连接成功后通过NTP同步时间
+ * 在设置系统时间之前计算本地时间的偏差，用于漂移学习。
+ *
+ * @param tv NTP 服务器时间
  */
-void time_init(void) {
-    time_t now;
+void sntp_sync_time(struct timeval *tv) {
+    struct timeval local;
+    gettimeofday(&local, NULL);
+
+    int64_t ntp_us = timeval_to_us(tv);
+    int64_t offset_us = ntp_us - timeval_to_us(&local);
+    update_drift(offset_us, ntp_us);
+
+    settimeofday(tv, NULL);
+    sntp_set_sync_status(SNTP_SYNC_STATUS_COMPLETED);
+
+    bool first = (s_source != TIME_SOURCE_NTP);
+    s_source = TIME_SOURCE_NTP;
+    s_last_sync_us = ntp_us;
+    rtc_state_save();
+    nvs_state_save(tv->tv_sec);
+
     struct tm timeinfo;
-    time(&now);
-    localtime_r(&now, &timeinfo);
-    obtain_time();
-    time(&now);
+    time_t now = tv->tv_sec;
     localtime_r(&now, &timeinfo);
+    char buf[32];
+    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &timeinfo);
+    ESP_LOGI(TAG, "Time synced: %s (offset %lld ms)", buf, offset_us / 1000);
 
-    setenv("TZ", "CST-8", 1);
-    tzset();
+    if (s_events != NULL) {
+        xEventGroupSetBits(s_events, TIME_SYNCED_BIT);
+    }
+    time_sync_cb_t cb = s_sync_cb;
+    if (cb != NULL) {
+        cb(first);
+    }
 }
 
 /**
- * @brief 通过SNTP获取网络时间
+ * @brief 开机恢复时间
  *
- * 初始化SNTP客户端并等待时间同步完成，最多重试10次
+ * 优先沿用 RTC 保持的系统时间，否则使用 NVS 中上次同步的时间。
  */
-void obtain_time(void) {
-    initialize_sntp();
-
-    time_t now = 0;
-    struct tm timeinfo = {0};
-    int retry = 0;
-    const int retry_count = 10;
-    while (sntp_get_sync_status() == SNTP_SYNC_STATUS_RESET && ++retry < retry_count) {
-        ESP_LOGI(TAG, "Waiting for system time sync (%d/%d)", retry, retry_count);
-        vTaskDelay(2000 / portTICK_PERIOD_MS);
-    }
-    time(&now);
-    localtime_r(&now, &timeinfo);
+void time_restore(void) {
+    if (s_events == NULL) {
+        s_events = xEventGroupCreate();
+    }
 
-    setenv("TZ", "CST-8", 1);
-    tzset();
+    sys_config_t config;
+    config_manager_get_config(&config);
+    apply_timezone(&config);
+
+    time_nvs_state_t state = {0};
+    bool has_state = (nvs_state_load(&state) == ESP_OK);
+
+    // 漂移估计：RTC 内存优先（软件复位），其次 NVS（掉电）
+    float drift_ppm = 0;
+    if (rtc_state_load(&drift_ppm)) {
+        s_drift_ppm = drift_ppm;
+    } else if (has_state && abs(state.drift_ppb) <= (int32_t)(DRIFT_MAX_PPM * 1000)) {
+        s_drift_ppm = state.drift_ppb / 1000.0f;
+    }
+
+    time_t now = time(NULL);
+    if (now >= TIME_MIN_VALID) {
+        s_source = TIME_SOURCE_RTC;
+    } else if (has_state && state.last_sync >= TIME_MIN_VALID) {
+        struct timeval tv = {.tv_sec = (time_t)state.last_sync, .tv_usec = 0};
+        settimeofday(&tv, NULL);
+        s_source = TIME_SOURCE_NVS;
+    } else {
+        s_source = TIME_SOURCE_NONE;
+    }
+
+    if (s_source != TIME_SOURCE_NONE) {
+        now = time(NULL);
+        struct tm timeinfo;
+        localtime_r(&now, &timeinfo);
+        char buf[32];
+        strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &timeinfo);
+        ESP_LOGI(TAG, "Time restored from %s: %s (drift %.2f ppm)",
+                 s_source == TIME_SOURCE_RTC ? "RTC" : "NVS", buf, s_drift_ppm);
+    } else {
+        ESP_LOGI(TAG, "No saved time, waiting for SNTP");
+    }
+
+    if (s_comp_timer == NULL) {
+        const esp_timer_create_args_t args = {
+            .callback = &drift_comp_cb,
+            .name = "time_drift",
+        };
+        if (esp_timer_create(&args, &s_comp_timer) == ESP_OK) {
+            esp_timer_start_periodic(s_comp_timer, (uint64_t)DRIFT_COMP_INTERVAL_S * 1000000);
+        }
+    }
 }
 
 /**
- * @brief 初始化SNTP配置
+ * @brief 启动后台 SNTP 同步
  *
- * 设置SNTP操作模式为轮询模式，配置NTP服务器地址和同步回调函数
+ * 在 WiFi 连接之后调用，不等待同步完成。
  */
-static void initialize_sntp(void) {
+void time_init(void) {
+    if (s_events == NULL) {
+        time_restore();
+    }
+
     ESP_LOGI(TAG, "Initializing SNTP");
-    esp_sntp_setoperatingmode(SNTP_OPMODE_POLL);
-    esp_sntp_setservername(0, "ntp.aliyun.com");
-    esp_sntp_set_time_sync_notification_cb(time_sync_notification_cb);
-    esp_sntp_init();
-}
\ No newline at end of file
+    start_sntp();
+    xEventGroupSetBits(s_events, TIME_READY_BIT);
+}
+
+void time_apply_config(void) {
+    sys_config_t config;
+    config_manager_get_config(&config);
+    apply_timezone(&config);
+
+    if (s_sntp_started) {
+        esp_sntp_stop();
+        start_sntp();
+    }
+}
+
+void time_wait_ready(void) {
+    while (s_events == NULL) {
+        vTaskDelay(pdMS_TO_TICKS(200));
+    }
+    xEventGroupWaitBits(s_events, TIME_READY_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+}
+
+bool time_wait_synced(uint32_t timeout_ms) {
+    if (s_events == NULL) {
+        return false;
+    }
+    EventBits_t bits =
+        xEventGroupWaitBits(s_events, TIME_SYNCED_BIT, pdFALSE, pdTRUE, pdMS_TO_TICKS(timeout_ms));
+    return (bits & TIME_SYNCED_BIT) != 0;
+}
+
+bool time_is_authoritative(void) { return s_source == TIME_SOURCE_NTP; }
+
+time_source_t time_get_source(void) { return s_source; }
+
+float time_get_drift_ppm(void) { return s_drift_ppm; }
+
+void time_set_sync_callback(time_sync_cb_t cb) { s_sync_cb = cb; }
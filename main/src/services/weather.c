@@ -8,508 +8,483 @@
  * - 解析天气 JSON 数据
  * - 自动解压缩 GZIP 编码的 HTTP 响应
  *
+ * 响应按 HTTP 数据块流式处理：每个数据块先解压，再交给增量 JSON 解析器，
+ * 字段在解析过程中直接写入目标结构体，不缓存完整响应体、解压结果或 JSON DOM。
+ *
  * 天气数据包括温度、风向、湿度、气压、云量等多项指标。
  *
  * @author
  * @date YYYY-MM-DD
  */
 
-#include "cJSON.h"
 #include "esp_attr.h"
-#include "esp_crt_bundle.h"
 #include "esp_heap_caps.h"
 #include "esp_http_client.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include <stdlib.h>
 #include <string.h>
 
 #include "config_manager.h"
 #include "decompress.h"
+#include "http_cache.h"
+#include "http_pool.h"
 #include "ip_location.h"
+#include "json_bind.h"
+#include "json_stream.h"
+#include "metrics.h"
+#include "net_health.h"
 #include "weather.h"
 
 /** @brief 日志标签 */
 #define TAG "weather"
 
+/** @brief 预报数据最大天数 */
+#define WEATHER_FORECAST_MAX_DAYS                                                              \
+    (sizeof(((weather_forecast_t *)0)->daily) / sizeof(weather_daily_t))
+
 /**
- * @brief 响应数据结构
+ * @brief 请求类型
+ */
+typedef enum {
+    WEATHER_REQUEST_NOW,      /**< 实时天气 */
+    WEATHER_REQUEST_FORECAST, /**< 每日预报 */
+} weather_request_kind_t;
+
+/**
+ * @brief 单次天气请求的流式解析上下文
  *
- * 用于存储 HTTP 响应的数据和长度信息。
+ * 作为 HTTP 客户端的 user_data，贯穿 解压 → JSON 解析 → 写入结构体 整条流水线。
  */
 typedef struct {
-    void *data;      /**< 响应数据指针 */
-    size_t data_len; /**< 响应数据长度 */
-} response_data_t;
+    weather_request_kind_t kind; /**< 请求类型 */
+    union {
+        weather_now_t *now;           /**< 实时天气输出 */
+        weather_forecast_t *forecast; /**< 每日预报输出 */
+    } out;
+    bool found;                                   /**< 是否找到 now 对象 / daily 数组 */
+    bool in_target;                               /**< 当前是否位于 now 对象 / daily 数组内 */
+    int day_index;                                /**< 当前预报日下标，-1 表示不在某一天的对象内 */
+    bool overflow;                                /**< 预报天数超过上限 */
+    int bind_depth;                               /**< 正在绑定的对象内字段所在深度，0 表示未在绑定 */
+    json_bind_obj_t bind;                         /**< 当前对象的绑定状态 */
+    int64_t bind_us;                              /**< 所有对象绑定累计耗时 */
+    bool unchanged;                               /**< updateTime 与缓存一致，停止解析 */
+    char update_time[HTTP_CACHE_DATE_MAX];        /**< 本次响应的 updateTime */
+    char cached_update_time[HTTP_CACHE_DATE_MAX]; /**< 缓存结果的 updateTime */
+    http_cache_meta_t cache;                      /**< 本次响应的缓存相关响应头 */
+    esp_err_t err;                                /**< 流水线中发生的第一个错误 */
+    gzip_stream_t *gzip;                          /**< 流式解压器（共享，请求期间持有） */
+    json_stream_t json;                           /**< 增量 JSON 解析器 */
+} weather_request_t;
+
+/** @brief 实时天气字段表（now 对象） */
+static const json_bind_field_t weather_now_fields[] = {
+    JSON_BIND_FIELD("temp", JSON_BIND_FLOAT, weather_now_t, temperature),
+    JSON_BIND_FIELD("feelsLike", JSON_BIND_FLOAT, weather_now_t, feelslike),
+    JSON_BIND_FIELD("icon", JSON_BIND_INT, weather_now_t, icon),
+    JSON_BIND_FIELD("text", JSON_BIND_STR, weather_now_t, text),
+    JSON_BIND_FIELD("windDir", JSON_BIND_STR, weather_now_t, wind_dir),
+    JSON_BIND_FIELD("windScale", JSON_BIND_INT, weather_now_t, wind_scale),
+    JSON_BIND_FIELD("humidity", JSON_BIND_INT, weather_now_t, humidity),
+    JSON_BIND_FIELD("precip", JSON_BIND_FLOAT, weather_now_t, precip),
+    JSON_BIND_FIELD("pressure", JSON_BIND_FLOAT, weather_now_t, pressure),
+    JSON_BIND_FIELD("vis", JSON_BIND_FLOAT, weather_now_t, visibility),
+    JSON_BIND_FIELD("cloud", JSON_BIND_FLOAT, weather_now_t, cloud),
+    JSON_BIND_FIELD("dew", JSON_BIND_FLOAT, weather_now_t, dew),
+    JSON_BIND_FIELD("obsTime", JSON_BIND_TIME, weather_now_t, obs_time),
+};
+
+// 由 tools/gen_json_bind_hash.py 生成，修改 weather_now_fields 后需重新生成
+// clang-format off
+#define WEATHER_NOW_SEED 0x00000035u
+static const int8_t weather_now_slots[32] = {
+    -1, -1, -1, 10, -1,  9,  4, -1, -1,  6,  7, 11,  5,  3,  8, -1,
+     0, -1, -1, 12, -1, -1, -1,  1, -1, -1, -1, -1, -1, -1, -1,  2,
+};
+// clang-format on
+
+static const json_bind_desc_t weather_now_desc = {
+    .name = "weather_now",
+    .fields = weather_now_fields,
+    .field_count = sizeof(weather_now_fields) / sizeof(weather_now_fields[0]),
+    .slots = weather_now_slots,
+    .slot_mask = sizeof(weather_now_slots) - 1,
+    .seed = WEATHER_NOW_SEED,
+};
+
+/** @brief 每日预报字段表（daily 数组元素） */
+static const json_bind_field_t weather_daily_fields[] = {
+    JSON_BIND_FIELD("fxDate", JSON_BIND_STR, weather_daily_t, fx_date),
+    JSON_BIND_FIELD("sunrise", JSON_BIND_STR, weather_daily_t, sunrise),
+    JSON_BIND_FIELD("sunset", JSON_BIND_STR, weather_daily_t, sunset),
+    JSON_BIND_FIELD("moonrise", JSON_BIND_STR, weather_daily_t, moonrise),
+    JSON_BIND_FIELD("moonset", JSON_BIND_STR, weather_daily_t, moonset),
+    JSON_BIND_FIELD("moonPhase", JSON_BIND_STR, weather_daily_t, moon_phase),
+    JSON_BIND_FIELD("moonPhaseIcon", JSON_BIND_INT, weather_daily_t, moon_phase_icon),
+    JSON_BIND_FIELD("tempMax", JSON_BIND_INT, weather_daily_t, temp_max),
+    JSON_BIND_FIELD("tempMin", JSON_BIND_INT, weather_daily_t, temp_min),
+    JSON_BIND_FIELD("iconDay", JSON_BIND_INT, weather_daily_t, icon_day),
+    JSON_BIND_FIELD("textDay", JSON_BIND_STR, weather_daily_t, text_day),
+    JSON_BIND_FIELD("iconNight", JSON_BIND_INT, weather_daily_t, icon_night),
+    JSON_BIND_FIELD("textNight", JSON_BIND_STR, weather_daily_t, text_night),
+    JSON_BIND_FIELD("wind360Day", JSON_BIND_INT, weather_daily_t, wind_360_day),
+    JSON_BIND_FIELD("windDirDay", JSON_BIND_STR, weather_daily_t, wind_dir_day),
+    JSON_BIND_FIELD("windScaleDay", JSON_BIND_STR, weather_daily_t, wind_scale_day),
+    JSON_BIND_FIELD("windSpeedDay", JSON_BIND_INT, weather_daily_t, wind_speed_day),
+    JSON_BIND_FIELD("wind360Night", JSON_BIND_INT, weather_daily_t, wind_360_night),
+    JSON_BIND_FIELD("windDirNight", JSON_BIND_STR, weather_daily_t, wind_dir_night),
+    JSON_BIND_FIELD("windScaleNight", JSON_BIND_STR, weather_daily_t, wind_scale_night),
+    JSON_BIND_FIELD("windSpeedNight", JSON_BIND_INT, weather_daily_t, wind_speed_night),
+    JSON_BIND_FIELD("humidity", JSON_BIND_INT, weather_daily_t, humidity),
+    JSON_BIND_FIELD("precip", JSON_BIND_FLOAT, weather_daily_t, precip),
+    JSON_BIND_FIELD("pressure", JSON_BIND_INT, weather_daily_t, pressure),
+    JSON_BIND_FIELD("vis", JSON_BIND_INT, weather_daily_t, vis),
+    JSON_BIND_FIELD("cloud", JSON_BIND_INT, weather_daily_t, cloud),
+    JSON_BIND_FIELD("uvIndex", JSON_BIND_INT, weather_daily_t, uv_index),
+};
+
+// 由 tools/gen_json_bind_hash.py 生成，修改 weather_daily_fields 后需重新生成
+// clang-format off
+#define WEATHER_DAILY_SEED 0x000000fdu
+static const int8_t weather_daily_slots[64] = {
+    -1,  2, -1, -1, 24, -1, -1, -1, -1, -1, -1, -1, 14,  9, -1,  7,
+    -1,  6,  8, -1, -1, -1, -1, -1, -1, 23, -1, 17, 15,  4, -1, -1,
+    19, 13, -1, -1, 26, 22,  3, -1, 10, 12, -1, 20, -1, 21, -1, -1,
+    16, -1, -1,  5, -1, -1, -1, 11, 18, -1, -1,  0,  1, -1, -1, 25,
+};
+// clang-format on
+
+static const json_bind_desc_t weather_daily_desc = {
+    .name = "weather_daily",
+    .fields = weather_daily_fields,
+    .field_count = sizeof(weather_daily_fields) / sizeof(weather_daily_fields[0]),
+    .slots = weather_daily_slots,
+    .slot_mask = sizeof(weather_daily_slots) - 1,
+    .seed = WEATHER_DAILY_SEED,
+};
 
 /**
- * @brief 解析天气 JSON 数据
- *
- * 从 API 响应的 JSON 中提取当前天气信息，包括温度、风向、湿度等。
- * 处理字段可能为数字或字符串格式的情况。
- *
- * @param json JSON 格式的天气数据字符串
- * @param weather_now 输出参数，解析后的天气数据结构体
+ * @brief JSON 对象开始回调：定位 now 对象或 daily 数组中的某一天
  */
-static void parse_weather_now(const char *json, weather_now_t *weather_now) {
-    if (weather_now == NULL || json == NULL) {
-        ESP_LOGE(TAG, "Invalid pointer parameters");
+static void on_object_start(void *ctx, int depth, const char *key) {
+    weather_request_t *req = (weather_request_t *)ctx;
+
+    if (req->unchanged) {
         return;
     }
 
-    // 解析 JSON 字符串
-    cJSON *root = cJSON_Parse(json);
-    if (root == NULL) {
-        ESP_LOGE(TAG, "Failed to parse weather JSON");
+    if (req->kind == WEATHER_REQUEST_NOW) {
+        // 查找 now 字段（当前天气数据）
+        if (depth == 1 && key != NULL && strcmp(key, "now") == 0) {
+            req->found = true;
+            req->in_target = true;
+            req->bind_depth = 2;
+            json_bind_begin(&req->bind, &weather_now_desc, req->out.now);
+        }
         return;
     }
 
-    // 初始化所有字段为零
-    memset(weather_now, 0, sizeof(weather_now_t));
-
-    // 查找 now 字段（当前天气数据）
-    cJSON *now = cJSON_GetObjectItemCaseSensitive(root, "now");
-    if (now == NULL || !cJSON_IsObject(now)) {
-        ESP_LOGE(TAG, "Missing 'now' object in weather response");
-        cJSON_Delete(root);
-        return;
+    // 遍历每一天的预报数据
+    if (req->in_target && depth == 2) {
+        if (req->out.forecast->count < WEATHER_FORECAST_MAX_DAYS) {
+            req->day_index = req->out.forecast->count;
+            req->bind_depth = 3;
+            json_bind_begin(&req->bind, &weather_daily_desc,
+                            &req->out.forecast->daily[req->day_index]);
+        } else {
+            if (!req->overflow) {
+                ESP_LOGW(TAG, "Weather forecast data exceeds maximum %u days",
+                         (unsigned)WEATHER_FORECAST_MAX_DAYS);
+            }
+            req->overflow = true;
+            req->day_index = -1;
+        }
     }
+}
 
-    // 提取各个天气字段信息
-    cJSON *item = NULL;
+/**
+ * @brief JSON 对象结束回调
+ */
+static void on_object_end(void *ctx, int depth) {
+    weather_request_t *req = (weather_request_t *)ctx;
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "temp");
-    if (cJSON_IsNumber(item)) {
-        weather_now->temperature = item->valuedouble;
-    } else if (cJSON_IsString(item)) {
-        weather_now->temperature = strtod(item->valuestring, NULL);
+    if (req->kind == WEATHER_REQUEST_NOW) {
+        if (depth == 1 && req->in_target) {
+            req->in_target = false;
+            req->bind_depth = 0;
+            req->bind_us += json_bind_end(&req->bind);
+        }
+        return;
     }
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "feelsLike");
-    if (cJSON_IsNumber(item)) {
-        weather_now->feelslike = item->valuedouble;
-    } else if (cJSON_IsString(item)) {
-        weather_now->feelslike = strtod(item->valuestring, NULL);
+    if (req->in_target && depth == 2 && req->day_index >= 0) {
+        req->out.forecast->count++;
+        req->day_index = -1;
+        req->bind_depth = 0;
+        req->bind_us += json_bind_end(&req->bind);
     }
+}
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "icon");
-    if (cJSON_IsNumber(item)) {
-        weather_now->icon = (uint16_t)item->valueint;
-    } else if (cJSON_IsString(item)) {
-        weather_now->icon = (uint16_t)atoi(item->valuestring);
-    }
+/**
+ * @brief JSON 数组开始回调：定位 daily 数组
+ */
+static void on_array_start(void *ctx, int depth, const char *key) {
+    weather_request_t *req = (weather_request_t *)ctx;
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "text");
-    if (cJSON_IsString(item)) {
-        strncpy(weather_now->text, item->valuestring, sizeof(weather_now->text) - 1);
-        weather_now->text[sizeof(weather_now->text) - 1] = '\0';
+    if (req->unchanged) {
+        return;
     }
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "windDir");
-    if (cJSON_IsString(item)) {
-        strncpy(weather_now->wind_dir, item->valuestring, sizeof(weather_now->wind_dir) - 1);
-        weather_now->wind_dir[sizeof(weather_now->wind_dir) - 1] = '\0';
+    if (req->kind == WEATHER_REQUEST_FORECAST && depth == 1 && key != NULL &&
+        strcmp(key, "daily") == 0) {
+        req->found = true;
+        req->in_target = true;
     }
+}
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "windScale");
-    if (cJSON_IsNumber(item)) {
-        weather_now->wind_scale = (uint8_t)item->valueint;
-    } else if (cJSON_IsString(item)) {
-        weather_now->wind_scale = (uint8_t)atoi(item->valuestring);
-    }
+/**
+ * @brief JSON 数组结束回调
+ */
+static void on_array_end(void *ctx, int depth) {
+    weather_request_t *req = (weather_request_t *)ctx;
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "humidity");
-    if (cJSON_IsNumber(item)) {
-        weather_now->humidity = (uint8_t)item->valueint;
-    } else if (cJSON_IsString(item)) {
-        weather_now->humidity = (uint8_t)atoi(item->valuestring);
+    if (req->kind == WEATHER_REQUEST_FORECAST && depth == 1) {
+        req->in_target = false;
     }
+}
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "precip");
-    if (cJSON_IsNumber(item)) {
-        weather_now->precip = item->valuedouble;
-    } else if (cJSON_IsString(item)) {
-        weather_now->precip = strtod(item->valuestring, NULL);
-    }
+/**
+ * @brief JSON 标量值回调：将字段直接写入目标结构体
+ */
+static void on_value(void *ctx, int depth, const char *key, json_stream_type_t type,
+                     const char *value, size_t len) {
+    weather_request_t *req = (weather_request_t *)ctx;
+    (void)len;
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "pressure");
-    if (cJSON_IsNumber(item)) {
-        weather_now->pressure = item->valuedouble;
-    } else if (cJSON_IsString(item)) {
-        weather_now->pressure = strtod(item->valuestring, NULL);
+    if (req->unchanged) {
+        return;
     }
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "vis");
-    if (cJSON_IsNumber(item)) {
-        weather_now->visibility = item->valuedouble;
-    } else if (cJSON_IsString(item)) {
-        weather_now->visibility = strtod(item->valuestring, NULL);
+    // updateTime 位于 now / daily 之前，与缓存一致时说明数据未更新，后续内容不再解析
+    if (depth == 1 && key != NULL && strcmp(key, "updateTime") == 0 &&
+        type == JSON_STREAM_STRING) {
+        snprintf(req->update_time, sizeof(req->update_time), "%s", value);
+        if (req->cached_update_time[0] != '\0' &&
+            strcmp(req->update_time, req->cached_update_time) == 0) {
+            req->unchanged = true;
+            req->bind_depth = 0;
+        }
+        return;
     }
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "cloud");
-    if (cJSON_IsNumber(item)) {
-        weather_now->cloud = item->valuedouble;
-    } else if (cJSON_IsString(item)) {
-        weather_now->cloud = strtod(item->valuestring, NULL);
+    // 只绑定目标对象的直接字段，忽略嵌套在其中的对象或数组
+    if (req->bind_depth != 0 && depth == req->bind_depth) {
+        json_bind_value(&req->bind, key, type, value);
     }
+}
 
-    item = cJSON_GetObjectItemCaseSensitive(now, "dew");
-    if (cJSON_IsNumber(item)) {
-        weather_now->dew = item->valuedouble;
-    } else if (cJSON_IsString(item)) {
-        weather_now->dew = strtod(item->valuestring, NULL);
-    }
+/** @brief 天气响应解析回调表 */
+static const json_stream_callbacks_t s_weather_json_callbacks = {
+    .on_object_start = on_object_start,
+    .on_object_end = on_object_end,
+    .on_array_start = on_array_start,
+    .on_array_end = on_array_end,
+    .on_value = on_value,
+};
 
-    // 解析观测时间 obsTime (ISO 8601格式: "2026-01-29T00:48+08:00")
-    item = cJSON_GetObjectItemCaseSensitive(now, "obsTime");
-    if (cJSON_IsString(item)) {
-        struct tm tm = {0};
-        // 解析ISO 8601时间格式: YYYY-MM-DDTHH:MM+TZ:TZ
-        if (sscanf(item->valuestring, "%d-%d-%dT%d:%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
-                   &tm.tm_hour, &tm.tm_min) == 5) {
-            tm.tm_year -= 1900; // tm_year是从1900年开始
-            tm.tm_mon -= 1;     // tm_mon是0-11
-            tm.tm_sec = 0;
-            tm.tm_isdst = -1; // 让系统自动判断是否夏令时
-            weather_now->obs_time = mktime(&tm);
-            ESP_LOGI(TAG, "Parsed obsTime: %s -> timestamp: %ld", item->valuestring,
-                     (long)weather_now->obs_time);
-        } else {
-            ESP_LOGW(TAG, "Failed to parse obsTime: %s", item->valuestring);
-            weather_now->obs_time = 0;
-        }
-    } else {
-        weather_now->obs_time = 0;
+/**
+ * @brief 解压输出回调：把解压后的文本交给 JSON 解析器
+ */
+static int gzip_output_cb(void *ctx, const uint8_t *data, size_t len) {
+    weather_request_t *req = (weather_request_t *)ctx;
+    if (json_stream_feed(&req->json, (const char *)data, len) != ESP_OK) {
+        return Z_DATA_ERROR;
     }
-
-    cJSON_Delete(root);
-    // 记录解析成功的日志
-    ESP_LOGI(TAG, "Weather data parsed successfully: %.1f°C, %s", weather_now->temperature,
-             weather_now->text);
+    return Z_OK;
 }
 
 /**
- * @brief 解析每日天气预报 JSON 数据
+ * @brief HTTP 客户端事件处理回调函数
  *
- * 从 API 响应的 JSON 中提取多天的天气预报信息。
+ * 每收到一个数据块就立即解压并解析，不缓存响应体。
  *
- * @param json JSON 格式的天气预报数据字符串
- * @param weather_forecast 输出参数，解析后的天气预报数据结构体
+ * @param evt HTTP 客户端事件结构体
+ * @return esp_err_t 错误码
  */
-static void parse_weather_forecast(const char *json, weather_forecast_t *weather_forecast) {
-    if (weather_forecast == NULL || json == NULL) {
-        ESP_LOGE(TAG, "Invalid pointer parameters");
-        return;
-    }
-
-    // 解析 JSON 字符串
-    cJSON *root = cJSON_Parse(json);
-    if (root == NULL) {
-        ESP_LOGE(TAG, "Failed to parse weather forecast JSON");
-        return;
-    }
-
-    // 初始化天数为0
-    weather_forecast->count = 0;
-    memset(weather_forecast->daily, 0, sizeof(weather_forecast->daily));
+static esp_err_t http_event_handler(esp_http_client_event_t *evt) {
+    weather_request_t *req = (weather_request_t *)evt->user_data;
 
-    // 查找 daily 数组（天气预报数据）
-    cJSON *daily_array = cJSON_GetObjectItemCaseSensitive(root, "daily");
-    if (daily_array == NULL || !cJSON_IsArray(daily_array)) {
-        ESP_LOGE(TAG, "Missing 'daily' array in weather forecast response");
-        cJSON_Delete(root);
-        return;
-    }
+    switch (evt->event_id) {
+    case HTTP_EVENT_ON_HEADER:
+        http_cache_parse_header(&req->cache, evt->header_key, evt->header_value);
+        break;
 
-    // 遍历每一天的预报数据
-    cJSON *daily_item = NULL;
-    int day_index = 0;
-    cJSON_ArrayForEach(daily_item, daily_array) {
-        if (day_index >= 10) {
-            ESP_LOGW(TAG, "Weather forecast data exceeds maximum 10 days");
+    case HTTP_EVENT_ON_DATA:
+        if (req->err != ESP_OK || req->unchanged) {
             break;
         }
-
-        if (!cJSON_IsObject(daily_item)) {
-            continue;
-        }
-
-        weather_daily_t *daily = &weather_forecast->daily[day_index];
-        cJSON *item = NULL;
-
-        // 解析预报日期
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "fxDate");
-        if (cJSON_IsString(item)) {
-            strncpy(daily->fx_date, item->valuestring, sizeof(daily->fx_date) - 1);
-            daily->fx_date[sizeof(daily->fx_date) - 1] = '\0';
-        }
-
-        // 解析日出时间
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "sunrise");
-        if (cJSON_IsString(item)) {
-            strncpy(daily->sunrise, item->valuestring, sizeof(daily->sunrise) - 1);
-            daily->sunrise[sizeof(daily->sunrise) - 1] = '\0';
-        }
-
-        // 解析日落时间
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "sunset");
-        if (cJSON_IsString(item)) {
-            strncpy(daily->sunset, item->valuestring, sizeof(daily->sunset) - 1);
-            daily->sunset[sizeof(daily->sunset) - 1] = '\0';
-        }
-
-        // 解析月升时间
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "moonrise");
-        if (cJSON_IsString(item) && item->valuestring != NULL) {
-            strncpy(daily->moonrise, item->valuestring, sizeof(daily->moonrise) - 1);
-            daily->moonrise[sizeof(daily->moonrise) - 1] = '\0';
-        }
-
-        // 解析月落时间
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "moonset");
-        if (cJSON_IsString(item) && item->valuestring != NULL) {
-            strncpy(daily->moonset, item->valuestring, sizeof(daily->moonset) - 1);
-            daily->moonset[sizeof(daily->moonset) - 1] = '\0';
-        }
-
-        // 解析月相名称
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "moonPhase");
-        if (cJSON_IsString(item)) {
-            strncpy(daily->moon_phase, item->valuestring, sizeof(daily->moon_phase) - 1);
-            daily->moon_phase[sizeof(daily->moon_phase) - 1] = '\0';
-        }
-
-        // 解析月相图标
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "moonPhaseIcon");
-        if (cJSON_IsNumber(item)) {
-            daily->moon_phase_icon = (uint16_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->moon_phase_icon = (uint16_t)atoi(item->valuestring);
-        }
-
-        // 解析最高温度
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "tempMax");
-        if (cJSON_IsNumber(item)) {
-            daily->temp_max = (int8_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->temp_max = (int8_t)atoi(item->valuestring);
-        }
-
-        // 解析最低温度
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "tempMin");
-        if (cJSON_IsNumber(item)) {
-            daily->temp_min = (int8_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->temp_min = (int8_t)atoi(item->valuestring);
-        }
-
-        // 解析白天天气图标
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "iconDay");
-        if (cJSON_IsNumber(item)) {
-            daily->icon_day = (uint16_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->icon_day = (uint16_t)atoi(item->valuestring);
-        }
-
-        // 解析白天天气描述
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "textDay");
-        if (cJSON_IsString(item)) {
-            strncpy(daily->text_day, item->valuestring, sizeof(daily->text_day) - 1);
-            daily->text_day[sizeof(daily->text_day) - 1] = '\0';
-        }
-
-        // 解析夜间天气图标
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "iconNight");
-        if (cJSON_IsNumber(item)) {
-            daily->icon_night = (uint16_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->icon_night = (uint16_t)atoi(item->valuestring);
-        }
-
-        // 解析夜间天气描述
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "textNight");
-        if (cJSON_IsString(item)) {
-            strncpy(daily->text_night, item->valuestring, sizeof(daily->text_night) - 1);
-            daily->text_night[sizeof(daily->text_night) - 1] = '\0';
-        }
-
-        // 解析白天风向360度
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "wind360Day");
-        if (cJSON_IsNumber(item)) {
-            daily->wind_360_day = (uint16_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->wind_360_day = (uint16_t)atoi(item->valuestring);
-        }
-
-        // 解析白天风向名称
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "windDirDay");
-        if (cJSON_IsString(item)) {
-            strncpy(daily->wind_dir_day, item->valuestring, sizeof(daily->wind_dir_day) - 1);
-            daily->wind_dir_day[sizeof(daily->wind_dir_day) - 1] = '\0';
+        // 非 200 响应（如重定向或错误页）不参与解析
+        if (esp_http_client_get_status_code(evt->client) != 200) {
+            break;
         }
-
-        // 解析白天风力等级
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "windScaleDay");
-        if (cJSON_IsString(item)) {
-            strncpy(daily->wind_scale_day, item->valuestring, sizeof(daily->wind_scale_day) - 1);
-            daily->wind_scale_day[sizeof(daily->wind_scale_day) - 1] = '\0';
+        if (gzip_stream_feed(req->gzip, evt->data, evt->data_len) != Z_OK) {
+            req->err = ESP_ERR_INVALID_RESPONSE;
         }
+        break;
 
-        // 解析白天风速
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "windSpeedDay");
-        if (cJSON_IsNumber(item)) {
-            daily->wind_speed_day = (uint8_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->wind_speed_day = (uint8_t)atoi(item->valuestring);
-        }
+    default:
+        break;
+    }
 
-        // 解析夜间风向360度
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "wind360Night");
-        if (cJSON_IsNumber(item)) {
-            daily->wind_360_night = (uint16_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->wind_360_night = (uint16_t)atoi(item->valuestring);
-        }
+    return ESP_OK;
+}
 
-        // 解析夜间风向名称
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "windDirNight");
-        if (cJSON_IsString(item)) {
-            strncpy(daily->wind_dir_night, item->valuestring, sizeof(daily->wind_dir_night) - 1);
-            daily->wind_dir_night[sizeof(daily->wind_dir_night) - 1] = '\0';
-        }
+/**
+ * @brief 天气 API 地址的协议前缀
+ *
+ * api_host 通常只填域名，此时使用 HTTPS；也可以填写带协议的地址（如本地模拟服务器）。
+ */
+static const char *api_scheme(const char *api_host) {
+    return (strstr(api_host, "://") != NULL) ? "" : "https://";
+}
 
-        // 解析夜间风力等级
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "windScaleNight");
-        if (cJSON_IsString(item)) {
-            strncpy(daily->wind_scale_night, item->valuestring,
-                    sizeof(daily->wind_scale_night) - 1);
-            daily->wind_scale_night[sizeof(daily->wind_scale_night) - 1] = '\0';
-        }
+/**
+ * @brief 执行一次天气请求并流式解析响应
+ *
+ * 先查询响应缓存：max-age 内直接返回缓存结果；否则发起条件请求，
+ * 304 或 updateTime 未变化时返回缓存结果，200 时解析并写入缓存。
+ *
+ * @param url 请求 URL
+ * @param req 已设置 kind 和输出结构体的请求上下文
+ * @param out 输出结构体（与 req->out 相同）
+ * @param out_size 输出结构体大小
+ * @param updated 输出，数据是否有更新，可为 NULL
+ * @return esp_err_t 错误码，ESP_OK 表示成功
+ */
+static esp_err_t weather_request_perform(const char *url, weather_request_t *req, void *out,
+                                         size_t out_size, bool *updated) {
+    static bool s_tables_checked = false;
+    if (!s_tables_checked) {
+        json_bind_verify(&weather_now_desc);
+        json_bind_verify(&weather_daily_desc);
+        s_tables_checked = true;
+    }
 
-        // 解析夜间风速
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "windSpeedNight");
-        if (cJSON_IsNumber(item)) {
-            daily->wind_speed_night = (uint8_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->wind_speed_night = (uint8_t)atoi(item->valuestring);
-        }
+    if (updated != NULL) {
+        *updated = false;
+    }
 
-        // 解析相对湿度
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "humidity");
-        if (cJSON_IsNumber(item)) {
-            daily->humidity = (uint8_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->humidity = (uint8_t)atoi(item->valuestring);
-        }
+    // max-age 内直接使用缓存结果，不发请求
+    if (http_cache_get_fresh(url, out, out_size) == ESP_OK) {
+        return ESP_OK;
+    }
 
-        // 解析降水量
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "precip");
-        if (cJSON_IsNumber(item)) {
-            daily->precip = item->valuedouble;
-        } else if (cJSON_IsString(item)) {
-            daily->precip = strtod(item->valuestring, NULL);
-        }
+    // 接口熔断中：不发请求，调用方继续显示上一次的数据
+    if (!net_health_allow(NET_EP_WEATHER)) {
+        ESP_LOGW(TAG, "Weather endpoint circuit open, request skipped");
+        return ESP_ERR_NOT_ALLOWED;
+    }
 
-        // 解析大气压强
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "pressure");
-        if (cJSON_IsNumber(item)) {
-            daily->pressure = (uint16_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->pressure = (uint16_t)atoi(item->valuestring);
-        }
+    int64_t start_us = esp_timer_get_time();
+
+    // 初始化所有字段为零，解析过程中直接写入
+    memset(out, 0, out_size);
+    req->day_index = -1;
+    req->err = ESP_OK;
+    http_cache_meta_init(&req->cache);
+    json_stream_init(&req->json, &s_weather_json_callbacks, req);
+
+    // 从连接池获取客户端并执行 HTTP 请求
+    esp_http_client_handle_t client = http_pool_acquire(url, http_event_handler, req);
+    if (client == NULL) {
+        ESP_LOGE(TAG, "Failed to initialize HTTP client");
+        net_health_report(NET_EP_WEATHER, NET_FAIL_OTHER, 0);
+        return ESP_FAIL;
+    }
 
-        // 解析能见度
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "vis");
-        if (cJSON_IsNumber(item)) {
-            daily->vis = (uint8_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->vis = (uint8_t)atoi(item->valuestring);
-        }
+    // 复用长期持有的解压器，不在每次请求时重新分配 zlib 窗口
+    req->gzip = gzip_stream_acquire(gzip_output_cb, req);
+    if (req->gzip == NULL) {
+        http_pool_release(client);
+        net_health_report(NET_EP_WEATHER, NET_FAIL_OTHER, 0);
+        return ESP_ERR_NO_MEM;
+    }
 
-        // 解析云量
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "cloud");
-        if (cJSON_IsNumber(item)) {
-            daily->cloud = (uint8_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->cloud = (uint8_t)atoi(item->valuestring);
-        }
+    http_cache_prepare_request(url, client, req->cached_update_time,
+                               sizeof(req->cached_update_time));
 
-        // 解析紫外线指数
-        item = cJSON_GetObjectItemCaseSensitive(daily_item, "uvIndex");
-        if (cJSON_IsNumber(item)) {
-            daily->uv_index = (uint8_t)item->valueint;
-        } else if (cJSON_IsString(item)) {
-            daily->uv_index = (uint8_t)atoi(item->valuestring);
-        }
+    int64_t perform_start_us = esp_timer_get_time();
+    esp_err_t err = http_pool_perform(client);
+    metrics_observe(METRIC_HTTP_REQUEST, NET_EP_WEATHER, esp_timer_get_time() - perform_start_us);
+    int status = esp_http_client_get_status_code(client);
 
-        day_index++;
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "HTTPS Status = %d, content_length = %lld", status,
+                 esp_http_client_get_content_length(client));
+    } else {
+        ESP_LOGE(TAG, "HTTP request failed: %s", esp_err_to_name(err));
     }
 
-    weather_forecast->count = day_index;
-    cJSON_Delete(root);
-    ESP_LOGI(TAG, "Weather forecast data parsed successfully: %d days", day_index);
-}
+    net_fail_t fail = net_health_classify(client, err, status);
+    http_pool_release(client);
+
+    // 304 或 updateTime 未变化：沿用缓存结果，跳过解析
+    if (err == ESP_OK && (status == 304 || (status == 200 && req->unchanged))) {
+        net_health_report(NET_EP_WEATHER, NET_FAIL_NONE, status);
+        if (http_cache_revalidated(url, &req->cache, status == 304, out, out_size) == ESP_OK) {
+            ESP_LOGI(TAG, "Weather data not modified (%s)",
+                     status == 304 ? "304" : "same updateTime");
+            gzip_stream_release(req->gzip, true);
+            return ESP_OK;
+        }
+        ESP_LOGW(TAG, "Cached result missing for unchanged response");
+        gzip_stream_release(req->gzip, false);
+        return ESP_ERR_INVALID_STATE;
+    }
 
-/**
- * @brief HTTP 客户端事件处理回调函数
- *
- * 处理 HTTP 请求的各个阶段事件，积累响应数据。
- * 使用内存重新分配来接收完整的 GZIP 压缩响应数据。
- *
- * @param evt HTTP 客户端事件结构体
- * @return esp_err_t 错误码
- */
-static esp_err_t http_event_handler(esp_http_client_event_t *evt) {
-    // 使用静态变量缓存压缩响应数据
-    static char *response_buf = NULL; /**< 响应数据缓冲区 */
-    static int total_len = 0;         /**< 已接收数据总长度 */
+    if (err == ESP_OK && status != 200) {
+        ESP_LOGE(TAG, "Unexpected HTTP status %d", status);
+        err = ESP_ERR_INVALID_RESPONSE;
+    }
+    if (err == ESP_OK && req->err != ESP_OK) {
+        err = req->err;
+    }
+    if (err == ESP_OK && req->gzip->total_in == 0) {
+        ESP_LOGE(TAG, "No response data received");
+        err = ESP_ERR_INVALID_RESPONSE;
+    }
+    if (err == ESP_OK && gzip_stream_finish(req->gzip) != Z_OK) {
+        err = ESP_ERR_INVALID_RESPONSE;
+    }
+    if (err == ESP_OK && json_stream_finish(&req->json) != ESP_OK) {
+        err = ESP_ERR_INVALID_RESPONSE;
+    }
+    if (err == ESP_OK && !req->found) {
+        ESP_LOGE(TAG, "Missing '%s' in weather response",
+                 req->kind == WEATHER_REQUEST_NOW ? "now" : "daily");
+        err = ESP_ERR_INVALID_RESPONSE;
+    }
 
-    switch (evt->event_id) {
-    case HTTP_EVENT_ON_HEADER:
-        // 在收到响应头时重置缓冲区
-        total_len = 0;
-        heap_caps_free(response_buf); // 释放之前分配的内存
-        response_buf = NULL;
-        break;
+    ESP_LOGI(TAG, "Streamed %u compressed -> %u bytes in %lld us (bind %lld us)",
+             (unsigned)req->gzip->total_in, (unsigned)req->gzip->total_out,
+             esp_timer_get_time() - start_us, req->bind_us);
 
-    case HTTP_EVENT_ON_DATA:
-        // 接收响应数据块
-        total_len += evt->data_len;
-        char *tmp = heap_caps_realloc(response_buf, total_len, MALLOC_CAP_SPIRAM);
-        if (tmp == NULL) {
-            ESP_LOGE(TAG, "Failed to allocate memory for response buffer");
-            heap_caps_free(response_buf);
-            response_buf = NULL;
-            return ESP_ERR_NO_MEM;
-        }
-        response_buf = tmp;
-        memcpy(response_buf + total_len - evt->data_len, evt->data, evt->data_len);
-        break;
+    // 传输层与状态码正常但内容无法解析，同样计入接口失败
+    if (fail == NET_FAIL_NONE && err != ESP_OK) {
+        fail = NET_FAIL_PARSE;
+    }
+    net_health_report(NET_EP_WEATHER, fail, status);
 
-    case HTTP_EVENT_ON_FINISH:
-        // 响应接收完成
-        if (response_buf != NULL && total_len > 0) {
-            // 将数据转移到用户提供的结构体
-            response_data_t *response_data = (response_data_t *)evt->user_data;
-            response_data->data = response_buf;
-            response_data->data_len = total_len;
-            response_buf = NULL;
-            total_len = 0;
+    if (err == ESP_OK) {
+        http_cache_store(url, &req->cache, req->update_time, out, out_size, req->gzip->total_in);
+        if (updated != NULL) {
+            *updated = true;
         }
-        break;
-
-    case HTTP_EVENT_ERROR:
-    case HTTP_EVENT_DISCONNECTED:
-        // 清理错误状态下的内存
-        heap_caps_free(response_buf);
-        response_buf = NULL;
-        total_len = 0;
-        break;
-
-    default:
-        break;
     }
 
-    return ESP_OK;
+    gzip_stream_release(req->gzip, err == ESP_OK);
+    return err;
 }
 
 /**
@@ -520,10 +495,15 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt) {
  *
  * @param location 位置信息结构体，包含经纬度坐标
  * @param weather_now 输出参数，包含当前天气数据的结构体
+ * @param updated 输出参数，数据是否较上次有更新（未更新时结果来自缓存），可为 NULL
  * @return esp_err_t 错误码，ESP_OK 表示成功
  */
-esp_err_t get_weather_now(location_t *location, weather_now_t *weather_now) {
-    response_data_t response_data = {.data = NULL, .data_len = 0};
+esp_err_t get_weather_now(location_t *location, weather_now_t *weather_now, bool *updated) {
+    // 参数有效性检查
+    if (location == NULL || weather_now == NULL) {
+        ESP_LOGE(TAG, "Invalid pointer parameters");
+        return ESP_ERR_INVALID_ARG;
+    }
 
     // 获取天气 API 配置
     sys_config_t sys_config;
@@ -537,66 +517,33 @@ esp_err_t get_weather_now(location_t *location, weather_now_t *weather_now) {
 
     // 构建 API 请求 URL
     char url[256];
-    snprintf(url, sizeof(url), "https://%s/v7/weather/now?location=%.2f,%.2f&key=%s",
-             sys_config.weather.api_host, location->longitude, location->latitude,
-             sys_config.weather.api_key);
-
-    // 配置 HTTP 客户端
-    esp_http_client_config_t config = {.url = url,
-                                       .event_handler = http_event_handler,
-                                       .crt_bundle_attach = esp_crt_bundle_attach,
-                                       .user_data = &response_data};
-
-    // 初始化并执行 HTTP 请求
-    esp_http_client_handle_t client = esp_http_client_init(&config);
-
-    esp_err_t err = esp_http_client_perform(client);
-
-    if (err == ESP_OK) {
-        ESP_LOGI(TAG, "HTTPS Status = %d, content_length = %lld",
-                 esp_http_client_get_status_code(client),
-                 esp_http_client_get_content_length(client));
-    } else {
-        ESP_LOGE(TAG, "HTTP request failed: %s", esp_err_to_name(err));
-        esp_http_client_cleanup(client);
-        return err;
+    snprintf(url, sizeof(url), "%s%s/v7/weather/now?location=%.2f,%.2f&key=%s",
+             api_scheme(sys_config.weather.api_host), sys_config.weather.api_host,
+             location->longitude, location->latitude, sys_config.weather.api_key);
+
+    weather_request_t *req = heap_caps_calloc(1, sizeof(weather_request_t), MALLOC_CAP_SPIRAM);
+    if (req == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate request context");
+        return ESP_ERR_NO_MEM;
     }
 
-    esp_http_client_cleanup(client);
-
-    // 处理响应数据
-    if (response_data.data != NULL && response_data.data_len > 0) {
-        // 分配解压缩缓冲区
-        size_t decompressed_size = 0;
-        char *decompressed_buf = (char *)heap_caps_malloc(4096, MALLOC_CAP_SPIRAM);
-        if (decompressed_buf == NULL) {
-            ESP_LOGE(TAG, "Failed to allocate memory for decompressed buffer");
-            heap_caps_free(response_data.data);
-            return ESP_ERR_NO_MEM;
-        }
-
-        // 解压缩 GZIP 数据
-        int decompress_result = network_gzip_decompress(response_data.data, response_data.data_len,
-                                                        decompressed_buf, &decompressed_size, 4096);
-        if (decompress_result != Z_OK) {
-            ESP_LOGE(TAG, "Failed to decompress response data: %d", decompress_result);
-            heap_caps_free(decompressed_buf);
-            heap_caps_free(response_data.data);
-            return ESP_FAIL;
-        }
+    req->kind = WEATHER_REQUEST_NOW;
+    req->out.now = weather_now;
 
-        // 解析 JSON 数据
-        parse_weather_now(decompressed_buf, weather_now);
+    bool fetched = false;
+    esp_err_t err = weather_request_perform(url, req, weather_now, sizeof(weather_now_t), &fetched);
+    heap_caps_free(req);
 
-        // 释放内存
-        heap_caps_free(decompressed_buf);
-        heap_caps_free(response_data.data);
-    } else {
-        ESP_LOGE(TAG, "No response data received");
-        return ESP_ERR_INVALID_RESPONSE;
+    if (updated != NULL) {
+        *updated = fetched;
     }
 
-    return ESP_OK;
+    if (err == ESP_OK && fetched) {
+        // 记录解析成功的日志
+        ESP_LOGI(TAG, "Weather data parsed successfully: %.1f°C, %s", weather_now->temperature,
+                 weather_now->text);
+    }
+    return err;
 }
 
 /**
@@ -608,12 +555,11 @@ esp_err_t get_weather_now(location_t *location, weather_now_t *weather_now) {
  * @param location 位置信息结构体，包含经纬度坐标
  * @param days 预报天数，可选值：3, 7, 10, 15, 30
  * @param weather_forecast 输出参数，包含多天天气预报数据的结构体
+ * @param updated 输出参数，数据是否较上次有更新（未更新时结果来自缓存），可为 NULL
  * @return esp_err_t 错误码，ESP_OK 表示成功
  */
 esp_err_t get_weather_forecast(location_t *location, uint8_t days,
-                               weather_forecast_t *weather_forecast) {
-    response_data_t response_data = {.data = NULL, .data_len = 0};
-
+                               weather_forecast_t *weather_forecast, bool *updated) {
     // 参数有效性检查
     if (location == NULL || weather_forecast == NULL) {
         ESP_LOGE(TAG, "Invalid pointer parameters");
@@ -637,64 +583,31 @@ esp_err_t get_weather_forecast(location_t *location, uint8_t days,
 
     // 构建 API 请求 URL，根据天数选择端点
     char url[256];
-    snprintf(url, sizeof(url), "https://%s/v7/weather/%dd?location=%.2f,%.2f&key=%s",
-             sys_config.weather.api_host, days, location->longitude, location->latitude,
-             sys_config.weather.api_key);
-
-    // 配置 HTTP 客户端
-    esp_http_client_config_t config = {.url = url,
-                                       .event_handler = http_event_handler,
-                                       .crt_bundle_attach = esp_crt_bundle_attach,
-                                       .user_data = &response_data};
-
-    // 初始化并执行 HTTP 请求
-    esp_http_client_handle_t client = esp_http_client_init(&config);
-
-    esp_err_t err = esp_http_client_perform(client);
-
-    if (err == ESP_OK) {
-        ESP_LOGI(TAG, "HTTPS Status = %d, content_length = %lld",
-                 esp_http_client_get_status_code(client),
-                 esp_http_client_get_content_length(client));
-    } else {
-        ESP_LOGE(TAG, "HTTP request failed: %s", esp_err_to_name(err));
-        esp_http_client_cleanup(client);
-        return err;
+    snprintf(url, sizeof(url), "%s%s/v7/weather/%dd?location=%.2f,%.2f&key=%s",
+             api_scheme(sys_config.weather.api_host), sys_config.weather.api_host, days,
+             location->longitude, location->latitude, sys_config.weather.api_key);
+
+    weather_request_t *req = heap_caps_calloc(1, sizeof(weather_request_t), MALLOC_CAP_SPIRAM);
+    if (req == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate request context");
+        return ESP_ERR_NO_MEM;
     }
 
-    esp_http_client_cleanup(client);
-
-    // 处理响应数据
-    if (response_data.data != NULL && response_data.data_len > 0) {
-        // 分配解压缩缓冲区
-        size_t decompressed_size = 0;
-        char *decompressed_buf = (char *)heap_caps_malloc(8192, MALLOC_CAP_SPIRAM);
-        if (decompressed_buf == NULL) {
-            ESP_LOGE(TAG, "Failed to allocate memory for decompressed buffer");
-            heap_caps_free(response_data.data);
-            return ESP_ERR_NO_MEM;
-        }
-
-        // 解压缩 GZIP 数据
-        int decompress_result = network_gzip_decompress(response_data.data, response_data.data_len,
-                                                        decompressed_buf, &decompressed_size, 8192);
-        if (decompress_result != Z_OK) {
-            ESP_LOGE(TAG, "Failed to decompress response data: %d", decompress_result);
-            heap_caps_free(decompressed_buf);
-            heap_caps_free(response_data.data);
-            return ESP_FAIL;
-        }
+    req->kind = WEATHER_REQUEST_FORECAST;
+    req->out.forecast = weather_forecast;
 
-        // 解析 JSON 数据
-        parse_weather_forecast(decompressed_buf, weather_forecast);
+    bool fetched = false;
+    esp_err_t err = weather_request_perform(url, req, weather_forecast, sizeof(weather_forecast_t),
+                                            &fetched);
+    heap_caps_free(req);
 
-        // 释放内存
-        heap_caps_free(decompressed_buf);
-        heap_caps_free(response_data.data);
-    } else {
-        ESP_LOGE(TAG, "No response data received");
-        return ESP_ERR_INVALID_RESPONSE;
+    if (updated != NULL) {
+        *updated = fetched;
     }
 
-    return ESP_OK;
-}
\ No newline at end of file
+    if (err == ESP_OK && fetched) {
+        ESP_LOGI(TAG, "Weather forecast data parsed successfully: %d days",
+                 weather_forecast->count);
+    }
+    return err;
+}
@@ -0,0 +1,405 @@
+/**
+ * @file weather_multi.c
+ * @brief 多位置天气缓存实现
+ *
+ * 所有槽位与请求暂存区位于同一块 PSRAM 中，初始化时分配一次，之后不再申请内存。
+ * 请求结果先写入暂存区，成功后在互斥锁内复制到槽位，界面读取时不会看到写了一半的数据，
+ * 请求失败时槽位保留上一次的有效数据。
+ *
+ * 所有位置使用同一个天气主机，请求经由连接池时复用同一条 keep-alive 连接。
+ *
+ * @author
+ * @date YYYY-MM-DD
+ */
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config_manager.h"
+#include "http_cache.h"
+#include "weather_multi.h"
+#include "weather_snapshot.h"
+
+/** @brief 日志标签 */
+#define TAG "weather_multi"
+
+/** @brief 坐标变化小于该值（度）时视为同一位置（天气请求按两位小数取坐标） */
+#define LOCATION_EPSILON 0.005
+
+// 每个位置的实时天气与预报 URL 都需要缓存条目，否则一轮刷新中互相淘汰，条件请求全部失效
+_Static_assert(HTTP_CACHE_SIZE >= WEATHER_MAX_LOCATIONS * 2,
+               "HTTP_CACHE_SIZE must hold now + forecast for every location");
+
+/**
+ * @brief 单个位置的缓存
+ */
+typedef struct {
+    bool valid;                  ///< 是否已有实时天气
+    bool has_forecast;           ///< 是否已有预报
+    bool forecast_wanted;        ///< 预报是否被读取过（按需获取）
+    int64_t forecast_at_us;      ///< 预报获取时间（esp_timer 时间）
+    int64_t forecast_read_us;    ///< 预报最近一次被读取的时间（esp_timer 时间）
+    location_t location;         ///< 位置
+    weather_now_t now;           ///< 实时天气
+    weather_forecast_t forecast; ///< 天气预报
+} weather_slot_t;
+
+/**
+ * @brief 槽位与请求暂存区（一次分配）
+ */
+typedef struct {
+    weather_slot_t slots[WEATHER_MAX_LOCATIONS];  ///< 位置槽位
+    location_t extras[WEATHER_MAX_LOCATIONS - 1]; ///< 从配置解析出的额外位置
+    location_t location;                          ///< 请求使用的位置
+    weather_now_t now;                            ///< 实时天气请求结果
+    weather_forecast_t forecast;                  ///< 预报请求结果
+} weather_slab_t;
+
+static weather_slab_t *s_slab = NULL;
+static SemaphoreHandle_t s_mutex = NULL;
+static uint8_t s_count = 1;
+static weather_multi_stats_t s_stats = {
+    .count = 1,
+    .last_refresh_ms = -1,
+    .max_refresh_ms = -1,
+    .avg_refresh_ms = -1,
+};
+static int64_t s_total_refresh_ms = 0;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+/**
+ * @brief 解析配置中的额外位置
+ *
+ * 格式为 "名称,纬度,经度"，以分号分隔；格式错误或坐标越界的条目被跳过。
+ *
+ * @param spec 配置字符串
+ * @param out 输出位置数组（只填写名称与坐标）
+ * @param max 数组容量
+ * @return 解析出的位置数
+ */
+static uint8_t parse_locations(const char *spec, location_t *out, uint8_t max) {
+    char buf[sizeof(((sys_config_t *)0)->weather.locations)];
+    snprintf(buf, sizeof(buf), "%s", spec);
+
+    uint8_t count = 0;
+    char *save = NULL;
+    for (char *entry = strtok_r(buf, ";", &save); entry != NULL && count < max;
+         entry = strtok_r(NULL, ";", &save)) {
+        char *lat_str = strchr(entry, ',');
+        char *lon_str = (lat_str != NULL) ? strchr(lat_str + 1, ',') : NULL;
+        if (lon_str == NULL) {
+            ESP_LOGW(TAG, "Ignoring location entry: %s", entry);
+            continue;
+        }
+        *lat_str++ = '\0';
+        *lon_str++ = '\0';
+
+        char *end_lat = NULL;
+        char *end_lon = NULL;
+        double latitude = strtod(lat_str, &end_lat);
+        double longitude = strtod(lon_str, &end_lon);
+        if (end_lat == lat_str || end_lon == lon_str || fabs(latitude) > 90.0 ||
+            fabs(longitude) > 180.0) {
+            ESP_LOGW(TAG, "Ignoring location with invalid coordinates: %s", entry);
+            continue;
+        }
+
+        while (*entry == ' ') {
+            entry++;
+        }
+
+        location_t *location = &out[count++];
+        memset(location, 0, sizeof(location_t));
+        snprintf(location->city, WEATHER_LOCATION_NAME_MAX, "%s", entry);
+        location->latitude = latitude;
+        location->longitude = longitude;
+    }
+    return count;
+}
+
+/**
+ * @brief 更新槽位的位置，坐标变化时清空已缓存的天气
+ *
+ * 调用方需持有 s_mutex。
+ */
+static void slot_set_location(weather_slot_t *slot, const location_t *location) {
+    if (fabs(slot->location.latitude - location->latitude) >= LOCATION_EPSILON ||
+        fabs(slot->location.longitude - location->longitude) >= LOCATION_EPSILON) {
+        slot->valid = false;
+        slot->has_forecast = false;
+    }
+    slot->location = *location;
+}
+
+/**
+ * @brief 位置的预报是否需要请求（需持有互斥锁）
+ *
+ * 只在界面读取过、且最近 WEATHER_FORECAST_IDLE_S 内仍在读取时请求；已有预报时按
+ * WEATHER_FORECAST_REFRESH_S 刷新。
+ */
+static bool forecast_due_locked(const weather_slot_t *slot, int64_t now_us) {
+    if (!slot->forecast_wanted ||
+        now_us - slot->forecast_read_us >= (int64_t)WEATHER_FORECAST_IDLE_S * 1000000) {
+        return false;
+    }
+    return !slot->has_forecast ||
+           now_us - slot->forecast_at_us >= (int64_t)WEATHER_FORECAST_REFRESH_S * 1000000;
+}
+
+/**
+ * @brief 获取单个位置的实时天气与（界面需要且到期时的）预报
+ *
+ * @param index 位置序号，位置已写入槽位
+ * @param changed 数据有更新时置位
+ * @return 实时天气的获取结果；预报失败只计入统计，熔断时返回 ESP_ERR_NOT_ALLOWED
+ */
+static esp_err_t refresh_slot(uint8_t index, uint32_t *changed) {
+    weather_slot_t *slot = &s_slab->slots[index];
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    s_slab->location = slot->location;
+    bool need_forecast = forecast_due_locked(slot, esp_timer_get_time());
+    s_stats.requests++;
+    xSemaphoreGive(s_mutex);
+
+    bool updated = false;
+    esp_err_t err = get_weather_now(&s_slab->location, &s_slab->now, &updated);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "[%d] %s: weather now failed: %s", index, s_slab->location.city,
+                 esp_err_to_name(err));
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        s_stats.failures++;
+        xSemaphoreGive(s_mutex);
+        return err;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (updated || !slot->valid) {
+        *changed |= 1u << index;
+    }
+    slot->now = s_slab->now;
+    slot->valid = true;
+    xSemaphoreGive(s_mutex);
+
+    if (index == 0 && updated) {
+        // 持久化当前位置，供下次开机时在联网前显示
+        weather_snapshot_save_now(&s_slab->now, &s_slab->location);
+    }
+
+    if (!need_forecast) {
+        return ESP_OK;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    s_stats.requests++;
+    xSemaphoreGive(s_mutex);
+
+    updated = false;
+    esp_err_t fc_err =
+        get_weather_forecast(&s_slab->location, WEATHER_FORECAST_DAYS, &s_slab->forecast, &updated);
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (fc_err == ESP_OK) {
+        slot->forecast = s_slab->forecast;
+        slot->has_forecast = true;
+        slot->forecast_at_us = esp_timer_get_time();
+    } else {
+        s_stats.failures++;
+    }
+    xSemaphoreGive(s_mutex);
+
+    if (fc_err != ESP_OK) {
+        ESP_LOGW(TAG, "[%d] %s: forecast failed: %s", index, s_slab->location.city,
+                 esp_err_to_name(fc_err));
+        return (fc_err == ESP_ERR_NOT_ALLOWED) ? fc_err : ESP_OK;
+    }
+    if (index == 0 && updated) {
+        weather_snapshot_save_forecast(&s_slab->forecast);
+    }
+    return ESP_OK;
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t weather_multi_init(void) {
+    if (s_mutex != NULL) {
+        return ESP_OK;
+    }
+
+    s_slab = heap_caps_calloc(1, sizeof(weather_slab_t), MALLOC_CAP_SPIRAM);
+    s_mutex = xSemaphoreCreateMutex();
+    if (s_slab == NULL || s_mutex == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate location slots");
+        heap_caps_free(s_slab);
+        s_slab = NULL;
+        if (s_mutex != NULL) {
+            vSemaphoreDelete(s_mutex);
+            s_mutex = NULL;
+        }
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "Allocated %d location slots (%u bytes)", WEATHER_MAX_LOCATIONS,
+             (unsigned)sizeof(weather_slab_t));
+    return ESP_OK;
+}
+
+esp_err_t weather_multi_refresh(const location_t *current, uint32_t *changed) {
+    if (s_mutex == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    uint32_t changed_mask = 0;
+    int64_t start = esp_timer_get_time();
+
+    // 额外位置每次从配置中解析，网页修改后下一轮生效
+    sys_config_t sys_config;
+    config_manager_get_config(&sys_config);
+    location_t *extras = s_slab->extras;
+    uint8_t extra_count =
+        parse_locations(sys_config.weather.locations, extras, WEATHER_MAX_LOCATIONS - 1);
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (current != NULL) {
+        slot_set_location(&s_slab->slots[0], current);
+    }
+    for (uint8_t i = 0; i < extra_count; i++) {
+        slot_set_location(&s_slab->slots[i + 1], &extras[i]);
+    }
+    for (uint8_t i = extra_count + 1; i < WEATHER_MAX_LOCATIONS; i++) {
+        memset(&s_slab->slots[i], 0, sizeof(weather_slot_t));
+    }
+    s_count = extra_count + 1;
+    xSemaphoreGive(s_mutex);
+
+    // 依次获取，同一主机的请求复用连接池中的连接
+    esp_err_t result = ESP_OK;
+    bool result_set = false;
+    for (uint8_t i = (current != NULL) ? 0 : 1; i < s_count; i++) {
+        esp_err_t err = refresh_slot(i, &changed_mask);
+        if (!result_set) {
+            result = err;
+            result_set = true;
+        }
+        if (err == ESP_ERR_NOT_ALLOWED) {
+            // 接口熔断中，本轮剩余位置不再请求
+            ESP_LOGW(TAG, "Endpoint circuit open, skipping remaining locations");
+            break;
+        }
+    }
+
+    int64_t elapsed_ms = (esp_timer_get_time() - start) / 1000;
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    s_stats.refreshes++;
+    s_stats.last_refresh_ms = elapsed_ms;
+    if (elapsed_ms > s_stats.max_refresh_ms) {
+        s_stats.max_refresh_ms = elapsed_ms;
+    }
+    s_total_refresh_ms += elapsed_ms;
+    xSemaphoreGive(s_mutex);
+
+    ESP_LOGI(TAG, "Refreshed %d locations in %lld ms (changed mask 0x%02lx)", s_count,
+             (long long)elapsed_ms, (unsigned long)changed_mask);
+
+    if (changed != NULL) {
+        *changed = changed_mask;
+    }
+    return result;
+}
+
+uint8_t weather_multi_count(void) {
+    if (s_mutex == NULL) {
+        return 1;
+    }
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    uint8_t count = s_count;
+    xSemaphoreGive(s_mutex);
+    return count;
+}
+
+esp_err_t weather_multi_get(uint8_t index, weather_now_t *weather_now, location_t *location) {
+    if (weather_now == NULL || index >= WEATHER_MAX_LOCATIONS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_mutex == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (index >= s_count) {
+        xSemaphoreGive(s_mutex);
+        return ESP_ERR_INVALID_ARG;
+    }
+    const weather_slot_t *slot = &s_slab->slots[index];
+    if (!slot->valid) {
+        xSemaphoreGive(s_mutex);
+        return ESP_ERR_NOT_FOUND;
+    }
+    *weather_now = slot->now;
+    if (location != NULL) {
+        *location = slot->location;
+    }
+    xSemaphoreGive(s_mutex);
+    return ESP_OK;
+}
+
+esp_err_t weather_multi_get_forecast(uint8_t index, weather_forecast_t *forecast) {
+    if (forecast == NULL || index >= WEATHER_MAX_LOCATIONS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_mutex == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (index >= s_count) {
+        xSemaphoreGive(s_mutex);
+        return ESP_ERR_INVALID_ARG;
+    }
+    weather_slot_t *slot = &s_slab->slots[index];
+    slot->forecast_wanted = true;
+    slot->forecast_read_us = esp_timer_get_time();
+    if (!slot->has_forecast) {
+        xSemaphoreGive(s_mutex);
+        return ESP_ERR_NOT_FOUND;
+    }
+    *forecast = slot->forecast;
+    xSemaphoreGive(s_mutex);
+    return ESP_OK;
+}
+
+void weather_multi_get_stats(weather_multi_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    if (s_mutex == NULL) {
+        *stats = s_stats;
+        return;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    *stats = s_stats;
+    stats->count = s_count;
+    stats->valid = 0;
+    for (uint8_t i = 0; i < s_count; i++) {
+        if (s_slab->slots[i].valid) {
+            stats->valid++;
+        }
+    }
+    if (s_stats.refreshes > 0) {
+        stats->avg_refresh_ms = s_total_refresh_ms / s_stats.refreshes;
+    }
+    xSemaphoreGive(s_mutex);
+}
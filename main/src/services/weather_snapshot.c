@@ -0,0 +1,226 @@
+/**
+ * @file weather_snapshot.c
+ * @brief 天气 / 预报 / 位置快照的持久化实现
+ *
+ * 快照以 blob 形式保存在独立的 NVS 命名空间中（NVS 写入是原子的，掉电不会留下半条记录），
+ * 每条记录由记录头和结构体原始内容组成。读取时校验结构版本与长度，不匹配视为无快照。
+ */
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "nvs.h"
+#include <stdint.h>
+#include <string.h>
+
+#include "weather_snapshot.h"
+
+#define TAG "weather_snapshot"
+#define SNAPSHOT_NVS_NAMESPACE "wx_snapshot"
+
+/** @brief 实时天气 + 位置 */
+#define SNAPSHOT_KEY_NOW "now"
+/** @brief 天气预报 */
+#define SNAPSHOT_KEY_FORECAST "forecast"
+
+/** @brief 早于该时间（2024-01-01）的系统时间视为尚未同步 */
+#define SNAPSHOT_MIN_VALID_TIME 1704067200
+
+/**
+ * @brief 记录头
+ */
+typedef struct {
+    uint16_t schema;  ///< 结构版本
+    uint16_t reserved;
+    uint32_t size;    ///< 数据长度（不含记录头）
+    int64_t saved_at; ///< 保存时间，0 表示保存时系统时间未同步
+} snapshot_header_t;
+
+/**
+ * @brief 实时天气记录内容
+ */
+typedef struct {
+    weather_now_t weather_now;
+    location_t location;
+} snapshot_now_t;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+static bool time_is_valid(time_t t) { return t >= SNAPSHOT_MIN_VALID_TIME; }
+
+/**
+ * @brief 读取一条记录到 buf（记录头 + 数据）
+ */
+static esp_err_t snapshot_read(nvs_handle_t nvs, const char *key, uint8_t *buf, size_t size) {
+    size_t length = size;
+    esp_err_t err = nvs_get_blob(nvs, key, buf, &length);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    const snapshot_header_t *header = (const snapshot_header_t *)buf;
+    if (length != size || header->schema != WEATHER_SNAPSHOT_SCHEMA_VERSION ||
+        header->size != size - sizeof(snapshot_header_t)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief 写入一条记录，数据与已有记录相同时跳过
+ */
+static esp_err_t snapshot_write(const char *key, const void *data, size_t size) {
+    size_t record_size = sizeof(snapshot_header_t) + size;
+    uint8_t *record = heap_caps_malloc(record_size, MALLOC_CAP_SPIRAM);
+    uint8_t *stored = heap_caps_malloc(record_size, MALLOC_CAP_SPIRAM);
+    if (record == NULL || stored == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate %u bytes for snapshot", (unsigned)record_size);
+        heap_caps_free(record);
+        heap_caps_free(stored);
+        return ESP_ERR_NO_MEM;
+    }
+
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(SNAPSHOT_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "nvs_open failed: %s", esp_err_to_name(err));
+        goto cleanup;
+    }
+
+    // 内容未变化时不写 flash（例如位置不变时）
+    if (snapshot_read(nvs, key, stored, record_size) == ESP_OK &&
+        memcmp(stored + sizeof(snapshot_header_t), data, size) == 0) {
+        ESP_LOGD(TAG, "%s unchanged, skip writing", key);
+        nvs_close(nvs);
+        goto cleanup;
+    }
+
+    time_t now = time(NULL);
+    snapshot_header_t header = {
+        .schema = WEATHER_SNAPSHOT_SCHEMA_VERSION,
+        .size = (uint32_t)size,
+        .saved_at = time_is_valid(now) ? (int64_t)now : 0,
+    };
+    memcpy(record, &header, sizeof(header));
+    memcpy(record + sizeof(header), data, size);
+
+    err = nvs_set_blob(nvs, key, record, record_size);
+    if (err == ESP_OK) {
+        err = nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to save %s: %s", key, esp_err_to_name(err));
+    } else {
+        ESP_LOGI(TAG, "Saved %s snapshot (%u bytes)", key, (unsigned)record_size);
+    }
+
+cleanup:
+    heap_caps_free(record);
+    heap_caps_free(stored);
+    return err;
+}
+
+/**
+ * @brief 读取一条记录的数据部分
+ */
+static esp_err_t snapshot_load(const char *key, void *data, size_t size, time_t *saved_at) {
+    size_t record_size = sizeof(snapshot_header_t) + size;
+    uint8_t *record = heap_caps_malloc(record_size, MALLOC_CAP_SPIRAM);
+    if (record == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(SNAPSHOT_NVS_NAMESPACE, NVS_READONLY, &nvs);
+    if (err == ESP_OK) {
+        err = snapshot_read(nvs, key, record, record_size);
+        nvs_close(nvs);
+    }
+
+    if (err == ESP_OK) {
+        const snapshot_header_t *header = (const snapshot_header_t *)record;
+        memcpy(data, record + sizeof(snapshot_header_t), size);
+        if (saved_at != NULL) {
+            *saved_at = (time_t)header->saved_at;
+        }
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        // 首次启动时命名空间或记录不存在
+        err = ESP_ERR_NOT_FOUND;
+    } else if (err == ESP_ERR_NOT_FOUND || err == ESP_ERR_NVS_INVALID_LENGTH) {
+        ESP_LOGW(TAG, "%s snapshot has an old layout, ignored", key);
+        err = ESP_ERR_NOT_FOUND;
+    }
+
+    heap_caps_free(record);
+    return err;
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t weather_snapshot_save_now(const weather_now_t *weather_now, const location_t *location) {
+    if (weather_now == NULL || location == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    snapshot_now_t *snapshot = heap_caps_calloc(1, sizeof(snapshot_now_t), MALLOC_CAP_SPIRAM);
+    if (snapshot == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    snapshot->weather_now = *weather_now;
+    snapshot->location = *location;
+
+    esp_err_t err = snapshot_write(SNAPSHOT_KEY_NOW, snapshot, sizeof(snapshot_now_t));
+    heap_caps_free(snapshot);
+    return err;
+}
+
+esp_err_t weather_snapshot_save_forecast(const weather_forecast_t *forecast) {
+    if (forecast == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return snapshot_write(SNAPSHOT_KEY_FORECAST, forecast, sizeof(weather_forecast_t));
+}
+
+esp_err_t weather_snapshot_load_now(weather_now_t *weather_now, location_t *location,
+                                    time_t *saved_at) {
+    if (weather_now == NULL || location == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    snapshot_now_t *snapshot = heap_caps_malloc(sizeof(snapshot_now_t), MALLOC_CAP_SPIRAM);
+    if (snapshot == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = snapshot_load(SNAPSHOT_KEY_NOW, snapshot, sizeof(snapshot_now_t), saved_at);
+    if (err == ESP_OK) {
+        *weather_now = snapshot->weather_now;
+        *location = snapshot->location;
+    }
+    heap_caps_free(snapshot);
+    return err;
+}
+
+esp_err_t weather_snapshot_load_forecast(weather_forecast_t *forecast, time_t *saved_at) {
+    if (forecast == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return snapshot_load(SNAPSHOT_KEY_FORECAST, forecast, sizeof(weather_forecast_t), saved_at);
+}
+
+bool weather_snapshot_is_stale(time_t timestamp, int stale_minutes) {
+    if (stale_minutes <= 0) {
+        stale_minutes = WEATHER_SNAPSHOT_DEFAULT_STALE_MIN;
+    }
+
+    time_t now = time(NULL);
+    if (!time_is_valid(now) || !time_is_valid(timestamp) || now < timestamp) {
+        return true;
+    }
+    return (now - timestamp) > (time_t)stale_minutes * 60;
+}
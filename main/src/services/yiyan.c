@@ -4,129 +4,158 @@
  *
  * 本模块通过在线 API 获取随机的日本动画、漫画、游戏等来源的经典句子。
  * 支持功能：
- * - 从 hitokoto.cn API 获取随机句子
- * - 解析 JSON 响应并提取句子内容
- * - 自动内存管理
+ * - 在一个联网窗口内批量获取句子，按内容哈希去重
+ * - 句子保存在 FAT 分区的环形缓冲区中，重启和离线时仍可显示
+ * - 界面轮换显示时只读取本地句子，不发起网络请求
+ *
+ * 句子环文件先写入临时文件再替换，掉电时最多丢失最近一次补充的句子。
+ * 显示位置只在补充时写入 flash，重启后可能重复显示少量句子。
  *
  * @author
  * @date YYYY-MM-DD
  */
 
 #include "cJSON.h"
-#include "esp_crt_bundle.h"
 #include "esp_heap_caps.h"
 #include "esp_http_client.h"
 #include "esp_log.h"
-#include "esp_wifi.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
-#include "vars.h"
+#include "config_manager.h"
+#include "http_pool.h"
+#include "json_bind.h"
+#include "metrics.h"
+#include "net_health.h"
 
 #include "yiyan.h"
 
 /** @brief 日志标签 */
 #define TAG "yiyan"
 
+/** @brief 句子环文件格式 */
+#define YIYAN_RING_MAGIC 0x4e594959u // "YIYN"
+#define YIYAN_RING_SCHEMA 1
+/** @brief 写入时使用的临时文件 */
+#define YIYAN_RING_TMP_PATH "/flash/yiyan.tmp"
+/** @brief 已被覆盖的句子哈希保留数量，避免短期内重复 */
+#define YIYAN_HISTORY_SIZE 64
+/** @brief 响应缓冲区大小（hitokoto 单条响应约 300~500 字节） */
+#define YIYAN_RESPONSE_MAX 1024
+/** @brief 批量获取时两次请求之间的间隔，避免触发限流 */
+#define YIYAN_REQUEST_GAP_MS 300
+/** @brief 哈希种子（FNV-1a 偏移基） */
+#define YIYAN_HASH_SEED 2166136261u
+
+/**
+ * @brief 句子环（即文件内容）
+ */
+typedef struct {
+    uint32_t magic;                             ///< YIYAN_RING_MAGIC
+    uint16_t schema;                            ///< YIYAN_RING_SCHEMA
+    uint16_t text_max;                          ///< YIYAN_TEXT_MAX
+    uint8_t ring_size;                          ///< YIYAN_RING_SIZE
+    uint8_t head;                               ///< 下一条写入位置
+    uint8_t count;                              ///< 已保存的句子数
+    uint8_t unread;                             ///< head 之前未显示过的句子数
+    uint8_t replay;                             ///< 循环显示已保存句子时的位置
+    uint8_t history_head;                       ///< history 下一条写入位置
+    uint16_t reserved;
+    uint32_t hashes[YIYAN_RING_SIZE];           ///< 各槽位句子的哈希
+    uint32_t history[YIYAN_HISTORY_SIZE];       ///< 已被覆盖的句子哈希
+    char text[YIYAN_RING_SIZE][YIYAN_TEXT_MAX]; ///< 句子
+} yiyan_ring_t;
+
+/**
+ * @brief 单次请求的响应缓冲（分块与非分块响应都直接追加到同一个缓冲区）
+ */
+typedef struct {
+    char *buf;     ///< YIYAN_RESPONSE_MAX 字节
+    size_t len;    ///< 已接收长度
+    bool overflow; ///< 响应超过缓冲区大小
+} yiyan_response_t;
+
+static yiyan_ring_t *s_ring = NULL;
+static SemaphoreHandle_t s_mutex = NULL;
+static yiyan_stats_t s_stats = {0};
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
 /**
  * @brief 解析一言 API 响应
  *
- * 从 JSON 响应中提取 hitokoto（一言）字段，获取句子内容。
- * 如果解析成功，分配内存并复制字符串到结果指针。
+ * 从 JSON 响应中提取 hitokoto（一言）字段。
  *
- * @param response API 响应 JSON 字符串
- * @param result 输出指针，包含提取的句子内容，失败时设为 NULL
+ * @param response API 响应
+ * @param len 响应长度
+ * @param out 输出缓冲区
+ * @param size 缓冲区大小
+ * @return ESP_OK 成功，ESP_ERR_INVALID_RESPONSE 解析失败，ESP_ERR_INVALID_SIZE 句子过长
  */
-static void parse_yiyan(const char *response, char **result) {
-    // 解析 JSON 响应
-    cJSON *json = cJSON_Parse(response);
+static esp_err_t parse_yiyan(const char *response, size_t len, char *out, size_t size) {
+    cJSON *json = cJSON_ParseWithLength(response, len);
     if (json == NULL) {
         ESP_LOGE(TAG, "Failed to parse JSON");
-        *result = NULL;
-        return;
+        return ESP_ERR_INVALID_RESPONSE;
     }
 
-    // 提取 hitokoto 字段
+    esp_err_t err = ESP_OK;
     cJSON *hitokoto = cJSON_GetObjectItem(json, "hitokoto");
-    if (cJSON_IsString(hitokoto) && (hitokoto->valuestring != NULL)) {
-        ESP_LOGI(TAG, "Hitokoto: %s", hitokoto->valuestring);
-        // 分配内存并复制字符串
-        *result = strdup(hitokoto->valuestring);
-    } else {
+    if (!cJSON_IsString(hitokoto) || hitokoto->valuestring == NULL ||
+        hitokoto->valuestring[0] == '\0') {
         ESP_LOGE(TAG, "Hitokoto not found or not a string");
-        *result = NULL;
+        err = ESP_ERR_INVALID_RESPONSE;
+    } else if (strlen(hitokoto->valuestring) >= size) {
+        // 截断会破坏 UTF-8 字符，直接丢弃
+        ESP_LOGW(TAG, "Hitokoto too long (%u bytes), skipped",
+                 (unsigned)strlen(hitokoto->valuestring));
+        err = ESP_ERR_INVALID_SIZE;
+    } else {
+        ESP_LOGI(TAG, "Hitokoto: %s", hitokoto->valuestring);
+        strcpy(out, hitokoto->valuestring);
     }
 
-    // 释放 JSON 对象
     cJSON_Delete(json);
+    return err;
 }
 
 /**
  * @brief HTTP 客户端事件处理回调函数
  *
- * 处理 HTTP 请求的各个阶段事件，积累响应数据。
- * 使用 SPIRAM 进行内存分配以节省内部 RAM。
+ * 响应体直接追加到请求上下文的缓冲区中。esp_http_client 在 ON_DATA 中交付的已是去掉分块
+ * 编码后的数据，分块与非分块响应按同样方式处理。
  *
  * @param evt HTTP 客户端事件结构体
  * @return esp_err_t 错误码
  */
-static esp_err_t _http_event_handler(esp_http_client_event_t *evt) {
-    // 使用静态变量缓存响应数据
-    static char *response_buf = NULL; /**< 响应数据缓冲区 */
-    static int total_len = 0;         /**< 已接收数据总长度 */
+static esp_err_t http_event_handler(esp_http_client_event_t *evt) {
+    yiyan_response_t *resp = (yiyan_response_t *)evt->user_data;
 
     switch (evt->event_id) {
     case HTTP_EVENT_ON_HEADER:
-        // 在收到响应头时重置缓冲区
-        total_len = 0;
-        heap_caps_free(response_buf); // 释放之前分配的内存
-        response_buf = NULL;
+        // 重定向后的新响应从头接收
+        resp->len = 0;
+        resp->overflow = false;
         break;
 
     case HTTP_EVENT_ON_DATA:
-        // 接收响应数据块（仅处理非分块传输的响应）
-        if (!esp_http_client_is_chunked_response(evt->client)) {
-            // 重新分配缓冲区以容纳新数据
-            char *new_buf =
-                heap_caps_realloc(response_buf, total_len + evt->data_len + 1, MALLOC_CAP_SPIRAM);
-            if (new_buf == NULL) {
-                ESP_LOGE(TAG, "Failed to allocate response buffer");
-                heap_caps_free(response_buf); // 释放已有的旧缓冲区
-                response_buf = NULL;
-                total_len = 0;
-                return ESP_ERR_NO_MEM;
-            }
-            response_buf = new_buf;
-            // 复制新数据到缓冲区
-            memcpy(response_buf + total_len, evt->data, evt->data_len);
-            total_len += evt->data_len;
-            response_buf[total_len] = '\0'; // 字符串终止符
+        // 非 200 响应体是错误页，不接收
+        if (esp_http_client_get_status_code(evt->client) != 200 || resp->overflow) {
+            break;
         }
-        break;
-
-    case HTTP_EVENT_ON_FINISH:
-        // 响应接收完成
-        if (response_buf) {
-            // 将数据复制到用户提供的缓冲区，使用 SPIRAM 保持内存分配一致
-            *(char **)evt->user_data = heap_caps_malloc(total_len + 1, MALLOC_CAP_SPIRAM);
-            if (*(char **)evt->user_data != NULL) {
-                memcpy(*(char **)evt->user_data, response_buf, total_len);
-                (*(char **)evt->user_data)[total_len] = '\0';
-            }
-            // 释放临时缓冲区
-            heap_caps_free(response_buf);
-            response_buf = NULL;
-            total_len = 0;
+        if (resp->len + evt->data_len >= YIYAN_RESPONSE_MAX) {
+            resp->overflow = true;
+            break;
         }
-        break;
-
-    case HTTP_EVENT_ERROR:
-    case HTTP_EVENT_DISCONNECTED:
-        // 清理错误状态下的内存
-        heap_caps_free(response_buf);
-        response_buf = NULL;
-        total_len = 0;
+        memcpy(resp->buf + resp->len, evt->data, evt->data_len);
+        resp->len += evt->data_len;
         break;
 
     default:
@@ -137,56 +166,346 @@ static esp_err_t _http_event_handler(esp_http_client_event_t *evt) {
 }
 
 /**
- * @brief 获取一言句子
- *
- * 通过 HTTPS API 从 hitokoto.cn 获取随机的日本动画、漫画、游戏等来源的经典句子。
- * 返回值是动态分配的字符串，调用者需要手动释放。
+ * @brief 请求一条句子
  *
- * @param return_str 输出指针，包含获取的句子内容
- * @return esp_err_t 错误码，ESP_OK 表示成功
+ * @param resp 响应缓冲
+ * @param out 输出缓冲区
+ * @param size 缓冲区大小
+ * @return ESP_OK 成功，ESP_ERR_NOT_ALLOWED 接口熔断中，ESP_ERR_INVALID_SIZE 句子过长（可继续请求）
  */
-esp_err_t get_yiyan(char **return_str) {
-    *return_str = NULL;
+static esp_err_t fetch_one(yiyan_response_t *resp, char *out, size_t size) {
+    // 接口熔断中：不发请求
+    if (!net_health_allow(NET_EP_YIYAN)) {
+        ESP_LOGW(TAG, "Yiyan endpoint circuit open, request skipped");
+        return ESP_ERR_NOT_ALLOWED;
+    }
 
-    char *response_data = NULL;
+    // 接口地址可配置，去掉末尾的斜杠后拼接路径
+    sys_config_t config;
+    config_manager_get_config(&config);
+    const char *base =
+        (config.yiyan.base_url[0] != '\0') ? config.yiyan.base_url : YIYAN_DEFAULT_BASE_URL;
+    int base_len = strlen(base);
+    while (base_len > 0 && base[base_len - 1] == '/') {
+        base_len--;
+    }
 
-    // 建立 HTTP 客户端配置
-    esp_http_client_config_t config = {
-        .url = "https://v1.hitokoto.cn/",
-        .event_handler = _http_event_handler,
-        .crt_bundle_attach = esp_crt_bundle_attach,
-        .user_data = &response_data,
-    };
+    char url[192];
+    snprintf(url, sizeof(url), "%.*s/?max_length=%d", base_len, base, YIYAN_MAX_CHARS);
 
-    // 初始化 HTTP 客户端
-    esp_http_client_handle_t client = esp_http_client_init(&config);
+    resp->len = 0;
+    resp->overflow = false;
+
+    // 从连接池获取 HTTP 客户端
+    esp_http_client_handle_t client = http_pool_acquire(url, http_event_handler, resp);
+    if (client == NULL) {
+        net_health_report(NET_EP_YIYAN, NET_FAIL_OTHER, 0);
+        return ESP_FAIL;
+    }
 
     // 发送 GET 请求
-    esp_err_t err = esp_http_client_perform(client);
+    int64_t start_us = esp_timer_get_time();
+    esp_err_t err = http_pool_perform(client);
+    metrics_observe(METRIC_HTTP_REQUEST, NET_EP_YIYAN, esp_timer_get_time() - start_us);
+    int status = esp_http_client_get_status_code(client);
+    net_fail_t fail = net_health_classify(client, err, status);
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    s_stats.requests++;
+    xSemaphoreGive(s_mutex);
 
     if (err == ESP_OK) {
-        ESP_LOGI(TAG, "HTTPS Status = %d, content_length = %lld",
-                 esp_http_client_get_status_code(client),
-                 esp_http_client_get_content_length(client));
+        ESP_LOGI(TAG, "HTTPS Status = %d, %u bytes", status, (unsigned)resp->len);
     } else {
         ESP_LOGE(TAG, "HTTP request failed: %s", esp_err_to_name(err));
-        esp_http_client_cleanup(client);
-        // 清理错误路径上可能分配的内存
-        if (response_data != NULL) {
-            heap_caps_free(response_data);
-            response_data = NULL;
-        }
+    }
+    http_pool_release(client);
+
+    if (err != ESP_OK) {
+        net_health_report(NET_EP_YIYAN, fail, 0);
         return err;
     }
+    if (fail != NET_FAIL_NONE) {
+        net_health_report(NET_EP_YIYAN, fail, status);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    // 解析响应数据（非 2xx 响应体是错误页，不解析）
+    err = resp->overflow ? ESP_ERR_INVALID_RESPONSE : parse_yiyan(resp->buf, resp->len, out, size);
+    net_health_report(NET_EP_YIYAN, (err == ESP_ERR_INVALID_RESPONSE) ? NET_FAIL_PARSE : fail,
+                      status);
+    return err;
+}
+
+static uint32_t text_hash(const char *text) { return json_bind_hash(text, YIYAN_HASH_SEED); }
+
+/**
+ * @brief 句子是否已在句子环或历史中（需持有互斥锁）
+ */
+static bool is_duplicate_locked(uint32_t hash) {
+    for (int i = 0; i < s_ring->count; i++) {
+        int slot = (s_ring->head + YIYAN_RING_SIZE - 1 - i) % YIYAN_RING_SIZE;
+        if (s_ring->hashes[slot] == hash) {
+            return true;
+        }
+    }
+    for (int i = 0; i < YIYAN_HISTORY_SIZE; i++) {
+        if (s_ring->history[i] != 0 && s_ring->history[i] == hash) {
+            return true;
+        }
+    }
+    return false;
+}
 
-    esp_http_client_cleanup(client);
+/**
+ * @brief 写入一条句子，覆盖最旧的句子（需持有互斥锁）
+ */
+static void push_locked(const char *text, uint32_t hash) {
+    uint8_t slot = s_ring->head;
+    if (s_ring->count == YIYAN_RING_SIZE) {
+        // 被覆盖的句子记入历史，短期内不再接受
+        s_ring->history[s_ring->history_head] = s_ring->hashes[slot];
+        s_ring->history_head = (s_ring->history_head + 1) % YIYAN_HISTORY_SIZE;
+    } else {
+        s_ring->count++;
+    }
 
-    // 解析响应数据并返回一言字符串
-    if (response_data != NULL) {
-        parse_yiyan(response_data, return_str);
-        // 使用 heap_caps_free 与分配方式对应
-        heap_caps_free(response_data);
+    snprintf(s_ring->text[slot], YIYAN_TEXT_MAX, "%s", text);
+    s_ring->hashes[slot] = hash;
+    s_ring->head = (slot + 1) % YIYAN_RING_SIZE;
+    if (s_ring->unread < YIYAN_RING_SIZE) {
+        s_ring->unread++;
     }
+    s_ring->replay = 0;
+}
 
+/**
+ * @brief 把句子环的副本写入 flash
+ *
+ * 不持有互斥锁：FAT 写入与 fsync 可能耗时数百毫秒，期间界面仍可通过 yiyan_next() 取句子。
+ * 只有 yiyan_refill() 调用，调用之间不会并发。
+ */
+static esp_err_t save_ring(const yiyan_ring_t *ring) {
+    FILE *f = fopen(YIYAN_RING_TMP_PATH, "wb");
+    if (f == NULL) {
+        ESP_LOGE(TAG, "Failed to open %s", YIYAN_RING_TMP_PATH);
+        return ESP_FAIL;
+    }
+
+    size_t written = fwrite(ring, 1, sizeof(yiyan_ring_t), f);
+    fflush(f);
+    fsync(fileno(f));
+    fclose(f);
+    if (written != sizeof(yiyan_ring_t)) {
+        ESP_LOGE(TAG, "Short write to %s", YIYAN_RING_TMP_PATH);
+        unlink(YIYAN_RING_TMP_PATH);
+        return ESP_FAIL;
+    }
+
+    // FAT 不支持覆盖式 rename，先删除旧文件（此时掉电由 load_file() 回退到临时文件）
+    unlink(YIYAN_RING_PATH);
+    if (rename(YIYAN_RING_TMP_PATH, YIYAN_RING_PATH) != 0) {
+        ESP_LOGE(TAG, "Failed to rename %s", YIYAN_RING_TMP_PATH);
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "Saved %d sentence(s), %d unread", ring->count, ring->unread);
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 在互斥锁内复制句子环，释放锁后写入 flash
+ */
+static void save_snapshot(void) {
+    yiyan_ring_t *copy = heap_caps_malloc(sizeof(yiyan_ring_t), MALLOC_CAP_SPIRAM);
+    if (copy == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate ring copy, not saved");
+        return;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    memcpy(copy, s_ring, sizeof(yiyan_ring_t));
+    xSemaphoreGive(s_mutex);
+
+    if (save_ring(copy) == ESP_OK) {
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        s_stats.saves++;
+        xSemaphoreGive(s_mutex);
+    }
+    heap_caps_free(copy);
+}
+
+/**
+ * @brief 从文件读取句子环，格式不匹配视为失败
+ */
+static bool load_file(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+    size_t read = fread(s_ring, 1, sizeof(yiyan_ring_t), f);
+    fclose(f);
+
+    if (read != sizeof(yiyan_ring_t) || s_ring->magic != YIYAN_RING_MAGIC ||
+        s_ring->schema != YIYAN_RING_SCHEMA || s_ring->text_max != YIYAN_TEXT_MAX ||
+        s_ring->ring_size != YIYAN_RING_SIZE || s_ring->count > YIYAN_RING_SIZE ||
+        s_ring->unread > s_ring->count || s_ring->head >= YIYAN_RING_SIZE ||
+        s_ring->history_head >= YIYAN_HISTORY_SIZE) {
+        ESP_LOGW(TAG, "%s has an incompatible format, ignored", path);
+        return false;
+    }
+    for (int i = 0; i < YIYAN_RING_SIZE; i++) {
+        s_ring->text[i][YIYAN_TEXT_MAX - 1] = '\0';
+    }
+    s_ring->replay = 0;
+    return true;
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t yiyan_init(void) {
+    if (s_mutex != NULL) {
+        return ESP_OK;
+    }
+
+    s_ring = heap_caps_calloc(1, sizeof(yiyan_ring_t), MALLOC_CAP_SPIRAM);
+    s_mutex = xSemaphoreCreateMutex();
+    if (s_ring == NULL || s_mutex == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate sentence ring");
+        heap_caps_free(s_ring);
+        s_ring = NULL;
+        if (s_mutex != NULL) {
+            vSemaphoreDelete(s_mutex);
+            s_mutex = NULL;
+        }
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (!load_file(YIYAN_RING_PATH) && !load_file(YIYAN_RING_TMP_PATH)) {
+        memset(s_ring, 0, sizeof(yiyan_ring_t));
+    }
+    s_ring->magic = YIYAN_RING_MAGIC;
+    s_ring->schema = YIYAN_RING_SCHEMA;
+    s_ring->text_max = YIYAN_TEXT_MAX;
+    s_ring->ring_size = YIYAN_RING_SIZE;
+
+    ESP_LOGI(TAG, "Sentence ring: %d stored, %d unread", s_ring->count, s_ring->unread);
+    return ESP_OK;
+}
+
+esp_err_t yiyan_next(char *out, size_t size) {
+    if (out == NULL || size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_mutex == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (s_ring->count == 0) {
+        xSemaphoreGive(s_mutex);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    int slot;
+    if (s_ring->unread > 0) {
+        // 最早写入的未显示句子
+        slot = (s_ring->head + YIYAN_RING_SIZE - s_ring->unread) % YIYAN_RING_SIZE;
+        s_ring->unread--;
+    } else {
+        // 离线或补充失败：按顺序循环已保存的句子
+        slot = (s_ring->head + YIYAN_RING_SIZE - s_ring->count + s_ring->replay) % YIYAN_RING_SIZE;
+        s_ring->replay = (s_ring->replay + 1) % s_ring->count;
+        s_stats.replays++;
+    }
+    snprintf(out, size, "%s", s_ring->text[slot]);
+    s_stats.shown++;
+    xSemaphoreGive(s_mutex);
+    return ESP_OK;
+}
+
+bool yiyan_needs_refill(void) {
+    if (s_mutex == NULL) {
+        return false;
+    }
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    bool needs = s_ring->unread < YIYAN_REFILL_WATERMARK;
+    xSemaphoreGive(s_mutex);
+    return needs;
+}
+
+esp_err_t yiyan_refill(void) {
+    if (s_mutex == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    yiyan_response_t resp = {0};
+    resp.buf = heap_caps_malloc(YIYAN_RESPONSE_MAX, MALLOC_CAP_SPIRAM);
+    if (resp.buf == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate response buffer");
+        return ESP_ERR_NO_MEM;
+    }
+
+    char text[YIYAN_TEXT_MAX];
+    esp_err_t first_err = ESP_OK;
+    int added = 0;
+
+    for (int i = 0; i < YIYAN_BATCH_MAX; i++) {
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        bool full = s_ring->unread >= YIYAN_RING_SIZE;
+        xSemaphoreGive(s_mutex);
+        if (full) {
+            break;
+        }
+
+        if (i > 0) {
+            vTaskDelay(pdMS_TO_TICKS(YIYAN_REQUEST_GAP_MS));
+        }
+
+        esp_err_t err = fetch_one(&resp, text, sizeof(text));
+        if (err == ESP_ERR_INVALID_SIZE) {
+            continue;
+        }
+        if (err != ESP_OK) {
+            if (added == 0) {
+                first_err = err;
+            }
+            break;
+        }
+
+        uint32_t hash = text_hash(text);
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        if (is_duplicate_locked(hash)) {
+            s_stats.duplicates++;
+        } else {
+            push_locked(text, hash);
+            s_stats.fetched++;
+            added++;
+        }
+        xSemaphoreGive(s_mutex);
+    }
+    heap_caps_free(resp.buf);
+
+    if (added > 0) {
+        save_snapshot();
+    }
+    ESP_LOGI(TAG, "Refill: %d new sentence(s)", added);
+    return first_err;
+}
+
+void yiyan_get_stats(yiyan_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    if (s_mutex == NULL) {
+        memset(stats, 0, sizeof(yiyan_stats_t));
+        return;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    *stats = s_stats;
+    stats->count = s_ring->count;
+    stats->unread = s_ring->unread;
+    xSemaphoreGive(s_mutex);
+}
@@ -1,54 +1,139 @@
 #include "actions.h"
 #include "eez-flow.h"
+#include "screens.h"
 #include "vars.h"
 
+#include "esp_heap_caps.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#include "freertos/semphr.h"
 
+#include "config_manager.h"
+#include "http_cache.h"
 #include "ip_location.h"
+#include "net_sched.h"
 #include "weather.h"
+#include "weather_multi.h"
+#include "weather_snapshot.h"
 #include "yiyan.h"
 
 #include <sys/time.h>
 #include <time.h>
 
-#define YIYAN_INTERVAL_MS (3 * 60 * 1000)    // 3分钟
-#define WEATHER_INTERVAL_MS (10 * 60 * 1000) // 10分钟
-
-TaskHandle_t get_yiyan_task_handle = NULL;
-TaskHandle_t get_weather_task_handle = NULL;
-void get_yiyan_task(void *pvParameters) {
-    while (1) {
-        // 获取一言
-        char *yiyan_str = NULL;
-        esp_err_t ret = get_yiyan(&yiyan_str);
-        if (ret == ESP_OK && yiyan_str != NULL) {
-            set_var_yiyan(yiyan_str);
-            free(yiyan_str);
-        } else {
-            set_var_yiyan("获取一言失败");
-            ESP_LOGE("get_yiyan_task", "get_yiyan failed with error: %s", esp_err_to_name(ret));
+#define YIYAN_INTERVAL_MS (3 * 60 * 1000)         // 轮换显示间隔 3分钟
+#define YIYAN_REFILL_INTERVAL_MS (6 * 3600 * 1000) // 句子环检查间隔 6小时
+#define WEATHER_INTERVAL_MS (10 * 60 * 1000)       // 10分钟
+
+#define JOB_JITTER_MS (15 * 1000)      // 周期随机抖动
+#define JOB_RETRY_DELAY_MS (30 * 1000) // 失败后首次重试延迟
+#define JOB_MAX_RETRIES 2
+
+static net_job_id_t s_yiyan_job = -1;
+static lv_timer_t *s_yiyan_timer = NULL;
+static net_job_id_t s_weather_job = -1;
+
+// 界面上是否已有可显示的数据（含开机恢复的快照）；接口失败或熔断时保留这些数据
+static bool s_yiyan_shown = false;
+
+// 天气页的显示状态，LVGL 任务（左滑切换位置）与网络调度器任务（weather_job）都会读写，
+// 由 s_weather_mutex 保护；持有期间只读写这几个字段，不获取其他锁
+static SemaphoreHandle_t s_weather_mutex = NULL;
+static uint8_t s_weather_location = 0; // 界面显示的位置序号（weather_multi）
+static bool s_weather_shown = false;
+static time_t s_weather_shown_time = 0; // 界面上天气数据的观测时间
+
+static void weather_state_lock(void) {
+    if (s_weather_mutex != NULL) {
+        xSemaphoreTake(s_weather_mutex, portMAX_DELAY);
+    }
+}
+
+static void weather_state_unlock(void) {
+    if (s_weather_mutex != NULL) {
+        xSemaphoreGive(s_weather_mutex);
+    }
+}
+
+/**
+ * @brief 从本地句子环显示下一条一言，句子不足时请求补充
+ *
+ * @return true 已显示
+ */
+static bool show_next_yiyan(void) {
+    char text[YIYAN_TEXT_MAX];
+    bool shown = (yiyan_next(text, sizeof(text)) == ESP_OK);
+    if (shown) {
+        set_var_yiyan(text);
+        s_yiyan_shown = true;
+    }
+    if (yiyan_needs_refill() && s_yiyan_job >= 0) {
+        net_sched_trigger(s_yiyan_job);
+    }
+    return shown;
+}
+
+/**
+ * @brief 一言补充任务：批量获取句子存入句子环（由网络调度器执行）
+ */
+static esp_err_t yiyan_job(void *arg) {
+    (void)arg;
+
+    if (!yiyan_needs_refill()) {
+        return ESP_OK;
+    }
+
+    esp_err_t ret = yiyan_refill();
+    if (ret == ESP_OK) {
+        // 首次获取到句子时立即显示，之后由定时器轮换
+        if (!s_yiyan_shown) {
+            show_next_yiyan();
         }
+        return ESP_OK;
+    }
+
+    if (ret == ESP_ERR_NOT_ALLOWED) {
+        // 接口熔断中，由熔断器决定何时重试，不占用调度器的重试次数
+        ESP_LOGW("yiyan_job", "Endpoint circuit open, keeping stored sentences");
+        return ESP_OK;
+    }
 
-        // 等待3分钟或收到立即执行的通知
-        // ulTaskNotifyTake 会阻塞直到收到通知或超时
-        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(YIYAN_INTERVAL_MS));
+    // 已显示过一言时保留原内容，离线时继续循环已保存的句子
+    if (!s_yiyan_shown) {
+        set_var_yiyan("获取一言失败");
     }
+    ESP_LOGE("yiyan_job", "yiyan_refill failed with error: %s", esp_err_to_name(ret));
+    return ret;
+}
 
-    // 正常情况下不会执行到这里，但为了安全起见保留
-    get_yiyan_task_handle = NULL;
-    vTaskDelete(NULL);
+/**
+ * @brief 一言轮换定时器（LVGL 任务中执行，只读取本地句子）
+ */
+static void yiyan_timer_cb(lv_timer_t *timer) {
+    (void)timer;
+    show_next_yiyan();
 }
 
 void action_get_yiyan(lv_event_t *e) {
-    if (get_yiyan_task_handle == NULL) {
-        // 任务不存在，创建新任务
-        xTaskCreate(get_yiyan_task, "get_yiyan_task", 4096, NULL, 5, &get_yiyan_task_handle);
-    } else {
-        // 任务已存在，通知任务立即执行
-        xTaskNotifyGive(get_yiyan_task_handle);
+    if (s_yiyan_job < 0) {
+        // 首次调用时注册补充任务（立即检查一次）与轮换定时器
+        net_job_config_t config = {
+            .name = "yiyan",
+            .fn = yiyan_job,
+            .period_ms = YIYAN_REFILL_INTERVAL_MS,
+            .jitter_ms = JOB_JITTER_MS,
+            .priority = NET_JOB_PRIO_LOW,
+            .max_retries = JOB_MAX_RETRIES,
+            .retry_delay_ms = JOB_RETRY_DELAY_MS,
+        };
+        s_yiyan_job = net_sched_add(&config);
+        s_yiyan_timer = lv_timer_create(yiyan_timer_cb, YIYAN_INTERVAL_MS, NULL);
+    } else if (s_yiyan_timer != NULL) {
+        // 手动切换时重新开始计时
+        lv_timer_reset(s_yiyan_timer);
     }
+
+    // 立即从本地显示一条，不等待网络
+    show_next_yiyan();
 }
 
 /**
@@ -188,82 +273,165 @@ static void format_time_ago(time_t timestamp, char *out, size_t out_size) {
     }
 }
 
-void get_weather_task(void *pvParameters) {
-    const char *TAG = "get_weather_task";
-    location_t *location = NULL;
-    weather_now_t *weather = NULL;
+/**
+ * @brief 将天气与位置数据写入界面变量
+ */
+static void apply_weather_ui(const weather_now_t *weather, const location_t *location,
+                             const char *uptime_str) {
+    char icon_str[4] = {0};
+    char temp_str[16] = {0};
+    char feelslike_str[16] = {0};
+
+    uint16_t safe_icon = weather->icon;
+    if (safe_icon < 100 || safe_icon > 999) {
+        safe_icon = 999;
+    }
+    weather_icon_to_unicode(safe_icon, icon_str, sizeof(icon_str));
+    snprintf(temp_str, sizeof(temp_str), "%.0f", weather->temperature);
+    snprintf(feelslike_str, sizeof(feelslike_str), "%.0f", weather->feelslike);
 
-    while (1) {
-        // 分配内存
-        if (location == NULL) {
-            location = heap_caps_malloc(sizeof(location_t), MALLOC_CAP_SPIRAM);
-        }
-        if (weather == NULL) {
-            weather = heap_caps_malloc(sizeof(weather_now_t), MALLOC_CAP_SPIRAM);
-        }
+    const char *district = (location->has_district && location->district[0] != '\0')
+                               ? location->district
+                               : (location->city[0] != '\0' ? location->city : "未知");
+
+    // 一次观测的所有字段作为一次提交发布，界面在同一次刷新中更新
+    if (vars_begin() != ESP_OK) {
+        return;
+    }
+    set_var_weather_icon(icon_str);
+    set_var_weather_temp(temp_str);
+    set_var_weather_text(weather->text);
+    set_var_weather_uptime(uptime_str);
+    set_var_weather_location(district);
+    set_var_weather_feelslike(feelslike_str);
+    set_var_weather_wind_dir(weather->wind_dir);
+    set_var_weather_wind_scale(weather->wind_scale);
+    set_var_weather_humidity(weather->humidity);
+    set_var_weather_precip((int32_t)weather->precip);
+    set_var_weather_pressure((int32_t)weather->pressure);
+    set_var_weather_visibility((int32_t)weather->visibility);
+    set_var_weather_cloud((int32_t)weather->cloud);
+    set_var_weather_dew((int32_t)weather->dew);
+    vars_commit();
+
+    weather_state_lock();
+    s_weather_shown = true;
+    s_weather_shown_time = weather->obs_time;
+    weather_state_unlock();
+}
 
-        if (location == NULL || weather == NULL) {
-            ESP_LOGE(TAG, "Failed to allocate memory");
-            vTaskDelay(pdMS_TO_TICKS(WEATHER_INTERVAL_MS));
-            continue;
+/**
+ * @brief 天气获取失败时更新界面
+ *
+ * 界面上已有数据时保留，只刷新观测时间描述；没有数据时显示错误提示。
+ */
+static void show_weather_failure(const char *message) {
+    weather_state_lock();
+    bool shown = s_weather_shown;
+    time_t shown_time = s_weather_shown_time;
+    weather_state_unlock();
+
+    if (shown) {
+        if (shown_time > 0) {
+            char uptime_str[32] = {0};
+            format_time_ago(shown_time, uptime_str, sizeof(uptime_str));
+            set_var_weather_uptime(uptime_str);
         }
+        return;
+    }
 
-        // 获取位置信息
-        esp_err_t err = get_location(NULL, location);
-        if (err != ESP_OK) {
-            ESP_LOGE(TAG, "get_location failed: %s", esp_err_to_name(err));
+    char icon_str[4] = {0};
+    weather_icon_to_unicode(999, icon_str, sizeof(icon_str));
 
-            // 更新UI显示错误
-            set_var_weather_text("定位失败");
-            set_var_weather_uptime("未更新");
+    if (vars_begin() != ESP_OK) {
+        return;
+    }
+    set_var_weather_icon(icon_str);
+    set_var_weather_temp("--");
+    set_var_weather_text(message);
+    set_var_weather_uptime("未更新");
+    set_var_weather_location("未知");
+    set_var_weather_feelslike("--");
+    set_var_weather_wind_dir("未知风");
+    set_var_weather_wind_scale(0);
+    set_var_weather_humidity(0);
+    set_var_weather_precip(0);
+    set_var_weather_pressure(0);
+    set_var_weather_visibility(0);
+    set_var_weather_cloud(0);
+    set_var_weather_dew(0);
+    vars_commit();
+}
 
-            vTaskDelay(pdMS_TO_TICKS(WEATHER_INTERVAL_MS));
-            continue;
-        }
+/**
+ * @brief 从持久化快照恢复天气界面变量
+ *
+ * 在 LVGL 与网络启动之前调用，超过配置的过期时间时观测时间显示为“数据已过期”。
+ */
+void restore_weather_snapshot(void) {
+    const char *TAG = "weather_snapshot";
+    // 此时 LVGL 与网络任务尚未启动，在这里创建天气页状态的互斥锁
+    if (s_weather_mutex == NULL) {
+        s_weather_mutex = xSemaphoreCreateMutex();
+    }
 
-        // 获取天气信息
-        err = get_weather_now(location, weather);
-        if (err != ESP_OK) {
-            ESP_LOGE(TAG, "get_weather_now failed: %s", esp_err_to_name(err));
-
-            // 更新UI显示错误
-            char icon_str[4] = {0};
-            weather_icon_to_unicode(999, icon_str, sizeof(icon_str));
-
-            set_var_weather_icon(icon_str);
-            set_var_weather_temp("--");
-            set_var_weather_text("获取失败");
-            set_var_weather_uptime("未更新");
-            set_var_weather_location("未知");
-            set_var_weather_feelslike("--");
-            set_var_weather_wind_dir("未知风");
-            set_var_weather_wind_scale(0);
-            set_var_weather_humidity(0);
-            set_var_weather_precip(0);
-            set_var_weather_pressure(0);
-            set_var_weather_visibility(0);
-            set_var_weather_cloud(0);
-            set_var_weather_dew(0);
-
-            vTaskDelay(pdMS_TO_TICKS(WEATHER_INTERVAL_MS));
-            continue;
-        }
+    weather_now_t *weather = heap_caps_malloc(sizeof(weather_now_t), MALLOC_CAP_SPIRAM);
+    location_t *location = heap_caps_malloc(sizeof(location_t), MALLOC_CAP_SPIRAM);
+    if (weather == NULL || location == NULL) {
+        heap_caps_free(weather);
+        heap_caps_free(location);
+        return;
+    }
 
-        ESP_LOGI(TAG, "Weather updated: %.1f°C, %s (icon: %d, obs_time: %ld)", weather->temperature,
-                 weather->text, weather->icon, (long)weather->obs_time);
+    time_t saved_at = 0;
+    if (weather_snapshot_load_now(weather, location, &saved_at) == ESP_OK) {
+        sys_config_t sys_config;
+        config_manager_get_config(&sys_config);
 
-        // 准备UI更新数据
-        char icon_str[4] = {0};
-        char temp_str[16] = {0};
+        // 以观测时间判断数据新旧，缺失时退回保存时间
+        time_t timestamp = (weather->obs_time > 0) ? weather->obs_time : saved_at;
         char uptime_str[32] = {0};
-        char feelslike_str[16] = {0};
-
-        uint16_t safe_icon = weather->icon;
-        if (safe_icon < 100 || safe_icon > 999) {
-            safe_icon = 999;
+        if (weather_snapshot_is_stale(timestamp, sys_config.weather.stale_minutes)) {
+            snprintf(uptime_str, sizeof(uptime_str), "数据已过期");
+        } else {
+            format_time_ago(timestamp, uptime_str, sizeof(uptime_str));
         }
-        weather_icon_to_unicode(safe_icon, icon_str, sizeof(icon_str));
-        snprintf(temp_str, sizeof(temp_str), "%.0f", weather->temperature);
+
+        apply_weather_ui(weather, location, uptime_str);
+        ESP_LOGI(TAG, "Restored weather snapshot: %.1f°C, %s (%s)", weather->temperature,
+                 weather->text, uptime_str);
+    }
+
+    heap_caps_free(weather);
+    heap_caps_free(location);
+}
+
+/**
+ * @brief 从位置缓存显示天气（不发起网络请求）
+ *
+ * 读出缓存后在一次提交中确认位置并写入界面变量。左滑切换（select）在提交中改写界面位置；
+ * 天气任务的刷新在提交中确认界面仍显示 index，已切换到其他位置时放弃，不会用旧位置的
+ * 数据覆盖切换后的内容。两者的提交互斥（LVGL 一侧的提交被推迟时在刷新之后发布），
+ * 所以最后生效的总是最后一次切换的位置。
+ *
+ * @param index 位置序号
+ * @param uptime_only 只刷新观测时间描述
+ * @param select 同时把界面显示的位置切换为 index
+ * @return ESP_OK 已显示，ESP_ERR_NOT_FOUND 该位置尚无数据，ESP_ERR_INVALID_STATE 界面已切换
+ *         到其他位置
+ */
+static esp_err_t show_weather_location(uint8_t index, bool uptime_only, bool select) {
+    weather_now_t *weather = heap_caps_malloc(sizeof(weather_now_t), MALLOC_CAP_SPIRAM);
+    location_t *location = heap_caps_malloc(sizeof(location_t), MALLOC_CAP_SPIRAM);
+    if (weather == NULL || location == NULL) {
+        heap_caps_free(weather);
+        heap_caps_free(location);
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = weather_multi_get(index, weather, location);
+    if (err == ESP_OK) {
+        char uptime_str[32] = {0};
 
         // 使用API返回的观测时间
         if (weather->obs_time > 0) {
@@ -272,51 +440,135 @@ void get_weather_task(void *pvParameters) {
             snprintf(uptime_str, sizeof(uptime_str), "未知");
         }
 
-        snprintf(feelslike_str, sizeof(feelslike_str), "%.0f", weather->feelslike);
-
-        const char *district = (location->has_district && location->district[0] != '\0')
-                                   ? location->district
-                                   : (location->city[0] != '\0' ? location->city : "未知");
-
-        // 通过变量更新UI
-        set_var_weather_icon(icon_str);
-        set_var_weather_temp(temp_str);
-        set_var_weather_text(weather->text);
-        set_var_weather_uptime(uptime_str);
-        set_var_weather_location(district);
-        set_var_weather_feelslike(feelslike_str);
-        set_var_weather_wind_dir(weather->wind_dir);
-        set_var_weather_wind_scale(weather->wind_scale);
-        set_var_weather_humidity(weather->humidity);
-        set_var_weather_precip((int32_t)weather->precip);
-        set_var_weather_pressure((int32_t)weather->pressure);
-        set_var_weather_visibility((int32_t)weather->visibility);
-        set_var_weather_cloud((int32_t)weather->cloud);
-        set_var_weather_dew((int32_t)weather->dew);
-
-        // 等待10分钟或收到立即执行的通知
-        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(WEATHER_INTERVAL_MS));
-    }
-
-    // 清理内存（正常情况下不会执行到这里）
-    if (location != NULL) {
-        heap_caps_free(location);
+        err = vars_begin();
+        if (err == ESP_OK) {
+            weather_state_lock();
+            bool current = select || s_weather_location == index;
+            if (select) {
+                s_weather_location = index;
+            }
+            weather_state_unlock();
+
+            if (!current) {
+                err = ESP_ERR_INVALID_STATE;
+            } else if (uptime_only) {
+                set_var_weather_uptime(uptime_str);
+            } else {
+                apply_weather_ui(weather, location, uptime_str);
+            }
+            vars_commit();
+        }
     }
-    if (weather != NULL) {
-        heap_caps_free(weather);
+
+    heap_caps_free(weather);
+    heap_caps_free(location);
+    return err;
+}
+
+/**
+ * @brief 天气任务：获取位置与所有位置的天气并更新界面变量（由网络调度器周期执行）
+ */
+static esp_err_t weather_job(void *arg) {
+    (void)arg;
+    const char *TAG = "weather_job";
+    static location_t *location = NULL;
+    static bool ui_valid = false; // 界面当前是否显示着本次运行中获取的天气数据
+
+    // 分配内存（在任务间保留，避免每个周期重新分配）
+    if (location == NULL) {
+        location = heap_caps_malloc(sizeof(location_t), MALLOC_CAP_SPIRAM);
+    }
+
+    if (location == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate memory");
+        return ESP_ERR_NO_MEM;
     }
 
-    get_weather_task_handle = NULL;
-    vTaskDelete(NULL);
+    // 获取当前位置（手动位置或按接入点缓存的定位结果），失败时仍刷新额外位置
+    esp_err_t loc_err = get_location_cached(location, NULL);
+    if (loc_err != ESP_OK) {
+        ESP_LOGE(TAG, "get_location_cached failed: %s", esp_err_to_name(loc_err));
+    }
+
+    // 在同一个联网窗口内依次获取所有位置的天气
+    uint32_t changed = 0;
+    esp_err_t err = weather_multi_refresh((loc_err == ESP_OK) ? location : NULL, &changed);
+
+    weather_state_lock();
+    if (s_weather_location >= weather_multi_count()) {
+        // 配置中的位置被删除，回到当前位置
+        s_weather_location = 0;
+        ui_valid = false;
+    }
+    uint8_t index = s_weather_location;
+    weather_state_unlock();
+
+    if (!(changed & (1u << index)) && ui_valid) {
+        // 数据未变化（缓存新鲜 / 304 / updateTime 相同）时只更新观测时间描述
+        ESP_LOGI(TAG, "Weather unchanged, UI update skipped");
+        show_weather_location(index, true, false);
+        http_cache_note_refresh_skipped();
+    } else {
+        esp_err_t shown = show_weather_location(index, false, false);
+        if (shown == ESP_OK) {
+            ui_valid = true;
+        } else if (shown == ESP_ERR_INVALID_STATE) {
+            // 刷新期间用户切换了位置，切换时已显示该位置的缓存
+            ESP_LOGI(TAG, "Location switched during refresh, keeping the new one");
+        } else if (index == 0 && loc_err != ESP_OK) {
+            show_weather_failure("定位失败");
+        } else {
+            show_weather_failure("获取失败");
+        }
+    }
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "weather_multi_refresh failed: %s", esp_err_to_name(err));
+    }
+    if (loc_err != ESP_OK) {
+        err = loc_err;
+    }
+    if (err == ESP_ERR_NOT_ALLOWED) {
+        // 接口熔断中，由熔断器决定何时重试，不占用调度器的重试次数
+        return ESP_OK;
+    }
+    return err;
+}
+
+/**
+ * @brief 在天气页切换到下一个已有数据的位置（只读取位置缓存）
+ */
+static void switch_weather_location(void) {
+    uint8_t count = weather_multi_count();
+    weather_state_lock();
+    uint8_t current = s_weather_location;
+    weather_state_unlock();
+
+    for (uint8_t step = 1; step < count; step++) {
+        uint8_t index = (current + step) % count;
+        if (show_weather_location(index, false, true) == ESP_OK) {
+            ESP_LOGI("weather", "Switched to location %d/%d", index + 1, count);
+            return;
+        }
+    }
 }
 
 void action_get_weather(lv_event_t *e) {
-    if (get_weather_task_handle == NULL) {
-        // 任务不存在，创建新任务
-        xTaskCreate(get_weather_task, "get_weather_task", 8192, NULL, 5, &get_weather_task_handle);
+    if (s_weather_job < 0) {
+        // 首次调用时注册周期任务（立即执行一次）
+        net_job_config_t config = {
+            .name = "weather",
+            .fn = weather_job,
+            .period_ms = WEATHER_INTERVAL_MS,
+            .jitter_ms = JOB_JITTER_MS,
+            .priority = NET_JOB_PRIO_NORMAL,
+            .max_retries = JOB_MAX_RETRIES,
+            .retry_delay_ms = JOB_RETRY_DELAY_MS,
+        };
+        s_weather_job = net_sched_add(&config);
     } else {
-        // 任务已存在，通知任务立即执行
-        xTaskNotifyGive(get_weather_task_handle);
+        // 任务已存在，通知调度器立即执行
+        net_sched_trigger(s_weather_job);
     }
 }
 
@@ -327,5 +579,8 @@ void action_change_to_previous_screen(lv_event_t *e) {
         // 左滑，返回上一个屏幕，使用 eez flow 屏幕栈管理
         ESP_LOGI("screen_change", "Popping screen with eez_flow");
         eez_flow_pop_screen(LV_SCR_LOAD_ANIM_MOVE_RIGHT, 200, 0);
+    } else if (dir == LV_DIR_LEFT && lv_screen_active() == objects.weather) {
+        // 天气页向左滑动，切换到下一个位置
+        switch_weather_location();
     }
 }
\ No newline at end of file
@@ -1,19 +1,22 @@
-#ifndef EEZ_LVGL_UI_EVENTS_H
-#define EEZ_LVGL_UI_EVENTS_H
-
-#include <lvgl.h>
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
+#ifndef EEZ_LVGL_UI_EVENTS_H
+#define EEZ_LVGL_UI_EVENTS_H
+
+#include <lvgl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 extern void action_get_yiyan(lv_event_t * e);
 extern void action_get_weather(lv_event_t * e);
 extern void action_change_to_previous_screen(lv_event_t * e);
-
-
-#ifdef __cplusplus
-}
-#endif
-
+
+// 开机时从持久化快照恢复天气界面变量
+extern void restore_weather_snapshot(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /*EEZ_LVGL_UI_EVENTS_H*/
\ No newline at end of file
@@ -0,0 +1,16 @@
+/**
+ * @file assets_flat.h
+ * @brief 未压缩的 EEZ 资源，由 tools/eez_assets.py 根据 ui.c 生成，请勿手动修改
+ *
+ * 格式为 HEADER_TAG 后接完整的 Assets 结构，loadMainAssets 直接在 Flash 中使用。
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/** @brief 生成时 ui.c 中压缩资源的长度与 CRC32，ui.c 重新生成后用于发现未同步更新的本文件 */
+#define UI_ASSETS_FLAT_SOURCE_SIZE 1459
+#define UI_ASSETS_FLAT_SOURCE_CRC32 0x036E177Du
+
+extern const uint8_t assets_flat[5284];
@@ -3154,8 +3154,19 @@ void registerComponent(ComponentTypes componentType, ExecuteComponentFunctionTyp
 		g_executeComponentFunctions[componentType - defs_v3::COMPONENT_TYPE_START_ACTION] = executeComponentFunction;
 	}
 }
+#if EEZ_FLOW_PROFILE
+struct ComponentProfileScope {
+    uint16_t type;
+    uint32_t start;
+    ComponentProfileScope(uint16_t type) : type(type), start(eez_flow_profile_now()) {}
+    ~ComponentProfileScope() { eez_flow_profile_component(type, start); }
+};
+#endif
 void executeComponent(FlowState *flowState, unsigned componentIndex) {
 	auto component = flowState->flow->components[componentIndex];
+#if EEZ_FLOW_PROFILE
+    ComponentProfileScope profileScope(component->type);
+#endif
 	if (component->type >= defs_v3::FIRST_DASHBOARD_ACTION_COMPONENT_TYPE) {
 #if defined(EEZ_DASHBOARD_API)
         executeDashboardComponent(component->type, getFlowStateIndex(flowState), componentIndex);
@@ -5375,6 +5386,7 @@ int eez_mqtt_publish(void *handle, const char *topic, const char *payload) {
     }, eez::flow::g_wasmModuleId, handle, topic, payload);
 }
 }
+#endif
 void eez_mqtt_on_event_callback(void *handle, EEZ_MQTT_Event event, void *eventData) {
     using namespace eez;
     using namespace eez::flow;
@@ -5427,6 +5439,7 @@ void eez_mqtt_on_event_callback(void *handle, EEZ_MQTT_Event event, void *eventD
         }
     }
 }
+#ifdef EEZ_STUDIO_FLOW_RUNTIME
 EM_PORT_API(void) onMqttEvent(void *handle, EEZ_MQTT_Event event, void *eventDataPtr1, void *eventDataPtr2) {
     void *eventData;
     if (eventDataPtr1 && eventDataPtr2)  {
@@ -6866,7 +6879,13 @@ bool evalExpression(FlowState *flowState, int componentIndex, const uint8_t *ins
 	g_stack.componentIndex = componentIndex;
 	g_stack.iterators = iterators;
     g_stack.errorMessage = nullptr;
+#if EEZ_FLOW_PROFILE
+    uint32_t profileStart = eez_flow_profile_now();
+#endif
 	evalExpression(flowState, instructions, numInstructionBytes);
+#if EEZ_FLOW_PROFILE
+    eez_flow_profile_expression(profileStart);
+#endif
 	g_stack.flowState = savedFlowState;
 	g_stack.componentIndex = savedComponentIndex;
 	g_stack.iterators = savedIterators;
@@ -6929,7 +6948,13 @@ bool evalAssignableExpression(FlowState *flowState, int componentIndex, const ui
 	g_stack.componentIndex = componentIndex;
 	g_stack.iterators = iterators;
     g_stack.errorMessage = nullptr;
+#if EEZ_FLOW_PROFILE
+    uint32_t profileStart = eez_flow_profile_now();
+#endif
 	evalExpression(flowState, instructions, numInstructionBytes);
+#if EEZ_FLOW_PROFILE
+    eez_flow_profile_expression(profileStart);
+#endif
 	g_stack.flowState = savedFlowState;
 	g_stack.componentIndex = savedComponentIndex;
 	g_stack.iterators = savedIterators;
@@ -7080,6 +7105,11 @@ void tick() {
         return;
     }
 	uint32_t startTickCount = millis();
+#if EEZ_FLOW_PROFILE
+    uint32_t profileStart = eez_flow_profile_now();
+    size_t profileQueueSize = getQueueSize();
+    bool profileBudgetExceeded = false;
+#endif
     visitWatchList();
     auto queueSizeAtTickStart = getQueueSize();
     for (size_t i = 0; i < queueSizeAtTickStart || g_numNonContinuousTaskInQueue > 0; i++) {
@@ -7121,6 +7151,9 @@ void tick() {
         if ((i + 1) % 5 == 0) {
             if (millis() - startTickCount >= FLOW_TICK_MAX_DURATION_MS) {
                 g_tick_max_duration_count++;
+#if EEZ_FLOW_PROFILE
+                profileBudgetExceeded = true;
+#endif
                 break;
             }
         }
@@ -7133,6 +7166,9 @@ void tick() {
         }
         flowState = nextFlowState;
     }
+#if EEZ_FLOW_PROFILE
+    eez_flow_profile_tick(profileStart, profileQueueSize, getMaxQueueSize(), profileBudgetExceeded);
+#endif
 }
 void stop(Assets* assets) {
     if (!assets) {
@@ -7745,7 +7781,13 @@ uint8_t g_lastLVGLEventUserDataBuffer[64];
 uint8_t g_lastLVGLEventParamBuffer[64];
 static lv_event_t g_lastLVGLEvent;
 static void executeLvglAction(int actionIndex) {
+#if EEZ_FLOW_PROFILE
+    uint32_t profileStart = eez_flow_profile_now();
+#endif
     g_actions[actionIndex](&g_lastLVGLEvent);
+#if EEZ_FLOW_PROFILE
+    eez_flow_profile_action(actionIndex, profileStart);
+#endif
 }
 void eez_flow_init_themes(const char **themeNames, size_t numThemes, void (*changeColorTheme)(uint32_t themeIndex)) {
     g_themeNames = themeNames;
@@ -2937,9 +2937,24 @@ typedef struct {
     const char *topic;
     const char *payload;
 } EEZ_MQTT_MessageEvent;
+void eez_mqtt_on_event_callback(void *handle, EEZ_MQTT_Event event, void *eventData);
 #ifdef __cplusplus
 }
 #endif
+#if EEZ_FLOW_PROFILE
+// 执行剖析钩子，由 flow_profile.c 实现，均在持有 LVGL 互斥锁时调用
+#ifdef __cplusplus
+extern "C" {
+#endif
+uint32_t eez_flow_profile_now(void);
+void eez_flow_profile_component(uint16_t type, uint32_t start);
+void eez_flow_profile_expression(uint32_t start);
+void eez_flow_profile_action(int actionIndex, uint32_t start);
+void eez_flow_profile_tick(uint32_t start, size_t queueSize, size_t queuePeak, bool budgetExceeded);
+#ifdef __cplusplus
+}
+#endif
+#endif
 // -----------------------------------------------------------------------------
 // flow/components/on_event.h
 // -----------------------------------------------------------------------------
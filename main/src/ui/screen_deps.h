@@ -0,0 +1,50 @@
+/**
+ * @file screen_deps.h
+ * @brief 各屏幕依赖的原生变量，由 tools/eez_bindings.py 根据 ui.c 生成，请勿手动修改
+ *
+ * lvgl_init.c 只在当前屏幕依赖的变量变化时执行 tick_screen_*。
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "vars.h"
+
+/** @brief 屏幕的表达式还依赖流程变量、输入或输出，每个 tick 都要执行 */
+#define SCREEN_DEPS_ALWAYS UINT32_MAX
+
+/** @brief 屏幕数（与 tick_screen_funcs 一致） */
+#define SCREEN_DEPS_COUNT 3
+
+static const uint32_t screen_deps[SCREEN_DEPS_COUNT] = {
+    // main
+    NATIVE_VAR_BIT(CURRENT_TIME) |
+        NATIVE_VAR_BIT(CURRENT_DATE) |
+        NATIVE_VAR_BIT(CURRENT_WEEKDAY) |
+        NATIVE_VAR_BIT(YIYAN) |
+        NATIVE_VAR_BIT(WEATHER_ICON) |
+        NATIVE_VAR_BIT(WEATHER_TEMP) |
+        NATIVE_VAR_BIT(WEATHER_UPTIME) |
+        NATIVE_VAR_BIT(WEATHER_TEXT) |
+        NATIVE_VAR_BIT(SOLAR_TERM),
+    // menu
+    NATIVE_VAR_BIT(CURRENT_TIME) |
+        NATIVE_VAR_BIT(WEATHER_ICON),
+    // weather
+    NATIVE_VAR_BIT(CURRENT_TIME) |
+        NATIVE_VAR_BIT(WEATHER_UPTIME) |
+        NATIVE_VAR_BIT(WEATHER_LOCATION) |
+        NATIVE_VAR_BIT(WEATHER_WIND_DIR) |
+        NATIVE_VAR_BIT(WEATHER_WIND_SCALE) |
+        NATIVE_VAR_BIT(WEATHER_TEXT) |
+        NATIVE_VAR_BIT(WEATHER_FEELSLIKE) |
+        NATIVE_VAR_BIT(WEATHER_TEMP) |
+        NATIVE_VAR_BIT(WEATHER_ICON) |
+        NATIVE_VAR_BIT(WEATHER_PRECIP) |
+        NATIVE_VAR_BIT(WEATHER_PRESSURE) |
+        NATIVE_VAR_BIT(WEATHER_HUMIDITY) |
+        NATIVE_VAR_BIT(WEATHER_VISIBILITY) |
+        NATIVE_VAR_BIT(WEATHER_CLOUD) |
+        NATIVE_VAR_BIT(WEATHER_DEW),
+};
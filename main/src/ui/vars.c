@@ -1,152 +1,503 @@
+/**
+ * @file vars.c
+ * @brief 界面变量存储：写入方以提交为单位发布，LVGL 一侧读取不加锁
+ *
+ * 存储有三份副本：
+ * - 暂存副本（PSRAM）：只在持有写锁时修改，始终等于最近一次提交加上进行中的赋值。
+ * - 发布副本（PSRAM）：提交时在顺序锁保护下从暂存副本整体复制。读者先后读取两次序号，
+ *   序号为奇数或前后不同说明复制期间有提交，结果作废。
+ * - LVGL 副本（内部 RAM）：get_var_* 的返回值指向这里，EEZ 表达式求值期间保持不变。
+ *   只在持有 LVGL 互斥锁时读写：vars_sync 先复制到 PSRAM 中的缓冲，确认完整后再覆盖。
+ *
+ *
+ * LVGL 一侧（持有 LVGL 互斥锁）的写入方从不等待写锁：写锁空闲时照常提交；被其他任务占用时，
+ * 赋值直接写入 LVGL 副本并记入推迟缓冲（PSRAM），之后的 vars_begin 或 vars_sync 取得写锁时
+ * 再合并到暂存副本发布。推迟期间 vars_sync 复制新的发布副本时保留这些赋值。
+ */
+
 #include "vars.h"
-#include <string.h>
 
-char current_time[100] = {0};
+#include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
 
-const char *get_var_current_time() { return current_time; }
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "lvgl_init.h"
+
+#define TAG "vars"
+
+_Static_assert(NATIVE_VAR_ID_COUNT <= 32, "native variables must fit in a uint32_t bitmap");
+
+/**
+ * @brief 变量在快照中的位置
+ */
+typedef struct {
+    var_type_t type; ///< 类型
+    uint16_t offset; ///< 在 vars_snapshot_t 中的偏移
+} var_slot_t;
+
+#define STR_SLOT(name) {VAR_TYPE_STRING, offsetof(vars_snapshot_t, name)}
+#define INT_SLOT(name) {VAR_TYPE_INT32, offsetof(vars_snapshot_t, name)}
+
+// ============================================================================
+// 私有变量
+// ============================================================================
+
+static const var_slot_t s_slots[NATIVE_VAR_ID_COUNT] = {
+    [NATIVE_VAR_ID_CURRENT_TIME] = STR_SLOT(current_time),
+    [NATIVE_VAR_ID_CURRENT_DATE] = STR_SLOT(current_date),
+    [NATIVE_VAR_ID_CURRENT_WEEKDAY] = STR_SLOT(current_weekday),
+    [NATIVE_VAR_ID_YIYAN] = STR_SLOT(yiyan),
+    [NATIVE_VAR_ID_SOLAR_TERM] = STR_SLOT(solar_term),
+    [NATIVE_VAR_ID_WEATHER_TEXT] = STR_SLOT(weather_text),
+    [NATIVE_VAR_ID_WEATHER_ICON] = STR_SLOT(weather_icon),
+    [NATIVE_VAR_ID_WEATHER_TEMP] = STR_SLOT(weather_temp),
+    [NATIVE_VAR_ID_WEATHER_UPTIME] = STR_SLOT(weather_uptime),
+    [NATIVE_VAR_ID_WEATHER_LOCATION] = STR_SLOT(weather_location),
+    [NATIVE_VAR_ID_WEATHER_FEELSLIKE] = STR_SLOT(weather_feelslike),
+    [NATIVE_VAR_ID_WEATHER_WIND_DIR] = STR_SLOT(weather_wind_dir),
+    [NATIVE_VAR_ID_WEATHER_WIND_SCALE] = INT_SLOT(weather_wind_scale),
+    [NATIVE_VAR_ID_WEATHER_HUMIDITY] = INT_SLOT(weather_humidity),
+    [NATIVE_VAR_ID_WEATHER_PRECIP] = INT_SLOT(weather_precip),
+    [NATIVE_VAR_ID_WEATHER_PRESSURE] = INT_SLOT(weather_pressure),
+    [NATIVE_VAR_ID_WEATHER_VISIBILITY] = INT_SLOT(weather_visibility),
+    [NATIVE_VAR_ID_WEATHER_CLOUD] = INT_SLOT(weather_cloud),
+    [NATIVE_VAR_ID_WEATHER_DEW] = INT_SLOT(weather_dew),
+};
+
+/** @brief 写锁（递归，允许在提交中调用 set_var_*），以及嵌套深度与是否有变化 */
+static SemaphoreHandle_t s_write_lock = NULL;
+static int s_depth = 0;
+static bool s_dirty = false;
+
+static vars_snapshot_t *s_stage = NULL;
+static vars_snapshot_t *s_published = NULL;
+
+/** @brief 发布序号，奇数表示正在复制 */
+static atomic_uint_least32_t s_seq;
+
+/** @brief LVGL 副本、复制缓冲，以及副本对应的发布序号和更新次数 */
+static vars_snapshot_t s_view;
+static vars_snapshot_t *s_scratch = NULL;
+static uint32_t s_view_seq = 0;
+static uint32_t s_view_gen = 0;
+
+/** @brief LVGL 一侧推迟的赋值、有效位图、嵌套深度与是否改变了 LVGL 副本（持有 LVGL 互斥锁时） */
+static vars_snapshot_t *s_deferred = NULL;
+static uint32_t s_deferred_mask = 0;
+static int s_defer_depth = 0;
+static bool s_defer_dirty = false;
+
+/** @brief 统计：写入方、LVGL 任务与读者分别更新，均为原子变量 */
+static atomic_uint_least32_t s_commits;
+static atomic_uint_least32_t s_changes;
+static atomic_uint_least32_t s_view_syncs;
+static atomic_uint_least32_t s_view_deferred;
+static atomic_uint_least32_t s_read_failed;
+static atomic_uint_least32_t s_lvgl_deferred;
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+static char *slot_str(vars_snapshot_t *snapshot, enum NativeVarId id) {
+    return (char *)snapshot + s_slots[id].offset;
+}
 
-void set_var_current_time(const char *value) {
-    strncpy(current_time, value, sizeof(current_time) / sizeof(char));
-    current_time[sizeof(current_time) / sizeof(char) - 1] = 0;
+static int32_t *slot_int(vars_snapshot_t *snapshot, enum NativeVarId id) {
+    return (int32_t *)((char *)snapshot + s_slots[id].offset);
 }
 
-char current_date[100] = {0};
+/**
+ * @brief 写入一个字符串变量，值变化时递增版本号
+ *
+ * @return 值是否变化
+ */
+static bool assign_str(vars_snapshot_t *snapshot, enum NativeVarId id, const char *value) {
+    char *dst = slot_str(snapshot, id);
+    if (strncmp(dst, value, VARS_STR_MAX - 1) == 0) {
+        return false;
+    }
+    strncpy(dst, value, VARS_STR_MAX);
+    dst[VARS_STR_MAX - 1] = 0;
+    snapshot->versions[id]++;
+    return true;
+}
 
-const char *get_var_current_date() { return current_date; }
+/**
+ * @brief 写入一个整数变量，值变化时递增版本号
+ *
+ * @return 值是否变化
+ */
+static bool assign_int(vars_snapshot_t *snapshot, enum NativeVarId id, int32_t value) {
+    int32_t *dst = slot_int(snapshot, id);
+    if (*dst == value) {
+        return false;
+    }
+    *dst = value;
+    snapshot->versions[id]++;
+    return true;
+}
 
-void set_var_current_date(const char *value) {
-    strncpy(current_date, value, sizeof(current_date) / sizeof(char));
-    current_date[sizeof(current_date) / sizeof(char) - 1] = 0;
+/**
+ * @brief 从 src 复制一个变量的值写入 dst，值变化时递增版本号
+ *
+ * @return 值是否变化
+ */
+static bool assign_from(vars_snapshot_t *dst, const vars_snapshot_t *src, enum NativeVarId id) {
+    if (s_slots[id].type == VAR_TYPE_STRING) {
+        return assign_str(dst, id, slot_str((vars_snapshot_t *)src, id));
+    }
+    return assign_int(dst, id, *slot_int((vars_snapshot_t *)src, id));
 }
 
-char current_weekday[100] = {0};
+/**
+ * @brief 调用者是否持有 LVGL 互斥锁
+ */
+static bool holds_lvgl_mutex(void) {
+    SemaphoreHandle_t mutex = lvgl_get_mutex();
+    return mutex != NULL && xSemaphoreGetMutexHolder(mutex) == xTaskGetCurrentTaskHandle();
+}
 
-const char *get_var_current_weekday() { return current_weekday; }
+/**
+ * @brief 在顺序锁保护下发布暂存副本（持有写锁时调用）
+ */
+static void publish(void) {
+    uint32_t seq = atomic_load_explicit(&s_seq, memory_order_relaxed);
+    atomic_store_explicit(&s_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(s_published, s_stage, sizeof(*s_published));
+    atomic_store_explicit(&s_seq, seq + 2, memory_order_release);
+    atomic_fetch_add(&s_commits, 1);
+
+    if (holds_lvgl_mutex()) {
+        memcpy(&s_view, s_stage, sizeof(s_view));
+        s_view_seq = seq + 2;
+        s_view_gen++;
+        atomic_fetch_add(&s_view_syncs, 1);
+    }
+}
 
-void set_var_current_weekday(const char *value) {
-    strncpy(current_weekday, value, sizeof(current_weekday) / sizeof(char));
-    current_weekday[sizeof(current_weekday) / sizeof(char) - 1] = 0;
+/**
+ * @brief 当前提交是否为 LVGL 一侧推迟的提交（先判断 LVGL 互斥锁，其他任务不读取推迟状态）
+ */
+static bool in_deferred_commit(void) { return holds_lvgl_mutex() && s_defer_depth > 0; }
+
+/**
+ * @brief 将推迟的赋值合并到暂存副本（持有写锁与 LVGL 互斥锁时调用）
+ */
+static void apply_deferred(void) {
+    for (int id = 1; id < NATIVE_VAR_ID_COUNT; id++) {
+        if ((s_deferred_mask & (1u << id)) != 0 && assign_from(s_stage, s_deferred, id)) {
+            atomic_fetch_add(&s_changes, 1);
+            s_dirty = true;
+        }
+    }
+    s_deferred_mask = 0;
 }
 
-char yiyan[100] = {0};
+/**
+ * @brief 按顺序锁读取发布副本
+ *
+ * @param seq 输出读到的发布序号
+ * @return true 读到完整的副本
+ */
+static bool read_published(vars_snapshot_t *out, uint32_t *seq) {
+    uint32_t before = atomic_load_explicit(&s_seq, memory_order_acquire);
+    if (before & 1) {
+        return false;
+    }
+    memcpy(out, s_published, sizeof(*out));
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&s_seq, memory_order_relaxed) != before) {
+        return false;
+    }
+    *seq = before;
+    return true;
+}
 
-const char *get_var_yiyan() { return yiyan; }
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_err_t vars_init(void) {
+    if (s_write_lock != NULL) {
+        return ESP_OK;
+    }
+
+    s_stage = heap_caps_calloc(1, sizeof(vars_snapshot_t), MALLOC_CAP_SPIRAM);
+    s_published = heap_caps_calloc(1, sizeof(vars_snapshot_t), MALLOC_CAP_SPIRAM);
+    s_scratch = heap_caps_calloc(1, sizeof(vars_snapshot_t), MALLOC_CAP_SPIRAM);
+    s_deferred = heap_caps_calloc(1, sizeof(vars_snapshot_t), MALLOC_CAP_SPIRAM);
+    SemaphoreHandle_t lock = xSemaphoreCreateRecursiveMutex();
+    if (s_stage == NULL || s_published == NULL || s_scratch == NULL || s_deferred == NULL ||
+        lock == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate variable store");
+        heap_caps_free(s_stage);
+        heap_caps_free(s_published);
+        heap_caps_free(s_scratch);
+        heap_caps_free(s_deferred);
+        s_stage = s_published = s_scratch = s_deferred = NULL;
+        if (lock != NULL) {
+            vSemaphoreDelete(lock);
+        }
+        return ESP_ERR_NO_MEM;
+    }
+    s_write_lock = lock;
+    return ESP_OK;
+}
 
-void set_var_yiyan(const char *value) {
-    strncpy(yiyan, value, sizeof(yiyan) / sizeof(char));
-    yiyan[sizeof(yiyan) / sizeof(char) - 1] = 0;
+esp_err_t vars_begin(void) {
+    if (s_write_lock == NULL) {
+        ESP_LOGE(TAG, "vars_init has not been called");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!holds_lvgl_mutex()) {
+        xSemaphoreTakeRecursive(s_write_lock, portMAX_DELAY);
+        s_depth++;
+        return ESP_OK;
+    }
+
+    // LVGL 任务不等待写锁：写锁被其他任务占用时推迟发布
+    if (s_defer_depth == 0 && xSemaphoreTakeRecursive(s_write_lock, 0) == pdTRUE) {
+        if (s_depth++ == 0) {
+            apply_deferred();
+        }
+        return ESP_OK;
+    }
+    if (s_defer_depth++ == 0) {
+        atomic_fetch_add(&s_lvgl_deferred, 1);
+    }
+    return ESP_OK;
 }
 
-char solar_term[100] = {0};
+void vars_commit(void) {
+    if (in_deferred_commit()) {
+        // 赋值已写入 LVGL 副本，由之后的 vars_begin 或 vars_sync 发布
+        if (--s_defer_depth == 0 && s_defer_dirty) {
+            s_defer_dirty = false;
+            s_view_gen++;
+        }
+        return;
+    }
+    if (--s_depth == 0 && s_dirty) {
+        s_dirty = false;
+        publish();
+    }
+    xSemaphoreGiveRecursive(s_write_lock);
+}
 
-const char *get_var_solar_term() { return solar_term; }
+void vars_set_str(enum NativeVarId id, const char *value) {
+    if (s_slots[id].type != VAR_TYPE_STRING || vars_begin() != ESP_OK) {
+        return;
+    }
+    if (in_deferred_commit()) {
+        assign_str(s_deferred, id, value);
+        s_deferred_mask |= 1u << id;
+        s_defer_dirty |= assign_str(&s_view, id, value);
+    } else if (assign_str(s_stage, id, value)) {
+        atomic_fetch_add(&s_changes, 1);
+        s_dirty = true;
+    }
+    vars_commit();
+}
 
-void set_var_solar_term(const char *value) {
-    strncpy(solar_term, value, sizeof(solar_term) / sizeof(char));
-    solar_term[sizeof(solar_term) / sizeof(char) - 1] = 0;
+void vars_set_int(enum NativeVarId id, int32_t value) {
+    if (s_slots[id].type != VAR_TYPE_INT32 || vars_begin() != ESP_OK) {
+        return;
+    }
+    if (in_deferred_commit()) {
+        assign_int(s_deferred, id, value);
+        s_deferred_mask |= 1u << id;
+        s_defer_dirty |= assign_int(&s_view, id, value);
+    } else if (assign_int(s_stage, id, value)) {
+        atomic_fetch_add(&s_changes, 1);
+        s_dirty = true;
+    }
+    vars_commit();
 }
 
-char weather_text[100] = {0};
+var_type_t vars_type(enum NativeVarId id) { return s_slots[id].type; }
 
-const char *get_var_weather_text() { return weather_text; }
+const char *vars_snapshot_str(const vars_snapshot_t *snapshot, enum NativeVarId id) {
+    return slot_str((vars_snapshot_t *)snapshot, id);
+}
+
+int32_t vars_snapshot_int(const vars_snapshot_t *snapshot, enum NativeVarId id) {
+    return *slot_int((vars_snapshot_t *)snapshot, id);
+}
 
-void set_var_weather_text(const char *value) {
-    strncpy(weather_text, value, sizeof(weather_text) / sizeof(char));
-    weather_text[sizeof(weather_text) / sizeof(char) - 1] = 0;
+bool vars_read(vars_snapshot_t *out) {
+    uint32_t seq;
+    if (s_published == NULL) {
+        memset(out, 0, sizeof(*out));
+        return true;
+    }
+    if (!read_published(out, &seq)) {
+        atomic_fetch_add(&s_read_failed, 1);
+        return false;
+    }
+    return true;
 }
 
-char weather_icon[100] = {0};
+void vars_sync(void) {
+    if (s_published == NULL) {
+        return;
+    }
+    // 发布推迟的赋值；写锁仍被占用时留到下一个 tick
+    if (s_deferred_mask != 0 && xSemaphoreTakeRecursive(s_write_lock, 0) == pdTRUE) {
+        s_depth++;
+        apply_deferred();
+        vars_commit();
+    }
+    if (atomic_load_explicit(&s_seq, memory_order_acquire) == s_view_seq) {
+        return;
+    }
+    uint32_t seq;
+    if (!read_published(s_scratch, &seq)) {
+        atomic_fetch_add(&s_view_deferred, 1);
+        return;
+    }
+    // 尚未发布的赋值保留在 LVGL 副本中，版本号不变，不会被当作变化
+    for (int id = 1; id < NATIVE_VAR_ID_COUNT; id++) {
+        if ((s_deferred_mask & (1u << id)) != 0) {
+            assign_from(s_scratch, s_deferred, id);
+            s_scratch->versions[id] = s_view.versions[id];
+        }
+    }
+    memcpy(&s_view, s_scratch, sizeof(s_view));
+    s_view_seq = seq;
+    s_view_gen++;
+    atomic_fetch_add(&s_view_syncs, 1);
+}
 
-const char *get_var_weather_icon() { return weather_icon; }
+void vars_get_stats(vars_stats_t *stats) {
+    stats->commits = atomic_load(&s_commits);
+    stats->changes = atomic_load(&s_changes);
+    stats->view_syncs = atomic_load(&s_view_syncs);
+    stats->view_deferred = atomic_load(&s_view_deferred);
+    stats->read_failed = atomic_load(&s_read_failed);
+    stats->lvgl_deferred = atomic_load(&s_lvgl_deferred);
+}
 
-void set_var_weather_icon(const char *value) {
-    strncpy(weather_icon, value, sizeof(weather_icon) / sizeof(char));
-    weather_icon[sizeof(weather_icon) / sizeof(char) - 1] = 0;
+void vars_watch_reset(vars_watch_t *watch) { watch->primed = false; }
+
+uint32_t vars_watch_poll(vars_watch_t *watch) {
+    if (watch->primed && watch->version == s_view_gen) {
+        return 0;
+    }
+
+    uint32_t changed = 0;
+    for (int id = 1; id < NATIVE_VAR_ID_COUNT; id++) {
+        if (!watch->primed || s_view.versions[id] != watch->var_versions[id]) {
+            watch->var_versions[id] = s_view.versions[id];
+            changed |= 1u << id;
+        }
+    }
+    watch->version = s_view_gen;
+    watch->primed = true;
+    return changed;
 }
 
-char weather_temp[100] = {0};
+// ============================================================================
+// EEZ 原生变量
+// ============================================================================
 
-const char *get_var_weather_temp() { return weather_temp; }
+const char *get_var_current_time() { return s_view.current_time; }
 
-void set_var_weather_temp(const char *value) {
-    strncpy(weather_temp, value, sizeof(weather_temp) / sizeof(char));
-    weather_temp[sizeof(weather_temp) / sizeof(char) - 1] = 0;
-}
+void set_var_current_time(const char *value) { vars_set_str(NATIVE_VAR_ID_CURRENT_TIME, value); }
 
-char weather_uptime[100] = {0};
+const char *get_var_current_date() { return s_view.current_date; }
 
-const char *get_var_weather_uptime() { return weather_uptime; }
+void set_var_current_date(const char *value) { vars_set_str(NATIVE_VAR_ID_CURRENT_DATE, value); }
 
-void set_var_weather_uptime(const char *value) {
-    strncpy(weather_uptime, value, sizeof(weather_uptime) / sizeof(char));
-    weather_uptime[sizeof(weather_uptime) / sizeof(char) - 1] = 0;
+const char *get_var_current_weekday() { return s_view.current_weekday; }
+
+void set_var_current_weekday(const char *value) {
+    vars_set_str(NATIVE_VAR_ID_CURRENT_WEEKDAY, value);
 }
 
-char weather_location[100] = {0};
+const char *get_var_yiyan() { return s_view.yiyan; }
 
-const char *get_var_weather_location() { return weather_location; }
+void set_var_yiyan(const char *value) { vars_set_str(NATIVE_VAR_ID_YIYAN, value); }
 
-void set_var_weather_location(const char *value) {
-    strncpy(weather_location, value, sizeof(weather_location) / sizeof(char));
-    weather_location[sizeof(weather_location) / sizeof(char) - 1] = 0;
-}
+const char *get_var_solar_term() { return s_view.solar_term; }
 
-char weather_feelslike[100] = {0};
+void set_var_solar_term(const char *value) { vars_set_str(NATIVE_VAR_ID_SOLAR_TERM, value); }
 
-const char *get_var_weather_feelslike() { return weather_feelslike; }
+const char *get_var_weather_text() { return s_view.weather_text; }
 
-void set_var_weather_feelslike(const char *value) {
-    strncpy(weather_feelslike, value, sizeof(weather_feelslike) / sizeof(char));
-    weather_feelslike[sizeof(weather_feelslike) / sizeof(char) - 1] = 0;
-}
+void set_var_weather_text(const char *value) { vars_set_str(NATIVE_VAR_ID_WEATHER_TEXT, value); }
 
-char weather_wind_dir[100] = {0};
+const char *get_var_weather_icon() { return s_view.weather_icon; }
 
-const char *get_var_weather_wind_dir() { return weather_wind_dir; }
+void set_var_weather_icon(const char *value) { vars_set_str(NATIVE_VAR_ID_WEATHER_ICON, value); }
 
-void set_var_weather_wind_dir(const char *value) {
-    strncpy(weather_wind_dir, value, sizeof(weather_wind_dir) / sizeof(char));
-    weather_wind_dir[sizeof(weather_wind_dir) / sizeof(char) - 1] = 0;
-}
+const char *get_var_weather_temp() { return s_view.weather_temp; }
 
-int32_t weather_wind_scale;
+void set_var_weather_temp(const char *value) { vars_set_str(NATIVE_VAR_ID_WEATHER_TEMP, value); }
 
-int32_t get_var_weather_wind_scale() { return weather_wind_scale; }
+const char *get_var_weather_uptime() { return s_view.weather_uptime; }
 
-void set_var_weather_wind_scale(int32_t value) { weather_wind_scale = value; }
+void set_var_weather_uptime(const char *value) {
+    vars_set_str(NATIVE_VAR_ID_WEATHER_UPTIME, value);
+}
 
-int32_t weather_humidity;
+const char *get_var_weather_location() { return s_view.weather_location; }
 
-int32_t get_var_weather_humidity() { return weather_humidity; }
+void set_var_weather_location(const char *value) {
+    vars_set_str(NATIVE_VAR_ID_WEATHER_LOCATION, value);
+}
 
-void set_var_weather_humidity(int32_t value) { weather_humidity = value; }
+const char *get_var_weather_feelslike() { return s_view.weather_feelslike; }
 
-int32_t weather_precip;
+void set_var_weather_feelslike(const char *value) {
+    vars_set_str(NATIVE_VAR_ID_WEATHER_FEELSLIKE, value);
+}
+
+const char *get_var_weather_wind_dir() { return s_view.weather_wind_dir; }
+
+void set_var_weather_wind_dir(const char *value) {
+    vars_set_str(NATIVE_VAR_ID_WEATHER_WIND_DIR, value);
+}
 
-int32_t get_var_weather_precip() { return weather_precip; }
+int32_t get_var_weather_wind_scale() { return s_view.weather_wind_scale; }
 
-void set_var_weather_precip(int32_t value) { weather_precip = value; }
+void set_var_weather_wind_scale(int32_t value) {
+    vars_set_int(NATIVE_VAR_ID_WEATHER_WIND_SCALE, value);
+}
 
-int32_t weather_pressure;
+int32_t get_var_weather_humidity() { return s_view.weather_humidity; }
 
-int32_t get_var_weather_pressure() { return weather_pressure; }
+void set_var_weather_humidity(int32_t value) {
+    vars_set_int(NATIVE_VAR_ID_WEATHER_HUMIDITY, value);
+}
 
-void set_var_weather_pressure(int32_t value) { weather_pressure = value; }
+int32_t get_var_weather_precip() { return s_view.weather_precip; }
 
-int32_t weather_visibility;
+void set_var_weather_precip(int32_t value) { vars_set_int(NATIVE_VAR_ID_WEATHER_PRECIP, value); }
 
-int32_t get_var_weather_visibility() { return weather_visibility; }
+int32_t get_var_weather_pressure() { return s_view.weather_pressure; }
 
-void set_var_weather_visibility(int32_t value) { weather_visibility = value; }
+void set_var_weather_pressure(int32_t value) {
+    vars_set_int(NATIVE_VAR_ID_WEATHER_PRESSURE, value);
+}
 
-int32_t weather_cloud;
+int32_t get_var_weather_visibility() { return s_view.weather_visibility; }
 
-int32_t get_var_weather_cloud() { return weather_cloud; }
+void set_var_weather_visibility(int32_t value) {
+    vars_set_int(NATIVE_VAR_ID_WEATHER_VISIBILITY, value);
+}
 
-void set_var_weather_cloud(int32_t value) { weather_cloud = value; }
+int32_t get_var_weather_cloud() { return s_view.weather_cloud; }
 
-int32_t weather_dew;
+void set_var_weather_cloud(int32_t value) { vars_set_int(NATIVE_VAR_ID_WEATHER_CLOUD, value); }
 
-int32_t get_var_weather_dew() { return weather_dew; }
+int32_t get_var_weather_dew() { return s_view.weather_dew; }
 
-void set_var_weather_dew(int32_t value) { weather_dew = value; }
+void set_var_weather_dew(int32_t value) { vars_set_int(NATIVE_VAR_ID_WEATHER_DEW, value); }
@@ -1,25 +1,27 @@
-#ifndef EEZ_LVGL_UI_VARS_H
-#define EEZ_LVGL_UI_VARS_H
-
-#include <stdint.h>
-#include <stdbool.h>
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-// enum declarations
-
-
-
-// Flow global variables
-
+#ifndef EEZ_LVGL_UI_VARS_H
+#define EEZ_LVGL_UI_VARS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// enum declarations
+
+
+
+// Flow global variables
+
 enum FlowGlobalVariables {
     FLOW_GLOBAL_VARIABLE_NONE
-};
-
-// Native global variables
-
+};
+
+// Native global variables
+
 extern const char *get_var_current_time();
 extern void set_var_current_time(const char *value);
 extern const char *get_var_current_date();
@@ -58,10 +60,194 @@ extern int32_t get_var_weather_cloud();
 extern void set_var_weather_cloud(int32_t value);
 extern int32_t get_var_weather_dew();
 extern void set_var_weather_dew(int32_t value);
-
-
-#ifdef __cplusplus
-}
-#endif
-
+
+// Native variable store
+//
+// 变量保存在带版本号的存储中，可以在任意任务中读写：
+// - 写入方持有写锁修改暂存副本；vars_begin / vars_commit 之间的多次赋值作为一次提交，
+//   提交时以顺序锁（seqlock）整体发布。单独调用 set_var_* 相当于只含一次赋值的提交。
+// - LVGL 一侧持有自己的副本，get_var_* 与 tick 函数只读这份副本（持有 LVGL 互斥锁时）。
+//   vars_sync 在每个 tick 开始时复制最新的提交，不等待写锁；遇到进行中的提交时保留旧
+//   副本，下一个 tick 再复制，因此一次提交的所有变化总是在同一个 tick 中生效。
+//   LVGL 一侧的写入从不等待写锁，写锁被占用时先写入自己的副本，之后再发布。
+// - 其他任务以 vars_read 读取一致的快照。
+// 变量的版本号只在值实际变化时递增，lvgl_init.c 用 vars_watch_poll 取得变化的变量，只在
+// 当前屏幕依赖的变量（screen_deps.h）变化时执行 tick_screen_*。
+
+/** @brief 字符串变量的容量（含结尾的 0） */
+#define VARS_STR_MAX 100
+
+enum NativeVarId {
+    NATIVE_VAR_ID_NONE,
+    NATIVE_VAR_ID_CURRENT_TIME,
+    NATIVE_VAR_ID_CURRENT_DATE,
+    NATIVE_VAR_ID_CURRENT_WEEKDAY,
+    NATIVE_VAR_ID_YIYAN,
+    NATIVE_VAR_ID_SOLAR_TERM,
+    NATIVE_VAR_ID_WEATHER_TEXT,
+    NATIVE_VAR_ID_WEATHER_ICON,
+    NATIVE_VAR_ID_WEATHER_TEMP,
+    NATIVE_VAR_ID_WEATHER_UPTIME,
+    NATIVE_VAR_ID_WEATHER_LOCATION,
+    NATIVE_VAR_ID_WEATHER_FEELSLIKE,
+    NATIVE_VAR_ID_WEATHER_WIND_DIR,
+    NATIVE_VAR_ID_WEATHER_WIND_SCALE,
+    NATIVE_VAR_ID_WEATHER_HUMIDITY,
+    NATIVE_VAR_ID_WEATHER_PRECIP,
+    NATIVE_VAR_ID_WEATHER_PRESSURE,
+    NATIVE_VAR_ID_WEATHER_VISIBILITY,
+    NATIVE_VAR_ID_WEATHER_CLOUD,
+    NATIVE_VAR_ID_WEATHER_DEW,
+    NATIVE_VAR_ID_COUNT
+};
+
+/** @brief 变量在变化位图中的位 */
+#define NATIVE_VAR_BIT(id) (1u << (NATIVE_VAR_ID_##id))
+
+/**
+ * @brief 变量类型
+ */
+typedef enum {
+    VAR_TYPE_NONE,
+    VAR_TYPE_STRING,
+    VAR_TYPE_INT32,
+} var_type_t;
+
+/**
+ * @brief 所有变量的一致快照
+ */
+typedef struct {
+    char current_time[VARS_STR_MAX];
+    char current_date[VARS_STR_MAX];
+    char current_weekday[VARS_STR_MAX];
+    char yiyan[VARS_STR_MAX];
+    char solar_term[VARS_STR_MAX];
+    char weather_text[VARS_STR_MAX];
+    char weather_icon[VARS_STR_MAX];
+    char weather_temp[VARS_STR_MAX];
+    char weather_uptime[VARS_STR_MAX];
+    char weather_location[VARS_STR_MAX];
+    char weather_feelslike[VARS_STR_MAX];
+    char weather_wind_dir[VARS_STR_MAX];
+    int32_t weather_wind_scale;
+    int32_t weather_humidity;
+    int32_t weather_precip;
+    int32_t weather_pressure;
+    int32_t weather_visibility;
+    int32_t weather_cloud;
+    int32_t weather_dew;
+    uint32_t versions[NATIVE_VAR_ID_COUNT]; ///< 各变量的版本号，值变化时递增
+} vars_snapshot_t;
+
+/**
+ * @brief 变量存储统计
+ */
+typedef struct {
+    uint32_t commits;       ///< 发布的提交数（不含没有变化的提交）
+    uint32_t changes;       ///< 实际改变了值的赋值次数
+    uint32_t view_syncs;    ///< LVGL 副本的更新次数
+    uint32_t view_deferred; ///< 遇到进行中的提交而推迟到下一个 tick 的次数
+    uint32_t read_failed;   ///< vars_read 遇到进行中的提交而失败的次数
+    uint32_t lvgl_deferred; ///< LVGL 一侧因写锁被占用而推迟发布的提交数
+} vars_stats_t;
+
+/**
+ * @brief 变化观察点，每个需要刷新控件的 tick 函数各持有一个
+ */
+typedef struct {
+    bool primed;                                ///< 是否已比对过
+    uint32_t version;                           ///< 上次比对时 LVGL 副本的版本
+    uint32_t var_versions[NATIVE_VAR_ID_COUNT]; ///< 上次比对时各变量的版本号
+} vars_watch_t;
+
+/**
+ * @brief 初始化变量存储（在任何 set_var_* 之前调用）
+ *
+ * @return ESP_OK 成功，ESP_ERR_NO_MEM 内存不足
+ */
+extern esp_err_t vars_init(void);
+
+/**
+ * @brief 开始一次提交，持有写锁直到对应的 vars_commit（可嵌套，最外层结束时发布）
+ *
+ * 两者之间只做赋值，不要进行网络请求等耗时操作，也不要获取 LVGL 互斥锁（LVGL 任务持有
+ * 该锁时也会写入变量，锁的顺序是先 LVGL 互斥锁、后写锁）。
+ * 持有 LVGL 互斥锁的调用者从不等待：写锁被占用时赋值立即写入 LVGL 副本，推迟到之后的
+ * vars_begin 或 vars_sync 再发布，其他任务的 vars_read 在此之前读不到。
+ *
+ * @return ESP_OK 成功，ESP_ERR_INVALID_STATE 未初始化（此时不要调用 vars_commit）
+ */
+extern esp_err_t vars_begin(void);
+
+/**
+ * @brief 结束提交；最外层且有变化时发布
+ *
+ * 调用者持有 LVGL 互斥锁时同时更新 LVGL 副本，之后的 get_var_* 立即读到新值。
+ */
+extern void vars_commit(void);
+
+/**
+ * @brief 设置字符串变量（超出 VARS_STR_MAX - 1 字节的部分被截断）
+ */
+extern void vars_set_str(enum NativeVarId id, const char *value);
+
+/**
+ * @brief 设置整数变量
+ */
+extern void vars_set_int(enum NativeVarId id, int32_t value);
+
+/**
+ * @brief 获取变量类型
+ */
+extern var_type_t vars_type(enum NativeVarId id);
+
+/**
+ * @brief 从快照中取字符串变量
+ */
+extern const char *vars_snapshot_str(const vars_snapshot_t *snapshot, enum NativeVarId id);
+
+/**
+ * @brief 从快照中取整数变量
+ */
+extern int32_t vars_snapshot_int(const vars_snapshot_t *snapshot, enum NativeVarId id);
+
+/**
+ * @brief 读取最近一次提交的一致快照（任意任务，不阻塞）
+ *
+ * @param out 输出快照
+ * @return true 成功；false 遇到进行中的提交，out 的内容无效，稍后重试
+ */
+extern bool vars_read(vars_snapshot_t *out);
+
+/**
+ * @brief 将最近一次提交复制到 LVGL 副本（持有 LVGL 互斥锁时，每个 tick 开始时调用）
+ *
+ * 没有新提交时只读取一次原子变量；遇到进行中的提交时保留旧副本，不等待。
+ */
+extern void vars_sync(void);
+
+/**
+ * @brief 获取变量存储统计
+ */
+extern void vars_get_stats(vars_stats_t *stats);
+
+/**
+ * @brief 重置观察点，下一次比对报告所有变量均已变化（屏幕重新创建时调用）
+ */
+extern void vars_watch_reset(vars_watch_t *watch);
+
+/**
+ * @brief 比对 LVGL 副本中上次调用以来变化的变量（持有 LVGL 互斥锁时调用）
+ *
+ * LVGL 副本没有更新时只比较一次版本即返回。
+ *
+ * @return 变化位图（NATIVE_VAR_BIT），首次调用或重置后为全部变量
+ */
+extern uint32_t vars_watch_poll(vars_watch_t *watch);
+
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /*EEZ_LVGL_UI_VARS_H*/
\ No newline at end of file
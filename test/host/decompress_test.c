@@ -0,0 +1,412 @@
+/**
+ * @file decompress_test.c
+ * @brief 流式 GZIP 解压器的单元测试
+ *
+ * 直接编译 decompress.c，用主机 zlib 按不同压缩级别与策略生成 GZIP 语料，检查
+ * gzip_stream_feed / gzip_stream_finish：
+ * - 单个成员在任意位置切分、逐字节喂入时输出不变；
+ * - 多个成员首尾相接（含空成员），成员边界落在两次喂入之间或同一次喂入中间；
+ * - 在成员中间截断时 finish 报告 Z_DATA_ERROR，不会把不完整的数据当作成功；
+ * - 成员之后的填充 0 被忽略，之后的非 0 数据报错；
+ * - 非 GZIP 数据原样透传，回调的返回值终止解压；
+ * - 共享解压器复用窗口，统计与实际一致。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "decompress.h"
+#include "esp_timer.h"
+
+/** @brief 输出缓冲容量 */
+#define TEST_OUT_MAX (256 * 1024)
+/** @brief 语料中单个成员的最大压缩长度 */
+#define TEST_GZ_MAX (128 * 1024)
+
+/**
+ * @brief 收集解压输出
+ */
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t abort_after; ///< 累计输出超过该长度时回调返回 Z_ERRNO，0 表示不终止
+} sink_t;
+
+static int s_failed_checks;
+
+#define EXPECT(cond, ...)                                                                          \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s:%d: ", __func__, __LINE__);                                            \
+            printf(__VA_ARGS__);                                                                   \
+            printf("\n");                                                                          \
+            s_failed_checks++;                                                                     \
+        }                                                                                          \
+    } while (0)
+
+static int sink_cb(void *ctx, const uint8_t *data, size_t len) {
+    sink_t *sink = ctx;
+    if (sink->len + len > TEST_OUT_MAX) {
+        return Z_MEM_ERROR;
+    }
+    memcpy(sink->data + sink->len, data, len);
+    sink->len += len;
+    if (sink->abort_after != 0 && sink->len > sink->abort_after) {
+        return Z_ERRNO;
+    }
+    return Z_OK;
+}
+
+// ============================================================================
+// 桩
+// ============================================================================
+
+int64_t esp_timer_get_time(void) { return 0; }
+
+// ============================================================================
+// 语料
+// ============================================================================
+
+/**
+ * @brief 一段明文及其 GZIP 成员
+ */
+typedef struct {
+    const char *name;
+    uint8_t *plain;
+    size_t plain_len;
+    uint8_t *gz;
+    size_t gz_len;
+} sample_t;
+
+/**
+ * @brief 用 zlib 压缩为一个 GZIP 成员
+ */
+static size_t gzip_member(const uint8_t *in, size_t len, int level, int strategy, uint8_t *out,
+                          size_t out_max) {
+    z_stream zs = {0};
+    if (deflateInit2(&zs, level, Z_DEFLATED, 16 + MAX_WBITS, 8, strategy) != Z_OK) {
+        return 0;
+    }
+    zs.next_in = (Bytef *)in;
+    zs.avail_in = (uInt)len;
+    zs.next_out = out;
+    zs.avail_out = (uInt)out_max;
+    int err = deflate(&zs, Z_FINISH);
+    size_t produced = out_max - zs.avail_out;
+    deflateEnd(&zs);
+    return err == Z_STREAM_END ? produced : 0;
+}
+
+/**
+ * @brief 类似天气接口的 JSON 文本（重复度高，压缩比与真实响应接近）
+ */
+static size_t make_json(uint8_t *out, size_t max, int days) {
+    size_t n = (size_t)snprintf((char *)out, max, "{\"code\":\"200\",\"daily\":[");
+    for (int i = 0; i < days && n < max; i++) {
+        n += (size_t)snprintf((char *)out + n, max - n,
+                              "%s{\"fxDate\":\"2026-01-%02d\",\"tempMax\":\"%d\","
+                              "\"tempMin\":\"-8\",\"textDay\":\"晴\",\"windDirDay\":\"西北风\","
+                              "\"windScaleDay\":\"3-4\",\"humidity\":\"%d\",\"pressure\":\"1028\","
+                              "\"uvIndex\":\"2\"}",
+                              i ? "," : "", 1 + i % 28, 3 + i % 5, 20 + i);
+    }
+    n += (size_t)snprintf((char *)out + n, max - n, "]}");
+    return n;
+}
+
+static void make_sample(sample_t *s, const char *name, const uint8_t *plain, size_t len,
+                        int level, int strategy) {
+    s->name = name;
+    s->plain = malloc(len + 1);
+    s->gz = malloc(TEST_GZ_MAX);
+    memcpy(s->plain, plain, len);
+    s->plain_len = len;
+    s->gz_len = gzip_member(plain, len, level, strategy, s->gz, TEST_GZ_MAX);
+    if (s->gz_len == 0) {
+        printf("FAIL: could not compress sample %s\n", name);
+        s_failed_checks++;
+    }
+}
+
+static void free_sample(sample_t *s) {
+    free(s->plain);
+    free(s->gz);
+}
+
+// ============================================================================
+// 辅助
+// ============================================================================
+
+/**
+ * @brief 按给定切分把 input 喂给解压器
+ *
+ * @param cuts 各次喂入的结束位置（递增），最后一段到 len 为止
+ * @return feed 的第一个错误或 finish 的结果
+ */
+static int run_cuts(gzip_stream_t *gs, sink_t *sink, const uint8_t *input, size_t len,
+                    const size_t *cuts, int num_cuts) {
+    sink->len = 0;
+    gzip_stream_reset(gs, sink_cb, sink);
+    size_t pos = 0;
+    for (int i = 0; i <= num_cuts; i++) {
+        size_t end = (i < num_cuts) ? cuts[i] : len;
+        int err = gzip_stream_feed(gs, input + pos, end - pos);
+        if (err != Z_OK) {
+            return err;
+        }
+        pos = end;
+    }
+    return gzip_stream_finish(gs);
+}
+
+/**
+ * @brief 以固定块大小喂入
+ */
+static int run_chunked(gzip_stream_t *gs, sink_t *sink, const uint8_t *input, size_t len,
+                       size_t chunk) {
+    sink->len = 0;
+    gzip_stream_reset(gs, sink_cb, sink);
+    for (size_t pos = 0; pos < len; pos += chunk) {
+        size_t n = (len - pos < chunk) ? len - pos : chunk;
+        int err = gzip_stream_feed(gs, input + pos, n);
+        if (err != Z_OK) {
+            return err;
+        }
+    }
+    return gzip_stream_finish(gs);
+}
+
+static bool output_is(const sink_t *sink, const uint8_t *want, size_t want_len) {
+    return sink->len == want_len && memcmp(sink->data, want, want_len) == 0;
+}
+
+// ============================================================================
+// 用例
+// ============================================================================
+
+/**
+ * @brief 单个成员：各种块大小与逐字节喂入
+ */
+static void check_single(gzip_stream_t *gs, sink_t *sink, const sample_t *samples, int count) {
+    const size_t chunks[] = {1, 2, 7, 64, 511, 512, 513, 1460, 4096, TEST_GZ_MAX};
+    for (int i = 0; i < count; i++) {
+        const sample_t *s = &samples[i];
+        for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+            int err = run_chunked(gs, sink, s->gz, s->gz_len, chunks[c]);
+            EXPECT(err == Z_OK && output_is(sink, s->plain, s->plain_len),
+                   "%s in %zu-byte chunks: err %d, %zu/%zu bytes", s->name, chunks[c], err,
+                   sink->len, s->plain_len);
+        }
+    }
+}
+
+/**
+ * @brief 多个成员首尾相接：边界在任意位置切分
+ */
+static void check_multi_member(gzip_stream_t *gs, sink_t *sink, const sample_t *samples,
+                               int count) {
+    static uint8_t input[4 * TEST_GZ_MAX];
+    static uint8_t want[TEST_OUT_MAX];
+    size_t len = 0;
+    size_t want_len = 0;
+    size_t boundaries[8];
+    int num_boundaries = 0;
+    for (int i = 0; i < count; i++) {
+        memcpy(input + len, samples[i].gz, samples[i].gz_len);
+        len += samples[i].gz_len;
+        memcpy(want + want_len, samples[i].plain, samples[i].plain_len);
+        want_len += samples[i].plain_len;
+        boundaries[num_boundaries++] = len;
+    }
+
+    int err = run_cuts(gs, sink, input, len, NULL, 0);
+    EXPECT(err == Z_OK && output_is(sink, want, want_len),
+           "%d members in one feed: err %d, %zu/%zu bytes", count, err, sink->len, want_len);
+
+    // 在每个成员边界附近切一刀：成员结束、下一个成员的头部都可能落在两次喂入之间
+    for (int b = 0; b < num_boundaries - 1; b++) {
+        for (int delta = -12; delta <= 12; delta++) {
+            size_t cut = (size_t)((long)boundaries[b] + delta);
+            err = run_cuts(gs, sink, input, len, &cut, 1);
+            EXPECT(err == Z_OK && output_is(sink, want, want_len),
+                   "cut at member %d boundary %+d: err %d, %zu/%zu bytes", b, delta, err,
+                   sink->len, want_len);
+        }
+    }
+
+    // 每次喂入恰好一个成员
+    err = run_cuts(gs, sink, input, len, boundaries, num_boundaries - 1);
+    EXPECT(err == Z_OK && output_is(sink, want, want_len), "one member per feed: err %d", err);
+
+    // 逐字节喂入
+    err = run_chunked(gs, sink, input, len, 1);
+    EXPECT(err == Z_OK && output_is(sink, want, want_len), "byte by byte: err %d, %zu/%zu bytes",
+           err, sink->len, want_len);
+}
+
+/**
+ * @brief 截断：任意成员中间的截断都必须报错
+ */
+static void check_truncated(gzip_stream_t *gs, sink_t *sink, const sample_t *a,
+                            const sample_t *b) {
+    static uint8_t input[2 * TEST_GZ_MAX];
+    memcpy(input, a->gz, a->gz_len);
+    memcpy(input + a->gz_len, b->gz, b->gz_len);
+    size_t len = a->gz_len + b->gz_len;
+
+    int ok_cuts = 0;
+    for (size_t cut = 1; cut < len; cut++) {
+        if (cut == a->gz_len) {
+            // 恰好在第一个成员之后结束：是完整的单成员数据
+            int err = run_chunked(gs, sink, input, cut, 97);
+            EXPECT(err == Z_OK && output_is(sink, a->plain, a->plain_len),
+                   "cut after the first member: err %d", err);
+            ok_cuts++;
+            continue;
+        }
+        int err = run_chunked(gs, sink, input, cut, 97);
+        EXPECT(err != Z_OK, "truncated at %zu/%zu bytes reported Z_OK (%zu bytes out)", cut, len,
+               sink->len);
+    }
+    EXPECT(ok_cuts == 1, "member boundary not hit");
+}
+
+/**
+ * @brief 成员之后的填充 0 被忽略；填充之后再出现非 0 数据报错
+ */
+static void check_padding(gzip_stream_t *gs, sink_t *sink, const sample_t *a, const sample_t *b) {
+    static uint8_t input[2 * TEST_GZ_MAX + 4096];
+    static uint8_t want[TEST_OUT_MAX];
+    const size_t pads[] = {1, 2, 8, 511, 512, 1024, 4096};
+
+    for (size_t p = 0; p < sizeof(pads) / sizeof(pads[0]); p++) {
+        // 单个成员加填充：同一次喂入、单独喂入、逐字节喂入
+        size_t len = a->gz_len + pads[p];
+        memcpy(input, a->gz, a->gz_len);
+        memset(input + a->gz_len, 0, pads[p]);
+
+        int err = run_cuts(gs, sink, input, len, NULL, 0);
+        EXPECT(err == Z_OK && output_is(sink, a->plain, a->plain_len),
+               "%zu padding bytes in the same feed: err %d", pads[p], err);
+        err = run_cuts(gs, sink, input, len, &a->gz_len, 1);
+        EXPECT(err == Z_OK && output_is(sink, a->plain, a->plain_len),
+               "%zu padding bytes in a separate feed: err %d", pads[p], err);
+        err = run_chunked(gs, sink, input, len, 1);
+        EXPECT(err == Z_OK && output_is(sink, a->plain, a->plain_len),
+               "%zu padding bytes byte by byte: err %d", pads[p], err);
+
+        // 两个成员后加填充
+        memcpy(input + a->gz_len, b->gz, b->gz_len);
+        memset(input + a->gz_len + b->gz_len, 0, pads[p]);
+        len = a->gz_len + b->gz_len + pads[p];
+        memcpy(want, a->plain, a->plain_len);
+        memcpy(want + a->plain_len, b->plain, b->plain_len);
+        err = run_chunked(gs, sink, input, len, 300);
+        EXPECT(err == Z_OK && output_is(sink, want, a->plain_len + b->plain_len),
+               "two members + %zu padding bytes: err %d", pads[p], err);
+    }
+
+    // 填充之后的非 0 数据不是合法的 GZIP 成员
+    size_t len = a->gz_len + 16;
+    memcpy(input, a->gz, a->gz_len);
+    memset(input + a->gz_len, 0, 16);
+    input[len++] = 0x42;
+    int err = run_chunked(gs, sink, input, len, 64);
+    EXPECT(err != Z_OK, "trailing garbage after padding accepted");
+}
+
+/**
+ * @brief 非 GZIP 数据透传；回调返回错误时终止
+ */
+static void check_passthrough_and_abort(gzip_stream_t *gs, sink_t *sink, const sample_t *s) {
+    const char *plain = "{\"code\":\"200\"}";
+    int err = run_chunked(gs, sink, (const uint8_t *)plain, strlen(plain), 3);
+    EXPECT(err == Z_OK && output_is(sink, (const uint8_t *)plain, strlen(plain)),
+           "passthrough: err %d, %zu bytes", err, sink->len);
+
+    sink->abort_after = GZIP_STREAM_OUT_CHUNK;
+    err = run_chunked(gs, sink, s->gz, s->gz_len, 4096);
+    EXPECT(err == Z_ERRNO, "callback abort: err %d, expected %d", err, Z_ERRNO);
+    sink->abort_after = 0;
+}
+
+/**
+ * @brief 共享解压器：窗口只分配一次，统计与实际一致
+ */
+static void check_shared(sink_t *sink, const sample_t *s) {
+    EXPECT(decompress_init() == ESP_OK, "decompress_init");
+    const int rounds = 5;
+    for (int i = 0; i < rounds; i++) {
+        sink->len = 0;
+        gzip_stream_t *gs = gzip_stream_acquire(sink_cb, sink);
+        EXPECT(gs != NULL, "acquire");
+        if (gs == NULL) {
+            return;
+        }
+        int err = gzip_stream_feed(gs, s->gz, s->gz_len);
+        if (err == Z_OK) {
+            err = gzip_stream_finish(gs);
+        }
+        gzip_stream_release(gs, err == Z_OK);
+        EXPECT(err == Z_OK && output_is(sink, s->plain, s->plain_len), "shared round %d: err %d",
+               i, err);
+    }
+
+    gzip_stats_t stats;
+    gzip_get_stats(&stats);
+    EXPECT(stats.streams == (uint32_t)rounds && stats.inits == 1 &&
+               stats.resets == (uint32_t)rounds - 1 && stats.errors == 0,
+           "shared stats: %u streams, %u inits, %u resets, %u errors", stats.streams, stats.inits,
+           stats.resets, stats.errors);
+    EXPECT(stats.total_in == (uint64_t)rounds * s->gz_len &&
+               stats.total_out == (uint64_t)rounds * s->plain_len,
+           "shared stats: %llu in, %llu out", (unsigned long long)stats.total_in,
+           (unsigned long long)stats.total_out);
+}
+
+int main(void) {
+    static uint8_t buf[TEST_OUT_MAX / 2];
+    sample_t samples[5];
+
+    size_t n = make_json(buf, sizeof(buf), 30);
+    make_sample(&samples[0], "json-30d", buf, n, Z_BEST_COMPRESSION, Z_DEFAULT_STRATEGY);
+    n = make_json(buf, sizeof(buf), 7);
+    make_sample(&samples[1], "json-7d-fast", buf, n, Z_BEST_SPEED, Z_DEFAULT_STRATEGY);
+    make_sample(&samples[2], "empty", buf, 0, Z_DEFAULT_COMPRESSION, Z_DEFAULT_STRATEGY);
+    srand(7);
+    for (size_t i = 0; i < 20000; i++) {
+        buf[i] = (uint8_t)rand();
+    }
+    make_sample(&samples[3], "random-stored", buf, 20000, Z_DEFAULT_COMPRESSION,
+                Z_DEFAULT_STRATEGY);
+    n = make_json(buf, sizeof(buf), 3);
+    make_sample(&samples[4], "json-huffman", buf, n, Z_DEFAULT_COMPRESSION, Z_HUFFMAN_ONLY);
+
+    sink_t sink = {.data = malloc(TEST_OUT_MAX)};
+    gzip_stream_t *gs = malloc(sizeof(gzip_stream_t));
+    gzip_stream_init(gs, sink_cb, &sink);
+
+    check_single(gs, &sink, samples, 5);
+    check_multi_member(gs, &sink, samples, 5);
+    check_truncated(gs, &sink, &samples[0], &samples[1]);
+    check_padding(gs, &sink, &samples[0], &samples[2]);
+    check_passthrough_and_abort(gs, &sink, &samples[0]);
+    check_shared(&sink, &samples[0]);
+
+    gzip_stream_deinit(gs);
+    free(gs);
+    free(sink.data);
+    for (int i = 0; i < 5; i++) {
+        printf("%-14s %6zu -> %6zu bytes\n", samples[i].name, samples[i].gz_len,
+               samples[i].plain_len);
+        free_sample(&samples[i]);
+    }
+
+    if (s_failed_checks != 0) {
+        printf("%d check(s) failed\n", s_failed_checks);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
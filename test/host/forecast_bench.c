@@ -0,0 +1,508 @@
+/**
+ * @file forecast_bench.c
+ * @brief 30 天预报的解析开销：流式解压 + 增量解析 对比 旧的整包缓冲 + cJSON
+ *
+ * 对 data/ 下每个 30 天预报响应（和风天气 v7 格式）启动 tools/mock_upstream.py 提供该响应，
+ * 两条路径各请求若干次：
+ * - stream：固件中的 get_weather_forecast()（weather.c、json_stream.c、json_bind.c、
+ *   decompress.c 与 http_pool.c），响应边收边解压边解析；
+ * - buffered：按改为流式解析之前 weather.c 的做法，ON_DATA 中 heap_caps_realloc 累积整个压缩
+ *   响应，请求结束后 inflate 到固定的 8 KB 缓冲区再交给 cJSON；同时测量把缓冲区放大到足以
+ *   容纳整个响应时的开销（旧代码的最好情况）。
+ *
+ * 每条路径报告调用线程的 CPU 时间中位数与 heap_caps 峰值占用。旧路径中 zlib 与 cJSON 的分配
+ * 改为经过 heap_caps，以便计入峰值；共享解压器在第一次解压时分配窗口并一直保留，
+ * 这部分常驻占用单独列出。cJSON 不随仓库提供，找不到时（见 CMakeLists.txt）只测量旧路径的
+ * 累积与解压。
+ *
+ * 用法：forecast_bench <python3> <tools/mock_upstream.py> <响应目录>...
+ */
+
+#define _GNU_SOURCE
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "esp_heap_caps.h"
+#include "esp_http_client.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "zlib.h"
+
+#include "config_manager.h"
+#include "decompress.h"
+#include "http_cache.h"
+#include "http_pool.h"
+#include "ip_location.h"
+#include "metrics.h"
+#include "net_health.h"
+#include "weather.h"
+#include "wifi.h"
+
+#ifdef BENCH_HAVE_CJSON
+#include "cJSON.h"
+#endif
+
+/** @brief 每条路径的请求次数 */
+#define BENCH_ROUNDS 25
+/** @brief 旧代码中预报响应的解压缓冲区大小 */
+#define BENCH_OLD_FORECAST_BUF 8192
+/** @brief 解析得到的天数（weather_forecast_t 最多 10 天） */
+#define BENCH_EXPECT_DAYS 10
+
+static char s_api_host[64];
+static int s_failed_checks;
+static size_t s_boot_heap; ///< 初始化前的 heap_caps 占用，打印常驻占用后清零
+
+// ============================================================================
+// 桩
+// ============================================================================
+
+int64_t esp_timer_get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+uint32_t esp_random(void) { return (uint32_t)rand(); }
+
+void config_manager_get_config(sys_config_t *config) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->weather.api_host, sizeof(config->weather.api_host), "%s", s_api_host);
+    snprintf(config->weather.api_key, sizeof(config->weather.api_key), "mock");
+}
+
+void metrics_observe(metric_id_t id, uint8_t index, int64_t us) {}
+
+void wifi_note_first_byte(void) {}
+
+// ============================================================================
+// 模拟服务器
+// ============================================================================
+
+static int free_port(void) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    socklen_t len = sizeof(addr);
+    if (bind(fd, (struct sockaddr *)&addr, len) != 0 ||
+        getsockname(fd, (struct sockaddr *)&addr, &len) != 0) {
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    return ntohs(addr.sin_port);
+}
+
+static bool mock_ready(void) {
+    char url[128];
+    snprintf(url, sizeof(url), "%s/_mock/stats", s_api_host);
+    esp_http_client_config_t config = {.url = url};
+    esp_http_client_handle_t client = esp_http_client_init(&config);
+    if (client == NULL) {
+        return false;
+    }
+    bool ok = esp_http_client_perform(client) == ESP_OK &&
+              esp_http_client_get_status_code(client) == 200;
+    esp_http_client_cleanup(client);
+    return ok;
+}
+
+static pid_t mock_start(const char *python, const char *script, const char *data_dir) {
+    int port = free_port();
+    if (port < 0) {
+        return -1;
+    }
+    snprintf(s_api_host, sizeof(s_api_host), "http://127.0.0.1:%d", port);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        char port_arg[16];
+        snprintf(port_arg, sizeof(port_arg), "%d", port);
+        freopen("/dev/null", "w", stderr);
+        execlp(python, python, script, "--host", "127.0.0.1", "--port", port_arg, "--max-age",
+               "0", "--data-dir", data_dir, (char *)NULL);
+        _exit(127);
+    }
+
+    for (int i = 0; i < 100; i++) {
+        if (mock_ready()) {
+            return pid;
+        }
+        usleep(100 * 1000);
+    }
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+    return -1;
+}
+
+static void mock_stop(pid_t pid) {
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+}
+
+// ============================================================================
+// 测量
+// ============================================================================
+
+#define EXPECT(cond, ...)                                                                          \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s:%d: ", __func__, __LINE__);                                            \
+            printf(__VA_ARGS__);                                                                   \
+            printf("\n");                                                                          \
+            s_failed_checks++;                                                                     \
+        }                                                                                          \
+    } while (0)
+
+/**
+ * @brief 一条路径多次请求的结果
+ */
+typedef struct {
+    int64_t cpu_us[BENCH_ROUNDS];  ///< 每次请求的线程 CPU 时间
+    int64_t step_us[BENCH_ROUNDS]; ///< 旧路径：解压与解析的 CPU 时间（不含网络收发）
+    size_t peak;                   ///< 各次请求中最大的 heap_caps 峰值占用
+    int rounds;                    ///< 完成的请求次数
+} bench_t;
+
+static int64_t thread_cpu_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int cmp_i64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int64_t median_us(int64_t *values, int count) {
+    if (count == 0) {
+        return 0;
+    }
+    qsort(values, count, sizeof(int64_t), cmp_i64);
+    return values[count / 2];
+}
+
+static void bench_begin(size_t *base) {
+    *base = host_heap_in_use();
+    host_heap_reset_peak();
+}
+
+static void bench_end(bench_t *b, size_t base, int64_t cpu_us, int64_t step_us) {
+    size_t peak = host_heap_peak() - base;
+    if (peak > b->peak) {
+        b->peak = peak;
+    }
+    b->cpu_us[b->rounds] = cpu_us;
+    b->step_us[b->rounds] = step_us;
+    b->rounds++;
+}
+
+static void print_row(const char *payload, const char *path, const char *result, bench_t *b,
+                      bool has_step) {
+    int64_t cpu = median_us(b->cpu_us, b->rounds);
+    printf("%-22s %-16s %-20s %7lld us", payload, path, result, (long long)cpu);
+    if (has_step) {
+        printf("  (inflate+parse %5lld us)", (long long)median_us(b->step_us, b->rounds));
+    } else {
+        printf("  %25s", "");
+    }
+    printf("  peak %6zu B\n", b->peak);
+}
+
+// ============================================================================
+// 流式路径（固件代码）
+// ============================================================================
+
+static void bench_stream(const char *payload) {
+    bench_t b = {0};
+    int days = -1;
+    bool ordered = true;
+
+    // 第 -1 次为预热（建立长连接、缓存表项），不计入结果
+    for (int i = -1; i < BENCH_ROUNDS; i++) {
+        // 每次换一个位置，URL 不同，不会命中条件请求的 304
+        location_t loc = {.longitude = 100.0f + i * 0.5f, .latitude = 30.0f};
+        weather_forecast_t forecast;
+        bool updated = false;
+        size_t base;
+        bench_begin(&base);
+        int64_t start = thread_cpu_us();
+        esp_err_t err = get_weather_forecast(&loc, 30, &forecast, &updated);
+        int64_t cpu = thread_cpu_us() - start;
+        EXPECT(err == ESP_OK && updated, "%s stream: %s", payload, esp_err_to_name(err));
+        if (err != ESP_OK) {
+            return;
+        }
+        if (i >= 0) {
+            bench_end(&b, base, cpu, 0);
+        } else if (s_boot_heap != 0) {
+            // 共享解压器的 inflate 状态与 32 KB 窗口在第一次解压时分配，之后一直保留
+            printf("kept after the first request: %zu B (shared inflate state and window, "
+                   "pooled client, cache entry)\n",
+                   host_heap_in_use() - s_boot_heap);
+            s_boot_heap = 0;
+        }
+
+        days = forecast.count;
+        for (int d = 1; d < forecast.count; d++) {
+            ordered = ordered &&
+                      strcmp(forecast.daily[d - 1].fx_date, forecast.daily[d].fx_date) < 0;
+        }
+    }
+    EXPECT(days == BENCH_EXPECT_DAYS && ordered, "%s stream: %d days, ordered %d", payload, days,
+           ordered);
+
+    char result[32];
+    snprintf(result, sizeof(result), "ok, %d days", days);
+    print_row(payload, "stream", result, &b, false);
+}
+
+// ============================================================================
+// 旧路径：整包缓冲 + 一次性解压 + cJSON
+// ============================================================================
+
+/**
+ * @brief 旧代码的响应累积缓冲区
+ */
+typedef struct {
+    char *data;
+    size_t len;
+} old_response_t;
+
+/**
+ * @brief 与旧 weather.c 的 http_event_handler 相同：每个数据块 realloc 一次
+ */
+static esp_err_t old_event_handler(esp_http_client_event_t *evt) {
+    old_response_t *resp = evt->user_data;
+    switch (evt->event_id) {
+    case HTTP_EVENT_ON_HEADER:
+        heap_caps_free(resp->data);
+        resp->data = NULL;
+        resp->len = 0;
+        break;
+    case HTTP_EVENT_ON_DATA: {
+        char *tmp = heap_caps_realloc(resp->data, resp->len + evt->data_len, MALLOC_CAP_SPIRAM);
+        if (tmp == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        resp->data = tmp;
+        memcpy(resp->data + resp->len, evt->data, evt->data_len);
+        resp->len += evt->data_len;
+        break;
+    }
+    default:
+        break;
+    }
+    return ESP_OK;
+}
+
+static voidpf old_zalloc(voidpf opaque, uInt items, uInt size) {
+    return heap_caps_malloc((size_t)items * size, MALLOC_CAP_SPIRAM);
+}
+
+static void old_zfree(voidpf opaque, voidpf address) { heap_caps_free(address); }
+
+/**
+ * @brief 旧的 network_gzip_decompress：每次新建 inflate 状态，输出缓冲区满时截断
+ *
+ * @return Z_OK 成功；*truncated 表示输出被截断
+ */
+static int old_gzip_decompress(const void *in, size_t in_size, char *out, size_t out_size,
+                               size_t *out_len, bool *truncated) {
+    z_stream zs = {.zalloc = old_zalloc, .zfree = old_zfree};
+    int err = inflateInit2(&zs, 16 + MAX_WBITS);
+    if (err != Z_OK) {
+        return err;
+    }
+    zs.next_in = (Bytef *)in;
+    zs.avail_in = in_size;
+    zs.next_out = (Bytef *)out;
+    zs.avail_out = out_size - 1;
+    err = inflate(&zs, Z_NO_FLUSH);
+    *truncated = (err != Z_STREAM_END && zs.avail_out == 0);
+    *out_len = zs.total_out;
+    out[*out_len] = '\0';
+    inflateEnd(&zs);
+    return (err == Z_STREAM_END || *truncated) ? Z_OK : err;
+}
+
+#ifdef BENCH_HAVE_CJSON
+static void *old_cjson_malloc(size_t size) { return heap_caps_malloc(size, MALLOC_CAP_SPIRAM); }
+
+/**
+ * @brief 与旧 parse_weather_forecast 相同的查找：每天逐个字段 GetObjectItemCaseSensitive
+ *
+ * @return 解析得到的天数，JSON 无法解析时返回 -1
+ */
+static int old_parse_forecast(const char *json, weather_forecast_t *forecast) {
+    static const char *const fields[] = {
+        "fxDate",    "sunrise",       "sunset",       "moonrise",       "moonset",
+        "moonPhase", "moonPhaseIcon", "tempMax",      "tempMin",        "iconDay",
+        "textDay",   "iconNight",     "textNight",    "wind360Day",     "windDirDay",
+        "humidity",  "windScaleDay",  "windSpeedDay", "wind360Night",   "windDirNight",
+        "precip",    "pressure",      "vis",          "windScaleNight", "windSpeedNight",
+        "cloud",     "uvIndex",
+    };
+    cJSON *root = cJSON_Parse(json);
+    if (root == NULL) {
+        return -1;
+    }
+    cJSON *daily = cJSON_GetObjectItemCaseSensitive(root, "daily");
+    int count = 0;
+    cJSON *day = NULL;
+    cJSON_ArrayForEach(day, daily) {
+        if (count >= BENCH_EXPECT_DAYS) {
+            break;
+        }
+        weather_daily_t *out = &forecast->daily[count];
+        // 只把 fxDate、tempMax、tempMin（下标 0、7、8）写入结构体用于核对，其余字段只查找
+        for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+            cJSON *item = cJSON_GetObjectItemCaseSensitive(day, fields[f]);
+            if (f == 0 && cJSON_IsString(item)) {
+                snprintf(out->fx_date, sizeof(out->fx_date), "%s", item->valuestring);
+            } else if (f == 7 && cJSON_IsString(item)) {
+                out->temp_max = (int8_t)atoi(item->valuestring);
+            } else if (f == 8 && cJSON_IsString(item)) {
+                out->temp_min = (int8_t)atoi(item->valuestring);
+            }
+        }
+        count++;
+    }
+    forecast->count = count;
+    cJSON_Delete(root);
+    return count;
+}
+#endif
+
+/**
+ * @brief 旧路径的一次请求
+ *
+ * @param buf_size 解压缓冲区大小
+ * @param[out] step_us 解压与解析的 CPU 时间
+ * @return 解析得到的天数；-1 表示 JSON 无法解析（截断），-2 表示请求或解压失败
+ */
+static int old_request(int round, size_t buf_size, bool *truncated, int64_t *step_us) {
+    char url[192];
+    snprintf(url, sizeof(url), "%s/v7/weather/30d?location=%.2f,30.00&key=mock", s_api_host,
+             200.0 + round * 0.5);
+    old_response_t resp = {0};
+    esp_http_client_config_t config = {
+        .url = url, .event_handler = old_event_handler, .user_data = &resp};
+    esp_http_client_handle_t client = esp_http_client_init(&config);
+    esp_err_t err = esp_http_client_perform(client);
+    esp_http_client_cleanup(client);
+    if (err != ESP_OK || resp.data == NULL) {
+        heap_caps_free(resp.data);
+        return -2;
+    }
+
+    int64_t start = thread_cpu_us();
+    int days = -2;
+    char *text = heap_caps_malloc(buf_size, MALLOC_CAP_SPIRAM);
+    size_t text_len = 0;
+    if (old_gzip_decompress(resp.data, resp.len, text, buf_size, &text_len, truncated) == Z_OK) {
+#ifdef BENCH_HAVE_CJSON
+        weather_forecast_t forecast;
+        days = old_parse_forecast(text, &forecast);
+#else
+        days = *truncated ? -1 : 0;
+#endif
+    }
+    *step_us = thread_cpu_us() - start;
+    heap_caps_free(text);
+    heap_caps_free(resp.data);
+    return days;
+}
+
+static void bench_old(const char *payload, const char *path, size_t buf_size, bool expect_ok) {
+    bench_t b = {0};
+    int days = 0;
+    bool truncated = false;
+    for (int i = -1; i < BENCH_ROUNDS; i++) {
+        size_t base;
+        int64_t step_us = 0;
+        bench_begin(&base);
+        int64_t start = thread_cpu_us();
+        days = old_request(i, buf_size, &truncated, &step_us);
+        int64_t cpu = thread_cpu_us() - start;
+        if (days == -2) {
+            EXPECT(false, "%s %s: request or inflate failed", payload, path);
+            return;
+        }
+        if (i >= 0) {
+            bench_end(&b, base, cpu, step_us);
+        }
+    }
+
+    char result[32];
+    if (truncated) {
+        snprintf(result, sizeof(result), "truncated at %zu B", buf_size - 1);
+    } else if (days < 0) {
+        snprintf(result, sizeof(result), "parse failed");
+    } else {
+#ifdef BENCH_HAVE_CJSON
+        snprintf(result, sizeof(result), "ok, %d days", days);
+#else
+        snprintf(result, sizeof(result), "ok, no cJSON");
+#endif
+    }
+    EXPECT(truncated != expect_ok, "%s %s: truncated %d", payload, path, truncated);
+#ifdef BENCH_HAVE_CJSON
+    EXPECT(!expect_ok || days == BENCH_EXPECT_DAYS, "%s %s: %d days", payload, path, days);
+#endif
+    print_row(payload, path, result, &b, true);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        fprintf(stderr, "usage: %s <python3> <mock_upstream.py> <payload dir>...\n", argv[0]);
+        return 2;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+#ifdef BENCH_HAVE_CJSON
+    cJSON_Hooks hooks = {.malloc_fn = old_cjson_malloc, .free_fn = heap_caps_free};
+    cJSON_InitHooks(&hooks);
+#else
+    printf("cJSON not found: the buffered path is measured without the DOM parse\n");
+#endif
+
+    http_pool_init();
+    http_cache_init();
+    net_health_init();
+    s_boot_heap = host_heap_in_use();
+    decompress_init();
+    printf("%-22s %-16s %-20s %10s  %25s  %s\n", "payload", "path", "result", "cpu", "",
+           "peak heap");
+
+    for (int i = 3; i < argc; i++) {
+        const char *payload = strrchr(argv[i], '/') ? strrchr(argv[i], '/') + 1 : argv[i];
+        pid_t mock = mock_start(argv[1], argv[2], argv[i]);
+        if (mock < 0) {
+            printf("FAIL: mock upstream did not start for %s\n", argv[i]);
+            return 1;
+        }
+        bench_stream(payload);
+        bench_old(payload, "buffered, 8 KB", BENCH_OLD_FORECAST_BUF, false);
+        bench_old(payload, "buffered, 32 KB", 4 * BENCH_OLD_FORECAST_BUF, true);
+        // 连接池中指向该服务器的长连接在服务器退出后失效，下一个响应换新端口
+        mock_stop(mock);
+    }
+
+    if (s_failed_checks != 0) {
+        printf("%d check(s) failed\n", s_failed_checks);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
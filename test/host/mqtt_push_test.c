@@ -0,0 +1,809 @@
+/**
+ * @file mqtt_push_test.c
+ * @brief MQTT 推送与 EEZ Flow 钩子：固件的 mqtt_push.c 对接 tools/mock_broker.py
+ *
+ * esp-mqtt 为 stubs/host_mqtt_client.c（每个客户端一个线程，保活与重连等待使用模拟时钟），
+ * 界面变量为真实的 vars.c。测试线程同时扮演 LVGL 任务与发布消息的一方（另一个客户端），检查：
+ * - 推送路径：变量消息写入界面变量并回显到 ack 主题，测量发布到回显的延迟；整数变量、
+ *   被拆成多个 DATA 事件的长消息、超长与未知的消息、refresh 命令；
+ * - 离线补发：broker 断开设备后发布的 QoS 1 消息在重连（持久会话）后按顺序送达，遗嘱消息
+ *   先报告 offline，重连后 online；
+ * - 唤醒次数：模拟的一小时空闲期间设备只发送保活报文，与按天气刷新间隔的 HTTP 轮询对比；
+ * - EEZ Flow 钩子：流程连接的事件经队列在 LVGL 定时器中交给流程，测量延迟；流程发布；
+ *   释放连接时丢弃它已排队的事件而保留其他连接的事件；释放后的客户端 ID 序号被复用，
+ *   持久会话保留了订阅；主动断开时同步报告 END；全部释放后没有内存泄漏。
+ *
+ * 用法：mqtt_push_test <python3> <tools/mock_broker.py>
+ */
+
+#define _GNU_SOURCE
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "esp_heap_caps.h"
+#include "esp_http_client.h"
+#include "esp_mac.h"
+#include "esp_timer.h"
+#include "lvgl.h"
+#include "lvgl_init.h"
+#include "mqtt_client.h"
+
+#include "config_manager.h"
+#include "mqtt_push.h"
+#include "net_sched.h"
+#include "radio.h"
+#include "vars.h"
+
+/*
+ * eez-flow.h 中 mqtt.h 部分的声明只对 C++ 可见，这里按 mqtt_push.c 中的签名声明。
+ * 事件类型取值：CONNECT 0，END 5，MESSAGE 7。
+ */
+int eez_mqtt_init(const char *protocol, const char *host, int port, const char *username,
+                  const char *password, void **handle);
+int eez_mqtt_deinit(void *handle);
+int eez_mqtt_connect(void *handle);
+int eez_mqtt_disconnect(void *handle);
+int eez_mqtt_subscribe(void *handle, const char *topic);
+int eez_mqtt_unsubscribe(void *handle, const char *topic);
+int eez_mqtt_publish(void *handle, const char *topic, const char *payload);
+
+/** @brief 设备的主题前缀 */
+#define TEST_PREFIX "test"
+/** @brief 设备的客户端 ID（esp_read_mac 桩返回的 MAC 后三字节） */
+#define DEVICE_ID "espaperplay-123456"
+/** @brief 推送延迟测量的消息数 */
+#define PUSH_COUNT 20
+/** @brief 推送与流程事件的延迟上限（毫秒），本机回环上远低于此值 */
+#define PUSH_LATENCY_MAX_MS 250
+/** @brief mqtt_push.c 中流程事件队列的处理间隔 EEZ_MQTT_POLL_MS */
+#define FLOW_POLL_MS 50
+/** @brief mqtt_push.c 中断开后的重连间隔 MQTT_RECONNECT_MS */
+#define RECONNECT_MS (10 * 1000)
+/** @brief 对比的 HTTP 轮询间隔：actions.c 中天气的刷新间隔 WEATHER_INTERVAL_MS */
+#define POLL_INTERVAL_S (10 * 60)
+/** @brief 模拟的空闲时长 */
+#define IDLE_SECONDS 3600
+
+/**
+ * @brief 测试线程代为运行的 LVGL 定时器
+ */
+struct host_lv_timer {
+    lv_timer_cb_t cb;
+    uint32_t period;
+    int64_t last_run_us;
+    int runs;      ///< 调用次数
+    int busy_runs; ///< 其中交给流程事件的次数
+};
+
+/**
+ * @brief 流程收到的事件
+ */
+typedef struct {
+    void *handle;
+    int event;
+    char topic[64];
+    char payload[64];
+    int64_t at_us;
+} flow_event_t;
+
+/**
+ * @brief 发布方收到的消息
+ */
+typedef struct {
+    char topic[64];
+    char *payload;
+    int64_t at_us;
+    bool consumed;
+} bench_msg_t;
+
+static char s_control_url[64]; ///< broker 控制接口
+static int s_broker_port;
+static int s_failed_checks;
+static _Atomic int64_t s_clock_skew_us;
+
+static SemaphoreHandle_t s_lvgl_mutex;
+static struct host_lv_timer s_timer;
+static flow_event_t s_flow_events[64];
+static int s_num_flow_events;
+static char s_triggered[32];
+static pthread_mutex_t s_triggered_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static esp_mqtt_client_handle_t s_bench;
+static pthread_mutex_t s_bench_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_bench_cond = PTHREAD_COND_INITIALIZER;
+static bench_msg_t s_bench_msgs[128];
+static int s_num_bench_msgs;
+static int s_bench_subscribed;
+
+// ============================================================================
+// 桩
+// ============================================================================
+
+/**
+ * @brief 单调时钟加上测试拨快的时间，保活与重连等待不必真的等待
+ */
+int64_t esp_timer_get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 + atomic_load(&s_clock_skew_us);
+}
+
+/**
+ * @brief 真实时间，用于测量延迟
+ */
+static int64_t now_us(void) { return esp_timer_get_time() - atomic_load(&s_clock_skew_us); }
+
+esp_err_t esp_read_mac(uint8_t *mac, esp_mac_type_t type) {
+    static const uint8_t sta[6] = {0x24, 0x6f, 0x28, 0x12, 0x34, 0x56};
+    memcpy(mac, sta, sizeof(sta));
+    return ESP_OK;
+}
+
+void config_manager_get_config(sys_config_t *config) {
+    memset(config, 0, sizeof(sys_config_t));
+    snprintf(config->mqtt.uri, sizeof(config->mqtt.uri), "mqtt://127.0.0.1:%d", s_broker_port);
+    snprintf(config->mqtt.topic_prefix, sizeof(config->mqtt.topic_prefix), TEST_PREFIX);
+}
+
+radio_mode_t radio_get_mode(void) { return RADIO_MODE_ALWAYS_ON; }
+
+const char *radio_mode_name(radio_mode_t mode) {
+    return (mode == RADIO_MODE_WINDOWED) ? "windowed" : "always_on";
+}
+
+esp_err_t net_sched_trigger_by_name(const char *name) {
+    if (strcmp(name, "weather") != 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    pthread_mutex_lock(&s_triggered_lock);
+    snprintf(s_triggered, sizeof(s_triggered), "%s", name);
+    pthread_mutex_unlock(&s_triggered_lock);
+    return ESP_OK;
+}
+
+SemaphoreHandle_t lvgl_get_mutex(void) { return s_lvgl_mutex; }
+
+lv_timer_t *lv_timer_create(lv_timer_cb_t cb, uint32_t period, void *user_data) {
+    s_timer.cb = cb;
+    s_timer.period = period;
+    s_timer.last_run_us = now_us();
+    return &s_timer;
+}
+
+void eez_mqtt_on_event_callback(void *handle, int event, void *eventData) {
+    if (s_num_flow_events == (int)(sizeof(s_flow_events) / sizeof(s_flow_events[0]))) {
+        return;
+    }
+    flow_event_t *rec = &s_flow_events[s_num_flow_events++];
+    memset(rec, 0, sizeof(flow_event_t));
+    rec->handle = handle;
+    rec->event = event;
+    rec->at_us = now_us();
+    if (event == 7 && eventData != NULL) {
+        // EEZ_MQTT_EVENT_MESSAGE：EEZ_MQTT_MessageEvent { topic, payload }
+        const char *const *message = eventData;
+        snprintf(rec->topic, sizeof(rec->topic), "%s", message[0]);
+        snprintf(rec->payload, sizeof(rec->payload), "%s", message[1]);
+    }
+}
+
+/**
+ * @brief 运行到期的 LVGL 定时器（调用者持有 LVGL 互斥锁）
+ */
+static void lvgl_run_timers(bool force) {
+    int64_t now = now_us();
+    if (s_timer.cb == NULL || (!force && now - s_timer.last_run_us < s_timer.period * 1000LL)) {
+        return;
+    }
+    int before = s_num_flow_events;
+    s_timer.last_run_us = now;
+    s_timer.cb(&s_timer);
+    s_timer.runs++;
+    if (s_num_flow_events != before) {
+        s_timer.busy_runs++;
+    }
+}
+
+/**
+ * @brief 查找流程事件（从 from 开始），找不到返回 -1
+ */
+static int find_flow_event(int from, void *handle, int event, const char *payload) {
+    for (int i = from; i < s_num_flow_events; i++) {
+        const flow_event_t *rec = &s_flow_events[i];
+        if (rec->handle == handle && rec->event == event &&
+            (payload == NULL || strcmp(rec->payload, payload) == 0)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 运行 LVGL 定时器直到出现指定的流程事件
+ */
+static int lvgl_wait_flow_event(int from, void *handle, int event, const char *payload,
+                                int timeout_ms) {
+    int64_t deadline = now_us() + timeout_ms * 1000LL;
+    int index;
+    while ((index = find_flow_event(from, handle, event, payload)) < 0 && now_us() < deadline) {
+        lvgl_run_timers(false);
+        usleep(1000);
+    }
+    return index;
+}
+
+// ============================================================================
+// 模拟服务器
+// ============================================================================
+
+static int free_port(void) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    socklen_t len = sizeof(addr);
+    if (bind(fd, (struct sockaddr *)&addr, len) != 0 ||
+        getsockname(fd, (struct sockaddr *)&addr, &len) != 0) {
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    return ntohs(addr.sin_port);
+}
+
+/**
+ * @brief 响应体
+ */
+typedef struct {
+    char text[4096];
+    size_t len;
+} body_t;
+
+static esp_err_t body_handler(esp_http_client_event_t *evt) {
+    body_t *body = evt->user_data;
+    if (evt->event_id == HTTP_EVENT_ON_DATA && body != NULL) {
+        size_t n = (size_t)evt->data_len;
+        if (n > sizeof(body->text) - 1 - body->len) {
+            n = sizeof(body->text) - 1 - body->len;
+        }
+        memcpy(body->text + body->len, evt->data, n);
+        body->len += n;
+        body->text[body->len] = '\0';
+    }
+    return ESP_OK;
+}
+
+static bool broker_get(const char *path, body_t *body) {
+    char url[160];
+    snprintf(url, sizeof(url), "%s%s", s_control_url, path);
+    esp_http_client_config_t config = {
+        .url = url, .event_handler = body_handler, .user_data = body};
+    esp_http_client_handle_t client = esp_http_client_init(&config);
+    if (client == NULL) {
+        return false;
+    }
+    esp_err_t err = esp_http_client_perform(client);
+    int status = esp_http_client_get_status_code(client);
+    esp_http_client_cleanup(client);
+    return err == ESP_OK && status == 200;
+}
+
+/**
+ * @brief broker 对某个客户端的统计项（报文计数或 online），读取失败返回 -1
+ */
+static int broker_stat(const char *client_id, const char *key) {
+    body_t body = {0};
+    if (!broker_get("/_mock/stats", &body)) {
+        return -1;
+    }
+    char pattern[96];
+    snprintf(pattern, sizeof(pattern), "\"%s\":{", client_id);
+    const char *obj = strstr(body.text, pattern);
+    if (obj == NULL) {
+        return 0;
+    }
+    const char *end = strchr(obj, '}');
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *value = strstr(obj, pattern);
+    if (value == NULL || value > end) {
+        return 0;
+    }
+    value += strlen(pattern);
+    return (strncmp(value, "true", 4) == 0) ? 1 : atoi(value);
+}
+
+/**
+ * @brief 等待 broker 的统计项达到指定值
+ */
+static bool broker_wait(const char *client_id, const char *key, int at_least, int timeout_ms) {
+    int64_t deadline = now_us() + timeout_ms * 1000LL;
+    while (broker_stat(client_id, key) < at_least) {
+        if (now_us() > deadline) {
+            return false;
+        }
+        usleep(5 * 1000);
+    }
+    return true;
+}
+
+static pid_t broker_start(const char *python, const char *script) {
+    int http_port = free_port();
+    s_broker_port = free_port();
+    if (s_broker_port < 0 || http_port < 0 || s_broker_port == http_port) {
+        return -1;
+    }
+    snprintf(s_control_url, sizeof(s_control_url), "http://127.0.0.1:%d", http_port);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        char port_arg[16];
+        char http_port_arg[16];
+        snprintf(port_arg, sizeof(port_arg), "%d", s_broker_port);
+        snprintf(http_port_arg, sizeof(http_port_arg), "%d", http_port);
+        freopen("/dev/null", "w", stdout);
+        execlp(python, python, script, "--host", "127.0.0.1", "--port", port_arg, "--http-port",
+               http_port_arg, (char *)NULL);
+        _exit(127);
+    }
+
+    // 等待控制接口开始监听（MQTT 端口在它之后不久监听，客户端连接失败时会重试）
+    body_t body = {0};
+    for (int i = 0; i < 100; i++) {
+        if (broker_get("/_mock/stats", &body)) {
+            usleep(100 * 1000);
+            return pid;
+        }
+        usleep(100 * 1000);
+    }
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+    return -1;
+}
+
+/**
+ * @brief 发布方的事件处理（客户端线程中执行）：记录收到的完整消息
+ */
+static void bench_handler(void *arg, esp_event_base_t base, int32_t event_id, void *event_data) {
+    esp_mqtt_event_handle_t event = event_data;
+    static char topic[64];
+    static char *payload;
+
+    pthread_mutex_lock(&s_bench_lock);
+    if (event_id == MQTT_EVENT_SUBSCRIBED) {
+        s_bench_subscribed++;
+    } else if (event_id == MQTT_EVENT_DATA) {
+        if (event->current_data_offset == 0) {
+            snprintf(topic, sizeof(topic), "%.*s", event->topic_len, event->topic);
+            payload = calloc(1, (size_t)event->total_data_len + 1);
+        }
+        if (payload != NULL) {
+            memcpy(payload + event->current_data_offset, event->data, event->data_len);
+        }
+        bool complete = event->current_data_offset + event->data_len >= event->total_data_len;
+        if (complete && payload != NULL &&
+            s_num_bench_msgs < (int)(sizeof(s_bench_msgs) / sizeof(s_bench_msgs[0]))) {
+            bench_msg_t *msg = &s_bench_msgs[s_num_bench_msgs++];
+            snprintf(msg->topic, sizeof(msg->topic), "%s", topic);
+            msg->payload = payload;
+            msg->at_us = now_us();
+            payload = NULL;
+        } else if (complete) {
+            free(payload);
+            payload = NULL;
+        }
+    }
+    pthread_cond_broadcast(&s_bench_cond);
+    pthread_mutex_unlock(&s_bench_lock);
+}
+
+/**
+ * @brief 等待发布方收到指定的消息，返回其序号（收到的顺序），超时返回 -1
+ */
+static int bench_wait(const char *topic, const char *payload, int timeout_ms, int64_t *at_us) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&s_bench_lock);
+    int found = -1;
+    while (found < 0) {
+        for (int i = 0; i < s_num_bench_msgs && found < 0; i++) {
+            bench_msg_t *msg = &s_bench_msgs[i];
+            if (!msg->consumed && strcmp(msg->topic, topic) == 0 &&
+                strcmp(msg->payload, payload) == 0) {
+                msg->consumed = true;
+                found = i;
+                if (at_us != NULL) {
+                    *at_us = msg->at_us;
+                }
+            }
+        }
+        if (found < 0 && pthread_cond_timedwait(&s_bench_cond, &s_bench_lock, &deadline) != 0) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_bench_lock);
+    return found;
+}
+
+static bool bench_start(void) {
+    char uri[64];
+    snprintf(uri, sizeof(uri), "mqtt://127.0.0.1:%d", s_broker_port);
+    esp_mqtt_client_config_t config = {
+        .broker.address.uri = uri,
+        .credentials.client_id = "bench",
+        .buffer.size = 4096,
+    };
+    s_bench = esp_mqtt_client_init(&config);
+    if (s_bench == NULL) {
+        return false;
+    }
+    esp_mqtt_client_register_event(s_bench, ESP_EVENT_ANY_ID, bench_handler, NULL);
+    if (esp_mqtt_client_start(s_bench) != ESP_OK) {
+        return false;
+    }
+
+    // 连接后订阅：设备的回显与状态，流程发布的主题
+    static const char *const topics[] = {TEST_PREFIX "/ack/+", TEST_PREFIX "/status", "flow/out"};
+    int64_t deadline = now_us() + 2000 * 1000LL;
+    size_t next = 0;
+    while (next < sizeof(topics) / sizeof(topics[0]) && now_us() < deadline) {
+        if (esp_mqtt_client_subscribe(s_bench, topics[next], 1) >= 0) {
+            next++;
+        } else {
+            usleep(5 * 1000);
+        }
+    }
+    while (now_us() < deadline) {
+        pthread_mutex_lock(&s_bench_lock);
+        bool done = s_bench_subscribed == (int)(sizeof(topics) / sizeof(topics[0]));
+        pthread_mutex_unlock(&s_bench_lock);
+        if (done) {
+            return true;
+        }
+        usleep(5 * 1000);
+    }
+    return false;
+}
+
+static void bench_publish(const char *topic, const char *payload) {
+    esp_mqtt_client_publish(s_bench, topic, payload, 0, 1, 0);
+}
+
+// ============================================================================
+// 检查
+// ============================================================================
+
+#define EXPECT(cond, ...)                                                                          \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s:%d: ", __func__, __LINE__);                                            \
+            printf(__VA_ARGS__);                                                                   \
+            printf("\n");                                                                          \
+            s_failed_checks++;                                                                     \
+        }                                                                                          \
+    } while (0)
+
+static int compare_i64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 等待推送统计满足条件
+ */
+static bool wait_push_stats(mqtt_push_stats_t *stats, bool (*done)(const mqtt_push_stats_t *),
+                            int timeout_ms) {
+    int64_t deadline = now_us() + timeout_ms * 1000LL;
+    for (;;) {
+        mqtt_push_get_stats(stats);
+        if (done(stats)) {
+            return true;
+        }
+        if (now_us() > deadline) {
+            return false;
+        }
+        usleep(5 * 1000);
+    }
+}
+
+static bool push_connected(const mqtt_push_stats_t *stats) { return stats->connected; }
+
+static bool push_offline(const mqtt_push_stats_t *stats) { return !stats->connected; }
+
+static bool push_command_done(const mqtt_push_stats_t *stats) { return stats->commands > 0; }
+
+static int64_t s_push_median_us; ///< 推送路径的延迟中位数，供唤醒次数对比
+
+static void check_push_path(void) {
+    mqtt_push_stats_t stats;
+    EXPECT(mqtt_push_start() == ESP_OK, "mqtt_push_start");
+    EXPECT(wait_push_stats(&stats, push_connected, 3000), "device did not connect");
+    EXPECT(broker_wait(DEVICE_ID, "SUBSCRIBE", 2, 2000), "device did not subscribe");
+    EXPECT(bench_start(), "bench client did not start");
+    EXPECT(bench_wait(TEST_PREFIX "/status", "online", 2000, NULL) >= 0, "no retained online");
+
+    int64_t latency_us[PUSH_COUNT];
+    int acked = 0;
+    char payload[32];
+    for (int i = 0; i < PUSH_COUNT; i++) {
+        snprintf(payload, sizeof(payload), "push-%02d", i);
+        int64_t sent_us = now_us();
+        int64_t ack_us = 0;
+        bench_publish(TEST_PREFIX "/var/yiyan", payload);
+        if (bench_wait(TEST_PREFIX "/ack/yiyan", payload, 2000, &ack_us) >= 0) {
+            latency_us[acked++] = ack_us - sent_us;
+        }
+    }
+    EXPECT(acked == PUSH_COUNT, "%d of %d pushes acknowledged", acked, PUSH_COUNT);
+    if (acked > 0) {
+        qsort(latency_us, acked, sizeof(int64_t), compare_i64);
+        s_push_median_us = latency_us[acked / 2];
+        printf("push: %d updates, latency median %lld us, max %lld us\n", acked,
+               (long long)s_push_median_us, (long long)latency_us[acked - 1]);
+        EXPECT(latency_us[acked - 1] < PUSH_LATENCY_MAX_MS * 1000LL, "max latency %lld us",
+               (long long)latency_us[acked - 1]);
+    }
+
+    vars_snapshot_t snap;
+    EXPECT(vars_read(&snap) && strcmp(snap.yiyan, payload) == 0, "yiyan '%s', expected '%s'",
+           snap.yiyan, payload);
+
+    bench_publish(TEST_PREFIX "/var/weather_humidity", "63");
+    EXPECT(bench_wait(TEST_PREFIX "/ack/weather_humidity", "63", 2000, NULL) >= 0, "no int ack");
+    EXPECT(vars_read(&snap) && snap.weather_humidity == 63, "humidity %d",
+           (int)snap.weather_humidity);
+
+    // 长消息被客户端拆成多个 DATA 事件，拼接后完整回显，变量按容量截断
+    char *long_text = malloc(MQTT_PUSH_PAYLOAD_MAX);
+    memset(long_text, 'x', MQTT_PUSH_PAYLOAD_MAX - 1);
+    long_text[MQTT_PUSH_PAYLOAD_MAX - 1] = '\0';
+    bench_publish(TEST_PREFIX "/var/weather_text", long_text);
+    EXPECT(bench_wait(TEST_PREFIX "/ack/weather_text", long_text, 2000, NULL) >= 0,
+           "fragmented message not reassembled");
+    EXPECT(vars_read(&snap) && strlen(snap.weather_text) == VARS_STR_MAX - 1,
+           "weather_text length %zu", strlen(snap.weather_text));
+    free(long_text);
+
+    char *oversized = malloc(MQTT_PUSH_PAYLOAD_MAX + 100);
+    memset(oversized, 'y', MQTT_PUSH_PAYLOAD_MAX + 99);
+    oversized[MQTT_PUSH_PAYLOAD_MAX + 99] = '\0';
+    bench_publish(TEST_PREFIX "/var/yiyan", oversized);
+    free(oversized);
+    bench_publish(TEST_PREFIX "/var/no_such_var", "1");
+    bench_publish(TEST_PREFIX "/cmd/refresh", "weather");
+    EXPECT(wait_push_stats(&stats, push_command_done, 2000), "refresh command not executed");
+
+    pthread_mutex_lock(&s_triggered_lock);
+    EXPECT(strcmp(s_triggered, "weather") == 0, "triggered '%s'", s_triggered);
+    pthread_mutex_unlock(&s_triggered_lock);
+    EXPECT(stats.vars == PUSH_COUNT + 2 && stats.commands == 1 && stats.dropped == 2 &&
+               stats.messages == PUSH_COUNT + 5,
+           "stats: %u messages, %u vars, %u commands, %u dropped", stats.messages, stats.vars,
+           stats.commands, stats.dropped);
+    EXPECT(vars_read(&snap) && strcmp(snap.yiyan, payload) == 0, "oversized message applied");
+}
+
+/**
+ * @brief broker 断开设备，离线期间的 QoS 1 消息在重连后补发
+ */
+static void check_offline_queue(void) {
+    mqtt_push_stats_t stats;
+    body_t body = {0};
+    EXPECT(broker_get("/_mock/kick?client=" DEVICE_ID, &body), "kick");
+    EXPECT(wait_push_stats(&stats, push_offline, 2000), "device did not notice the disconnect");
+    EXPECT(bench_wait(TEST_PREFIX "/status", "offline", 2000, NULL) >= 0, "no last will");
+
+    char payload[32];
+    for (int i = 0; i < 3; i++) {
+        snprintf(payload, sizeof(payload), "offline-%d", i);
+        bench_publish(TEST_PREFIX "/var/yiyan", payload);
+    }
+    usleep(100 * 1000);
+    EXPECT(broker_stat(DEVICE_ID, "online") == 0, "device reconnected before the retry delay");
+
+    atomic_fetch_add(&s_clock_skew_us, (RECONNECT_MS + 1000) * 1000LL);
+    EXPECT(wait_push_stats(&stats, push_connected, 3000), "device did not reconnect");
+
+    int last = -1;
+    for (int i = 0; i < 3; i++) {
+        snprintf(payload, sizeof(payload), "offline-%d", i);
+        int seq = bench_wait(TEST_PREFIX "/ack/yiyan", payload, 2000, NULL);
+        EXPECT(seq > last, "%s: received as #%d after #%d", payload, seq, last);
+        last = seq;
+    }
+    EXPECT(bench_wait(TEST_PREFIX "/status", "online", 2000, NULL) >= 0,
+           "no online after reconnect");
+
+    mqtt_push_get_stats(&stats);
+    EXPECT(stats.connects == 2 && stats.disconnects == 1 && stats.session_present,
+           "%u connects, %u disconnects, session present %d", stats.connects, stats.disconnects,
+           stats.session_present);
+}
+
+/**
+ * @brief 模拟一小时空闲：设备只发送保活报文
+ */
+static void check_idle_wakeups(void) {
+    int pings = broker_stat(DEVICE_ID, "PINGREQ");
+    int packets = broker_stat(DEVICE_ID, "packets");
+    int steps = IDLE_SECONDS / MQTT_PUSH_KEEPALIVE_S;
+    for (int i = 1; i <= steps; i++) {
+        atomic_fetch_add(&s_clock_skew_us, MQTT_PUSH_KEEPALIVE_S * 1000000LL);
+        if (!broker_wait(DEVICE_ID, "PINGREQ", pings + i, 2000)) {
+            EXPECT(false, "no keepalive after %d s idle", i * MQTT_PUSH_KEEPALIVE_S);
+            break;
+        }
+    }
+    usleep(50 * 1000);
+    int ping_delta = broker_stat(DEVICE_ID, "PINGREQ") - pings;
+    int packet_delta = broker_stat(DEVICE_ID, "packets") - packets;
+    EXPECT(ping_delta == steps && packet_delta == ping_delta,
+           "idle: %d keepalives, %d packets, expected %d / %d", ping_delta, packet_delta, steps,
+           steps);
+
+    printf("idle %d s: push %d wake-up(s) (keepalive %d s), latency %lld us per update; "
+           "polling every %d s: %d request(s), mean staleness %d s\n",
+           IDLE_SECONDS, packet_delta, MQTT_PUSH_KEEPALIVE_S, (long long)s_push_median_us,
+           POLL_INTERVAL_S, IDLE_SECONDS / POLL_INTERVAL_S, POLL_INTERVAL_S / 2);
+}
+
+/**
+ * @brief 流程连接的事件经队列在 LVGL 定时器中交给流程（测试线程持有 LVGL 互斥锁）
+ */
+static void check_flow_hooks(void) {
+    enum { CONNECT = 0, END = 5, MESSAGE = 7 };
+    const char *flow0 = DEVICE_ID "-flow0";
+    const char *flow1 = DEVICE_ID "-flow1";
+    size_t heap_before = host_heap_in_use();
+    xSemaphoreTake(s_lvgl_mutex, portMAX_DELAY);
+
+    void *h1 = NULL;
+    EXPECT(eez_mqtt_init("tcp", "127.0.0.1", s_broker_port, "", "", &h1) == 0 && h1 != NULL,
+           "init");
+    EXPECT(s_timer.cb != NULL && s_timer.period == FLOW_POLL_MS, "queue timer");
+    EXPECT(eez_mqtt_connect(h1) == 0, "connect");
+    EXPECT(lvgl_wait_flow_event(0, h1, CONNECT, NULL, 2000) >= 0, "no CONNECT event");
+    EXPECT(eez_mqtt_subscribe(h1, "flow/a") == 0, "subscribe");
+    EXPECT(broker_wait(flow0, "SUBSCRIBE", 1, 2000), "subscription not received");
+
+    // 流程事件的延迟：网络延迟加上至多一个定时器周期
+    int64_t latency_us[10];
+    int received = 0;
+    int runs_before = s_timer.runs;
+    int busy_before = s_timer.busy_runs;
+    char payload[32];
+    for (int i = 0; i < 10; i++) {
+        snprintf(payload, sizeof(payload), "flow-%d", i);
+        int from = s_num_flow_events;
+        int64_t sent_us = now_us();
+        bench_publish("flow/a", payload);
+        int index = lvgl_wait_flow_event(from, h1, MESSAGE, payload, 2000);
+        if (index >= 0) {
+            EXPECT(strcmp(s_flow_events[index].topic, "flow/a") == 0, "topic '%s'",
+                   s_flow_events[index].topic);
+            latency_us[received++] = s_flow_events[index].at_us - sent_us;
+        }
+    }
+    EXPECT(received == 10, "%d of 10 flow messages", received);
+    if (received > 0) {
+        qsort(latency_us, received, sizeof(int64_t), compare_i64);
+        printf("flow: latency median %lld us, max %lld us; queue timer ran %d time(s), "
+               "%d with events\n",
+               (long long)latency_us[received / 2], (long long)latency_us[received - 1],
+               s_timer.runs - runs_before, s_timer.busy_runs - busy_before);
+        EXPECT(latency_us[received - 1] < (FLOW_POLL_MS + PUSH_LATENCY_MAX_MS) * 1000LL,
+               "max flow latency %lld us", (long long)latency_us[received - 1]);
+    }
+
+    EXPECT(eez_mqtt_publish(h1, "flow/out", "from-flow") == 0, "publish");
+    EXPECT(bench_wait("flow/out", "from-flow", 2000, NULL) >= 0, "flow publish not received");
+
+    // 两个连接都有事件排队时释放其中一个：只丢弃它的事件，另一个连接的事件按顺序保留
+    void *h2 = NULL;
+    EXPECT(eez_mqtt_init("tcp", "127.0.0.1", s_broker_port, "", "", &h2) == 0 && h2 != NULL,
+           "init second");
+    EXPECT(eez_mqtt_connect(h2) == 0, "connect second");
+    EXPECT(lvgl_wait_flow_event(0, h2, CONNECT, NULL, 2000) >= 0, "no CONNECT event");
+    EXPECT(eez_mqtt_subscribe(h2, "flow/b") == 0, "subscribe second");
+    EXPECT(broker_wait(flow1, "SUBSCRIBE", 1, 2000), "second subscription not received");
+
+    int acks_a = broker_stat(flow0, "PUBACK");
+    int acks_b = broker_stat(flow1, "PUBACK");
+    for (int i = 0; i < 3; i++) {
+        snprintf(payload, sizeof(payload), "a-%d", i);
+        bench_publish("flow/a", payload);
+        snprintf(payload, sizeof(payload), "b-%d", i);
+        bench_publish("flow/b", payload);
+    }
+    // 客户端在事件处理函数返回后确认，确认之后事件已在队列中
+    EXPECT(broker_wait(flow0, "PUBACK", acks_a + 3, 2000) &&
+               broker_wait(flow1, "PUBACK", acks_b + 3, 2000),
+           "messages not queued");
+
+    int from = s_num_flow_events;
+    EXPECT(eez_mqtt_deinit(h1) == 0, "deinit");
+    lvgl_run_timers(true);
+    EXPECT(s_num_flow_events - from == 3, "%d event(s) after deinit, expected 3",
+           s_num_flow_events - from);
+    for (int i = 0; i < 3 && from + i < s_num_flow_events; i++) {
+        const flow_event_t *rec = &s_flow_events[from + i];
+        snprintf(payload, sizeof(payload), "b-%d", i);
+        EXPECT(rec->handle == h2 && rec->event == MESSAGE && strcmp(rec->payload, payload) == 0,
+               "event %d: %s '%s', expected second connection '%s'", i,
+               rec->handle == h2 ? "second" : "other", rec->payload, payload);
+    }
+
+    // 释放的序号被复用：同一客户端 ID 恢复持久会话，不必重新订阅
+    void *h3 = NULL;
+    EXPECT(eez_mqtt_init("tcp", "127.0.0.1", s_broker_port, "", "", &h3) == 0 && h3 != NULL,
+           "init third");
+    EXPECT(eez_mqtt_connect(h3) == 0, "connect third");
+    EXPECT(lvgl_wait_flow_event(0, h3, CONNECT, NULL, 2000) >= 0, "no CONNECT event");
+    EXPECT(broker_stat(flow0, "CONNECT") == 2, "client ID not reused");
+    from = s_num_flow_events;
+    bench_publish("flow/a", "resumed");
+    EXPECT(lvgl_wait_flow_event(from, h3, MESSAGE, "resumed", 2000) >= 0,
+           "persistent session lost the subscription");
+
+    from = s_num_flow_events;
+    EXPECT(eez_mqtt_disconnect(h3) == 0, "disconnect");
+    EXPECT(find_flow_event(from, h3, END, NULL) == from, "no END event");
+
+    EXPECT(eez_mqtt_deinit(h2) == 0 && eez_mqtt_deinit(h3) == 0, "deinit rest");
+    lvgl_run_timers(true);
+    xSemaphoreGive(s_lvgl_mutex);
+
+    EXPECT(host_heap_in_use() == heap_before, "%zu byte(s) leaked",
+           host_heap_in_use() - heap_before);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <python3> <mock_broker.py>\n", argv[0]);
+        return 2;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    s_lvgl_mutex = xSemaphoreCreateMutex();
+    if (s_lvgl_mutex == NULL || vars_init() != ESP_OK) {
+        printf("FAIL: init\n");
+        return 1;
+    }
+    pid_t broker = broker_start(argv[1], argv[2]);
+    if (broker < 0) {
+        printf("FAIL: mock broker did not start\n");
+        return 1;
+    }
+
+    check_push_path();
+    check_offline_queue();
+    check_idle_wakeups();
+    check_flow_hooks();
+
+    esp_mqtt_client_destroy(s_bench);
+    kill(broker, SIGTERM);
+    waitpid(broker, NULL, 0);
+
+    if (s_failed_checks != 0) {
+        printf("%d check(s) failed\n", s_failed_checks);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,345 @@
+/**
+ * @file net_sched_sim.c
+ * @brief 网络任务调度器的模拟时钟测试
+ *
+ * 直接包含 net_sched.c，用模拟时钟驱动工作任务：任务函数与 ulTaskNotifyTake() 推进时钟，
+ * 时钟超过模拟时长时 longjmp 退出工作循环。检查：
+ * - 同一轮中按优先级执行；
+ * - 除重试外，任务最多提前 NET_SCHED_COALESCE_MS 执行，且每一轮中至少有一个任务已到期；
+ * - 失败的任务按 retry_delay_ms 翻倍退避，重试不提前，次数耗尽后计入 failures；
+ * - 执行期间触发的任务在本次完成后立即再执行一次；
+ * - 有联网任务的一轮只申请一次射频，只有离线任务的一轮不申请，轮与轮之间射频全部释放；
+ * - 统计与执行记录一致。
+ */
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../main/src/network/net_sched.c"
+
+/** @brief 模拟时长 */
+#define SIM_END_US (6LL * 3600 * 1000000)
+/** @brief 最多记录的执行次数 */
+#define SIM_MAX_RUNS 1024
+
+/**
+ * @brief 一次任务执行记录
+ */
+typedef struct {
+    const char *name; ///< 任务名
+    bool offline;     ///< 是否为离线任务
+    int64_t start_us; ///< 开始时间
+    int64_t due_us;   ///< 开始时的截止时间
+    uint8_t retries;  ///< 开始时的连续重试次数
+    int burst;        ///< 所在的轮次
+} sim_run_t;
+
+static int64_t s_now;
+static jmp_buf s_end;
+static sim_run_t s_runs[SIM_MAX_RUNS];
+static int s_num_runs;
+static int s_radio_refs;
+static int s_acquires;
+static uint8_t s_burst_acquires[SIM_MAX_RUNS];
+static int s_failed_checks;
+
+static int s_weather_failures = 3;
+static bool s_yiyan_retrigger = true;
+
+static esp_err_t radio_off_job(void *arg);
+
+// ============================================================================
+// 桩
+// ============================================================================
+
+int64_t esp_timer_get_time(void) { return s_now; }
+
+uint32_t esp_random(void) { return (uint32_t)rand(); }
+
+void time_wait_ready(void) {}
+
+esp_err_t radio_acquire(const char *who) {
+    (void)who;
+    s_radio_refs++;
+    s_acquires++;
+    if (s_stats.bursts < SIM_MAX_RUNS) {
+        s_burst_acquires[s_stats.bursts]++;
+    }
+    return ESP_OK;
+}
+
+void radio_release(const char *who) {
+    (void)who;
+    if (--s_radio_refs == 0) {
+        // 与 radio.c 相同：停留时间结束后提交关闭射频的离线任务
+        const net_job_config_t off = {.name = "radio_off",
+                                      .fn = radio_off_job,
+                                      .first_delay_ms = 3000,
+                                      .priority = NET_JOB_PRIO_LOW,
+                                      .offline = true};
+        net_sched_add(&off);
+    }
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                       UBaseType_t prio, TaskHandle_t *handle) {
+    (void)fn, (void)name, (void)stack, (void)arg, (void)prio;
+    *handle = xTaskGetCurrentTaskHandle();
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    (void)task;
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+    (void)clear;
+    if (s_radio_refs != 0) {
+        printf("FAIL: radio still held while idle (%d refs)\n", s_radio_refs);
+        s_failed_checks++;
+    }
+    if (ticks == portMAX_DELAY || s_now + (int64_t)ticks * 1000 > SIM_END_US) {
+        longjmp(s_end, 1);
+    }
+    s_now += (int64_t)ticks * 1000;
+    return 0;
+}
+
+// ============================================================================
+// 模拟任务
+// ============================================================================
+
+/**
+ * @brief 记录一次执行并推进时钟
+ */
+static void record(const char *name, int64_t duration_us) {
+    net_job_t *job = NULL;
+    for (int i = 0; i < NET_SCHED_MAX_JOBS; i++) {
+        if (s_jobs[i].in_use && s_jobs[i].running && strcmp(s_jobs[i].name, name) == 0) {
+            job = &s_jobs[i];
+        }
+    }
+    if (job != NULL && s_num_runs < SIM_MAX_RUNS) {
+        s_runs[s_num_runs++] = (sim_run_t){
+            .name = name,
+            .offline = job->config.offline,
+            .start_us = s_now,
+            .due_us = job->due_us,
+            .retries = job->retries,
+            .burst = (int)s_stats.bursts,
+        };
+    }
+    s_now += duration_us;
+}
+
+static esp_err_t yiyan_job(void *arg) {
+    (void)arg;
+    record("yiyan", 800 * 1000);
+    if (s_yiyan_retrigger && s_now > 20 * 60 * 1000000LL) {
+        // 执行期间收到立即执行请求
+        s_yiyan_retrigger = false;
+        net_sched_trigger_by_name("yiyan");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t weather_job(void *arg) {
+    (void)arg;
+    record("weather", 2000 * 1000);
+    if (s_weather_failures > 0) {
+        s_weather_failures--;
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t radio_off_job(void *arg) {
+    (void)arg;
+    record("radio_off", 50 * 1000);
+    return ESP_OK;
+}
+
+static esp_err_t location_job(void *arg) {
+    (void)arg;
+    record("location", 1500 * 1000);
+    return ESP_OK;
+}
+
+static esp_err_t adhoc_job(void *arg) {
+    (void)arg;
+    record("adhoc", 100 * 1000);
+    return ESP_OK;
+}
+
+// ============================================================================
+// 检查
+// ============================================================================
+
+static void expect(bool cond, const char *what, int run) {
+    if (!cond) {
+        const sim_run_t *r = &s_runs[run];
+        printf("FAIL: %s (run %d: %s at %.1f s, due %.1f s)\n", what, run, r->name,
+               r->start_us / 1e6, r->due_us / 1e6);
+        s_failed_checks++;
+    }
+}
+
+/**
+ * @brief 检查一轮执行 s_runs[first, end)
+ *
+ * @return 本轮是否包含联网任务
+ */
+static bool check_burst(int first, int end) {
+    bool has_due = false;
+    bool online = false;
+    for (int i = first; i < end; i++) {
+        has_due |= (s_runs[i].due_us <= s_runs[first].start_us);
+        online |= !s_runs[i].offline;
+    }
+    expect(has_due, "burst without any due job", first);
+    expect(s_burst_acquires[s_runs[first].burst] == (online ? 1 : 0),
+           online ? "burst with network jobs must acquire the radio once"
+                  : "offline-only burst must not acquire the radio",
+           first);
+    return online;
+}
+
+static void check_runs(const net_sched_stats_t *stats) {
+    const int64_t window_us = (int64_t)NET_SCHED_COALESCE_MS * 1000;
+    int coalesced = 0;
+    int retry_runs = 0;
+    int bursts = 0;
+    int online_bursts = 0;
+    int offline_runs = 0;
+    bool retriggered = false;
+
+    expect(s_num_runs > 0 && strcmp(s_runs[0].name, "adhoc") == 0, "high priority runs first", 0);
+
+    int burst_first = 0;
+    for (int i = 0; i < s_num_runs; i++) {
+        const sim_run_t *r = &s_runs[i];
+        bool burst_start = (i == 0 || s_runs[i - 1].burst != r->burst);
+        if (burst_start && i > 0) {
+            online_bursts += check_burst(burst_first, i);
+            burst_first = i;
+        }
+        bursts += burst_start;
+        offline_runs += r->offline;
+
+        if (r->retries > 0) {
+            retry_runs++;
+            expect(r->start_us >= r->due_us, "retry runs before its backoff", i);
+        } else {
+            expect(r->start_us >= r->due_us - window_us, "run earlier than coalesce window", i);
+        }
+        if (r->start_us < r->due_us) {
+            coalesced++;
+        }
+        if (!burst_start) {
+            const sim_run_t *prev = &s_runs[i - 1];
+            if (strcmp(prev->name, r->name) == 0 && r->due_us == prev->start_us + 800 * 1000) {
+                retriggered = true;
+            }
+        }
+    }
+    online_bursts += check_burst(burst_first, s_num_runs);
+
+    if (offline_runs == 0 || online_bursts == bursts) {
+        printf("FAIL: no offline-only burst was simulated\n");
+        s_failed_checks++;
+    }
+
+    // 天气失败 3 次：重试 2 次（30 s、60 s 后），之后等下一个周期
+    int weather_seen = 0;
+    int64_t prev_end = 0;
+    for (int i = 0; i < s_num_runs && weather_seen < 4; i++) {
+        const sim_run_t *r = &s_runs[i];
+        if (strcmp(r->name, "weather") != 0) {
+            continue;
+        }
+        if (weather_seen == 1) {
+            expect(r->due_us == prev_end + 30 * 1000000LL, "first retry after 30 s", i);
+        } else if (weather_seen == 2) {
+            expect(r->due_us == prev_end + 60 * 1000000LL, "second retry after 60 s", i);
+        } else if (weather_seen == 3) {
+            expect(r->retries == 0 && r->due_us >= prev_end + 600 * 1000000LL,
+                   "gives up until next period", i);
+        }
+        prev_end = r->start_us + 2000 * 1000;
+        weather_seen++;
+    }
+
+    if (!retriggered) {
+        printf("FAIL: job triggered while running did not run again\n");
+        s_failed_checks++;
+    }
+    if ((int)stats->jobs_run != s_num_runs || (int)stats->bursts != bursts ||
+        s_acquires != online_bursts ||
+        (int)stats->coalesced != coalesced || (int)stats->retries != retry_runs ||
+        stats->failures != 1) {
+        printf("FAIL: stats do not match the run log (jobs %u/%d, bursts %u/%d, coalesced "
+               "%u/%d, retries %u/%d, failures %u, radio %d/%d)\n",
+               stats->jobs_run, s_num_runs, stats->bursts, bursts, stats->coalesced,
+               coalesced, stats->retries, retry_runs, stats->failures, s_acquires,
+               online_bursts);
+        s_failed_checks++;
+    }
+}
+
+int main(void) {
+    srand(1);
+    net_sched_init();
+
+    const net_job_config_t yiyan = {.name = "yiyan",
+                                    .fn = yiyan_job,
+                                    .period_ms = 180000,
+                                    .jitter_ms = 15000,
+                                    .priority = NET_JOB_PRIO_LOW,
+                                    .max_retries = 2,
+                                    .retry_delay_ms = 30000};
+    const net_job_config_t weather = {.name = "weather",
+                                      .fn = weather_job,
+                                      .period_ms = 600000,
+                                      .jitter_ms = 15000,
+                                      .priority = NET_JOB_PRIO_NORMAL,
+                                      .max_retries = 2,
+                                      .retry_delay_ms = 30000};
+    const net_job_config_t location = {.name = "location",
+                                       .fn = location_job,
+                                       .period_ms = 3600000,
+                                       .first_delay_ms = 5000,
+                                       .priority = NET_JOB_PRIO_HIGH,
+                                       .max_retries = 1,
+                                       .retry_delay_ms = 10000};
+    net_sched_add(&yiyan);
+    net_sched_add(&weather);
+    net_sched_add(&location);
+    net_sched_submit("adhoc", adhoc_job, NULL, NET_JOB_PRIO_HIGH);
+
+    if (net_sched_find("adhoc") != -1) {
+        printf("FAIL: one-shot jobs must not be found by name\n");
+        s_failed_checks++;
+    }
+
+    if (setjmp(s_end) == 0) {
+        net_sched_task(NULL);
+    }
+
+    net_sched_stats_t stats;
+    net_sched_get_stats(&stats);
+    check_runs(&stats);
+
+    printf("%.0f h simulated: %u jobs in %u bursts, %u coalesced, %u retries, %u failures, "
+           "radio busy %lld s\n",
+           SIM_END_US / 3600e6, stats.jobs_run, stats.bursts, stats.coalesced, stats.retries,
+           stats.failures, (long long)(stats.busy_us_total / 1000000));
+    if (s_failed_checks != 0) {
+        printf("%d check(s) failed\n", s_failed_checks);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,286 @@
+/**
+ * @file pool_tls_test.c
+ * @brief 连接池的 TLS 会话恢复：固件的 http_pool.c 对接 tools/mock_upstream.py 的 HTTPS 端口
+ *
+ * HTTP 客户端为 stubs/host_http_client.c（HOST_HTTP_TLS，OpenSSL），与 esp-tls 一样把会话
+ * 票据保存在句柄中。模拟服务器按连接记录完整握手与会话恢复的次数，检查：
+ * - 首次请求完整握手，紧接着的请求复用连接、不再握手；
+ * - 空闲超过 HTTP_POOL_IDLE_CLOSE_MS 后连接池主动关闭连接，重连时恢复会话；
+ * - http_pool_flush()（Wi-Fi 断开）之后的请求同样恢复会话；
+ * - 对照：不保存会话的客户端每次重连都是完整握手。
+ *
+ * 用法：pool_tls_test <python3> <tools/mock_upstream.py> <cert.pem> <key.pem>
+ */
+
+#define _GNU_SOURCE
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "esp_http_client.h"
+#include "esp_timer.h"
+
+#include "http_pool.h"
+#include "wifi.h"
+
+static char s_control_url[64]; ///< 明文端口，用于读取统计
+static char s_tls_url[64];     ///< HTTPS 端口上的一言接口
+static int s_failed_checks;
+static int64_t s_clock_skew_us;
+
+// ============================================================================
+// 桩
+// ============================================================================
+
+/**
+ * @brief 单调时钟加上测试拨快的时间，空闲超时不必真的等待
+ */
+int64_t esp_timer_get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 + s_clock_skew_us;
+}
+
+void wifi_note_first_byte(void) {}
+
+// ============================================================================
+// 模拟服务器
+// ============================================================================
+
+static int free_port(void) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    socklen_t len = sizeof(addr);
+    if (bind(fd, (struct sockaddr *)&addr, len) != 0 ||
+        getsockname(fd, (struct sockaddr *)&addr, &len) != 0) {
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    return ntohs(addr.sin_port);
+}
+
+/**
+ * @brief 响应体
+ */
+typedef struct {
+    char text[1024];
+    size_t len;
+} body_t;
+
+static esp_err_t body_handler(esp_http_client_event_t *evt) {
+    body_t *body = evt->user_data;
+    if (evt->event_id == HTTP_EVENT_ON_DATA && body != NULL) {
+        size_t n = (size_t)evt->data_len;
+        if (n > sizeof(body->text) - 1 - body->len) {
+            n = sizeof(body->text) - 1 - body->len;
+        }
+        memcpy(body->text + body->len, evt->data, n);
+        body->len += n;
+        body->text[body->len] = '\0';
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief 模拟服务器记录的握手次数
+ */
+typedef struct {
+    int full;
+    int resumed;
+} handshakes_t;
+
+static bool mock_handshakes(handshakes_t *out) {
+    char url[128];
+    snprintf(url, sizeof(url), "%s/_mock/stats", s_control_url);
+    body_t body = {0};
+    esp_http_client_config_t config = {
+        .url = url, .event_handler = body_handler, .user_data = &body};
+    esp_http_client_handle_t client = esp_http_client_init(&config);
+    if (client == NULL) {
+        return false;
+    }
+    esp_err_t err = esp_http_client_perform(client);
+    int status = esp_http_client_get_status_code(client);
+    esp_http_client_cleanup(client);
+    if (err != ESP_OK || status != 200) {
+        return false;
+    }
+
+    const char *tls = strstr(body.text, "\"tls\"");
+    const char *full = tls ? strstr(tls, "\"full\":") : NULL;
+    const char *resumed = tls ? strstr(tls, "\"resumed\":") : NULL;
+    if (full == NULL || resumed == NULL) {
+        return false;
+    }
+    out->full = atoi(full + strlen("\"full\":"));
+    out->resumed = atoi(resumed + strlen("\"resumed\":"));
+    return true;
+}
+
+static pid_t mock_start(const char *python, const char *script, const char *cert,
+                        const char *key) {
+    int port = free_port();
+    int tls_port = free_port();
+    if (port < 0 || tls_port < 0 || port == tls_port) {
+        return -1;
+    }
+    snprintf(s_control_url, sizeof(s_control_url), "http://127.0.0.1:%d", port);
+    snprintf(s_tls_url, sizeof(s_tls_url), "https://127.0.0.1:%d/hitokoto", tls_port);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        char port_arg[16];
+        char tls_port_arg[16];
+        snprintf(port_arg, sizeof(port_arg), "%d", port);
+        snprintf(tls_port_arg, sizeof(tls_port_arg), "%d", tls_port);
+        freopen("/dev/null", "w", stderr);
+        execlp(python, python, script, "--host", "127.0.0.1", "--port", port_arg, "--tls-port",
+               tls_port_arg, "--tls-cert", cert, "--tls-key", key, (char *)NULL);
+        _exit(127);
+    }
+
+    // 等待服务器开始监听
+    handshakes_t hs;
+    for (int i = 0; i < 100; i++) {
+        if (mock_handshakes(&hs)) {
+            return pid;
+        }
+        usleep(100 * 1000);
+    }
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+    return -1;
+}
+
+// ============================================================================
+// 检查
+// ============================================================================
+
+#define EXPECT(cond, ...)                                                                          \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s:%d: ", __func__, __LINE__);                                            \
+            printf(__VA_ARGS__);                                                                   \
+            printf("\n");                                                                          \
+            s_failed_checks++;                                                                     \
+        }                                                                                          \
+    } while (0)
+
+/**
+ * @brief 通过连接池请求一次，检查握手次数的变化
+ *
+ * @param full    预期新增的完整握手次数
+ * @param resumed 预期新增的会话恢复次数
+ */
+static void pool_request(const char *name, int full, int resumed) {
+    handshakes_t before = {0}, after = {0};
+    http_pool_stats_t pool;
+    EXPECT(mock_handshakes(&before), "%s: read stats", name);
+
+    body_t body = {0};
+    esp_http_client_handle_t client = http_pool_acquire(s_tls_url, body_handler, &body);
+    EXPECT(client != NULL, "%s: acquire %s", name, s_tls_url);
+    if (client == NULL) {
+        return;
+    }
+    esp_err_t err = http_pool_perform(client);
+    int status = esp_http_client_get_status_code(client);
+    http_pool_release(client);
+    http_pool_get_stats(&pool);
+
+    EXPECT(err == ESP_OK && status == 200, "%s: %s, status %d", name, esp_err_to_name(err),
+           status);
+    EXPECT(strstr(body.text, "hitokoto") != NULL, "%s: unexpected body '%s'", name, body.text);
+    EXPECT(mock_handshakes(&after), "%s: read stats", name);
+    EXPECT(after.full - before.full == full && after.resumed - before.resumed == resumed,
+           "%s: %d full / %d resumed handshake(s), expected %d / %d", name,
+           after.full - before.full, after.resumed - before.resumed, full, resumed);
+    printf("%-12s full %d, resumed %d, last connect %6lld us\n", name, after.full, after.resumed,
+           (long long)pool.last_connect_us);
+}
+
+static void check_pool_resumption(void) {
+    pool_request("first", 1, 0);
+    pool_request("keep-alive", 0, 0);
+
+    s_clock_skew_us += (HTTP_POOL_IDLE_CLOSE_MS + 1000) * 1000LL;
+    pool_request("idle close", 0, 1);
+
+    http_pool_flush();
+    pool_request("flush", 0, 1);
+
+    http_pool_stats_t pool;
+    http_pool_get_stats(&pool);
+    EXPECT(pool.connects == 3 && pool.reused == 1, "pool: %u connects, %u reused", pool.connects,
+           pool.reused);
+}
+
+/**
+ * @brief 对照：不保存会话时，同一句柄重连仍是完整握手
+ */
+static void check_without_session(void) {
+    handshakes_t before = {0}, after = {0};
+    EXPECT(mock_handshakes(&before), "read stats");
+
+    body_t body = {0};
+    esp_http_client_config_t config = {
+        .url = s_tls_url,
+        .event_handler = body_handler,
+        .user_data = &body,
+        .keep_alive_enable = true,
+    };
+    esp_http_client_handle_t client = esp_http_client_init(&config);
+    EXPECT(client != NULL, "init %s", s_tls_url);
+    if (client == NULL) {
+        return;
+    }
+    for (int i = 0; i < 2; i++) {
+        esp_err_t err = esp_http_client_perform(client);
+        EXPECT(err == ESP_OK, "request %d: %s", i, esp_err_to_name(err));
+        esp_http_client_close(client);
+    }
+    esp_http_client_cleanup(client);
+
+    EXPECT(mock_handshakes(&after), "read stats");
+    EXPECT(after.full - before.full == 2 && after.resumed == before.resumed,
+           "no session: %d full / %d resumed handshake(s), expected 2 / 0",
+           after.full - before.full, after.resumed - before.resumed);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 5) {
+        fprintf(stderr, "usage: %s <python3> <mock_upstream.py> <cert.pem> <key.pem>\n",
+                argv[0]);
+        return 2;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    pid_t mock = mock_start(argv[1], argv[2], argv[3], argv[4]);
+    if (mock < 0) {
+        printf("FAIL: mock upstream did not start\n");
+        return 1;
+    }
+
+    http_pool_init();
+    check_pool_resumption();
+    check_without_session();
+
+    kill(mock, SIGTERM);
+    waitpid(mock, NULL, 0);
+
+    if (s_failed_checks != 0) {
+        printf("%d check(s) failed\n", s_failed_checks);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,10 @@
+/**
+ * @file esp_attr.h
+ * @brief 主机测试用的段属性桩，属性全部为空
+ */
+
+#pragma once
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define EXT_RAM_BSS_ATTR
@@ -0,0 +1,10 @@
+/**
+ * @file esp_crt_bundle.h
+ * @brief 主机测试用的证书包桩，主机端不校验证书
+ */
+
+#pragma once
+
+#include "esp_err.h"
+
+esp_err_t esp_crt_bundle_attach(void *conf);
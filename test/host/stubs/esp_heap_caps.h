@@ -0,0 +1,30 @@
+/**
+ * @file esp_heap_caps.h
+ * @brief 主机测试用的 heap_caps 桩
+ *
+ * 分配转发给 libc，并统计当前与峰值占用（heap.c），供测试报告固件代码的内存峰值。
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+void *heap_caps_malloc(size_t size, uint32_t caps);
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void *heap_caps_realloc(void *ptr, size_t size, uint32_t caps);
+void heap_caps_free(void *ptr);
+
+/** @brief 当前通过 heap_caps_* 分配且未释放的字节数 */
+size_t host_heap_in_use(void);
+
+/** @brief 上次 host_heap_reset_peak() 以来的峰值占用 */
+size_t host_heap_peak(void);
+
+/** @brief 把峰值重置为当前占用 */
+void host_heap_reset_peak(void);
@@ -0,0 +1,17 @@
+/**
+ * @file esp_mac.h
+ * @brief 主机测试用的 MAC 地址桩，esp_read_mac() 由各测试实现
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+typedef enum {
+    ESP_MAC_WIFI_STA,
+    ESP_MAC_WIFI_SOFTAP,
+} esp_mac_type_t;
+
+esp_err_t esp_read_mac(uint8_t *mac, esp_mac_type_t type);
@@ -0,0 +1,10 @@
+/**
+ * @file esp_random.h
+ * @brief 主机测试用的随机数桩，由各测试实现（可复现）
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+uint32_t esp_random(void);
@@ -0,0 +1,10 @@
+/**
+ * @file esp_timer.h
+ * @brief 主机测试用的 esp_timer 桩，esp_timer_get_time() 由各测试实现（真实或模拟时钟）
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
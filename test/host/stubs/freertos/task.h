@@ -0,0 +1,19 @@
+/**
+ * @file task.h
+ * @brief 主机测试用的 FreeRTOS 任务桩
+ *
+ * xTaskGetCurrentTaskHandle() 在 rtos.c 中按线程实现；创建任务与任务通知由各测试实现。
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                       UBaseType_t prio, TaskHandle_t *handle);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
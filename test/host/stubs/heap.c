@@ -0,0 +1,76 @@
+/**
+ * @file heap.c
+ * @brief 主机测试用的 heap_caps 实现：libc 分配加占用统计
+ *
+ * 每块前面放一个记录大小的头，释放时扣减。
+ */
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_heap_caps.h"
+
+/** @brief 块头，按 max_align_t 对齐，保证返回的指针满足任意类型的对齐要求 */
+typedef union {
+    size_t size;
+    max_align_t align;
+} heap_header_t;
+
+static atomic_size_t s_in_use;
+static atomic_size_t s_peak;
+
+static void *account(heap_header_t *h, size_t size) {
+    if (h == NULL) {
+        return NULL;
+    }
+    h->size = size;
+    size_t now = atomic_fetch_add(&s_in_use, size) + size;
+    size_t peak = atomic_load(&s_peak);
+    while (now > peak && !atomic_compare_exchange_weak(&s_peak, &peak, now)) {
+    }
+    return h + 1;
+}
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+    (void)caps;
+    return account(malloc(sizeof(heap_header_t) + size), size);
+}
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    (void)caps;
+    if (size != 0 && n > (SIZE_MAX - sizeof(heap_header_t)) / size) {
+        return NULL;
+    }
+    return account(calloc(1, sizeof(heap_header_t) + n * size), n * size);
+}
+
+void *heap_caps_realloc(void *ptr, size_t size, uint32_t caps) {
+    (void)caps;
+    if (ptr == NULL) {
+        return heap_caps_malloc(size, caps);
+    }
+    heap_header_t *h = (heap_header_t *)ptr - 1;
+    size_t old = h->size;
+    heap_header_t *n = realloc(h, sizeof(heap_header_t) + size);
+    if (n == NULL) {
+        return NULL;
+    }
+    atomic_fetch_sub(&s_in_use, old);
+    return account(n, size);
+}
+
+void heap_caps_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    heap_header_t *h = (heap_header_t *)ptr - 1;
+    atomic_fetch_sub(&s_in_use, h->size);
+    free(h);
+}
+
+size_t host_heap_in_use(void) { return atomic_load(&s_in_use); }
+
+size_t host_heap_peak(void) { return atomic_load(&s_peak); }
+
+void host_heap_reset_peak(void) { atomic_store(&s_peak, atomic_load(&s_in_use)); }
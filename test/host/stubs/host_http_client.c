@@ -0,0 +1,560 @@
+/**
+ * @file host_http_client.c
+ * @brief 主机测试用的 esp_http_client 实现（HTTP/1.1，POSIX 套接字）
+ *
+ * 只实现固件用到的行为：
+ * - HOST_HTTP_TLS 为 1 时 https:// 经 OpenSSL 建立 TLS（不校验证书）；save_client_session
+ *   开启时保存服务器下发的会话票据，句柄重连时恢复会话，与 esp-tls 相同，票据随句柄一起释放；
+ *   为 0 时 https:// 与 http:// 一样以明文连接（默认端口 443），可对接明文的模拟服务器；
+ * - 长连接：连接在请求之间保持打开，服务器返回 Connection: close 或出错时关闭；
+ * - 响应体按 Content-Length、分块传输或读到连接关闭为止，分块格式在交给回调前去掉；
+ * - 事件顺序：ON_CONNECTED → HEADERS_SENT → ON_HEADER… → ON_DATA… → ON_FINISH，
+ *   关闭连接时 DISCONNECTED；
+ * - 接收超时返回 ESP_ERR_HTTP_EAGAIN，连接失败时记录 esp-tls 错误码，与 ESP-IDF 一致。
+ */
+
+#include <errno.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#ifndef HOST_HTTP_TLS
+#define HOST_HTTP_TLS 0
+#endif
+
+#if HOST_HTTP_TLS
+#include <openssl/ssl.h>
+#endif
+
+#include "esp_crt_bundle.h"
+#include "esp_http_client.h"
+#include "esp_tls.h"
+
+/** @brief 默认接收超时（与 ESP-IDF 的 DEFAULT_TIMEOUT_MS 相同） */
+#define HOST_HTTP_TIMEOUT_MS 5000
+/** @brief 最多保存的请求头数 */
+#define HOST_HTTP_MAX_HEADERS 8
+/** @brief 接收缓冲区大小，也是单个 ON_DATA 事件的最大长度 */
+#define HOST_HTTP_BUF_SIZE 1024
+
+typedef struct {
+    char key[64];
+    char value[256];
+} host_header_t;
+
+struct esp_http_client {
+    char host[128];
+    char port[8];
+    char path[512];
+    http_event_handle_cb handler;
+    void *user_data;
+    int timeout_ms;
+    bool keep_alive;
+    bool tls;          ///< https:// 且 HOST_HTTP_TLS 为 1
+    bool save_session; ///< save_client_session
+    int fd;
+#if HOST_HTTP_TLS
+    SSL *ssl;
+    SSL_SESSION *session; ///< 最近一次收到的会话票据
+#endif
+    host_header_t headers[HOST_HTTP_MAX_HEADERS];
+    int status;
+    int64_t content_length;
+    esp_err_t tls_err;
+    uint8_t buf[HOST_HTTP_BUF_SIZE];
+    size_t buf_pos;
+    size_t buf_len;
+};
+
+/** @brief 读取结果：> 0 读到的字节数，0 对端关闭，< 0 出错或超时 */
+#define READ_TIMEOUT -2
+
+#if HOST_HTTP_TLS
+static SSL_CTX *s_ssl_ctx;
+#endif
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+static void dispatch(esp_http_client_handle_t c, esp_http_client_event_id_t id, void *data,
+                     int len, char *key, char *value) {
+    if (c->handler == NULL) {
+        return;
+    }
+    esp_http_client_event_t evt = {
+        .event_id = id,
+        .client = c,
+        .data = data,
+        .data_len = len,
+        .user_data = c->user_data,
+        .header_key = key,
+        .header_value = value,
+    };
+    c->handler(&evt);
+}
+
+static esp_err_t parse_url(esp_http_client_handle_t c, const char *url) {
+    const char *p;
+    bool https = false;
+    if (strncmp(url, "http://", 7) == 0) {
+        p = url + 7;
+    } else if (strncmp(url, "https://", 8) == 0) {
+        p = url + 8;
+        https = true;
+    } else {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    c->tls = HOST_HTTP_TLS && https;
+    size_t host_len = strcspn(p, ":/?");
+    if (host_len == 0 || host_len >= sizeof(c->host)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memcpy(c->host, p, host_len);
+    c->host[host_len] = '\0';
+    p += host_len;
+
+    snprintf(c->port, sizeof(c->port), "%s", https ? "443" : "80");
+    if (*p == ':') {
+        size_t port_len = strcspn(++p, "/?");
+        if (port_len == 0 || port_len >= sizeof(c->port)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        memcpy(c->port, p, port_len);
+        c->port[port_len] = '\0';
+        p += port_len;
+    }
+    snprintf(c->path, sizeof(c->path), "%s%s", *p == '/' ? "" : "/", p);
+    return ESP_OK;
+}
+
+#if HOST_HTTP_TLS
+/**
+ * @brief 服务器下发会话票据（TLS 1.3 在握手之后、读取响应时到达）
+ *
+ * @return 1 接管 sess，0 由 OpenSSL 释放
+ */
+static int tls_new_session(SSL *ssl, SSL_SESSION *sess) {
+    esp_http_client_handle_t c = SSL_get_app_data(ssl);
+    if (!c->save_session) {
+        return 0;
+    }
+    if (c->session != NULL) {
+        SSL_SESSION_free(c->session);
+    }
+    c->session = sess;
+    return 1;
+}
+
+static esp_err_t tls_handshake(esp_http_client_handle_t c, int fd) {
+    if (s_ssl_ctx == NULL) {
+        s_ssl_ctx = SSL_CTX_new(TLS_client_method());
+        if (s_ssl_ctx == NULL) {
+            return ESP_FAIL;
+        }
+        // 证书包在主机上是空实现，不校验证书；会话只保存在句柄中，不使用 OpenSSL 的缓存
+        SSL_CTX_set_verify(s_ssl_ctx, SSL_VERIFY_NONE, NULL);
+        SSL_CTX_set_options(s_ssl_ctx, SSL_OP_IGNORE_UNEXPECTED_EOF);
+        SSL_CTX_set_session_cache_mode(s_ssl_ctx,
+                                       SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(s_ssl_ctx, tls_new_session);
+    }
+
+    c->ssl = SSL_new(s_ssl_ctx);
+    if (c->ssl == NULL) {
+        return ESP_FAIL;
+    }
+    SSL_set_app_data(c->ssl, c);
+    SSL_set_fd(c->ssl, fd);
+    if (c->save_session && c->session != NULL) {
+        SSL_set_session(c->ssl, c->session);
+    }
+    if (SSL_connect(c->ssl) != 1) {
+        SSL_free(c->ssl);
+        c->ssl = NULL;
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+#endif
+
+static ssize_t io_recv(esp_http_client_handle_t c, void *buf, size_t len) {
+#if HOST_HTTP_TLS
+    if (c->ssl != NULL) {
+        int n = SSL_read(c->ssl, buf, (int)len);
+        if (n > 0) {
+            return n;
+        }
+        int err = SSL_get_error(c->ssl, n);
+        if (err == SSL_ERROR_ZERO_RETURN) {
+            return 0;
+        }
+        if (err != SSL_ERROR_WANT_READ && (err != SSL_ERROR_SYSCALL || errno == 0)) {
+            errno = EIO;
+        }
+        return -1;
+    }
+#endif
+    return recv(c->fd, buf, len, 0);
+}
+
+static ssize_t io_send(esp_http_client_handle_t c, const void *buf, size_t len) {
+#if HOST_HTTP_TLS
+    if (c->ssl != NULL) {
+        int n = SSL_write(c->ssl, buf, (int)len);
+        return n > 0 ? n : -1;
+    }
+#endif
+    return send(c->fd, buf, len, MSG_NOSIGNAL);
+}
+
+static esp_err_t do_connect(esp_http_client_handle_t c) {
+    struct addrinfo hints = {.ai_family = AF_INET, .ai_socktype = SOCK_STREAM};
+    struct addrinfo *res = NULL;
+    if (getaddrinfo(c->host, c->port, &hints, &res) != 0 || res == NULL) {
+        c->tls_err = ESP_ERR_ESP_TLS_CANNOT_RESOLVE_HOSTNAME;
+        return ESP_ERR_HTTP_CONNECT;
+    }
+
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd < 0) {
+        freeaddrinfo(res);
+        c->tls_err = ESP_ERR_ESP_TLS_CANNOT_CREATE_SOCKET;
+        return ESP_ERR_HTTP_CONNECT;
+    }
+    int ret = connect(fd, res->ai_addr, res->ai_addrlen);
+    freeaddrinfo(res);
+    if (ret != 0) {
+        close(fd);
+        c->tls_err = ESP_ERR_ESP_TLS_FAILED_CONNECT_TO_HOST;
+        return ESP_ERR_HTTP_CONNECT;
+    }
+
+    struct timeval tv = {.tv_sec = c->timeout_ms / 1000, .tv_usec = c->timeout_ms % 1000 * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+#if HOST_HTTP_TLS
+    if (c->tls && tls_handshake(c, fd) != ESP_OK) {
+        close(fd);
+        c->tls_err = ESP_ERR_MBEDTLS_SSL_HANDSHAKE_FAILED;
+        return ESP_ERR_HTTP_CONNECT;
+    }
+#endif
+    c->fd = fd;
+    c->buf_pos = c->buf_len = 0;
+    dispatch(c, HTTP_EVENT_ON_CONNECTED, NULL, 0, NULL, NULL);
+    return ESP_OK;
+}
+
+/**
+ * @brief 读取数据，优先返回缓冲区中剩余的部分
+ */
+static int read_some(esp_http_client_handle_t c, uint8_t **data, size_t max) {
+    if (c->buf_pos == c->buf_len) {
+        errno = 0;
+        ssize_t n = io_recv(c, c->buf, sizeof(c->buf));
+        if (n < 0) {
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? READ_TIMEOUT : -1;
+        }
+        if (n == 0) {
+            return 0;
+        }
+        c->buf_pos = 0;
+        c->buf_len = (size_t)n;
+    }
+    size_t n = c->buf_len - c->buf_pos;
+    if (n > max) {
+        n = max;
+    }
+    *data = c->buf + c->buf_pos;
+    c->buf_pos += n;
+    return (int)n;
+}
+
+/**
+ * @brief 读取一行（去掉 CRLF）
+ *
+ * @return 行长度，0 对端关闭，< 0 出错或超时
+ */
+static int read_line(esp_http_client_handle_t c, char *line, size_t size) {
+    size_t len = 0;
+    for (;;) {
+        uint8_t *p;
+        int n = read_some(c, &p, 1);
+        if (n <= 0) {
+            return n;
+        }
+        if (*p == '\n') {
+            break;
+        }
+        if (*p != '\r' && len + 1 < size) {
+            line[len++] = (char)*p;
+        }
+    }
+    line[len] = '\0';
+    return (int)len + 1;
+}
+
+/**
+ * @brief 读取 len 字节的响应体并逐块交给回调，len < 0 表示读到连接关闭为止
+ */
+static int read_body(esp_http_client_handle_t c, int64_t len) {
+    while (len != 0) {
+        uint8_t *data;
+        size_t want = (len < 0 || len > HOST_HTTP_BUF_SIZE) ? HOST_HTTP_BUF_SIZE : (size_t)len;
+        int n = read_some(c, &data, want);
+        if (n <= 0) {
+            return (n == 0 && len < 0) ? 1 : n;
+        }
+        dispatch(c, HTTP_EVENT_ON_DATA, data, n, NULL, NULL);
+        if (len > 0) {
+            len -= n;
+        }
+    }
+    return 1;
+}
+
+static esp_err_t read_error(esp_http_client_handle_t c, int n) {
+    esp_http_client_close(c);
+    return n == READ_TIMEOUT ? ESP_ERR_HTTP_EAGAIN : ESP_FAIL;
+}
+
+// ============================================================================
+// esp_http_client API
+// ============================================================================
+
+esp_err_t esp_crt_bundle_attach(void *conf) {
+    (void)conf;
+    return ESP_OK;
+}
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *config) {
+    esp_http_client_handle_t c = calloc(1, sizeof(*c));
+    if (c == NULL) {
+        return NULL;
+    }
+    c->fd = -1;
+    c->handler = config->event_handler;
+    c->user_data = config->user_data;
+    c->keep_alive = config->keep_alive_enable;
+    c->save_session = config->save_client_session;
+    c->timeout_ms = config->timeout_ms > 0 ? config->timeout_ms : HOST_HTTP_TIMEOUT_MS;
+    if (config->url == NULL || parse_url(c, config->url) != ESP_OK) {
+        free(c);
+        return NULL;
+    }
+    return c;
+}
+
+esp_err_t esp_http_client_set_url(esp_http_client_handle_t c, const char *url) {
+    char host[sizeof(c->host)];
+    char port[sizeof(c->port)];
+    memcpy(host, c->host, sizeof(host));
+    memcpy(port, c->port, sizeof(port));
+    esp_err_t err = parse_url(c, url);
+    if (err == ESP_OK && (strcmp(host, c->host) != 0 || strcmp(port, c->port) != 0)) {
+        esp_http_client_close(c);
+    }
+    return err;
+}
+
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t c, const char *key,
+                                     const char *value) {
+    host_header_t *free_slot = NULL;
+    for (int i = 0; i < HOST_HTTP_MAX_HEADERS; i++) {
+        host_header_t *h = &c->headers[i];
+        if (strcasecmp(h->key, key) == 0) {
+            free_slot = h;
+            break;
+        }
+        if (h->key[0] == '\0' && free_slot == NULL) {
+            free_slot = h;
+        }
+    }
+    if (free_slot == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    snprintf(free_slot->key, sizeof(free_slot->key), "%s", key);
+    snprintf(free_slot->value, sizeof(free_slot->value), "%s", value);
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_delete_header(esp_http_client_handle_t c, const char *key) {
+    for (int i = 0; i < HOST_HTTP_MAX_HEADERS; i++) {
+        if (strcasecmp(c->headers[i].key, key) == 0) {
+            c->headers[i].key[0] = '\0';
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_get_header(esp_http_client_handle_t c, const char *key, char **value) {
+    *value = NULL;
+    for (int i = 0; i < HOST_HTTP_MAX_HEADERS; i++) {
+        if (c->headers[i].key[0] != '\0' && strcasecmp(c->headers[i].key, key) == 0) {
+            *value = c->headers[i].value;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_perform(esp_http_client_handle_t c) {
+    c->status = 0;
+    c->content_length = 0;
+
+    if (c->fd < 0) {
+        esp_err_t err = do_connect(c);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    char req[1536];
+    int len = snprintf(req, sizeof(req),
+                       "GET %s HTTP/1.1\r\nHost: %s:%s\r\nUser-Agent: ESP32 HTTP Client/1.0\r\n",
+                       c->path, c->host, c->port);
+    for (int i = 0; i < HOST_HTTP_MAX_HEADERS; i++) {
+        if (c->headers[i].key[0] != '\0') {
+            len += snprintf(req + len, sizeof(req) - len, "%s: %s\r\n", c->headers[i].key,
+                            c->headers[i].value);
+        }
+    }
+    len += snprintf(req + len, sizeof(req) - len, "%s\r\n",
+                    c->keep_alive ? "" : "Connection: close\r\n");
+    if (io_send(c, req, len) != len) {
+        esp_http_client_close(c);
+        return ESP_ERR_HTTP_WRITE_DATA;
+    }
+    dispatch(c, HTTP_EVENT_HEADERS_SENT, NULL, 0, NULL, NULL);
+
+    // 状态行：复用的连接已被对端关闭时在这里读到 0
+    char line[512];
+    int n = read_line(c, line, sizeof(line));
+    if (n <= 0) {
+        esp_http_client_close(c);
+        return n == READ_TIMEOUT ? ESP_ERR_HTTP_EAGAIN : ESP_ERR_HTTP_FETCH_HEADER;
+    }
+    if (sscanf(line, "HTTP/%*d.%*d %d", &c->status) != 1) {
+        esp_http_client_close(c);
+        return ESP_ERR_HTTP_FETCH_HEADER;
+    }
+
+    bool chunked = false;
+    bool close_after = !c->keep_alive;
+    int64_t length = -1;
+    while ((n = read_line(c, line, sizeof(line))) > 1) {
+        char *colon = strchr(line, ':');
+        if (colon == NULL) {
+            continue;
+        }
+        *colon = '\0';
+        char *value = colon + 1 + strspn(colon + 1, " \t");
+        if (strcasecmp(line, "Content-Length") == 0) {
+            length = strtoll(value, NULL, 10);
+        } else if (strcasecmp(line, "Transfer-Encoding") == 0) {
+            chunked = strcasecmp(value, "chunked") == 0;
+        } else if (strcasecmp(line, "Connection") == 0) {
+            close_after |= strcasecmp(value, "close") == 0;
+        }
+        dispatch(c, HTTP_EVENT_ON_HEADER, NULL, 0, line, value);
+    }
+    if (n <= 0) {
+        return read_error(c, n);
+    }
+
+    if (c->status == 204 || c->status == 304 || (c->status >= 100 && c->status < 200)) {
+        length = 0;
+    }
+    c->content_length = chunked ? -1 : length;
+
+    if (chunked) {
+        for (;;) {
+            if ((n = read_line(c, line, sizeof(line))) <= 0) {
+                return read_error(c, n);
+            }
+            int64_t size = strtoll(line, NULL, 16);
+            if (size == 0) {
+                // 跳过 trailer 直到空行
+                while ((n = read_line(c, line, sizeof(line))) > 1) {
+                }
+                if (n <= 0) {
+                    return read_error(c, n);
+                }
+                break;
+            }
+            if ((n = read_body(c, size)) <= 0 || (n = read_line(c, line, sizeof(line))) <= 0) {
+                return read_error(c, n);
+            }
+        }
+    } else {
+        if ((n = read_body(c, length)) <= 0) {
+            return read_error(c, n);
+        }
+        close_after |= length < 0;
+    }
+
+    dispatch(c, HTTP_EVENT_ON_FINISH, NULL, 0, NULL, NULL);
+    if (close_after) {
+        esp_http_client_close(c);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_get_user_data(esp_http_client_handle_t c, void **data) {
+    *data = c->user_data;
+    return ESP_OK;
+}
+
+int esp_http_client_get_status_code(esp_http_client_handle_t c) { return c->status; }
+
+int64_t esp_http_client_get_content_length(esp_http_client_handle_t c) {
+    return c->content_length;
+}
+
+esp_err_t esp_http_client_close(esp_http_client_handle_t c) {
+    if (c->fd >= 0) {
+#if HOST_HTTP_TLS
+        if (c->ssl != NULL) {
+            // 发送 close_notify，否则 OpenSSL 认为会话异常结束，不再允许恢复
+            SSL_shutdown(c->ssl);
+            SSL_free(c->ssl);
+            c->ssl = NULL;
+        }
+#endif
+        close(c->fd);
+        c->fd = -1;
+        dispatch(c, HTTP_EVENT_DISCONNECTED, NULL, 0, NULL, NULL);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t c) {
+    if (c == NULL) {
+        return ESP_FAIL;
+    }
+    esp_http_client_close(c);
+#if HOST_HTTP_TLS
+    if (c->session != NULL) {
+        SSL_SESSION_free(c->session);
+    }
+#endif
+    free(c);
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_get_and_clear_last_tls_error(esp_http_client_handle_t c,
+                                                       int *esp_tls_code, int *esp_tls_flags) {
+    esp_err_t err = c->tls_err;
+    c->tls_err = ESP_OK;
+    if (esp_tls_code != NULL) {
+        *esp_tls_code = 0;
+    }
+    if (esp_tls_flags != NULL) {
+        *esp_tls_flags = 0;
+    }
+    return err;
+}
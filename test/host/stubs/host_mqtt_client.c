@@ -0,0 +1,759 @@
+/**
+ * @file host_mqtt_client.c
+ * @brief 主机测试用的 esp-mqtt 客户端实现（MQTT 3.1.1，POSIX 套接字）
+ *
+ * 每个客户端一个线程，相当于 esp-mqtt 的 MQTT 任务，事件处理函数在该线程中调用。
+ * 只实现固件用到的行为：
+ * - 只支持 mqtt://；QoS 0 / 1，持久会话，遗嘱消息；
+ * - 事件顺序：BEFORE_CONNECT → CONNECTED（带 session present）→ DATA… → DISCONNECTED，
+ *   连接失败时 ERROR；之后等待 reconnect_timeout_ms 再重连；stop 不产生事件；
+ * - 超过接收缓冲的消息分成多个 DATA 事件，只有第一个带主题，与 esp-mqtt 相同；
+ * - QoS 1 的 PUBACK 在事件处理函数返回之后发送；
+ * - outbox：QoS 1 消息在收到 PUBACK 前保留，断开后重连时重发；离线时的 QoS 1 发布与
+ *   enqueue 的消息由客户端线程在连接后发送；超过 outbox.limit 时返回 -2；
+ * - 保活与重连等待使用 esp_timer_get_time()（由测试实现，可以是模拟时钟）：距上次发送
+ *   满 keepalive 秒时发送 PINGREQ。
+ */
+
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "mqtt_client.h"
+
+#define TAG "host_mqtt"
+
+/** @brief 客户端线程检查停止、保活与 outbox 的间隔 */
+#define HOST_MQTT_POLL_MS 10
+/** @brief 连接与读取报文的超时 */
+#define HOST_MQTT_TIMEOUT_MS 5000
+
+#define PKT_CONNECT 1
+#define PKT_CONNACK 2
+#define PKT_PUBLISH 3
+#define PKT_PUBACK 4
+#define PKT_SUBSCRIBE 8
+#define PKT_SUBACK 9
+#define PKT_UNSUBSCRIBE 10
+#define PKT_UNSUBACK 11
+#define PKT_PINGREQ 12
+#define PKT_PINGRESP 13
+#define PKT_DISCONNECT 14
+
+/**
+ * @brief outbox 中的一条 PUBLISH
+ */
+typedef struct outbox_msg {
+    struct outbox_msg *next;
+    int msg_id;       ///< QoS 0 为 0
+    int qos;          ///< 发送后 QoS 0 的消息即移除，QoS 1 等待 PUBACK
+    bool sent;        ///< 本次连接中是否已发送
+    size_t len;       ///< 报文长度
+    uint8_t packet[]; ///< 完整的 PUBLISH 报文
+} outbox_msg_t;
+
+struct esp_mqtt_client {
+    char host[128];
+    char port[8];
+    char client_id[64];
+    char username[64];
+    char password[64];
+    char will_topic[128];
+    char will_msg[128];
+    int will_qos;
+    bool will_retain;
+    bool clean_session;
+    int keepalive_s;
+    int reconnect_ms;
+    int buffer_size;
+    uint64_t outbox_limit;
+
+    esp_event_handler_t handler;
+    void *handler_arg;
+
+    pthread_t thread;
+    bool started;
+    atomic_bool running;
+    atomic_bool reconnect_now;
+
+    pthread_mutex_t lock; ///< 保护以下成员与套接字写入
+    int fd;               ///< 只由客户端线程打开与关闭
+    bool connected;
+    uint16_t next_id;
+    int64_t last_tx_us; ///< 上次发送报文的时间（保活）
+    outbox_msg_t *outbox;
+    size_t outbox_bytes;
+
+    uint8_t *rx; ///< 只由客户端线程使用
+    size_t rx_cap;
+};
+
+// ============================================================================
+// 私有函数
+// ============================================================================
+
+static void dispatch(esp_mqtt_client_handle_t client, esp_mqtt_event_t *event) {
+    event->client = client;
+    if (client->handler != NULL) {
+        client->handler(client->handler_arg, "MQTT_EVENTS", event->event_id, event);
+    }
+}
+
+static void dispatch_simple(esp_mqtt_client_handle_t client, esp_mqtt_event_id_t id, int msg_id) {
+    esp_mqtt_event_t event = {.event_id = id, .msg_id = msg_id};
+    dispatch(client, &event);
+}
+
+/**
+ * @brief 写入剩余长度字段，返回字节数
+ */
+static size_t put_length(uint8_t *buf, size_t n) {
+    size_t pos = 0;
+    do {
+        uint8_t byte = n % 128;
+        n /= 128;
+        buf[pos++] = byte | (n > 0 ? 0x80 : 0);
+    } while (n > 0);
+    return pos;
+}
+
+static size_t put_str(uint8_t *buf, const char *s, size_t len) {
+    buf[0] = (uint8_t)(len >> 8);
+    buf[1] = (uint8_t)len;
+    memcpy(buf + 2, s, len);
+    return len + 2;
+}
+
+/**
+ * @brief 组装报文：固定头 + 可变部分，返回 malloc 的缓冲
+ */
+static uint8_t *build_packet(uint8_t first, const uint8_t *body, size_t body_len, size_t *len) {
+    uint8_t *packet = malloc(body_len + 5);
+    if (packet == NULL) {
+        return NULL;
+    }
+    packet[0] = first;
+    size_t pos = 1 + put_length(packet + 1, body_len);
+    memcpy(packet + pos, body, body_len);
+    *len = pos + body_len;
+    return packet;
+}
+
+/**
+ * @brief 发送报文（需持有锁）
+ */
+static bool send_locked(esp_mqtt_client_handle_t client, const uint8_t *data, size_t len) {
+    if (client->fd < 0) {
+        return false;
+    }
+    while (len > 0) {
+        ssize_t n = send(client->fd, data, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+    client->last_tx_us = esp_timer_get_time();
+    return true;
+}
+
+static uint16_t next_id_locked(esp_mqtt_client_handle_t client) {
+    client->next_id = (uint16_t)(client->next_id % 65535 + 1);
+    return client->next_id;
+}
+
+/**
+ * @brief 放入 outbox（需持有锁），超出上限返回 false
+ */
+static bool outbox_add_locked(esp_mqtt_client_handle_t client, const uint8_t *packet, size_t len,
+                              int msg_id, int qos, bool sent) {
+    if (client->outbox_limit > 0 && client->outbox_bytes + len > client->outbox_limit) {
+        return false;
+    }
+    outbox_msg_t *msg = malloc(sizeof(outbox_msg_t) + len);
+    if (msg == NULL) {
+        return false;
+    }
+    msg->next = NULL;
+    msg->msg_id = msg_id;
+    msg->qos = qos;
+    msg->sent = sent;
+    msg->len = len;
+    memcpy(msg->packet, packet, len);
+
+    outbox_msg_t **tail = &client->outbox;
+    while (*tail != NULL) {
+        tail = &(*tail)->next;
+    }
+    *tail = msg;
+    client->outbox_bytes += len;
+    return true;
+}
+
+/**
+ * @brief 移除满足条件的 outbox 消息（需持有锁）
+ */
+static void outbox_remove_locked(esp_mqtt_client_handle_t client, int msg_id, bool sent_qos0) {
+    outbox_msg_t **link = &client->outbox;
+    while (*link != NULL) {
+        outbox_msg_t *msg = *link;
+        bool remove = sent_qos0 ? (msg->qos == 0 && msg->sent) : (msg->msg_id == msg_id);
+        if (remove) {
+            *link = msg->next;
+            client->outbox_bytes -= msg->len;
+            free(msg);
+        } else {
+            link = &msg->next;
+        }
+    }
+}
+
+/**
+ * @brief 发送 outbox 中本次连接尚未发送的消息（需持有锁）
+ */
+static void outbox_flush_locked(esp_mqtt_client_handle_t client) {
+    for (outbox_msg_t *msg = client->outbox; msg != NULL; msg = msg->next) {
+        if (!msg->sent && send_locked(client, msg->packet, msg->len)) {
+            msg->sent = true;
+        }
+    }
+    outbox_remove_locked(client, 0, true);
+}
+
+static uint8_t *build_publish(esp_mqtt_client_handle_t client, const char *topic,
+                              const char *data, int len, int qos, int retain, int *msg_id,
+                              size_t *packet_len) {
+    size_t topic_len = strlen(topic);
+    size_t data_len = (len > 0) ? (size_t)len : (data != NULL ? strlen(data) : 0);
+    uint8_t *body = malloc(topic_len + 4 + data_len);
+    if (body == NULL) {
+        return NULL;
+    }
+    size_t pos = put_str(body, topic, topic_len);
+    *msg_id = 0;
+    if (qos > 0) {
+        *msg_id = next_id_locked(client);
+        body[pos++] = (uint8_t)(*msg_id >> 8);
+        body[pos++] = (uint8_t)*msg_id;
+    }
+    if (data_len > 0) {
+        memcpy(body + pos, data, data_len);
+        pos += data_len;
+    }
+    uint8_t first = (uint8_t)((PKT_PUBLISH << 4) | (qos > 0 ? 0x02 : 0) | (retain ? 0x01 : 0));
+    uint8_t *packet = build_packet(first, body, pos, packet_len);
+    free(body);
+    return packet;
+}
+
+static bool recv_exact(int fd, uint8_t *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = recv(fd, buf, len, 0);
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief 读取一个报文到 client->rx，返回报文类型与标志，失败返回 -1
+ */
+static int read_packet(esp_mqtt_client_handle_t client, int fd, size_t *len) {
+    uint8_t first;
+    if (!recv_exact(fd, &first, 1)) {
+        return -1;
+    }
+    size_t n = 0;
+    for (int shift = 0; shift <= 21; shift += 7) {
+        uint8_t byte;
+        if (!recv_exact(fd, &byte, 1)) {
+            return -1;
+        }
+        n |= (size_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+    if (n > client->rx_cap) {
+        uint8_t *rx = realloc(client->rx, n);
+        if (rx == NULL) {
+            return -1;
+        }
+        client->rx = rx;
+        client->rx_cap = n;
+    }
+    if (n > 0 && !recv_exact(fd, client->rx, n)) {
+        return -1;
+    }
+    *len = n;
+    return first;
+}
+
+/**
+ * @brief 建立 TCP 连接并完成 CONNECT / CONNACK，失败返回 -1
+ */
+static int open_session(esp_mqtt_client_handle_t client, int *session_present,
+                        esp_mqtt_error_type_t *error) {
+    *error = MQTT_ERROR_TYPE_TCP_TRANSPORT;
+    struct addrinfo hints = {.ai_family = AF_INET, .ai_socktype = SOCK_STREAM};
+    struct addrinfo *res = NULL;
+    if (getaddrinfo(client->host, client->port, &hints, &res) != 0 || res == NULL) {
+        return -1;
+    }
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    if (fd < 0) {
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    struct timeval tv = {.tv_sec = HOST_MQTT_TIMEOUT_MS / 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    uint8_t body[512];
+    size_t pos = put_str(body, "MQTT", 4);
+    body[pos++] = 4;
+    uint8_t flags = client->clean_session ? 0x02 : 0;
+    if (client->will_topic[0] != '\0') {
+        flags |= 0x04 | (uint8_t)(client->will_qos << 3) | (client->will_retain ? 0x20 : 0);
+    }
+    if (client->username[0] != '\0') {
+        flags |= 0x80;
+    }
+    if (client->password[0] != '\0') {
+        flags |= 0x40;
+    }
+    body[pos++] = flags;
+    body[pos++] = (uint8_t)(client->keepalive_s >> 8);
+    body[pos++] = (uint8_t)client->keepalive_s;
+    pos += put_str(body + pos, client->client_id, strlen(client->client_id));
+    if (flags & 0x04) {
+        pos += put_str(body + pos, client->will_topic, strlen(client->will_topic));
+        pos += put_str(body + pos, client->will_msg, strlen(client->will_msg));
+    }
+    if (flags & 0x80) {
+        pos += put_str(body + pos, client->username, strlen(client->username));
+    }
+    if (flags & 0x40) {
+        pos += put_str(body + pos, client->password, strlen(client->password));
+    }
+
+    size_t len;
+    uint8_t *packet = build_packet(PKT_CONNECT << 4, body, pos, &len);
+    bool ok = packet != NULL && send(fd, packet, len, MSG_NOSIGNAL) == (ssize_t)len;
+    free(packet);
+
+    int type = ok ? read_packet(client, fd, &len) : -1;
+    if (type < 0 || (type >> 4) != PKT_CONNACK || len != 2) {
+        close(fd);
+        return -1;
+    }
+    if (client->rx[1] != 0) {
+        *error = MQTT_ERROR_TYPE_CONNECTION_REFUSED;
+        close(fd);
+        return -1;
+    }
+    *session_present = client->rx[0] & 0x01;
+    return fd;
+}
+
+/**
+ * @brief 收到 PUBLISH：按接收缓冲大小分成 DATA 事件，QoS 1 在处理后确认
+ */
+static bool handle_publish(esp_mqtt_client_handle_t client, uint8_t flags, size_t len) {
+    uint8_t *p = client->rx;
+    if (len < 2) {
+        return false;
+    }
+    size_t topic_len = ((size_t)p[0] << 8) | p[1];
+    int qos = (flags >> 1) & 0x03;
+    size_t pos = 2 + topic_len + (qos > 0 ? 2 : 0);
+    if (pos > len) {
+        return false;
+    }
+    int msg_id = (qos > 0) ? ((p[2 + topic_len] << 8) | p[3 + topic_len]) : 0;
+    size_t total = len - pos;
+
+    // 第一个事件与主题共用缓冲区
+    size_t first_cap = 1;
+    if ((size_t)client->buffer_size > topic_len + 7) {
+        first_cap = (size_t)client->buffer_size - topic_len - 7;
+    }
+    size_t offset = 0;
+    do {
+        size_t cap = (offset == 0) ? first_cap : (size_t)client->buffer_size;
+        size_t chunk = (total - offset < cap) ? total - offset : cap;
+        esp_mqtt_event_t event = {
+            .event_id = MQTT_EVENT_DATA,
+            .data = (char *)p + pos + offset,
+            .data_len = (int)chunk,
+            .total_data_len = (int)total,
+            .current_data_offset = (int)offset,
+            .topic = (offset == 0) ? (char *)p + 2 : NULL,
+            .topic_len = (offset == 0) ? (int)topic_len : 0,
+            .msg_id = msg_id,
+            .qos = qos,
+            .retain = (flags & 0x01) != 0,
+        };
+        dispatch(client, &event);
+        offset += chunk;
+    } while (offset < total);
+
+    if (qos > 0) {
+        uint8_t ack[4] = {PKT_PUBACK << 4, 2, (uint8_t)(msg_id >> 8), (uint8_t)msg_id};
+        pthread_mutex_lock(&client->lock);
+        send_locked(client, ack, sizeof(ack));
+        pthread_mutex_unlock(&client->lock);
+    }
+    return true;
+}
+
+/**
+ * @brief 连接建立后的收发循环，连接断开或停止时返回
+ */
+static void run_session(esp_mqtt_client_handle_t client, int fd) {
+    while (atomic_load(&client->running)) {
+        struct pollfd pfd = {.fd = fd, .events = POLLIN};
+        int n = poll(&pfd, 1, HOST_MQTT_POLL_MS);
+        if (n < 0 && errno != EINTR) {
+            return;
+        }
+        if (n > 0) {
+            size_t len;
+            int type = read_packet(client, fd, &len);
+            if (type < 0) {
+                return;
+            }
+            int msg_id = (len >= 2) ? ((client->rx[0] << 8) | client->rx[1]) : 0;
+            switch (type >> 4) {
+            case PKT_PUBLISH:
+                if (!handle_publish(client, (uint8_t)(type & 0x0F), len)) {
+                    return;
+                }
+                break;
+            case PKT_PUBACK:
+                pthread_mutex_lock(&client->lock);
+                outbox_remove_locked(client, msg_id, false);
+                pthread_mutex_unlock(&client->lock);
+                dispatch_simple(client, MQTT_EVENT_PUBLISHED, msg_id);
+                break;
+            case PKT_SUBACK:
+                dispatch_simple(client, MQTT_EVENT_SUBSCRIBED, msg_id);
+                break;
+            case PKT_UNSUBACK:
+                dispatch_simple(client, MQTT_EVENT_UNSUBSCRIBED, msg_id);
+                break;
+            default:
+                break;
+            }
+        }
+
+        pthread_mutex_lock(&client->lock);
+        outbox_flush_locked(client);
+        if (esp_timer_get_time() - client->last_tx_us >= client->keepalive_s * 1000000LL) {
+            uint8_t ping[2] = {PKT_PINGREQ << 4, 0};
+            send_locked(client, ping, sizeof(ping));
+        }
+        pthread_mutex_unlock(&client->lock);
+    }
+}
+
+/**
+ * @brief 客户端线程（相当于 esp-mqtt 的 MQTT 任务）
+ */
+static void *client_task(void *arg) {
+    esp_mqtt_client_handle_t client = arg;
+
+    while (atomic_load(&client->running)) {
+        dispatch_simple(client, MQTT_EVENT_BEFORE_CONNECT, 0);
+
+        int session_present = 0;
+        esp_mqtt_error_type_t error;
+        int fd = open_session(client, &session_present, &error);
+        if (fd >= 0) {
+            pthread_mutex_lock(&client->lock);
+            client->fd = fd;
+            client->connected = true;
+            client->last_tx_us = esp_timer_get_time();
+            // 重连后重发未确认的消息
+            for (outbox_msg_t *msg = client->outbox; msg != NULL; msg = msg->next) {
+                msg->sent = false;
+            }
+            pthread_mutex_unlock(&client->lock);
+
+            esp_mqtt_event_t event = {.event_id = MQTT_EVENT_CONNECTED,
+                                      .session_present = session_present};
+            dispatch(client, &event);
+
+            run_session(client, fd);
+
+            pthread_mutex_lock(&client->lock);
+            client->connected = false;
+            client->fd = -1;
+            close(fd);
+            pthread_mutex_unlock(&client->lock);
+            if (atomic_load(&client->running)) {
+                dispatch_simple(client, MQTT_EVENT_DISCONNECTED, 0);
+            }
+        } else if (atomic_load(&client->running)) {
+            esp_mqtt_error_codes_t codes = {.error_type = error};
+            esp_mqtt_event_t event = {.event_id = MQTT_EVENT_ERROR, .error_handle = &codes};
+            dispatch(client, &event);
+        }
+
+        int64_t retry_at = esp_timer_get_time() + client->reconnect_ms * 1000LL;
+        while (atomic_load(&client->running) && !atomic_load(&client->reconnect_now) &&
+               esp_timer_get_time() < retry_at) {
+            usleep(HOST_MQTT_POLL_MS * 1000);
+        }
+        atomic_store(&client->reconnect_now, false);
+    }
+    return NULL;
+}
+
+static void copy_str(char *dst, size_t size, const char *src) {
+    snprintf(dst, size, "%s", (src != NULL) ? src : "");
+}
+
+// ============================================================================
+// 公共 API
+// ============================================================================
+
+esp_mqtt_client_handle_t esp_mqtt_client_init(const esp_mqtt_client_config_t *config) {
+    const char *uri = config->broker.address.uri;
+    if (uri == NULL || strncmp(uri, "mqtt://", 7) != 0) {
+        ESP_LOGE(TAG, "Unsupported URI: %s", uri ? uri : "(null)");
+        return NULL;
+    }
+    esp_mqtt_client_handle_t client = calloc(1, sizeof(struct esp_mqtt_client));
+    if (client == NULL) {
+        return NULL;
+    }
+
+    const char *host = uri + 7;
+    const char *colon = strchr(host, ':');
+    size_t host_len = colon ? (size_t)(colon - host) : strcspn(host, "/");
+    if (host_len >= sizeof(client->host)) {
+        free(client);
+        return NULL;
+    }
+    memcpy(client->host, host, host_len);
+    snprintf(client->port, sizeof(client->port), "%d", colon ? atoi(colon + 1) : 1883);
+
+    copy_str(client->client_id, sizeof(client->client_id), config->credentials.client_id);
+    copy_str(client->username, sizeof(client->username), config->credentials.username);
+    copy_str(client->password, sizeof(client->password),
+             config->credentials.authentication.password);
+    copy_str(client->will_topic, sizeof(client->will_topic), config->session.last_will.topic);
+    copy_str(client->will_msg, sizeof(client->will_msg), config->session.last_will.msg);
+    client->will_qos = config->session.last_will.qos;
+    client->will_retain = config->session.last_will.retain != 0;
+    client->clean_session = !config->session.disable_clean_session;
+    client->keepalive_s = config->session.keepalive > 0 ? config->session.keepalive : 120;
+    client->reconnect_ms =
+        config->network.reconnect_timeout_ms > 0 ? config->network.reconnect_timeout_ms : 10000;
+    client->buffer_size = config->buffer.size > 0 ? config->buffer.size : 1024;
+    client->outbox_limit = config->outbox.limit;
+    client->fd = -1;
+    pthread_mutex_init(&client->lock, NULL);
+    return client;
+}
+
+esp_err_t esp_mqtt_client_register_event(esp_mqtt_client_handle_t client,
+                                         esp_mqtt_event_id_t event, esp_event_handler_t handler,
+                                         void *arg) {
+    if (client == NULL || event != MQTT_EVENT_ANY) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    client->handler = handler;
+    client->handler_arg = arg;
+    return ESP_OK;
+}
+
+esp_err_t esp_mqtt_client_start(esp_mqtt_client_handle_t client) {
+    if (client == NULL || client->started) {
+        return ESP_FAIL;
+    }
+    atomic_store(&client->running, true);
+    if (pthread_create(&client->thread, NULL, client_task, client) != 0) {
+        atomic_store(&client->running, false);
+        return ESP_FAIL;
+    }
+    client->started = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_mqtt_client_reconnect(esp_mqtt_client_handle_t client) {
+    if (client == NULL || !client->started) {
+        return ESP_FAIL;
+    }
+    atomic_store(&client->reconnect_now, true);
+    return ESP_OK;
+}
+
+esp_err_t esp_mqtt_client_stop(esp_mqtt_client_handle_t client) {
+    if (client == NULL || !client->started) {
+        return ESP_FAIL;
+    }
+    atomic_store(&client->running, false);
+    pthread_mutex_lock(&client->lock);
+    if (client->connected) {
+        uint8_t disconnect[2] = {PKT_DISCONNECT << 4, 0};
+        send_locked(client, disconnect, sizeof(disconnect));
+        shutdown(client->fd, SHUT_RDWR);
+    }
+    pthread_mutex_unlock(&client->lock);
+    pthread_join(client->thread, NULL);
+    client->started = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_mqtt_client_destroy(esp_mqtt_client_handle_t client) {
+    if (client == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (client->started) {
+        esp_mqtt_client_stop(client);
+    }
+    pthread_mutex_lock(&client->lock);
+    while (client->outbox != NULL) {
+        outbox_remove_locked(client, client->outbox->msg_id, false);
+    }
+    pthread_mutex_unlock(&client->lock);
+    pthread_mutex_destroy(&client->lock);
+    free(client->rx);
+    free(client);
+    return ESP_OK;
+}
+
+int esp_mqtt_client_subscribe(esp_mqtt_client_handle_t client, const char *topic, int qos) {
+    if (client == NULL || topic == NULL) {
+        return -1;
+    }
+    uint8_t body[260];
+    size_t topic_len = strlen(topic);
+    if (topic_len > sizeof(body) - 5) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&client->lock);
+    int msg_id = -1;
+    if (client->connected) {
+        msg_id = next_id_locked(client);
+        body[0] = (uint8_t)(msg_id >> 8);
+        body[1] = (uint8_t)msg_id;
+        size_t pos = 2 + put_str(body + 2, topic, topic_len);
+        body[pos++] = (uint8_t)qos;
+        size_t len;
+        uint8_t *packet = build_packet((PKT_SUBSCRIBE << 4) | 0x02, body, pos, &len);
+        if (packet == NULL || !send_locked(client, packet, len)) {
+            msg_id = -1;
+        }
+        free(packet);
+    }
+    pthread_mutex_unlock(&client->lock);
+    return msg_id;
+}
+
+int esp_mqtt_client_unsubscribe(esp_mqtt_client_handle_t client, const char *topic) {
+    if (client == NULL || topic == NULL) {
+        return -1;
+    }
+    uint8_t body[260];
+    size_t topic_len = strlen(topic);
+    if (topic_len > sizeof(body) - 4) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&client->lock);
+    int msg_id = -1;
+    if (client->connected) {
+        msg_id = next_id_locked(client);
+        body[0] = (uint8_t)(msg_id >> 8);
+        body[1] = (uint8_t)msg_id;
+        size_t pos = 2 + put_str(body + 2, topic, topic_len);
+        size_t len;
+        uint8_t *packet = build_packet((PKT_UNSUBSCRIBE << 4) | 0x02, body, pos, &len);
+        if (packet == NULL || !send_locked(client, packet, len)) {
+            msg_id = -1;
+        }
+        free(packet);
+    }
+    pthread_mutex_unlock(&client->lock);
+    return msg_id;
+}
+
+int esp_mqtt_client_publish(esp_mqtt_client_handle_t client, const char *topic, const char *data,
+                            int len, int qos, int retain) {
+    if (client == NULL || topic == NULL) {
+        return -1;
+    }
+    qos = (qos > 0) ? 1 : 0;
+
+    pthread_mutex_lock(&client->lock);
+    int msg_id = -1;
+    if (client->connected || qos > 0) {
+        size_t packet_len;
+        uint8_t *packet =
+            build_publish(client, topic, data, len, qos, retain, &msg_id, &packet_len);
+        if (packet == NULL) {
+            msg_id = -1;
+        } else if (!client->connected) {
+            // 离线时 QoS 1 的消息留在 outbox，连接后发送
+            if (!outbox_add_locked(client, packet, packet_len, msg_id, qos, false)) {
+                msg_id = -2;
+            }
+        } else if (!send_locked(client, packet, packet_len)) {
+            msg_id = -1;
+        } else if (qos > 0 && !outbox_add_locked(client, packet, packet_len, msg_id, qos, true)) {
+            msg_id = -2;
+        }
+        free(packet);
+    }
+    pthread_mutex_unlock(&client->lock);
+    return msg_id;
+}
+
+int esp_mqtt_client_enqueue(esp_mqtt_client_handle_t client, const char *topic, const char *data,
+                            int len, int qos, int retain, bool store) {
+    if (client == NULL || topic == NULL) {
+        return -1;
+    }
+    qos = (qos > 0) ? 1 : 0;
+    if (qos == 0 && !store) {
+        return esp_mqtt_client_publish(client, topic, data, len, qos, retain);
+    }
+
+    pthread_mutex_lock(&client->lock);
+    int msg_id = -1;
+    size_t packet_len;
+    uint8_t *packet = build_publish(client, topic, data, len, qos, retain, &msg_id, &packet_len);
+    if (packet != NULL && !outbox_add_locked(client, packet, packet_len, msg_id, qos, false)) {
+        msg_id = -2;
+    } else if (packet == NULL) {
+        msg_id = -1;
+    }
+    free(packet);
+    pthread_mutex_unlock(&client->lock);
+    return msg_id;
+}
@@ -0,0 +1,13 @@
+/**
+ * @file lvgl.h
+ * @brief 主机测试用的 LVGL 定时器桩，lv_timer_create() 由各测试实现
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct host_lv_timer lv_timer_t;
+typedef void (*lv_timer_cb_t)(lv_timer_t *timer);
+
+lv_timer_t *lv_timer_create(lv_timer_cb_t cb, uint32_t period, void *user_data);
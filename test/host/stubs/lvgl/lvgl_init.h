@@ -0,0 +1,13 @@
+/**
+ * @file lvgl_init.h
+ * @brief 主机测试用的 LVGL 入口桩：只提供 LVGL 互斥锁，由各测试实现
+ *
+ * 放在单独的目录中，只加入需要它的测试的包含路径，其他测试仍使用 main/include 中的头文件。
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+SemaphoreHandle_t lvgl_get_mutex(void);
@@ -0,0 +1,197 @@
+/**
+ * @file rtos.c
+ * @brief 主机测试用的 FreeRTOS 互斥锁与队列，每个线程相当于一个任务
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+struct host_sem {
+    pthread_mutex_t mutex;
+    _Atomic(TaskHandle_t) holder; ///< 持有者，供 xSemaphoreGetMutexHolder() 查询
+    int depth;                    ///< 递归加锁层数，只由持有者修改
+};
+
+struct host_queue {
+    pthread_mutex_t mutex;
+    pthread_cond_t changed; ///< 入队或出队后广播
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t head; ///< 队首元素的下标
+    UBaseType_t count;
+    uint8_t items[];
+};
+
+/**
+ * @brief 把等待的 tick 数换算为绝对时间（1 tick = 1 ms）
+ */
+static struct timespec deadline_after(TickType_t ticks) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += ticks / 1000;
+    deadline.tv_nsec += (long)(ticks % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+    return deadline;
+}
+
+static SemaphoreHandle_t create(bool recursive) {
+    SemaphoreHandle_t sem = calloc(1, sizeof(struct host_sem));
+    if (sem == NULL) {
+        return NULL;
+    }
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    if (recursive) {
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    }
+    pthread_mutex_init(&sem->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    return sem;
+}
+
+static BaseType_t take(SemaphoreHandle_t sem, TickType_t ticks) {
+    int err;
+    if (ticks == portMAX_DELAY) {
+        err = pthread_mutex_lock(&sem->mutex);
+    } else if (ticks == 0) {
+        err = pthread_mutex_trylock(&sem->mutex);
+    } else {
+        struct timespec deadline = deadline_after(ticks);
+        err = pthread_mutex_timedlock(&sem->mutex, &deadline);
+    }
+    if (err != 0) {
+        return pdFALSE;
+    }
+    if (sem->depth++ == 0) {
+        sem->holder = xTaskGetCurrentTaskHandle();
+    }
+    return pdTRUE;
+}
+
+static BaseType_t give(SemaphoreHandle_t sem) {
+    if (--sem->depth == 0) {
+        sem->holder = NULL;
+    }
+    return pthread_mutex_unlock(&sem->mutex) == 0 ? pdTRUE : pdFALSE;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    static __thread int self;
+    return &self;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) { return create(false); }
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void) { return create(true); }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) { return take(sem, ticks); }
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) { return give(sem); }
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticks) {
+    return take(sem, ticks);
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem) { return give(sem); }
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t sem) { return sem->holder; }
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) {
+    pthread_mutex_destroy(&sem->mutex);
+    free(sem);
+}
+
+/**
+ * @brief 等待条件成立（需持有队列锁），超时返回 false
+ */
+static bool queue_wait(QueueHandle_t queue, bool for_space, TickType_t ticks) {
+    struct timespec deadline = deadline_after(ticks);
+    while (for_space ? queue->count == queue->length : queue->count == 0) {
+        if (ticks == 0) {
+            return false;
+        }
+        if (ticks == portMAX_DELAY) {
+            pthread_cond_wait(&queue->changed, &queue->mutex);
+        } else if (pthread_cond_timedwait(&queue->changed, &queue->mutex, &deadline) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static BaseType_t queue_send(QueueHandle_t queue, const void *item, TickType_t ticks,
+                             bool to_front) {
+    pthread_mutex_lock(&queue->mutex);
+    if (!queue_wait(queue, true, ticks)) {
+        pthread_mutex_unlock(&queue->mutex);
+        return pdFALSE;
+    }
+    UBaseType_t slot;
+    if (to_front) {
+        queue->head = (queue->head + queue->length - 1) % queue->length;
+        slot = queue->head;
+    } else {
+        slot = (queue->head + queue->count) % queue->length;
+    }
+    memcpy(queue->items + (size_t)slot * queue->item_size, item, queue->item_size);
+    queue->count++;
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->mutex);
+    return pdTRUE;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    QueueHandle_t queue = calloc(1, sizeof(struct host_queue) + (size_t)length * item_size);
+    if (queue == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->changed, NULL);
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks) {
+    return queue_send(queue, item, ticks, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void *item, TickType_t ticks) {
+    return queue_send(queue, item, ticks, true);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks) {
+    pthread_mutex_lock(&queue->mutex);
+    if (!queue_wait(queue, false, ticks)) {
+        pthread_mutex_unlock(&queue->mutex);
+        return pdFALSE;
+    }
+    memcpy(item, queue->items + (size_t)queue->head * queue->item_size, queue->item_size);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->mutex);
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    pthread_mutex_lock(&queue->mutex);
+    UBaseType_t count = queue->count;
+    pthread_mutex_unlock(&queue->mutex);
+    return count;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    pthread_cond_destroy(&queue->changed);
+    pthread_mutex_destroy(&queue->mutex);
+    free(queue);
+}
@@ -0,0 +1,378 @@
+/**
+ * @file vars_stress.c
+ * @brief 界面变量存储的多线程压力测试
+ *
+ * 直接编译 vars.c，用 pthread 模拟各任务：
+ * - 多个写入方以提交为单位写入成组的变量（同一次提交中的值由同一个序号生成，字符串写满
+ *   整个容量），LVGL 读者每个 tick 调用 vars_sync 并检查 LVGL 副本，快照读者以 vars_read
+ *   检查发布副本，任何撕裂或跨提交的组合都会被发现；
+ * - LVGL 一侧写入从不等待写锁，写入后立即读到新值，之后发布给其他任务；
+ * - 写入结束后的下一个 tick 看到最后一次提交；
+ * - 写入方在提交中途长时间持有写锁时，LVGL 读者照常 tick，看不到未提交的赋值，LVGL 一侧
+ *   的写入被推迟，写锁释放后发布；
+ * - 统计与实际的提交次数一致。
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "lvgl_init.h"
+#include "vars.h"
+
+/** @brief 写入方数量 */
+#define STRESS_WRITERS 4
+/** @brief 每个写入方的提交数 */
+#define STRESS_COMMITS 50000
+/** @brief LVGL 读者每隔多少个 tick 写入一次 */
+#define STRESS_LVGL_WRITE_EVERY 97
+/** @brief 写入方在提交中途持有写锁的时长（毫秒） */
+#define STRESS_HOLD_MS 100
+
+static SemaphoreHandle_t s_lvgl_mutex;
+
+static atomic_bool s_running;
+static atomic_bool s_watch_uncommitted;
+static atomic_bool s_saw_uncommitted;
+static atomic_long s_ticks;
+static long s_renders;
+static long s_lvgl_writes;
+static long s_lvgl_deferred;
+static char s_lvgl_last[32];
+static double s_max_sync_ns;
+static double s_max_lvgl_wait_ns;
+static long s_snapshots;
+static long s_snapshot_retries;
+static atomic_int s_failed_checks;
+
+SemaphoreHandle_t lvgl_get_mutex(void) { return s_lvgl_mutex; }
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void fail(const char *what) {
+    printf("FAIL: %s\n", what);
+    atomic_fetch_add(&s_failed_checks, 1);
+}
+
+// ============================================================================
+// 变量组
+// ============================================================================
+
+/**
+ * @brief 生成序号 k 对应的字符串：前缀、序号，之后用同一个字母填满整个容量
+ */
+static void fill(char *buf, const char *tag, int k) {
+    int n = snprintf(buf, VARS_STR_MAX, "%s%d:", tag, k);
+    while (n < VARS_STR_MAX - 1) {
+        buf[n++] = (char)('a' + k % 26);
+    }
+    buf[n] = 0;
+}
+
+/**
+ * @brief 解析 fill 生成的字符串
+ *
+ * @return 序号，内容不完整时为负数
+ */
+static int parse(const char *str, const char *tag) {
+    size_t len = strlen(tag);
+    if (strncmp(str, tag, len) != 0 || strlen(str) != VARS_STR_MAX - 1) {
+        return -1;
+    }
+    int k = atoi(str + len);
+    const char *c = strchr(str, ':');
+    if (c == NULL) {
+        return -1;
+    }
+    for (c++; *c != 0; c++) {
+        if (*c != 'a' + k % 26) {
+            return -1;
+        }
+    }
+    return k;
+}
+
+/**
+ * @brief 检查一组变量来自同一次提交
+ *
+ * @return 提交的序号，初始状态为 0，不一致时为 -1
+ */
+static int check_group(const char *temp, const char *text, const char *location,
+                       int32_t humidity, int32_t cloud) {
+    if (temp[0] == 0 && text[0] == 0 && location[0] == 0 && humidity == 0 && cloud == 0) {
+        return 0;
+    }
+    int a = parse(temp, "T");
+    int b = parse(text, "X");
+    int c = parse(location, "L");
+    if (a < 0 || a != b || b != c || humidity != a || cloud != -a) {
+        printf("FAIL: inconsistent group (temp %d, text %d, location %d, humidity %d, "
+               "cloud %d)\n",
+               a, b, c, (int)humidity, (int)cloud);
+        atomic_fetch_add(&s_failed_checks, 1);
+        return -1;
+    }
+    return a;
+}
+
+static int check_view(void) {
+    return check_group(get_var_weather_temp(), get_var_weather_text(),
+                       get_var_weather_location(), get_var_weather_humidity(),
+                       get_var_weather_cloud());
+}
+
+/**
+ * @brief 在一次提交中写入序号 k 对应的一组变量
+ */
+static void write_group(int k) {
+    char buf[VARS_STR_MAX];
+    fill(buf, "T", k);
+    set_var_weather_temp(buf);
+    fill(buf, "X", k);
+    set_var_weather_text(buf);
+    set_var_weather_humidity(k);
+    fill(buf, "L", k);
+    set_var_weather_location(buf);
+    set_var_weather_cloud(-k);
+}
+
+// ============================================================================
+// 线程
+// ============================================================================
+
+static void *writer(void *arg) {
+    int w = (int)(long)arg;
+    for (int i = 0; i < STRESS_COMMITS; i++) {
+        if (vars_begin() != ESP_OK) {
+            fail("writer outside LVGL must not time out");
+            continue;
+        }
+        write_group(i * STRESS_WRITERS + w + 1);
+        vars_commit();
+    }
+    return NULL;
+}
+
+/**
+ * @brief LVGL 一侧写入：必须立即读到新值，写锁被占用时计入 lvgl_deferred
+ *
+ * 每次写入的值都不同。
+ */
+static void lvgl_write(long tick) {
+    char value[32];
+    snprintf(value, sizeof(value), "tick %ld", tick);
+
+    vars_stats_t before;
+    vars_get_stats(&before);
+    double start_ns = now_ns();
+    set_var_yiyan(value);
+    double wait_ns = now_ns() - start_ns;
+    if (wait_ns > s_max_lvgl_wait_ns) {
+        s_max_lvgl_wait_ns = wait_ns;
+    }
+
+    vars_stats_t after;
+    vars_get_stats(&after);
+    s_lvgl_writes++;
+    s_lvgl_deferred += after.lvgl_deferred - before.lvgl_deferred;
+    if (strcmp(get_var_yiyan(), value) != 0) {
+        fail("LVGL-side write not visible to get_var_*");
+    }
+    strcpy(s_lvgl_last, value);
+}
+
+static void *lvgl_reader(void *arg) {
+    (void)arg;
+    vars_watch_t watch = {0};
+    while (atomic_load(&s_running)) {
+        xSemaphoreTake(s_lvgl_mutex, portMAX_DELAY);
+        double start_ns = now_ns();
+        vars_sync();
+        double sync_ns = now_ns() - start_ns;
+        if (sync_ns > s_max_sync_ns) {
+            s_max_sync_ns = sync_ns;
+        }
+
+        long tick = atomic_fetch_add(&s_ticks, 1) + 1;
+        if (vars_watch_poll(&watch) != 0) {
+            s_renders++;
+            check_view();
+        }
+        if (atomic_load(&s_watch_uncommitted) && strncmp(get_var_weather_temp(), "T1:", 3) == 0) {
+            atomic_store(&s_saw_uncommitted, true);
+        }
+        if (tick % STRESS_LVGL_WRITE_EVERY == 0) {
+            lvgl_write(tick);
+        }
+        xSemaphoreGive(s_lvgl_mutex);
+    }
+    return NULL;
+}
+
+static void *snapshot_reader(void *arg) {
+    (void)arg;
+    static vars_snapshot_t snapshot;
+    while (atomic_load(&s_running)) {
+        if (!vars_read(&snapshot)) {
+            s_snapshot_retries++;
+            continue;
+        }
+        s_snapshots++;
+        check_group(snapshot.weather_temp, snapshot.weather_text, snapshot.weather_location,
+                    snapshot.weather_humidity, snapshot.weather_cloud);
+    }
+    return NULL;
+}
+
+// ============================================================================
+// 场景
+// ============================================================================
+
+/**
+ * @brief 多个写入方并发提交，两种读者检查一致性
+ */
+static void run_concurrent(void) {
+    pthread_t writers[STRESS_WRITERS];
+    pthread_t lvgl;
+    pthread_t snap;
+
+    atomic_store(&s_running, true);
+    atomic_store(&s_watch_uncommitted, false);
+    pthread_create(&lvgl, NULL, lvgl_reader, NULL);
+    pthread_create(&snap, NULL, snapshot_reader, NULL);
+
+    double start_ns = now_ns();
+    for (int i = 0; i < STRESS_WRITERS; i++) {
+        pthread_create(&writers[i], NULL, writer, (void *)(long)i);
+    }
+    for (int i = 0; i < STRESS_WRITERS; i++) {
+        pthread_join(writers[i], NULL);
+    }
+    double elapsed_s = (now_ns() - start_ns) / 1e9;
+
+    usleep(1000);
+    atomic_store(&s_running, false);
+    pthread_join(lvgl, NULL);
+    pthread_join(snap, NULL);
+
+    // 写入结束后的下一个 tick 必须看到某个写入方的最后一次提交
+    xSemaphoreTake(s_lvgl_mutex, portMAX_DELAY);
+    vars_sync();
+    int last = check_view();
+    xSemaphoreGive(s_lvgl_mutex);
+    if (last <= (STRESS_COMMITS - 1) * STRESS_WRITERS) {
+        printf("FAIL: last tick shows commit %d, not a final one\n", last);
+        atomic_fetch_add(&s_failed_checks, 1);
+    }
+
+    printf("%d writers x %d commits in %.2f s; last visible commit %d\n", STRESS_WRITERS,
+           STRESS_COMMITS, elapsed_s, last);
+}
+
+/**
+ * @brief 写入方在提交中途持有写锁：LVGL 照常 tick、看不到未提交的赋值，LVGL 一侧的写入推迟发布
+ */
+static void run_held_lock(void) {
+    pthread_t lvgl;
+
+    atomic_store(&s_running, true);
+    atomic_store(&s_watch_uncommitted, true);
+    pthread_create(&lvgl, NULL, lvgl_reader, NULL);
+    usleep(10000);
+
+    long deferred_before = s_lvgl_deferred;
+
+    if (vars_begin() != ESP_OK) {
+        fail("vars_begin outside LVGL failed");
+        return;
+    }
+    write_group(1);
+    long ticks_before = atomic_load(&s_ticks);
+    usleep(STRESS_HOLD_MS * 1000);
+    long held_ticks = atomic_load(&s_ticks) - ticks_before;
+    bool saw_uncommitted = atomic_load(&s_saw_uncommitted);
+    vars_commit();
+
+    usleep(10000);
+    atomic_store(&s_running, false);
+    pthread_join(lvgl, NULL);
+
+    // 写锁释放后的 tick 发布推迟的赋值，其他任务读到 LVGL 一侧的最后一次写入
+    static vars_snapshot_t snapshot;
+    bool published = vars_read(&snapshot) && strcmp(snapshot.yiyan, s_lvgl_last) == 0;
+
+    printf("writer held the lock %d ms: lvgl ticked %ld times, %ld LVGL-side commits deferred, "
+           "uncommitted value visible: %s, deferred writes published: %s\n",
+           STRESS_HOLD_MS, held_ticks, s_lvgl_deferred - deferred_before,
+           saw_uncommitted ? "yes" : "no", published ? "yes" : "no");
+
+    if (held_ticks < STRESS_LVGL_WRITE_EVERY) {
+        fail("LVGL task stalled behind the write lock");
+    }
+    if (saw_uncommitted) {
+        fail("uncommitted assignment visible to LVGL");
+    }
+    if (s_lvgl_deferred == deferred_before) {
+        fail("LVGL-side write was not deferred while the lock was held");
+    }
+    if (!published) {
+        fail("deferred LVGL-side write not published after the lock was released");
+    }
+    if (s_max_lvgl_wait_ns > STRESS_HOLD_MS * 1e6 / 2) {
+        printf("FAIL: LVGL-side write waited %.1f ms for the write lock\n",
+               s_max_lvgl_wait_ns / 1e6);
+        atomic_fetch_add(&s_failed_checks, 1);
+    }
+}
+
+int main(void) {
+    s_lvgl_mutex = xSemaphoreCreateMutex();
+    if (s_lvgl_mutex == NULL || vars_init() != ESP_OK) {
+        printf("FAIL: init\n");
+        return 1;
+    }
+
+    run_concurrent();
+    run_held_lock();
+
+    vars_stats_t stats;
+    vars_get_stats(&stats);
+    printf("lvgl: %ld ticks, %ld with changes, max vars_sync %.0f ns, max LVGL-side write "
+           "%.1f ms; snapshots: %ld ok, %ld retried\n",
+           atomic_load(&s_ticks), s_renders, s_max_sync_ns, s_max_lvgl_wait_ns / 1e6,
+           s_snapshots, s_snapshot_retries);
+    printf("stats: commits %u, changes %u, view_syncs %u, view_deferred %u, read_failed %u, "
+           "lvgl_deferred %u\n",
+           stats.commits, stats.changes, stats.view_syncs, stats.view_deferred,
+           stats.read_failed, stats.lvgl_deferred);
+
+    // 写入方的每次提交与持锁场景的一次提交都有变化；LVGL 一侧推迟的写入可能合并为一次提交
+    long writer_commits = (long)STRESS_WRITERS * STRESS_COMMITS + 1;
+    long max_commits = writer_commits + s_lvgl_writes;
+    if ((long)stats.commits < writer_commits || (long)stats.commits > max_commits ||
+        (long)stats.lvgl_deferred != s_lvgl_deferred) {
+        printf("FAIL: stats do not match (commits %u, expected %ld..%ld, lvgl_deferred %u/%ld)\n",
+               stats.commits, writer_commits, max_commits, stats.lvgl_deferred,
+               s_lvgl_deferred);
+        atomic_fetch_add(&s_failed_checks, 1);
+    }
+    if (stats.view_syncs == 0 || stats.view_syncs > stats.commits) {
+        fail("view_syncs out of range");
+    }
+
+    int failed = atomic_load(&s_failed_checks);
+    if (failed != 0) {
+        printf("%d check(s) failed\n", failed);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
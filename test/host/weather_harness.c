@@ -0,0 +1,593 @@
+/**
+ * @file weather_harness.c
+ * @brief 天气服务的端到端测试：真实的服务代码对接 tools/mock_upstream.py
+ *
+ * 编译固件中的 weather.c、http_pool.c、http_cache.c、net_health.c、decompress.c、
+ * json_stream.c 与 json_bind.c，HTTP 客户端为 stubs/host_http_client.c（明文 HTTP/1.1）。
+ * 启动模拟服务器后逐个切换场景调用 get_weather_now() / get_weather_forecast()，检查：
+ * - 解析得到的结构体与录制响应一致（gzip、未压缩、分块、慢速传输）；
+ * - 重复请求走条件请求，304 时返回缓存结果且 updated 为 false，连接被复用；
+ * - 语法错误、截断、5xx、401 与接收超时返回错误，熔断器记录正确的失败分类；
+ * - 拨快时钟驱动熔断器：连续失败后熔断、退避翻倍至上限、半开只放行一个探测、
+ *   401/429 一次即熔断，熔断期间服务器收不到请求；
+ * - 每个场景的耗时与 heap_caps 峰值占用在预期范围内。
+ *
+ * 用法：weather_harness <python3> <tools/mock_upstream.py>
+ */
+
+#define _GNU_SOURCE
+
+#include <arpa/inet.h>
+#include <math.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "esp_heap_caps.h"
+#include "esp_http_client.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+
+#include "config_manager.h"
+#include "decompress.h"
+#include "http_cache.h"
+#include "http_pool.h"
+#include "ip_location.h"
+#include "metrics.h"
+#include "net_health.h"
+#include "weather.h"
+#include "wifi.h"
+
+/** @brief 模拟服务器 slow 场景的总耗时（秒） */
+#define HARNESS_SLOW_SECONDS 1
+/** @brief 正常场景单次请求的耗时上限（回环地址） */
+#define HARNESS_FAST_MAX_MS 500
+/** @brief 单次请求的 heap_caps 峰值上限：zlib 窗口 32 KB 与状态约 7 KB，其余为请求上下文 */
+#define HARNESS_PEAK_HEAP_MAX (56 * 1024)
+
+static char s_api_host[64];
+static int s_failed_checks;
+static int64_t s_clock_skew_us;
+
+// ============================================================================
+// 桩
+// ============================================================================
+
+/**
+ * @brief 单调时钟加上测试拨快的时间，熔断器的退避不必真的等待
+ */
+int64_t esp_timer_get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 + s_clock_skew_us;
+}
+
+uint32_t esp_random(void) { return (uint32_t)rand(); }
+
+void config_manager_get_config(sys_config_t *config) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->weather.api_host, sizeof(config->weather.api_host), "%s", s_api_host);
+    snprintf(config->weather.api_key, sizeof(config->weather.api_key), "mock");
+}
+
+void metrics_observe(metric_id_t id, uint8_t index, int64_t us) {}
+
+void wifi_note_first_byte(void) {}
+
+// ============================================================================
+// 模拟服务器
+// ============================================================================
+
+static int free_port(void) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    socklen_t len = sizeof(addr);
+    if (bind(fd, (struct sockaddr *)&addr, len) != 0 ||
+        getsockname(fd, (struct sockaddr *)&addr, &len) != 0) {
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    return ntohs(addr.sin_port);
+}
+
+/**
+ * @brief 控制请求的响应体
+ */
+typedef struct {
+    char text[1024];
+    size_t len;
+} mock_body_t;
+
+static esp_err_t mock_body_handler(esp_http_client_event_t *evt) {
+    mock_body_t *body = evt->user_data;
+    if (evt->event_id == HTTP_EVENT_ON_DATA && body != NULL) {
+        size_t n = (size_t)evt->data_len;
+        if (n > sizeof(body->text) - 1 - body->len) {
+            n = sizeof(body->text) - 1 - body->len;
+        }
+        memcpy(body->text + body->len, evt->data, n);
+        body->len += n;
+        body->text[body->len] = '\0';
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief 发起一次控制请求（切换场景、读取统计），返回状态码
+ *
+ * @param body 响应体输出，可为 NULL
+ */
+static int mock_get_body(const char *path, mock_body_t *body) {
+    char url[128];
+    snprintf(url, sizeof(url), "%s%s", s_api_host, path);
+    esp_http_client_config_t config = {
+        .url = url, .event_handler = mock_body_handler, .user_data = body};
+    esp_http_client_handle_t client = esp_http_client_init(&config);
+    if (client == NULL) {
+        return -1;
+    }
+    int status = -1;
+    if (esp_http_client_perform(client) == ESP_OK) {
+        status = esp_http_client_get_status_code(client);
+    }
+    esp_http_client_cleanup(client);
+    return status;
+}
+
+static int mock_get(const char *path) { return mock_get_body(path, NULL); }
+
+/**
+ * @brief 模拟服务器收到的天气请求数
+ */
+static int mock_weather_requests(void) {
+    mock_body_t body = {0};
+    if (mock_get_body("/_mock/stats", &body) != 200) {
+        return -1;
+    }
+    const char *weather = strstr(body.text, "\"weather\"");
+    const char *requests = weather ? strstr(weather, "\"requests\":") : NULL;
+    return requests ? atoi(requests + strlen("\"requests\":")) : -1;
+}
+
+static pid_t mock_start(const char *python, const char *script) {
+    int port = free_port();
+    if (port < 0) {
+        return -1;
+    }
+    snprintf(s_api_host, sizeof(s_api_host), "http://127.0.0.1:%d", port);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        char port_arg[16];
+        char slow_arg[16];
+        snprintf(port_arg, sizeof(port_arg), "%d", port);
+        snprintf(slow_arg, sizeof(slow_arg), "%d", HARNESS_SLOW_SECONDS);
+        freopen("/dev/null", "w", stderr);
+        execlp(python, python, script, "--host", "127.0.0.1", "--port", port_arg, "--max-age",
+               "0", "--slow-seconds", slow_arg, (char *)NULL);
+        _exit(127);
+    }
+
+    // 等待服务器开始监听
+    for (int i = 0; i < 100; i++) {
+        if (mock_get("/_mock/stats") == 200) {
+            return pid;
+        }
+        usleep(100 * 1000);
+    }
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+    return -1;
+}
+
+// ============================================================================
+// 检查
+// ============================================================================
+
+#define EXPECT(cond, ...)                                                                          \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s:%d: ", __func__, __LINE__);                                            \
+            printf(__VA_ARGS__);                                                                   \
+            printf("\n");                                                                          \
+            s_failed_checks++;                                                                     \
+        }                                                                                          \
+    } while (0)
+
+/**
+ * @brief 一次请求的结果
+ */
+typedef struct {
+    esp_err_t err;
+    bool updated;
+    double ms;
+    size_t peak;
+} run_t;
+
+static location_t make_location(int index) {
+    location_t loc = {0};
+    loc.longitude = 116.30f + index * 0.1f;
+    loc.latitude = 39.96f;
+    return loc;
+}
+
+/**
+ * @brief 切换场景但保留熔断器状态
+ */
+static void switch_scenario(const char *name) {
+    char path[64];
+    snprintf(path, sizeof(path), "/_mock/scenario?weather=%s", name);
+    EXPECT(mock_get(path) == 200, "switch scenario to %s", name);
+}
+
+static void scenario(const char *name) {
+    switch_scenario(name);
+    net_health_reset_all();
+}
+
+static run_t run_now(const char *name, int location, weather_now_t *now) {
+    location_t loc = make_location(location);
+    size_t base = host_heap_in_use();
+    host_heap_reset_peak();
+    int64_t start = esp_timer_get_time();
+
+    run_t r = {0};
+    r.err = get_weather_now(&loc, now, &r.updated);
+    r.ms = (esp_timer_get_time() - start) / 1000.0;
+    r.peak = host_heap_peak() - base;
+    printf("now       %-10s %-26s %8.1f ms  peak %6zu B%s\n", name, esp_err_to_name(r.err), r.ms,
+           r.peak, r.updated ? "" : "  (not updated)");
+    EXPECT(r.peak <= HARNESS_PEAK_HEAP_MAX, "%s: peak heap %zu B", name, r.peak);
+    return r;
+}
+
+static void expect_now(const char *name, const weather_now_t *now) {
+    struct tm tm = {
+        .tm_year = 2026 - 1900, .tm_mon = 0, .tm_mday = 15, .tm_hour = 10, .tm_min = 24};
+    EXPECT(fabsf(now->temperature - -2.0f) < 0.01f, "%s: temperature %.1f", name, now->temperature);
+    EXPECT(fabsf(now->feelslike - -7.0f) < 0.01f, "%s: feelslike %.1f", name, now->feelslike);
+    EXPECT(now->icon == 100, "%s: icon %u", name, now->icon);
+    EXPECT(strcmp(now->text, "晴") == 0, "%s: text '%s'", name, now->text);
+    EXPECT(strcmp(now->wind_dir, "西北风") == 0, "%s: wind_dir '%s'", name, now->wind_dir);
+    EXPECT(now->wind_scale == 3, "%s: wind_scale %u", name, now->wind_scale);
+    EXPECT(now->humidity == 23, "%s: humidity %u", name, now->humidity);
+    EXPECT(fabsf(now->pressure - 1027.0f) < 0.01f, "%s: pressure %.1f", name, now->pressure);
+    EXPECT(now->obs_time == timegm(&tm), "%s: obs_time %lld", name, (long long)now->obs_time);
+}
+
+static void expect_fail(const char *name, const run_t *r, net_fail_t fail, int status) {
+    net_health_info_t info;
+    net_health_get(NET_EP_WEATHER, &info);
+    EXPECT(r->err != ESP_OK, "%s: request succeeded", name);
+    EXPECT(info.last_fail == fail, "%s: classified as %s, expected %s", name,
+           net_health_fail_name(info.last_fail), net_health_fail_name(fail));
+    EXPECT(info.last_status == status, "%s: last status %d, expected %d", name, info.last_status,
+           status);
+}
+
+/**
+ * @brief 正常响应：gzip、未压缩、分块与慢速传输都应得到相同的结构体
+ */
+static void check_ok_scenarios(void) {
+    const char *names[] = {"ok", "plain", "chunked", "slow"};
+    for (int i = 0; i < 4; i++) {
+        weather_now_t now;
+        scenario(names[i]);
+        run_t r = run_now(names[i], i, &now);
+        EXPECT(r.err == ESP_OK && r.updated, "%s: %s", names[i], esp_err_to_name(r.err));
+        expect_now(names[i], &now);
+        if (strcmp(names[i], "slow") == 0) {
+            EXPECT(r.ms >= HARNESS_SLOW_SECONDS * 800, "slow: finished in %.1f ms", r.ms);
+        } else {
+            EXPECT(r.ms <= HARNESS_FAST_MAX_MS, "%s: took %.1f ms", names[i], r.ms);
+        }
+    }
+}
+
+/**
+ * @brief 重复请求：条件请求返回 304，结果来自缓存，连接被复用
+ */
+static void check_revalidation(void) {
+    http_cache_stats_t cache_before, cache_after;
+    http_pool_stats_t pool_before, pool_after;
+    http_cache_get_stats(&cache_before);
+    http_pool_get_stats(&pool_before);
+
+    weather_now_t now;
+    scenario("ok");
+    run_t r = run_now("304", 0, &now);
+    EXPECT(r.err == ESP_OK && !r.updated, "304: %s, updated %d", esp_err_to_name(r.err),
+           r.updated);
+    expect_now("304", &now);
+
+    http_cache_get_stats(&cache_after);
+    http_pool_get_stats(&pool_after);
+    EXPECT(cache_after.not_modified == cache_before.not_modified + 1, "304: not_modified %u -> %u",
+           cache_before.not_modified, cache_after.not_modified);
+    EXPECT(pool_after.reused == pool_before.reused + 1, "304: keep-alive connection not reused");
+
+    // 归还后的句柄按主机共享，条件请求头不能带到同一主机上其他 URL 的请求中
+    char url[128];
+    snprintf(url, sizeof(url), "%s/v7/weather/7d", s_api_host);
+    esp_http_client_handle_t client = http_pool_acquire(url, NULL, NULL);
+    EXPECT(client != NULL, "304: pooled client for %s", url);
+    if (client != NULL) {
+        char *etag = NULL;
+        char *since = NULL;
+        esp_http_client_get_header(client, "If-None-Match", &etag);
+        esp_http_client_get_header(client, "If-Modified-Since", &since);
+        EXPECT(etag == NULL && since == NULL, "304: conditional headers left on pooled client");
+        http_pool_release(client);
+    }
+}
+
+static void check_forecast(void) {
+    scenario("ok");
+    location_t loc = make_location(0);
+    weather_forecast_t forecast;
+    size_t base = host_heap_in_use();
+    host_heap_reset_peak();
+    int64_t start = esp_timer_get_time();
+    bool updated = false;
+    esp_err_t err = get_weather_forecast(&loc, 7, &forecast, &updated);
+    double ms = (esp_timer_get_time() - start) / 1000.0;
+    size_t peak = host_heap_peak() - base;
+    printf("forecast  %-10s %-26s %8.1f ms  peak %6zu B\n", "ok", esp_err_to_name(err), ms, peak);
+
+    EXPECT(err == ESP_OK && updated, "forecast: %s", esp_err_to_name(err));
+    EXPECT(forecast.count == 7, "forecast: %u days", forecast.count);
+    for (int i = 0; i < forecast.count && i < 7; i++) {
+        const weather_daily_t *d = &forecast.daily[i];
+        char date[11];
+        snprintf(date, sizeof(date), "2026-01-%02d", 15 + i);
+        EXPECT(strcmp(d->fx_date, date) == 0, "forecast[%d]: fx_date '%s'", i, d->fx_date);
+        EXPECT(d->temp_max == 3 + i % 5 && d->temp_min == -8, "forecast[%d]: %d/%d", i,
+               d->temp_max, d->temp_min);
+        EXPECT(strcmp(d->text_day, "晴") == 0 && strcmp(d->wind_dir_day, "西北风") == 0 &&
+                   strcmp(d->wind_scale_day, "3-4") == 0,
+               "forecast[%d]: '%s' '%s' '%s'", i, d->text_day, d->wind_dir_day,
+               d->wind_scale_day);
+        EXPECT(d->pressure == 1028 && d->uv_index == 2, "forecast[%d]: %u %u", i, d->pressure,
+               d->uv_index);
+    }
+    EXPECT(ms <= HARNESS_FAST_MAX_MS, "forecast: took %.1f ms", ms);
+    EXPECT(peak <= HARNESS_PEAK_HEAP_MAX, "forecast: peak heap %zu B", peak);
+}
+
+/**
+ * @brief 失败场景：返回错误并按原因分类，接收超时按客户端超时结束
+ */
+static void check_fail_scenarios(void) {
+    weather_now_t now;
+    run_t r;
+
+    scenario("malformed");
+    r = run_now("malformed", 10, &now);
+    expect_fail("malformed", &r, NET_FAIL_PARSE, 200);
+
+    scenario("truncated");
+    r = run_now("truncated", 11, &now);
+    expect_fail("truncated", &r, NET_FAIL_OTHER, 200);
+
+    scenario("5xx");
+    r = run_now("5xx", 12, &now);
+    expect_fail("5xx", &r, NET_FAIL_HTTP_5XX, 503);
+
+    scenario("401");
+    r = run_now("401", 13, &now);
+    expect_fail("401", &r, NET_FAIL_AUTH, 401);
+
+    scenario("stall");
+    r = run_now("stall", 14, &now);
+    expect_fail("stall", &r, NET_FAIL_TIMEOUT, 200);
+    EXPECT(r.ms >= 4000 && r.ms <= 7000, "stall: gave up after %.1f ms", r.ms);
+
+    // 失败后的下一次请求仍能正常完成（连接已重建）
+    scenario("ok");
+    r = run_now("recover", 15, &now);
+    EXPECT(r.err == ESP_OK, "recover: %s", esp_err_to_name(r.err));
+    expect_now("recover", &now);
+}
+
+// ============================================================================
+// 熔断器
+// ============================================================================
+
+static void advance_clock_ms(int64_t ms) { s_clock_skew_us += ms * 1000; }
+
+static esp_err_t breaker_request(net_health_info_t *info) {
+    location_t loc = make_location(20);
+    weather_now_t now;
+    bool updated = false;
+    esp_err_t err = get_weather_now(&loc, &now, &updated);
+    net_health_get(NET_EP_WEATHER, info);
+    return err;
+}
+
+/**
+ * @brief 拨快时钟越过当前退避时间，并检查退避时间带抖动
+ */
+static void expect_open_then_skip(const char *name, uint32_t backoff_ms) {
+    net_health_info_t info;
+    net_health_get(NET_EP_WEATHER, &info);
+    int64_t span = (int64_t)backoff_ms / 100 * NET_HEALTH_JITTER_PCT;
+    EXPECT(info.state == NET_HEALTH_OPEN, "%s: %s, expected open", name,
+           net_health_state_name(info.state));
+    EXPECT(info.backoff_ms == backoff_ms, "%s: backoff %u ms, expected %u ms", name,
+           info.backoff_ms, backoff_ms);
+    EXPECT(info.retry_in_ms >= backoff_ms - span - 1000 && info.retry_in_ms <= backoff_ms + span,
+           "%s: retry in %lld ms for a %u ms backoff", name, (long long)info.retry_in_ms,
+           backoff_ms);
+
+    // 熔断期间请求不发出，退避到期前一秒仍然熔断
+    int sent = mock_weather_requests();
+    uint32_t skipped = info.skipped;
+    advance_clock_ms(info.retry_in_ms - 1000);
+    esp_err_t err = breaker_request(&info);
+    EXPECT(err == ESP_ERR_NOT_ALLOWED, "%s: open circuit returned %s", name,
+           esp_err_to_name(err));
+    EXPECT(info.skipped == skipped + 1, "%s: skipped %u -> %u", name, skipped, info.skipped);
+    EXPECT(mock_weather_requests() == sent, "%s: request reached the server while open", name);
+
+    advance_clock_ms(info.retry_in_ms + 1);
+}
+
+/**
+ * @brief 探测请求：到达服务器，结果决定回到 CLOSED 还是以翻倍的退避重新 OPEN
+ */
+static esp_err_t probe(const char *name, net_health_info_t *info) {
+    int sent = mock_weather_requests();
+    esp_err_t err = breaker_request(info);
+    EXPECT(err != ESP_ERR_NOT_ALLOWED, "%s: probe not allowed", name);
+    EXPECT(mock_weather_requests() == sent + 1, "%s: probe did not reach the server", name);
+    return err;
+}
+
+/**
+ * @brief 熔断器在模拟时钟下走完 CLOSED → OPEN → HALF_OPEN → CLOSED
+ *
+ * 时钟只拨快不等待；每一步都对照服务器收到的请求数，确认熔断期间没有请求发出。
+ */
+static void check_breaker(void) {
+    net_health_info_t info;
+    esp_err_t err;
+
+    // 连续失败达到阈值前保持 CLOSED，达到后 OPEN
+    scenario("5xx");
+    net_health_get(NET_EP_WEATHER, &info);
+    uint32_t trips = info.trips;
+    for (int i = 1; i <= NET_HEALTH_FAIL_THRESHOLD; i++) {
+        err = breaker_request(&info);
+        EXPECT(err != ESP_OK && err != ESP_ERR_NOT_ALLOWED, "5xx #%d: %s", i, esp_err_to_name(err));
+        EXPECT(info.consecutive_failures == (uint32_t)i, "5xx #%d: %u consecutive failures", i,
+               info.consecutive_failures);
+        if (i < NET_HEALTH_FAIL_THRESHOLD) {
+            EXPECT(info.state == NET_HEALTH_CLOSED, "5xx #%d: %s before the threshold", i,
+                   net_health_state_name(info.state));
+        }
+    }
+    EXPECT(info.trips == trips + 1, "5xx: %u trips, expected %u", info.trips, trips + 1);
+
+    // 探测失败，退避时间每次翻倍，直到上限
+    uint32_t backoff = NET_HEALTH_BACKOFF_BASE_MS;
+    for (int round = 0; backoff < NET_HEALTH_BACKOFF_MAX_MS || round < 7; round++) {
+        char name[32];
+        snprintf(name, sizeof(name), "5xx backoff %d", round);
+        expect_open_then_skip(name, backoff);
+        probe(name, &info);
+        backoff = (backoff * 2 > NET_HEALTH_BACKOFF_MAX_MS) ? NET_HEALTH_BACKOFF_MAX_MS
+                                                            : backoff * 2;
+        EXPECT(info.last_fail == NET_FAIL_HTTP_5XX && info.last_status == 503,
+               "%s: last failure %s/%d", name, net_health_fail_name(info.last_fail),
+               info.last_status);
+    }
+    expect_open_then_skip("5xx capped", NET_HEALTH_BACKOFF_MAX_MS);
+
+    // 同一时间只放行一个探测请求；探测超时未报告时允许新的探测
+    EXPECT(net_health_allow(NET_EP_WEATHER), "half-open: first probe refused");
+    EXPECT(!net_health_allow(NET_EP_WEATHER), "half-open: second concurrent probe allowed");
+    advance_clock_ms(121 * 1000);
+    EXPECT(net_health_allow(NET_EP_WEATHER), "half-open: stuck probe never replaced");
+    net_health_report(NET_EP_WEATHER, NET_FAIL_TIMEOUT, 0);
+    expect_open_then_skip("probe timeout", NET_HEALTH_BACKOFF_MAX_MS);
+
+    // 探测成功：回到 CLOSED，退避与连续失败清零
+    switch_scenario("ok");
+    err = probe("recover", &info);
+    EXPECT(err == ESP_OK, "recover: %s", esp_err_to_name(err));
+    EXPECT(info.state == NET_HEALTH_CLOSED && info.backoff_ms == 0 &&
+               info.consecutive_failures == 0,
+           "recover: %s, backoff %u, %u consecutive failures", net_health_state_name(info.state),
+           info.backoff_ms, info.consecutive_failures);
+
+    // 401 与 429 一次即熔断，使用各自更长的首次退避，探测失败同样翻倍
+    const struct {
+        const char *scenario;
+        net_fail_t fail;
+        int status;
+        uint32_t backoff_ms;
+    } immediate[] = {
+        {"401", NET_FAIL_AUTH, 401, NET_HEALTH_BACKOFF_AUTH_MS},
+        {"429", NET_FAIL_RATE, 429, NET_HEALTH_BACKOFF_RATE_MS},
+    };
+    for (size_t i = 0; i < sizeof(immediate) / sizeof(immediate[0]); i++) {
+        const char *name = immediate[i].scenario;
+        switch_scenario(name);
+        trips = info.trips;
+        err = breaker_request(&info);
+        EXPECT(err != ESP_OK && err != ESP_ERR_NOT_ALLOWED, "%s: %s", name, esp_err_to_name(err));
+        EXPECT(info.trips == trips + 1 && info.consecutive_failures == 1,
+               "%s: %u trips after %u failure(s), expected an immediate trip", name, info.trips,
+               info.consecutive_failures);
+        EXPECT(info.last_fail == immediate[i].fail && info.last_status == immediate[i].status,
+               "%s: classified as %s/%d", name, net_health_fail_name(info.last_fail),
+               info.last_status);
+        expect_open_then_skip(name, immediate[i].backoff_ms);
+        probe(name, &info);
+        expect_open_then_skip(name, immediate[i].backoff_ms * 2);
+
+        switch_scenario("ok");
+        err = probe(name, &info);
+        EXPECT(err == ESP_OK && info.state == NET_HEALTH_CLOSED, "%s recover: %s, %s", name,
+               esp_err_to_name(err), net_health_state_name(info.state));
+    }
+    printf("breaker   %u trips, %u skipped, clock advanced %lld s\n", info.trips, info.skipped,
+           (long long)(s_clock_skew_us / 1000000));
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <python3> <mock_upstream.py>\n", argv[0]);
+        return 2;
+    }
+    // json_bind 按本地时间解析 obsTime
+    setenv("TZ", "UTC0", 1);
+    tzset();
+    signal(SIGPIPE, SIG_IGN);
+
+    pid_t mock = mock_start(argv[1], argv[2]);
+    if (mock < 0) {
+        printf("FAIL: mock upstream did not start\n");
+        return 1;
+    }
+
+    http_pool_init();
+    http_cache_init();
+    net_health_init();
+    decompress_init();
+
+    check_ok_scenarios();
+    check_revalidation();
+    check_forecast();
+    check_fail_scenarios();
+    check_breaker();
+
+    http_pool_stats_t pool;
+    http_cache_stats_t cache;
+    gzip_stats_t gzip;
+    http_pool_get_stats(&pool);
+    http_cache_get_stats(&cache);
+    gzip_get_stats(&gzip);
+    printf("pool: %u requests, %u connects, %u reused, %u stale retries\n", pool.requests,
+           pool.connects, pool.reused, pool.stale_retries);
+    printf("cache: %u stores, %u not modified; gzip: %llu -> %llu bytes\n", cache.stores,
+           cache.not_modified, (unsigned long long)gzip.total_in,
+           (unsigned long long)gzip.total_out);
+
+    kill(mock, SIGTERM);
+    waitpid(mock, NULL, 0);
+
+    if (s_failed_checks != 0) {
+        printf("%d check(s) failed\n", s_failed_checks);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""把 ui.c 中 LZ4 压缩的 EEZ 资源转换为可直接在 Flash 中使用的未压缩资源。
+
+用法：
+    python tools/eez_assets.py [--check] [main/src/ui/ui.c]
+
+EEZ Studio 生成的 assets 数组为压缩格式（HEADER_TAG_COMPRESSED），启动时 loadMainAssets
+需要从 LVGL 堆中分配约 5 KB 并解压。资源中的指针均为相对字段自身的偏移（AssetsPtr），
+解压后的数据与地址无关，因此可以在构建前生成一次：以 HEADER_TAG 开头、后接完整 Assets
+结构的常量数组放在 .rodata 中，loadMainAssets 识别 HEADER_TAG 后直接使用，不分配内存也
+不解压（全局变量的初值由 initGlobalVariables 复制到 RAM）。
+
+在 EEZ Studio 中修改并重新生成代码后运行本工具，更新同目录下的 assets_flat.c/.h。
+assets_flat.h 记录生成时 ui.c 中压缩资源的长度与 CRC32：固件构建时执行 --check，忘记更新
+时构建失败；lvgl_init.c 启动时再比对一次，不一致则退回解压 ui.c 中的资源。生成的 ui.c
+保持原样。
+--check：只比较现有的 assets_flat.c/.h 与 ui.c 是否一致，不一致时返回非零。
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+from eez_bindings import HEADER_TAG_COMPRESSED, lz4_block_decompress
+
+HEADER_TAG = 0x5A45457E
+
+C_TEMPLATE = """\
+/**
+ * @file assets_flat.c
+ * @brief 未压缩的 EEZ 资源，由 tools/eez_assets.py 根据 ui.c 生成，请勿手动修改
+ */
+
+#include "assets_flat.h"
+
+// AssetsPtr 为 int32 偏移，按 4 字节对齐以便直接按 Assets 结构访问
+const uint8_t assets_flat[{size}] __attribute__((aligned(4))) = {{
+{body}
+}};
+"""
+
+H_TEMPLATE = """\
+/**
+ * @file assets_flat.h
+ * @brief 未压缩的 EEZ 资源，由 tools/eez_assets.py 根据 ui.c 生成，请勿手动修改
+ *
+ * 格式为 HEADER_TAG 后接完整的 Assets 结构，loadMainAssets 直接在 Flash 中使用。
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/** @brief 生成时 ui.c 中压缩资源的长度与 CRC32，ui.c 重新生成后用于发现未同步更新的本文件 */
+#define UI_ASSETS_FLAT_SOURCE_SIZE {source_size}
+#define UI_ASSETS_FLAT_SOURCE_CRC32 0x{source_crc:08X}u
+
+extern const uint8_t assets_flat[{size}];
+"""
+
+
+def parse_array(path: str, name: str) -> bytes:
+    src = open(path, encoding="utf-8").read()
+    m = re.search(name + r"\[\d+\][^=]*=\s*\{(.*?)\};", src, re.S)
+    if not m:
+        sys.exit(f"{path} 中没有 {name} 数组")
+    return bytes(int(x, 0) for x in re.findall(r"0x[0-9A-Fa-f]+|\d+", m.group(1)))
+
+
+def flatten(raw: bytes) -> bytes:
+    tag, major, minor, assets_type, _, size = struct.unpack_from("<IBBBBI", raw)
+    if tag != HEADER_TAG_COMPRESSED:
+        sys.exit("只支持压缩格式的资源")
+    data = lz4_block_decompress(raw[12:], size)
+    # Assets 结构在 settings 之前为 projectMajorVersion、projectMinorVersion、assetsType、
+    # external 与 reserved，解压路径由 decompressAssetsData 填写，这里预先写好
+    prefix = struct.pack("<IBBBBI", HEADER_TAG, major, minor, assets_type, 0, 0)
+    return prefix + data
+
+
+def format_body(data: bytes) -> str:
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join(f"0x{b:02X}" for b in data[i : i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("ui_c", nargs="?", default="main/src/ui/ui.c")
+    parser.add_argument("--check", action="store_true", help="只检查 assets_flat.c 是否最新")
+    args = parser.parse_args()
+
+    raw = parse_array(args.ui_c, "assets")
+    flat = flatten(raw)
+    out_dir = os.path.dirname(args.ui_c)
+    c_path = os.path.join(out_dir, "assets_flat.c")
+    h_path = os.path.join(out_dir, "assets_flat.h")
+
+    c_text = C_TEMPLATE.format(size=len(flat), body=format_body(flat))
+    h_text = H_TEMPLATE.format(size=len(flat), source_size=len(raw), source_crc=zlib.crc32(raw))
+
+    if args.check:
+        for path, text in ((c_path, c_text), (h_path, h_text)):
+            current = open(path, encoding="utf-8").read() if os.path.exists(path) else ""
+            if current != text:
+                sys.exit(f"{path} 与 {args.ui_c} 不一致，请重新运行 tools/eez_assets.py")
+        print(f"{c_path} 已是最新")
+        return
+
+    with open(c_path, "w", encoding="utf-8", newline="\n") as f:
+        f.write(c_text)
+    with open(h_path, "w", encoding="utf-8", newline="\n") as f:
+        f.write(h_text)
+    print(f"压缩 {len(raw)} B -> 未压缩 {len(flat)} B（.rodata），启动时不再分配与解压")
+
+
+if __name__ == "__main__":
+    main()
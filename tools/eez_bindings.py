@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+"""根据 EEZ 资源生成各屏幕依赖的原生变量表 screen_deps.h。
+
+用法：
+    python tools/eez_bindings.py [--check] [--list] [main/src/ui/ui.c] [main/src/ui/vars.h]
+
+lvgl_init.c 每个 tick 只在当前屏幕依赖的变量变化时才执行生成的 tick_screen_*（见 vars.h
+中的 vars_watch_t），EEZ Studio 生成的 screens.c 保持原样。本工具解码 ui.c 中的 assets
+数组，收集每个屏幕流程中表达式引用的原生变量，写入 ui.c 同目录下的 screen_deps.h；
+用户控件（如状态栏）的依赖并入每个屏幕。表达式中若出现流程变量、局部变量、输入或输出，
+该屏幕的依赖记为 SCREEN_DEPS_ALWAYS，每个 tick 都执行。
+
+在 EEZ Studio 中修改并重新生成代码后运行本工具。
+--check：只比较现有的 screen_deps.h 与 ui.c 是否一致，不一致时返回非零（构建时执行）。
+--list：按组件列出依赖，不写文件。
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+HEADER_TAG_COMPRESSED = 0x7A65657E
+OPERAND_KINDS = ["const", "input", "local", "global", "output", "element", "op"]
+
+
+def lz4_block_decompress(src: bytes, size: int) -> bytes:
+    out = bytearray()
+    i = 0
+    while i < len(src):
+        token = src[i]
+        i += 1
+        length = token >> 4
+        if length == 15:
+            while True:
+                b = src[i]
+                i += 1
+                length += b
+                if b != 255:
+                    break
+        out += src[i : i + length]
+        i += length
+        if i >= len(src):
+            break
+        offset = src[i] | (src[i + 1] << 8)
+        i += 2
+        length = token & 15
+        if length == 15:
+            while True:
+                b = src[i]
+                i += 1
+                length += b
+                if b != 255:
+                    break
+        length += 4
+        for _ in range(length):
+            out.append(out[-offset])
+    if len(out) != size:
+        sys.exit(f"解压长度 {len(out)} 与头部记录的 {size} 不符")
+    return bytes(out)
+
+
+def load_assets(ui_c: str) -> bytes:
+    src = open(ui_c, encoding="utf-8").read()
+    m = re.search(r"assets\[\d+\]\s*=\s*\{(.*?)\};", src, re.S)
+    if not m:
+        sys.exit(f"{ui_c} 中没有 assets 数组")
+    raw = bytes(int(x, 0) for x in re.findall(r"0x[0-9A-Fa-f]+|\d+", m.group(1)))
+    tag, _, size = struct.unpack_from("<III", raw)
+    if tag != HEADER_TAG_COMPRESSED:
+        sys.exit("只支持压缩格式的资源")
+    return lz4_block_decompress(raw[12:], size)
+
+
+class Assets:
+    """解压后的数据从 Assets::settings 开始，AssetsPtr 为相对字段自身的偏移。"""
+
+    def __init__(self, data: bytes):
+        self.d = data
+
+    def u16(self, o):
+        return struct.unpack_from("<H", self.d, o)[0]
+
+    def u32(self, o):
+        return struct.unpack_from("<I", self.d, o)[0]
+
+    def ptr(self, o):
+        v = struct.unpack_from("<i", self.d, o)[0]
+        return o + v if v else None
+
+    def items(self, o):
+        n = self.u32(o)
+        base = self.ptr(o + 4)
+        return [self.ptr(base + 4 * k) for k in range(n)] if n else []
+
+    def instructions(self, o):
+        while True:
+            w = self.u16(o)
+            o += 2
+            kind = w >> 13
+            if kind == 7:
+                return
+            yield OPERAND_KINDS[kind], w & 0x1FFF
+
+
+H_TEMPLATE = """\
+/**
+ * @file screen_deps.h
+ * @brief 各屏幕依赖的原生变量，由 tools/eez_bindings.py 根据 ui.c 生成，请勿手动修改
+ *
+ * lvgl_init.c 只在当前屏幕依赖的变量变化时执行 tick_screen_*。
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "vars.h"
+
+/** @brief 屏幕的表达式还依赖流程变量、输入或输出，每个 tick 都要执行 */
+#define SCREEN_DEPS_ALWAYS UINT32_MAX
+
+/** @brief 屏幕数（与 tick_screen_funcs 一致） */
+#define SCREEN_DEPS_COUNT {count}
+
+static const uint32_t screen_deps[SCREEN_DEPS_COUNT] = {{
+{body}
+}};
+"""
+
+
+def collect(a: Assets, names):
+    """返回 [(flow, component, property, deps, others)]。"""
+    # settings, colorsDefinition, actionNames, variableNames 之后是 flowDefinition
+    flow_def = a.ptr(24)
+    flow_globals = a.u32(flow_def + 16)
+    result = []
+    for page, flow in enumerate(a.items(flow_def)):
+        for comp_index, comp in enumerate(a.items(flow)):
+            for prop_index, prop in enumerate(a.items(comp + 12)):
+                deps, others = [], []
+                for kind, param in a.instructions(prop):
+                    if kind == "global" and param >= flow_globals:
+                        name = names[param - flow_globals].upper()
+                        if name not in deps:
+                            deps.append(name)
+                    elif kind == "global":
+                        others.append(f"global{param}")
+                    elif kind in ("input", "local", "output"):
+                        others.append(f"{kind}{param}")
+                if deps or others:
+                    result.append((page, comp_index, prop_index, deps, others))
+    return result
+
+
+def screen_names(screens_h: str):
+    src = open(screens_h, encoding="utf-8").read()
+    ids = re.findall(r"SCREEN_ID_(\w+)\s*=\s*(\d+)", src)
+    return [name.lower() for name, _ in sorted(ids, key=lambda x: int(x[1]))]
+
+
+def render(bindings, screens):
+    widget_deps, widget_always = [], False
+    for page, _, _, deps, others in bindings:
+        if page >= len(screens):
+            widget_deps += [d for d in deps if d not in widget_deps]
+            widget_always = widget_always or bool(others)
+
+    lines = []
+    for page, name in enumerate(screens):
+        deps = list(widget_deps)
+        always = widget_always
+        for p, _, _, d, others in bindings:
+            if p == page:
+                deps += [x for x in d if x not in deps]
+                always = always or bool(others)
+        if always:
+            cond = "SCREEN_DEPS_ALWAYS"
+        else:
+            cond = " |\n        ".join(f"NATIVE_VAR_BIT({d})" for d in deps) or "0"
+        lines.append(f"    // {name}\n    {cond},")
+    return H_TEMPLATE.format(count=len(screens), body="\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("ui_c", nargs="?", default="main/src/ui/ui.c")
+    parser.add_argument("vars_h", nargs="?", default="main/src/ui/vars.h")
+    parser.add_argument("--check", action="store_true", help="只检查 screen_deps.h 是否最新")
+    parser.add_argument("--list", action="store_true", help="按组件列出依赖，不写文件")
+    args = parser.parse_args()
+
+    names = re.findall(r"extern void set_var_(\w+)\(", open(args.vars_h, encoding="utf-8").read())
+    out_dir = os.path.dirname(args.ui_c)
+    bindings = collect(Assets(load_assets(args.ui_c)), names)
+
+    if args.list:
+        for page, comp, prop, deps, others in bindings:
+            cond = " | ".join(f"NATIVE_VAR_BIT({n})" for n in deps) or "-"
+            note = f"  # 还依赖 {', '.join(others)}" if others else ""
+            print(f"flow {page} component {comp} property {prop}: {cond}{note}")
+        return
+
+    text = render(bindings, screen_names(os.path.join(out_dir, "screens.h")))
+    h_path = os.path.join(out_dir, "screen_deps.h")
+    if args.check:
+        current = open(h_path, encoding="utf-8").read() if os.path.exists(h_path) else ""
+        if current != text:
+            sys.exit(f"{h_path} 与 {args.ui_c} 不一致，请重新运行 tools/eez_bindings.py")
+        print(f"{h_path} 已是最新")
+        return
+
+    with open(h_path, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+    print(f"{h_path}: {len(bindings)} 个绑定")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""读取 /api/flow_profile，按耗时输出 EEZ 流程各组件类型与原生动作的统计。
+
+用法：
+    python tools/flow_profile.py <设备IP> [--reset] [--interval 10]
+
+固件需在 main/CMakeLists.txt 中设置 EEZ_FLOW_PROFILE=1。组件类型号按 eez-flow.h 中的
+COMPONENT_TYPE_* 换算为名称，原生动作序号按 ui.c 中的 actions 数组换算为函数名。
+
+--reset：读取后清零，下次读取只包含两次之间的统计。
+--interval N：每 N 秒读取并清零一次，持续输出各时间窗口内的统计，Ctrl+C 结束。
+"""
+
+import argparse
+import json
+import re
+import time
+import urllib.request
+
+
+def component_names(eez_flow_h):
+    src = open(eez_flow_h, encoding="utf-8").read()
+    return {int(n): name for name, n in re.findall(r"COMPONENT_TYPE_(\w+) = (\d+)", src)}
+
+
+def action_names(ui_c):
+    src = open(ui_c, encoding="utf-8").read()
+    m = re.search(r"ActionExecFunc actions\[\]\s*=\s*\{(.*?)\};", src, re.S)
+    return re.findall(r"(\w+)\s*,", m.group(1)) if m else []
+
+
+def fetch(device, reset):
+    url = f"http://{device}/api/flow_profile" + ("?reset=1" if reset else "")
+    with urllib.request.urlopen(url, timeout=5) as resp:
+        return json.load(resp)
+
+
+def row(name, e):
+    avg = e["total_us"] / e["count"] if e["count"] else 0
+    return f"{name:<32} {e['count']:>8} {e['total_us']:>12} {avg:>9.1f} {e['max_us']:>9}"
+
+
+def report(p, types, actions):
+    window = p["window_ms"] / 1000
+    ticks = p["ticks"]
+    queue = p["queue"]
+    print(f"统计 {window:.1f} s：tick {ticks['count']} 次，累计 {ticks['total_us']} us，"
+          f"最长 {ticks['max_us']} us，超时 {ticks['budget_hits']} 次")
+    print(f"队列：当前 {queue['size']}，tick 开始时最多 {queue['backlog_max']}，"
+          f"启动以来最多 {queue['peak']}")
+    print(f"{'':<32} {'次数':>6} {'累计us':>10} {'平均us':>7} {'最大us':>7}")
+    print(row("expressions", p["expressions"]))
+    for c in sorted(p["components"], key=lambda c: -c["total_us"]):
+        print(row(types.get(c["type"], f"type {c['type']}"), c))
+    for i, a in enumerate(p["actions"]):
+        if a["count"]:
+            print(row(actions[i] if i < len(actions) else f"action {i}", a))
+    if p["dropped"]:
+        print(f"类型表已满，未统计 {p['dropped']} 次组件执行")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("device", help="设备地址，如 192.168.1.50")
+    parser.add_argument("--reset", action="store_true", help="读取后清零")
+    parser.add_argument("--interval", type=float, default=0, help="按固定间隔持续读取")
+    parser.add_argument("--eez-flow-h", default="main/src/ui/eez-flow.h")
+    parser.add_argument("--ui-c", default="main/src/ui/ui.c")
+    args = parser.parse_args()
+
+    types = component_names(args.eez_flow_h)
+    actions = action_names(args.ui_c)
+    if not args.interval:
+        report(fetch(args.device, args.reset), types, actions)
+        return
+
+    fetch(args.device, True)
+    try:
+        while True:
+            time.sleep(args.interval)
+            report(fetch(args.device, True), types, actions)
+            print()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""生成 json_bind 完美哈希槽表。
+
+用法：
+    python tools/gen_json_bind_hash.py <名称> <键名1> <键名2> ...
+
+键名顺序必须与 C 代码中字段表的顺序一致。输出可直接粘贴到源文件中的槽表和种子。
+哈希算法与 main/src/services/json_bind.c 中的 json_bind_hash() 保持一致。
+"""
+
+import sys
+
+
+def fnv1a(key: str, seed: int) -> int:
+    h = seed
+    for b in key.encode("utf-8"):
+        h ^= b
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h ^ (h >> 16)
+
+
+def find_seed(keys, slot_count, max_tries=1 << 24):
+    mask = slot_count - 1
+    for seed in range(1, max_tries):
+        slots = [-1] * slot_count
+        for idx, key in enumerate(keys):
+            s = fnv1a(key, seed) & mask
+            if slots[s] != -1:
+                break
+            slots[s] = idx
+        else:
+            return seed, slots
+    return None, None
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__)
+        return 1
+
+    name, keys = sys.argv[1], sys.argv[2:]
+    if len(set(keys)) != len(keys):
+        print("duplicate keys", file=sys.stderr)
+        return 1
+
+    # 槽数取不小于键数两倍的 2 的幂，保证很快能找到无冲突的种子
+    slot_count = 1
+    while slot_count < len(keys) * 2:
+        slot_count <<= 1
+    if slot_count > 256:
+        print("too many keys", file=sys.stderr)
+        return 1
+
+    seed, slots = find_seed(keys, slot_count)
+    if seed is None:
+        print("no perfect seed found", file=sys.stderr)
+        return 1
+
+    print(f"// 由 tools/gen_json_bind_hash.py 生成，修改 {name}_fields 后需重新生成")
+    print("// clang-format off")
+    print(f"#define {name.upper()}_SEED 0x{seed:08x}u")
+    print(f"static const int8_t {name}_slots[{slot_count}] = {{")
+    for i in range(0, slot_count, 16):
+        row = ", ".join(f"{v:2d}" for v in slots[i:i + 16])
+        print(f"    {row},")
+    print("};")
+    print("// clang-format on")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
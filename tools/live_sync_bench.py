@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""测量 /api/live 每个连接的 CPU 耗时与内存占用（需要 websocket-client）。
+
+用法：
+    python tools/live_sync_bench.py <设备IP> [--clients 3] [--seconds 60] [--stall]
+
+依次建立 --clients 个连接，每建立一个读取一次 /api/health，输出内部 RAM 估算的每连接占用；
+随后保持 --seconds 秒接收推送，结束时输出各连接的消息数、字节数、累计耗时与每条消息的
+平均耗时，以及比对（所有连接共同承担）的累计耗时。
+
+--stall：最后一个连接不读取消息，用于观察背压：该连接的推迟次数增加，变化合并到之后的
+消息中，持续不可写 30 秒后被设备关闭，其他连接不受影响。
+--patch NAME：结束前经第一个连接发送 {"config":{"device_name":NAME}}，输出确认与
+其他连接收到配置增量的耗时。
+"""
+
+import argparse
+import json
+import sys
+import threading
+import time
+import urllib.request
+
+try:
+    import websocket
+except ImportError:
+    sys.exit("需要 websocket-client：pip install websocket-client")
+
+
+def read_live(device):
+    with urllib.request.urlopen(f"http://{device}/api/health", timeout=5) as resp:
+        return json.load(resp)["live"]
+
+
+def receiver(ws, log, stop):
+    ws.settimeout(1)
+    while not stop.is_set():
+        try:
+            text = ws.recv()
+        except websocket.WebSocketTimeoutException:
+            continue
+        except websocket.WebSocketException:
+            return
+        log.append((time.monotonic(), json.loads(text)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("device", help="设备地址，如 192.168.1.50")
+    parser.add_argument("--clients", type=int, default=3)
+    parser.add_argument("--seconds", type=float, default=60)
+    parser.add_argument("--stall", action="store_true", help="最后一个连接不读取消息")
+    parser.add_argument("--patch", default="", help="经第一个连接修改设备名称")
+    args = parser.parse_args()
+
+    stop = threading.Event()
+    conns = []
+    logs = []
+    for i in range(args.clients):
+        ws = websocket.create_connection(f"ws://{args.device}/api/live")
+        log = []
+        if not (args.stall and i == args.clients - 1):
+            threading.Thread(target=receiver, args=(ws, log, stop), daemon=True).start()
+        conns.append(ws)
+        logs.append(log)
+        time.sleep(1.5)
+        live = read_live(args.device)
+        print(f"{i + 1} 个连接：heap_per_client {live['heap_per_client']} B")
+
+    time.sleep(args.seconds)
+
+    if args.patch:
+        sent = time.monotonic()
+        conns[0].send(json.dumps({"config": {"device_name": args.patch}}))
+        time.sleep(3)
+        for i, log in enumerate(logs):
+            for ts, msg in log:
+                if ts < sent:
+                    continue
+                if msg.get("type") == "ack":
+                    print(f"连接 {i}：确认 {(ts - sent) * 1000:.0f} ms，ok={msg['ok']}")
+                elif "device_name" in msg.get("config", {}):
+                    print(f"连接 {i}：配置增量 {(ts - sent) * 1000:.0f} ms")
+
+    live = read_live(args.device)
+    stop.set()
+    for ws in conns:
+        ws.close()
+
+    print(f"比对 {live['polls']} 次，累计 {live['poll_us']} us")
+    print(f"推迟 {live['deferred']} 次，关闭 {live['dropped']} 个，拒绝 {live['rejected']} 个")
+    for peer in live["peers"]:
+        per_msg = peer["cpu_us"] / peer["messages"] if peer["messages"] else 0
+        print(f"fd {peer['fd']}: {peer['messages']} 条 / {peer['bytes']} B，"
+              f"耗时 {peer['cpu_us']} us（每条 {per_msg:.0f} us），推迟 {peer['deferred']} 次，"
+              f"已连接 {peer['connected_s']} 秒")
+    for i, log in enumerate(logs):
+        patches = sum(1 for _, msg in log if msg.get("type") == "patch")
+        print(f"连接 {i}：收到 {len(log)} 条（增量 {patches} 条）")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,352 @@
+#!/usr/bin/env python3
+"""本地模拟 MQTT broker（MQTT 3.1.1 的子集），用于没有 mosquitto 的环境中联调 MQTT 推送。
+
+用法：
+    python tools/mock_broker.py [--host 0.0.0.0] [--port 1883] [--http-port 8081]
+
+支持的行为：
+    CONNECT / CONNACK，clean session = 0 时保留会话（订阅与离线期间的 QoS 1 消息），
+    重连时 CONNACK 带 session present；同一客户端 ID 再次连接时断开旧连接
+    遗嘱消息（连接异常断开时发布，正常 DISCONNECT 时丢弃）
+    SUBSCRIBE / UNSUBSCRIBE（+ 与 # 通配符），订阅时下发匹配的 retain 消息
+    PUBLISH QoS 0 / 1，retain（空负载删除），已发出但未确认的 QoS 1 消息在断开时放回会话队列
+    PINGREQ / PINGRESP
+不检查保活超时（测试用模拟时钟驱动客户端的保活），不支持 QoS 2 与认证。
+
+--http-port 上的控制接口：
+    curl 'http://127.0.0.1:8081/_mock/stats'               按客户端 ID 统计收到的各类报文，
+                                                          packets 为 CONNECT 之后的报文总数
+    curl 'http://127.0.0.1:8081/_mock/kick?client=<ID>'    直接关闭连接（模拟网络中断）
+
+test/host 中的 mqtt_push_test 编译固件的 mqtt_push.c，对接本 broker 检查推送路径、离线补发、
+保活唤醒次数与 EEZ Flow 钩子（见 test/host/CMakeLists.txt）。
+"""
+
+import argparse
+import json
+import socket
+import socketserver
+import struct
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+CONNECT, CONNACK, PUBLISH, PUBACK = 1, 2, 3, 4
+SUBSCRIBE, SUBACK, UNSUBSCRIBE, UNSUBACK = 8, 9, 10, 11
+PINGREQ, PINGRESP, DISCONNECT = 12, 13, 14
+
+PACKET_NAMES = {
+    CONNECT: "CONNECT", PUBLISH: "PUBLISH", PUBACK: "PUBACK", SUBSCRIBE: "SUBSCRIBE",
+    UNSUBSCRIBE: "UNSUBSCRIBE", PINGREQ: "PINGREQ", DISCONNECT: "DISCONNECT",
+}
+
+
+def topic_matches(pattern, topic):
+    pat = pattern.split("/")
+    parts = topic.split("/")
+    for i, level in enumerate(pat):
+        if level == "#":
+            return True
+        if i >= len(parts) or (level != "+" and level != parts[i]):
+            return False
+    return len(pat) == len(parts)
+
+
+def encode_str(s):
+    data = s.encode("utf-8")
+    return struct.pack("!H", len(data)) + data
+
+
+def encode_packet(ptype, flags, body):
+    header = bytes([(ptype << 4) | flags])
+    n = len(body)
+    while True:
+        byte = n % 128
+        n //= 128
+        header += bytes([byte | (0x80 if n else 0)])
+        if not n:
+            return header + body
+
+
+class Session:
+    def __init__(self, client_id):
+        self.client_id = client_id
+        self.subs = {}       # 主题过滤器 -> QoS
+        self.queue = []      # 离线期间的 (主题, 负载, QoS)
+        self.inflight = {}   # 报文 ID -> (主题, 负载)
+        self.next_id = 1
+        self.conn = None
+
+
+class Broker:
+    def __init__(self):
+        self.lock = threading.RLock()
+        self.sessions = {}
+        self.retained = {}
+        self.stats = {}
+
+    def count(self, client_id, name):
+        with self.lock:
+            entry = self.stats.setdefault(client_id, {"online": False})
+            entry[name] = entry.get(name, 0) + 1
+            if name != "CONNECT":
+                entry["packets"] = entry.get("packets", 0) + 1
+
+    def set_online(self, client_id, online):
+        with self.lock:
+            self.stats.setdefault(client_id, {})["online"] = online
+
+    def route(self, topic, payload, qos, retain):
+        with self.lock:
+            if retain:
+                if payload:
+                    self.retained[topic] = (payload, qos)
+                else:
+                    self.retained.pop(topic, None)
+            for session in list(self.sessions.values()):
+                granted = [q for f, q in session.subs.items() if topic_matches(f, topic)]
+                if not granted:
+                    continue
+                deliver_qos = min(qos, max(granted))
+                if session.conn is not None:
+                    session.conn.deliver(topic, payload, deliver_qos, False)
+                elif deliver_qos > 0:
+                    session.queue.append((topic, payload, deliver_qos))
+
+
+class Connection(socketserver.BaseRequestHandler):
+    def setup(self):
+        self.broker = self.server.broker
+        self.session = None
+        self.will = None
+        self.write_lock = threading.Lock()
+        self.request.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+
+    def send(self, data):
+        with self.write_lock:
+            try:
+                self.request.sendall(data)
+            except OSError:
+                pass
+
+    def recv_exact(self, n):
+        data = b""
+        while len(data) < n:
+            chunk = self.request.recv(n - len(data))
+            if not chunk:
+                raise ConnectionError
+            data += chunk
+        return data
+
+    def read_packet(self):
+        first = self.recv_exact(1)[0]
+        length, shift = 0, 0
+        while True:
+            byte = self.recv_exact(1)[0]
+            length += (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                break
+        return first >> 4, first & 0x0F, self.recv_exact(length) if length else b""
+
+    def deliver(self, topic, payload, qos, retain):
+        """发送一条消息（需持有 broker.lock）"""
+        body = encode_str(topic)
+        if qos > 0:
+            packet_id = self.session.next_id
+            self.session.next_id = packet_id % 65535 + 1
+            self.session.inflight[packet_id] = (topic, payload)
+            body += struct.pack("!H", packet_id)
+        self.send(encode_packet(PUBLISH, (qos << 1) | (1 if retain else 0), body + payload))
+
+    def handle(self):
+        try:
+            ptype, _, body = self.read_packet()
+            if ptype != CONNECT or not self.on_connect(body):
+                return
+            while True:
+                ptype, flags, body = self.read_packet()
+                self.broker.count(self.session.client_id, PACKET_NAMES.get(ptype, "other"))
+                if ptype == DISCONNECT:
+                    self.will = None
+                    return
+                self.dispatch(ptype, flags, body)
+        except (ConnectionError, OSError, IndexError, struct.error):
+            pass
+
+    def on_connect(self, body):
+        name_len = struct.unpack("!H", body[:2])[0]
+        pos = 2 + name_len
+        level, conn_flags = body[pos], body[pos + 1]
+        pos += 4
+        if level != 4:
+            self.send(encode_packet(CONNACK, 0, b"\x00\x01"))
+            return False
+
+        def read_field():
+            nonlocal pos
+            n = struct.unpack("!H", body[pos:pos + 2])[0]
+            value = body[pos + 2:pos + 2 + n]
+            pos += 2 + n
+            return value
+
+        client_id = read_field().decode("utf-8")
+        if conn_flags & 0x04:
+            will_topic = read_field().decode("utf-8")
+            will_msg = read_field()
+            self.will = (will_topic, will_msg, (conn_flags >> 3) & 0x03, bool(conn_flags & 0x20))
+        clean = bool(conn_flags & 0x02)
+
+        broker = self.broker
+        with broker.lock:
+            old = broker.sessions.get(client_id)
+            if old is not None and old.conn is not None:
+                old.conn.will = None
+                old.conn.request.shutdown(socket.SHUT_RDWR)
+                old.conn.detach()
+            present = old is not None and not clean
+            self.session = old if present else Session(client_id)
+            self.session.conn = self
+            if clean:
+                broker.sessions.pop(client_id, None)
+            broker.sessions[client_id] = self.session
+            broker.count(client_id, "CONNECT")
+            broker.set_online(client_id, True)
+            self.clean = clean
+            self.send(encode_packet(CONNACK, 0, bytes([1 if present else 0, 0])))
+
+            # 先补发断开时未确认的消息，再发离线期间排队的消息
+            pending = list(self.session.inflight.values())
+            self.session.inflight.clear()
+            queued, self.session.queue = self.session.queue, []
+            for topic, payload in pending:
+                self.deliver(topic, payload, 1, False)
+            for topic, payload, qos in queued:
+                self.deliver(topic, payload, qos, False)
+        return True
+
+    def dispatch(self, ptype, flags, body):
+        broker = self.broker
+        if ptype == PUBLISH:
+            qos = (flags >> 1) & 0x03
+            n = struct.unpack("!H", body[:2])[0]
+            topic = body[2:2 + n].decode("utf-8")
+            pos = 2 + n
+            if qos > 0:
+                packet_id = body[pos:pos + 2]
+                pos += 2
+                self.send(encode_packet(PUBACK, 0, packet_id))
+            broker.route(topic, body[pos:], min(qos, 1), bool(flags & 0x01))
+        elif ptype == PUBACK:
+            with broker.lock:
+                self.session.inflight.pop(struct.unpack("!H", body[:2])[0], None)
+        elif ptype == SUBSCRIBE:
+            packet_id, pos, granted, filters = body[:2], 2, b"", []
+            while pos < len(body):
+                n = struct.unpack("!H", body[pos:pos + 2])[0]
+                topic_filter = body[pos + 2:pos + 2 + n].decode("utf-8")
+                qos = min(body[pos + 2 + n], 1)
+                pos += 3 + n
+                filters.append((topic_filter, qos))
+                granted += bytes([qos])
+            with broker.lock:
+                for topic_filter, qos in filters:
+                    self.session.subs[topic_filter] = qos
+                self.send(encode_packet(SUBACK, 0, packet_id + granted))
+                for topic, (payload, qos) in sorted(broker.retained.items()):
+                    matched = [q for f, q in filters if topic_matches(f, topic)]
+                    if matched:
+                        self.deliver(topic, payload, min(qos, max(matched)), True)
+        elif ptype == UNSUBSCRIBE:
+            pos = 2
+            with broker.lock:
+                while pos < len(body):
+                    n = struct.unpack("!H", body[pos:pos + 2])[0]
+                    self.session.subs.pop(body[pos + 2:pos + 2 + n].decode("utf-8"), None)
+                    pos += 2 + n
+            self.send(encode_packet(UNSUBACK, 0, body[:2]))
+        elif ptype == PINGREQ:
+            self.send(encode_packet(PINGRESP, 0, b""))
+
+    def detach(self):
+        """连接结束：记录离线，clean session 的会话随连接删除（需持有 broker.lock）"""
+        session = self.session
+        if session is None or session.conn is not self:
+            return
+        session.conn = None
+        self.broker.set_online(session.client_id, False)
+        if self.clean:
+            self.broker.sessions.pop(session.client_id, None)
+
+    def finish(self):
+        with self.broker.lock:
+            self.detach()
+        if self.will is not None:
+            topic, payload, qos, retain = self.will
+            self.broker.route(topic, payload, min(qos, 1), retain)
+
+    def kick(self):
+        try:
+            self.request.shutdown(socket.SHUT_RDWR)
+        except OSError:
+            pass
+
+
+class BrokerServer(socketserver.ThreadingTCPServer):
+    allow_reuse_address = True
+    daemon_threads = True
+
+
+class ControlHandler(BaseHTTPRequestHandler):
+    def log_message(self, fmt, *args):
+        pass
+
+    def do_GET(self):
+        url = urlparse(self.path)
+        broker = self.server.broker
+        if url.path == "/_mock/stats":
+            with broker.lock:
+                body = json.dumps({"clients": broker.stats}, separators=(",", ":"))
+        elif url.path == "/_mock/kick":
+            client_id = parse_qs(url.query).get("client", [""])[0]
+            with broker.lock:
+                session = broker.sessions.get(client_id)
+                conn = session.conn if session is not None else None
+            if conn is None:
+                self.send_error(404)
+                return
+            conn.kick()
+            body = "{}"
+        else:
+            self.send_error(404)
+            return
+        data = body.encode("utf-8")
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--http-port", type=int, default=8081, help="控制接口端口")
+    args = parser.parse_args()
+
+    broker = Broker()
+    server = BrokerServer((args.host, args.port), Connection)
+    server.broker = broker
+    control = ThreadingHTTPServer((args.host, args.http_port), ControlHandler)
+    control.broker = broker
+    threading.Thread(target=control.serve_forever, daemon=True).start()
+    print(f"MQTT broker on {args.host}:{args.port}, control on :{args.http_port}")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
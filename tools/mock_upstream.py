@@ -0,0 +1,369 @@
+#!/usr/bin/env python3
+"""本地模拟上游服务器（和风天气、API盒子 IP 定位、一言、SNTP）。
+
+用法：
+    python tools/mock_upstream.py [--port 8080] [--ntp-port 123]
+                                  [--scenario 接口=场景 ...] [--data-dir 目录]
+                                  [--tls-port 8443 --tls-cert 证书 --tls-key 私钥]
+
+设备配置（网页或 /api/config）中把地址指向本机即可离线联调：
+    weather.api_host      = http://<本机IP>:8080
+    ip_location.base_url  = http://<本机IP>:8080
+    yiyan.base_url        = http://<本机IP>:8080/hitokoto
+    time.ntp_servers      = <本机IP>（需要 --ntp-port 123，通常需要 root 权限）
+
+接口：weather、location、yiyan。场景：
+    ok         正常响应（天气为 gzip，与和风天气一致；一言为 Content-Length）
+    plain      天气不压缩
+    chunked    分块传输（天气为 gzip 后分块）
+    malformed  JSON 语法错误
+    truncated  响应体在中途截断（Content-Length 大于实际长度后关闭连接）
+    slow       按小块缓慢发送，总耗时约 --slow-seconds 秒
+    stall      发送响应头后不再发送数据（触发客户端超时）
+    5xx / 429 / 401 / 404   返回对应状态码
+
+运行时切换场景与查看统计：
+    curl 'http://127.0.0.1:8080/_mock/scenario?weather=slow&yiyan=chunked'
+    curl 'http://127.0.0.1:8080/_mock/stats'
+
+--tls-port 在另一个端口以 HTTPS 提供同样的接口，统计中的 tls 记录完整握手与会话恢复
+（票据）的次数，用于检查连接池重连时是否恢复了会话。自签名证书可用以下命令生成：
+    openssl req -x509 -newkey ec -pkeyopt ec_paramgen_curve:prime256v1 -nodes \
+        -keyout key.pem -out cert.pem -days 3650 -subj /CN=127.0.0.1
+
+--data-dir 中的 weather_now.json、weather_daily.json、location.json、yiyan.json
+会替换内置的录制响应。天气响应带 ETag 与 Cache-Control，重复请求返回 304。
+
+test/host 中的 weather_harness 在 PC 上编译固件的天气请求、解压与解析代码，
+启动本服务器后逐个场景检查解析结果、耗时与峰值内存（见 test/host/CMakeLists.txt）。
+"""
+
+import argparse
+import gzip
+import hashlib
+import json
+import os
+import socket
+import ssl
+import struct
+import sys
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+ENDPOINTS = ("weather", "location", "yiyan")
+SCENARIOS = ("ok", "plain", "chunked", "malformed", "truncated", "slow", "stall",
+             "5xx", "429", "401", "404")
+
+WEATHER_NOW = {
+    "code": "200",
+    "updateTime": "2026-01-15T10:30+08:00",
+    "fxLink": "https://www.qweather.com/weather/beijing-101010100.html",
+    "now": {
+        "obsTime": "2026-01-15T10:24+08:00",
+        "temp": "-2", "feelsLike": "-7", "icon": "100", "text": "晴",
+        "wind360": "315", "windDir": "西北风", "windScale": "3", "windSpeed": "14",
+        "humidity": "23", "precip": "0.0", "pressure": "1027", "vis": "30",
+        "cloud": "0", "dew": "-20",
+    },
+    "refer": {"sources": ["QWeather"], "license": ["QWeather Developers License"]},
+}
+
+DAILY_TEMPLATE = {
+    "sunrise": "07:35", "sunset": "17:12", "moonrise": "02:41", "moonset": "12:50",
+    "moonPhase": "残月", "moonPhaseIcon": "807", "tempMax": "3", "tempMin": "-8",
+    "iconDay": "100", "textDay": "晴", "iconNight": "150", "textNight": "晴",
+    "wind360Day": "315", "windDirDay": "西北风", "windScaleDay": "3-4", "windSpeedDay": "16",
+    "wind360Night": "270", "windDirNight": "西风", "windScaleNight": "1-3",
+    "windSpeedNight": "3", "humidity": "20", "precip": "0.0", "pressure": "1028",
+    "vis": "25", "cloud": "0", "uvIndex": "2",
+}
+
+LOCATION = {
+    "code": 200, "zhou": "亚洲", "zhoucode": "AP", "guo": "中国", "guocode": "CN",
+    "sheng": "北京", "shengcode": "110000", "shi": "北京", "shicode": "110100",
+    "qu": "海淀", "qucode": "110108", "isp": "联通", "lat": "39.96", "lon": "116.30",
+    "msg": "中国北京北京海淀联通", "ip": "203.0.113.7", "td": "+8",
+}
+
+YIYAN = {
+    "id": 1, "uuid": "9818ecda-9cbf-4f2a-9af8-8136ef39cfcd",
+    "hitokoto": "与众不同的生活方式很累人呢，因为找不到借口。",
+    "type": "a", "from": "幸运星", "from_who": None, "creator": "mock",
+    "length": 22,
+}
+
+
+def load_override(data_dir, name, default):
+    if data_dir is None:
+        return default
+    path = os.path.join(data_dir, name)
+    if not os.path.exists(path):
+        return default
+    with open(path, "rb") as f:
+        return json.loads(f.read().decode("utf-8"))
+
+
+def daily_payload(days):
+    base = {"code": "200", "updateTime": WEATHER_NOW["updateTime"],
+            "fxLink": WEATHER_NOW["fxLink"], "daily": []}
+    for i in range(days):
+        day = dict(DAILY_TEMPLATE)
+        day["fxDate"] = "2026-01-%02d" % (15 + i % 16)
+        day["tempMax"] = str(3 + i % 5)
+        base["daily"].append(day)
+    return base
+
+
+class Upstream:
+    """场景、录制数据与统计，在请求线程间共享。"""
+
+    def __init__(self, args):
+        self.lock = threading.Lock()
+        self.scenarios = {ep: "ok" for ep in ENDPOINTS}
+        self.slow_seconds = args.slow_seconds
+        self.max_age = args.max_age
+        self.now = load_override(args.data_dir, "weather_now.json", WEATHER_NOW)
+        self.daily = load_override(args.data_dir, "weather_daily.json", None)
+        self.location = load_override(args.data_dir, "location.json", LOCATION)
+        self.yiyan = load_override(args.data_dir, "yiyan.json", YIYAN)
+        self.stats = {ep: {"requests": 0, "not_modified": 0, "bytes": 0, "ms_total": 0.0}
+                      for ep in ENDPOINTS}
+        self.stats["tls"] = {"full": 0, "resumed": 0}
+
+    def scenario(self, ep):
+        with self.lock:
+            return self.scenarios[ep]
+
+    def arrive(self, ep):
+        # 收到请求时就计数：响应发出后客户端可能立即查询统计，早于 record()
+        with self.lock:
+            self.stats[ep]["requests"] += 1
+
+    def handshake(self, resumed):
+        with self.lock:
+            self.stats["tls"]["resumed" if resumed else "full"] += 1
+
+    def record(self, ep, sent, elapsed_ms, not_modified=False):
+        with self.lock:
+            s = self.stats[ep]
+            s["bytes"] += sent
+            s["ms_total"] += elapsed_ms
+            if not_modified:
+                s["not_modified"] += 1
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    upstream = None
+
+    def log_message(self, fmt, *args):
+        sys.stderr.write("%s %s\n" % (time.strftime("%H:%M:%S"), fmt % args))
+
+    def setup(self):
+        # HTTPS：握手在请求线程中完成，之后才知道是否恢复了会话
+        if isinstance(self.request, ssl.SSLSocket):
+            self.request.do_handshake()
+            self.upstream.handshake(self.request.session_reused)
+        super().setup()
+
+    # ------------------------------------------------------------------ 路由
+
+    def do_GET(self):
+        url = urlparse(self.path)
+        query = parse_qs(url.query)
+        path = url.path.rstrip("/") or "/"
+
+        if path == "/_mock/scenario":
+            return self.set_scenario(query)
+        if path == "/_mock/stats":
+            with self.upstream.lock:
+                return self.send_json_plain(200, self.upstream.stats)
+
+        if path == "/v7/weather/now":
+            return self.serve("weather", self.upstream.now, gzip_body=True)
+        if path.startswith("/v7/weather/") and path.endswith("d"):
+            try:
+                days = int(path[len("/v7/weather/"):-1])
+            except ValueError:
+                return self.send_json_plain(404, {"code": "404"})
+            payload = self.upstream.daily or daily_payload(days)
+            return self.serve("weather", payload, gzip_body=True)
+        if path == "/api/ip/chaapi.php":
+            return self.serve("location", self.upstream.location)
+        if path in ("/", "/hitokoto"):
+            return self.serve("yiyan", self.upstream.yiyan)
+
+        return self.send_json_plain(404, {"code": 404, "msg": "not found"})
+
+    def set_scenario(self, query):
+        changed = {}
+        for ep, values in query.items():
+            if ep not in ENDPOINTS or values[0] not in SCENARIOS:
+                return self.send_json_plain(400, {"error": "unknown %s=%s" % (ep, values[0])})
+            changed[ep] = values[0]
+        with self.upstream.lock:
+            self.upstream.scenarios.update(changed)
+            return self.send_json_plain(200, self.upstream.scenarios)
+
+    # ------------------------------------------------------------------ 响应
+
+    def send_json_plain(self, status, obj):
+        body = json.dumps(obj, ensure_ascii=False).encode("utf-8")
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json; charset=utf-8")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def serve(self, ep, payload, gzip_body=False):
+        start = time.monotonic()
+        self.upstream.arrive(ep)
+        scenario = self.upstream.scenario(ep)
+
+        if scenario in ("5xx", "429", "401", "404"):
+            status = 503 if scenario == "5xx" else int(scenario)
+            self.send_json_plain(status, {"code": str(status)})
+            self.upstream.record(ep, 0, (time.monotonic() - start) * 1000)
+            return
+
+        text = json.dumps(payload, ensure_ascii=False).encode("utf-8")
+        if scenario == "malformed":
+            text = text[:-1] + b',"broken":}'
+        etag = '"%s"' % hashlib.sha1(text).hexdigest()[:16]
+
+        if gzip_body and scenario not in ("malformed", "truncated") and \
+                self.headers.get("If-None-Match") == etag:
+            self.send_response(304)
+            self.send_header("ETag", etag)
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+            self.upstream.record(ep, 0, (time.monotonic() - start) * 1000, not_modified=True)
+            return
+
+        body = gzip.compress(text) if gzip_body and scenario != "plain" else text
+
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json; charset=utf-8")
+        if body is not text:
+            self.send_header("Content-Encoding", "gzip")
+        if gzip_body:
+            self.send_header("ETag", etag)
+            self.send_header("Cache-Control", "max-age=%d" % self.upstream.max_age)
+
+        if scenario == "chunked":
+            self.send_header("Transfer-Encoding", "chunked")
+            self.end_headers()
+            step = max(1, len(body) // 4)
+            for i in range(0, len(body), step):
+                part = body[i:i + step]
+                self.wfile.write(b"%x\r\n%s\r\n" % (len(part), part))
+            self.wfile.write(b"0\r\n\r\n")
+        elif scenario == "truncated":
+            self.send_header("Content-Length", str(len(body)))
+            self.send_header("Connection", "close")
+            self.end_headers()
+            self.wfile.write(body[:len(body) // 2])
+            self.close_connection = True
+        elif scenario == "stall":
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.flush()
+            time.sleep(max(self.upstream.slow_seconds, 30))
+            self.close_connection = True
+        elif scenario == "slow":
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            step = max(1, len(body) // 20)
+            pause = self.upstream.slow_seconds / max(1, (len(body) + step - 1) // step)
+            for i in range(0, len(body), step):
+                self.wfile.write(body[i:i + step])
+                self.wfile.flush()
+                time.sleep(pause)
+        else:
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+        self.upstream.record(ep, len(body), (time.monotonic() - start) * 1000)
+
+
+# ---------------------------------------------------------------------- SNTP
+
+NTP_EPOCH_OFFSET = 2208988800
+
+
+def ntp_timestamp(t):
+    return struct.pack("!II", int(t) + NTP_EPOCH_OFFSET, int((t % 1) * (1 << 32)))
+
+
+def run_sntp(port, offset_s):
+    """最简 SNTP 服务器：以本机时间（加上 offset_s）应答 mode 3 请求。"""
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("0.0.0.0", port))
+    while True:
+        data, addr = sock.recvfrom(512)
+        if len(data) < 48:
+            continue
+        recv = time.time() + offset_s
+        version = (data[0] >> 3) & 0x7
+        header = struct.pack("!BBbb", (version << 3) | 4, 1, 6, -20)
+        reply = header + b"\0" * 8 + b"MOCK" + ntp_timestamp(recv) + data[40:48] + \
+            ntp_timestamp(recv) + ntp_timestamp(time.time() + offset_s)
+        sock.sendto(reply, addr)
+
+
+# ---------------------------------------------------------------------- 入口
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--ntp-port", type=int, default=0, help="SNTP 端口，0 表示不启用")
+    parser.add_argument("--ntp-offset", type=float, default=0.0,
+                        help="SNTP 应答相对本机时间的偏移（秒），用于验证漂移补偿")
+    parser.add_argument("--scenario", action="append", default=[], metavar="接口=场景")
+    parser.add_argument("--slow-seconds", type=float, default=8.0)
+    parser.add_argument("--max-age", type=int, default=600)
+    parser.add_argument("--data-dir", default=None)
+    parser.add_argument("--tls-port", type=int, default=0, help="HTTPS 端口，0 表示不启用")
+    parser.add_argument("--tls-cert", default=None)
+    parser.add_argument("--tls-key", default=None)
+    args = parser.parse_args()
+    if args.tls_port and not (args.tls_cert and args.tls_key):
+        parser.error("--tls-port requires --tls-cert and --tls-key")
+
+    Handler.upstream = Upstream(args)
+    for item in args.scenario:
+        ep, _, name = item.partition("=")
+        if ep not in ENDPOINTS or name not in SCENARIOS:
+            parser.error("unknown scenario %s" % item)
+        Handler.upstream.scenarios[ep] = name
+
+    if args.ntp_port:
+        threading.Thread(target=run_sntp, args=(args.ntp_port, args.ntp_offset),
+                         daemon=True).start()
+        print("SNTP on udp/%d (offset %+.1f s)" % (args.ntp_port, args.ntp_offset))
+
+    if args.tls_port:
+        context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        context.load_cert_chain(args.tls_cert, args.tls_key)
+        tls_server = ThreadingHTTPServer((args.host, args.tls_port), Handler)
+        tls_server.socket = context.wrap_socket(tls_server.socket, server_side=True,
+                                                do_handshake_on_connect=False)
+        threading.Thread(target=tls_server.serve_forever, daemon=True).start()
+        print("Mock upstream on https://%s:%d" % (args.host, args.tls_port))
+
+    server = ThreadingHTTPServer((args.host, args.port), Handler)
+    print("Mock upstream on http://%s:%d  scenarios: %s" %
+          (args.host, args.port, Handler.upstream.scenarios))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""测量 MQTT 推送的更新延迟与射频唤醒次数（需要 paho-mqtt 与一个 broker，如本地 mosquitto）。
+
+用法：
+    mosquitto -v          （或 python tools/mock_broker.py）
+    python tools/mqtt_push_bench.py --broker 127.0.0.1 --device http://<设备IP> [--count 20]
+
+设备配置 mqtt.uri = mqtt://<本机IP>:1883（重启生效）。工具向 <prefix>/var/<变量> 发布
+retain 消息，等待设备回显到 <prefix>/ack/<变量>，统计往返延迟；前后读取设备 /api/health，
+输出期间的射频唤醒次数、MQTT 重连次数与消息计数，可与同一时段内 HTTP 轮询的唤醒次数对比。
+
+--offline-seconds N：先发布一条消息，等待 N 秒（期间设备可处于仅联网窗口开启的模式），
+再统计消息从发布到设备回显的时间，验证持久会话的离线补发。
+"""
+
+import argparse
+import json
+import statistics
+import sys
+import threading
+import time
+import urllib.request
+
+try:
+    import paho.mqtt.client as mqtt
+except ImportError:
+    sys.exit("需要 paho-mqtt：pip install paho-mqtt")
+
+
+def read_health(device):
+    if not device:
+        return None
+    try:
+        with urllib.request.urlopen(device.rstrip("/") + "/api/health", timeout=5) as resp:
+            return json.load(resp)
+    except OSError as err:
+        print(f"读取 /api/health 失败：{err}")
+        return None
+
+
+class AckWaiter:
+    def __init__(self):
+        self.cond = threading.Condition()
+        self.acks = {}
+
+    def on_message(self, client, userdata, msg):
+        with self.cond:
+            self.acks[msg.payload.decode("utf-8", "replace")] = time.monotonic()
+            self.cond.notify_all()
+
+    def wait(self, payload, timeout):
+        deadline = time.monotonic() + timeout
+        with self.cond:
+            while payload not in self.acks:
+                remaining = deadline - time.monotonic()
+                if remaining <= 0:
+                    return None
+                self.cond.wait(remaining)
+            return self.acks[payload]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--broker", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--prefix", default="espaperplay")
+    parser.add_argument("--var", default="yiyan", help="用于测试的界面变量")
+    parser.add_argument("--device", default="", help="设备地址，如 http://192.168.1.50")
+    parser.add_argument("--count", type=int, default=20)
+    parser.add_argument("--interval", type=float, default=1.0, help="两次发布间隔（秒）")
+    parser.add_argument("--timeout", type=float, default=30.0, help="等待回显的超时（秒）")
+    parser.add_argument("--offline-seconds", type=float, default=0)
+    args = parser.parse_args()
+
+    waiter = AckWaiter()
+    client = mqtt.Client(mqtt.CallbackAPIVersion.VERSION2, client_id="espaperplay-bench")
+    client.on_message = waiter.on_message
+    client.connect(args.broker, args.port)
+    client.subscribe(f"{args.prefix}/ack/{args.var}", qos=1)
+    client.loop_start()
+
+    before = read_health(args.device)
+    topic = f"{args.prefix}/var/{args.var}"
+    latencies = []
+    lost = 0
+
+    if args.offline_seconds > 0:
+        payload = f"离线补发测试 {time.time():.3f}"
+        sent = time.monotonic()
+        client.publish(topic, payload, qos=1, retain=True)
+        print(f"已发布，等待设备在 {args.offline_seconds:.0f} 秒内上线...")
+        acked = waiter.wait(payload, args.offline_seconds + args.timeout)
+        if acked is None:
+            print("未收到回显")
+            lost += 1
+        else:
+            print(f"发布到回显：{acked - sent:.2f} 秒")
+
+    for i in range(args.count):
+        payload = f"推送测试 {i} {time.time():.3f}"
+        sent = time.monotonic()
+        client.publish(topic, payload, qos=1, retain=True)
+        acked = waiter.wait(payload, args.timeout)
+        if acked is None:
+            lost += 1
+        else:
+            latencies.append((acked - sent) * 1000)
+        time.sleep(args.interval)
+
+    after = read_health(args.device)
+    client.loop_stop()
+    client.disconnect()
+
+    if latencies:
+        latencies.sort()
+        p95 = latencies[min(len(latencies) - 1, int(len(latencies) * 0.95))]
+        print(f"延迟 (ms)：min {latencies[0]:.0f}  median {statistics.median(latencies):.0f}  "
+              f"p95 {p95:.0f}  max {latencies[-1]:.0f}")
+    print(f"回显 {len(latencies)} / 丢失 {lost}")
+
+    if before and after:
+        for key in ("wakeups", "on_ms_total"):
+            delta = after["radio"].get(key, 0) - before["radio"].get(key, 0)
+            print(f"radio.{key}: +{delta}")
+        for key in ("connects", "disconnects", "messages", "vars", "dropped"):
+            delta = after["mqtt"].get(key, 0) - before["mqtt"].get(key, 0)
+            print(f"mqtt.{key}: +{delta}")
+
+
+if __name__ == "__main__":
+    main()
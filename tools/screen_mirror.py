@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""连接设备的 /api/screen/ws，重建屏幕画面并输出每次刷新的变化像素（需要 websocket-client）。
+
+用法：
+    python tools/screen_mirror.py <设备IP> [--out screen.pbm]
+
+每收到一条消息打印类型、矩形数、变化像素数与消息字节数，并把重建的画面写入 PBM 文件
+（查看器支持自动重载时即为实时镜像）。消息格式见 main/include/screen_mirror.h。
+"""
+
+import argparse
+import struct
+import sys
+
+try:
+    import websocket
+except ImportError:
+    sys.exit("需要 websocket-client：pip install websocket-client")
+
+
+def unpackbits(data, size):
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        c = data[i]
+        i += 1
+        if c < 128:
+            out += data[i:i + c + 1]
+            i += c + 1
+        elif c > 128:
+            out += bytes([data[i]]) * (257 - c)
+            i += 1
+    return out, i
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("device", help="设备地址，如 192.168.1.50")
+    parser.add_argument("--width", type=int, default=200)
+    parser.add_argument("--height", type=int, default=200)
+    parser.add_argument("--out", default="screen.pbm")
+    args = parser.parse_args()
+
+    stride = args.width // 8
+    screen = bytearray(stride * args.height)
+    ws = websocket.create_connection(f"ws://{args.device}/api/screen/ws")
+
+    while True:
+        msg = ws.recv()
+        kind, count, seq, changed = struct.unpack_from("<BBHI", msg)
+        pos = 8
+        for _ in range(count):
+            x, y, w, h, length = struct.unpack_from("<HHHHH", msg, pos)
+            pos += 10
+            pixels, _ = unpackbits(msg[pos:pos + length], w // 8 * h)
+            pos += length
+            for row in range(h):
+                start = (y + row) * stride + x // 8
+                screen[start:start + w // 8] = pixels[row * (w // 8):(row + 1) * (w // 8)]
+
+        name = "关键帧" if kind == 0 else "增量"
+        print(f"#{seq} {name} 矩形 {count} 变化像素 {changed} 消息 {len(msg)} 字节")
+        with open(args.out, "wb") as f:
+            f.write(f"P4\n{args.width} {args.height}\n".encode() + screen)
+
+
+if __name__ == "__main__":
+    main()
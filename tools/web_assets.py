@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""生成静态文件的预压缩版本，并测量配置页的传输字节数与首字节时间。
+
+用法：
+    python tools/web_assets.py build [fatfs_image]
+    python tools/web_assets.py measure http://<设备IP> [--count 10]
+
+build：为可压缩的文件生成 <文件>.gz（gzip -9，不写入时间戳，内容不变时输出不变），
+压缩后不足原文件 90% 才保留；同时删除源文件已不存在的 .gz。设备在客户端接受 gzip 时
+发送 .gz 版本。需要在生成 FATFS 镜像前运行（见 main/CMakeLists.txt）。
+
+measure：分别以不压缩、gzip 请求配置页，再带 If-None-Match 重新校验，输出每种情况的
+响应字节数、首字节时间与总时间，以及设备 /api/health 中记录的服务端耗时。
+"""
+
+import argparse
+import gzip
+import http.client
+import json
+import os
+import statistics
+import sys
+import time
+import urllib.parse
+
+COMPRESSIBLE = (".html", ".css", ".js", ".json", ".svg", ".ttf")
+MIN_RATIO = 0.9
+
+
+def build(image):
+    for name in sorted(os.listdir(image)):
+        path = os.path.join(image, name)
+        if name.endswith(".gz"):
+            if not os.path.exists(path[:-3]):
+                os.remove(path)
+                print(f"删除 {name}（源文件不存在）")
+            continue
+        if not name.endswith(COMPRESSIBLE) or not os.path.isfile(path):
+            continue
+
+        with open(path, "rb") as f:
+            data = f.read()
+        packed = gzip.compress(data, compresslevel=9, mtime=0)
+        if len(packed) >= len(data) * MIN_RATIO:
+            if os.path.exists(path + ".gz"):
+                os.remove(path + ".gz")
+            print(f"跳过 {name}：压缩收益不足")
+            continue
+
+        with open(path + ".gz", "wb") as f:
+            f.write(packed)
+        print(f"{name}: {len(data)} -> {len(packed)} 字节 ({len(packed) * 100 // len(data)}%)")
+
+
+def fetch(url, headers):
+    parts = urllib.parse.urlsplit(url)
+    conn = http.client.HTTPConnection(parts.hostname, parts.port or 80, timeout=10)
+    start = time.monotonic()
+    conn.request("GET", parts.path or "/", headers=headers)
+    resp = conn.getresponse()
+    first = resp.read(1)
+    ttfb = time.monotonic() - start
+    body = first + resp.read()
+    total = time.monotonic() - start
+    result = (resp.status, len(body), resp.getheader("ETag"), ttfb * 1000, total * 1000)
+    conn.close()
+    return result
+
+
+def measure(device, count):
+    url = device.rstrip("/") + "/"
+    cases = [("identity", {"Accept-Encoding": "identity"}), ("gzip", {"Accept-Encoding": "gzip"})]
+    etag = None
+    for label, headers in cases:
+        samples = [fetch(url, headers) for _ in range(count)]
+        etag = samples[-1][2]
+        report(label, samples)
+
+    if etag:
+        headers = {"Accept-Encoding": "gzip", "If-None-Match": etag}
+        report("304", [fetch(url, headers) for _ in range(count)])
+
+    try:
+        parts = urllib.parse.urlsplit(url)
+        conn = http.client.HTTPConnection(parts.hostname, parts.port or 80, timeout=5)
+        conn.request("GET", "/api/health")
+        web = json.load(conn.getresponse()).get("web", {})
+        print(f"设备端：page_bytes {web.get('page_bytes')}  "
+              f"ttfb {web.get('page_ttfb_us')} us  total {web.get('page_total_us')} us")
+    except (OSError, ValueError) as err:
+        print(f"读取 /api/health 失败：{err}")
+
+
+def report(label, samples):
+    status = samples[-1][0]
+    size = samples[-1][1]
+    ttfb = statistics.median(s[3] for s in samples)
+    total = statistics.median(s[4] for s in samples)
+    print(f"{label:>8}: {status}  {size} 字节  TTFB {ttfb:.1f} ms  总计 {total:.1f} ms")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    p_build = sub.add_parser("build")
+    p_build.add_argument("image", nargs="?",
+                         default=os.path.join(os.path.dirname(__file__), "..", "fatfs_image"))
+    p_measure = sub.add_parser("measure")
+    p_measure.add_argument("device", help="设备地址，如 http://192.168.1.50")
+    p_measure.add_argument("--count", type=int, default=10)
+    args = parser.parse_args()
+
+    if args.cmd == "build":
+        if not os.path.isdir(args.image):
+            sys.exit(f"目录不存在：{args.image}")
+        build(args.image)
+    else:
+        measure(args.device, args.count)
+
+
+if __name__ == "__main__":
+    main()